@@ -97,10 +97,9 @@ void audioCallback(ma_device* device, void* output, const void* input, ma_uint32
 
     ma_uint32 pcmBytes = frameCount * ma_get_bytes_per_frame(device->capture.format, device->capture.channels);
 
-    // capture input audio
+    // capture input audio (the callback is the only producer of input audio, and the only consumer of output
+    // audio, so neither buffer requires locking here)
     if (frameCount > 0U) {
-        std::lock_guard<std::mutex> lock(HostBridge::m_audioMutex);
-
         int smpIdx = 0;
         short samples[MBE_SAMPLES_LENGTH];
         const uint8_t* pcm = (const uint8_t*)input;
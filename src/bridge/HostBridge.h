@@ -18,13 +18,13 @@
 
 #include "Defines.h"
 #include "common/concurrent/deque.h"
+#include "common/concurrent/spsc_ring_buffer.h"
 #include "common/dmr/data/EmbeddedData.h"
 #include "common/dmr/lc/LC.h"
 #include "common/dmr/lc/PrivacyLC.h"
 #include "common/p25/Crypto.h"
 #include "common/network/udp/Socket.h"
 #include "common/yaml/Yaml.h"
-#include "common/RingBuffer.h"
 #include "common/Timer.h"
 #include "vocoder/MBEDecoder.h"
 #include "vocoder/MBEEncoder.h"
@@ -237,8 +237,8 @@ private:
     ma_waveform m_maSineWaveform;
     ma_waveform_config m_maSineWaveConfig;
 
-    RingBuffer<short> m_inputAudio;
-    RingBuffer<short> m_outputAudio;
+    concurrent::spsc_ring_buffer<short> m_inputAudio;
+    concurrent::spsc_ring_buffer<short> m_outputAudio;
     concurrent::deque<NetPacketRequest*> m_udpPackets;
 
     vocoder::MBEDecoder* m_decoder;
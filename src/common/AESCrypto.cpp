@@ -15,9 +15,17 @@
 
 using namespace crypto;
 
+#include <cassert>
 #include <cstring>
 #include <string>
 
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define AES_NI_SUPPORTED 1
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#endif
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
@@ -238,13 +246,115 @@ static const uint8_t CMDS[4][4] = { {2, 3, 1, 1}, {1, 2, 3, 1}, {1, 1, 2, 3}, {3
 // Inverse circulant MDS matrix
 static const uint8_t INV_CMDS[4][4] = { {14, 11, 13, 9}, {9, 14, 11, 13}, {13, 9, 14, 11}, {11, 13, 9, 14} };
 
+#if defined(AES_NI_SUPPORTED)
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to encrypt blocks using AES-NI. */
+
+__attribute__((target("aes,sse2")))
+static void aesniEncryptBlocks(const uint8_t* roundKeys, uint32_t rounds, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    __m128i rk[15U];
+    for (uint32_t i = 0U; i <= rounds; i++)
+        rk[i] = _mm_loadu_si128((const __m128i*)(roundKeys + (i * 16U)));
+
+    // interleave 4 blocks at a time to hide the latency of the AES instructions
+    uint32_t n = 0U;
+    for (; n + 4U <= blocks; n += 4U) {
+        const __m128i* src = (const __m128i*)(in + (n * 16U));
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src + 0), rk[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), rk[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), rk[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), rk[0]);
+        for (uint32_t r = 1U; r < rounds; r++) {
+            b0 = _mm_aesenc_si128(b0, rk[r]);
+            b1 = _mm_aesenc_si128(b1, rk[r]);
+            b2 = _mm_aesenc_si128(b2, rk[r]);
+            b3 = _mm_aesenc_si128(b3, rk[r]);
+        }
+
+        __m128i* dst = (__m128i*)(out + (n * 16U));
+        _mm_storeu_si128(dst + 0, _mm_aesenclast_si128(b0, rk[rounds]));
+        _mm_storeu_si128(dst + 1, _mm_aesenclast_si128(b1, rk[rounds]));
+        _mm_storeu_si128(dst + 2, _mm_aesenclast_si128(b2, rk[rounds]));
+        _mm_storeu_si128(dst + 3, _mm_aesenclast_si128(b3, rk[rounds]));
+    }
+
+    for (; n < blocks; n++) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + (n * 16U))), rk[0]);
+        for (uint32_t r = 1U; r < rounds; r++)
+            b = _mm_aesenc_si128(b, rk[r]);
+        _mm_storeu_si128((__m128i*)(out + (n * 16U)), _mm_aesenclast_si128(b, rk[rounds]));
+    }
+}
+
+/* Helper to decrypt blocks using AES-NI. */
+
+__attribute__((target("aes,sse2")))
+static void aesniDecryptBlocks(const uint8_t* invRoundKeys, uint32_t rounds, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    __m128i rk[15U];
+    for (uint32_t i = 0U; i <= rounds; i++)
+        rk[i] = _mm_loadu_si128((const __m128i*)(invRoundKeys + (i * 16U)));
+
+    // interleave 4 blocks at a time to hide the latency of the AES instructions
+    uint32_t n = 0U;
+    for (; n + 4U <= blocks; n += 4U) {
+        const __m128i* src = (const __m128i*)(in + (n * 16U));
+        __m128i b0 = _mm_xor_si128(_mm_loadu_si128(src + 0), rk[0]);
+        __m128i b1 = _mm_xor_si128(_mm_loadu_si128(src + 1), rk[0]);
+        __m128i b2 = _mm_xor_si128(_mm_loadu_si128(src + 2), rk[0]);
+        __m128i b3 = _mm_xor_si128(_mm_loadu_si128(src + 3), rk[0]);
+        for (uint32_t r = 1U; r < rounds; r++) {
+            b0 = _mm_aesdec_si128(b0, rk[r]);
+            b1 = _mm_aesdec_si128(b1, rk[r]);
+            b2 = _mm_aesdec_si128(b2, rk[r]);
+            b3 = _mm_aesdec_si128(b3, rk[r]);
+        }
+
+        __m128i* dst = (__m128i*)(out + (n * 16U));
+        _mm_storeu_si128(dst + 0, _mm_aesdeclast_si128(b0, rk[rounds]));
+        _mm_storeu_si128(dst + 1, _mm_aesdeclast_si128(b1, rk[rounds]));
+        _mm_storeu_si128(dst + 2, _mm_aesdeclast_si128(b2, rk[rounds]));
+        _mm_storeu_si128(dst + 3, _mm_aesdeclast_si128(b3, rk[rounds]));
+    }
+
+    for (; n < blocks; n++) {
+        __m128i b = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + (n * 16U))), rk[0]);
+        for (uint32_t r = 1U; r < rounds; r++)
+            b = _mm_aesdec_si128(b, rk[r]);
+        _mm_storeu_si128((__m128i*)(out + (n * 16U)), _mm_aesdeclast_si128(b, rk[rounds]));
+    }
+}
+
+/* Helper to derive the AES-NI decryption key schedule from the encryption key schedule. */
+
+__attribute__((target("aes,sse2")))
+static void aesniInvertRoundKeys(const uint8_t* roundKeys, uint32_t rounds, uint8_t* invRoundKeys)
+{
+    _mm_storeu_si128((__m128i*)invRoundKeys, _mm_loadu_si128((const __m128i*)(roundKeys + (rounds * 16U))));
+    for (uint32_t i = 1U; i < rounds; i++) {
+        __m128i rk = _mm_loadu_si128((const __m128i*)(roundKeys + ((rounds - i) * 16U)));
+        _mm_storeu_si128((__m128i*)(invRoundKeys + (i * 16U)), _mm_aesimc_si128(rk));
+    }
+    _mm_storeu_si128((__m128i*)(invRoundKeys + (rounds * 16U)), _mm_loadu_si128((const __m128i*)roundKeys));
+}
+#endif // defined(AES_NI_SUPPORTED)
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
 
 /* Initializes a new instance of the AES class. */
 
-AES::AES(const AESKeyLength keyLength) {
+AES::AES(const AESKeyLength keyLength, bool useHardware) :
+    m_Nk(8U),
+    m_Nr(14U),
+    m_useHardware(useHardware && isHardwareSupported()),
+    m_hasKey(false)
+{
     switch (keyLength) {
     case AESKeyLength::AES_128:
         this->m_Nk = 4;
@@ -259,6 +369,30 @@ AES::AES(const AESKeyLength keyLength) {
         this->m_Nr = 14;
         break;
     }
+
+    ::memset(m_key, 0x00U, AES_MAX_KEY_BYTES);
+    ::memset(m_roundKeys, 0x00U, AES_MAX_ROUND_KEY_BYTES);
+    ::memset(m_invRoundKeys, 0x00U, AES_MAX_ROUND_KEY_BYTES);
+}
+
+/* Sets the encryption key, and expands the key schedule. */
+
+void AES::setKey(const uint8_t key[])
+{
+    assert(key != nullptr);
+
+    // don't expand the key schedule again for the same key
+    if (m_hasKey && ::memcmp(m_key, key, 4U * m_Nk) == 0)
+        return;
+
+    ::memcpy(m_key, key, 4U * m_Nk);
+    keyExpansion(key, m_roundKeys);
+#if defined(AES_NI_SUPPORTED)
+    if (m_useHardware)
+        aesniInvertRoundKeys(m_roundKeys, m_Nr, m_invRoundKeys);
+#endif // defined(AES_NI_SUPPORTED)
+
+    m_hasKey = true;
 }
 
 /* Encrypt input buffer with given key in AES-ECB. */
@@ -271,16 +405,8 @@ uint8_t* AES::encryptECB(const uint8_t in[], uint32_t inLen, const uint8_t key[]
     }
 
     uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
-    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        encryptBlock(in + i, out + i, roundKeys);
-    }
-
-    delete[] roundKeys;
+    setKey(key);
+    encryptECB(in, out, inLen);
     return out;
 }
 
@@ -294,16 +420,8 @@ uint8_t* AES::decryptECB(const uint8_t in[], uint32_t inLen, const uint8_t key[]
     }
 
     uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
-    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        decryptBlock(in + i, out + i, roundKeys);
-    }
-
-    delete[] roundKeys;
+    setKey(key);
+    decryptECB(in, out, inLen);
     return out;
 }
 
@@ -317,20 +435,8 @@ uint8_t* AES::encryptCBC(const uint8_t in[], uint32_t inLen, const uint8_t key[]
     }
 
     uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
-    uint8_t block[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
-    ::memcpy(block, iv, BLOCK_BYTES_LEN);
-    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        xorBlocks(block, in + i, block, BLOCK_BYTES_LEN);
-        encryptBlock(block, out + i, roundKeys);
-        ::memcpy(block, out + i, BLOCK_BYTES_LEN);
-    }
-
-    delete[] roundKeys;
+    setKey(key);
+    encryptCBC(in, out, inLen, iv);
     return out;
 }
 
@@ -344,20 +450,8 @@ uint8_t* AES::decryptCBC(const uint8_t in[], uint32_t inLen, const uint8_t key[]
     }
 
     uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
-    uint8_t block[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
-    ::memcpy(block, iv, BLOCK_BYTES_LEN);
-    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        decryptBlock(in + i, out + i, roundKeys);
-        xorBlocks(block, out + i, out + i, BLOCK_BYTES_LEN);
-        ::memcpy(block, in + i, BLOCK_BYTES_LEN);
-    }
-
-    delete[] roundKeys;
+    setKey(key);
+    decryptCBC(in, out, inLen, iv);
     return out;
 }
 
@@ -374,18 +468,15 @@ uint8_t* AES::encryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[]
     ::memset(out, 0x00U, inLen);
     uint8_t block[BLOCK_BYTES_LEN];
     uint8_t encryptedBlock[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
 
-    keyExpansion(key, roundKeys);
+    setKey(key);
     ::memcpy(block, iv, BLOCK_BYTES_LEN);
     for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        encryptBlock(block, encryptedBlock, roundKeys);
+        encryptBlocks(block, encryptedBlock, 1U);
         xorBlocks(in + i, encryptedBlock, out + i, BLOCK_BYTES_LEN);
         ::memcpy(block, out + i, BLOCK_BYTES_LEN);
     }
 
-    delete[] roundKeys;
     return out;
 }
 
@@ -402,21 +493,130 @@ uint8_t* AES::decryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[]
     ::memset(out, 0x00U, inLen);
     uint8_t block[BLOCK_BYTES_LEN];
     uint8_t encryptedBlock[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
 
-    keyExpansion(key, roundKeys);
+    setKey(key);
     ::memcpy(block, iv, BLOCK_BYTES_LEN);
     for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        encryptBlock(block, encryptedBlock, roundKeys);
+        encryptBlocks(block, encryptedBlock, 1U);
         xorBlocks(in + i, encryptedBlock, out + i, BLOCK_BYTES_LEN);
         ::memcpy(block, in + i, BLOCK_BYTES_LEN);
     }
 
-    delete[] roundKeys;
     return out;
 }
 
+/* Encrypt input buffer with the current key in AES-ECB. */
+
+bool AES::encryptECB(const uint8_t in[], uint8_t out[], uint32_t inLen)
+{
+    assert(m_hasKey);
+
+    if (inLen % BLOCK_BYTES_LEN != 0) {
+        LogDebugEx(LOG_HOST, "AES::encryptECB()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
+        return false;
+    }
+
+    encryptBlocks(in, out, inLen / BLOCK_BYTES_LEN);
+    return true;
+}
+
+/* Decrypt input buffer with the current key in AES-ECB. */
+
+bool AES::decryptECB(const uint8_t in[], uint8_t out[], uint32_t inLen)
+{
+    assert(m_hasKey);
+
+    if (inLen % BLOCK_BYTES_LEN != 0) {
+        LogDebugEx(LOG_HOST, "AES::decryptECB()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
+        return false;
+    }
+
+    decryptBlocks(in, out, inLen / BLOCK_BYTES_LEN);
+    return true;
+}
+
+/* Encrypt input buffer with the current key and given IV in AES-CBC. */
+
+bool AES::encryptCBC(const uint8_t in[], uint8_t out[], uint32_t inLen, const uint8_t* iv)
+{
+    assert(m_hasKey);
+
+    if (inLen % BLOCK_BYTES_LEN != 0) {
+        LogDebugEx(LOG_HOST, "AES::encryptCBC()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
+        return false;
+    }
+
+    uint8_t block[BLOCK_BYTES_LEN];
+    ::memcpy(block, iv, BLOCK_BYTES_LEN);
+    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
+        xorBlocks(block, in + i, block, BLOCK_BYTES_LEN);
+        encryptBlocks(block, out + i, 1U);
+        ::memcpy(block, out + i, BLOCK_BYTES_LEN);
+    }
+
+    return true;
+}
+
+/* Decrypt input buffer with the current key and given IV in AES-CBC. */
+
+bool AES::decryptCBC(const uint8_t in[], uint8_t out[], uint32_t inLen, const uint8_t* iv)
+{
+    assert(m_hasKey);
+
+    if (inLen % BLOCK_BYTES_LEN != 0) {
+        LogDebugEx(LOG_HOST, "AES::decryptCBC()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
+        return false;
+    }
+
+    uint8_t block[BLOCK_BYTES_LEN];
+    uint8_t crypted[BLOCK_BYTES_LEN];
+    ::memcpy(block, iv, BLOCK_BYTES_LEN);
+    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
+        // the ciphertext is kept, the output may overwrite the input
+        ::memcpy(crypted, in + i, BLOCK_BYTES_LEN);
+        decryptBlocks(crypted, out + i, 1U);
+        xorBlocks(block, out + i, out + i, BLOCK_BYTES_LEN);
+        ::memcpy(block, crypted, BLOCK_BYTES_LEN);
+    }
+
+    return true;
+}
+
+/* Encrypt input buffer with the current key and given IV in AES-OFB. */
+
+void AES::encryptOFB(const uint8_t in[], uint8_t out[], uint32_t inLen, const uint8_t* iv)
+{
+    assert(m_hasKey);
+
+    uint8_t block[BLOCK_BYTES_LEN];
+    ::memcpy(block, iv, BLOCK_BYTES_LEN);
+    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
+        encryptBlocks(block, block, 1U);
+
+        uint32_t len = (inLen - i < BLOCK_BYTES_LEN) ? inLen - i : BLOCK_BYTES_LEN;
+        xorBlocks(in + i, block, out + i, len);
+    }
+}
+
+/* Helper to check whether the CPU supports AES-NI. */
+
+bool AES::isHardwareSupported()
+{
+#if defined(AES_NI_SUPPORTED)
+    static const bool supported = []() {
+        uint32_t eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+        if (__get_cpuid(1U, &eax, &ebx, &ecx, &edx) == 0)
+            return false;
+
+        return (ecx & bit_AES) != 0U && (edx & bit_SSE2) != 0U;
+    }();
+
+    return supported;
+#else
+    return false;
+#endif // defined(AES_NI_SUPPORTED)
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
@@ -521,7 +721,7 @@ void AES::invMixColumns(uint8_t state[4][AES_NB]) {
 
 /* */
 
-void AES::addRoundKey(uint8_t state[4][AES_NB], uint8_t* key) 
+void AES::addRoundKey(uint8_t state[4][AES_NB], const uint8_t* key) 
 {
     for (uint32_t i = 0; i < 4; i++) {
         for (uint32_t j = 0; j < AES_NB; j++) {
@@ -609,7 +809,7 @@ void AES::keyExpansion(const uint8_t key[], uint8_t w[]) {
 
 /* */
 
-void AES::encryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys) 
+void AES::encryptBlock(const uint8_t in[], uint8_t out[], const uint8_t* roundKeys) 
 {
     uint8_t state[4][AES_NB];
     for (uint32_t i = 0; i < 4; i++) {
@@ -640,7 +840,7 @@ void AES::encryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys)
 
 /* */
 
-void AES::decryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys) 
+void AES::decryptBlock(const uint8_t in[], uint8_t out[], const uint8_t* roundKeys) 
 {
     uint8_t state[4][AES_NB];
     for (uint32_t i = 0; i < 4; i++) {
@@ -669,6 +869,38 @@ void AES::decryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys)
     }
 }
 
+/* Helper to encrypt blocks with the current key schedule. */
+
+void AES::encryptBlocks(const uint8_t in[], uint8_t out[], uint32_t blocks)
+{
+#if defined(AES_NI_SUPPORTED)
+    if (m_useHardware) {
+        aesniEncryptBlocks(m_roundKeys, m_Nr, in, out, blocks);
+        return;
+    }
+#endif // defined(AES_NI_SUPPORTED)
+
+    for (uint32_t i = 0; i < blocks; i++) {
+        encryptBlock(in + (i * BLOCK_BYTES_LEN), out + (i * BLOCK_BYTES_LEN), m_roundKeys);
+    }
+}
+
+/* Helper to decrypt blocks with the current key schedule. */
+
+void AES::decryptBlocks(const uint8_t in[], uint8_t out[], uint32_t blocks)
+{
+#if defined(AES_NI_SUPPORTED)
+    if (m_useHardware) {
+        aesniDecryptBlocks(m_invRoundKeys, m_Nr, in, out, blocks);
+        return;
+    }
+#endif // defined(AES_NI_SUPPORTED)
+
+    for (uint32_t i = 0; i < blocks; i++) {
+        decryptBlock(in + (i * BLOCK_BYTES_LEN), out + (i * BLOCK_BYTES_LEN), m_roundKeys);
+    }
+}
+
 /* */
 
 void AES::xorBlocks(const uint8_t *a, const uint8_t *b, uint8_t *c, uint32_t len) 
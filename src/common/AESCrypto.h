@@ -30,6 +30,8 @@ namespace crypto
     // ---------------------------------------------------------------------------
 
     const uint8_t AES_NB = 4;
+    const uint32_t AES_MAX_KEY_BYTES = 32U;
+    const uint32_t AES_MAX_ROUND_KEY_BYTES = 4U * AES_NB * 15U;
 
     /**
      * @brief Enumeration of AES key lengths.
@@ -43,6 +45,10 @@ namespace crypto
 
     /**
      * @brief Advanced Encryption Standard Algorithm.
+     * @note The expanded key schedule of the last key used is kept, and is only expanded again when a different
+     *  key is used. When the CPU supports AES-NI, blocks are encrypted and decrypted using AES-NI instead of the
+     *  portable implementation. An instance may be used by multiple threads concurrently, as long as the key is
+     *  not changed while it is in use.
      * @ingroup crypto
      */
     class HOST_SW_API AES {
@@ -50,8 +56,72 @@ namespace crypto
         /**
          * @brief Initializes a new instance of the AES class.
          * @param keyLength Encryption key length from the AESKeyLength enumeration.
+         * @param useHardware Flag indicating AES-NI is used when the CPU supports it.
          */
-        explicit AES(const AESKeyLength keyLength = AESKeyLength::AES_256);
+        explicit AES(const AESKeyLength keyLength = AESKeyLength::AES_256, bool useHardware = true);
+
+        /**
+         * @brief Sets the encryption key, and expands the key schedule.
+         * @note If the key is the same as the current key, the current key schedule is kept.
+         * @param key Encryption key.
+         */
+        void setKey(const uint8_t key[]);
+
+        /**
+         * @brief Encrypt input buffer with the current key in AES-ECB.
+         * @param in Input buffer.
+         * @param out Output buffer (may be the same as the input buffer).
+         * @param inLen Input buffer length.
+         * @returns bool True, if the input buffer was encrypted, otherwise false.
+         */
+        bool encryptECB(const uint8_t in[], uint8_t out[], uint32_t inLen);
+        /**
+         * @brief Decrypt input buffer with the current key in AES-ECB.
+         * @param in Input buffer.
+         * @param out Output buffer (may be the same as the input buffer).
+         * @param inLen Input buffer length.
+         * @returns bool True, if the input buffer was decrypted, otherwise false.
+         */
+        bool decryptECB(const uint8_t in[], uint8_t out[], uint32_t inLen);
+
+        /**
+         * @brief Encrypt input buffer with the current key and given IV in AES-CBC.
+         * @param in Input buffer.
+         * @param out Output buffer (may be the same as the input buffer).
+         * @param inLen Input buffer length.
+         * @param iv Initialization Vector buffer.
+         * @returns bool True, if the input buffer was encrypted, otherwise false.
+         */
+        bool encryptCBC(const uint8_t in[], uint8_t out[], uint32_t inLen, const uint8_t* iv);
+        /**
+         * @brief Decrypt input buffer with the current key and given IV in AES-CBC.
+         * @param in Input buffer.
+         * @param out Output buffer (may be the same as the input buffer).
+         * @param inLen Input buffer length.
+         * @param iv Initialization Vector buffer.
+         * @returns bool True, if the input buffer was decrypted, otherwise false.
+         */
+        bool decryptCBC(const uint8_t in[], uint8_t out[], uint32_t inLen, const uint8_t* iv);
+
+        /**
+         * @brief Encrypt input buffer with the current key and given IV in AES-OFB.
+         * @note The input buffer does not need to be block aligned. Encrypting a zeroed input buffer generates
+         *  the OFB keystream.
+         * @param in Input buffer.
+         * @param out Output buffer (may be the same as the input buffer).
+         * @param inLen Input buffer length.
+         * @param iv Initialization Vector buffer.
+         */
+        void encryptOFB(const uint8_t in[], uint8_t out[], uint32_t inLen, const uint8_t* iv);
+        /**
+         * @brief Decrypt input buffer with the current key and given IV in AES-OFB.
+         * @note The input buffer does not need to be block aligned.
+         * @param in Input buffer.
+         * @param out Output buffer (may be the same as the input buffer).
+         * @param inLen Input buffer length.
+         * @param iv Initialization Vector buffer.
+         */
+        void decryptOFB(const uint8_t in[], uint8_t out[], uint32_t inLen, const uint8_t* iv) { encryptOFB(in, out, inLen, iv); }
 
         /**
          * @brief Encrypt input buffer with given key in AES-ECB.
@@ -108,12 +178,29 @@ namespace crypto
          */
         uint8_t* decryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t* iv);
 
+        /**
+         * @brief Helper to check whether the CPU supports AES-NI.
+         * @returns bool True, if the CPU supports AES-NI, otherwise false.
+         */
+        static bool isHardwareSupported();
+        /**
+         * @brief Flag indicating whether this instance uses AES-NI.
+         * @returns bool True, if this instance uses AES-NI, otherwise false.
+         */
+        bool isHardwareAccelerated() const { return m_useHardware; }
+
         static constexpr uint32_t BLOCK_BYTES_LEN = 4 * AES_NB * sizeof(uint8_t);
 
     private:
         uint32_t m_Nk;
         uint32_t m_Nr;
 
+        bool m_useHardware;
+        bool m_hasKey;
+        uint8_t m_key[AES_MAX_KEY_BYTES];
+        uint8_t m_roundKeys[AES_MAX_ROUND_KEY_BYTES];
+        uint8_t m_invRoundKeys[AES_MAX_ROUND_KEY_BYTES];
+
         void subBytes(uint8_t state[4][AES_NB]);
         void invSubBytes(uint8_t state[4][AES_NB]);
         void shiftRow(uint8_t state[4][AES_NB], uint32_t i, uint32_t n);  // shift row i on n positions
@@ -124,7 +211,7 @@ namespace crypto
 
         void mixColumns(uint8_t state[4][AES_NB]);
         void invMixColumns(uint8_t state[4][AES_NB]);
-        void addRoundKey(uint8_t state[4][AES_NB], uint8_t* key);
+        void addRoundKey(uint8_t state[4][AES_NB], const uint8_t* key);
 
         void subWord(uint8_t* a);
         void rotWord(uint8_t* a);
@@ -134,8 +221,11 @@ namespace crypto
 
         void keyExpansion(const uint8_t key[], uint8_t w[]);
 
-        void encryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys);
-        void decryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys);
+        void encryptBlock(const uint8_t in[], uint8_t out[], const uint8_t* roundKeys);
+        void decryptBlock(const uint8_t in[], uint8_t out[], const uint8_t* roundKeys);
+
+        void encryptBlocks(const uint8_t in[], uint8_t out[], uint32_t blocks);
+        void decryptBlocks(const uint8_t in[], uint8_t out[], uint32_t blocks);
 
         void xorBlocks(const uint8_t* a, const uint8_t* b, uint8_t* c, uint32_t len);
     };
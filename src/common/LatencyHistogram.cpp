@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "LatencyHistogram.h"
+
+#include <chrono>
+#include <cmath>
+#if defined(_WIN32)
+#include <intrin.h>
+#endif // defined(_WIN32)
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the index of the most significant set bit of a non-zero value. */
+
+static uint32_t msb(uint64_t value)
+{
+#if defined(_WIN32)
+    unsigned long index = 0U;
+    _BitScanReverse64(&index, value);
+    return (uint32_t)index;
+#else
+    return 63U - (uint32_t)__builtin_clzll(value);
+#endif // defined(_WIN32)
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LatencyHistogramSnapshot class. */
+
+LatencyHistogramSnapshot::LatencyHistogramSnapshot() :
+    m_buckets(LATENCY_HISTOGRAM_BUCKETS, 0U),
+    m_count(0U),
+    m_sum(0U),
+    m_max(0U)
+{
+    /* stub */
+}
+
+/* Gets the sample value at the given percentile. */
+
+uint64_t LatencyHistogramSnapshot::percentile(double percentile) const
+{
+    if (m_count == 0U)
+        return 0U;
+
+    if (percentile > 100.0)
+        percentile = 100.0;
+
+    uint64_t target = (uint64_t)std::ceil((percentile / 100.0) * (double)m_count);
+    if (target == 0U)
+        target = 1U;
+
+    uint64_t total = 0U;
+    for (uint32_t i = 0U; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        total += m_buckets[i];
+        if (total >= target) {
+            uint64_t value = LatencyHistogram::bucketUpperBound(i);
+            return (value < m_max) ? value : m_max;
+        }
+    }
+
+    return m_max;
+}
+
+/* Gets the samples recorded since an earlier snapshot of the same histogram. */
+
+LatencyHistogramSnapshot LatencyHistogramSnapshot::since(const LatencyHistogramSnapshot& prev) const
+{
+    LatencyHistogramSnapshot delta;
+    for (uint32_t i = 0U; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        // a reset between the snapshots leaves fewer samples than the earlier snapshot
+        uint64_t count = (m_buckets[i] >= prev.m_buckets[i]) ? m_buckets[i] - prev.m_buckets[i] : m_buckets[i];
+        delta.m_buckets[i] = count;
+        delta.m_count += count;
+        if (count > 0U)
+            delta.m_max = LatencyHistogram::bucketUpperBound(i);
+    }
+
+    delta.m_sum = (m_sum >= prev.m_sum) ? m_sum - prev.m_sum : m_sum;
+    if (delta.m_max > m_max)
+        delta.m_max = m_max;
+
+    return delta;
+}
+
+/* Initializes a new instance of the LatencyHistogram class. */
+
+LatencyHistogram::LatencyHistogram(const std::string& name) :
+    m_name(name),
+    m_shards(nullptr)
+{
+    m_shards = new Shard[LATENCY_HISTOGRAM_SHARDS];
+    reset();
+}
+
+/* Finalizes a instance of the LatencyHistogram class. */
+
+LatencyHistogram::~LatencyHistogram()
+{
+    delete[] m_shards;
+}
+
+/* Gets the current monotonic time in microseconds. */
+
+uint64_t LatencyHistogram::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Records a sample. */
+
+void LatencyHistogram::record(uint64_t value)
+{
+    Shard& shard = m_shards[threadShard()];
+    shard.buckets[bucketIndex(value)].fetch_add(1U, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t curr = shard.max.load(std::memory_order_relaxed);
+    while (value > curr && !shard.max.compare_exchange_weak(curr, value, std::memory_order_relaxed));
+}
+
+/* Records the time elapsed since the given monotonic time. */
+
+void LatencyHistogram::recordSince(uint64_t start)
+{
+    uint64_t end = now();
+    record((end > start) ? end - start : 0U);
+}
+
+/* Takes a snapshot of the samples recorded by the histogram. */
+
+LatencyHistogramSnapshot LatencyHistogram::snapshot() const
+{
+    LatencyHistogramSnapshot snapshot;
+    for (uint32_t s = 0U; s < LATENCY_HISTOGRAM_SHARDS; s++) {
+        const Shard& shard = m_shards[s];
+        for (uint32_t i = 0U; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+            uint64_t count = shard.buckets[i].load(std::memory_order_relaxed);
+            snapshot.m_buckets[i] += count;
+            snapshot.m_count += count;
+        }
+
+        snapshot.m_sum += shard.sum.load(std::memory_order_relaxed);
+
+        uint64_t max = shard.max.load(std::memory_order_relaxed);
+        if (max > snapshot.m_max)
+            snapshot.m_max = max;
+    }
+
+    return snapshot;
+}
+
+/* Clears all samples recorded by the histogram. */
+
+void LatencyHistogram::reset()
+{
+    for (uint32_t s = 0U; s < LATENCY_HISTOGRAM_SHARDS; s++) {
+        Shard& shard = m_shards[s];
+        for (uint32_t i = 0U; i < LATENCY_HISTOGRAM_BUCKETS; i++)
+            shard.buckets[i].store(0U, std::memory_order_relaxed);
+
+        shard.sum.store(0U, std::memory_order_relaxed);
+        shard.max.store(0U, std::memory_order_relaxed);
+    }
+}
+
+/* Helper to get the bucket index for a sample value. */
+
+uint32_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+    // values below the first magnitude are counted exactly
+    if (value < LATENCY_HISTOGRAM_SUB_BUCKETS)
+        return (uint32_t)value;
+
+    uint32_t bit = msb(value);
+    uint32_t magnitude = bit - LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 1U;
+    if (magnitude >= LATENCY_HISTOGRAM_MAGNITUDES)
+        return LATENCY_HISTOGRAM_BUCKETS - 1U;
+
+    // the sub-bucket is given by the bits directly below the most significant bit
+    uint32_t subBucket = (uint32_t)(value >> (bit - LATENCY_HISTOGRAM_SUB_BUCKET_BITS)) - LATENCY_HISTOGRAM_SUB_BUCKETS;
+    return (magnitude * LATENCY_HISTOGRAM_SUB_BUCKETS) + subBucket;
+}
+
+/* Helper to get the highest sample value counted by a bucket. */
+
+uint64_t LatencyHistogram::bucketUpperBound(uint32_t index)
+{
+    uint32_t magnitude = index / LATENCY_HISTOGRAM_SUB_BUCKETS;
+    uint32_t subBucket = index % LATENCY_HISTOGRAM_SUB_BUCKETS;
+    if (magnitude == 0U)
+        return subBucket;
+
+    return ((uint64_t)(LATENCY_HISTOGRAM_SUB_BUCKETS + subBucket + 1U) << (magnitude - 1U)) - 1U;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Gets the shard assigned to the calling thread. */
+
+uint32_t LatencyHistogram::threadShard()
+{
+    static std::atomic<uint32_t> nextShard(0U);
+    static thread_local uint32_t shard = nextShard.fetch_add(1U, std::memory_order_relaxed) % LATENCY_HISTOGRAM_SHARDS;
+    return shard;
+}
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LatencyHistogram.h
+ * @ingroup timers
+ * @file LatencyHistogram.cpp
+ * @ingroup timers
+ */
+#if !defined(__LATENCY_HISTOGRAM_H__)
+#define __LATENCY_HISTOGRAM_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup timers
+ * @{
+ */
+
+const uint32_t LATENCY_HISTOGRAM_SUB_BUCKET_BITS = 4U;
+const uint32_t LATENCY_HISTOGRAM_SUB_BUCKETS = 1U << LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+const uint32_t LATENCY_HISTOGRAM_MAGNITUDES = 33U;
+const uint32_t LATENCY_HISTOGRAM_BUCKETS = LATENCY_HISTOGRAM_MAGNITUDES * LATENCY_HISTOGRAM_SUB_BUCKETS;
+const uint32_t LATENCY_HISTOGRAM_SHARDS = 16U;
+
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Point-in-time copy of the samples recorded by a latency histogram.
+ * @ingroup timers
+ */
+class HOST_SW_API LatencyHistogramSnapshot {
+public:
+    /**
+     * @brief Initializes a new instance of the LatencyHistogramSnapshot class.
+     */
+    LatencyHistogramSnapshot();
+
+    /**
+     * @brief Gets the total number of samples.
+     * @returns uint64_t Total number of samples.
+     */
+    uint64_t count() const { return m_count; }
+    /**
+     * @brief Gets the mean sample value.
+     * @returns uint64_t Mean sample value.
+     */
+    uint64_t mean() const { return (m_count > 0U) ? m_sum / m_count : 0U; }
+    /**
+     * @brief Gets the largest sample value.
+     * @returns uint64_t Largest sample value.
+     */
+    uint64_t max() const { return m_max; }
+
+    /**
+     * @brief Gets the sample value at the given percentile.
+     * @note The returned value is the highest value equivalent (within the histogram precision) to the
+     *  sample at the given percentile, and is never larger than the largest sample.
+     * @param percentile Percentile (0.0 - 100.0).
+     * @returns uint64_t Sample value at the given percentile.
+     */
+    uint64_t percentile(double percentile) const;
+
+    /**
+     * @brief Gets the samples recorded since an earlier snapshot of the same histogram.
+     * @note The largest sample of the interval is not tracked exactly, it is estimated from the highest
+     *  populated bucket.
+     * @param prev Earlier snapshot of the same histogram.
+     * @returns LatencyHistogramSnapshot Snapshot of the samples recorded since the earlier snapshot.
+     */
+    LatencyHistogramSnapshot since(const LatencyHistogramSnapshot& prev) const;
+
+private:
+    friend class LatencyHistogram;
+
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count;
+    uint64_t m_sum;
+    uint64_t m_max;
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a low-overhead, log-linear (HDR-style) histogram of latency samples.
+ * @note Samples (generally microseconds) are counted into buckets that double in width every
+ *  LATENCY_HISTOGRAM_SUB_BUCKETS buckets, which keeps the precision of every bucket within ~6% of the
+ *  sample value from 1us up to over an hour. Recording a sample never locks or allocates; each thread records
+ *  into its own shard of buckets (shards are spread across LATENCY_HISTOGRAM_SHARDS per-thread slots) and
+ *  the shards are only merged when a snapshot is taken.
+ * @ingroup timers
+ */
+class HOST_SW_API LatencyHistogram {
+public:
+    auto operator=(LatencyHistogram&) -> LatencyHistogram& = delete;
+    auto operator=(LatencyHistogram&&) -> LatencyHistogram& = delete;
+    LatencyHistogram(LatencyHistogram&) = delete;
+
+    /**
+     * @brief Initializes a new instance of the LatencyHistogram class.
+     * @param name Name of the histogram.
+     */
+    LatencyHistogram(const std::string& name);
+    /**
+     * @brief Finalizes a instance of the LatencyHistogram class.
+     */
+    ~LatencyHistogram();
+
+    /**
+     * @brief Gets the current monotonic time in microseconds.
+     * @returns uint64_t Current monotonic time in microseconds.
+     */
+    static uint64_t now();
+
+    /**
+     * @brief Records a sample.
+     * @param value Sample value.
+     */
+    void record(uint64_t value);
+    /**
+     * @brief Records the time elapsed since the given monotonic time.
+     * @param start Monotonic start time in microseconds (see now()).
+     */
+    void recordSince(uint64_t start);
+
+    /**
+     * @brief Takes a snapshot of the samples recorded by the histogram.
+     * @returns LatencyHistogramSnapshot Snapshot of the recorded samples.
+     */
+    LatencyHistogramSnapshot snapshot() const;
+    /**
+     * @brief Clears all samples recorded by the histogram.
+     * @note Samples recorded concurrently with a reset may be partially cleared.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the name of the histogram.
+     * @returns std::string Name of the histogram.
+     */
+    std::string name() const { return m_name; }
+
+    /**
+     * @brief Helper to get the bucket index for a sample value.
+     * @param value Sample value.
+     * @returns uint32_t Bucket index.
+     */
+    static uint32_t bucketIndex(uint64_t value);
+    /**
+     * @brief Helper to get the highest sample value counted by a bucket.
+     * @param index Bucket index.
+     * @returns uint64_t Highest sample value counted by the bucket.
+     */
+    static uint64_t bucketUpperBound(uint32_t index);
+
+private:
+    /**
+     * @brief Samples recorded by a group of threads.
+     */
+    struct Shard {
+        std::atomic<uint64_t> buckets[LATENCY_HISTOGRAM_BUCKETS];
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+    };
+
+    std::string m_name;
+    Shard* m_shards;
+
+    /**
+     * @brief Gets the shard assigned to the calling thread.
+     * @returns uint32_t Shard index.
+     */
+    static uint32_t threadShard();
+};
+
+#endif // __LATENCY_HISTOGRAM_H__
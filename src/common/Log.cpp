@@ -9,6 +9,7 @@
  *
  */
 #include "Log.h"
+#include "Thread.h"
 #include "network/BaseNetwork.h"
 
 #if defined(_WIN32)
@@ -22,6 +23,10 @@
 #include <catch2/catch_test_macros.hpp>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstdarg>
@@ -29,6 +34,8 @@
 #include <cassert>
 #include <cstring>
 #include <iostream>
+#include <mutex>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -38,6 +45,9 @@
 
 const uint32_t LOG_BUFFER_LEN = 4096U;
 
+const uint32_t LOG_ASYNC_WRITER_INTERVAL = 10U; // ms
+const uint32_t LOG_RATE_LIMIT_SLOTS = 4096U;
+
 // ---------------------------------------------------------------------------
 //  Global Variables
 // ---------------------------------------------------------------------------
@@ -61,6 +71,125 @@ static std::ostream m_outStream { std::cerr.rdbuf() };
 
 static char LEVELS[] = " DMIWEF";
 
+static std::atomic<uint32_t> m_rateLimit(0U);
+static std::atomic<uint64_t> m_rateLimited(0U);
+
+static std::atomic<bool> m_asyncRunning(false);
+static bool m_asyncDropOnOverflow = true;
+static uint32_t m_asyncBufferLen = LOG_ASYNC_DEFAULT_BUFFER_LEN;
+static thread_t m_asyncWriter;
+static std::mutex m_asyncMutex;
+static std::mutex m_asyncStopMutex;
+static std::mutex m_asyncFlushMutex;
+static std::condition_variable m_asyncCond;
+static std::atomic<bool> m_asyncSignalled(false);
+
+static std::atomic<uint64_t> m_asyncSequence(0U);
+static std::atomic<uint64_t> m_asyncWritten(0U);
+static std::atomic<uint64_t> m_asyncDropped(0U);
+static uint64_t m_asyncDroppedReported = 0U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Header of a log entry queued for the log writer thread.
+ */
+struct LogQueueEntry {
+    uint64_t seq;                       //! Sequence number of the entry.
+    uint32_t level;                     //! Log level of the entry.
+    uint32_t length;                    //! Length of the entry text (which directly follows the header).
+};
+
+/**
+ * @brief States of a log entry queue.
+ */
+enum LOG_QUEUE_STATE {
+    LOG_QUEUE_ACTIVE,                   //! Queue is owned by a thread.
+    LOG_QUEUE_RELEASED,                 //! Owning thread has exited, the queue may still hold entries.
+    LOG_QUEUE_FREEING,                  //! Log writer is freeing the ring buffer of the queue.
+    LOG_QUEUE_FREED                     //! Ring buffer of the queue has been freed.
+};
+
+/**
+ * @brief Single-producer, single-consumer ring buffer of log entries written by a single thread.
+ * @note When the owning thread exits, the queue is released. The ring buffer of a released queue is freed once
+ *  the log writer has written everything queued in it, and the queue (without its ring buffer) is reused by
+ *  the next thread that needs a queue.
+ */
+struct LogThreadQueue {
+    /**
+     * @brief Initializes a new instance of the LogThreadQueue structure.
+     * @param length Length of the ring buffer (a power of 2).
+     */
+    LogThreadQueue(uint32_t length) :
+        buffer(new uint8_t[length]),
+        length(length),
+        head(0U),
+        pad(),
+        tail(0U),
+        state(LOG_QUEUE_ACTIVE),
+        next(nullptr)
+    {
+        /* stub */
+    }
+
+    uint8_t* buffer;                    //! Ring buffer.
+    uint32_t length;                    //! Length of ring buffer.
+
+    // head and tail are kept on separate cache lines, so the owning thread and the log writer thread don't
+    // contend for the same cache line
+    std::atomic<uint64_t> head;         //! Write position (only written by the owning thread).
+    uint8_t pad[64U];
+    std::atomic<uint64_t> tail;         //! Read position (only written by the log writer thread).
+
+    std::atomic<uint32_t> state;        //! State of the queue (see LOG_QUEUE_STATE).
+    LogThreadQueue* next;               //! Next queue in the list of queues.
+};
+
+/**
+ * @brief Thread local reference to the log entry queue of a thread, releases the queue when the thread exits.
+ */
+struct LogThreadQueueRef {
+    /**
+     * @brief Finalizes a instance of the LogThreadQueueRef structure.
+     */
+    ~LogThreadQueueRef()
+    {
+        if (queue != nullptr)
+            queue->state.store(LOG_QUEUE_RELEASED, std::memory_order_release);
+    }
+
+    LogThreadQueue* queue = nullptr;    //! Log entry queue of the thread.
+};
+
+/**
+ * @brief Log entry read from the log entry queues by the log writer thread.
+ */
+struct LogBatchEntry {
+    uint64_t seq;                       //! Sequence number of the entry.
+    uint32_t level;                     //! Log level of the entry.
+    uint32_t offset;                    //! Offset of the entry text in the batch text buffer.
+    uint32_t length;                    //! Length of the entry text.
+};
+
+/**
+ * @brief Per call site log rate limiting state.
+ */
+struct LogRateSlot {
+    std::atomic<const char*> site;      //! Call site (format string) owning this slot.
+    std::atomic<uint64_t> window;       //! Current rate limit window (in seconds).
+    std::atomic<uint32_t> count;        //! Number of entries logged in the current window.
+    std::atomic<uint32_t> suppressed;   //! Number of entries suppressed since the last logged entry.
+};
+
+static std::atomic<LogThreadQueue*> m_asyncQueues(nullptr);
+static LogRateSlot m_rateSlots[LOG_RATE_LIMIT_SLOTS];
+
+static std::vector<LogBatchEntry> m_asyncBatch;
+static std::string m_asyncText;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -139,77 +268,10 @@ static bool LogOpen()
     }
 }
 
-/* Internal helper to set an output stream to direct logging to. */
-
-void __InternalOutputStream(std::ostream& stream)
-{
-    m_outStream.rdbuf(stream.rdbuf());
-}
-
-/* Gets the instance of the Network class to transfer the activity log with. */
-
-void* LogGetNetwork()
-{
-    // NO GOOD, VERY BAD, TERRIBLE HACK
-    return (void*)m_network;
-}
-
-/* Sets the instance of the Network class to transfer the activity log with. */
-
-void LogSetNetwork(void* network)
-{
-#if defined(CATCH2_TEST_COMPILATION)
-    return;
-#endif
-    // note: The Network class is passed here as a void so we can avoid including the Network.h
-    // header in Log.h. This is dirty and probably terrible...
-    m_network = (network::BaseNetwork*)network;
-}
-
-/* Initializes the diagnostics log. */
-
-bool LogInitialise(const std::string& filePath, const std::string& fileRoot, uint32_t fileLevel, uint32_t displayLevel, bool disableTimeDisplay, bool useSyslog)
-{
-    m_filePath = filePath;
-    m_fileRoot = fileRoot;
-    m_fileLevel = fileLevel;
-    g_logDisplayLevel = displayLevel;
-    g_disableTimeDisplay = disableTimeDisplay;
-#if defined(_WIN32)
-    g_useSyslog = false;
-#else
-    if (!g_useSyslog)
-        g_useSyslog = useSyslog;
-#endif // defined(_WIN32)
-    return ::LogOpen();
-}
-
-/* Finalizes the diagnostics log. */
-
-void LogFinalise()
-{
-#if defined(CATCH2_TEST_COMPILATION)
-    return;
-#endif
-    if (m_fpLog != nullptr) {
-        ::fclose(m_fpLog);
-        m_fpLog = nullptr;
-    }
-#if !defined(_WIN32)
-    if (g_useSyslog)
-        closelog();
-#endif // !defined(_WIN32)
-}
-
-/* Writes a new entry to the diagnostics log. */
+/* Helper to format the prefix of a log entry. */
 
-void Log(uint32_t level, const char *module, const char* file, const int lineNo, const char* func, const char* fmt, ...)
+static void LogPrefix(char* buffer, uint32_t level, const char* module, const char* file, const int lineNo, const char* func)
 {
-    assert(fmt != nullptr);
-#if defined(CATCH2_TEST_COMPILATION)
-    g_disableTimeDisplay = true;
-#endif
-    char buffer[LOG_BUFFER_LEN];
     if (!g_disableTimeDisplay && !g_useSyslog) {
         time_t now;
         ::time(&now);
@@ -300,25 +362,512 @@ void Log(uint32_t level, const char *module, const char* file, const int lineNo,
         }
     }
 
-    va_list vl, vl_len;
-    va_start(vl, fmt);
-    va_copy(vl_len, vl);
+}
 
-    size_t len = ::vsnprintf(nullptr, 0U, fmt, vl_len);
-    ::vsnprintf(buffer + ::strlen(buffer), len + 1U, fmt, vl);
+/* Helper to write a log entry to the log file (or syslog). */
+
+static void LogWriteFile(uint32_t level, const char* buffer)
+{
+    if (!g_useSyslog) {
+        bool ret = ::LogOpen();
+        if (!ret)
+            return;
 
-    va_end(vl_len);
+        if (m_fpLog != nullptr) {
+            ::fprintf(m_fpLog, "%s\n", buffer);
+            ::fflush(m_fpLog);
+        }
+    } else {
+#if !defined(_WIN32)
+        // convert our log level into syslog level
+        int syslogLevel = LOG_INFO;
+        switch (level) {
+        case 1U:
+            syslogLevel = LOG_DEBUG;
+            break;
+        case 2U:
+            syslogLevel = LOG_NOTICE;
+            break;
+        case 3U:
+        case 9999U: // in-band U: messages should also be info level
+            syslogLevel = LOG_INFO;
+            break;
+        case 4U:
+            syslogLevel = LOG_WARNING;
+            break;
+        case 5U:
+            syslogLevel = LOG_ERR;
+            break;
+        default:
+            syslogLevel = LOG_EMERG;
+            break;
+        }
+
+        syslog(syslogLevel, "%s", buffer);
+#endif // !defined(_WIN32)
+    }
+}
+
+/* Helper to check whether a log entry from the given call site exceeds the rate limit. */
+
+static bool LogRateLimited(const char* site, uint32_t& suppressed)
+{
+    suppressed = 0U;
+
+    uint32_t limit = m_rateLimit.load(std::memory_order_relaxed);
+    if (limit == 0U)
+        return false;
+
+    // call sites are identified by their format string; call sites hashing to the same slot evict each other,
+    // so the limit is approximate
+    uintptr_t hash = (uintptr_t)site;
+    hash ^= hash >> 17;
+    hash *= 0x9E3779B1U;
+    LogRateSlot& slot = m_rateSlots[(hash >> 8) & (LOG_RATE_LIMIT_SLOTS - 1U)];
+
+    uint64_t now = (uint64_t)std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    if (slot.site.load(std::memory_order_relaxed) != site) {
+        slot.site.store(site, std::memory_order_relaxed);
+        slot.window.store(now, std::memory_order_relaxed);
+        slot.count.store(0U, std::memory_order_relaxed);
+        slot.suppressed.store(0U, std::memory_order_relaxed);
+    }
+
+    uint64_t window = slot.window.load(std::memory_order_relaxed);
+    if (window != now && slot.window.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+        slot.count.store(0U, std::memory_order_relaxed);
+    }
+
+    if (slot.count.fetch_add(1U, std::memory_order_relaxed) >= limit) {
+        slot.suppressed.fetch_add(1U, std::memory_order_relaxed);
+        m_rateLimited.fetch_add(1U, std::memory_order_relaxed);
+        return true;
+    }
+
+    suppressed = slot.suppressed.exchange(0U, std::memory_order_relaxed);
+    return false;
+}
+
+/* Helper to get the log entry queue of the calling thread. */
+
+static LogThreadQueue* LogGetThreadQueue()
+{
+    static thread_local LogThreadQueueRef ref;
+    if (ref.queue != nullptr)
+        return ref.queue;
+
+    // reuse a queue released by a thread that has exited
+    for (LogThreadQueue* queue = m_asyncQueues.load(std::memory_order_acquire); queue != nullptr; queue = queue->next) {
+        uint32_t state = LOG_QUEUE_RELEASED;
+        if (queue->state.load(std::memory_order_relaxed) == LOG_QUEUE_RELEASED &&
+            queue->state.compare_exchange_strong(state, LOG_QUEUE_ACTIVE, std::memory_order_acquire)) {
+            ref.queue = queue;
+            return queue;
+        }
+
+        // the ring buffer of a freed queue is reallocated, the queue is empty so its positions are kept
+        state = LOG_QUEUE_FREED;
+        if (queue->state.load(std::memory_order_relaxed) == LOG_QUEUE_FREED &&
+            queue->state.compare_exchange_strong(state, LOG_QUEUE_ACTIVE, std::memory_order_acquire)) {
+            queue->buffer = new uint8_t[m_asyncBufferLen];
+            queue->length = m_asyncBufferLen;
+            ref.queue = queue;
+            return queue;
+        }
+    }
+
+    LogThreadQueue* queue = new LogThreadQueue(m_asyncBufferLen);
+    queue->next = m_asyncQueues.load(std::memory_order_relaxed);
+    while (!m_asyncQueues.compare_exchange_weak(queue->next, queue, std::memory_order_release, std::memory_order_relaxed));
+
+    ref.queue = queue;
+    return queue;
+}
+
+/* Helper to copy data into a log entry queue. */
+
+static void LogQueueWrite(LogThreadQueue* queue, uint64_t pos, const void* data, uint32_t length)
+{
+    uint32_t offset = (uint32_t)(pos & (queue->length - 1U));
+    uint32_t first = std::min(length, queue->length - offset);
+    ::memcpy(queue->buffer + offset, data, first);
+    if (length > first)
+        ::memcpy(queue->buffer, (const uint8_t*)data + first, length - first);
+}
+
+/* Helper to copy data out of a log entry queue. */
+
+static void LogQueueRead(LogThreadQueue* queue, uint64_t pos, void* data, uint32_t length)
+{
+    uint32_t offset = (uint32_t)(pos & (queue->length - 1U));
+    uint32_t first = std::min(length, queue->length - offset);
+    ::memcpy(data, queue->buffer + offset, first);
+    if (length > first)
+        ::memcpy((uint8_t*)data + first, queue->buffer, length - first);
+}
+
+static void LogFlushPending();
+
+/* Helper to queue a log entry for the log writer thread. */
+
+static void LogEnqueue(uint32_t level, const char* buffer)
+{
+    LogThreadQueue* queue = LogGetThreadQueue();
+
+    LogQueueEntry entry;
+    entry.level = level;
+    entry.length = (uint32_t)::strlen(buffer);
+    uint32_t length = sizeof(LogQueueEntry) + entry.length;
+
+    uint64_t head = queue->head.load(std::memory_order_relaxed);
+    while (queue->length - (uint32_t)(head - queue->tail.load(std::memory_order_acquire)) < length) {
+        if (m_asyncDropOnOverflow) {
+            m_asyncDropped.fetch_add(1U, std::memory_order_relaxed);
+            return;
+        }
+
+        // if the log writer has stopped, make room by writing the queued entries from this thread
+        if (!m_asyncRunning.load()) {
+            LogFlushPending();
+            continue;
+        }
+
+        // wake the log writer and wait for it to make room
+        m_asyncSignalled.store(true);
+        m_asyncCond.notify_one();
+        Thread::sleep(1U);
+    }
+
+    entry.seq = m_asyncSequence.fetch_add(1U, std::memory_order_relaxed);
+    LogQueueWrite(queue, head, &entry, sizeof(LogQueueEntry));
+    LogQueueWrite(queue, head + sizeof(LogQueueEntry), buffer, entry.length);
+
+    queue->head.store(head + length, std::memory_order_release);
+
+    // the log writer may have been stopped after this thread decided to queue the entry, and may have already
+    // written the queued entries for the last time; either the final write sees this entry, or this thread
+    // sees the log writer stopped and writes the entry itself
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_asyncRunning.load())
+        LogFlushPending();
+}
+
+/* Helper to write all queued log entries. */
+
+static void LogFlushQueues(std::vector<LogBatchEntry>& batch, std::string& text)
+{
+    batch.clear();
+    text.clear();
+
+    // gather what is currently queued by every thread
+    for (LogThreadQueue* queue = m_asyncQueues.load(std::memory_order_acquire); queue != nullptr; queue = queue->next) {
+        uint64_t tail = queue->tail.load(std::memory_order_relaxed);
+        uint64_t head = queue->head.load(std::memory_order_acquire);
+        while (tail != head) {
+            LogQueueEntry entry;
+            LogQueueRead(queue, tail, &entry, sizeof(LogQueueEntry));
+
+            LogBatchEntry batchEntry;
+            batchEntry.seq = entry.seq;
+            batchEntry.level = entry.level;
+            batchEntry.offset = (uint32_t)text.size();
+            batchEntry.length = entry.length;
+
+            text.resize(text.size() + entry.length + 1U);
+            LogQueueRead(queue, tail + sizeof(LogQueueEntry), &text[batchEntry.offset], entry.length);
+            text[batchEntry.offset + entry.length] = '\0';
+
+            batch.push_back(batchEntry);
+            tail += sizeof(LogQueueEntry) + entry.length;
+        }
+
+        queue->tail.store(tail, std::memory_order_release);
+
+        // free the ring buffer of a drained queue whose thread has exited
+        uint32_t state = LOG_QUEUE_RELEASED;
+        if (queue->state.load(std::memory_order_acquire) == LOG_QUEUE_RELEASED &&
+            queue->head.load(std::memory_order_acquire) == tail &&
+            queue->state.compare_exchange_strong(state, LOG_QUEUE_FREEING, std::memory_order_acquire)) {
+            delete[] queue->buffer;
+            queue->buffer = nullptr;
+            queue->state.store(LOG_QUEUE_FREED, std::memory_order_release);
+        }
+    }
+
+    // report entries dropped because a queue was full
+    uint64_t dropped = m_asyncDropped.load(std::memory_order_relaxed);
+    if (dropped != m_asyncDroppedReported) {
+        char buffer[LOG_BUFFER_LEN];
+        LogPrefix(buffer, 4U, nullptr, nullptr, 0, nullptr);
+        ::sprintf(buffer + ::strlen(buffer), "Log buffer overflow, %llu log entries dropped", (unsigned long long)(dropped - m_asyncDroppedReported));
+        m_asyncDroppedReported = dropped;
+
+        LogBatchEntry batchEntry;
+        batchEntry.seq = m_asyncSequence.fetch_add(1U, std::memory_order_relaxed);
+        batchEntry.level = 4U;
+        batchEntry.offset = (uint32_t)text.size();
+        batchEntry.length = (uint32_t)::strlen(buffer);
+        text.append(buffer, batchEntry.length + 1U);
+        batch.push_back(batchEntry);
+    }
+
+    if (batch.empty())
+        return;
+
+    // entries from different threads are merged back into the order they were logged
+    std::sort(batch.begin(), batch.end(), [](const LogBatchEntry& a, const LogBatchEntry& b) { return a.seq < b.seq; });
+
+    std::string fileOut, displayOut;
+    for (const LogBatchEntry& entry : batch) {
+        const char* buffer = text.c_str() + entry.offset;
+        if (entry.level >= m_fileLevel && m_fileLevel != 0U) {
+            if (!g_useSyslog) {
+                fileOut.append(buffer, entry.length);
+                fileOut.append("\n");
+            }
+            else {
+                LogWriteFile(entry.level, buffer);
+            }
+        }
+
+        if (!g_useSyslog && entry.level >= g_logDisplayLevel && g_logDisplayLevel != 0U) {
+            displayOut.append(buffer, entry.length);
+            displayOut.append(EOL);
+        }
+    }
+
+    // write the whole batch with a single write and flush
+    if (!fileOut.empty() && ::LogOpen() && m_fpLog != nullptr) {
+        ::fwrite(fileOut.c_str(), 1U, fileOut.size(), m_fpLog);
+        ::fflush(m_fpLog);
+    }
+
+    if (!displayOut.empty()) {
+        ::fwrite(displayOut.c_str(), 1U, displayOut.size(), stdout);
+        ::fflush(stdout);
+    }
+
+    m_asyncWritten.fetch_add(batch.size(), std::memory_order_relaxed);
+}
+
+/* Helper to write all queued log entries, from any thread. */
+
+static void LogFlushPending()
+{
+    std::lock_guard<std::mutex> lock(m_asyncFlushMutex);
+    LogFlushQueues(m_asyncBatch, m_asyncText);
+}
+
+/* Entry point to the log writer thread. */
+
+static void* LogWriter(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th == nullptr)
+        return nullptr;
+
+#ifdef _GNU_SOURCE
+    ::pthread_setname_np(th->thread, "log:writer");
+#endif // _GNU_SOURCE
+
+    while (m_asyncRunning.load(std::memory_order_relaxed)) {
+        // scope is intentional
+        {
+            std::unique_lock<std::mutex> lock(m_asyncMutex);
+            m_asyncCond.wait_for(lock, std::chrono::milliseconds(LOG_ASYNC_WRITER_INTERVAL),
+                [] { return !m_asyncRunning.load(std::memory_order_relaxed) || m_asyncSignalled.load(); });
+            m_asyncSignalled.store(false);
+        }
+
+        LogFlushPending();
+    }
+
+    return nullptr;
+}
+
+/* Internal helper to set an output stream to direct logging to. */
+
+void __InternalOutputStream(std::ostream& stream)
+{
+    m_outStream.rdbuf(stream.rdbuf());
+}
+
+/* Gets the instance of the Network class to transfer the activity log with. */
+
+void* LogGetNetwork()
+{
+    // NO GOOD, VERY BAD, TERRIBLE HACK
+    return (void*)m_network;
+}
+
+/* Sets the instance of the Network class to transfer the activity log with. */
+
+void LogSetNetwork(void* network)
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return;
+#endif
+    // note: The Network class is passed here as a void so we can avoid including the Network.h
+    // header in Log.h. This is dirty and probably terrible...
+    m_network = (network::BaseNetwork*)network;
+}
+
+/* Initializes the diagnostics log. */
+
+bool LogInitialise(const std::string& filePath, const std::string& fileRoot, uint32_t fileLevel, uint32_t displayLevel, bool disableTimeDisplay, bool useSyslog)
+{
+    m_filePath = filePath;
+    m_fileRoot = fileRoot;
+    m_fileLevel = fileLevel;
+    g_logDisplayLevel = displayLevel;
+    g_disableTimeDisplay = disableTimeDisplay;
+#if defined(_WIN32)
+    g_useSyslog = false;
+#else
+    if (!g_useSyslog)
+        g_useSyslog = useSyslog;
+#endif // defined(_WIN32)
+    return ::LogOpen();
+}
+
+/* Finalizes the diagnostics log. */
+
+void LogFinalise()
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return;
+#endif
+    LogStopAsync();
+
+    if (m_fpLog != nullptr) {
+        ::fclose(m_fpLog);
+        m_fpLog = nullptr;
+    }
+#if !defined(_WIN32)
+    if (g_useSyslog)
+        closelog();
+#endif // !defined(_WIN32)
+}
+
+/* Starts writing log entries from a dedicated log writer thread. */
+
+bool LogStartAsync(uint32_t bufferLen, bool dropOnOverflow)
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return false;
+#endif
+    std::lock_guard<std::mutex> stopLock(m_asyncStopMutex);
+    if (m_asyncRunning.load())
+        return true;
+
+    // the queue length must be a power of 2, and must hold at least two full length log entries
+    uint32_t length = 1U;
+    while (length < bufferLen || length < 2U * (LOG_BUFFER_LEN + sizeof(LogQueueEntry)))
+        length <<= 1U;
+
+    m_asyncBufferLen = length;
+    m_asyncDropOnOverflow = dropOnOverflow;
+    m_asyncSignalled.store(false);
+    m_asyncRunning.store(true);
+
+    if (!Thread::runAsThread(nullptr, LogWriter, &m_asyncWriter)) {
+        m_asyncRunning.store(false);
+        return false;
+    }
+
+    return true;
+}
+
+/* Stops the log writer thread, writing any remaining queued log entries. */
+
+void LogStopAsync()
+{
+    // concurrent callers (such as two threads logging a fatal error) wait for the first to finish stopping, and
+    // only the caller that actually stopped the log writer joins it
+    std::lock_guard<std::mutex> stopLock(m_asyncStopMutex);
+
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(m_asyncMutex);
+        bool running = true;
+        if (!m_asyncRunning.compare_exchange_strong(running, false))
+            return;
+    }
+    m_asyncCond.notify_all();
+
+#if defined(_WIN32)
+    ::WaitForSingleObject(m_asyncWriter.thread, INFINITE);
+    ::CloseHandle(m_asyncWriter.thread);
+#else
+    ::pthread_join(m_asyncWriter.thread, NULL);
+#endif // defined(_WIN32)
+
+    LogFlushPending();
+}
+
+/* Sets the maximum number of log entries per second, for each call site. */
+
+void LogSetRateLimit(uint32_t entriesPerSecond)
+{
+    m_rateLimit.store(entriesPerSecond);
+}
+
+/* Helper to get the asynchronous logging and rate limiting counters. */
+
+void LogGetCounters(uint64_t& written, uint64_t& dropped, uint64_t& suppressed)
+{
+    written = m_asyncWritten.load();
+    dropped = m_asyncDropped.load();
+    suppressed = m_rateLimited.load();
+}
+
+/* Writes a new entry to the diagnostics log. */
+
+void Log(uint32_t level, const char *module, const char* file, const int lineNo, const char* func, const char* fmt, ...)
+{
+    assert(fmt != nullptr);
+#if defined(CATCH2_TEST_COMPILATION)
+    g_disableTimeDisplay = true;
+#endif
+    // fatal error (specially allow any log levels above 9999)
+    bool fatal = (level >= 6U && level < 9999U);
+
+    bool writeFile = (level >= m_fileLevel && m_fileLevel != 0U);
+    bool writeDisplay = (!g_useSyslog && level >= g_logDisplayLevel && g_logDisplayLevel != 0U);
+    bool writeStream = (m_outStream && g_logDisplayLevel == 0U);
+    bool writeNetwork = (m_network != nullptr && level > 1U); // don't transfer debug data...
+#if !defined(CATCH2_TEST_COMPILATION)
+    // entries filtered out everywhere are dropped before they count against the rate limit
+    if (!fatal && !writeFile && !writeDisplay && !writeStream && !writeNetwork)
+        return;
+#endif
+
+    // fatal errors are never rate limited
+    uint32_t suppressed = 0U;
+    if (!fatal && LogRateLimited(fmt, suppressed))
+        return;
+
+    char buffer[LOG_BUFFER_LEN];
+    LogPrefix(buffer, level, module, file, lineNo, func);
+
+    size_t len = ::strlen(buffer);
+
+    va_list vl;
+    va_start(vl, fmt);
+    ::vsnprintf(buffer + len, LOG_BUFFER_LEN - len, fmt, vl);
     va_end(vl);
 
-    if (m_outStream && g_logDisplayLevel == 0U) {
+    if (suppressed > 0U) {
+        len = ::strlen(buffer);
+        ::snprintf(buffer + len, LOG_BUFFER_LEN - len, " (%u similar log entries suppressed)", suppressed);
+    }
+
+    if (writeStream) {
         m_outStream << buffer << std::endl;
     }
 
-    if (m_network != nullptr) {
-        // don't transfer debug data...
-        if (level > 1U) {
-            m_network->writeDiagLog(buffer);
-        }
+    if (writeNetwork) {
+        m_network->writeDiagLog(buffer);
     }
 
 #if defined(CATCH2_TEST_COMPILATION)
@@ -326,54 +875,26 @@ void Log(uint32_t level, const char *module, const char* file, const int lineNo,
     return;
 #endif
 
-    if (level >= m_fileLevel && m_fileLevel != 0U) {
-        if (!g_useSyslog) {
-            bool ret = ::LogOpen();
-            if (!ret)
-                return;
+    if (m_asyncRunning.load(std::memory_order_relaxed) && !fatal) {
+        if (writeFile || writeDisplay)
+            LogEnqueue(level, buffer);
+        return;
+    }
 
-            if (m_fpLog != nullptr) {
-                ::fprintf(m_fpLog, "%s\n", buffer);
-                ::fflush(m_fpLog);
-            }
-        } else {
-#if !defined(_WIN32)
-            // convert our log level into syslog level
-            int syslogLevel = LOG_INFO;
-            switch (level) {
-            case 1U:
-                syslogLevel = LOG_DEBUG;
-                break;
-            case 2U:
-                syslogLevel = LOG_NOTICE;
-                break;
-            case 3U:
-            case 9999U: // in-band U: messages should also be info level
-                syslogLevel = LOG_INFO;
-                break;
-            case 4U:
-                syslogLevel = LOG_WARNING;
-                break;
-            case 5U:
-                syslogLevel = LOG_ERR;
-                break;
-            default:
-                syslogLevel = LOG_EMERG;
-                break;
-            }
+    // make sure everything logged before a fatal error is written first
+    if (fatal)
+        LogStopAsync();
 
-            syslog(syslogLevel, "%s", buffer);
-#endif // !defined(_WIN32)
-        }
+    if (writeFile) {
+        LogWriteFile(level, buffer);
     }
 
-    if (!g_useSyslog && level >= g_logDisplayLevel && g_logDisplayLevel != 0U) {
+    if (writeDisplay) {
         ::fprintf(stdout, "%s" EOL, buffer);
         ::fflush(stdout);
     }
 
-    // fatal error (specially allow any log levels above 9999)
-    if (level >= 6U && level < 9999U) {
+    if (fatal) {
         if (m_fpLog != nullptr)
             ::fclose(m_fpLog);
 #if !defined(_WIN32)
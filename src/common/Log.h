@@ -52,6 +52,8 @@
 
 /** @endcond */
 
+const uint32_t LOG_ASYNC_DEFAULT_BUFFER_LEN = 65536U;
+
 // ---------------------------------------------------------------------------
 //  Macros
 // ---------------------------------------------------------------------------
@@ -192,6 +194,39 @@ extern HOST_SW_API bool LogInitialise(const std::string& filePath, const std::st
  * @brief Finalizes the diagnostics log.
  */
 extern HOST_SW_API void LogFinalise();
+
+/**
+ * @brief Starts writing log entries from a dedicated log writer thread.
+ * @note Log entries are still formatted by the calling thread, but are then queued into a lock-free per-thread
+ *  buffer instead of being written to the log file and console by the calling thread. The log writer thread
+ *  writes queued log entries in batches. Fatal log entries are always written immediately. This must be called
+ *  after any process forking, as the log writer thread does not survive a fork.
+ * @param bufferLen Length (in bytes) of the per-thread log entry buffer.
+ * @param dropOnOverflow Flag indicating log entries are dropped (and counted) when the per-thread buffer is
+ *  full, instead of waiting for the log writer thread.
+ * @returns bool True, if the log writer thread was started, otherwise false.
+ */
+extern HOST_SW_API bool LogStartAsync(uint32_t bufferLen = LOG_ASYNC_DEFAULT_BUFFER_LEN, bool dropOnOverflow = true);
+/**
+ * @brief Stops the log writer thread, writing any remaining queued log entries.
+ * @note Log entries queued while (or after) the log writer thread stops are written by the logging thread.
+ */
+extern HOST_SW_API void LogStopAsync();
+/**
+ * @brief Sets the maximum number of log entries per second, for each call site.
+ * @note Entries over the limit are suppressed, and the number of suppressed entries is appended to the next
+ *  entry logged by the same call site. Fatal log entries are never suppressed, and entries filtered out by the
+ *  log levels never count against the limit.
+ * @param entriesPerSecond Maximum number of log entries per second (0 disables rate limiting).
+ */
+extern HOST_SW_API void LogSetRateLimit(uint32_t entriesPerSecond);
+/**
+ * @brief Helper to get the asynchronous logging and rate limiting counters.
+ * @param[out] written Number of log entries written by the log writer thread.
+ * @param[out] dropped Number of log entries dropped because a per-thread log entry buffer was full.
+ * @param[out] suppressed Number of log entries suppressed by rate limiting.
+ */
+extern HOST_SW_API void LogGetCounters(uint64_t& written, uint64_t& dropped, uint64_t& suppressed);
 /**
  * @brief Writes a new entry to the diagnostics log.
  * @param level Log level for entry.
@@ -11,6 +11,7 @@
 #include "Log.h"
 
 #include <cerrno>
+#include <chrono>
 #include <signal.h>
 #if !defined(_WIN32)
 #include <unistd.h>
@@ -21,6 +22,28 @@
 // ---------------------------------------------------------------------------
 
 #define MIN_WORKER_CNT 4U
+#define DEFAULT_LOCKFREE_QUEUE_LEN 4096U
+#define DEFAULT_CONTROL_WORKER_CNT 2U
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the current monotonic time in microseconds. */
+
+static uint64_t now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to raise an atomic high-water mark to the given sample. */
+
+template<typename T>
+static void atomicMax(std::atomic<T>& value, T sample)
+{
+    T curr = value.load(std::memory_order_relaxed);
+    while (sample > curr && !value.compare_exchange_weak(curr, sample, std::memory_order_relaxed));
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -32,12 +55,30 @@ ThreadPool::ThreadPool(uint16_t workerCnt, std::string name) :
     m_maxWorkerCnt(workerCnt),
     m_maxQueuedTasks(0U),
     m_poolState(STOP),
+    m_lockFree(false),
+    m_lockFreeQueueLen(DEFAULT_LOCKFREE_QUEUE_LEN),
+    m_sharded(false),
+    m_controlWorkerCnt(DEFAULT_CONTROL_WORKER_CNT),
     m_workers(),
     m_tasks(),
+    m_lockFreeTasks(nullptr),
+    m_shards(),
+    m_shardIdx(0U),
     m_workerMutex(),
     m_queueMutex(),
     m_cond(),
-    m_name(name)
+    m_idleWorkers(0U),
+    m_sharedDepth(0),
+    m_affinity(),
+    m_workerIdx(0U),
+    m_name(name),
+    m_queueDepth(0),
+    m_maxQueueDepth(0U),
+    m_enqueued(0U),
+    m_dropped(0U),
+    m_completed(0U),
+    m_totalLatency(0U),
+    m_maxLatency(0U)
 {
     if (m_maxWorkerCnt < MIN_WORKER_CNT)
         m_maxWorkerCnt = MIN_WORKER_CNT;
@@ -45,56 +86,33 @@ ThreadPool::ThreadPool(uint16_t workerCnt, std::string name) :
 
 /* Finalizes a instance of the ThreadPool class. */
 
-ThreadPool::~ThreadPool() = default;
+ThreadPool::~ThreadPool()
+{
+    if (m_lockFreeTasks != nullptr) {
+        delete m_lockFreeTasks;
+        m_lockFreeTasks = nullptr;
+    }
+
+    for (WorkerShard* shard : m_shards)
+        delete shard;
+    m_shards.clear();
+}
 
 /* Enqueue a thread pool task. */
 
 bool ThreadPool::enqueue(ThreadPoolTask* task)
 {
-    // scope is intentional
-    {
-        std::unique_lock<std::mutex> lock(m_workerMutex);
-        if (m_poolState == RUNNING && m_workers.size() < m_maxWorkerCnt) {
-            thread_t* thread = new thread_t();
-            thread->obj = this;
-        
-#if defined(_WIN32)
-            HANDLE hnd = ::CreateThread(NULL, 0, worker, thread, CREATE_SUSPENDED, NULL);
-            if (hnd == NULL) {
-                LogError(LOG_HOST, "Error returned from CreateThread, err: %lu", ::GetLastError());
-                return false;
-            }
-
-            thread->thread = hnd;
-            ::ResumeThread(hnd);
-#else
-            if (::pthread_create(&thread->thread, NULL, worker, thread) != 0) {
-                LogError(LOG_HOST, "Error returned from pthread_create, err: %d", errno);
-                return false;
-            }
-#endif // defined(_WIN32)
-
-            m_workers.emplace_back(thread->thread);
-        }
-    }
-
-    // scope is intentional
-    {
-        std::unique_lock<std::mutex> lock(m_queueMutex);
-        if (m_poolState == STOP) {
-            LogError(LOG_HOST, "Cannot enqueue task on a stopped thread pool!");
-            return false;
-        }
-
-        if (m_maxQueuedTasks > 0U && m_tasks.size() >= m_maxQueuedTasks) {
-            LogError(LOG_HOST, "Cannot enqueue task, thread pool queue is full!");
-            return false;
-        }
+    PooledTask pooled;
+    pooled.invoke = &ThreadPool::invokePoolTask;
+    pooled.fn = nullptr;
+    pooled.arg = static_cast<void*>(task);
 
-        m_tasks.emplace(std::unique_ptr<ThreadPoolTask>(task));
+    if (!push(pooled)) {
+        // the task was never queued, and the caller handed us ownership
+        delete task;
+        return false;
     }
 
-    m_cond.notify_one();
     return true;
 }
 
@@ -105,9 +123,30 @@ void ThreadPool::start()
     // scope is intentional
     {
         std::unique_lock<std::mutex> lock(m_queueMutex);
+        uint32_t queueLen = getLockFreeQueueLen();
+        if (m_lockFree && m_lockFreeTasks == nullptr) {
+            m_lockFreeTasks = new concurrent::mpmc_queue<PooledTask>(queueLen);
+            LogInfoEx(LOG_HOST, "%s thread pool, lock-free task queue capacity %u tasks", m_name.c_str(), (uint32_t)m_lockFreeTasks->capacity());
+        }
+
+        // sharded pools have every worker started up front, each owning its own task queue
+        if (m_sharded && m_shards.empty()) {
+            for (uint32_t i = 0U; i < m_maxWorkerCnt; i++) {
+                m_shards.push_back(new WorkerShard(queueLen));
+            }
+
+            LogInfoEx(LOG_HOST, "%s thread pool, %u per-worker task queues, capacity %u tasks each, %u control workers", m_name.c_str(), 
+                m_maxWorkerCnt, (uint32_t)m_shards[0U]->tasks.capacity(), m_controlWorkerCnt);
+        }
+
         m_poolState = RUNNING;
 
-        for (uint32_t i = m_workers.size(); i < m_maxWorkerCnt; i++) {
+        // sharded pools also start the control workers, these follow the shard workers and run the unkeyed tasks
+        uint32_t workerCnt = m_maxWorkerCnt;
+        if (m_sharded)
+            workerCnt += m_controlWorkerCnt;
+
+        for (uint32_t i = m_workers.size(); i < workerCnt; i++) {
             thread_t* thread = new thread_t();
             thread->obj = this;
         
@@ -145,6 +184,11 @@ void ThreadPool::stop()
     }
 
     m_cond.notify_all();
+
+    for (WorkerShard* shard : m_shards) {
+        { std::lock_guard<std::mutex> lock(shard->mutex); }
+        shard->cond.notify_all();
+    }
 }
 
 /* Make calling thread wait for termination of any remaining thread pool tasks. */
@@ -163,10 +207,271 @@ void ThreadPool::wait()
     }
 }
 
+/* Gets the queue statistics of the thread pool. */
+
+ThreadPoolStats ThreadPool::stats() const
+{
+    ThreadPoolStats stats;
+    int32_t depth = m_queueDepth.load();
+    stats.queueDepth = (depth > 0) ? (uint32_t)depth : 0U;
+    stats.maxQueueDepth = m_maxQueueDepth.load();
+    stats.enqueued = m_enqueued.load();
+    stats.dropped = m_dropped.load();
+    stats.completed = m_completed.load();
+    stats.avgLatency = (stats.completed > 0U) ? m_totalLatency.load() / stats.completed : 0U;
+    stats.maxLatency = m_maxLatency.load();
+
+    return stats;
+}
+
+/* Resets the queue statistics of the thread pool. */
+
+void ThreadPool::resetStats()
+{
+    m_maxQueueDepth = 0U;
+    m_enqueued = 0U;
+    m_dropped = 0U;
+    m_completed = 0U;
+    m_totalLatency = 0U;
+    m_maxLatency = 0U;
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/* Internal helper to push a task onto the task queue. */
+
+bool ThreadPool::push(PooledTask& task)
+{
+    if (m_poolState == STOP) {
+        LogError(LOG_HOST, "Cannot enqueue task on a stopped thread pool!");
+        m_dropped++;
+        return false;
+    }
+
+    // unkeyed tasks are never placed on the per-worker queues of a sharded pool, they are run by the
+    // control workers from the shared task queue
+    task.enqueueTime = now();
+
+    // the depth is raised before the task is queued, so that a worker going idle always observes
+    // either the pending task or a non-zero idle count here
+    ++m_queueDepth;
+    ++m_sharedDepth;
+
+    if (m_lockFree && m_lockFreeTasks != nullptr) {
+        if (!m_lockFreeTasks->push(task)) {
+            LogError(LOG_HOST, "Cannot enqueue task, %s thread pool queue is full (%u tasks)!", m_name.c_str(), (uint32_t)m_lockFreeTasks->capacity());
+            m_queueDepth--;
+            m_sharedDepth--;
+            m_dropped++;
+            return false;
+        }
+    }
+    else {
+        // scope is intentional
+        {
+            std::unique_lock<std::mutex> lock(m_workerMutex);
+            if (m_poolState == RUNNING && m_workers.size() < m_maxWorkerCnt) {
+                thread_t* thread = new thread_t();
+                thread->obj = this;
+            
+#if defined(_WIN32)
+                HANDLE hnd = ::CreateThread(NULL, 0, worker, thread, CREATE_SUSPENDED, NULL);
+                if (hnd == NULL) {
+                    LogError(LOG_HOST, "Error returned from CreateThread, err: %lu", ::GetLastError());
+                    m_queueDepth--;
+                    m_sharedDepth--;
+                    m_dropped++;
+                    return false;
+                }
+
+                thread->thread = hnd;
+                ::ResumeThread(hnd);
+#else
+                if (::pthread_create(&thread->thread, NULL, worker, thread) != 0) {
+                    LogError(LOG_HOST, "Error returned from pthread_create, err: %d", errno);
+                    m_queueDepth--;
+                    m_sharedDepth--;
+                    m_dropped++;
+                    return false;
+                }
+#endif // defined(_WIN32)
+
+                m_workers.emplace_back(thread->thread);
+            }
+        }
+
+        // scope is intentional
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            if (m_maxQueuedTasks > 0U && m_tasks.size() >= m_maxQueuedTasks) {
+                LogError(LOG_HOST, "Cannot enqueue task, thread pool queue is full!");
+                m_queueDepth--;
+                m_sharedDepth--;
+                m_dropped++;
+                return false;
+            }
+
+            m_tasks.push(task);
+        }
+    }
+
+    m_enqueued++;
+    int32_t depth = m_queueDepth.load();
+    atomicMax(m_maxQueueDepth, (depth > 0) ? (uint32_t)depth : 0U);
+
+    // only wake a worker (and take the wait mutex) if there are workers waiting for tasks
+    if (m_idleWorkers.load() > 0U) {
+        // taking the mutex here guarantees the idle worker is actually waiting before it is notified
+        { std::lock_guard<std::mutex> lock(m_queueMutex); }
+        m_cond.notify_one();
+    }
+
+    return true;
+}
+
+/* Internal helper to pop a task from the task queue. */
+
+bool ThreadPool::pop(PooledTask& task)
+{
+    if (m_lockFree && m_lockFreeTasks != nullptr) {
+        if (!m_lockFreeTasks->pop(task))
+            return false;
+    }
+    else {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        if (m_tasks.empty())
+            return false;
+
+        task = m_tasks.front();
+        m_tasks.pop();
+    }
+
+    m_sharedDepth--;
+    taskDequeued(task);
+    return true;
+}
+
+/* Internal helper to push a task onto a task queue by dispatch key. */
+
+bool ThreadPool::pushKeyed(PooledTask& task, uint32_t key)
+{
+    if (m_sharded && !m_shards.empty()) {
+        return pushShard(task, m_shards[key % m_shards.size()]);
+    }
+
+    return push(task);
+}
+
+/* Internal helper to push a task onto a per-worker task queue. */
+
+bool ThreadPool::pushShard(PooledTask& task, WorkerShard* shard)
+{
+    if (m_poolState == STOP) {
+        LogError(LOG_HOST, "Cannot enqueue task on a stopped thread pool!");
+        m_dropped++;
+        return false;
+    }
+
+    task.enqueueTime = now();
+
+    ++shard->depth;
+    ++m_queueDepth;
+    if (!shard->tasks.push(task)) {
+        LogError(LOG_HOST, "Cannot enqueue task, %s thread pool worker queue is full (%u tasks)!", m_name.c_str(), (uint32_t)shard->tasks.capacity());
+        shard->depth--;
+        m_queueDepth--;
+        m_dropped++;
+        return false;
+    }
+
+    m_enqueued++;
+    int32_t depth = m_queueDepth.load();
+    atomicMax(m_maxQueueDepth, (depth > 0) ? (uint32_t)depth : 0U);
+
+    if (shard->idle.load()) {
+        { std::lock_guard<std::mutex> lock(shard->mutex); }
+        shard->cond.notify_one();
+    }
+
+    return true;
+}
+
+/* Internal helper to record the queue latency of a dequeued task. */
+
+void ThreadPool::taskDequeued(const PooledTask& task)
+{
+    m_queueDepth--;
+
+    uint64_t latency = now() - task.enqueueTime;
+    m_totalLatency += latency;
+    atomicMax(m_maxLatency, latency);
+}
+
+/* Internal helper to run the task loop of a worker that owns a per-worker task queue. */
+
+void ThreadPool::runShard(WorkerShard* shard)
+{
+    PooledTask task;
+    while (m_poolState != STOP) {
+        if (!shard->tasks.pop(task)) {
+            // scope is intentional
+            {
+                std::unique_lock<std::mutex> lock(shard->mutex);
+                shard->idle = true;
+                shard->cond.wait(lock, [=] { return m_poolState == STOP || shard->depth.load() > 0; });
+                shard->idle = false;
+            }
+
+            continue;
+        }
+
+        shard->depth--;
+        taskDequeued(task);
+
+        task.invoke(task.fn, task.arg);
+        m_completed++;
+    }
+}
+
+/* Internal helper to run and release a allocated ThreadPoolTask. */
+
+void ThreadPool::invokePoolTask(void (*fn)(), void* arg)
+{
+    ThreadPoolTask* task = static_cast<ThreadPoolTask*>(arg);
+    if (task != nullptr) {
+        task->run();
+        delete task;
+    }
+}
+
+/* Internal helper to pin the calling worker thread to a CPU based on the affinity policy. */
+
+void ThreadPool::pinWorker(thread_t* thread)
+{
+    if (m_affinity.empty())
+        return;
+
+    uint32_t cpu = m_affinity[m_workerIdx++ % m_affinity.size()];
+#if defined(__linux__)
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+
+    int ret = ::pthread_setaffinity_np(thread->thread, sizeof(cpu_set_t), &cpuset);
+    if (ret != 0) {
+        LogWarning(LOG_HOST, "Failed to pin %s worker to CPU %u, err: %d", m_name.c_str(), cpu, ret);
+    }
+#elif defined(_WIN32)
+    if (::SetThreadAffinityMask(thread->thread, ((DWORD_PTR)1U) << cpu) == 0) {
+        LogWarning(LOG_HOST, "Failed to pin %s worker to CPU %u, err: %lu", m_name.c_str(), cpu, ::GetLastError());
+    }
+#else
+    LogWarning(LOG_HOST, "Worker CPU pinning is not supported on this platform, %s worker not pinned to CPU %u", m_name.c_str(), cpu);
+#endif
+}
+
 /* Internal worker thread that is used to execute task functions. */
 
 #if defined(_WIN32)
@@ -202,32 +507,43 @@ void* ThreadPool::worker(void* arg)
     ::pthread_setname_np(thread->thread, threadName.str().c_str());
 #endif // _GNU_SOURCE
 
-    ThreadPoolTask* task = nullptr;
-    while (threadPool->m_poolState != STOP) {
-        // scope is intentional
-        {
-            std::unique_lock<std::mutex> lock(threadPool->m_queueMutex);
-            threadPool->m_cond.wait(lock, [=] { return threadPool->m_poolState == STOP || !threadPool->m_tasks.empty(); });
-            if (threadPool->m_poolState == STOP && threadPool->m_tasks.empty()) {
-                delete thread;
+    threadPool->pinWorker(thread);
+
+    // the first workers of a sharded pool each own a per-worker queue, the remaining (control) workers
+    // run the shared task queue below
+    if (threadPool->m_sharded) {
+        uint32_t idx = threadPool->m_shardIdx++;
+        if (idx < threadPool->m_shards.size()) {
+            threadPool->runShard(threadPool->m_shards[idx]);
+
+            delete thread;
 #if defined(_WIN32)
-                return 0UL;
+            return 0UL;
 #else
-                return nullptr;
+            return nullptr;
 #endif // defined(_WIN32)
-            }
-
-            task = (threadPool->m_tasks.front()).release();
-            threadPool->m_tasks.pop();
         }
+    }
+
+    PooledTask task;
+    while (threadPool->m_poolState != STOP) {
+        if (!threadPool->pop(task)) {
+            // scope is intentional
+            {
+                std::unique_lock<std::mutex> lock(threadPool->m_queueMutex);
+                threadPool->m_idleWorkers++;
+                threadPool->m_cond.wait(lock, [=] { return threadPool->m_poolState == STOP || threadPool->m_sharedDepth.load() > 0; });
+                threadPool->m_idleWorkers--;
+            }
 
-        if (task == nullptr)
             continue;
+        }
 
-        task->run();
-        delete task;
+        task.invoke(task.fn, task.arg);
+        threadPool->m_completed++;
     }
 
+    delete thread;
 #if defined(_WIN32)
     return 0UL;
 #else
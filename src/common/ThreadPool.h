@@ -18,7 +18,9 @@
 
 #include "common/Defines.h"
 #include "common/Thread.h"
+#include "common/concurrent/mpmc_queue.h"
 
+#include <atomic>
 #include <vector>
 #include <queue>
 #include <mutex>
@@ -69,6 +71,38 @@ private:
 template<class F, class... Args>
 ThreadPoolTask* new_pooltask(F&& f, Args&&... args) { return new ThreadPoolTask(f, args...); }
 
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a non-allocating task entry in a thread pool queue.
+ * @note This is a plain function pointer and argument pair, it is what is actually queued by the
+ *  thread pool.
+ * @ingroup threading
+ */
+struct PooledTask {
+    void (*invoke)(void (*)(), void*);  //! Trampoline used to call the task function.
+    void (*fn)();                       //! Task function.
+    void* arg;                          //! Task function argument.
+
+    uint64_t enqueueTime;               //! Time (in microseconds) the task was enqueued.
+};
+
+/**
+ * @brief Represents the queue statistics of a thread pool.
+ * @ingroup threading
+ */
+struct ThreadPoolStats {
+    uint32_t queueDepth;                //! Current number of queued tasks.
+    uint32_t maxQueueDepth;             //! Maximum number of queued tasks.
+    uint64_t enqueued;                  //! Total number of tasks enqueued.
+    uint64_t dropped;                   //! Total number of tasks that failed to enqueue.
+    uint64_t completed;                 //! Total number of tasks completed.
+    uint64_t avgLatency;                //! Average time (in microseconds) a task waits in the queue.
+    uint64_t maxLatency;                //! Maximum time (in microseconds) a task waited in the queue.
+};
+
 // ---------------------------------------------------------------------------
 //  Class Declaration
 // ---------------------------------------------------------------------------
@@ -92,10 +126,49 @@ public:
 
     /**
      * @brief Enqueues a thread pool task.
+     * @note The thread pool always takes ownership of the task; the task is deleted after it has run, or
+     *  immediately if it could not be enqueued (the caller must not delete the task when this returns false).
      * @param task Task to enqueue.
      * @returns bool True, if task enqueued otherwise false.
      */
     bool enqueue(ThreadPoolTask* task);
+    /**
+     * @brief Enqueues a thread pool task function.
+     * @note This does not allocate, the function and its argument are queued directly.
+     * @tparam T Type of the task function argument.
+     * @param fn Task function.
+     * @param arg Task function argument.
+     * @returns bool True, if task enqueued otherwise false.
+     */
+    template<class T>
+    bool enqueue(void (*fn)(T*), T* arg)
+    {
+        PooledTask task;
+        task.invoke = &ThreadPool::invokeTask<T>;
+        task.fn = reinterpret_cast<void (*)()>(fn);
+        task.arg = static_cast<void*>(arg);
+        return push(task);
+    }
+    /**
+     * @brief Enqueues a thread pool task function, dispatched by key.
+     * @note When the thread pool is sharded, all tasks with the same key are executed, in the order
+     *  they were enqueued, by the same worker thread. When the thread pool is not sharded the key
+     *  is ignored.
+     * @tparam T Type of the task function argument.
+     * @param fn Task function.
+     * @param arg Task function argument.
+     * @param key Dispatch key.
+     * @returns bool True, if task enqueued otherwise false.
+     */
+    template<class T>
+    bool enqueue(void (*fn)(T*), T* arg, uint32_t key)
+    {
+        PooledTask task;
+        task.invoke = &ThreadPool::invokeTask<T>;
+        task.fn = reinterpret_cast<void (*)()>(fn);
+        task.arg = static_cast<void*>(arg);
+        return pushKeyed(task, key);
+    }
 
     /**
      * @brief Starts the thread pool.
@@ -111,6 +184,74 @@ public:
      */
     void wait();
 
+    /**
+     * @brief Sets the CPU affinity policy for the worker threads.
+     * @note This must be set before the thread pool is started. Worker threads are pinned round-robin
+     *  to the given list of CPUs; an empty list leaves the worker threads unpinned.
+     * @param cpus List of CPUs to pin worker threads to.
+     */
+    void setAffinity(const std::vector<uint32_t>& cpus) { m_affinity = cpus; }
+    /**
+     * @brief Sets whether the thread pool uses the lock-free task queue.
+     * @note This must be set before the thread pool is started. Unlike the locked task queue (which is unbounded
+     *  unless a maximum number of queued tasks is set), the lock-free and per-worker task queues are bounded
+     *  (see setLockFreeQueueLen()), tasks enqueued while the queue is full are dropped.
+     * @param lockFree Flag indicating whether the thread pool uses the lock-free task queue.
+     */
+    void setLockFree(bool lockFree) { if (m_poolState == STOP) m_lockFree = lockFree; }
+    /**
+     * @brief Gets whether the thread pool uses the lock-free task queue.
+     * @returns bool True, if the thread pool uses the lock-free task queue, otherwise false.
+     */
+    bool isLockFree() const { return m_lockFree; }
+    /**
+     * @brief Sets the capacity of the lock-free and per-worker task queues.
+     * @note This must be set before the thread pool is started. If a maximum number of queued tasks is set,
+     *  it takes precedence over this capacity. The capacity is rounded up to the next power of 2.
+     * @param queueLen Maximum number of queued tasks.
+     */
+    void setLockFreeQueueLen(uint32_t queueLen) { if (m_poolState == STOP && queueLen > 0U) m_lockFreeQueueLen = queueLen; }
+    /**
+     * @brief Gets the capacity of the lock-free and per-worker task queues.
+     * @returns uint32_t Maximum number of queued tasks.
+     */
+    uint32_t getLockFreeQueueLen() const { return (m_maxQueuedTasks > 0U) ? m_maxQueuedTasks : m_lockFreeQueueLen; }
+    /**
+     * @brief Sets whether the thread pool dispatches tasks to per-worker queues.
+     * @note This must be set before the thread pool is started. When sharded, every worker thread owns its
+     *  own lock-free task queue, and tasks enqueued by key are always routed to the same worker. Tasks
+     *  enqueued without a key are never placed on the per-worker queues, they are run by a separate set of
+     *  control workers (see setControlWorkerCnt()), so that a slow unkeyed task never delays keyed tasks.
+     * @param sharded Flag indicating whether the thread pool dispatches tasks to per-worker queues.
+     */
+    void setSharded(bool sharded) { if (m_poolState == STOP) m_sharded = sharded; }
+    /**
+     * @brief Sets the number of control workers that run unkeyed tasks, when the thread pool is sharded.
+     * @note This must be set before the thread pool is started.
+     * @param workerCnt Number of control workers.
+     */
+    void setControlWorkerCnt(uint16_t workerCnt) { if (m_poolState == STOP && workerCnt > 0U) m_controlWorkerCnt = workerCnt; }
+    /**
+     * @brief Gets the number of control workers that run unkeyed tasks, when the thread pool is sharded.
+     * @returns uint16_t Number of control workers.
+     */
+    uint16_t getControlWorkerCnt() const { return m_controlWorkerCnt; }
+    /**
+     * @brief Gets whether the thread pool dispatches tasks to per-worker queues.
+     * @returns bool True, if the thread pool dispatches tasks to per-worker queues, otherwise false.
+     */
+    bool isSharded() const { return m_sharded; }
+
+    /**
+     * @brief Gets the queue statistics of the thread pool.
+     * @returns ThreadPoolStats Queue statistics.
+     */
+    ThreadPoolStats stats() const;
+    /**
+     * @brief Resets the queue statistics of the thread pool.
+     */
+    void resetStats();
+
 public:
     /**
      * @brief Maximum number of worker threads.
@@ -132,17 +273,120 @@ private:
         RUNNING
     };
 
-    PoolState m_poolState;
+    /**
+     * @brief Represents a per-worker task queue.
+     */
+    struct WorkerShard {
+        /**
+         * @brief Initializes a new instance of the WorkerShard struct.
+         * @param queueLen Maximum number of queued tasks.
+         */
+        WorkerShard(uint32_t queueLen) :
+            tasks(queueLen),
+            mutex(),
+            cond(),
+            depth(0),
+            idle(false)
+        {
+            /* stub */
+        }
+
+        concurrent::mpmc_queue<PooledTask> tasks;
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::atomic<int32_t> depth;
+        std::atomic<bool> idle;
+    };
+
+    std::atomic<PoolState> m_poolState;
+    bool m_lockFree;
+    uint32_t m_lockFreeQueueLen;
+    bool m_sharded;
+    uint16_t m_controlWorkerCnt;
 
     std::vector<pthread_t> m_workers;
-    std::queue<std::unique_ptr<ThreadPoolTask>> m_tasks;
+    std::queue<PooledTask> m_tasks;
+    concurrent::mpmc_queue<PooledTask>* m_lockFreeTasks;
+    std::vector<WorkerShard*> m_shards;
+    std::atomic<uint32_t> m_shardIdx;
 
     std::mutex m_workerMutex;
     std::mutex m_queueMutex;
     std::condition_variable m_cond;
+    std::atomic<uint32_t> m_idleWorkers;
+    std::atomic<int32_t> m_sharedDepth;
+
+    std::vector<uint32_t> m_affinity;
+    std::atomic<uint32_t> m_workerIdx;
 
     std::string m_name;
 
+    std::atomic<int32_t> m_queueDepth;
+    std::atomic<uint32_t> m_maxQueueDepth;
+    std::atomic<uint64_t> m_enqueued;
+    std::atomic<uint64_t> m_dropped;
+    std::atomic<uint64_t> m_completed;
+    std::atomic<uint64_t> m_totalLatency;
+    std::atomic<uint64_t> m_maxLatency;
+
+    /**
+     * @brief Internal helper to push a task onto the task queue.
+     * @param task Task to enqueue.
+     * @returns bool True, if task enqueued otherwise false.
+     */
+    bool push(PooledTask& task);
+    /**
+     * @brief Internal helper to pop a task from the task queue.
+     * @param[out] task Task dequeued.
+     * @returns bool True, if a task was dequeued otherwise false.
+     */
+    bool pop(PooledTask& task);
+    /**
+     * @brief Internal helper to push a task onto a task queue by dispatch key.
+     * @param task Task to enqueue.
+     * @param key Dispatch key.
+     * @returns bool True, if task enqueued otherwise false.
+     */
+    bool pushKeyed(PooledTask& task, uint32_t key);
+    /**
+     * @brief Internal helper to push a task onto a per-worker task queue.
+     * @param task Task to enqueue.
+     * @param shard Per-worker task queue.
+     * @returns bool True, if task enqueued otherwise false.
+     */
+    bool pushShard(PooledTask& task, WorkerShard* shard);
+    /**
+     * @brief Internal helper to record the queue latency of a dequeued task.
+     * @param task Task dequeued.
+     */
+    void taskDequeued(const PooledTask& task);
+    /**
+     * @brief Internal helper to run the task loop of a worker that owns a per-worker task queue.
+     * @param shard Per-worker task queue.
+     */
+    void runShard(WorkerShard* shard);
+
+    /**
+     * @brief Internal helper to call a task function with its argument.
+     * @tparam T Type of the task function argument.
+     * @param fn Task function.
+     * @param arg Task function argument.
+     */
+    template<class T>
+    static void invokeTask(void (*fn)(), void* arg) { reinterpret_cast<void (*)(T*)>(fn)(static_cast<T*>(arg)); }
+    /**
+     * @brief Internal helper to run and release a allocated ThreadPoolTask.
+     * @param fn Unused.
+     * @param arg Instance of ThreadPoolTask.
+     */
+    static void invokePoolTask(void (*fn)(), void* arg);
+
+    /**
+     * @brief Internal helper to pin the calling worker thread to a CPU based on the affinity policy.
+     * @param thread Worker thread.
+     */
+    void pinWorker(thread_t* thread);
+
     /**
      * @brief Internal worker thats used as the entry point for the worker threads.
      * @param arg 
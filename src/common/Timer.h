@@ -77,6 +77,20 @@ public:
 
         return (m_timeout - m_timer) / m_ticksPerSec;
     }
+    /**
+     * @brief Gets the currently remaining time for the timer, in milliseconds.
+     * @return uint32_t Amount of time (in milliseconds) remaining before the timeout.
+     */
+    uint32_t getRemainingMs() const
+    {
+        if (m_timeout == 0U || m_timer == 0U)
+            return 0U;
+
+        if (m_timer >= m_timeout)
+            return 0U;
+
+        return (uint32_t)(((uint64_t)(m_timeout - m_timer) * 1000U) / m_ticksPerSec);
+    }
 
     /**
      * @brief Flag indicating whether the timer is running.
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file epoch.h
+ * @ingroup concurrency
+ */
+#if !defined(__CONCURRENCY_EPOCH_H__)
+#define __CONCURRENCY_EPOCH_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+
+namespace concurrent
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Epoch based read-side critical section tracker, used to safely reclaim data published with
+     *  read-copy-update.
+     * @note Readers never block, entering a read-side section is a pair of atomic operations on the reader
+     *  count for the current epoch (reader counts are spread across per-thread slots). Writers never wait
+     *  for readers either; data a writer has unpublished is tagged with the current() epoch and released
+     *  once the epoch has advanced twice past that tag (see isSafe()). tryAdvance() only advances the epoch
+     *  when every reader of the previous epoch has left, so by then no reader can still reference the data.
+     * @ingroup concurrency
+     */
+    class epoch
+    {
+    public:
+        auto operator=(epoch&) -> epoch& = delete;
+        auto operator=(epoch&&) -> epoch& = delete;
+        epoch(epoch&) = delete;
+
+        /**
+         * @brief Initializes a new instance of the epoch class.
+         */
+        epoch() :
+            m_epoch(0U),
+            m_slots()
+        {
+            for (uint32_t i = 0U; i < SLOT_COUNT; i++) {
+                m_slots[i].readers[0U].store(0U, std::memory_order_relaxed);
+                m_slots[i].readers[1U].store(0U, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Enters a read-side critical section.
+         * @returns uint32_t Epoch the read-side critical section was entered in.
+         */
+        uint32_t readLock() const
+        {
+            Slot& slot = m_slots[threadSlot()];
+            for (;;) {
+                uint32_t e = m_epoch.load();
+                slot.readers[e & 1U].fetch_add(1U);
+                if (m_epoch.load() == e)
+                    return e;
+
+                // the epoch advanced underneath us, back out and retry against the new epoch
+                slot.readers[e & 1U].fetch_sub(1U);
+            }
+        }
+        /**
+         * @brief Leaves a read-side critical section.
+         * @param e Epoch the read-side critical section was entered in.
+         */
+        void readUnlock(uint32_t e) const
+        {
+            m_slots[threadSlot()].readers[e & 1U].fetch_sub(1U, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gets the current epoch.
+         * @returns uint32_t Current epoch.
+         */
+        uint32_t current() const { return m_epoch.load(); }
+
+        /**
+         * @brief Advances the epoch, if every reader of the previous epoch has left.
+         * @note This never waits for readers; a reader that holds a read-side section open simply delays
+         *  the advance (and so the release of retired data) until it leaves.
+         * @returns bool True, if the epoch was advanced, otherwise false.
+         */
+        bool tryAdvance()
+        {
+            uint32_t e = m_epoch.load();
+            for (uint32_t i = 0U; i < SLOT_COUNT; i++) {
+                if (m_slots[i].readers[(e + 1U) & 1U].load(std::memory_order_acquire) > 0U)
+                    return false;
+            }
+
+            return m_epoch.compare_exchange_strong(e, e + 1U);
+        }
+
+        /**
+         * @brief Checks if data retired in the given epoch can no longer be referenced by any reader.
+         * @param retired Epoch the data was retired in.
+         * @returns bool True, if the data may be released, otherwise false.
+         */
+        bool isSafe(uint32_t retired) const
+        {
+            return (int32_t)(m_epoch.load() - retired) >= 2;
+        }
+
+    private:
+        static const uint32_t SLOT_COUNT = 16U;
+        static const size_t CACHE_LINE_SIZE = 64U;
+
+        /**
+         * @brief Reader counts (for each epoch parity) of a group of threads.
+         * @note The padding keeps each group of reader counts on its own cache line, so readers on different
+         *  threads do not contend with each other.
+         */
+        struct Slot {
+            std::atomic<uint32_t> readers[2U];
+            uint8_t pad[CACHE_LINE_SIZE - (2U * sizeof(std::atomic<uint32_t>))];
+        };
+
+        mutable std::atomic<uint32_t> m_epoch;
+        mutable Slot m_slots[SLOT_COUNT];
+
+        /**
+         * @brief Gets the reader slot assigned to the calling thread.
+         * @returns uint32_t Reader slot.
+         */
+        static uint32_t threadSlot()
+        {
+            static std::atomic<uint32_t> nextSlot(0U);
+            static thread_local uint32_t slot = nextSlot.fetch_add(1U, std::memory_order_relaxed) % SLOT_COUNT;
+            return slot;
+        }
+    };
+} // namespace concurrent
+
+#endif // __CONCURRENCY_EPOCH_H__
@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file mpmc_queue.h
+ * @ingroup concurrency
+ */
+#if !defined(__CONCURRENCY_MPMC_QUEUE_H__)
+#define __CONCURRENCY_MPMC_QUEUE_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+#include <cstddef>
+
+namespace concurrent
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Bounded lock-free multi-producer/multi-consumer queue.
+     * @note This is a fixed capacity ring of cells, each cell carries a sequence number that is used
+     *  by producers and consumers to claim the cell without locking. The capacity is always rounded up
+     *  to the next power of 2.
+     * @tparam T Type of element stored in the queue (should be trivially copyable).
+     * @ingroup concurrency
+     */
+    template <typename T>
+    class mpmc_queue
+    {
+    public:
+        auto operator=(mpmc_queue&) -> mpmc_queue& = delete;
+        auto operator=(mpmc_queue&&) -> mpmc_queue& = delete;
+        mpmc_queue(mpmc_queue&) = delete;
+
+        /**
+         * @brief Initializes a new instance of the mpmc_queue class.
+         * @param capacity Maximum number of elements in the queue.
+         */
+        mpmc_queue(size_t capacity) :
+            m_cells(nullptr),
+            m_mask(0U),
+            m_pad0(),
+            m_enqueuePos(0U),
+            m_pad1(),
+            m_dequeuePos(0U)
+        {
+            size_t size = 2U;
+            while (size < capacity)
+                size <<= 1;
+
+            m_mask = size - 1U;
+            m_cells = new Cell[size];
+            for (size_t i = 0U; i < size; i++)
+                m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        /**
+         * @brief Finalizes a instance of the mpmc_queue class.
+         */
+        ~mpmc_queue()
+        {
+            delete[] m_cells;
+        }
+
+        /**
+         * @brief Pushes an element onto the end of the queue.
+         * @param value Element to push.
+         * @returns bool True, if the element was pushed, otherwise false (queue full).
+         */
+        bool push(const T& value)
+        {
+            Cell* cell = nullptr;
+            size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+                if (diff == 0) {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) {
+                    return false; // queue is full
+                }
+                else {
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            cell->data = value;
+            cell->sequence.store(pos + 1U, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pops an element from the front of the queue.
+         * @param[out] value Element popped.
+         * @returns bool True, if an element was popped, otherwise false (queue empty).
+         */
+        bool pop(T& value)
+        {
+            Cell* cell = nullptr;
+            size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &m_cells[pos & m_mask];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1U);
+                if (diff == 0) {
+                    if (m_dequeuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0) {
+                    return false; // queue is empty
+                }
+                else {
+                    pos = m_dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+
+            value = cell->data;
+            cell->sequence.store(pos + m_mask + 1U, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Gets the capacity of the queue.
+         * @returns size_t Maximum number of elements in the queue.
+         */
+        size_t capacity() const { return m_mask + 1U; }
+
+    private:
+        /**
+         * @brief Represents a single cell in the queue ring.
+         */
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        static const size_t CACHE_LINE_SIZE = 64U;
+
+        Cell* m_cells;
+        size_t m_mask;
+
+        // the padding keeps producers and consumers from contending on the same cache line
+        uint8_t m_pad0[CACHE_LINE_SIZE];
+        std::atomic<size_t> m_enqueuePos;
+        uint8_t m_pad1[CACHE_LINE_SIZE];
+        std::atomic<size_t> m_dequeuePos;
+    };
+} // namespace concurrent
+
+#endif // __CONCURRENCY_MPMC_QUEUE_H__
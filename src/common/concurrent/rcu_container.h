@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file rcu_container.h
+ * @ingroup concurrency
+ */
+#if !defined(__CONCURRENCY_RCU_CONTAINER_H__)
+#define __CONCURRENCY_RCU_CONTAINER_H__
+
+#include "common/concurrent/epoch.h"
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace concurrent
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Read-only snapshot of a read-copy-update container.
+     * @note The snapshot holds a read-side critical section for its lifetime; it should be kept
+     *  short-lived (i.e. a single iteration), as outstanding snapshots delay the release of every version
+     *  of the container retired while they are held.
+     * @tparam C Type of the underlying container.
+     * @ingroup concurrency
+     */
+    template <typename C>
+    class rcu_snapshot
+    {
+    public:
+        using const_iterator = typename C::const_iterator;
+
+        auto operator=(rcu_snapshot&) -> rcu_snapshot& = delete;
+        auto operator=(rcu_snapshot&&) -> rcu_snapshot& = delete;
+        rcu_snapshot(rcu_snapshot&) = delete;
+
+        /**
+         * @brief Initializes a new instance of the rcu_snapshot class.
+         * @param e Epoch tracker of the owning container.
+         * @param current Current version of the owning container.
+         */
+        rcu_snapshot(const epoch& e, const std::atomic<C*>& current) :
+            m_epoch(&e),
+            m_readEpoch(e.readLock()),
+            m_data(current.load(std::memory_order_acquire))
+        {
+            /* stub */
+        }
+        /**
+         * @brief Initializes a new instance of the rcu_snapshot class.
+         * @param other Snapshot to take ownership of.
+         */
+        rcu_snapshot(rcu_snapshot&& other) :
+            m_epoch(other.m_epoch),
+            m_readEpoch(other.m_readEpoch),
+            m_data(other.m_data)
+        {
+            other.m_epoch = nullptr;
+            other.m_data = nullptr;
+        }
+        /**
+         * @brief Finalizes a instance of the rcu_snapshot class.
+         */
+        ~rcu_snapshot()
+        {
+            if (m_epoch != nullptr)
+                m_epoch->readUnlock(m_readEpoch);
+        }
+
+        /**
+         * @brief Returns a read-only (constant) iterator that points to the first element in the snapshot.
+         * @returns const_iterator
+         */
+        const_iterator begin() const { return m_data->cbegin(); }
+        /**
+         * @brief Returns a read-only (constant) iterator that points one past the last element in the snapshot.
+         * @returns const_iterator
+         */
+        const_iterator end() const { return m_data->cend(); }
+
+        /**
+         * @brief Gets the total number of elements in the snapshot.
+         * @returns size_t Total number of elements in the snapshot.
+         */
+        size_t size() const { return m_data->size(); }
+        /**
+         * @brief Checks if the snapshot is empty.
+         * @returns bool True if the snapshot is empty, false otherwise.
+         */
+        bool empty() const { return m_data->empty(); }
+
+        /**
+         * @brief Gets the underlying container of the snapshot.
+         * @returns const C& Underlying container.
+         */
+        const C& get() const { return *m_data; }
+
+    private:
+        const epoch* m_epoch;
+        uint32_t m_readEpoch;
+        const C* m_data;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Base class for a read-copy-update container.
+     * @note Readers are never blocked by writers; every reader sees a complete, immutable version of the
+     *  container. Writers are serialized, copy the current version, modify the copy and publish it, and then
+     *  retire the previous version; retired versions are released by a later write once all readers of them
+     *  have left. Writers never wait for readers, so a thread holding a snapshot may safely write to the
+     *  container. This is intended for containers that are read far more often than they are written.
+     * @tparam C Type of the underlying container.
+     * @ingroup concurrency
+     */
+    template <typename C>
+    class rcu_container
+    {
+    public:
+        auto operator=(rcu_container&) -> rcu_container& = delete;
+        auto operator=(rcu_container&&) -> rcu_container& = delete;
+        rcu_container(rcu_container&) = delete;
+
+        /**
+         * @brief Initializes a new instance of the rcu_container class.
+         */
+        rcu_container() :
+            m_epoch(),
+            m_writeMutex(),
+            m_current(new C()),
+            m_retired()
+        {
+            /* stub */
+        }
+        /**
+         * @brief Finalizes a instance of the rcu_container class.
+         */
+        virtual ~rcu_container()
+        {
+            // no readers can remain once the container is being destroyed
+            for (auto& entry : m_retired)
+                entry.second();
+            delete m_current.load();
+        }
+
+        /**
+         * @brief Takes a read-only snapshot of the container.
+         * @returns rcu_snapshot<C> Snapshot of the container.
+         */
+        rcu_snapshot<C> snapshot() const { return rcu_snapshot<C>(m_epoch, m_current); }
+
+        /**
+         * @brief Gets the total number of elements in the container.
+         * @returns size_t Total number of elements in the container.
+         */
+        size_t size() const
+        {
+            return read([](const C& c) { return c.size(); });
+        }
+        /**
+         * @brief Checks if the container is empty.
+         * @returns bool True if the container is empty, false otherwise.
+         */
+        bool empty() const
+        {
+            return read([](const C& c) { return c.empty(); });
+        }
+
+        /**
+         * @brief Clears the container.
+         */
+        void clear()
+        {
+            update([](C& c) { c.clear(); });
+        }
+
+        /**
+         * @brief Applies a set of modifications to the container as a single update.
+         * @note The modifications are applied to a private copy of the container, readers only ever see the
+         *  container before or after all the modifications.
+         * @tparam F Type of the modification function.
+         * @param fn Modification function, called with the copy of the container to modify.
+         */
+        template <typename F>
+        void update(F fn)
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+
+            C* prev = m_current.load();
+            C* next = new C(*prev);
+            fn(*next);
+
+            m_current.store(next);
+            retireLocked([prev]() { delete prev; });
+        }
+
+        /**
+         * @brief Defers releasing data that was reachable through the container until no reader can still
+         *  reference it.
+         * @note This is intended for the pointees of elements that have been removed from the container; the
+         *  release function runs once every read-side section (including snapshots) that was open when the
+         *  data was retired has been left. It does not protect copies of an element held outside of a
+         *  read-side section.
+         * @param release Function that releases the retired data.
+         */
+        void retire(std::function<void()> release)
+        {
+            std::lock_guard<std::mutex> lock(m_writeMutex);
+            retireLocked(release);
+        }
+
+    protected:
+        epoch m_epoch;
+        std::mutex m_writeMutex;
+        std::atomic<C*> m_current;
+        std::deque<std::pair<uint32_t, std::function<void()>>> m_retired;
+
+        /**
+         * @brief Helper to retire data, and release any retired data that is no longer referenced.
+         * @note The write lock must be held.
+         * @param release Function that releases the retired data.
+         */
+        void retireLocked(std::function<void()> release)
+        {
+            m_retired.push_back(std::make_pair(m_epoch.current(), release));
+
+            // advance the epoch as far as the current readers allow (data is safe after two advances), then
+            // release everything retired before that
+            if (m_epoch.tryAdvance())
+                m_epoch.tryAdvance();
+
+            while (!m_retired.empty() && m_epoch.isSafe(m_retired.front().first)) {
+                m_retired.front().second();
+                m_retired.pop_front();
+            }
+        }
+
+        /**
+         * @brief Runs a read-only function against the current version of the container.
+         * @tparam F Type of the read function.
+         * @param fn Read function, called with the current version of the container.
+         * @returns Result of the read function.
+         */
+        template <typename F>
+        auto read(F fn) const -> decltype(fn(std::declval<const C&>()))
+        {
+            uint32_t e = m_epoch.readLock();
+            const C* c = m_current.load(std::memory_order_acquire);
+            auto ret = fn(*c);
+            m_epoch.readUnlock(e);
+            return ret;
+        }
+    };
+} // namespace concurrent
+
+#endif // __CONCURRENCY_RCU_CONTAINER_H__
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file rcu_unordered_map.h
+ * @ingroup concurrency
+ */
+#if !defined(__CONCURRENCY_RCU_UNORDERED_MAP_H__)
+#define __CONCURRENCY_RCU_UNORDERED_MAP_H__
+
+#include "common/concurrent/rcu_container.h"
+
+#include <unordered_map>
+
+namespace concurrent
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Thread-safe read-copy-update std::unordered_map.
+     * @note Lookups never block and never observe a partially applied write. Element access returns
+     *  copies of the stored values; use snapshot() to iterate the map.
+     * @ingroup concurrency
+     */
+    template <typename Key, typename T>
+    class rcu_unordered_map : public rcu_container<std::unordered_map<Key, T>>
+    {
+        using __std = std::unordered_map<Key, T>;
+        using __base = rcu_container<__std>;
+    public:
+        /**
+         * @brief Initializes a new instance of the rcu_unordered_map class.
+         */
+        rcu_unordered_map() : __base()
+        {
+            /* stub */
+        }
+
+        /**
+         * @brief Unordered map assignment operator.
+         * @param other A map of identical element and allocator types.
+         */
+        rcu_unordered_map& operator=(const std::unordered_map<Key, T>& other)
+        {
+            __base::update([&](__std& m) { m = other; });
+            return *this;
+        }
+
+        /**
+         * @brief Gets a copy of the element at the specified key.
+         * @param key Key of the element to get.
+         * @returns T Copy of the element at the specified key, or a default constructed element if the key
+         *  does not exist.
+         */
+        T operator[](const Key& key) const
+        {
+            return __base::read([&](const __std& m) {
+                auto it = m.find(key);
+                return (it != m.end()) ? it->second : T();
+            });
+        }
+
+        /**
+         * @brief Checks if the unordered_map contains the specified key.
+         * @param key Key to check.
+         * @returns bool True if the unordered_map contains the specified key, false otherwise.
+         */
+        bool contains(const Key& key) const
+        {
+            return __base::read([&](const __std& m) { return m.find(key) != m.end(); });
+        }
+
+        /**
+         * @brief Finds the number of elements.
+         * @param key Key to count.
+         * @return size_t Number of elements with specified key.
+         */
+        size_t count(const Key& key) const
+        {
+            return __base::read([&](const __std& m) { return m.count(key); });
+        }
+
+        /**
+         * @brief Tries to locate an element in the unordered_map.
+         * @param key Key to be located.
+         * @param[out] value Copy of the located element.
+         * @returns bool True, if the element was located, otherwise false.
+         */
+        bool find(const Key& key, T& value) const
+        {
+            return __base::read([&](const __std& m) {
+                auto it = m.find(key);
+                if (it == m.end())
+                    return false;
+
+                value = it->second;
+                return true;
+            });
+        }
+
+        /**
+         * @brief Inserts a new element into the unordered_map.
+         * @note If the key already exists, the existing element is left unchanged.
+         * @param key Key of the element to insert.
+         * @param value Value of the element to insert.
+         */
+        void insert(const Key& key, const T& value)
+        {
+            __base::update([&](__std& m) { m.insert({key, value}); });
+        }
+
+        /**
+         * @brief Inserts or replaces the element at the specified key.
+         * @param key Key of the element to set.
+         * @param value Value of the element to set.
+         */
+        void set(const Key& key, const T& value)
+        {
+            __base::update([&](__std& m) { m[key] = value; });
+        }
+
+        /**
+         * @brief Removes the element at the specified key.
+         * @param key Key of the element to remove.
+         */
+        void erase(const Key& key)
+        {
+            __base::update([&](__std& m) { m.erase(key); });
+        }
+    };
+} // namespace concurrent
+
+#endif // __CONCURRENCY_RCU_UNORDERED_MAP_H__
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file rcu_vector.h
+ * @ingroup concurrency
+ */
+#if !defined(__CONCURRENCY_RCU_VECTOR_H__)
+#define __CONCURRENCY_RCU_VECTOR_H__
+
+#include "common/concurrent/rcu_container.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace concurrent
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Thread-safe read-copy-update std::vector.
+     * @note Reads never block and never observe a partially applied write. Element access returns
+     *  copies of the stored values; use snapshot() to iterate the vector.
+     * @ingroup concurrency
+     */
+    template <typename T>
+    class rcu_vector : public rcu_container<std::vector<T>>
+    {
+        using __std = std::vector<T>;
+        using __base = rcu_container<__std>;
+    public:
+        /**
+         * @brief Initializes a new instance of the rcu_vector class.
+         */
+        rcu_vector() : __base()
+        {
+            /* stub */
+        }
+
+        /**
+         * @brief Vector assignment operator.
+         * @param other A vector of identical element and allocator types.
+         */
+        rcu_vector& operator=(const std::vector<T>& other)
+        {
+            __base::update([&](__std& v) { v = other; });
+            return *this;
+        }
+
+        /**
+         * @brief Gets a copy of the element at the specified index.
+         * @param index Index of the element to get.
+         * @returns T Copy of the element at the specified index, or a default constructed element if the index
+         *  is out of range.
+         */
+        T operator[](size_t index) const
+        {
+            return __base::read([&](const __std& v) { return (index < v.size()) ? v[index] : T(); });
+        }
+
+        /**
+         * @brief Checks if the vector contains the specified value.
+         * @param value Value to check.
+         * @returns bool True if the vector contains the specified value, false otherwise.
+         */
+        bool contains(const T& value) const
+        {
+            return __base::read([&](const __std& v) { return std::find(v.begin(), v.end(), value) != v.end(); });
+        }
+
+        /**
+         * @brief Adds an element to the end of the vector.
+         * @param value Value of the element to add.
+         */
+        void push_back(const T& value)
+        {
+            __base::update([&](__std& v) { v.push_back(value); });
+        }
+
+        /**
+         * @brief Removes all elements matching the specified value.
+         * @param value Value of the elements to remove.
+         */
+        void remove(const T& value)
+        {
+            __base::update([&](__std& v) { v.erase(std::remove(v.begin(), v.end(), value), v.end()); });
+        }
+    };
+} // namespace concurrent
+
+#endif // __CONCURRENCY_RCU_VECTOR_H__
@@ -0,0 +1,458 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file spsc_ring_buffer.h
+ * @ingroup concurrency
+ */
+#if !defined(__CONCURRENCY_SPSC_RING_BUFFER_H__)
+#define __CONCURRENCY_SPSC_RING_BUFFER_H__
+
+#include "common/Defines.h"
+#include "common/Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+namespace concurrent
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @addtogroup concurrency
+     * @{
+     */
+
+    const uint32_t SPSC_RECORD_HEADER_LENGTH = 2U;
+    const uint32_t SPSC_MAX_RECORD_LENGTH = 0xFFFFU;
+
+    /** @} */
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Bounded lock-free single-producer/single-consumer circular buffer.
+     * @note One thread may add data while one other thread gets data, without locking. The producer
+     *  publishes data by storing its index with release ordering, and the consumer acquires it before
+     *  reading (and vice versa for the space freed by the consumer). Data is copied in at most two
+     *  segments, and can be read in place without copying through peekSpans().
+     *
+     *  The buffer can also be used to store framed records (uint8_t buffers only); each record is
+     *  stored with a 16-bit length header, and is published in its entirety, so the consumer never
+     *  sees a partially written record.
+     *
+     *  If more than one thread must add (or get) data, those threads must be serialized by the caller.
+     * @tparam T Type of data to store in the buffer (must be trivially copyable).
+     * @ingroup concurrency
+     */
+    template <typename T>
+    class spsc_ring_buffer
+    {
+    public:
+        auto operator=(spsc_ring_buffer&) -> spsc_ring_buffer& = delete;
+        auto operator=(spsc_ring_buffer&&) -> spsc_ring_buffer& = delete;
+        spsc_ring_buffer(spsc_ring_buffer&) = delete;
+
+        /**
+         * @brief Represents a contiguous range of data in the buffer, split into at most two segments
+         *  where the data wraps around the end of the buffer.
+         */
+        struct span {
+            const T* first;                 //! First segment.
+            uint32_t firstLength;           //! Length of the first segment.
+            const T* second;                //! Second segment (nullptr if the data does not wrap).
+            uint32_t secondLength;          //! Length of the second segment.
+
+            /**
+             * @brief Gets the total length of the span.
+             * @returns uint32_t Total length of the span.
+             */
+            uint32_t length() const { return firstLength + secondLength; }
+            /**
+             * @brief Copies the span into a contiguous buffer.
+             * @param[out] buffer Buffer to copy into (must be at least length() long).
+             */
+            void copy(T* buffer) const
+            {
+                ::memcpy(buffer, first, firstLength * sizeof(T));
+                if (secondLength > 0U)
+                    ::memcpy(buffer + firstLength, second, secondLength * sizeof(T));
+            }
+        };
+
+        /**
+         * @brief Initializes a new instance of the spsc_ring_buffer class.
+         * @param length Length of the buffer.
+         * @param name Name of the buffer.
+         */
+        spsc_ring_buffer(uint32_t length, const char* name) :
+            m_size(length + 1U),
+            m_name(name),
+            m_buffer(nullptr),
+            m_pad0(),
+            m_iPtr(0U),
+            m_pad1(),
+            m_oPtr(0U)
+        {
+            assert(length > 0U);
+
+            // one element is always kept free, to distinguish a full buffer from an empty buffer
+            m_buffer = new T[m_size];
+            ::memset(m_buffer, 0x00, m_size * sizeof(T));
+        }
+        /**
+         * @brief Finalizes a instance of the spsc_ring_buffer class.
+         */
+        ~spsc_ring_buffer()
+        {
+            delete[] m_buffer;
+        }
+
+        /**
+         * @brief Adds data to the end of the buffer.
+         * @param[in] buffer Data buffer.
+         * @param length Length of data in buffer.
+         * @returns bool True, if data is added to the buffer, otherwise false (not enough space).
+         */
+        bool addData(const T* buffer, uint32_t length)
+        {
+            uint32_t iPtr = m_iPtr.load(std::memory_order_relaxed);
+            uint32_t free = freeSpace(iPtr, m_oPtr.load(std::memory_order_acquire));
+            if (length > free) {
+                LogError(LOG_HOST, "**** Overflow in %s ring buffer, %u > %u", m_name, length, free);
+                return false;
+            }
+
+            iPtr = copyIn(iPtr, buffer, length);
+            m_iPtr.store(iPtr, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Adds a framed record to the end of the buffer.
+         * @param[in] buffer Record data buffer.
+         * @param length Length of record data (1 - 65535).
+         * @returns bool True, if the record is added to the buffer, otherwise false (not enough space).
+         */
+        bool addRecord(const T* buffer, uint32_t length) { return addRecord(nullptr, 0U, buffer, length); }
+        /**
+         * @brief Adds a framed record, gathered from a header and a data buffer, to the end of the buffer.
+         * @param[in] header Record header buffer (may be nullptr if headerLength is 0).
+         * @param headerLength Length of record header.
+         * @param[in] buffer Record data buffer (may be nullptr if length is 0).
+         * @param length Length of record data.
+         * @returns bool True, if the record is added to the buffer, otherwise false (not enough space).
+         */
+        bool addRecord(const T* header, uint32_t headerLength, const T* buffer, uint32_t length)
+        {
+            static_assert(sizeof(T) == 1U, "framed records are only supported for byte buffers");
+
+            uint32_t recordLength = headerLength + length;
+            if (recordLength == 0U || recordLength > SPSC_MAX_RECORD_LENGTH) {
+                LogError(LOG_HOST, "**** Invalid record length in %s ring buffer, %u", m_name, recordLength);
+                return false;
+            }
+
+            uint32_t iPtr = m_iPtr.load(std::memory_order_relaxed);
+            uint32_t free = freeSpace(iPtr, m_oPtr.load(std::memory_order_acquire));
+            if (SPSC_RECORD_HEADER_LENGTH + recordLength > free) {
+                LogError(LOG_HOST, "**** Overflow in %s ring buffer, %u > %u", m_name, SPSC_RECORD_HEADER_LENGTH + recordLength, free);
+                return false;
+            }
+
+            T len[SPSC_RECORD_HEADER_LENGTH];
+            len[0U] = (T)((recordLength >> 8) & 0xFFU);
+            len[1U] = (T)(recordLength & 0xFFU);
+
+            iPtr = copyIn(iPtr, len, SPSC_RECORD_HEADER_LENGTH);
+            if (headerLength > 0U)
+                iPtr = copyIn(iPtr, header, headerLength);
+            if (length > 0U)
+                iPtr = copyIn(iPtr, buffer, length);
+
+            // the entire record is published at once
+            m_iPtr.store(iPtr, std::memory_order_release);
+            return true;
+        }
+        /**
+         * @brief Gets data from the buffer.
+         * @param[out] buffer Buffer to write data to be retrieved.
+         * @param length Length of data to retrieve.
+         * @returns bool True, if data is read from the buffer, otherwise false.
+         */
+        bool get(T* buffer, uint32_t length)
+        {
+            if (!peek(buffer, length))
+                return false;
+
+            return skip(length);
+        }
+
+        /**
+         * @brief Gets data from the buffer without removing it.
+         * @param[out] buffer Buffer to write data to be retrieved.
+         * @param length Length of data to retrieve.
+         * @returns bool True, if data is read from the buffer, otherwise false.
+         */
+        bool peek(T* buffer, uint32_t length) const
+        {
+            span s;
+            if (!peekSpans(length, s)) {
+                LogError(LOG_HOST, "**** Underflow in %s ring buffer, %u < %u", m_name, dataSize(), length);
+                return false;
+            }
+
+            s.copy(buffer);
+            return true;
+        }
+
+        /**
+         * @brief Gets data from the buffer in place, without copying or removing it.
+         * @note The data remains valid until it is removed with skip(), get() or clear().
+         * @param length Length of data to retrieve.
+         * @param[out] s Span of the data in the buffer.
+         * @returns bool True, if the buffer contains the given length of data, otherwise false.
+         */
+        bool peekSpans(uint32_t length, span& s) const
+        {
+            uint32_t oPtr = m_oPtr.load(std::memory_order_relaxed);
+            if (dataSize(m_iPtr.load(std::memory_order_acquire), oPtr) < length)
+                return false;
+
+            s.first = m_buffer + oPtr;
+            s.firstLength = std::min(length, m_size - oPtr);
+            s.secondLength = length - s.firstLength;
+            s.second = (s.secondLength > 0U) ? m_buffer : nullptr;
+            return true;
+        }
+
+        /**
+         * @brief Removes data from the front of the buffer.
+         * @param length Length of data to remove.
+         * @returns bool True, if data is removed from the buffer, otherwise false.
+         */
+        bool skip(uint32_t length)
+        {
+            uint32_t oPtr = m_oPtr.load(std::memory_order_relaxed);
+            if (dataSize(m_iPtr.load(std::memory_order_acquire), oPtr) < length)
+                return false;
+
+            m_oPtr.store(advance(oPtr, length), std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Gets the length of the next framed record in the buffer.
+         * @returns uint32_t Length of the next record, or 0 if the buffer contains no record.
+         */
+        uint32_t peekRecordLength() const
+        {
+            static_assert(sizeof(T) == 1U, "framed records are only supported for byte buffers");
+
+            span s;
+            if (!peekSpans(SPSC_RECORD_HEADER_LENGTH, s))
+                return 0U;
+
+            T len[SPSC_RECORD_HEADER_LENGTH];
+            s.copy(len);
+            return ((uint32_t)(len[0U] & 0xFFU) << 8) | (uint32_t)(len[1U] & 0xFFU);
+        }
+
+        /**
+         * @brief Gets the next framed record in the buffer in place, without copying or removing it.
+         * @note The record remains valid until it is removed with skipRecord(), getRecord() or clear().
+         * @param[out] s Span of the record data in the buffer.
+         * @returns bool True, if the buffer contains a record, otherwise false.
+         */
+        bool peekRecord(span& s) const
+        {
+            uint32_t length = peekRecordLength();
+            if (length == 0U)
+                return false;
+
+            span r;
+            if (!peekSpans(SPSC_RECORD_HEADER_LENGTH + length, r))
+                return false;
+
+            // trim the record header off the span
+            if (r.firstLength > SPSC_RECORD_HEADER_LENGTH) {
+                s.first = r.first + SPSC_RECORD_HEADER_LENGTH;
+                s.firstLength = r.firstLength - SPSC_RECORD_HEADER_LENGTH;
+                s.second = r.second;
+                s.secondLength = r.secondLength;
+            }
+            else {
+                s.first = r.second + (SPSC_RECORD_HEADER_LENGTH - r.firstLength);
+                s.firstLength = length;
+                s.second = nullptr;
+                s.secondLength = 0U;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief Removes the next framed record from the buffer.
+         * @returns bool True, if a record is removed from the buffer, otherwise false.
+         */
+        bool skipRecord()
+        {
+            uint32_t length = peekRecordLength();
+            if (length == 0U)
+                return false;
+
+            return skip(SPSC_RECORD_HEADER_LENGTH + length);
+        }
+
+        /**
+         * @brief Gets the next framed record from the buffer.
+         * @param[out] buffer Buffer to write the record data to.
+         * @param maxLength Length of the buffer; a record that does not fit is discarded.
+         * @returns uint32_t Length of the record, or 0 if the buffer contains no record.
+         */
+        uint32_t getRecord(T* buffer, uint32_t maxLength = SPSC_MAX_RECORD_LENGTH)
+        {
+            span s;
+            if (!peekRecord(s))
+                return 0U;
+
+            uint32_t length = s.length();
+            if (length > maxLength) {
+                LogError(LOG_HOST, "**** Record too long in %s ring buffer, %u > %u, discarding", m_name, length, maxLength);
+                skipRecord();
+                return 0U;
+            }
+
+            s.copy(buffer);
+            skip(SPSC_RECORD_HEADER_LENGTH + length);
+            return length;
+        }
+
+        /**
+         * @brief Removes all data from the buffer.
+         * @note This must only be called by the consumer.
+         */
+        void clear()
+        {
+            m_oPtr.store(m_iPtr.load(std::memory_order_acquire), std::memory_order_release);
+        }
+        /**
+         * @brief Returns the currently available space in the buffer.
+         * @returns uint32_t Space free in the buffer.
+         */
+        uint32_t freeSpace() const
+        {
+            return freeSpace(m_iPtr.load(std::memory_order_acquire), m_oPtr.load(std::memory_order_acquire));
+        }
+        /**
+         * @brief Returns the size of the data currently stored in the buffer.
+         * @returns uint32_t Size of data stored in the buffer.
+         */
+        uint32_t dataSize() const
+        {
+            return dataSize(m_iPtr.load(std::memory_order_acquire), m_oPtr.load(std::memory_order_acquire));
+        }
+        /**
+         * @brief Gets the length of the buffer.
+         * @returns uint32_t Length of the buffer.
+         */
+        uint32_t length() const { return m_size - 1U; }
+
+        /**
+         * @brief Helper to test if the given length of data would fit in the buffer.
+         * @param length Length to check.
+         * @returns bool True, if specified length will fit in buffer, otherwise false.
+         */
+        bool hasSpace(uint32_t length) const { return freeSpace() >= length; }
+        /**
+         * @brief Helper to return whether the buffer contains data.
+         * @returns bool True, if the buffer contains data, otherwise false.
+         */
+        bool hasData() const { return !isEmpty(); }
+        /**
+         * @brief Helper to return whether the buffer is empty or not.
+         * @returns bool True, if the buffer is empty, otherwise false.
+         */
+        bool isEmpty() const
+        {
+            return m_iPtr.load(std::memory_order_acquire) == m_oPtr.load(std::memory_order_acquire);
+        }
+
+    private:
+        static const size_t CACHE_LINE_SIZE = 64U;
+
+        uint32_t m_size;
+        const char* m_name;
+        T* m_buffer;
+
+        // the padding keeps the producer and consumer from contending on the same cache line
+        uint8_t m_pad0[CACHE_LINE_SIZE];
+        std::atomic<uint32_t> m_iPtr;
+        uint8_t m_pad1[CACHE_LINE_SIZE];
+        std::atomic<uint32_t> m_oPtr;
+
+        /**
+         * @brief Helper to advance a buffer index.
+         * @param ptr Buffer index.
+         * @param length Number of elements to advance by.
+         * @returns uint32_t Advanced buffer index.
+         */
+        uint32_t advance(uint32_t ptr, uint32_t length) const
+        {
+            ptr += length;
+            return (ptr >= m_size) ? ptr - m_size : ptr;
+        }
+
+        /**
+         * @brief Helper to get the free space between the given buffer indexes.
+         * @param iPtr Producer index.
+         * @param oPtr Consumer index.
+         * @returns uint32_t Space free in the buffer.
+         */
+        uint32_t freeSpace(uint32_t iPtr, uint32_t oPtr) const
+        {
+            return m_size - 1U - dataSize(iPtr, oPtr);
+        }
+        /**
+         * @brief Helper to get the size of the data between the given buffer indexes.
+         * @param iPtr Producer index.
+         * @param oPtr Consumer index.
+         * @returns uint32_t Size of data stored in the buffer.
+         */
+        uint32_t dataSize(uint32_t iPtr, uint32_t oPtr) const
+        {
+            return (iPtr >= oPtr) ? iPtr - oPtr : m_size - (oPtr - iPtr);
+        }
+
+        /**
+         * @brief Helper to copy data into the buffer (without publishing it).
+         * @param ptr Producer index.
+         * @param[in] buffer Data buffer.
+         * @param length Length of data in buffer.
+         * @returns uint32_t Producer index after the copied data.
+         */
+        uint32_t copyIn(uint32_t ptr, const T* buffer, uint32_t length)
+        {
+            uint32_t first = std::min(length, m_size - ptr);
+            ::memcpy(m_buffer + ptr, buffer, first * sizeof(T));
+            if (length > first)
+                ::memcpy(m_buffer, buffer + first, (length - first) * sizeof(T));
+
+            return advance(ptr, length);
+        }
+    };
+} // namespace concurrent
+
+#endif // __CONCURRENCY_SPSC_RING_BUFFER_H__
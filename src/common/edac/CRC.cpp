@@ -79,40 +79,6 @@ const uint16_t CCITT16_TABLE1[] = {
     0xF78FU, 0xE606U, 0xD49DU, 0xC514U, 0xB1ABU, 0xA022U, 0x92B9U, 0x8330U,
     0x7BC7U, 0x6A4EU, 0x58D5U, 0x495CU, 0x3DE3U, 0x2C6AU, 0x1EF1U, 0x0F78U };
 
-const uint16_t CCITT16_TABLE2[] = {
-    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0 };
-
 const uint32_t CRC32_TABLE[] = {
     0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9, 0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
     0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61, 0x350C9B64, 0x31CD86D3, 0x3C8EA00A, 0x384FBDBD,
@@ -147,6 +113,119 @@ const uint32_t CRC32_TABLE[] = {
     0x89B8FD09, 0x8D79E0BE, 0x803AC667, 0x84FBDBD0, 0x9ABC8BD5, 0x9E7D9662, 0x933EB0BB, 0x97FFAD0C,
     0xAFB010B1, 0xAB710D06, 0xA6322BDF, 0xA2F33668, 0xBCB4666D, 0xB8757BDA, 0xB5365D03, 0xB1F740B4 };
 
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/* Implements a table driven MSB-first CRC for CRCs up to 16-bits wide. */
+
+struct CRCSliceTable {
+    uint16_t poly;                          // Polynomial (aligned to the top of a 16-bit register)
+    uint32_t shift;                         // Number of bits the CRC is shifted to align it to the top of the register
+    uint16_t table[8U][256U];               // Slicing-by-8 tables; table[k] is the effect of a byte after 8 * (k + 1) bits
+
+    /* Initializes a new instance of the CRCSliceTable struct. */
+
+    CRCSliceTable(uint32_t width, uint16_t polynomial) :
+        poly((uint16_t)(polynomial << (16U - width))),
+        shift(16U - width)
+    {
+        for (uint32_t i = 0U; i < 256U; i++) {
+            uint16_t crc = (uint16_t)(i << 8);
+            for (uint32_t j = 0U; j < 8U; j++)
+                crc = (crc & 0x8000U) ? (uint16_t)((crc << 1) ^ poly) : (uint16_t)(crc << 1);
+
+            table[0U][i] = crc;
+        }
+
+        for (uint32_t k = 1U; k < 8U; k++) {
+            for (uint32_t i = 0U; i < 256U; i++)
+                table[k][i] = (uint16_t)(table[k - 1U][i] << 8) ^ table[0U][table[k - 1U][i] >> 8];
+        }
+    }
+
+    /* Updates the CRC with the given number of bits of the input buffer. */
+
+    uint16_t update(uint16_t crc, const uint8_t* in, uint32_t bitLength) const
+    {
+        uint16_t reg = (uint16_t)(crc << shift);
+        uint32_t len = bitLength >> 3;
+
+        // process 8 bytes at a time
+        while (len >= 8U) {
+            reg ^= (uint16_t)((in[0U] << 8) | in[1U]);
+            reg = table[7U][reg >> 8] ^ table[6U][reg & 0xFFU] ^ table[5U][in[2U]] ^ table[4U][in[3U]] ^
+                table[3U][in[4U]] ^ table[2U][in[5U]] ^ table[1U][in[6U]] ^ table[0U][in[7U]];
+            in += 8U;
+            len -= 8U;
+        }
+
+        // process any remaining whole bytes
+        while (len > 0U) {
+            reg = (uint16_t)(reg << 8) ^ table[0U][(reg >> 8) ^ *in++];
+            len--;
+        }
+
+        // process any trailing bits one at a time
+        uint32_t bits = bitLength & 7U;
+        for (uint32_t i = 0U; i < bits; i++) {
+            bool bit1 = (*in & (0x80U >> i)) != 0x00U;
+            bool bit2 = (reg & 0x8000U) == 0x8000U;
+
+            reg <<= 1;
+
+            if (bit1 ^ bit2)
+                reg ^= poly;
+        }
+
+        return reg >> shift;
+    }
+};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the CRC-16 (CCITT) table. */
+
+static const CRCSliceTable& crc16Table()
+{
+    static const CRCSliceTable table(16U, 0x1021U);
+    return table;
+}
+
+/* Helper to get the CRC-15 table. */
+
+static const CRCSliceTable& crc15Table()
+{
+    static const CRCSliceTable table(15U, 0x4CC5U);
+    return table;
+}
+
+/* Helper to get the CRC-12 table. */
+
+static const CRCSliceTable& crc12Table()
+{
+    static const CRCSliceTable table(12U, 0x080FU);
+    return table;
+}
+
+/* Helper to get the CRC-9 table. */
+
+static const CRCSliceTable& crc9Table()
+{
+    static const CRCSliceTable table(9U, 0x59U);
+    return table;
+}
+
+/* Helper to get the CRC-6 table. */
+
+static const CRCSliceTable& crc6Table()
+{
+    static const CRCSliceTable table(6U, 0x27U);
+    return table;
+}
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -188,16 +267,7 @@ bool CRC::checkCCITT162(const uint8_t *in, uint32_t length)
     assert(in != nullptr);
     assert(length > 2U);
 
-    union {
-        uint16_t crc16;
-        uint8_t  crc8[2U];
-    };
-
-    crc16 = 0U;
-
-    for (unsigned i = 0U; i < (length - 2U); i++)
-        crc16 = (uint16_t(crc8[0U]) << 8) ^ CCITT16_TABLE2[crc8[1U] ^ in[i]];
-
+    uint16_t crc16 = crc16Table().update(0U, in, (length - 2U) * 8U);
     crc16 = ~crc16;
 
 #if DEBUG_CRC_CHECK
@@ -205,7 +275,7 @@ bool CRC::checkCCITT162(const uint8_t *in, uint32_t length)
     LogDebugEx(LOG_HOST, "CRC::checkCCITT162()", "crc = $%04X, in = $%04X, len = %u", crc16, inCrc, length);
 #endif
 
-    return crc8[0U] == in[length - 1U] && crc8[1U] == in[length - 2U];
+    return (uint8_t)(crc16 & 0xFFU) == in[length - 1U] && (uint8_t)(crc16 >> 8) == in[length - 2U];
 }
 
 /* Encode 16-bit CRC CCITT-162. */
@@ -215,24 +285,15 @@ void CRC::addCCITT162(uint8_t* in, uint32_t length)
     assert(in != nullptr);
     assert(length > 2U);
 
-    union {
-        uint16_t crc16;
-        uint8_t  crc8[2U];
-    };
-
-    crc16 = 0U;
-
-    for (unsigned i = 0U; i < (length - 2U); i++)
-        crc16 = (uint16_t(crc8[0U]) << 8) ^ CCITT16_TABLE2[crc8[1U] ^ in[i]];
-
+    uint16_t crc16 = crc16Table().update(0U, in, (length - 2U) * 8U);
     crc16 = ~crc16;
 
 #if DEBUG_CRC_ADD
     LogDebugEx(LOG_HOST, "CRC::addCCITT162()", "crc = $%04X, len = %u", crc16, length);
 #endif
 
-    in[length - 1U] = crc8[0U];
-    in[length - 2U] = crc8[1U];
+    in[length - 1U] = (uint8_t)(crc16 & 0xFFU);
+    in[length - 2U] = (uint8_t)(crc16 >> 8);
 }
 
 /* Check 16-bit CRC CCITT-161. */
@@ -576,17 +637,9 @@ uint16_t CRC::addCRC16(uint8_t* in, uint32_t bitLength)
 
 uint16_t CRC::createCRC9(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0U;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x100U) == 0x100U;
-
-        crc <<= 1;
+    assert(in != nullptr);
 
-        if (bit1 ^ bit2)
-            crc ^= 0x59U;
-    }
+    uint16_t crc = crc9Table().update(0U, in, bitLength);
 
     crc = ~crc;
     return crc & 0x1FFU;
@@ -596,18 +649,9 @@ uint16_t CRC::createCRC9(const uint8_t* in, uint32_t bitLength)
 
 uint16_t CRC::createCRC16(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0xFFFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x8000U) == 0x8000U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x1021U;
-    }
+    assert(in != nullptr);
 
+    uint16_t crc = crc16Table().update(0xFFFFU, in, bitLength);
     return crc & 0xFFFFU;
 }
 
@@ -619,18 +663,9 @@ uint16_t CRC::createCRC16(const uint8_t* in, uint32_t bitLength)
 
 uint8_t CRC::createCRC6(const uint8_t* in, uint32_t bitLength)
 {
-    uint8_t crc = 0x3FU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x20U) == 0x20U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x27U;
-    }
+    assert(in != nullptr);
 
+    uint8_t crc = (uint8_t)crc6Table().update(0x3FU, in, bitLength);
     return crc & 0x3FU;
 }
 
@@ -638,18 +673,9 @@ uint8_t CRC::createCRC6(const uint8_t* in, uint32_t bitLength)
 
 uint16_t CRC::createCRC12(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0x0FFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x0800U) == 0x0800U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x080FU;
-    }
+    assert(in != nullptr);
 
+    uint16_t crc = crc12Table().update(0x0FFFU, in, bitLength);
     return crc & 0x0FFFU;
 }
 
@@ -657,17 +683,8 @@ uint16_t CRC::createCRC12(const uint8_t* in, uint32_t bitLength)
 
 uint16_t CRC::createCRC15(const uint8_t* in, uint32_t bitLength)
 {
-    uint16_t crc = 0x7FFFU;
-
-    for (uint32_t i = 0U; i < bitLength; i++) {
-        bool bit1 = READ_BIT(in, i) != 0x00U;
-        bool bit2 = (crc & 0x4000U) == 0x4000U;
-
-        crc <<= 1;
-
-        if (bit1 ^ bit2)
-            crc ^= 0x4CC5U;
-    }
+    assert(in != nullptr);
 
+    uint16_t crc = crc15Table().update(0x7FFFU, in, bitLength);
     return crc & 0x7FFFU;
 }
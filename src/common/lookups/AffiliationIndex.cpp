@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "lookups/AffiliationIndex.h"
+
+using namespace lookups;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the AffiliationIndex class. */
+
+AffiliationIndex::AffiliationIndex() :
+    m_mutex(),
+    m_table()
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the AffiliationIndex class. */
+
+AffiliationIndex::~AffiliationIndex() = default;
+
+/* Helper to add an owner (peer) that has affiliations to the talkgroup. */
+
+void AffiliationIndex::add(uint32_t dstId, uint32_t ownerId)
+{
+    if (dstId == 0U) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_table[dstId].insert(ownerId);
+}
+
+/* Helper to remove an owner (peer) that no longer has affiliations to the talkgroup. */
+
+void AffiliationIndex::remove(uint32_t dstId, uint32_t ownerId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_table.find(dstId);
+    if (it == m_table.end()) {
+        return;
+    }
+
+    it->second.erase(ownerId);
+    if (it->second.empty()) {
+        m_table.erase(it);
+    }
+}
+
+/* Helper to determine if the talkgroup has any affiliations, from any owner. */
+
+bool AffiliationIndex::isAffiliated(uint32_t dstId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_table.find(dstId) != m_table.end();
+}
+
+/* Helper to determine if the owner (peer) has affiliations to the talkgroup. */
+
+bool AffiliationIndex::isAffiliated(uint32_t dstId, uint32_t ownerId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_table.find(dstId);
+    if (it == m_table.end()) {
+        return false;
+    }
+
+    return it->second.find(ownerId) != it->second.end();
+}
+
+/* Gets the owners (peers) that have affiliations to the talkgroup. */
+
+std::vector<uint32_t> AffiliationIndex::owners(uint32_t dstId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_table.find(dstId);
+    if (it == m_table.end()) {
+        return std::vector<uint32_t>();
+    }
+
+    return std::vector<uint32_t>(it->second.begin(), it->second.end());
+}
+
+/* Gets the count of owners (peers) that have affiliations to the talkgroup. */
+
+uint32_t AffiliationIndex::ownerCount(uint32_t dstId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_table.find(dstId);
+    if (it == m_table.end()) {
+        return 0U;
+    }
+
+    return (uint32_t)it->second.size();
+}
+
+/* Gets the count of talkgroups that have affiliations. */
+
+uint32_t AffiliationIndex::size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (uint32_t)m_table.size();
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file AffiliationIndex.h
+ * @ingroup lookups_aff
+ * @file AffiliationIndex.cpp
+ * @ingroup lookups_aff
+ */
+#if !defined(__AFFILIATION_INDEX_H__)
+#define __AFFILIATION_INDEX_H__
+
+#include "common/Defines.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lookups
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements an aggregated index of the talkgroups affiliated across many affiliation
+     *  lookups (i.e. the affiliations of every peer connected to the FNE).
+     * @note The index is maintained by the affiliation lookups themselves (see AffiliationLookup::setAffiliationIndex()),
+     *  an owner is added to a talkgroup when its first unit affiliates, and removed when its last unit unaffiliates.
+     * @ingroup lookups_aff
+     */
+    class HOST_SW_API AffiliationIndex {
+    public:
+        /**
+         * @brief Initializes a new instance of the AffiliationIndex class.
+         */
+        AffiliationIndex();
+        /**
+         * @brief Finalizes a instance of the AffiliationIndex class.
+         */
+        ~AffiliationIndex();
+
+        /**
+         * @brief Helper to add an owner (peer) that has affiliations to the talkgroup.
+         * @param dstId Talkgroup ID.
+         * @param ownerId Owner ID.
+         */
+        void add(uint32_t dstId, uint32_t ownerId);
+        /**
+         * @brief Helper to remove an owner (peer) that no longer has affiliations to the talkgroup.
+         * @param dstId Talkgroup ID.
+         * @param ownerId Owner ID.
+         */
+        void remove(uint32_t dstId, uint32_t ownerId);
+
+        /**
+         * @brief Helper to determine if the talkgroup has any affiliations, from any owner.
+         * @param dstId Talkgroup ID.
+         * @returns bool True, if the talkgroup has affiliations, otherwise false.
+         */
+        bool isAffiliated(uint32_t dstId) const;
+        /**
+         * @brief Helper to determine if the owner (peer) has affiliations to the talkgroup.
+         * @param dstId Talkgroup ID.
+         * @param ownerId Owner ID.
+         * @returns bool True, if the owner has affiliations to the talkgroup, otherwise false.
+         */
+        bool isAffiliated(uint32_t dstId, uint32_t ownerId) const;
+        /**
+         * @brief Gets the owners (peers) that have affiliations to the talkgroup.
+         * @param dstId Talkgroup ID.
+         * @returns std::vector<uint32_t> List of owner IDs.
+         */
+        std::vector<uint32_t> owners(uint32_t dstId) const;
+        /**
+         * @brief Gets the count of owners (peers) that have affiliations to the talkgroup.
+         * @param dstId Talkgroup ID.
+         * @returns uint32_t Count of owners.
+         */
+        uint32_t ownerCount(uint32_t dstId) const;
+        /**
+         * @brief Gets the count of talkgroups that have affiliations.
+         * @returns uint32_t Count of talkgroups.
+         */
+        uint32_t size() const;
+
+    private:
+        mutable std::mutex m_mutex;
+        std::unordered_map<uint32_t, std::unordered_set<uint32_t>> m_table;
+    };
+} // namespace lookups
+
+#endif // __AFFILIATION_INDEX_H__
@@ -12,6 +12,7 @@
 
 using namespace lookups;
 
+#include <algorithm>
 #include <cassert>
 
 // ---------------------------------------------------------------------------
@@ -28,14 +29,20 @@ const uint32_t UNIT_REG_TIMEOUT = 43200U; // 12 hours
 
 AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* channelLookup, bool verbose) :
     m_rfGrantChCnt(0U),
+    m_affMutex(),
     m_unitRegTable(),
-    m_unitRegTimers(),
     m_grpAffTable(),
+    m_grpAffDstTable(),
     m_grantChTable(),
     m_grantSrcIdTable(),
     m_uuGrantedTable(),
     m_netGrantedTable(),
     m_grantTimers(),
+    m_grantIndexMutex(),
+    m_grantDstByChTable(),
+    m_grantDstBySrcIdTable(),
+    m_affIndex(nullptr),
+    m_affIndexOwnerId(0U),
     m_releaseGrant(nullptr),
     m_name(),
     m_chLookup(channelLookup),
@@ -46,10 +53,6 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
 
     m_name = name;
 
-    m_unitRegTable.clear();
-    m_unitRegTimers.clear();
-    m_grpAffTable.clear();
-
     m_grantChTable.clear();
     m_grantSrcIdTable.clear();
     m_grantTimers.clear();
@@ -57,20 +60,49 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
 
 /* Finalizes a instance of the AffiliationLookup class. */
 
-AffiliationLookup::~AffiliationLookup() = default;
+AffiliationLookup::~AffiliationLookup()
+{
+    // remove our affiliated talkgroups from the aggregated index
+    setAffiliationIndex(nullptr, 0U);
+}
 
-/* Helper to group affiliate a source ID. */
+/* Gets the count of unit registrations. */
 
-void AffiliationLookup::unitReg(uint32_t srcId)
+uint32_t AffiliationLookup::unitRegSize() const
 {
-    if (isUnitReg(srcId)) {
-        return;
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return (uint32_t)m_unitRegTable.size();
+}
+
+/* Gets the unit registration table. */
+
+std::vector<uint32_t> AffiliationLookup::unitRegTable() const
+{
+    std::vector<uint32_t> table = std::vector<uint32_t>();
+
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    table.reserve(m_unitRegTable.size());
+    for (auto& entry : m_unitRegTable) {
+        table.push_back(entry.first);
     }
 
-    m_unitRegTable.push_back(srcId);
+    return table;
+}
 
-    m_unitRegTimers[srcId] = Timer(1000U, UNIT_REG_TIMEOUT);
-    m_unitRegTimers[srcId].start();
+/* Helper to group affiliate a source ID. */
+
+void AffiliationLookup::unitReg(uint32_t srcId)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_affMutex);
+        if (m_unitRegTable.find(srcId) != m_unitRegTable.end()) {
+            return;
+        }
+
+        Timer timer = Timer(1000U, UNIT_REG_TIMEOUT);
+        timer.start();
+        m_unitRegTable[srcId] = timer;
+    }
 
     if (m_verbose) {
         LogMessage(LOG_HOST, "%s, unit registration, srcId = %u",
@@ -95,17 +127,11 @@ bool AffiliationLookup::unitDereg(uint32_t srcId, bool automatic)
 
     groupUnaff(srcId);
 
-    m_unitRegTimers[srcId].stop();
-
     // remove dynamic unit registration table entry
-    m_unitRegTable.lock(false);
-    if (std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId) != m_unitRegTable.end()) {
-        auto it = std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId);
-        m_unitRegTable.unlock();
-        m_unitRegTable.erase(it);
-        ret = true;
+    {
+        std::lock_guard<std::mutex> lock(m_affMutex);
+        ret = m_unitRegTable.erase(srcId) > 0U;
     }
-    m_unitRegTable.unlock();
 
     if (ret) {
         if (m_unitDereg != nullptr) {
@@ -124,8 +150,10 @@ void AffiliationLookup::touchUnitReg(uint32_t srcId)
         return;
     }
 
-    if (isUnitReg(srcId)) {
-        m_unitRegTimers[srcId].start();
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_unitRegTable.find(srcId);
+    if (it != m_unitRegTable.end()) {
+        it->second.start();
     }
 }
 
@@ -137,8 +165,10 @@ uint32_t AffiliationLookup::unitRegTimeout(uint32_t srcId)
         return 0U;
     }
 
-    if (isUnitReg(srcId)) {
-        return m_unitRegTimers[srcId].getTimeout();
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_unitRegTable.find(srcId);
+    if (it != m_unitRegTable.end()) {
+        return it->second.getTimeout();
     }
 
     return 0U;
@@ -152,8 +182,10 @@ uint32_t AffiliationLookup::unitRegTimer(uint32_t srcId)
         return 0U;
     }
 
-    if (isUnitReg(srcId)) {
-        return m_unitRegTimers[srcId].getTimer();
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_unitRegTable.find(srcId);
+    if (it != m_unitRegTable.end()) {
+        return it->second.getTimer();
     }
 
     return 0U;
@@ -164,38 +196,60 @@ uint32_t AffiliationLookup::unitRegTimer(uint32_t srcId)
 bool AffiliationLookup::isUnitReg(uint32_t srcId) const
 {
     // lookup dynamic unit registration table entry
-    m_unitRegTable.lock(false);
-    if (std::find(m_unitRegTable.begin(), m_unitRegTable.end(), srcId) != m_unitRegTable.end()) {
-        m_unitRegTable.unlock();
-        return true;
-    }
-    else {
-        m_unitRegTable.unlock();
-        return false;
-    }
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return m_unitRegTable.find(srcId) != m_unitRegTable.end();
 }
 
 /* Helper to release unit registrations. */
 
 void AffiliationLookup::clearUnitReg()
 {
-    std::vector<uint32_t> srcToRel = std::vector<uint32_t>();
     LogWarning(LOG_HOST, "%s, releasing all unit registrations", m_name.c_str());
+
+    std::lock_guard<std::mutex> lock(m_affMutex);
     m_unitRegTable.clear();
 }
 
+/* Gets the count of affiliations. */
+
+uint32_t AffiliationLookup::grpAffSize() const
+{
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return (uint32_t)m_grpAffTable.size();
+}
+
+/* Gets the group affiliation table. */
+
+std::unordered_map<uint32_t, uint32_t> AffiliationLookup::grpAffTable() const
+{
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return m_grpAffTable;
+}
+
 /* Helper to group affiliate a source ID. */
 
 void AffiliationLookup::groupAff(uint32_t srcId, uint32_t dstId)
 {
-    if (!isGroupAff(srcId, dstId)) {
+    {
+        std::lock_guard<std::mutex> lock(m_affMutex);
+        auto it = m_grpAffTable.find(srcId);
+        if (it != m_grpAffTable.end()) {
+            if (it->second == dstId) {
+                return;
+            }
+
+            // the source ID is moving to another talkgroup
+            unindexGroupAff(srcId, it->second);
+        }
+
         // update dynamic affiliation table
         m_grpAffTable[srcId] = dstId;
+        indexGroupAff(srcId, dstId);
+    }
 
-        if (m_verbose) {
-            LogMessage(LOG_HOST, "%s, group affiliation, srcId = %u, dstId = %u",
-                m_name.c_str(), srcId, dstId);
-        }
+    if (m_verbose) {
+        LogMessage(LOG_HOST, "%s, group affiliation, srcId = %u, dstId = %u",
+            m_name.c_str(), srcId, dstId);
     }
 }
 
@@ -203,62 +257,78 @@ void AffiliationLookup::groupAff(uint32_t srcId, uint32_t dstId)
 
 bool AffiliationLookup::groupUnaff(uint32_t srcId)
 {
-    // lookup dynamic affiliation table entry
-    if (m_grpAffTable.find(srcId) != m_grpAffTable.end()) {
-        uint32_t tblDstId = m_grpAffTable.at(srcId);
-        if (m_verbose) {
-            LogMessage(LOG_HOST, "%s, group unaffiliation, srcId = %u, dstId = %u",
-                m_name.c_str(), srcId, tblDstId);
+    uint32_t tblDstId = 0U;
+
+    // lookup and remove dynamic affiliation table entry
+    {
+        std::lock_guard<std::mutex> lock(m_affMutex);
+        auto it = m_grpAffTable.find(srcId);
+        if (it == m_grpAffTable.end()) {
+            return false;
         }
-    } else {
-        return false;
-    }
 
-    // remove dynamic affiliation table entry
-    try {
-        uint32_t entry = m_grpAffTable.at(srcId); // this value will get discarded
-        (void)entry;                              // but some variants of C++ mark the unordered_map<>::at as nodiscard
-        m_grpAffTable.erase(srcId);
-        return true;
+        tblDstId = it->second;
+        m_grpAffTable.erase(it);
+        unindexGroupAff(srcId, tblDstId);
     }
-    catch (...) {
-        return false;
+
+    if (m_verbose) {
+        LogMessage(LOG_HOST, "%s, group unaffiliation, srcId = %u, dstId = %u",
+            m_name.c_str(), srcId, tblDstId);
     }
+
+    return true;
 }
 
 /* Helper to determine if the group destination ID has any affiations. */
 
 bool AffiliationLookup::hasGroupAff(uint32_t dstId) const
+{
+    // lookup dynamic affiliation destination table entry
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    return m_grpAffDstTable.find(dstId) != m_grpAffDstTable.end();
+}
+
+/* Helper to determine if the source ID has affiliated to the group destination ID. */
+
+bool AffiliationLookup::isGroupAff(uint32_t srcId, uint32_t dstId) const
 {
     // lookup dynamic affiliation table entry
-    m_grpAffTable.lock(false);
-    for (auto entry : m_grpAffTable) {
-        if (entry.second == dstId) {
-            m_grpAffTable.unlock();
-            return true;
-        }
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_grpAffTable.find(srcId);
+    if (it != m_grpAffTable.end()) {
+        return it->second == dstId;
     }
-    m_grpAffTable.unlock();
 
     return false;
 }
 
-/* Helper to determine if the source ID has affiliated to the group destination ID. */
+/* Helper to get the group destination ID the source ID is affiliated to. */
 
-bool AffiliationLookup::isGroupAff(uint32_t srcId, uint32_t dstId) const
+uint32_t AffiliationLookup::getGroupAff(uint32_t srcId) const
 {
     // lookup dynamic affiliation table entry
-    m_grpAffTable.lock(false);
-    if (m_grpAffTable.find(srcId) != m_grpAffTable.end()) {
-        uint32_t tblDstId = m_grpAffTable.at(srcId);
-        if (tblDstId == dstId) {
-            m_grpAffTable.unlock();
-            return true;
-        }
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_grpAffTable.find(srcId);
+    if (it != m_grpAffTable.end()) {
+        return it->second;
     }
-    m_grpAffTable.unlock();
 
-    return false;
+    return 0U;
+}
+
+/* Helper to get the source IDs affiliated to the group destination ID. */
+
+std::vector<uint32_t> AffiliationLookup::getGroupAffSrcIds(uint32_t dstId) const
+{
+    // lookup dynamic affiliation destination table entry
+    std::lock_guard<std::mutex> lock(m_affMutex);
+    auto it = m_grpAffDstTable.find(dstId);
+    if (it != m_grpAffDstTable.end()) {
+        return std::vector<uint32_t>(it->second.begin(), it->second.end());
+    }
+
+    return std::vector<uint32_t>();
 }
 
 /* Helper to release group affiliations. */
@@ -272,24 +342,38 @@ std::vector<uint32_t> AffiliationLookup::clearGroupAff(uint32_t dstId, bool rele
 
     if (dstId == 0U && releaseAll) {
         LogWarning(LOG_HOST, "%s, releasing all group affiliations", m_name.c_str());
-        for (auto entry : m_grpAffTable) {
-            uint32_t srcId = entry.first;
-            srcToRel.push_back(srcId);
+
+        std::lock_guard<std::mutex> lock(m_affMutex);
+        srcToRel.reserve(m_grpAffTable.size());
+        for (auto& entry : m_grpAffTable) {
+            srcToRel.push_back(entry.first);
+        }
+
+        if (m_affIndex != nullptr) {
+            for (auto& entry : m_grpAffDstTable) {
+                m_affIndex->remove(entry.first, m_affIndexOwnerId);
+            }
         }
+
+        m_grpAffTable.clear();
+        m_grpAffDstTable.clear();
     }
     else {
         LogWarning(LOG_HOST, "%s, releasing group affiliations, dstId = %u", m_name.c_str(), dstId);
-        for (auto entry : m_grpAffTable) {
-            uint32_t srcId = entry.first;
-            uint32_t grpId = entry.second;
-            if (grpId == dstId) {
-                srcToRel.push_back(srcId);
+
+        std::lock_guard<std::mutex> lock(m_affMutex);
+        auto it = m_grpAffDstTable.find(dstId);
+        if (it != m_grpAffDstTable.end()) {
+            srcToRel.assign(it->second.begin(), it->second.end());
+            for (uint32_t srcId : srcToRel) {
+                m_grpAffTable.erase(srcId);
             }
-        }
-    }
 
-    for (auto srcId : srcToRel) {
-        m_grpAffTable.erase(srcId);
+            m_grpAffDstTable.erase(it);
+            if (m_affIndex != nullptr) {
+                m_affIndex->remove(dstId, m_affIndexOwnerId);
+            }
+        }
     }
 
     return srcToRel;
@@ -312,15 +396,7 @@ bool AffiliationLookup::grantCh(uint32_t dstId, uint32_t srcId, uint32_t grantTi
         return false;
     }
 
-    m_grantChTable[dstId] = chNo;
-    m_grantSrcIdTable[dstId] = srcId;
-    m_rfGrantChCnt++;
-
-    m_uuGrantedTable[dstId] = !grp;
-    m_netGrantedTable[dstId] = netGranted;
-
-    m_grantTimers[dstId] = Timer(1000U, grantTimeout);
-    m_grantTimers[dstId].start();
+    addGrant(dstId, srcId, chNo, grantTimeout, grp, netGranted);
 
     if (m_verbose) {
         LogMessage(LOG_HOST, "%s, granting channel, chNo = %u, dstId = %u, srcId = %u, group = %u",
@@ -355,7 +431,7 @@ bool AffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll)
     if (dstId == 0U && releaseAll) {
         LogWarning(LOG_HOST, "%s, force releasing all channel grants", m_name.c_str());
 
-        m_grantChTable.lock();
+        m_grantChTable.lock(false);
         std::vector<uint32_t> gntsToRel = std::vector<uint32_t>();
         for (auto entry : m_grantChTable) {
             uint32_t dstId = entry.first;
@@ -383,21 +459,9 @@ bool AffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll)
             m_releaseGrant(chNo, dstId, 0U);
         }
 
-        m_grantChTable.erase(dstId);
-        m_grantSrcIdTable.erase(dstId);
-        m_uuGrantedTable.erase(dstId);
-        m_netGrantedTable.erase(dstId);
+        removeGrant(dstId, chNo);
         m_chLookup->addRFCh(chNo, true);
 
-        if (m_rfGrantChCnt > 0U) {
-            m_rfGrantChCnt--;
-        }
-        else {
-            m_rfGrantChCnt = 0U;
-        }
-
-        m_grantTimers[dstId].stop();
-
         return true;
     }
 
@@ -412,17 +476,8 @@ bool AffiliationLookup::isChBusy(uint32_t chNo) const
         return false;
     }
 
-    // lookup dynamic channel grant table entry
-    m_grantChTable.lock(false);
-    for (auto entry : m_grantChTable) {
-        if (entry.second == chNo) {
-            m_grantChTable.unlock();
-            return true;
-        }
-    }
-    m_grantChTable.unlock();
-
-    return false;
+    // lookup dynamic channel grant index entry
+    return getGrantCntByCh(chNo) > 0U;
 }
 
 /* Helper to determine if the destination ID is already granted. */
@@ -434,19 +489,15 @@ bool AffiliationLookup::isGranted(uint32_t dstId) const
     }
 
     // lookup dynamic channel grant table entry
+    bool granted = false;
     m_grantChTable.lock(false);
-    for (auto entry : m_grantChTable) {
-        uint32_t gntDstId = entry.first;
-        uint32_t chNo = entry.second;
-
-        if (gntDstId == dstId && chNo != 0U) {
-            m_grantChTable.unlock();
-            return true;
-        }
+    auto it = m_grantChTable.find(dstId);
+    if (it != m_grantChTable.end()) {
+        granted = it->second != 0U;
     }
     m_grantChTable.unlock();
 
-    return false;
+    return granted;
 }
 
 /* Helper to determine if the destination ID is network granted. */
@@ -458,19 +509,15 @@ bool AffiliationLookup::isGroup(uint32_t dstId) const
     }
 
     // lookup U-U grant flag table entry
+    bool group = true;
     m_uuGrantedTable.lock(false);
-    for (auto entry : m_uuGrantedTable) {
-        uint32_t gntDstId = entry.first;
-        bool uu = entry.second;
-
-        if (gntDstId == dstId) {
-            m_uuGrantedTable.unlock();
-            return !uu;
-        }
+    auto it = m_uuGrantedTable.find(dstId);
+    if (it != m_uuGrantedTable.end()) {
+        group = !it->second;
     }
     m_uuGrantedTable.unlock();
 
-    return true;
+    return group;
 }
 
 /* Helper to determine if the destination ID is network granted. */
@@ -482,19 +529,15 @@ bool AffiliationLookup::isNetGranted(uint32_t dstId) const
     }
 
     // lookup net granted flag table entry
+    bool net = false;
     m_netGrantedTable.lock(false);
-    for (auto entry : m_netGrantedTable) {
-        uint32_t gntDstId = entry.first;
-        bool net = entry.second;
-
-        if (gntDstId == dstId) {
-            m_netGrantedTable.unlock();
-            return net;
-        }
+    auto it = m_netGrantedTable.find(dstId);
+    if (it != m_netGrantedTable.end()) {
+        net = it->second;
     }
     m_netGrantedTable.unlock();
 
-    return false;
+    return net;
 }
 
 /* Helper to get the channel granted for the given destination ID. */
@@ -516,15 +559,12 @@ uint32_t AffiliationLookup::getGrantedCh(uint32_t dstId)
 
 uint32_t AffiliationLookup::getGrantedDstByCh(uint32_t chNo)
 {
-    // lookup dynamic channel grant table entry
-    m_grantChTable.lock(false);
-    for (auto entry : m_grantChTable) {
-        if (entry.second == chNo) {
-            m_grantChTable.unlock();
-            return entry.first;
-        }
+    // lookup dynamic channel grant index entry
+    std::lock_guard<std::mutex> lock(m_grantIndexMutex);
+    auto it = m_grantDstByChTable.find(chNo);
+    if (it != m_grantDstByChTable.end() && !it->second.empty()) {
+        return it->second.front();
     }
-    m_grantChTable.unlock();
 
     return 0U;
 }
@@ -537,15 +577,12 @@ uint32_t AffiliationLookup::getGrantedBySrcId(uint32_t srcId)
         return 0U;
     }
 
-    // lookup dynamic channel grant source table entry
-    m_grantSrcIdTable.lock(false);
-    for (auto entry : m_grantSrcIdTable) {
-        if (entry.second == srcId) {
-            m_grantSrcIdTable.unlock();
-            return entry.first;
-        }
+    // lookup dynamic channel grant source index entry
+    std::lock_guard<std::mutex> lock(m_grantIndexMutex);
+    auto it = m_grantDstBySrcIdTable.find(srcId);
+    if (it != m_grantDstBySrcIdTable.end()) {
+        return it->second;
     }
-    m_grantSrcIdTable.unlock();
 
     return 0U;
 }
@@ -565,6 +602,29 @@ uint32_t AffiliationLookup::getGrantedSrcId(uint32_t dstId)
     return 0U;
 }
 
+/* Helper to set the aggregated affiliation index this lookup reports its affiliated talkgroups to. */
+
+void AffiliationLookup::setAffiliationIndex(AffiliationIndex* index, uint32_t ownerId)
+{
+    std::lock_guard<std::mutex> lock(m_affMutex);
+
+    // move the affiliated talkgroups from the previous index to the new index
+    if (m_affIndex != nullptr) {
+        for (auto& entry : m_grpAffDstTable) {
+            m_affIndex->remove(entry.first, m_affIndexOwnerId);
+        }
+    }
+
+    m_affIndex = index;
+    m_affIndexOwnerId = ownerId;
+
+    if (m_affIndex != nullptr) {
+        for (auto& entry : m_grpAffDstTable) {
+            m_affIndex->add(entry.first, m_affIndexOwnerId);
+        }
+    }
+}
+
 /* Updates the processor by the passed number of milliseconds. */
 
 void AffiliationLookup::clock(uint32_t ms)
@@ -590,18 +650,17 @@ void AffiliationLookup::clock(uint32_t ms)
     }
 
     if (!m_disableUnitRegTimeout) {
-        m_unitRegTable.spinlock();
-
         // clock all the unit registration timers
-        m_unitRegTable.lock(false);
         std::vector<uint32_t> unitsToDereg = std::vector<uint32_t>();
-        for (uint32_t srcId : m_unitRegTable) {
-            m_unitRegTimers[srcId].clock(ms);
-            if (m_unitRegTimers[srcId].isRunning() && m_unitRegTimers[srcId].hasExpired()) {
-                unitsToDereg.push_back(srcId);
+        {
+            std::lock_guard<std::mutex> lock(m_affMutex);
+            for (auto& entry : m_unitRegTable) {
+                entry.second.clock(ms);
+                if (entry.second.isRunning() && entry.second.hasExpired()) {
+                    unitsToDereg.push_back(entry.first);
+                }
             }
         }
-        m_unitRegTable.unlock();
 
         // release units registrations that have timed out
         for (uint32_t srcId : unitsToDereg) {
@@ -609,3 +668,133 @@ void AffiliationLookup::clock(uint32_t ms)
         }
     }
 }
+
+// ---------------------------------------------------------------------------
+//  Protected Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to add a channel grant to the grant tables. */
+
+void AffiliationLookup::addGrant(uint32_t dstId, uint32_t srcId, uint32_t chNo, uint32_t grantTimeout, bool grp, bool netGranted)
+{
+    uint32_t prevChNo = 0U;
+    if (isGranted(dstId)) {
+        prevChNo = m_grantChTable.at(dstId);
+    }
+
+    m_grantChTable[dstId] = chNo;
+    m_grantSrcIdTable[dstId] = srcId;
+    m_rfGrantChCnt++;
+
+    m_uuGrantedTable[dstId] = !grp;
+    m_netGrantedTable[dstId] = netGranted;
+
+    m_grantTimers[dstId] = Timer(1000U, grantTimeout);
+    m_grantTimers[dstId].start();
+
+    // update the channel and source indexes
+    std::lock_guard<std::mutex> lock(m_grantIndexMutex);
+    if (prevChNo != 0U) {
+        std::vector<uint32_t>& dstIds = m_grantDstByChTable[prevChNo];
+        dstIds.erase(std::remove(dstIds.begin(), dstIds.end(), dstId), dstIds.end());
+        if (dstIds.empty()) {
+            m_grantDstByChTable.erase(prevChNo);
+        }
+    }
+
+    m_grantDstByChTable[chNo].push_back(dstId);
+    m_grantDstBySrcIdTable[srcId] = dstId;
+}
+
+/* Helper to remove a channel grant from the grant tables. */
+
+void AffiliationLookup::removeGrant(uint32_t dstId, uint32_t chNo)
+{
+    uint32_t srcId = 0U;
+    m_grantSrcIdTable.lock(false);
+    auto it = m_grantSrcIdTable.find(dstId);
+    if (it != m_grantSrcIdTable.end()) {
+        srcId = it->second;
+    }
+    m_grantSrcIdTable.unlock();
+
+    m_grantChTable.erase(dstId);
+    m_grantSrcIdTable.erase(dstId);
+    m_uuGrantedTable.erase(dstId);
+    m_netGrantedTable.erase(dstId);
+
+    if (m_rfGrantChCnt > 0U) {
+        m_rfGrantChCnt--;
+    }
+    else {
+        m_rfGrantChCnt = 0U;
+    }
+
+    m_grantTimers[dstId].stop();
+
+    // update the channel and source indexes
+    std::lock_guard<std::mutex> lock(m_grantIndexMutex);
+    auto chIt = m_grantDstByChTable.find(chNo);
+    if (chIt != m_grantDstByChTable.end()) {
+        std::vector<uint32_t>& dstIds = chIt->second;
+        dstIds.erase(std::remove(dstIds.begin(), dstIds.end(), dstId), dstIds.end());
+        if (dstIds.empty()) {
+            m_grantDstByChTable.erase(chIt);
+        }
+    }
+
+    auto srcIt = m_grantDstBySrcIdTable.find(srcId);
+    if (srcIt != m_grantDstBySrcIdTable.end() && srcIt->second == dstId) {
+        m_grantDstBySrcIdTable.erase(srcIt);
+    }
+}
+
+/* Gets the count of grants on the given channel. */
+
+uint32_t AffiliationLookup::getGrantCntByCh(uint32_t chNo) const
+{
+    std::lock_guard<std::mutex> lock(m_grantIndexMutex);
+    auto it = m_grantDstByChTable.find(chNo);
+    if (it != m_grantDstByChTable.end()) {
+        return (uint32_t)it->second.size();
+    }
+
+    return 0U;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to add a source ID to the group destination ID affiliation index. */
+
+void AffiliationLookup::indexGroupAff(uint32_t srcId, uint32_t dstId)
+{
+    std::unordered_set<uint32_t>& srcIds = m_grpAffDstTable[dstId];
+    srcIds.insert(srcId);
+
+    // the first affiliation to the talkgroup is reported to the aggregated index
+    if (srcIds.size() == 1U && m_affIndex != nullptr) {
+        m_affIndex->add(dstId, m_affIndexOwnerId);
+    }
+}
+
+/* Helper to remove a source ID from the group destination ID affiliation index. */
+
+void AffiliationLookup::unindexGroupAff(uint32_t srcId, uint32_t dstId)
+{
+    auto it = m_grpAffDstTable.find(dstId);
+    if (it == m_grpAffDstTable.end()) {
+        return;
+    }
+
+    it->second.erase(srcId);
+
+    // the last affiliation to the talkgroup is removed from the aggregated index
+    if (it->second.empty()) {
+        m_grpAffDstTable.erase(it);
+        if (m_affIndex != nullptr) {
+            m_affIndex->remove(dstId, m_affIndexOwnerId);
+        }
+    }
+}
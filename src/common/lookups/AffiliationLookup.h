@@ -23,12 +23,17 @@
 #include "common/Defines.h"
 #include "common/concurrent/vector.h"
 #include "common/concurrent/unordered_map.h"
+#include "common/lookups/AffiliationIndex.h"
 #include "common/lookups/ChannelLookup.h"
 #include "common/Timer.h"
 
 #include <cstdio>
 #include <algorithm>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace lookups
 {
@@ -39,6 +44,9 @@ namespace lookups
     /**
      * @brief Implements a lookup table class that contains subscriber registration
      *  and group affiliation information.
+     * @note Unit registrations, group affiliations and channel grants are all hash indexed, in both
+     *  directions where needed (srcId -> dstId and dstId -> srcIds for affiliations, dstId -> chNo and
+     *  chNo -> dstIds for grants, srcId -> dstId for grant sources), so no lookup scans a table.
      * @ingroup lookups_aff
      */
     class HOST_SW_API AffiliationLookup {
@@ -60,12 +68,12 @@ namespace lookups
          * @brief Gets the count of unit registrations.
          * @returns uint32_t Total count of unit registrations.
          */
-        uint32_t unitRegSize() const { return m_unitRegTable.size(); }
+        uint32_t unitRegSize() const;
         /**
          * @brief Gets the unit registration table.
          * @returns std::vector<uint32> Unit Registration Table.
          */
-        std::vector<uint32_t> unitRegTable() const { return m_unitRegTable.get(); }
+        std::vector<uint32_t> unitRegTable() const;
         /**
          * @brief Helper to register a source ID.
          * @param srcId Source Radio ID.
@@ -112,12 +120,12 @@ namespace lookups
          * @brief Gets the count of affiliations.
          * @returns uint32_t Total count of group affiliations.
          */
-        uint32_t grpAffSize() const { return m_grpAffTable.size(); }
+        uint32_t grpAffSize() const;
         /**
          * @brief Gets the group affiliation table.
          * @returns std::unordered_map<uint32_t, uint32_t> Group Affiliation Table.
          */
-        std::unordered_map<uint32_t, uint32_t> grpAffTable() const { return m_grpAffTable.get(); }
+        std::unordered_map<uint32_t, uint32_t> grpAffTable() const;
         /**
          * @brief Helper to group affiliate a source ID.
          * @param srcId Source Radio ID.
@@ -143,6 +151,18 @@ namespace lookups
          * @returns bool True, if the source ID is affiliated to the talkgroup ID, otherwise false.
          */
         virtual bool isGroupAff(uint32_t srcId, uint32_t dstId) const;
+        /**
+         * @brief Helper to get the group destination ID the source ID is affiliated to.
+         * @param srcId Source Radio ID.
+         * @returns uint32_t Talkgroup ID the source ID is affiliated to, or 0 if the source ID is not affiliated.
+         */
+        virtual uint32_t getGroupAff(uint32_t srcId) const;
+        /**
+         * @brief Helper to get the source IDs affiliated to the group destination ID.
+         * @param dstId Talkgroup ID.
+         * @returns std::vector<uint32_t> List of source IDs affiliated to the talkgroup ID.
+         */
+        virtual std::vector<uint32_t> getGroupAffSrcIds(uint32_t dstId) const;
         /**
          * @brief Helper to release group affiliations.
          * @param dstId Talkgroup ID.
@@ -274,12 +294,20 @@ namespace lookups
          */
         void setUnitDeregCallback(std::function<void(uint32_t, bool)>&& callback) { m_unitDereg = callback; }
 
+        /**
+         * @brief Helper to set the aggregated affiliation index this lookup reports its affiliated talkgroups to.
+         * @param index Instance of the AffiliationIndex class (or nullptr to stop reporting).
+         * @param ownerId Owner ID this lookup reports its affiliated talkgroups as (i.e. the peer ID).
+         */
+        void setAffiliationIndex(AffiliationIndex* index, uint32_t ownerId);
+
     protected:
         uint8_t m_rfGrantChCnt;
 
-        concurrent::vector<uint32_t> m_unitRegTable;
-        concurrent::unordered_map<uint32_t, Timer> m_unitRegTimers;
-        concurrent::unordered_map<uint32_t, uint32_t> m_grpAffTable;
+        mutable std::mutex m_affMutex;
+        std::unordered_map<uint32_t, Timer> m_unitRegTable;
+        std::unordered_map<uint32_t, uint32_t> m_grpAffTable;
+        std::unordered_map<uint32_t, std::unordered_set<uint32_t>> m_grpAffDstTable;
 
         concurrent::unordered_map<uint32_t, uint32_t> m_grantChTable;
         concurrent::unordered_map<uint32_t, uint32_t> m_grantSrcIdTable;
@@ -287,6 +315,13 @@ namespace lookups
         concurrent::unordered_map<uint32_t, bool> m_netGrantedTable;
         concurrent::unordered_map<uint32_t, Timer> m_grantTimers;
 
+        mutable std::mutex m_grantIndexMutex;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_grantDstByChTable;
+        std::unordered_map<uint32_t, uint32_t> m_grantDstBySrcIdTable;
+
+        AffiliationIndex* m_affIndex;
+        uint32_t m_affIndexOwnerId;
+
         //                 chNo      dstId     slot
         std::function<void(uint32_t, uint32_t, uint8_t)> m_releaseGrant;
         //                 srcId     auto
@@ -298,6 +333,45 @@ namespace lookups
         bool m_disableUnitRegTimeout;
 
         bool m_verbose;
+
+        /**
+         * @brief Helper to add a channel grant to the grant tables.
+         * @param dstId Destination Address.
+         * @param srcId Source Radio ID.
+         * @param chNo Channel Number.
+         * @param grantTimeout Time before the grant times out from inactivity.
+         * @param grp Flag indicating the grant is for a talkgroup.
+         * @param netGranted Flag indicating the grant came from network traffic.
+         */
+        void addGrant(uint32_t dstId, uint32_t srcId, uint32_t chNo, uint32_t grantTimeout, bool grp, bool netGranted);
+        /**
+         * @brief Helper to remove a channel grant from the grant tables.
+         * @param dstId Destination Address.
+         * @param chNo Channel Number.
+         */
+        void removeGrant(uint32_t dstId, uint32_t chNo);
+        /**
+         * @brief Gets the count of grants on the given channel.
+         * @param chNo Channel Number.
+         * @returns uint32_t Count of grants on the channel.
+         */
+        uint32_t getGrantCntByCh(uint32_t chNo) const;
+
+    private:
+        /**
+         * @brief Helper to add a source ID to the group destination ID affiliation index.
+         * @note The affiliation mutex must be held.
+         * @param srcId Source Radio ID.
+         * @param dstId Talkgroup ID.
+         */
+        void indexGroupAff(uint32_t srcId, uint32_t dstId);
+        /**
+         * @brief Helper to remove a source ID from the group destination ID affiliation index.
+         * @note The affiliation mutex must be held.
+         * @param srcId Source Radio ID.
+         * @param dstId Talkgroup ID.
+         */
+        void unindexGroupAff(uint32_t srcId, uint32_t dstId);
     };
 } // namespace lookups
 
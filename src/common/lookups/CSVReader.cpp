@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "lookups/CSVReader.h"
+
+using namespace lookups;
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the CSVReader class. */
+
+CSVReader::CSVReader(bool skipEmpty, char delim) :
+    m_skipEmpty(skipEmpty),
+    m_delim(delim),
+    m_buffer(),
+    m_data(nullptr),
+    m_length(0U),
+    m_pos(0U),
+    m_line(nullptr),
+    m_lineLen(0U),
+    m_field(),
+    m_fieldLen(),
+    m_fieldCnt(0U)
+{
+    /* stub */
+}
+
+/* Reads the given file into memory. */
+
+bool CSVReader::open(const std::string& filename)
+{
+    FILE* fp = ::fopen(filename.c_str(), "rb");
+    if (fp == nullptr)
+        return false;
+
+    if (::fseek(fp, 0L, SEEK_END) != 0) {
+        ::fclose(fp);
+        return false;
+    }
+
+    long size = ::ftell(fp);
+    if (size < 0L) {
+        ::fclose(fp);
+        return false;
+    }
+
+    ::rewind(fp);
+
+    m_buffer.resize((size_t)size);
+    size_t read = 0U;
+    if (size > 0L)
+        read = ::fread(m_buffer.data(), 1U, (size_t)size, fp);
+    ::fclose(fp);
+
+    if (read != (size_t)size)
+        return false;
+
+    open(m_buffer.data(), m_buffer.size());
+    return true;
+}
+
+/* Sets the data to tokenize. */
+
+void CSVReader::open(const char* data, size_t length)
+{
+    m_data = data;
+    m_length = length;
+    m_pos = 0U;
+
+    m_line = nullptr;
+    m_lineLen = 0U;
+    m_fieldCnt = 0U;
+}
+
+/* Advances to and tokenizes the next line. */
+
+bool CSVReader::next()
+{
+    while (m_pos < m_length) {
+        const char* line = m_data + m_pos;
+        size_t remaining = m_length - m_pos;
+
+        const char* end = (const char*)::memchr(line, '\n', remaining);
+        size_t length = (end != nullptr) ? (size_t)(end - line) : remaining;
+        m_pos += length + 1U;
+
+        // strip the carriage return of CRLF line endings
+        if (length > 0U && line[length - 1U] == '\r')
+            length--;
+
+        // skip empty lines and comments
+        if (length == 0U || line[0U] == '#')
+            continue;
+
+        m_line = line;
+        m_lineLen = length;
+        tokenize();
+        return true;
+    }
+
+    m_line = nullptr;
+    m_lineLen = 0U;
+    m_fieldCnt = 0U;
+    return false;
+}
+
+/* Gets the given field of the current line as a string. */
+
+std::string CSVReader::str(uint32_t n) const
+{
+    if (n >= m_fieldCnt)
+        return std::string();
+
+    return std::string(m_field[n], m_fieldLen[n]);
+}
+
+/* Gets the given field of the current line as an integer. */
+
+int32_t CSVReader::toInt(uint32_t n) const
+{
+    if (n >= m_fieldCnt)
+        return 0;
+
+    const char* p = m_field[n];
+    const char* end = p + m_fieldLen[n];
+
+    while (p < end && (*p == ' ' || *p == '\t'))
+        p++;
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    uint32_t value = 0U;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = (value * 10U) + (uint32_t)(*p - '0');
+        p++;
+    }
+
+    return negative ? -(int32_t)value : (int32_t)value;
+}
+
+/* Gets the given field of the current line as a floating point number. */
+
+float CSVReader::toFloat(uint32_t n) const
+{
+    if (n >= m_fieldCnt)
+        return 0.0F;
+
+    // fields are not null-terminated; copy the field to a terminated buffer for ::strtof()
+    char buffer[64U];
+    uint32_t length = m_fieldLen[n];
+    if (length >= sizeof(buffer))
+        length = sizeof(buffer) - 1U;
+
+    ::memcpy(buffer, m_field[n], length);
+    buffer[length] = '\0';
+
+    return ::strtof(buffer, nullptr);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to tokenize the current line into fields. */
+
+void CSVReader::tokenize()
+{
+    m_fieldCnt = 0U;
+
+    const char* p = m_line;
+    const char* end = m_line + m_lineLen;
+    while (p <= end && m_fieldCnt < CSV_MAX_FIELDS) {
+        const char* delim = (const char*)::memchr(p, m_delim, (size_t)(end - p));
+        if (delim == nullptr)
+            delim = end;
+
+        uint32_t length = (uint32_t)(delim - p);
+
+        // the trailing field is only counted if it is not empty (i.e. "a,b," is tokenized as 2 fields)
+        bool trailing = (delim == end);
+        if (length > 0U || (!m_skipEmpty && !trailing)) {
+            m_field[m_fieldCnt] = p;
+            m_fieldLen[m_fieldCnt] = length;
+            m_fieldCnt++;
+        }
+
+        if (trailing)
+            break;
+
+        p = delim + 1U;
+    }
+}
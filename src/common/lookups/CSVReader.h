@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file CSVReader.h
+ * @ingroup lookups
+ * @file CSVReader.cpp
+ * @ingroup lookups
+ */
+#if !defined(__CSV_READER_H__)
+#define __CSV_READER_H__
+
+#include "common/Defines.h"
+
+#include <string>
+#include <vector>
+
+namespace lookups
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t CSV_MAX_FIELDS = 16U;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a reader for comma-separated lookup table files.
+     * @note The entire file is read into memory once, lines and fields are then tokenized in place; no
+     *  allocations are made while tokenizing. Empty lines and lines starting with '#' are skipped, and a
+     *  line may contain at most CSV_MAX_FIELDS fields (any further fields are ignored).
+     * @ingroup lookups
+     */
+    class HOST_SW_API CSVReader {
+    public:
+        /**
+         * @brief Initializes a new instance of the CSVReader class.
+         * @param skipEmpty Flag indicating empty fields are skipped (i.e. "a,,b" is tokenized as 2 fields).
+         * @param delim Field delimiter.
+         */
+        CSVReader(bool skipEmpty = true, char delim = ',');
+
+        /**
+         * @brief Reads the given file into memory.
+         * @param filename Full-path to the file.
+         * @returns bool True, if the file was read, otherwise false.
+         */
+        bool open(const std::string& filename);
+        /**
+         * @brief Sets the data to tokenize.
+         * @param data Buffer containing the data.
+         * @param length Length of the data.
+         */
+        void open(const char* data, size_t length);
+
+        /**
+         * @brief Advances to and tokenizes the next line.
+         * @returns bool True, if there was a next line, otherwise false.
+         */
+        bool next();
+
+        /**
+         * @brief Gets the number of fields of the current line.
+         * @returns uint32_t Number of fields.
+         */
+        uint32_t fields() const { return m_fieldCnt; }
+        /**
+         * @brief Gets the given field of the current line as a string.
+         * @param n Field index.
+         * @returns std::string Field value (empty if the field does not exist).
+         */
+        std::string str(uint32_t n) const;
+        /**
+         * @brief Gets the given field of the current line as an integer.
+         * @note Parsing follows ::atoi(); leading whitespace is skipped and parsing stops at the first non-digit.
+         * @param n Field index.
+         * @returns int32_t Field value (0 if the field does not exist).
+         */
+        int32_t toInt(uint32_t n) const;
+        /**
+         * @brief Gets the given field of the current line as a floating point number.
+         * @param n Field index.
+         * @returns float Field value (0 if the field does not exist).
+         */
+        float toFloat(uint32_t n) const;
+
+        /**
+         * @brief Gets the current line as a string.
+         * @returns std::string Current line.
+         */
+        std::string line() const { return std::string(m_line, m_lineLen); }
+
+    private:
+        bool m_skipEmpty;
+        char m_delim;
+
+        std::vector<char> m_buffer;
+        const char* m_data;
+        size_t m_length;
+        size_t m_pos;
+
+        const char* m_line;
+        size_t m_lineLen;
+
+        const char* m_field[CSV_MAX_FIELDS];
+        uint32_t m_fieldLen[CSV_MAX_FIELDS];
+        uint32_t m_fieldCnt;
+
+        /**
+         * @brief Helper to tokenize the current line into fields.
+         */
+        void tokenize();
+    };
+} // namespace lookups
+
+#endif // __CSV_READER_H__
@@ -4,11 +4,12 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2018-2022,2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2018-2022,2024,2025 Bryan Biedenkapp, N2PLL
  *  Copyright (c) 2024 Patrick McDonnell, W3AXL
  *
  */
 #include "lookups/IdenTableLookup.h"
+#include "lookups/CSVReader.h"
 #include "Log.h"
 
 using namespace lookups;
@@ -16,13 +17,6 @@ using namespace lookups;
 #include <cstdlib>
 #include <string>
 #include <vector>
-#include <fstream>
-
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::mutex IdenTableLookup::m_mutex;
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -35,25 +29,16 @@ IdenTableLookup::IdenTableLookup(const std::string& filename, uint32_t reloadTim
     /* stub */
 }
 
-/* Clears all entries from the lookup table. */
-
-void IdenTableLookup::clear()
-{
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_table.clear();
-}
-
 /* Finds a table entry in this lookup table. */
 
 IdenTable IdenTableLookup::find(uint32_t id)
 {
     IdenTable entry;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    try {
-        entry = m_table.at(id);
-    } catch (...) {
-        /* stub */
+    std::shared_ptr<const std::unordered_map<uint32_t, IdenTable>> table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        entry = it->second;
     }
 
     float chBandwidthKhz = entry.chBandwidthKhz();
@@ -73,8 +58,10 @@ IdenTable IdenTableLookup::find(uint32_t id)
 std::vector<IdenTable> IdenTableLookup::list()
 {
     std::vector<IdenTable> list = std::vector<IdenTable>();
-    if (m_table.size() > 0) {
-        for (auto entry : m_table) {
+
+    std::shared_ptr<const std::unordered_map<uint32_t, IdenTable>> table = snapshot();
+    if (table->size() > 0) {
+        for (auto entry : *table) {
             list.push_back(entry.second);
         }
     }
@@ -94,74 +81,52 @@ bool IdenTableLookup::load()
         return false;
     }
 
-    std::ifstream file (m_filename, std::ifstream::in);
-    if (file.fail()) {
+    CSVReader reader;
+    if (!reader.open(m_filename)) {
         LogError(LOG_HOST, "Cannot open the identity table lookup file - %s", m_filename.c_str());
         return false;
     }
 
-    // clear table
-    clear();
-
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // build the new table off to the side, lookups continue against the current table until it is published
+    std::unordered_map<uint32_t, IdenTable> table;
 
     // read lines from file
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.length() > 0) {
-            if (line.at(0) == '#')
-                continue;
-
-            // tokenize line
-            std::string next;
-            std::vector<std::string> parsed;
-            char delim = ',';
-
-            for (auto it = line.begin(); it != line.end(); it++) {
-                if (*it == delim) {
-                    if (!next.empty()) {
-                        parsed.push_back(next);
-                        next.clear();
-                    }
-                }
-                else
-                    next += *it;
-            }
-            if (!next.empty())
-                parsed.push_back(next);
-
-            // ensure we have at least 5 fields
-            if (parsed.size() < 5) {
-                LogError(LOG_HOST, "Invalid entry in identity table lookup file - %s", line.c_str());
-                continue;
-            }
-
-            // parse tokenized line
-            uint8_t channelId = (uint8_t)::atoi(parsed[0].c_str());
-            uint32_t baseFrequency = (uint32_t)::atoi(parsed[1].c_str());
-            float chSpaceKhz = float(::atof(parsed[2].c_str()));
-            float txOffsetMhz = float(::atof(parsed[3].c_str()));
-            float chBandwidthKhz = float(::atof(parsed[4].c_str()));
-
-            if (chSpaceKhz == 0.0F)
-                chSpaceKhz = chBandwidthKhz / 2;
-            if (chSpaceKhz < 0.125F)    // clamp to 125 Hz
-                chSpaceKhz = 0.125F;
-            if (chSpaceKhz > 125000.0F)   // clamp to 125 kHz
-                chSpaceKhz = 125000.0F;
-
-            IdenTable entry = IdenTable(channelId, baseFrequency, chSpaceKhz, txOffsetMhz, chBandwidthKhz);
-
-            LogMessage(LOG_HOST, "Channel Id %u: BaseFrequency = %uHz, TXOffsetMhz = %fMHz, BandwidthKhz = %fKHz, SpaceKhz = %fKHz",
-                entry.channelId(), entry.baseFrequency(), entry.txOffsetMhz(), entry.chBandwidthKhz(), entry.chSpaceKhz());
-
-            m_table[channelId] = entry;
+    while (reader.next()) {
+        // ensure we have at least 5 fields
+        if (reader.fields() < 5U) {
+            LogError(LOG_HOST, "Invalid entry in identity table lookup file - %s", reader.line().c_str());
+            continue;
         }
+
+        // parse tokenized line
+        uint8_t channelId = (uint8_t)reader.toInt(0U);
+        uint32_t baseFrequency = (uint32_t)reader.toInt(1U);
+        float chSpaceKhz = reader.toFloat(2U);
+        float txOffsetMhz = reader.toFloat(3U);
+        float chBandwidthKhz = reader.toFloat(4U);
+
+        if (chSpaceKhz == 0.0F)
+            chSpaceKhz = chBandwidthKhz / 2;
+        if (chSpaceKhz < 0.125F)    // clamp to 125 Hz
+            chSpaceKhz = 0.125F;
+        if (chSpaceKhz > 125000.0F)   // clamp to 125 kHz
+            chSpaceKhz = 125000.0F;
+
+        IdenTable entry = IdenTable(channelId, baseFrequency, chSpaceKhz, txOffsetMhz, chBandwidthKhz);
+
+        LogMessage(LOG_HOST, "Channel Id %u: BaseFrequency = %uHz, TXOffsetMhz = %fMHz, BandwidthKhz = %fKHz, SpaceKhz = %fKHz",
+            entry.channelId(), entry.baseFrequency(), entry.txOffsetMhz(), entry.chBandwidthKhz(), entry.chSpaceKhz());
+
+        table[channelId] = entry;
     }
 
-    file.close();
+    size_t size = table.size();
+
+    {
+        std::lock_guard<std::mutex> lock(m_updateLock);
+        publish(std::move(table));
+    }
 
-    size_t size = m_table.size();
     if (size == 0U)
         return false;
 
@@ -128,11 +128,6 @@ namespace lookups
          */
         IdenTableLookup(const std::string& filename, uint32_t reloadTime);
 
-        /**
-         * @brief Clears all entries from the lookup table.
-         */
-        void clear() override;
-
         /**
          * @brief Finds a table entry in this lookup table.
          * @param id Unique identifier for table entry.
@@ -157,9 +152,6 @@ namespace lookups
          * @returns bool True, if lookup table was saved, otherwise false.
          */
         bool save() override;
-
-    private:
-        static std::mutex m_mutex;
     };
 } // namespace lookups
 
@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2018-2022,2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2018-2022,2024,2025 Bryan Biedenkapp, N2PLL
  *  Copyright (c) 2024 Patrick McDonnell, W3AXL
  *
  */
@@ -27,9 +27,19 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <unordered_map>
 
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // defined(__linux__)
+
 namespace lookups
 {
     // ---------------------------------------------------------------------------
@@ -39,6 +49,11 @@ namespace lookups
     /**
      * @brief Implements a abstract threading class that contains base logic for
      *  building tables of data.
+     * @note The table is immutable once published; lookups take a reference to the current table
+     *  and never block, while (re)loads and modifications build a new table and publish it with an
+     *  atomic pointer swap. When a reload time is set, the lookup table file is watched for changes
+     *  (using inotify, where available) and reloaded off-thread when it changes; otherwise the file
+     *  is reloaded every reload time interval. Changes made by save() are never reloaded.
      * @tparam T Atomic type this lookup table is for.
      * @ingroup lookups
      */
@@ -54,8 +69,15 @@ namespace lookups
             Thread(),
             m_filename(filename),
             m_reloadTime(reloadTime),
-            m_table(),
-            m_stop(false)
+            m_table(std::make_shared<const std::unordered_map<uint32_t, T>>()),
+            m_updateLock(),
+            m_fileLock(),
+            m_stop(false),
+            m_generation(0U)
+#if defined(__linux__)
+            , m_written(),
+            m_hasWritten(false)
+#endif // defined(__linux__)
         {
             /* stub */
         }
@@ -70,6 +92,13 @@ namespace lookups
                 return;
             }
 
+#if defined(__linux__)
+            // watch the lookup table file for changes, falling back to periodic reloads if it cannot be watched
+            if (watch()) {
+                return;
+            }
+#endif // defined(__linux__)
+
             Timer timer(1U, 60U * m_reloadTime);
             timer.start();
 
@@ -78,7 +107,7 @@ namespace lookups
 
                 timer.clock();
                 if (timer.hasExpired()) {
-                    load();
+                    reload();
                     timer.start();
                 }
             }
@@ -109,6 +138,7 @@ namespace lookups
         virtual bool read()
         {
             bool ret = load();
+            m_generation++;
 
             if (m_reloadTime > 0U)
                 run();
@@ -123,7 +153,9 @@ namespace lookups
          */
         virtual bool reload()
         {
-            return load();
+            bool ret = load();
+            m_generation++;
+            return ret;
         }
 
         /**
@@ -131,9 +163,8 @@ namespace lookups
          */
         virtual void clear()
         {
-            // bryanb: this is not thread-safe and thread saftey should be implemented
-            // on the derived class
-            m_table.clear();
+            std::lock_guard<std::mutex> lock(m_updateLock);
+            publish(std::unordered_map<uint32_t, T>());
         }
 
         /**
@@ -143,16 +174,8 @@ namespace lookups
          */
         virtual bool hasEntry(uint32_t id)
         {
-            try {
-                T entry = m_table.at(id); // this value will get discarded
-                (void)entry;              // but some variants of C++ mark the unordered_map<>::at as nodiscard
-                return true;
-            }
-            catch (...) {
-                return false;
-            }
-
-            return false;
+            std::shared_ptr<const std::unordered_map<uint32_t, T>> table = snapshot();
+            return table->find(id) != table->end();
         }
 
         /**
@@ -166,7 +189,7 @@ namespace lookups
          * @brief Helper to return the lookup table.
          * @returns std::unordered_map<uint32_t, T> Table.
          */
-        virtual std::unordered_map<uint32_t, T> table() { return m_table; }
+        virtual std::unordered_map<uint32_t, T> table() { return *snapshot(); }
 
         /**
          * @brief Returns the filename used to load this lookup table.
@@ -185,12 +208,55 @@ namespace lookups
          */
         void setReloadTime(uint32_t reloadTime) { m_reloadTime = reloadTime; }
 
+        /**
+         * @brief Gets the number of times the lookup table has been (re)loaded from the lookup table file.
+         * @returns uint32_t Number of times the lookup table has been loaded.
+         */
+        uint32_t generation() const { return m_generation.load(); }
+
     protected:
         std::string m_filename;
         uint32_t m_reloadTime;
-        std::unordered_map<uint32_t, T> m_table;
+        std::shared_ptr<const std::unordered_map<uint32_t, T>> m_table;   //! Current table (only access using snapshot() and publish()).
+        std::mutex m_updateLock;                                          //! Mutex used to serialize table modifications.
+        std::mutex m_fileLock;                                            //! Mutex held by save() while writing the lookup table file.
         bool m_stop;
 
+        std::atomic<uint32_t> m_generation;
+
+        /**
+         * @brief Gets the current table.
+         * @note The returned table is immutable and remains valid (even if a newer table is published)
+         *  for as long as the reference is held.
+         * @returns std::shared_ptr<const std::unordered_map<uint32_t, T>> Current table.
+         */
+        std::shared_ptr<const std::unordered_map<uint32_t, T>> snapshot() const { return std::atomic_load(&m_table); }
+        /**
+         * @brief Publishes a new table, replacing the current table.
+         * @param table Table to publish.
+         */
+        void publish(std::unordered_map<uint32_t, T>&& table)
+        {
+            std::shared_ptr<const std::unordered_map<uint32_t, T>> next = std::make_shared<const std::unordered_map<uint32_t, T>>(std::move(table));
+            std::atomic_store(&m_table, next);
+        }
+        /**
+         * @brief Modifies a copy of the current table and publishes it.
+         * @note Modifications are serialized against each other, but never block lookups. As each
+         *  modification copies the table, callers changing many entries should do so with a single call.
+         * @tparam F Function type.
+         * @param func Function modifying the table.
+         */
+        template <typename F>
+        void update(F func)
+        {
+            std::lock_guard<std::mutex> lock(m_updateLock);
+
+            std::unordered_map<uint32_t, T> table = *snapshot();
+            func(table);
+            publish(std::move(table));
+        }
+
         /**
          * @brief Loads the table from the passed lookup table file.
          * @returns bool True, if lookup table was loaded, otherwise false.
@@ -199,9 +265,116 @@ namespace lookups
 
         /**
          * @brief Saves the table from the lookup table in memory.
+         * @note Implementations hold m_fileLock while writing the file, and call written() once it is closed.
          * @returns bool True, if lookup table was saved, otherwise false.
          */
         virtual bool save() = 0;
+
+        /**
+         * @brief Helper to record the lookup table file as written by this lookup table, so the change
+         *  is not reloaded.
+         * @note m_fileLock must be held.
+         */
+        void written()
+        {
+#if defined(__linux__)
+            m_hasWritten = (::stat(m_filename.c_str(), &m_written) == 0);
+#endif // defined(__linux__)
+        }
+
+    private:
+#if defined(__linux__)
+        struct stat m_written;
+        bool m_hasWritten;
+
+        /**
+         * @brief Helper to determine whether the lookup table file is as it was last written by this lookup table.
+         * @returns bool True, if the file is unchanged since it was last written by save(), otherwise false.
+         */
+        bool isWritten()
+        {
+            std::lock_guard<std::mutex> lock(m_fileLock);
+            if (!m_hasWritten) {
+                return false;
+            }
+
+            struct stat st;
+            if (::stat(m_filename.c_str(), &st) != 0) {
+                return false;
+            }
+
+            return st.st_dev == m_written.st_dev && st.st_ino == m_written.st_ino && st.st_size == m_written.st_size &&
+                st.st_mtim.tv_sec == m_written.st_mtim.tv_sec && st.st_mtim.tv_nsec == m_written.st_mtim.tv_nsec;
+        }
+
+        /**
+         * @brief Helper to watch the lookup table file for changes, reloading the lookup table when it changes.
+         * @note This blocks until the lookup table is stopped.
+         * @returns bool True, if the lookup table file was watched, otherwise false.
+         */
+        bool watch()
+        {
+            if (m_filename.empty()) {
+                return false;
+            }
+
+            int fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (fd < 0) {
+                return false;
+            }
+
+            // watch the directory containing the file, as the file is commonly replaced (renamed over) rather
+            // than rewritten in place, which would silently end a watch on the file itself
+            std::string dir = ".";
+            std::string name = m_filename;
+            size_t pos = m_filename.find_last_of('/');
+            if (pos != std::string::npos) {
+                dir = (pos == 0U) ? "/" : m_filename.substr(0U, pos);
+                name = m_filename.substr(pos + 1U);
+            }
+
+            int wd = ::inotify_add_watch(fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (wd < 0) {
+                ::close(fd);
+                return false;
+            }
+
+            alignas(struct inotify_event) char buffer[4096U];
+            while (!m_stop) {
+                struct pollfd pfd;
+                pfd.fd = fd;
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+
+                if (::poll(&pfd, 1, 1000) <= 0) {
+                    continue;
+                }
+
+                // drain all pending events, multiple writes to the file result in a single reload
+                bool changed = false;
+                ssize_t len = 0;
+                while ((len = ::read(fd, buffer, sizeof(buffer))) > 0) {
+                    for (char* p = buffer; p < buffer + len; ) {
+                        const struct inotify_event* event = (const struct inotify_event*)p;
+                        if (event->len > 0U && name == event->name) {
+                            changed = true;
+                        }
+
+                        p += sizeof(struct inotify_event) + event->len;
+                    }
+                }
+
+                // ignore the change if it was made by save()
+                if (changed && !isWritten()) {
+                    reload();
+                }
+            }
+
+            ::inotify_rm_watch(fd, wd);
+            ::close(fd);
+            return true;
+        }
+#endif // defined(__linux__)
     };
 } // namespace lookups
 
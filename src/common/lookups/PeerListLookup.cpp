@@ -11,6 +11,7 @@
  *
  */
 #include "PeerListLookup.h"
+#include "lookups/CSVReader.h"
 #include "Log.h"
 
 using namespace lookups;
@@ -18,32 +19,6 @@ using namespace lookups;
 #include <fstream>
 #include <algorithm>
 
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::mutex PeerListLookup::m_mutex;
-bool PeerListLookup::m_locked = false;
-
-// ---------------------------------------------------------------------------
-//  Macros
-// ---------------------------------------------------------------------------
-
-// Lock the table.
-#define __LOCK_TABLE()                          \
-    std::lock_guard<std::mutex> lock(m_mutex);  \
-    m_locked = true;
-
-// Unlock the table.
-#define __UNLOCK_TABLE() m_locked = false;
-
-// Spinlock wait for table to be read unlocked.
-#define __SPINLOCK()                            \
-    if (m_locked) {                             \
-        while (m_locked)                        \
-            Thread::sleep(2U);                  \
-    }
-
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -56,71 +31,39 @@ PeerListLookup::PeerListLookup(const std::string& filename, uint32_t reloadTime,
     /* stub */
 }
 
-/* Clears all entries from the list. */
-
-void PeerListLookup::clear()
-{
-    __LOCK_TABLE();
-
-    m_table.clear();
-
-    __UNLOCK_TABLE();
-}
-
 /* Adds a new entry to the list. */
 
 void PeerListLookup::addEntry(uint32_t id, const std::string& alias, const std::string& password, bool peerLink, bool canRequestKeys)
 {
-    PeerId entry = PeerId(id, alias, password, peerLink, canRequestKeys, false);
-
-    __LOCK_TABLE();
-
-    try {
-        PeerId _entry = m_table.at(id);
-        // if either the alias or the enabled flag doesn't match, update the entry
-        if (_entry.peerId() == id) {
-            _entry = PeerId(id, alias, password, peerLink, canRequestKeys, false);
-            m_table[id] = _entry;
-        }
-    } catch (...) {
-        m_table[id] = entry;
-    }
-
-    __UNLOCK_TABLE();
+    update([&](std::unordered_map<uint32_t, PeerId>& table) {
+        table[id] = PeerId(id, alias, password, peerLink, canRequestKeys, false);
+    });
 }
 
 /* Removes an existing entry from the list. */
 
 void PeerListLookup::eraseEntry(uint32_t id)
 {
-    __LOCK_TABLE();
-
-    try {
-        PeerId entry = m_table.at(id);  // this value will get discarded
-        (void)entry;                    // but some variants of C++ mark the unordered_map<>::at as nodiscard
-        m_table.erase(id);
-    } catch (...) {
-        /* stub */
+    if (!isPeerInList(id)) {
+        return;
     }
 
-    __UNLOCK_TABLE();
+    update([&](std::unordered_map<uint32_t, PeerId>& table) {
+        table.erase(id);
+    });
 }
 
 /* Finds a table entry in this lookup table. */
 
 PeerId PeerListLookup::find(uint32_t id)
 {
-    PeerId entry;
-
-    __SPINLOCK();
-
-    try {
-        entry = m_table.at(id);
-    } catch (...) {
-        entry = PeerId(0U, "", "", false, false, true);
+    std::shared_ptr<const std::unordered_map<uint32_t, PeerId>> table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        return it->second;
     }
 
-    return entry;
+    return PeerId(0U, "", "", false, false, true);
 }
 
 /* Commit the table. */
@@ -141,9 +84,8 @@ bool PeerListLookup::getACL() const
 
 bool PeerListLookup::isPeerInList(uint32_t id) const
 {
-    __SPINLOCK();
-
-    if (m_table.find(id) != m_table.end()) {
+    std::shared_ptr<const std::unordered_map<uint32_t, PeerId>> table = snapshot();
+    if (table->find(id) != table->end()) {
         return true;
     }
 
@@ -167,13 +109,11 @@ std::vector<PeerId> PeerListLookup::tableAsList() const
 {
     std::vector<PeerId> ret = std::vector<PeerId>();
 
-    __LOCK_TABLE();
-
-    for (auto entry : m_table) {
+    std::shared_ptr<const std::unordered_map<uint32_t, PeerId>> table = snapshot();
+    for (auto entry : *table) {
         ret.push_back(entry.second);
     }
 
-    __UNLOCK_TABLE();
     return ret;
 }
 
@@ -189,81 +129,51 @@ bool PeerListLookup::load()
         return false;
     }
 
-    std::ifstream file(m_filename, std::ifstream::in);
-    if (file.fail()) {
+    // empty fields are significant in the peer list (i.e. an empty password field)
+    CSVReader reader(false);
+    if (!reader.open(m_filename)) {
         LogError(LOG_HOST, "Cannot open the peer ID lookup file - %s", m_filename.c_str());
         return false;
     }
 
-    clear();
-
-    __LOCK_TABLE();
+    // build the new table off to the side, lookups continue against the current table until it is published
+    std::unordered_map<uint32_t, PeerId> table;
 
     // read lines from file
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.length() > 0) {
-            // Skip comments with #
-            if (line.at(0) == '#')
-                continue;
-
-            // tokenize line
-            std::string next;
-            std::vector<std::string> parsed;
-            char delim = ',';
-
-            for (char c : line) {
-                if (c == delim) {
-                    //if (!next.empty()) {
-                        parsed.push_back(next);
-                        next.clear();
-                    //}
-                }
-                else
-                    next += c;
-            }
-            if (!next.empty())
-                parsed.push_back(next);
-
-            // parse tokenized line
-            uint32_t id = ::atoi(parsed[0].c_str());
-
-            // parse optional alias field (at end of line to avoid breaking change with existing lists)
-            std::string alias = "";
-            if (parsed.size() >= 4)
-                alias = parsed[3].c_str();
-
-            // parse peer link flag
-            bool peerLink = false;
-            if (parsed.size() >= 3)
-                peerLink = ::atoi(parsed[2].c_str()) == 1;
-
-            // parse can request keys flag
-            bool canRequestKeys = false;
-            if (parsed.size() >= 5)
-                canRequestKeys = ::atoi(parsed[4].c_str()) == 1;
-
-            // parse optional password
-            std::string password = "";
-            if (parsed.size() >= 2)
-                password = parsed[1].c_str();
-
-            // load into table
-            m_table[id] = PeerId(id, alias, password, peerLink, canRequestKeys, false);
-
-            // log depending on what was loaded
-            LogMessage(LOG_HOST, "Loaded peer ID %u%s into peer ID lookup table, %s%s%s", id,
-                (!alias.empty() ? (" (" + alias + ")").c_str() : ""),
-                (!password.empty() ? "using unique peer password" : "using master password"),
-                (peerLink) ? ", Peer-Link Enabled" : "",
-                (canRequestKeys) ? ", Can Request Keys" : "");
-        }
+    while (reader.next()) {
+        // parse tokenized line
+        uint32_t id = (uint32_t)reader.toInt(0U);
+
+        // parse optional alias field (at end of line to avoid breaking change with existing lists)
+        std::string alias = reader.str(3U);
+
+        // parse peer link flag
+        bool peerLink = reader.toInt(2U) == 1;
+
+        // parse can request keys flag
+        bool canRequestKeys = reader.toInt(4U) == 1;
+
+        // parse optional password
+        std::string password = reader.str(1U);
+
+        // load into table
+        table[id] = PeerId(id, alias, password, peerLink, canRequestKeys, false);
+
+        // log depending on what was loaded
+        LogMessage(LOG_HOST, "Loaded peer ID %u%s into peer ID lookup table, %s%s%s", id,
+            (!alias.empty() ? (" (" + alias + ")").c_str() : ""),
+            (!password.empty() ? "using unique peer password" : "using master password"),
+            (peerLink) ? ", Peer-Link Enabled" : "",
+            (canRequestKeys) ? ", Can Request Keys" : "");
     }
 
-    file.close();
-    __UNLOCK_TABLE();
+    size_t size = table.size();
+
+    {
+        std::lock_guard<std::mutex> lock(m_updateLock);
+        publish(std::move(table));
+    }
 
-    size_t size = m_table.size();
     if (size == 0U)
         return false;
 
@@ -279,6 +189,8 @@ bool PeerListLookup::save()
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(m_fileLock);
+
     std::ofstream file(m_filename, std::ofstream::out);
     if (file.fail()) {
         LogError(LOG_HOST, "Cannot open the peer ID lookup file - %s", m_filename.c_str());
@@ -290,12 +202,12 @@ bool PeerListLookup::save()
     // Counter for lines written
     unsigned int lines = 0;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<const std::unordered_map<uint32_t, PeerId>> table = snapshot();
 
     // String for writing
     std::string line;
     // iterate over each entry in the RID lookup and write it to the open file
-    for (auto& entry: m_table) {
+    for (auto& entry: *table) {
         // get the parameters
         uint32_t peerId = entry.first;
         std::string alias = entry.second.peerAlias();
@@ -340,8 +252,9 @@ bool PeerListLookup::save()
     }
 
     file.close();
+    written();
 
-    if (lines != m_table.size())
+    if (lines != table->size())
         return false;
 
     LogInfoEx(LOG_HOST, "Saved %u entries to lookup table file %s", lines, m_filename.c_str());
@@ -160,11 +160,6 @@ namespace lookups
          */
         PeerListLookup(const std::string& filename, uint32_t reloadTime, bool peerAcl);
 
-        /**
-         * @brief Clears all entries from the list.
-         */
-        void clear() override;
-
         /**
          * @brief Adds a new entry to the list.
          * @param peerId Unique peer ID to add.
@@ -213,13 +208,13 @@ namespace lookups
          * @brief Checks if the peer list is empty.
          * @returns bool True, if list is empty, otherwise false.
          */
-        bool isPeerListEmpty() const { return m_table.size() == 0U; }
+        bool isPeerListEmpty() const { return snapshot()->size() == 0U; }
 
         /**
          * @brief Gets the entire peer ID table.
          * @returns std::unordered_map<uint32_t, PeerId> 
          */
-        std::unordered_map<uint32_t, PeerId> table() const { return m_table; }
+        std::unordered_map<uint32_t, PeerId> table() const { return *snapshot(); }
         /**
          * @brief Gets the entire peer ID table.
          * @returns std::vector<PeerId> 
@@ -240,10 +235,6 @@ namespace lookups
          * @return True, if lookup table was saved, otherwise false.
          */
         bool save() override;
-
-    private:
-        static std::mutex m_mutex;  //! Mutex used for change locking.
-        static bool m_locked;       //! Flag used for read locking (prevents find lookups), should be used when atomic operations (add/erase/etc) are being used.
     };
 } // namespace lookups
 
@@ -10,6 +10,7 @@
  *
  */
 #include "lookups/RadioIdLookup.h"
+#include "lookups/CSVReader.h"
 #include "p25/P25Defines.h"
 #include "Log.h"
 
@@ -20,32 +21,6 @@ using namespace lookups;
 #include <vector>
 #include <fstream>
 
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::mutex RadioIdLookup::m_mutex;
-bool RadioIdLookup::m_locked = false;
-
-// ---------------------------------------------------------------------------
-//  Macros
-// ---------------------------------------------------------------------------
-
-// Lock the table.
-#define __LOCK_TABLE()                          \
-    std::lock_guard<std::mutex> lock(m_mutex);  \
-    m_locked = true;
-
-// Unlock the table.
-#define __UNLOCK_TABLE() m_locked = false;
-
-// Spinlock wait for table to be read unlocked.
-#define __SPINLOCK()                            \
-    if (m_locked) {                             \
-        while (m_locked)                        \
-            Thread::sleep(2U);                  \
-    }
-
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -58,17 +33,6 @@ RadioIdLookup::RadioIdLookup(const std::string& filename, uint32_t reloadTime, b
     /* stub */
 }
 
-/* Clears all entries from the lookup table. */
-
-void RadioIdLookup::clear()
-{
-    __LOCK_TABLE();
-
-    m_table.clear();
-
-    __UNLOCK_TABLE();
-}
-
 /* Toggles the specified radio ID enabled or disabled. */
 
 void RadioIdLookup::toggleEntry(uint32_t id, bool enabled)
@@ -77,6 +41,32 @@ void RadioIdLookup::toggleEntry(uint32_t id, bool enabled)
     addEntry(id, enabled, rid.radioAlias());
 }
 
+/* Toggles the specified radio IDs enabled or disabled. */
+
+void RadioIdLookup::toggleEntries(const std::vector<uint32_t>& ids, bool enabled)
+{
+    if (ids.empty()) {
+        return;
+    }
+
+    // all the radio IDs are toggled in a single modification of the table
+    update([&](std::unordered_map<uint32_t, RadioId>& table) {
+        for (uint32_t id : ids) {
+            if ((id == p25::defines::WUID_ALL) || (id == p25::defines::WUID_FNE)) {
+                continue;
+            }
+
+            auto it = table.find(id);
+            if (it != table.end()) {
+                it->second = RadioId(enabled, false, it->second.radioAlias(), it->second.radioIPAddress());
+            }
+            else {
+                table[id] = RadioId(enabled, false, "", "");
+            }
+        }
+    });
+}
+
 /* Adds a new entry to the lookup table by the specified unique ID. */
 
 void RadioIdLookup::addEntry(uint32_t id, bool enabled, const std::string& alias, const std::string& ipAddress)
@@ -85,65 +75,46 @@ void RadioIdLookup::addEntry(uint32_t id, bool enabled, const std::string& alias
         return;
     }
 
-    RadioId entry = RadioId(enabled, false, alias, ipAddress);
-
-    __LOCK_TABLE();
-
-    try {
-        RadioId _entry = m_table.at(id);
-        // if either the alias or the enabled flag doesn't match, update the entry
-        if (_entry.radioEnabled() != enabled || _entry.radioAlias() != alias) {
-            //LogDebug(LOG_HOST, "Updating existing RID %d (%s) in ACL", id, alias.c_str());
-            _entry = RadioId(enabled, false, alias, ipAddress);
-            m_table[id] = _entry;
-        } else {
-            //LogDebug(LOG_HOST, "No changes made to RID %d (%s) in ACL", id, alias.c_str());
-        }
-    } catch (...) {
-        //LogDebug(LOG_HOST, "Adding new RID %d (%s) to ACL", id, alias.c_str());
-        m_table[id] = entry;
+    // if neither the alias or the enabled flag differ, there is nothing to change
+    std::shared_ptr<const std::unordered_map<uint32_t, RadioId>> current = snapshot();
+    auto it = current->find(id);
+    if (it != current->end() && it->second.radioEnabled() == enabled && it->second.radioAlias() == alias) {
+        return;
     }
 
-    __UNLOCK_TABLE();
+    update([&](std::unordered_map<uint32_t, RadioId>& table) {
+        table[id] = RadioId(enabled, false, alias, ipAddress);
+    });
 }
 
 /* Erases an existing entry from the lookup table by the specified unique ID. */
 
 void RadioIdLookup::eraseEntry(uint32_t id)
 {
-    __LOCK_TABLE();
-
-    try {
-        RadioId entry = m_table.at(id); // this value will get discarded
-        (void)entry;                    // but some variants of C++ mark the unordered_map<>::at as nodiscard
-        m_table.erase(id);
-    }
-    catch (...) {
-        /* stub */
+    if (!hasEntry(id)) {
+        return;
     }
 
-    __UNLOCK_TABLE();
+    update([&](std::unordered_map<uint32_t, RadioId>& table) {
+        table.erase(id);
+    });
 }
 
 /* Finds a table entry in this lookup table. */
 
 RadioId RadioIdLookup::find(uint32_t id)
 {
-    RadioId entry;
-
     if ((id == p25::defines::WUID_ALL) || (id == p25::defines::WUID_FNE)) {
         return RadioId(true, false);
     }
 
-    __SPINLOCK();
-
-    try {
-        entry = m_table.at(id);
-    } catch (...) {
-        entry = RadioId(false, true);
+    std::shared_ptr<const std::unordered_map<uint32_t, RadioId>> table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        return it->second;
     }
 
-    return entry;
+    return RadioId(false, true);
 }
 
 /* Saves loaded talkgroup rules. */
@@ -172,73 +143,41 @@ bool RadioIdLookup::load()
         return false;
     }
 
-    std::ifstream file (m_filename, std::ifstream::in);
-    if (file.fail()) {
+    CSVReader reader;
+    if (!reader.open(m_filename)) {
         LogError(LOG_HOST, "Cannot open the radio ID lookup file - %s", m_filename.c_str());
         return false;
     }
 
-    // clear table
-    clear();
-
-    __LOCK_TABLE();
+    // build the new table off to the side, lookups continue against the current table until it is published
+    std::unordered_map<uint32_t, RadioId> table;
 
     // read lines from file
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.length() > 0) {
-            // Skip comments with #
-            if (line.at(0) == '#')
-                continue;
+    while (reader.next()) {
+        // ensure we have at least 2 fields
+        if (reader.fields() < 2U) {
+            LogError(LOG_HOST, "Invalid entry in radio ID lookup table - %s", reader.line().c_str());
+            continue;
+        }
 
-            // tokenize line
-            std::string next;
-            std::vector<std::string> parsed;
-            char delim = ',';
-
-            for (char c : line) {
-                if (c == delim) {
-                    if (!next.empty()) {
-                        parsed.push_back(next);
-                        next.clear();
-                    }
-                }
-                else
-                    next += c;
-            }
-            if (!next.empty())
-                parsed.push_back(next);
+        // parse tokenized line
+        uint32_t id = (uint32_t)reader.toInt(0U);
+        bool radioEnabled = reader.toInt(1U) == 1;
 
-            // ensure we have at least 2 fields
-            if (parsed.size() < 2) {
-                LogError(LOG_HOST, "Invalid entry in radio ID lookup table - %s", line.c_str());
-                continue;
-            }
-
-            // parse tokenized line
-            uint32_t id = ::atoi(parsed[0].c_str());
-            bool radioEnabled = ::atoi(parsed[1].c_str()) == 1;
-            std::string alias = "";
-            std::string ipAddress = "";
+        // parse the optional alias and IP address fields
+        std::string alias = reader.str(2U);
+        std::string ipAddress = reader.str(3U);
 
-            // check for an optional alias field
-            if (parsed.size() >= 3) {
-                alias = parsed[2];
-            }
+        table[id] = RadioId(radioEnabled, false, alias, ipAddress);
+    }
 
-            // check for an optional IP address field
-            if (parsed.size() >= 4) {
-                ipAddress = parsed[3];
-            }
+    size_t size = table.size();
 
-            m_table[id] = RadioId(radioEnabled, false, alias, ipAddress);
-        }
+    {
+        std::lock_guard<std::mutex> lock(m_updateLock);
+        publish(std::move(table));
     }
 
-    file.close();
-    __UNLOCK_TABLE();
-
-    size_t size = m_table.size();
     if (size == 0U)
         return false;
 
@@ -255,6 +194,8 @@ bool RadioIdLookup::save()
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(m_fileLock);
+
     std::ofstream file (m_filename, std::ofstream::out);
     if (file.fail()) {
         LogError(LOG_HOST, "Cannot open the radio ID lookup file - %s", m_filename.c_str());
@@ -266,13 +207,13 @@ bool RadioIdLookup::save()
     // Counter for lines written
     unsigned int lines = 0;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<const std::unordered_map<uint32_t, RadioId>> table = snapshot();
 
     // String for writing
     std::string line;
 
     // iterate over each entry in the RID lookup and write it to the open file
-    for (auto& entry: m_table) {
+    for (auto& entry: *table) {
         // get the parameters
         uint32_t rid = entry.first;
         bool enabled = entry.second.radioEnabled();
@@ -300,8 +241,9 @@ bool RadioIdLookup::save()
     }
 
     file.close();
+    written();
 
-    if (lines != m_table.size())
+    if (lines != table->size())
         return false;
 
     LogInfoEx(LOG_HOST, "Saved %u entries to lookup table file %s", lines, m_filename.c_str());
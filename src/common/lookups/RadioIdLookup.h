@@ -27,6 +27,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace lookups
 {
@@ -150,17 +151,18 @@ namespace lookups
          */
         RadioIdLookup(const std::string& filename, uint32_t reloadTime, bool ridAcl);
 
-        /**
-         * @brief Clears all entries from the lookup table.
-         */
-        void clear() override;
-
         /**
          * @brief Toggles the specified radio ID enabled or disabled.
          * @param id Unique ID to toggle.
          * @param enabled Flag indicating if radio ID is enabled or not.
          */
         void toggleEntry(uint32_t id, bool enabled);
+        /**
+         * @brief Toggles the specified radio IDs enabled or disabled.
+         * @param ids Unique IDs to toggle.
+         * @param enabled Flag indicating if radio IDs are enabled or not.
+         */
+        void toggleEntries(const std::vector<uint32_t>& ids, bool enabled);
 
         /**
          * @brief Adds a new entry to the lookup table by the specified unique ID, with an alias.
@@ -206,10 +208,6 @@ namespace lookups
          * @return True, if lookup table was saved, otherwise false.
          */
         bool save() override;
-
-    private:
-        static std::mutex m_mutex;  //! Mutex used for change locking.
-        static bool m_locked;       //! Flag used for read locking (prevents find lookups), should be used when atomic operations (add/erase/etc) are being used.
     };
 } // namespace lookups
 
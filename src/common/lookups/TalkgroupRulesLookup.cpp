@@ -15,6 +15,7 @@
 
 using namespace lookups;
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -37,13 +38,131 @@ bool TalkgroupRulesLookup::m_locked = false;
 // Unlock the table.
 #define __UNLOCK_TABLE() m_locked = false;
 
-// Spinlock wait for table to be read unlocked.
-#define __SPINLOCK()                            \
-    if (m_locked) {                             \
-        while (m_locked)                        \
-            Thread::sleep(2U);                  \
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to create a sorted copy of a peer list. */
+
+static std::vector<uint32_t> sortedPeers(const std::vector<uint32_t>& peers)
+{
+    std::vector<uint32_t> sorted = peers;
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return sorted;
+}
+
+// ---------------------------------------------------------------------------
+//  TalkgroupRuleIndexEntry Structure Members
+// ---------------------------------------------------------------------------
+
+/* Helper to check if the given peer is in the inclusion list for this rule. */
+
+bool TalkgroupRuleIndexEntry::isIncluded(uint32_t peerId) const
+{
+    return std::binary_search(inclusion.begin(), inclusion.end(), peerId);
+}
+
+/* Helper to check if the given peer is in the exclusion list for this rule. */
+
+bool TalkgroupRuleIndexEntry::isExcluded(uint32_t peerId) const
+{
+    return std::binary_search(exclusion.begin(), exclusion.end(), peerId);
+}
+
+/* Helper to check if the given peer is in the always send list for this rule. */
+
+bool TalkgroupRuleIndexEntry::isAlwaysSend(uint32_t peerId) const
+{
+    return std::binary_search(alwaysSend.begin(), alwaysSend.end(), peerId);
+}
+
+/* Helper to check if the given peer is in the preferred list for this rule. */
+
+bool TalkgroupRuleIndexEntry::isPreferred(uint32_t peerId) const
+{
+    return std::binary_search(preferred.begin(), preferred.end(), peerId);
+}
+
+// ---------------------------------------------------------------------------
+//  TalkgroupRulesIndex Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the TalkgroupRulesIndex class. */
+
+TalkgroupRulesIndex::TalkgroupRulesIndex(const std::vector<TalkgroupRuleGroupVoice>& groupVoice) :
+    m_rules(),
+    m_byTgId(),
+    m_bySource(),
+    m_byRewrite()
+{
+    m_rules.reserve(groupVoice.size());
+    for (const TalkgroupRuleGroupVoice& gv : groupVoice) {
+        TalkgroupRuleIndexEntry entry;
+        entry.groupVoice = gv;
+
+        TalkgroupRuleConfig config = gv.config();
+        entry.tgId = gv.source().tgId();
+        entry.tgSlot = gv.source().tgSlot();
+        entry.active = config.active();
+        entry.affiliated = config.affiliated();
+        entry.parrot = config.parrot();
+
+        entry.rewrite = config.rewrite();
+        entry.inclusion = sortedPeers(config.inclusion());
+        entry.exclusion = sortedPeers(config.exclusion());
+        entry.alwaysSend = sortedPeers(config.alwaysSend());
+        entry.preferred = sortedPeers(config.preferred());
+
+        uint32_t idx = (uint32_t)m_rules.size();
+        m_rules.push_back(entry);
+
+        // the first rule defined for a talkgroup (or talkgroup and slot) wins, this matches the order
+        // rules were searched in before being indexed
+        m_byTgId.emplace(entry.tgId, idx);
+        m_bySource.emplace(((uint64_t)entry.tgId << 8) | entry.tgSlot, idx);
+
+        for (const TalkgroupRuleRewrite& rewrite : entry.rewrite) {
+            uint64_t key = ((uint64_t)rewrite.peerId() << 32) | rewrite.tgId();
+            m_byRewrite[key].push_back(std::make_pair(rewrite.tgSlot(), idx));
+        }
+    }
+}
+
+/* Finds a rule in this index. */
+
+const TalkgroupRuleIndexEntry* TalkgroupRulesIndex::find(uint32_t id, uint8_t slot) const
+{
+    if (slot != 0U) {
+        auto it = m_bySource.find(((uint64_t)id << 8) | slot);
+        if (it != m_bySource.end())
+            return &m_rules[it->second];
+        return nullptr;
     }
 
+    auto it = m_byTgId.find(id);
+    if (it != m_byTgId.end())
+        return &m_rules[it->second];
+    return nullptr;
+}
+
+/* Finds a rule in this index by rewrite. */
+
+const TalkgroupRuleIndexEntry* TalkgroupRulesIndex::findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot) const
+{
+    auto it = m_byRewrite.find(((uint64_t)peerId << 32) | id);
+    if (it == m_byRewrite.end())
+        return nullptr;
+
+    // rewrites are kept in rule order, so the first match is the first rule defining the rewrite
+    for (const std::pair<uint8_t, uint32_t>& rewrite : it->second) {
+        if (slot == 0U || rewrite.first == slot)
+            return &m_rules[rewrite.second];
+    }
+
+    return nullptr;
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -56,6 +175,11 @@ TalkgroupRulesLookup::TalkgroupRulesLookup(const std::string& filename, uint32_t
     m_rules(),
     m_acl(acl),
     m_stop(false),
+    m_generation(0U),
+    m_index(std::make_shared<const TalkgroupRulesIndex>(std::vector<TalkgroupRuleGroupVoice>())),
+    m_indexVersion(0U),
+    m_updateDepth(0U),
+    m_indexDirty(false),
     m_groupHangTime(5U),
     m_sendTalkgroups(false),
     m_groupVoice()
@@ -124,6 +248,7 @@ void TalkgroupRulesLookup::clear()
     __LOCK_TABLE();
 
     m_groupVoice.clear();
+    buildIndex();
 
     __UNLOCK_TABLE();
 }
@@ -175,6 +300,8 @@ void TalkgroupRulesLookup::addEntry(uint32_t id, uint8_t slot, bool enabled, boo
         m_groupVoice.push_back(entry);
     }
 
+    buildIndex();
+
     __UNLOCK_TABLE();
 }
 
@@ -207,6 +334,8 @@ void TalkgroupRulesLookup::addEntry(TalkgroupRuleGroupVoice groupVoice)
         m_groupVoice.push_back(entry);
     }
 
+    buildIndex();
+
     __UNLOCK_TABLE();
 }
 
@@ -221,73 +350,62 @@ void TalkgroupRulesLookup::eraseEntry(uint32_t id, uint8_t slot)
         m_groupVoice.erase(it);
     }
 
+    buildIndex();
+
     __UNLOCK_TABLE();
 }
 
-/* Finds a table entry in this lookup table. */
+/* Begins a batch of changes to the lookup table. */
 
-TalkgroupRuleGroupVoice TalkgroupRulesLookup::find(uint32_t id, uint8_t slot)
+void TalkgroupRulesLookup::beginUpdate()
 {
-    TalkgroupRuleGroupVoice entry;
+    __LOCK_TABLE();
 
-    __SPINLOCK();
+    m_updateDepth++;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(),
-        [&](TalkgroupRuleGroupVoice x)
-        {
-            if (slot != 0U) {
-                return x.source().tgId() == id && x.source().tgSlot() == slot;
-            }
+    __UNLOCK_TABLE();
+}
 
-            return x.source().tgId() == id;
-        });
-    if (it != m_groupVoice.end()) {
-        entry = *it;
-    } else {
-        entry = TalkgroupRuleGroupVoice();
+/* Ends a batch of changes to the lookup table, and publishes the index of the changed rules. */
+
+void TalkgroupRulesLookup::endUpdate()
+{
+    __LOCK_TABLE();
+
+    if (m_updateDepth > 0U) {
+        m_updateDepth--;
+        if (m_updateDepth == 0U && m_indexDirty) {
+            buildIndex();
+        }
     }
 
-    return entry;
+    __UNLOCK_TABLE();
 }
 
 /* Finds a table entry in this lookup table. */
 
-TalkgroupRuleGroupVoice TalkgroupRulesLookup::findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot)
+TalkgroupRuleGroupVoice TalkgroupRulesLookup::find(uint32_t id, uint8_t slot)
 {
-    TalkgroupRuleGroupVoice entry;
+    std::shared_ptr<const TalkgroupRulesIndex> idx = index();
+    const TalkgroupRuleIndexEntry* entry = idx->find(id, slot);
+    if (entry != nullptr) {
+        return entry->groupVoice;
+    }
 
-    __SPINLOCK();
+    return TalkgroupRuleGroupVoice();
+}
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(),
-        [&](TalkgroupRuleGroupVoice x)
-        {
-            if (x.config().rewrite().size() == 0)
-                return false;
-
-            std::vector<TalkgroupRuleRewrite> rewrite = x.config().rewrite();
-            auto innerIt = std::find_if(rewrite.begin(), rewrite.end(),
-                [&](TalkgroupRuleRewrite y)
-                {
-                    if (slot != 0U) {
-                        return y.peerId() == peerId && y.tgId() == id && y.tgSlot() == slot;
-                    }
-
-                    return y.peerId() == peerId && y.tgId() == id;
-                });
-
-            if (innerIt != rewrite.end())
-                return true;
-            return false;
-        });
-    if (it != m_groupVoice.end()) {
-        entry = *it;
-    } else {
-        entry = TalkgroupRuleGroupVoice();
+/* Finds a table entry in this lookup table. */
+
+TalkgroupRuleGroupVoice TalkgroupRulesLookup::findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot)
+{
+    std::shared_ptr<const TalkgroupRulesIndex> idx = index();
+    const TalkgroupRuleIndexEntry* entry = idx->findByRewrite(peerId, id, slot);
+    if (entry != nullptr) {
+        return entry->groupVoice;
     }
 
-    return entry;
+    return TalkgroupRuleGroupVoice();
 }
 
 /* Saves loaded talkgroup rules. */
@@ -328,22 +446,22 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
-    // clear table
-    clear();
-
-    __LOCK_TABLE();
-
     yaml::Node& groupVoiceList = m_rules["groupVoice"];
 
     if (groupVoiceList.size() == 0U) {
         ::LogError(LOG_HOST, "No group voice rules list defined!");
-        m_locked = false;
+
+        // clear table
+        clear();
+        m_generation++;
         return false;
     }
 
+    // the new rules are built aside and swapped in as a whole, lookups never see a partially loaded table
+    std::vector<TalkgroupRuleGroupVoice> groupVoiceRules;
     for (size_t i = 0; i < groupVoiceList.size(); i++) {
         TalkgroupRuleGroupVoice groupVoice = TalkgroupRuleGroupVoice(groupVoiceList[i]);
-        m_groupVoice.push_back(groupVoice);
+        groupVoiceRules.push_back(groupVoice);
 
         std::string groupName = groupVoice.name();
         uint32_t tgId = groupVoice.source().tgId();
@@ -370,9 +488,18 @@ bool TalkgroupRulesLookup::load()
         ::LogInfoEx(LOG_HOST, "Talkgroup NAME: %s SRC_TGID: %u SRC_TS: %u ACTIVE: %u PARROT: %u AFFILIATED: %u INCLUSIONS: %u EXCLUSIONS: %u REWRITES: %u ALWAYS: %u PREFERRED: %u PERMITTED RIDS: %u", groupName.c_str(), tgId, tgSlot, active, parrot, affil, incCount, excCount, rewrCount, alwyCount, prefCount, permRIDCount);
     }
 
-    __UNLOCK_TABLE();
+    size_t size = 0U;
+    {
+        __LOCK_TABLE();
+
+        m_groupVoice = groupVoiceRules;
+        buildIndex();
+        size = m_groupVoice.size();
+        m_generation++;
+
+        __UNLOCK_TABLE();
+    }
 
-    size_t size = m_groupVoice.size();
     if (size == 0U) {
         return false;
     }
@@ -382,6 +509,21 @@ bool TalkgroupRulesLookup::load()
     return true;
 }
 
+/* Compiles and publishes a new index of the talkgroup rules. */
+
+void TalkgroupRulesLookup::buildIndex()
+{
+    // defer compiling the index until the batch of changes is complete
+    if (m_updateDepth > 0U) {
+        m_indexDirty = true;
+        return;
+    }
+
+    m_indexDirty = false;
+    std::atomic_store(&m_index, std::shared_ptr<const TalkgroupRulesIndex>(std::make_shared<const TalkgroupRulesIndex>(m_groupVoice)));
+    m_indexVersion++;
+}
+
 /* Saves the table to the passed lookup table file. */
 
 bool TalkgroupRulesLookup::save()
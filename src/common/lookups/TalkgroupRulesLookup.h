@@ -26,7 +26,9 @@
 #include "common/yaml/Yaml.h"
 #include "common/Utils.h"
 
+#include <atomic>
 #include <string>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -521,6 +523,103 @@ namespace lookups
         DECLARE_PROPERTY_PLAIN(TalkgroupRuleGroupVoiceSource, source);
     };
 
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a talkgroup rule compiled into a talkgroup rules index.
+     * @ingroup lookups_tgid
+     */
+    struct HOST_SW_API TalkgroupRuleIndexEntry {
+        TalkgroupRuleGroupVoice groupVoice; //! Group voice rule.
+
+        uint32_t tgId;                      //! Source talkgroup ID.
+        uint8_t tgSlot;                     //! Source talkgroup DMR slot.
+        bool active;                        //! Flag indicating whether the rule is active.
+        bool affiliated;                    //! Flag indicating whether the rule requires affiliations to repeat traffic.
+        bool parrot;                        //! Flag indicating whether the rule is a parrot talkgroup.
+
+        std::vector<TalkgroupRuleRewrite> rewrite; //! List of rewrites.
+        std::vector<uint32_t> inclusion;    //! Sorted list of peer inclusions.
+        std::vector<uint32_t> exclusion;    //! Sorted list of peer exclusions.
+        std::vector<uint32_t> alwaysSend;   //! Sorted list of always send peers.
+        std::vector<uint32_t> preferred;    //! Sorted list of preferred peers.
+
+        /**
+         * @brief Helper to check if the given peer is in the inclusion list for this rule.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer is included, otherwise false.
+         */
+        bool isIncluded(uint32_t peerId) const;
+        /**
+         * @brief Helper to check if the given peer is in the exclusion list for this rule.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer is excluded, otherwise false.
+         */
+        bool isExcluded(uint32_t peerId) const;
+        /**
+         * @brief Helper to check if the given peer is in the always send list for this rule.
+         * @param peerId Peer ID.
+         * @returns bool True, if traffic is always sent to the peer, otherwise false.
+         */
+        bool isAlwaysSend(uint32_t peerId) const;
+        /**
+         * @brief Helper to check if the given peer is in the preferred list for this rule.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer is preferred, otherwise false.
+         */
+        bool isPreferred(uint32_t peerId) const;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements an immutable index of talkgroup rules.
+     * @note An index is compiled from the group voice rules every time the rules change, and is never
+     *  modified afterwards; lookups against an index do not lock and do not copy rules.
+     * @ingroup lookups_tgid
+     */
+    class HOST_SW_API TalkgroupRulesIndex {
+    public:
+        /**
+         * @brief Initializes a new instance of the TalkgroupRulesIndex class.
+         * @param groupVoice List of group voice rules to index.
+         */
+        TalkgroupRulesIndex(const std::vector<TalkgroupRuleGroupVoice>& groupVoice);
+
+        /**
+         * @brief Finds a rule in this index.
+         * @param id Unique identifier for table entry.
+         * @param slot DMR slot this talkgroup is valid on (0 matches any slot).
+         * @returns const TalkgroupRuleIndexEntry* Rule, or nullptr if no rule was found.
+         */
+        const TalkgroupRuleIndexEntry* find(uint32_t id, uint8_t slot = 0U) const;
+        /**
+         * @brief Finds a rule in this index by rewrite.
+         * @param peerId Peer ID of the rewrite.
+         * @param id Rewritten talkgroup ID.
+         * @param slot DMR slot of the rewritten talkgroup (0 matches any slot).
+         * @returns const TalkgroupRuleIndexEntry* Rule, or nullptr if no rule was found.
+         */
+        const TalkgroupRuleIndexEntry* findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot = 0U) const;
+
+        /**
+         * @brief Gets the number of rules in this index.
+         * @returns size_t Number of rules in this index.
+         */
+        size_t size() const { return m_rules.size(); }
+
+    private:
+        std::vector<TalkgroupRuleIndexEntry> m_rules;
+
+        std::unordered_map<uint32_t, uint32_t> m_byTgId;
+        std::unordered_map<uint64_t, uint32_t> m_bySource;
+        std::unordered_map<uint64_t, std::vector<std::pair<uint8_t, uint32_t>>> m_byRewrite;
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
@@ -591,6 +690,19 @@ namespace lookups
          * @param slot DMR slot this talkgroup is valid on.
          */
         void eraseEntry(uint32_t id, uint8_t slot);
+
+        /**
+         * @brief Begins a batch of changes to the lookup table.
+         * @note While a batch is open, changes made by addEntry(), eraseEntry() and clear() are not indexed; the
+         *  index is compiled once, when the outermost batch ends. Lookups made while a batch is open see the rules
+         *  as they were before the batch.
+         */
+        void beginUpdate();
+        /**
+         * @brief Ends a batch of changes to the lookup table, and publishes the index of the changed rules.
+         */
+        void endUpdate();
+
         /**
          * @brief Finds a table entry in this lookup table.
          * @param id Unique identifier for table entry.
@@ -607,6 +719,14 @@ namespace lookups
          */
         virtual TalkgroupRuleGroupVoice findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot = 0U);
 
+        /**
+         * @brief Gets the current compiled index of the talkgroup rules.
+         * @note The returned index is immutable, and remains valid for as long as the caller holds it even if
+         *  the rules are changed or reloaded.
+         * @returns std::shared_ptr<const TalkgroupRulesIndex> Talkgroup rules index.
+         */
+        std::shared_ptr<const TalkgroupRulesIndex> index() const { return std::atomic_load(&m_index); }
+
         /**
          * @brief Saves loaded talkgroup rules.
          */
@@ -635,6 +755,18 @@ namespace lookups
          */
         void setReloadTime(uint32_t reloadTime) { m_reloadTime = reloadTime; }
 
+        /**
+         * @brief Gets the number of times the lookup table has been (re)loaded from the routing rules file.
+         * @returns uint32_t Number of times the lookup table has been loaded.
+         */
+        uint32_t generation() const { return m_generation.load(); }
+        /**
+         * @brief Gets the number of times the index of the talkgroup rules has been published.
+         * @note This changes whenever the rules change for any reason (a reload, or an entry being added or erased).
+         * @returns uint32_t Number of times the index has been published.
+         */
+        uint32_t indexVersion() const { return m_indexVersion.load(); }
+
     private:
         std::string m_rulesFile;
         uint32_t m_reloadTime;
@@ -643,9 +775,23 @@ namespace lookups
         bool m_acl;
         bool m_stop;
 
+        std::atomic<uint32_t> m_generation;
+
         static std::mutex m_mutex;  //! Mutex used for change locking.
         static bool m_locked;       //! Flag used for read locking (prevents find lookups), should be used when atomic operations (add/erase/etc) are being used.
 
+        std::shared_ptr<const TalkgroupRulesIndex> m_index;
+        std::atomic<uint32_t> m_indexVersion;
+        uint32_t m_updateDepth;
+        bool m_indexDirty;
+
+        /**
+         * @brief Compiles and publishes a new index of the talkgroup rules, or marks the index dirty if a batch
+         *  of changes is open.
+         *  (NOTE: This must be called with the table locked.)
+         */
+        void buildIndex();
+
         /**
          * @brief Loads the table from the passed lookup table file.
          * @return True, if lookup table was loaded, otherwise false.
@@ -32,6 +32,7 @@ using namespace network::frame;
 
 FrameQueue::FrameQueue(udp::Socket* socket, uint32_t peerId, bool debug) : RawFrameQueue(socket, debug),
     m_peerId(peerId),
+    m_rxReady(),
 #if defined(_WIN32)
     m_streamTSMtx(),
 #endif // defined(_WIN32)
@@ -71,28 +72,8 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
 
         m_failedReadCnt = 0U;
 
-        if (length < RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES) {
-            LogError(LOG_NET, "FrameQueue::read(), message received from network is malformed! %u bytes != %u bytes", 
-                RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES, length);
-            return nullptr;
-        }
-
-        // decode RTP header
-        if (!_rtpHeader.decode(buffer)) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
-            return nullptr;
-        }
-
-        // ensure the RTP header has extension header (otherwise abort)
-        if (!_rtpHeader.getExtension()) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP header received from network");
-            return nullptr;
-        }
-
-        // ensure payload type is correct
-        if ((_rtpHeader.getPayloadType() != DVM_RTP_PAYLOAD_TYPE) &&
-            (_rtpHeader.getPayloadType() != (DVM_RTP_PAYLOAD_TYPE + 1U))) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP payload type received from network");
+        uint8_t* data = decodeMessage("FrameQueue::read()", buffer, length, _rtpHeader, _fneHeader);
+        if (data == nullptr) {
             return nullptr;
         }
 
@@ -100,17 +81,6 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
             *rtpHeader = _rtpHeader;
         }
 
-        // decode FNE RTP header
-        if (!_fneHeader.decode(buffer + RTP_HEADER_LENGTH_BYTES)) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
-            return nullptr;
-        }
-
-        if (_fneHeader.getMessageLength() == 0U) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid FNE packet length received from network");
-            return nullptr;
-        }
-
         if (fneHeader != nullptr) {
             *fneHeader = _fneHeader;
         }
@@ -118,14 +88,7 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
         // copy message
         messageLength = _fneHeader.getMessageLength();
         UInt8Array message = std::unique_ptr<uint8_t[]>(new uint8_t[messageLength]);
-        ::memcpy(message.get(), buffer + (RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES), messageLength);
-
-        uint16_t calc = edac::CRC::createCRC16(message.get(), messageLength * 8U);
-        if (calc != _fneHeader.getCRC()) {
-            LogError(LOG_NET, "FrameQueue::read(), failed CRC CCITT-162 check");
-            messageLength = -1;
-            return nullptr;
-        }
+        ::memcpy(message.get(), data, messageLength);
 
         // LogDebug(LOG_NET, "message buffer, addr %p len %u", message.get(), messageLength);
         return message;
@@ -134,6 +97,34 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
     return nullptr;
 }
 
+/* Read a batch of messages from the received UDP packets. */
+
+int FrameQueue::readBatch(std::vector<RxFrame>& frames)
+{
+    frames.clear();
+
+    int count = RawFrameQueue::readBatch(m_rxReady);
+    if (count <= 0) {
+        return count;
+    }
+
+    for (udp::UDPDatagram* datagram : m_rxReady) {
+        RxFrame frame;
+        frame.message = decodeMessage("FrameQueue::readBatch()", datagram->buffer, (int)datagram->length, frame.rtpHeader, frame.fneHeader);
+        if (frame.message == nullptr) {
+            continue;
+        }
+
+        frame.messageLength = frame.fneHeader.getMessageLength();
+        frame.address = datagram->address;
+        frame.addrLen = datagram->addrLen;
+
+        frames.push_back(frame);
+    }
+
+    return (int)frames.size();
+}
+
 /* Write message to the UDP socket. */
 
 bool FrameQueue::write(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
@@ -148,8 +139,7 @@ bool FrameQueue::write(const uint8_t* message, uint32_t length, uint32_t streamI
         return false;
     }
 
-    uint32_t bufferLen = 0U;
-    uint8_t* buffer = generateMessage(message, length, streamId, peerId, ssrc, opcode, rtpSeq, &bufferLen);
+    uint32_t bufferLen = DVM_FRAME_HEADER_LENGTH_BYTES + length;
 
     // bryanb: this is really a developer warning not a end-user warning, there's nothing the end-users can do about
     //  this message
@@ -157,13 +147,21 @@ bool FrameQueue::write(const uint8_t* message, uint32_t length, uint32_t streamI
         LogDebug(LOG_NET, "FrameQueue::write(), WARN: packet length is possibly oversized, possible data truncation - BUGBUG");
     }
 
+    // the headers are generated on the stack and written along with the message straight from the callers buffer
+    uint8_t header[DVM_FRAME_HEADER_LENGTH_BYTES];
+    generateHeader(header, message, length, streamId, peerId, ssrc, opcode, rtpSeq);
+
+    if (m_debug) {
+        Utils::dump(1U, "FrameQueue::write() Message Header", header, DVM_FRAME_HEADER_LENGTH_BYTES);
+        Utils::dump(1U, "FrameQueue::write() Message", message, length);
+    }
+
     bool ret = true;
-    if (!m_socket->write(buffer, bufferLen, addr, addrLen)) {
+    if (!m_socket->write(header, DVM_FRAME_HEADER_LENGTH_BYTES, message, length, addr, addrLen)) {
         // LogError(LOG_NET, "Failed writing data to the network");
         ret = false;
     }
 
-    delete[] buffer;
     return ret;
 }
 
@@ -189,8 +187,7 @@ void FrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, uint32_
         return;
     }
 
-    uint32_t bufferLen = 0U;
-    uint8_t* buffer = generateMessage(message, length, streamId, peerId, ssrc, opcode, rtpSeq, &bufferLen);
+    uint32_t bufferLen = DVM_FRAME_HEADER_LENGTH_BYTES + length;
 
     // bryanb: this is really a developer warning not a end-user warning, there's nothing the end-users can do about
     //  this message
@@ -198,13 +195,86 @@ void FrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, uint32_
         LogDebug(LOG_NET, "FrameQueue::enqueueMessage(), WARN: packet length is possibly oversized, possible data truncation - BUGBUG");
     }
 
-    udp::UDPDatagram *dgram = new udp::UDPDatagram;
-    dgram->buffer = buffer;
-    dgram->length = bufferLen;
+    // the headers are generated and the message copied straight into a pooled datagram
+    udp::UDPDatagram* dgram = m_pool.acquire(bufferLen);
+    generateHeader(dgram->buffer, message, length, streamId, peerId, ssrc, opcode, rtpSeq);
+    ::memcpy(dgram->buffer + DVM_FRAME_HEADER_LENGTH_BYTES, message, length);
+    dgram->address = addr;
+    dgram->addrLen = addrLen;
+
+    if (m_debug)
+        Utils::dump(1U, "FrameQueue::enqueueMessage() Buffered Message", dgram->buffer, bufferLen);
+
+    enqueueDatagram(dgram);
+}
+
+/* Prepares a message to be queued to many peers. */
+
+bool FrameQueue::prepareMessage(PreparedFrame& frame, const uint8_t* message, uint32_t length, uint32_t streamId,
+    uint32_t ssrc, OpcodePair opcode)
+{
+    frame.message = nullptr;
+    frame.length = 0U;
+
+    if (message == nullptr) {
+        LogError(LOG_NET, "FrameQueue::prepareMessage(), message is null");
+        return false;
+    }
+    if (length == 0U) {
+        LogError(LOG_NET, "FrameQueue::prepareMessage(), message length is zero");
+        return false;
+    }
+
+    // bryanb: this is really a developer warning not a end-user warning, there's nothing the end-users can do about
+    //  this message
+    if (DVM_FRAME_HEADER_LENGTH_BYTES + length > (DATA_PACKET_LENGTH - OVERSIZED_PACKET_WARN)) {
+        LogDebug(LOG_NET, "FrameQueue::prepareMessage(), WARN: packet length is possibly oversized, possible data truncation - BUGBUG");
+    }
+
+    frame.message = message;
+    frame.length = length;
+    frame.streamId = streamId;
+    frame.ssrc = ssrc;
+
+    RTPFNEHeader fneHeader = RTPFNEHeader();
+    fneHeader.setCRC(edac::CRC::createCRC16(message, length * 8U));
+    fneHeader.setStreamId(streamId);
+    fneHeader.setPeerId(0U);
+    fneHeader.setMessageLength(length);
+
+    fneHeader.setFunction(opcode.first);
+    fneHeader.setSubFunction(opcode.second);
+
+    ::memset(frame.fneHeader, 0x00U, RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES);
+    fneHeader.encode(frame.fneHeader);
+    return true;
+}
+
+/* Cache a prepared message to frame queue. */
+
+void FrameQueue::enqueueMessage(const PreparedFrame& frame, uint32_t peerId, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen)
+{
+    if (frame.message == nullptr || frame.length == 0U) {
+        LogError(LOG_NET, "FrameQueue::enqueueMessage(), prepared message is empty");
+        return;
+    }
+
+    uint32_t bufferLen = DVM_FRAME_HEADER_LENGTH_BYTES + frame.length;
+
+    // only the RTP header and the peer ID differ between peers, the FNE header is copied from the prepared
+    // template and the message copied straight into a pooled datagram
+    udp::UDPDatagram* dgram = m_pool.acquire(bufferLen);
+    generateRTPHeader(dgram->buffer, frame.streamId, frame.ssrc, rtpSeq);
+    ::memcpy(dgram->buffer + RTP_HEADER_LENGTH_BYTES, frame.fneHeader, RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES);
+    SET_UINT32(peerId, dgram->buffer, RTP_HEADER_LENGTH_BYTES + 12U);          // Peer ID
+    ::memcpy(dgram->buffer + DVM_FRAME_HEADER_LENGTH_BYTES, frame.message, frame.length);
     dgram->address = addr;
     dgram->addrLen = addrLen;
 
-    m_buffers.push_back(dgram);
+    if (m_debug)
+        Utils::dump(1U, "FrameQueue::enqueueMessage() Buffered Prepared Message", dgram->buffer, bufferLen);
+
+    enqueueDatagram(dgram);
 }
 
 /* Helper method to clear any tracked stream timestamps. */
@@ -218,20 +288,93 @@ void FrameQueue::clearTimestamps()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* Generate RTP message for the frame queue. */
+/* Helper to decode and validate the RTP and FNE headers of a received UDP packet. */
 
-uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
-    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, uint32_t* outBufferLen)
+uint8_t* FrameQueue::decodeMessage(const char* caller, uint8_t* buffer, int length, RTPHeader& rtpHeader, RTPFNEHeader& fneHeader)
 {
-    if (message == nullptr) {
-        LogError(LOG_NET, "FrameQueue::generateMessage(), message is null");
+    if (length < (int)(RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES)) {
+        LogError(LOG_NET, "%s, message received from network is malformed! %u bytes != %u bytes", caller, 
+            RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES, length);
         return nullptr;
     }
-    if (length == 0U) {
-        LogError(LOG_NET, "FrameQueue::generateMessage(), message length is zero");
+
+    // decode RTP header
+    if (!rtpHeader.decode(buffer)) {
+        LogError(LOG_NET, "%s, invalid RTP packet received from network", caller);
+        return nullptr;
+    }
+
+    // ensure the RTP header has extension header (otherwise abort)
+    if (!rtpHeader.getExtension()) {
+        LogError(LOG_NET, "%s, invalid RTP header received from network", caller);
         return nullptr;
     }
 
+    // ensure payload type is correct
+    if ((rtpHeader.getPayloadType() != DVM_RTP_PAYLOAD_TYPE) &&
+        (rtpHeader.getPayloadType() != (DVM_RTP_PAYLOAD_TYPE + 1U))) {
+        LogError(LOG_NET, "%s, invalid RTP payload type received from network", caller);
+        return nullptr;
+    }
+
+    // decode FNE RTP header
+    if (!fneHeader.decode(buffer + RTP_HEADER_LENGTH_BYTES)) {
+        LogError(LOG_NET, "%s, invalid RTP packet received from network", caller);
+        return nullptr;
+    }
+
+    uint32_t messageLength = fneHeader.getMessageLength();
+    if (messageLength == 0U) {
+        LogError(LOG_NET, "%s, invalid FNE packet length received from network", caller);
+        return nullptr;
+    }
+
+    uint32_t offset = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+    if (offset + messageLength > (uint32_t)length) {
+        LogError(LOG_NET, "%s, invalid FNE packet length received from network", caller);
+        return nullptr;
+    }
+
+    uint8_t* message = buffer + offset;
+
+    uint16_t calc = edac::CRC::createCRC16(message, messageLength * 8U);
+    if (calc != fneHeader.getCRC()) {
+        LogError(LOG_NET, "%s, failed CRC CCITT-162 check", caller);
+        return nullptr;
+    }
+
+    return message;
+}
+
+/* Generate the RTP and FNE headers of a message for the frame queue. */
+
+void FrameQueue::generateHeader(uint8_t* header, const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
+    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq)
+{
+    assert(header != nullptr);
+    assert(message != nullptr);
+
+    ::memset(header, 0x00U, DVM_FRAME_HEADER_LENGTH_BYTES);
+    generateRTPHeader(header, streamId, ssrc, rtpSeq);
+
+    RTPFNEHeader fneHeader = RTPFNEHeader();
+    fneHeader.setCRC(edac::CRC::createCRC16(message, length * 8U));
+    fneHeader.setStreamId(streamId);
+    fneHeader.setPeerId(peerId);
+    fneHeader.setMessageLength(length);
+
+    fneHeader.setFunction(opcode.first);
+    fneHeader.setSubFunction(opcode.second);
+
+    fneHeader.encode(header + RTP_HEADER_LENGTH_BYTES);
+}
+
+/* Generate the RTP header of a message for the frame queue. */
+
+void FrameQueue::generateRTPHeader(uint8_t* header, uint32_t streamId, uint32_t ssrc, uint16_t rtpSeq)
+{
+    assert(header != nullptr);
+
     uint32_t timestamp = INVALID_TS;
     if (streamId != 0U) {
 #if defined(_WIN32)
@@ -247,7 +390,7 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
         if (timestamp != INVALID_TS) {
             timestamp += (RTP_GENERIC_CLOCK_RATE / 133);
             if (m_debug)
-                LogDebugEx(LOG_NET, "FrameQueue::generateMessage()", "RTP streamId = %u, previous TS = %u, TS = %u, rtpSeq = %u", streamId, m_streamTimestamps[streamId], timestamp, rtpSeq);
+                LogDebugEx(LOG_NET, "FrameQueue::generateRTPHeader()", "RTP streamId = %u, previous TS = %u, TS = %u, rtpSeq = %u", streamId, m_streamTimestamps[streamId], timestamp, rtpSeq);
             m_streamTimestamps[streamId] = timestamp;
         }
 #if !defined(_WIN32)
@@ -255,24 +398,20 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
 #endif // defined(_WIN32)
     }
 
-    uint32_t bufferLen = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES + length;
-    uint8_t* buffer = new uint8_t[bufferLen];
-    ::memset(buffer, 0x00U, bufferLen);
-
-    RTPHeader header = RTPHeader();
-    header.setExtension(true);
+    RTPHeader rtpHeader = RTPHeader();
+    rtpHeader.setExtension(true);
 
-    header.setPayloadType(DVM_RTP_PAYLOAD_TYPE);
-    header.setTimestamp(timestamp);
-    header.setSequence(rtpSeq);
-    header.setSSRC(ssrc);
+    rtpHeader.setPayloadType(DVM_RTP_PAYLOAD_TYPE);
+    rtpHeader.setTimestamp(timestamp);
+    rtpHeader.setSequence(rtpSeq);
+    rtpHeader.setSSRC(ssrc);
 
     if (streamId != 0U && timestamp == INVALID_TS && rtpSeq != RTP_END_OF_CALL_SEQ) {
         if (m_debug)
-            LogDebugEx(LOG_NET, "FrameQueue::generateMessage()", "RTP streamId = %u, initial TS = %u, rtpSeq = %u", streamId, header.getTimestamp(), rtpSeq);
+            LogDebugEx(LOG_NET, "FrameQueue::generateRTPHeader()", "RTP streamId = %u, initial TS = %u, rtpSeq = %u", streamId, rtpHeader.getTimestamp(), rtpSeq);
 
         timestamp = (uint32_t)system_clock::ntp::now();
-        header.setTimestamp(timestamp);
+        rtpHeader.setTimestamp(timestamp);
 
 #if defined(_WIN32)
         std::lock_guard<std::mutex> lock(m_streamTSMtx);
@@ -282,7 +421,7 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
 #endif // defined(_WIN32)
     }
 
-    header.encode(buffer);
+    rtpHeader.encode(header);
 
     if (streamId != 0U && rtpSeq == RTP_END_OF_CALL_SEQ) {
 #if defined(_WIN32)
@@ -293,7 +432,7 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
         auto entry = m_streamTimestamps.find(streamId);
         if (entry != m_streamTimestamps.end()) {
             if (m_debug)
-                LogDebugEx(LOG_NET, "FrameQueue::generateMessage()", "RTP streamId = %u, rtpSeq = %u", streamId, rtpSeq);
+                LogDebugEx(LOG_NET, "FrameQueue::generateRTPHeader()", "RTP streamId = %u, rtpSeq = %u", streamId, rtpSeq);
 #if !defined(_WIN32)
             m_streamTimestamps.unlock();
 #endif // defined(_WIN32)
@@ -303,26 +442,4 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
         m_streamTimestamps.unlock();
 #endif // defined(_WIN32)
     }
-
-    RTPFNEHeader fneHeader = RTPFNEHeader();
-    fneHeader.setCRC(edac::CRC::createCRC16(message, length * 8U));
-    fneHeader.setStreamId(streamId);
-    fneHeader.setPeerId(peerId);
-    fneHeader.setMessageLength(length);
-
-    fneHeader.setFunction(opcode.first);
-    fneHeader.setSubFunction(opcode.second);
-
-    fneHeader.encode(buffer + RTP_HEADER_LENGTH_BYTES);
-
-    ::memcpy(buffer + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES, message, length);
-
-    if (m_debug)
-        Utils::dump(1U, "FrameQueue::generateMessage() Buffered Message", buffer, bufferLen);
-
-    if (outBufferLen != nullptr) {
-        *outBufferLen = bufferLen;
-    }
-
-    return buffer;
 }
@@ -29,6 +29,7 @@ namespace network
     // ---------------------------------------------------------------------------
     
     const uint8_t DVM_RTP_PAYLOAD_TYPE = 0x56U;
+    const uint32_t DVM_FRAME_HEADER_LENGTH_BYTES = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
 
     // ---------------------------------------------------------------------------
     //  Class Declaration
@@ -41,6 +42,37 @@ namespace network
     class HOST_SW_API FrameQueue : public RawFrameQueue {
     public: typedef std::pair<const NET_FUNC::ENUM, const NET_SUBFUNC::ENUM> OpcodePair;
     public:
+        /**
+         * @brief Represents a message read from a UDP packet by a batched read.
+         */
+        struct RxFrame {
+            uint8_t* message;               //! Message buffer (this points into the receive slab)
+            int messageLength;              //! Length of message buffer
+
+            sockaddr_storage address;       //! IP Address and Port
+            uint32_t addrLen;               //! Length of address structure
+            frame::RTPHeader rtpHeader;     //! RTP Header
+            frame::RTPFNEHeader fneHeader;  //! RTP FNE Header
+        };
+
+        /**
+         * @brief Represents a message whose payload CRC and invariant header fields have been encoded once, for
+         *  queuing the same message to many peers.
+         * @note The prepared frame does not copy the message, the message buffer must remain valid (and unchanged)
+         *  for as long as the prepared frame is used.
+         */
+        struct PreparedFrame {
+            const uint8_t* message;         //! Message buffer
+            uint32_t length;                //! Length of message buffer
+            uint32_t streamId;              //! Message stream ID
+            uint32_t ssrc;                  //! RTP SSRC ID
+
+            /**
+             * @brief Encoded FNE header template (the peer ID is patched in for each peer).
+             */
+            uint8_t fneHeader[RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES];
+        };
+
         auto operator=(FrameQueue&) -> FrameQueue& = delete;
         auto operator=(FrameQueue&&) -> FrameQueue& = delete;
         FrameQueue(FrameQueue&) = delete;
@@ -63,6 +95,14 @@ namespace network
          */
         UInt8Array read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
                 frame::RTPHeader* rtpHeader = nullptr, frame::RTPFNEHeader* fneHeader = nullptr);
+        /**
+         * @brief Read a batch of messages from the received UDP packets.
+         * @note The message buffers of the returned frames point into the receive slab, and are only valid until
+         *  the next batched read.
+         * @param[out] frames Vector of frames read.
+         * @returns int Number of frames read, or -1 on error.
+         */
+        int readBatch(std::vector<RxFrame>& frames);
         /**
          * @brief Write message to the UDP socket.
          * @param[in] message Message buffer to frame and queue.
@@ -107,6 +147,30 @@ namespace network
         void enqueueMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
             uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen);
 
+        /**
+         * @brief Prepares a message to be queued to many peers.
+         * @note The payload CRC and the invariant FNE header fields are encoded once, queuing the prepared frame
+         *  to each peer then only generates the RTP header and patches the peer ID.
+         * @param[out] frame Prepared frame.
+         * @param[in] message Message buffer to frame (this is not copied, see PreparedFrame).
+         * @param length Length of message.
+         * @param streamId Message stream ID.
+         * @param ssrc RTP SSRC ID.
+         * @param opcode Opcode.
+         * @returns bool True, if the message was prepared, otherwise false.
+         */
+        bool prepareMessage(PreparedFrame& frame, const uint8_t* message, uint32_t length, uint32_t streamId,
+            uint32_t ssrc, OpcodePair opcode);
+        /**
+         * @brief Cache a prepared message to frame queue.
+         * @param[in] frame Prepared frame.
+         * @param peerId Peer ID.
+         * @param rtpSeq RTP Sequence.
+         * @param addr IP address to write data to.
+         * @param addrLen 
+         */
+        void enqueueMessage(const PreparedFrame& frame, uint32_t peerId, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen);
+
         /**
          * @brief Helper method to clear any tracked stream timestamps.
          */
@@ -115,6 +179,8 @@ namespace network
     private:
         uint32_t m_peerId;
 
+        udp::BufferVector m_rxReady;
+
 #if defined(_WIN32)
         std::mutex m_streamTSMtx;
         std::unordered_map<uint32_t, uint32_t> m_streamTimestamps;
@@ -123,7 +189,19 @@ namespace network
 #endif // defined(_WIN32)
 
         /**
-         * @brief Generate RTP message for the frame queue.
+         * @brief Helper to decode and validate the RTP and FNE headers of a received UDP packet.
+         * @param caller Name of the calling read method (used for logging).
+         * @param[in] buffer Buffer containing the UDP packet.
+         * @param length Length of the UDP packet.
+         * @param[out] rtpHeader RTP Header.
+         * @param[out] fneHeader FNE Header.
+         * @returns uint8_t* Pointer to the message within the UDP packet, or nullptr if the packet is invalid.
+         */
+        uint8_t* decodeMessage(const char* caller, uint8_t* buffer, int length, frame::RTPHeader& rtpHeader, frame::RTPFNEHeader& fneHeader);
+
+        /**
+         * @brief Generate the RTP and FNE headers of a message for the frame queue.
+         * @param[out] header Buffer to generate the headers into (must be DVM_FRAME_HEADER_LENGTH_BYTES long).
          * @param[in] message Message buffer to frame and queue.
          * @param length Length of message.
          * @param streamId Message stream ID.
@@ -131,11 +209,18 @@ namespace network
          * @param ssrc RTP SSRC ID.
          * @param opcode Opcode.
          * @param rtpSeq RTP Sequence.
-         * @param[out] outBufferLen Length of buffer generated.
-         * @returns uint8_t* Buffer containing RTP message.
          */
-        uint8_t* generateMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
-            uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, uint32_t* outBufferLen);
+        void generateHeader(uint8_t* header, const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
+            uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq);
+        /**
+         * @brief Generate the RTP header of a message for the frame queue.
+         * @note This advances the tracked RTP timestamp of the stream.
+         * @param[out] header Buffer to generate the RTP header into (must be RTP_HEADER_LENGTH_BYTES long).
+         * @param streamId Message stream ID.
+         * @param ssrc RTP SSRC ID.
+         * @param rtpSeq RTP Sequence.
+         */
+        void generateRTPHeader(uint8_t* header, uint32_t streamId, uint32_t ssrc, uint16_t rtpSeq);
     };
 } // namespace network
 
@@ -19,6 +19,7 @@
 
 using namespace network;
 
+#include <algorithm>
 #include <cstdio>
 #include <cassert>
 #include <cmath>
@@ -29,6 +30,10 @@ using namespace network;
 
 #define MAX_SERVER_DIFF 360ULL // maximum difference in time between a server timestamp and local timestamp in milliseconds
 
+const uint32_t MAX_RX_DRAIN_CNT = 256U;
+const uint32_t MAX_RX_FRAME_LEN = 256U; // length byte, and the largest frame a length byte can describe
+const uint32_t RX_STREAM_TIMEOUT = 1000U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -50,6 +55,9 @@ Network::Network(const std::string& address, uint16_t port, uint16_t localPort,
     m_saveLookup(saveLookup),
     m_ridLookup(nullptr),
     m_tidLookup(nullptr),
+    m_aclVersion(0U),
+    m_aclRIDGeneration(0U),
+    m_aclTGIDGeneration(0U),
     m_salt(nullptr),
     m_retryTimer(1000U, 10U),
     m_timeoutTimer(1000U, MAX_PEER_PING_TIME),
@@ -65,7 +73,13 @@ Network::Network(const std::string& address, uint16_t port, uint16_t localPort,
     m_dmrInCallCallback(nullptr),
     m_p25InCallCallback(nullptr),
     m_nxdnInCallCallback(nullptr),
-    m_keyRespCallback(nullptr)
+    m_keyRespCallback(nullptr),
+    m_rxStreams(),
+    m_rxStreamMutex(),
+    m_jitterBufferEnabled(true),
+    m_jitterBufferMinDepth(JITTER_BUFFER_DEFAULT_MIN_DEPTH),
+    m_jitterBufferMaxDepth(JITTER_BUFFER_DEFAULT_MAX_DEPTH),
+    m_jitterBufferMaxWait(JITTER_BUFFER_DEFAULT_MAX_WAIT)
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -86,6 +100,11 @@ Network::Network(const std::string& address, uint16_t port, uint16_t localPort,
 
 Network::~Network()
 {
+    for (auto& entry : m_rxStreams) {
+        delete entry.second.jitterBuffer;
+    }
+    m_rxStreams.clear();
+
     delete[] m_salt;
     delete[] m_rxDMRStreamId;
     delete m_metadata;
@@ -104,6 +123,8 @@ void Network::resetDMR(uint32_t slotNo)
     else {
         m_rxDMRStreamId[1U] = 0U;
     }
+
+    clearRxStreams(NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR, slotNo - 1U);
 }
 
 /* Resets the P25 ring buffer. */
@@ -112,6 +133,8 @@ void Network::resetP25()
 {
     BaseNetwork::resetP25();
     m_rxP25StreamId = 0U;
+
+    clearRxStreams(NET_SUBFUNC::PROTOCOL_SUBFUNC_P25);
 }
 
 /* Resets the NXDN ring buffer. */
@@ -120,6 +143,8 @@ void Network::resetNXDN()
 {
     BaseNetwork::resetNXDN();
     m_rxNXDNStreamId = 0U;
+
+    clearRxStreams(NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN);
 }
 
 /* Sets the instances of the Radio ID and Talkgroup ID lookup tables. */
@@ -167,6 +192,16 @@ void Network::setPresharedKey(const uint8_t* presharedKey)
     m_socket->setPresharedKey(presharedKey);
 }
 
+/* Sets the receive jitter buffer configuration. */
+
+void Network::setJitterBuffer(bool enabled, uint32_t minDepth, uint32_t maxDepth, uint32_t maxWait)
+{
+    m_jitterBufferEnabled = enabled;
+    m_jitterBufferMinDepth = minDepth;
+    m_jitterBufferMaxDepth = maxDepth;
+    m_jitterBufferMaxWait = maxWait;
+}
+
 /* Updates the timer by the passed number of milliseconds. */
 
 void Network::clock(uint32_t ms)
@@ -227,12 +262,23 @@ void Network::clock(uint32_t ms)
     frame::RTPFNEHeader fneHeader;
     int length = 0U;
 
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
-    if (length > 0) {
+    // drain the messages waiting on the socket -- a single message can release every frame held by a jitter buffer,
+    // so draining stops (leaving the remaining messages queued on the socket) once any of the protocol ring buffers
+    // can no longer hold that many frames
+    uint32_t rxHeadroom = ((m_jitterBufferEnabled) ? m_jitterBufferMaxDepth + 1U : 1U) * MAX_RX_FRAME_LEN;
+    for (uint32_t drainCnt = 0U; drainCnt < MAX_RX_DRAIN_CNT; drainCnt++) {
+        if (!hasRxSpace(rxHeadroom)) {
+            break;
+        }
+
+        UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+        if (length <= 0) {
+            break;
+        }
+
         if (!udp::Socket::match(m_addr, address)) {
             LogError(LOG_NET, "Packet received from an invalid source");
-            return;
+            continue;
         }
 
         if (m_debug) {
@@ -250,7 +296,7 @@ void Network::clock(uint32_t ms)
         uint32_t peerId = fneHeader.getPeerId();
         if ((m_peerId != peerId) && !m_promiscuousPeer) {
             LogError(LOG_NET, "Packet received was not destined for us? peerId = %u", peerId);
-            return;
+            continue;
         }
 
         // peer connections should never encounter no stream ID
@@ -326,9 +372,7 @@ void Network::clock(uint32_t ms)
                             if (length > 255)
                                 LogError(LOG_NET, "DMR Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
 
-                            uint8_t len = length;
-                            m_rxDMRData.addData(&len, 1U);
-                            m_rxDMRData.addData(buffer.get(), len);
+                            queueRxFrame(NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR, slotNo, streamId, rtpHeader.getSequence(), buffer, length, now);
                         }
                     }
                     break;
@@ -378,9 +422,7 @@ void Network::clock(uint32_t ms)
                             if (length > 255)
                                 LogError(LOG_NET, "P25 Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
 
-                            uint8_t len = length;
-                            m_rxP25Data.addData(&len, 1U);
-                            m_rxP25Data.addData(buffer.get(), len);
+                            queueRxFrame(NET_SUBFUNC::PROTOCOL_SUBFUNC_P25, 0U, streamId, rtpHeader.getSequence(), buffer, length, now);
                         }
                     }
                     break;
@@ -430,9 +472,7 @@ void Network::clock(uint32_t ms)
                             if (length > 255)
                                 LogError(LOG_NET, "NXDN Stream %u, frame oversized? this shouldn't happen, pktSeq = %u, len = %u", streamId, m_pktSeq, length);
 
-                            uint8_t len = length;
-                            m_rxNXDNData.addData(&len, 1U);
-                            m_rxNXDNData.addData(buffer.get(), len);
+                            queueRxFrame(NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN, 0U, streamId, rtpHeader.getSequence(), buffer, length, now);
                         }
                     }
                     break;
@@ -458,12 +498,15 @@ void Network::clock(uint32_t ms)
                                 // update RID lists
                                 uint32_t len = GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
+                                std::vector<uint32_t> ids;
                                 for (uint32_t i = 0; i < len; i++) {
                                     uint32_t id = GET_UINT24(buffer, offs);
-                                    m_ridLookup->toggleEntry(id, true);
+                                    ids.push_back(id);
                                     offs += 4U;
                                 }
 
+                                m_ridLookup->toggleEntries(ids, true);
+
                                 LogMessage(LOG_NET, "Network Announced %u whitelisted RIDs", len);
 
                                 // save to file if enabled and we got RIDs
@@ -484,12 +527,15 @@ void Network::clock(uint32_t ms)
                                 // update RID lists
                                 uint32_t len = GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
+                                std::vector<uint32_t> ids;
                                 for (uint32_t i = 0; i < len; i++) {
                                     uint32_t id = GET_UINT24(buffer, offs);
-                                    m_ridLookup->toggleEntry(id, false);
+                                    ids.push_back(id);
                                     offs += 4U;
                                 }
 
+                                m_ridLookup->toggleEntries(ids, false);
+
                                 LogMessage(LOG_NET, "Network Announced %u blacklisted RIDs", len);
 
                                 // save to file if enabled and we got RIDs
@@ -508,9 +554,10 @@ void Network::clock(uint32_t ms)
                                 Utils::dump(1U, "Network Received, ACTIVE TGS", buffer.get(), length);
 
                             if (m_tidLookup != nullptr) {
-                                // update TGID lists
+                                // update TGID lists (the talkgroup rules are re-indexed once, after the whole list is applied)
                                 uint32_t len = GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
+                                m_tidLookup->beginUpdate();
                                 for (uint32_t i = 0; i < len; i++) {
                                     uint32_t id = GET_UINT24(buffer, offs);
                                     uint8_t slot = (buffer[offs + 3U]) & 0x03U;
@@ -524,7 +571,7 @@ void Network::clock(uint32_t ms)
                                     if (nonPreferred) {
                                         if (!tid.isInvalid()) {
                                             m_tidLookup->eraseEntry(id, slot);
-                                            tid = m_tidLookup->find(id, slot);
+                                            tid = lookups::TalkgroupRuleGroupVoice(); // lookups don't see the erase until the batch ends
                                         }
                                     }
 
@@ -540,6 +587,7 @@ void Network::clock(uint32_t ms)
 
                                     offs += 5U;
                                 }
+                                m_tidLookup->endUpdate();
 
                                 LogMessage(LOG_NET, "Activated %u TGs; loaded %u entries into talkgroup rules table", len, m_tidLookup->groupVoice().size());
 
@@ -558,9 +606,10 @@ void Network::clock(uint32_t ms)
                                 Utils::dump(1U, "Network Received, DEACTIVE TGS", buffer.get(), length);
 
                             if (m_tidLookup != nullptr) {
-                                // update TGID lists
+                                // update TGID lists (the talkgroup rules are re-indexed once, after the whole list is applied)
                                 uint32_t len = GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
+                                m_tidLookup->beginUpdate();
                                 for (uint32_t i = 0; i < len; i++) {
                                     uint32_t id = GET_UINT24(buffer, offs);
                                     uint8_t slot = (buffer[offs + 3U]);
@@ -573,6 +622,7 @@ void Network::clock(uint32_t ms)
 
                                     offs += 5U;
                                 }
+                                m_tidLookup->endUpdate();
 
                                 LogMessage(LOG_NET, "Deactivated %u TGs; loaded %u entries into talkgroup rules table", len, m_tidLookup->groupVoice().size());
 
@@ -585,6 +635,25 @@ void Network::clock(uint32_t ms)
                     }
                     break;
 
+                case NET_SUBFUNC::MASTER_SUBFUNC_ACL_VERSION:           // ACL Version
+                    {
+                        if (m_enabled && m_updateLookup) {
+                            if (m_debug)
+                                Utils::dump(1U, "Network Received, ACL VERSION", buffer.get(), length);
+
+                            // the master has finished sending the ACL lists, record the version of the lists we have
+                            // (and the lookup table generations they were applied to)
+                            uint32_t version = GET_UINT32(buffer, 6U);
+                            m_aclVersion = version;
+                            m_aclRIDGeneration = (m_ridLookup != nullptr) ? m_ridLookup->generation() : 0U;
+                            m_aclTGIDGeneration = (m_tidLookup != nullptr) ? m_tidLookup->generation() : 0U;
+
+                            if (m_debug)
+                                LogDebug(LOG_NET, "Network Announced ACL version $%08X", version);
+                        }
+                    }
+                    break;
+
                 default:
                     Utils::dump("unknown master control opcode from the master", buffer.get(), length);
                     break;
@@ -841,8 +910,16 @@ void Network::clock(uint32_t ms)
                 buffer.get(), length, fneHeader.getStreamId());
             break;
         }
+
+        // stop draining if the connection was reset
+        if (m_status == NET_STAT_WAITING_CONNECT) {
+            break;
+        }
     }
 
+    // release the frames ready in the stream jitter buffers
+    releaseRxFrames(now);
+
     m_retryTimer.clock(ms);
     if (m_retryTimer.isRunning() && m_retryTimer.hasExpired()) {
         switch (m_status) {
@@ -920,6 +997,15 @@ void Network::close()
     m_retryTimer.stop();
     m_timeoutTimer.stop();
 
+    // discard any frames held by the stream jitter buffers
+    {
+        std::lock_guard<std::mutex> lock(m_rxStreamMutex);
+        for (auto& entry : m_rxStreams) {
+            delete entry.second.jitterBuffer;
+        }
+        m_rxStreams.clear();
+    }
+
     m_status = NET_STAT_WAITING_CONNECT;
 }
 
@@ -941,6 +1027,142 @@ void Network::userPacketHandler(uint32_t peerId, FrameQueue::OpcodePair opcode,
     Utils::dump("unknown opcode from the master", data, length);
 }
 
+/* Helper to queue a received protocol frame, through the stream jitter buffer, to the protocol ring buffer. */
+
+void Network::queueRxFrame(NET_SUBFUNC::ENUM subFunc, uint32_t slotNo, uint32_t streamId, uint16_t seq, UInt8Array& data, uint32_t length, uint64_t now)
+{
+    std::lock_guard<std::mutex> lock(m_rxStreamMutex);
+
+    // frames are passed straight through when the jitter buffer is disabled, or for single frame messages
+    auto it = m_rxStreams.find(streamId);
+    if (!m_jitterBufferEnabled || (it == m_rxStreams.end() && seq == RTP_END_OF_CALL_SEQ)) {
+        addRxFrame(subFunc, data.get(), length);
+        return;
+    }
+
+    if (it == m_rxStreams.end()) {
+        RxStream stream;
+        stream.subFunc = subFunc;
+        stream.slotNo = slotNo;
+        stream.jitterBuffer = new RTPJitterBuffer(m_jitterBufferMinDepth, m_jitterBufferMaxDepth, m_jitterBufferMaxWait);
+
+        it = m_rxStreams.insert({ streamId, stream }).first;
+    }
+
+    if (!it->second.jitterBuffer->push(seq, data, length, now)) {
+        if (m_debug)
+            LogDebugEx(LOG_NET, "Network::queueRxFrame()", "stream %u, dropped late or duplicate frame, seq = %u", streamId, seq);
+        return;
+    }
+
+    if (releaseRxStream(streamId, it->second, now)) {
+        delete it->second.jitterBuffer;
+        m_rxStreams.erase(it);
+    }
+}
+
+/* Helper to release the ready frames from the stream jitter buffers to the protocol ring buffers. */
+
+void Network::releaseRxFrames(uint64_t now)
+{
+    std::lock_guard<std::mutex> lock(m_rxStreamMutex);
+    for (auto it = m_rxStreams.begin(); it != m_rxStreams.end();) {
+        // streams that stop without an end of call are flushed once they time out
+        bool timeout = (now - it->second.jitterBuffer->lastRxTime()) >= RX_STREAM_TIMEOUT;
+        if (releaseRxStream(it->first, it->second, now, timeout)) {
+            delete it->second.jitterBuffer;
+            it = m_rxStreams.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+}
+
+/* Helper to release the ready frames from a stream jitter buffer to the protocol ring buffer. */
+
+bool Network::releaseRxStream(uint32_t streamId, RxStream& stream, uint64_t now, bool flush)
+{
+    RTPJitterBuffer* jitterBuffer = stream.jitterBuffer;
+
+    // flushing releases the held frames as if they had waited the maximum time
+    uint64_t releaseTime = flush ? now + m_jitterBufferMaxWait : now;
+
+    UInt8Array data = nullptr;
+    uint32_t length = 0U;
+    while (jitterBuffer->pop(data, length, releaseTime)) {
+        addRxFrame(stream.subFunc, data.get(), length);
+    }
+
+    if (!jitterBuffer->isEnded() && !flush) {
+        return false;
+    }
+
+    if (jitterBuffer->lostCnt() > 0U || jitterBuffer->lateCnt() > 0U) {
+        LogWarning(LOG_NET, "%s Stream %u, jitter buffer, lost = %u, late = %u, reordered = %u, depth = %u",
+            (stream.subFunc == NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR) ? "DMR" : (stream.subFunc == NET_SUBFUNC::PROTOCOL_SUBFUNC_P25) ? "P25" : "NXDN",
+            streamId, jitterBuffer->lostCnt(), jitterBuffer->lateCnt(), jitterBuffer->reorderCnt(), jitterBuffer->depth());
+    }
+
+    return true;
+}
+
+/* Helper to clear the stream jitter buffers for the given protocol. */
+
+void Network::clearRxStreams(NET_SUBFUNC::ENUM subFunc, uint32_t slotNo)
+{
+    std::lock_guard<std::mutex> lock(m_rxStreamMutex);
+    for (auto it = m_rxStreams.begin(); it != m_rxStreams.end();) {
+        if (it->second.subFunc == subFunc && (subFunc != NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR || it->second.slotNo == slotNo)) {
+            delete it->second.jitterBuffer;
+            it = m_rxStreams.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+}
+
+/* Helper to check whether every protocol ring buffer has the given amount of free space. */
+
+bool Network::hasRxSpace(uint32_t length) const
+{
+    // a ring buffer can never hold more than its own length, an empty ring buffer always has enough space
+    return m_rxDMRData.freeSpace() >= std::min(length, m_rxDMRData.length()) &&
+        m_rxP25Data.freeSpace() >= std::min(length, m_rxP25Data.length()) &&
+        m_rxNXDNData.freeSpace() >= std::min(length, m_rxNXDNData.length());
+}
+
+/* Helper to add a received protocol frame to the protocol ring buffer. */
+
+void Network::addRxFrame(NET_SUBFUNC::ENUM subFunc, const uint8_t* data, uint32_t length)
+{
+    RingBuffer<uint8_t>* rxData = nullptr;
+    switch (subFunc) {
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR:
+        rxData = &m_rxDMRData;
+        break;
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_P25:
+        rxData = &m_rxP25Data;
+        break;
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN:
+        rxData = &m_rxNXDNData;
+        break;
+    default:
+        return;
+    }
+
+    // a frame that doesn't fit is dropped, instead of overflowing (and clearing) the whole ring buffer
+    uint8_t len = length;
+    if (rxData->freeSpace() < len + 1U) {
+        LogWarning(LOG_NET, "Receive buffer full, dropping frame, subFunc = %02X, len = %u", subFunc, len);
+        return;
+    }
+
+    rxData->addData(&len, 1U);
+    rxData->addData(data, len);
+}
+
 /* Writes login request to the network. */
 
 bool Network::writeLogin()
@@ -1037,6 +1259,12 @@ bool Network::writeConfig()
     // Flags
     config["conventionalPeer"].set<bool>(m_metadata->isConventional);               // Conventional Peer Marker
 
+    // ACL version (only reported if the ACL lists from the master are applied)
+    if (m_updateLookup) {
+        uint32_t aclVer = aclVersion();
+        config["aclVersion"].set<uint32_t>(aclVer);                                  // ACL Version
+    }
+
     config["software"].set<std::string>(std::string(software));
 
     json::value v = json::value(config);
@@ -1058,11 +1286,33 @@ bool Network::writeConfig()
 
 bool Network::writePing()
 {
-    uint8_t buffer[1U];
-    ::memset(buffer, 0x00U, 1U);
+    uint8_t buffer[5U];
+    ::memset(buffer, 0x00U, 5U);
+
+    // append the version of the ACL lists we have
+    uint32_t version = aclVersion();
+    SET_UINT32(version, buffer, 1U);
 
     if (m_debug)
-        Utils::dump(1U, "Network Message, Ping", buffer, 11U);
+        Utils::dump(1U, "Network Message, Ping", buffer, 5U);
+
+    return writeMaster({ NET_FUNC::PING, NET_SUBFUNC::NOP }, buffer, 5U, RTP_END_OF_CALL_SEQ, createStreamId());
+}
+
+/* Helper to get the version of the ACL lists received from the master. */
+
+uint32_t Network::aclVersion()
+{
+    if (!m_updateLookup) {
+        return 0U;
+    }
+
+    // reloading the lookup tables discards the lists received from the master
+    uint32_t ridGeneration = (m_ridLookup != nullptr) ? m_ridLookup->generation() : 0U;
+    uint32_t tidGeneration = (m_tidLookup != nullptr) ? m_tidLookup->generation() : 0U;
+    if (ridGeneration != m_aclRIDGeneration || tidGeneration != m_aclTGIDGeneration) {
+        m_aclVersion = 0U;
+    }
 
-    return writeMaster({ NET_FUNC::PING, NET_SUBFUNC::NOP }, buffer, 1U, RTP_END_OF_CALL_SEQ, createStreamId());
+    return m_aclVersion;
 }
@@ -18,6 +18,7 @@
 
 #include "common/Defines.h"
 #include "common/network/BaseNetwork.h"
+#include "common/network/RTPJitterBuffer.h"
 #include "common/lookups/RadioIdLookup.h"
 #include "common/lookups/TalkgroupRulesLookup.h"
 #include "common/p25/kmm/KeysetItem.h"
@@ -25,6 +26,8 @@
 #include <string>
 #include <cstdint>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 
 namespace network
 {
@@ -156,6 +159,14 @@ namespace network
          * @param presharedKey Encryption preshared key for networking.
          */
         void setPresharedKey(const uint8_t* presharedKey);
+        /**
+         * @brief Sets the receive jitter buffer configuration.
+         * @param enabled Flag indicating whether received voice frames are reordered by a jitter buffer.
+         * @param minDepth Minimum number of held frames before a sequence gap is considered lost.
+         * @param maxDepth Maximum number of held frames before a sequence gap is considered lost.
+         * @param maxWait Maximum amount of time (ms) a frame is held waiting for a sequence gap to fill.
+         */
+        void setJitterBuffer(bool enabled, uint32_t minDepth, uint32_t maxDepth, uint32_t maxWait);
 
         /**
          * @brief Updates the timer by the passed number of milliseconds.
@@ -242,6 +253,10 @@ namespace network
         lookups::RadioIdLookup* m_ridLookup;
         lookups::TalkgroupRulesLookup* m_tidLookup;
 
+        uint32_t m_aclVersion;
+        uint32_t m_aclRIDGeneration;
+        uint32_t m_aclTGIDGeneration;
+
         uint8_t* m_salt;
 
         Timer m_retryTimer;
@@ -305,6 +320,67 @@ namespace network
          */
         std::function<void(p25::kmm::KeyItem ki, uint8_t algId, uint8_t keyLength)> m_keyRespCallback;
 
+        /**
+         * @brief Represents a received stream being reordered by a jitter buffer.
+         */
+        struct RxStream {
+            NET_SUBFUNC::ENUM subFunc;      //! Protocol Subfunction
+            uint32_t slotNo;                //! DMR Slot Index
+            RTPJitterBuffer* jitterBuffer;  //! Jitter Buffer
+        };
+        std::unordered_map<uint32_t, RxStream> m_rxStreams;
+        std::mutex m_rxStreamMutex;
+
+        bool m_jitterBufferEnabled;
+        uint32_t m_jitterBufferMinDepth;
+        uint32_t m_jitterBufferMaxDepth;
+        uint32_t m_jitterBufferMaxWait;
+
+        /**
+         * @brief Helper to queue a received protocol frame, through the stream jitter buffer, to the protocol ring buffer.
+         * @param subFunc Protocol subfunction.
+         * @param slotNo DMR slot index.
+         * @param streamId Stream ID.
+         * @param seq RTP sequence.
+         * @param data Frame data.
+         * @param length Length of frame data.
+         * @param now Current time (ms).
+         */
+        void queueRxFrame(NET_SUBFUNC::ENUM subFunc, uint32_t slotNo, uint32_t streamId, uint16_t seq, UInt8Array& data, uint32_t length, uint64_t now);
+        /**
+         * @brief Helper to release the ready frames from the stream jitter buffers to the protocol ring buffers.
+         * @param now Current time (ms).
+         */
+        void releaseRxFrames(uint64_t now);
+        /**
+         * @brief Helper to release the ready frames from a stream jitter buffer to the protocol ring buffer.
+         * @param streamId Stream ID.
+         * @param stream Received stream.
+         * @param now Current time (ms).
+         * @param flush Flag indicating all held frames should be released.
+         * @returns bool True, if the stream has ended, otherwise false.
+         */
+        bool releaseRxStream(uint32_t streamId, RxStream& stream, uint64_t now, bool flush = false);
+        /**
+         * @brief Helper to clear the stream jitter buffers for the given protocol.
+         * @param subFunc Protocol subfunction.
+         * @param slotNo DMR slot index.
+         */
+        void clearRxStreams(NET_SUBFUNC::ENUM subFunc, uint32_t slotNo = 0U);
+        /**
+         * @brief Helper to add a received protocol frame to the protocol ring buffer.
+         * @param subFunc Protocol subfunction.
+         * @param data Frame data.
+         * @param length Length of frame data.
+         */
+        void addRxFrame(NET_SUBFUNC::ENUM subFunc, const uint8_t* data, uint32_t length);
+        /**
+         * @brief Helper to check whether every protocol ring buffer has the given amount of free space.
+         * @param length Amount of free space (in bytes).
+         * @returns bool True, if every protocol ring buffer has the free space, otherwise false.
+         */
+        bool hasRxSpace(uint32_t length) const;
+
         /**
          * @brief User overrideable handler that allows user code to process network packets not handled by this class.
          * @param peerId Peer ID.
@@ -336,6 +412,14 @@ namespace network
          * @returns bool True, if stay-alive ping was sent, otherwise false.
          */
         bool writePing();
+
+        /**
+         * @brief Helper to get the version of the ACL lists received from the master.
+         * @note The version is forgotten (and 0 is returned) once the lookup tables are reloaded from their
+         *  files, as the lists received from the master are no longer present in the lookup tables.
+         * @returns uint32_t Version of the ACL lists received from the master, or 0 if unknown.
+         */
+        uint32_t aclVersion();
     };
 } // namespace network
 
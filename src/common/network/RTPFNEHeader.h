@@ -92,6 +92,7 @@ namespace network
             MASTER_SUBFUNC_BL_RID = 0x01U,          //! Blacklist RIDs
             MASTER_SUBFUNC_ACTIVE_TGS = 0x02U,      //! Active TGIDs
             MASTER_SUBFUNC_DEACTIVE_TGS = 0x03U,    //! Deactive TGIDs
+            MASTER_SUBFUNC_ACL_VERSION = 0x04U,     //! ACL Version
 
             TRANSFER_SUBFUNC_ACTIVITY = 0x01U,      //! Activity Log Transfer
             TRANSFER_SUBFUNC_DIAG = 0x02U,          //! Diagnostic Log Transfer
@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "network/RTPJitterBuffer.h"
+#include "network/RTPFNEHeader.h"
+
+using namespace network;
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t JITTER_BUFFER_SHRINK_CNT = 500U;
+const int32_t RTP_SEQ_RANGE = RTP_END_OF_CALL_SEQ;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the RTPJitterBuffer class. */
+
+RTPJitterBuffer::RTPJitterBuffer(uint32_t minDepth, uint32_t maxDepth, uint32_t maxWait) :
+    m_minDepth(minDepth),
+    m_maxDepth(maxDepth),
+    m_maxWait(maxWait),
+    m_depth(minDepth),
+    m_slots(),
+    m_count(0U),
+    m_endFrame(nullptr),
+    m_endFrameLength(0U),
+    m_hasEndFrame(false),
+    m_nextSeq(0U),
+    m_started(false),
+    m_ended(false),
+    m_lastRxTime(0U),
+    m_inOrderCnt(0U),
+    m_lostCnt(0U),
+    m_lateCnt(0U),
+    m_reorderCnt(0U)
+{
+    if (m_maxDepth > JITTER_BUFFER_MAX_DEPTH)
+        m_maxDepth = JITTER_BUFFER_MAX_DEPTH;
+    if (m_maxDepth < 1U)
+        m_maxDepth = 1U;
+    if (m_minDepth < 1U)
+        m_minDepth = 1U;
+    if (m_minDepth > m_maxDepth)
+        m_minDepth = m_maxDepth;
+
+    m_depth = m_minDepth;
+
+    for (uint32_t i = 0U; i < JITTER_BUFFER_MAX_DEPTH; i++) {
+        m_slots[i].length = 0U;
+        m_slots[i].seq = 0U;
+        m_slots[i].rxTime = 0U;
+        m_slots[i].valid = false;
+    }
+}
+
+/* Finalizes a instance of the RTPJitterBuffer class. */
+
+RTPJitterBuffer::~RTPJitterBuffer() = default;
+
+/* Adds a frame to the jitter buffer. */
+
+bool RTPJitterBuffer::push(uint16_t seq, UInt8Array& data, uint32_t length, uint64_t now)
+{
+    m_lastRxTime = now;
+
+    // the end of call frame is always released last
+    if (seq == RTP_END_OF_CALL_SEQ) {
+        m_endFrame = std::move(data);
+        m_endFrameLength = length;
+        m_hasEndFrame = true;
+        return true;
+    }
+
+    if (!m_started) {
+        m_nextSeq = seq;
+        m_started = true;
+        m_ended = false;
+    }
+
+    int32_t dist = distance(seq);
+    if (dist < 0) {
+        // this sequence was already released (or skipped as lost)
+        m_lateCnt++;
+        if (m_depth < m_maxDepth)
+            m_depth++;
+        m_inOrderCnt = 0U;
+        return false;
+    }
+
+    // (sequences roll over at the end of call sequence, which is not a multiple of the buffer size, so
+    //  the last slot is left unused to prevent held frames from colliding across the roll over)
+    if (dist >= (int32_t)JITTER_BUFFER_MAX_DEPTH - 1) {
+        // the sequence jumped further ahead than the buffer can hold; the held frames can no longer
+        // be released in order, discard them and resynchronize on this frame
+        m_lostCnt += (uint32_t)dist - m_count;
+        for (uint32_t i = 0U; i < JITTER_BUFFER_MAX_DEPTH; i++) {
+            m_slots[i].data = nullptr;
+            m_slots[i].valid = false;
+        }
+
+        m_count = 0U;
+        m_nextSeq = seq;
+        dist = 0;
+    }
+
+    Slot& slot = m_slots[seq % JITTER_BUFFER_MAX_DEPTH];
+    if (slot.valid && slot.seq == seq) {
+        return false; // duplicate
+    }
+
+    // is this frame filling a sequence gap?
+    if (m_count > 0U) {
+        for (uint32_t i = 0U; i < JITTER_BUFFER_MAX_DEPTH; i++) {
+            if (m_slots[i].valid && distance(m_slots[i].seq) > dist) {
+                m_reorderCnt++;
+                if (m_depth < m_maxDepth)
+                    m_depth++;
+                m_inOrderCnt = 0U;
+                break;
+            }
+        }
+    }
+
+    slot.data = std::move(data);
+    slot.length = length;
+    slot.seq = seq;
+    slot.rxTime = now;
+    slot.valid = true;
+    m_count++;
+
+    return true;
+}
+
+/* Gets the next frame that is ready to be released from the jitter buffer. */
+
+bool RTPJitterBuffer::pop(UInt8Array& data, uint32_t& length, uint64_t now)
+{
+    if (m_count > 0U) {
+        // is the next expected sequence held?
+        Slot* slot = &m_slots[m_nextSeq % JITTER_BUFFER_MAX_DEPTH];
+        if (slot->valid && slot->seq == m_nextSeq) {
+            release(slot, data, length);
+
+            m_inOrderCnt++;
+            if (m_inOrderCnt >= JITTER_BUFFER_SHRINK_CNT) {
+                if (m_depth > m_minDepth)
+                    m_depth--;
+                m_inOrderCnt = 0U;
+            }
+
+            return true;
+        }
+
+        // there is a sequence gap; wait for it to fill until the buffer is too deep or the
+        // frames have been held too long
+        uint64_t oldest = now;
+        for (uint32_t i = 0U; i < JITTER_BUFFER_MAX_DEPTH; i++) {
+            if (m_slots[i].valid && m_slots[i].rxTime < oldest)
+                oldest = m_slots[i].rxTime;
+        }
+
+        if (m_count >= m_depth || (now - oldest) >= m_maxWait) {
+            slot = nearest();
+            m_lostCnt += (uint32_t)distance(slot->seq);
+            m_inOrderCnt = 0U;
+
+            release(slot, data, length);
+            return true;
+        }
+
+        return false;
+    }
+
+    if (m_hasEndFrame) {
+        data = std::move(m_endFrame);
+        length = m_endFrameLength;
+
+        m_hasEndFrame = false;
+        m_endFrameLength = 0U;
+
+        m_started = false;
+        m_ended = true;
+        return true;
+    }
+
+    return false;
+}
+
+/* Helper to reset the jitter buffer. */
+
+void RTPJitterBuffer::reset()
+{
+    for (uint32_t i = 0U; i < JITTER_BUFFER_MAX_DEPTH; i++) {
+        m_slots[i].data = nullptr;
+        m_slots[i].valid = false;
+    }
+
+    m_count = 0U;
+
+    m_endFrame = nullptr;
+    m_endFrameLength = 0U;
+    m_hasEndFrame = false;
+
+    m_nextSeq = 0U;
+    m_started = false;
+    m_ended = false;
+    m_inOrderCnt = 0U;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to determine the distance from the next expected sequence to the given sequence. */
+
+int32_t RTPJitterBuffer::distance(uint16_t seq) const
+{
+    // sequences roll over before the end of call sequence
+    int32_t dist = ((int32_t)seq - (int32_t)m_nextSeq) % RTP_SEQ_RANGE;
+    if (dist < 0)
+        dist += RTP_SEQ_RANGE;
+    if (dist >= RTP_SEQ_RANGE / 2)
+        dist -= RTP_SEQ_RANGE;
+
+    return dist;
+}
+
+/* Helper to get the held frame with the nearest sequence to the next expected sequence. */
+
+RTPJitterBuffer::Slot* RTPJitterBuffer::nearest()
+{
+    Slot* slot = nullptr;
+    int32_t nearest = 0;
+    for (uint32_t i = 0U; i < JITTER_BUFFER_MAX_DEPTH; i++) {
+        if (!m_slots[i].valid)
+            continue;
+
+        int32_t dist = distance(m_slots[i].seq);
+        if (slot == nullptr || dist < nearest) {
+            slot = &m_slots[i];
+            nearest = dist;
+        }
+    }
+
+    return slot;
+}
+
+/* Helper to release a held frame. */
+
+void RTPJitterBuffer::release(Slot* slot, UInt8Array& data, uint32_t& length)
+{
+    data = std::move(slot->data);
+    length = slot->length;
+
+    slot->valid = false;
+    m_count--;
+
+    m_nextSeq = (uint16_t)((slot->seq + 1U) % RTP_END_OF_CALL_SEQ);
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file RTPJitterBuffer.h
+ * @ingroup network_core
+ * @file RTPJitterBuffer.cpp
+ * @ingroup network_core
+ */
+#if !defined(__RTP_JITTER_BUFFER_H__)
+#define __RTP_JITTER_BUFFER_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define JITTER_BUFFER_MAX_DEPTH 32U
+#define JITTER_BUFFER_DEFAULT_MIN_DEPTH 2U
+#define JITTER_BUFFER_DEFAULT_MAX_DEPTH 8U
+#define JITTER_BUFFER_DEFAULT_MAX_WAIT 120U
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a RTP jitter buffer, which reorders the frames of a single stream by their
+     *  RTP sequence.
+     * @note Frames received in sequence are released immediately; frames received after a sequence gap
+     *  are held until the gap is filled, the held frames exceed the buffer depth or the oldest held frame
+     *  exceeds the maximum wait time. The buffer depth adapts between the minimum and maximum depth;
+     *  growing when frames are received out-of-order or late, and shrinking after a run of in-order frames.
+     * @ingroup network_core
+     */
+    class HOST_SW_API RTPJitterBuffer {
+    public:
+        /**
+         * @brief Initializes a new instance of the RTPJitterBuffer class.
+         * @param minDepth Minimum number of held frames before a sequence gap is considered lost.
+         * @param maxDepth Maximum number of held frames before a sequence gap is considered lost.
+         * @param maxWait Maximum amount of time (ms) a frame is held waiting for a sequence gap to fill.
+         */
+        RTPJitterBuffer(uint32_t minDepth = JITTER_BUFFER_DEFAULT_MIN_DEPTH, uint32_t maxDepth = JITTER_BUFFER_DEFAULT_MAX_DEPTH,
+            uint32_t maxWait = JITTER_BUFFER_DEFAULT_MAX_WAIT);
+        /**
+         * @brief Finalizes a instance of the RTPJitterBuffer class.
+         */
+        ~RTPJitterBuffer();
+
+        /**
+         * @brief Adds a frame to the jitter buffer.
+         * @param seq RTP sequence of the frame.
+         * @param data Frame data (the jitter buffer takes ownership).
+         * @param length Length of the frame.
+         * @param now Current time (ms).
+         * @returns bool True, if the frame was buffered, otherwise false (the frame was late or duplicated).
+         */
+        bool push(uint16_t seq, UInt8Array& data, uint32_t length, uint64_t now);
+        /**
+         * @brief Gets the next frame that is ready to be released from the jitter buffer.
+         * @param[out] data Frame data.
+         * @param[out] length Length of the frame.
+         * @param now Current time (ms).
+         * @returns bool True, if a frame was released, otherwise false.
+         */
+        bool pop(UInt8Array& data, uint32_t& length, uint64_t now);
+
+        /**
+         * @brief Helper to reset the jitter buffer.
+         * @note This does not reset the loss, late and reorder counters.
+         */
+        void reset();
+
+        /**
+         * @brief Flag indicating the jitter buffer has no held frames.
+         * @returns bool True, if the jitter buffer is empty, otherwise false.
+         */
+        bool isEmpty() const { return m_count == 0U && !m_hasEndFrame; }
+        /**
+         * @brief Flag indicating the end of call frame for the stream was released.
+         * @returns bool True, if the stream has ended, otherwise false.
+         */
+        bool isEnded() const { return m_ended; }
+
+        /**
+         * @brief Gets the time (ms) the last frame was added to the jitter buffer.
+         * @returns uint64_t Time (ms) the last frame was added.
+         */
+        uint64_t lastRxTime() const { return m_lastRxTime; }
+        /**
+         * @brief Gets the current depth of the jitter buffer.
+         * @returns uint32_t Current depth.
+         */
+        uint32_t depth() const { return m_depth; }
+        /**
+         * @brief Gets the count of frames that were never received.
+         * @returns uint32_t Count of lost frames.
+         */
+        uint32_t lostCnt() const { return m_lostCnt; }
+        /**
+         * @brief Gets the count of frames that were received after their sequence was released.
+         * @returns uint32_t Count of late frames.
+         */
+        uint32_t lateCnt() const { return m_lateCnt; }
+        /**
+         * @brief Gets the count of frames that were received out-of-order and reordered.
+         * @returns uint32_t Count of reordered frames.
+         */
+        uint32_t reorderCnt() const { return m_reorderCnt; }
+
+    private:
+        /**
+         * @brief Represents a held frame.
+         */
+        struct Slot {
+            UInt8Array data;                //! Frame data
+            uint32_t length;                //! Length of frame data
+            uint16_t seq;                   //! RTP Sequence
+            uint64_t rxTime;                //! Time (ms) the frame was received
+            bool valid;                     //! Flag indicating the slot holds a frame
+        };
+
+        uint32_t m_minDepth;
+        uint32_t m_maxDepth;
+        uint32_t m_maxWait;
+        uint32_t m_depth;
+
+        Slot m_slots[JITTER_BUFFER_MAX_DEPTH];
+        uint32_t m_count;
+
+        UInt8Array m_endFrame;
+        uint32_t m_endFrameLength;
+        bool m_hasEndFrame;
+
+        uint16_t m_nextSeq;
+        bool m_started;
+        bool m_ended;
+
+        uint64_t m_lastRxTime;
+        uint32_t m_inOrderCnt;
+
+        uint32_t m_lostCnt;
+        uint32_t m_lateCnt;
+        uint32_t m_reorderCnt;
+
+        /**
+         * @brief Helper to determine the distance from the next expected sequence to the given sequence.
+         * @param seq RTP sequence.
+         * @returns int32_t Distance from the next expected sequence (negative values are sequences already released).
+         */
+        int32_t distance(uint16_t seq) const;
+        /**
+         * @brief Helper to get the held frame with the nearest sequence to the next expected sequence.
+         * @returns Slot* Held frame, or nullptr if no frames are held.
+         */
+        Slot* nearest();
+        /**
+         * @brief Helper to release a held frame.
+         * @param slot Held frame.
+         * @param[out] data Frame data.
+         * @param[out] length Length of the frame.
+         */
+        void release(Slot* slot, UInt8Array& data, uint32_t& length);
+    };
+} // namespace network
+
+#endif // __RTP_JITTER_BUFFER_H__
@@ -17,14 +17,28 @@
 using namespace network;
 
 #include <cassert>
+#include <chrono>
 #include <cstring>
 
 // ---------------------------------------------------------------------------
-//  Static Class Members
+//  Global Functions
 // ---------------------------------------------------------------------------
 
-std::mutex RawFrameQueue::m_queueMutex;
-bool RawFrameQueue::m_queueFlushing = false;
+/* Helper to get the current monotonic time in microseconds. */
+
+static uint64_t now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to raise an atomic high-water mark to the given sample. */
+
+template<typename T>
+static void atomicMax(std::atomic<T>& value, T sample)
+{
+    T curr = value.load(std::memory_order_relaxed);
+    while (sample > curr && !value.compare_exchange_weak(curr, sample, std::memory_order_relaxed));
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -34,18 +48,46 @@ bool RawFrameQueue::m_queueFlushing = false;
 
 RawFrameQueue::RawFrameQueue(udp::Socket* socket, bool debug) :
     m_socket(socket),
-    m_buffers(),
+    m_pool(),
+    m_txQueue(TX_QUEUE_LENGTH),
+    m_txDepth(0),
+    m_flushMutex(),
+    m_txBatch(),
+    m_writer(),
+    m_writerName(),
+    m_writerRunning(false),
+    m_writerSignalled(false),
+    m_writerSleeping(false),
+    m_writerMutex(),
+    m_writerCond(),
+    m_writerLatency(DEFAULT_TX_WRITER_LATENCY),
+    m_maxTxDepth(0U),
+    m_txEnqueued(0U),
+    m_txDropped(0U),
+    m_txWritten(0U),
+    m_txFlushes(0U),
+    m_writerWakeups(0U),
+    m_txTotalLatency(0U),
+    m_txMaxLatency(0U),
+    m_txQueueLatency(nullptr),
+    m_txWriteLatency(nullptr),
+    m_rxSlab(nullptr),
+    m_rxDatagrams(nullptr),
+    m_rxBuffers(),
+    m_rxBatchCount(0U),
     m_failedReadCnt(0U),
     m_debug(debug)
 {
-    /* stub */
+    m_txBatch.reserve(MAX_TX_BATCH_COUNT);
 }
 
 /* Finalizes a instance of the RawFrameQueue class. */
 
 RawFrameQueue::~RawFrameQueue()
 {
+    stopWriter();
     deleteBuffers();
+    deleteRxSlab();
 }
 
 /* Read message from the received UDP packet. */
@@ -86,6 +128,53 @@ UInt8Array RawFrameQueue::read(int& messageLength, sockaddr_storage& address, ui
     return nullptr;
 }
 
+/* Read a batch of UDP packets into the receive slab. */
+
+int RawFrameQueue::readBatch(udp::BufferVector& datagrams)
+{
+    datagrams.clear();
+
+    if (m_rxSlab == nullptr) {
+        setRxBatchCount(m_rxBatchCount);
+    }
+
+    // reset the slab datagrams to their full length
+    for (uint32_t i = 0U; i < m_rxBatchCount; i++) {
+        m_rxDatagrams[i].length = DATA_PACKET_LENGTH;
+        m_rxDatagrams[i].addrLen = 0U;
+    }
+
+    // read messages from socket
+    int count = m_socket->read(m_rxBuffers);
+    if (count < 0) {
+        if (m_failedReadCnt <= MAX_FAILED_READ_CNT_LOGGING)
+            LogError(LOG_NET, "Failed reading data from the network, failedCnt = %u", m_failedReadCnt);
+        else {
+            if (m_failedReadCnt == MAX_FAILED_READ_CNT_LOGGING + 1U)
+                LogError(LOG_NET, "Failed reading data from the network -- exceeded 5 read errors, probable connection issue, silencing further errors");
+        }
+        m_failedReadCnt++;
+        return -1;
+    }
+
+    if (count > 0) {
+        m_failedReadCnt = 0U;
+
+        for (int i = 0; i < count; i++) {
+            udp::UDPDatagram* datagram = m_rxBuffers[i];
+            if (datagram->length == 0U)
+                continue; // discarded datagram
+
+            if (m_debug)
+                Utils::dump(1U, "Network Packet", datagram->buffer, datagram->length);
+
+            datagrams.push_back(datagram);
+        }
+    }
+
+    return (int)datagrams.size();
+}
+
 /* Write message to the UDP socket. */
 
 bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_storage& addr, uint32_t addrLen, ssize_t* lenWritten)
@@ -99,12 +188,8 @@ bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_stor
         return false;
     }
 
-    uint8_t* buffer = new uint8_t[length];
-    ::memset(buffer, 0x00U, length);
-    ::memcpy(buffer, message, length);
-
     if (m_debug)
-        Utils::dump(1U, "RawFrameQueue::write() Message", buffer, length);
+        Utils::dump(1U, "RawFrameQueue::write() Message", message, length);
 
     // bryanb: this is really a developer warning not a end-user warning, there's nothing the end-users can do about
     //  this message
@@ -113,12 +198,11 @@ bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_stor
     }
 
     bool ret = true;
-    if (!m_socket->write(buffer, length, addr, addrLen, lenWritten)) {
+    if (!m_socket->write(message, length, addr, addrLen, lenWritten)) {
         // LogError(LOG_NET, "Failed writing data to the network");
         ret = false;
     }
 
-    delete[] buffer;
     return ret;
 }
 
@@ -135,86 +219,341 @@ void RawFrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, sock
         return;
     }
 
-    // if the queue is flushing -- don't attempt to enqueue any messages
-    if (m_queueFlushing) {
-        LogWarning(LOG_NET, "RawFrameQueue::enqueueMessage() -- queue is flushing, waiting to enqueue message");
-        while (m_queueFlushing)
-            Thread::sleep(2U);
-    }
-
     // bryanb: this is really a developer warning not a end-user warning, there's nothing the end-users can do about
     //  this message
     if (length > (DATA_PACKET_LENGTH - OVERSIZED_PACKET_WARN)) {
         LogDebug(LOG_NET, "RawFrameQueue::enqueueMessage(), WARN: packet length is possibly oversized, possible data truncation - BUGBUG");
     }
 
-    uint8_t* buffer = new uint8_t[length];
-    ::memset(buffer, 0x00U, length);
-    ::memcpy(buffer, message, length);
-
-    if (m_debug)
-        Utils::dump(1U, "RawFrameQueue::enqueueMessage() Buffered Message", buffer, length);
-
-    udp::UDPDatagram* dgram = new udp::UDPDatagram;
-    dgram->buffer = buffer;
-    dgram->length = length;
+    udp::UDPDatagram* dgram = m_pool.acquire(length);
+    ::memcpy(dgram->buffer, message, length);
     dgram->address = addr;
     dgram->addrLen = addrLen;
 
-    m_buffers.push_back(dgram);
+    if (m_debug)
+        Utils::dump(1U, "RawFrameQueue::enqueueMessage() Buffered Message", dgram->buffer, length);
+
+    enqueueDatagram(dgram);
 }
 
 /* Flush the message queue. */
 
 bool RawFrameQueue::flushQueue()
 {
-    bool ret = true;
-    std::lock_guard<std::mutex> lock(m_queueMutex);
-    m_queueFlushing = true;
+    // if the writer thread is running, just wake it up
+    if (m_writerRunning) {
+        if (m_txDepth.load() > 0) {
+            m_writerSignalled = true;
+            if (m_writerSleeping) {
+                std::lock_guard<std::mutex> lock(m_writerMutex);
+                m_writerCond.notify_one();
+            }
+            else {
+                m_writerCond.notify_one();
+            }
+        }
+        return true;
+    }
 
-    if (m_buffers.empty()) {
-        return false;
+    return flushPending();
+}
+
+/* Starts a dedicated writer thread that flushes the message queue. */
+
+bool RawFrameQueue::startWriter(const std::string& name, uint32_t latency)
+{
+    if (m_writerRunning) {
+        return true;
     }
 
-    // bryanb: this is the same as above -- but for some assinine reason prevents
-    // weirdness
-    if (m_buffers.size() == 0U) {
+    if (latency == 0U) {
+        latency = DEFAULT_TX_WRITER_LATENCY;
+    }
+
+    m_writerName = name;
+    m_writerLatency = latency;
+    m_writerSignalled = false;
+    m_writerRunning = true;
+
+    if (!Thread::runAsThread(this, writer, &m_writer)) {
+        m_writerRunning = false;
         return false;
     }
 
-    // LogDebug(LOG_NET, "m_buffers len = %u", m_buffers.size());
+    return true;
+}
+
+/* Stops the writer thread, flushing any remaining queued messages. */
 
-    ret = true;
-    if (!m_socket->write(m_buffers)) {
-        // LogError(LOG_NET, "Failed writing data to the network");
-        ret = false;
+void RawFrameQueue::stopWriter()
+{
+    if (!m_writerRunning) {
+        return;
     }
 
-    deleteBuffers();
-    m_queueFlushing = false;
-    return ret;
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerRunning = false;
+    }
+    m_writerCond.notify_all();
+
+#if defined(_WIN32)
+    ::WaitForSingleObject(m_writer.thread, INFINITE);
+    ::CloseHandle(m_writer.thread);
+#else
+    ::pthread_join(m_writer.thread, NULL);
+#endif // defined(_WIN32)
+
+    flushPending();
+}
+
+/* Gets the outbound queue statistics of the frame queue. */
+
+RawFrameQueueStats RawFrameQueue::stats() const
+{
+    RawFrameQueueStats stats;
+    int32_t depth = m_txDepth.load();
+    stats.queueDepth = (depth > 0) ? (uint32_t)depth : 0U;
+    stats.maxQueueDepth = m_maxTxDepth.load();
+    stats.enqueued = m_txEnqueued.load();
+    stats.dropped = m_txDropped.load();
+    stats.written = m_txWritten.load();
+    stats.flushes = m_txFlushes.load();
+    stats.writerWakeups = m_writerWakeups.load();
+    stats.avgLatency = (stats.written > 0U) ? m_txTotalLatency.load() / stats.written : 0U;
+    stats.maxLatency = m_txMaxLatency.load();
+
+    return stats;
+}
+
+/* Resets the outbound queue statistics of the frame queue. */
+
+void RawFrameQueue::resetStats()
+{
+    m_maxTxDepth = 0U;
+    m_txEnqueued = 0U;
+    m_txDropped = 0U;
+    m_txWritten = 0U;
+    m_txFlushes = 0U;
+    m_writerWakeups = 0U;
+    m_txTotalLatency = 0U;
+    m_txMaxLatency = 0U;
+}
+
+/* Sets the histograms the outbound queue records its latency samples into. */
+
+void RawFrameQueue::setLatencyHistograms(LatencyHistogram* queueLatency, LatencyHistogram* writeLatency)
+{
+    m_txQueueLatency = queueLatency;
+    m_txWriteLatency = writeLatency;
+}
+
+/* Sets the maximum number of UDP packets read per batched read. */
+
+void RawFrameQueue::setRxBatchCount(uint32_t count)
+{
+    if (count == 0U)
+        count = 1U;
+    if (count > MAX_RX_BATCH_COUNT)
+        count = MAX_RX_BATCH_COUNT;
+
+    deleteRxSlab();
+
+    // allocate a single slab for all the receive buffers
+    m_rxBatchCount = count;
+    m_rxSlab = new uint8_t[m_rxBatchCount * DATA_PACKET_LENGTH];
+    m_rxDatagrams = new udp::UDPDatagram[m_rxBatchCount];
+    ::memset(m_rxDatagrams, 0x00U, sizeof(udp::UDPDatagram) * m_rxBatchCount);
+
+    m_rxBuffers.reserve(m_rxBatchCount);
+    for (uint32_t i = 0U; i < m_rxBatchCount; i++) {
+        m_rxDatagrams[i].buffer = m_rxSlab + (i * DATA_PACKET_LENGTH);
+        m_rxDatagrams[i].length = DATA_PACKET_LENGTH;
+        m_rxBuffers.push_back(&m_rxDatagrams[i]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Protected Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to queue a datagram for transmission. */
+
+void RawFrameQueue::enqueueDatagram(udp::UDPDatagram* datagram)
+{
+    TxEntry entry;
+    entry.datagram = datagram;
+    entry.enqueueTime = now();
+
+    int32_t depth = ++m_txDepth;
+    if (!m_txQueue.push(entry)) {
+        // the queue is full, flush it from this thread and try again
+        m_txDepth--;
+        flushPending();
+
+        depth = ++m_txDepth;
+        if (!m_txQueue.push(entry)) {
+            m_txDepth--;
+            m_txDropped++;
+            LogError(LOG_NET, "RawFrameQueue::enqueueDatagram(), outbound queue is full, dropping message");
+            m_pool.release(datagram);
+            return;
+        }
+    }
+
+    atomicMax(m_maxTxDepth, (depth > 0) ? (uint32_t)depth : 0U);
+    m_txEnqueued++;
+
+    // the writer thread sleeps without a timeout while nothing is queued, wake it so the datagram is written
+    // within the latency interval even if nothing flushes the queue
+    if (m_writerRunning)
+        wakeWriter();
+}
+
+/* Helper to wake the writer thread, if it is sleeping with nothing queued. */
+
+void RawFrameQueue::wakeWriter()
+{
+    // the writer publishes that it is going to sleep before it checks the queue depth, and the depth is
+    // published before this checks if the writer is sleeping; either the writer sees the queued datagram, or
+    // this sees the writer sleeping (and the mutex orders the notify after the writer started waiting)
+    if (m_writerSleeping) {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerCond.notify_one();
+    }
 }
 
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* Helper to ensure buffers are deleted. */
+/* Helper to write all queued datagrams to the socket. */
+
+bool RawFrameQueue::flushPending()
+{
+    std::lock_guard<std::mutex> lock(m_flushMutex);
+
+    bool ret = true;
+    bool written = false;
+    for (;;) {
+        // dequeue up to a batch worth of datagrams
+        uint64_t t = now();
+        TxEntry entry;
+        while (m_txBatch.size() < MAX_TX_BATCH_COUNT && m_txQueue.pop(entry)) {
+            m_txDepth--;
+
+            uint64_t latency = (t > entry.enqueueTime) ? t - entry.enqueueTime : 0U;
+            m_txTotalLatency += latency;
+            atomicMax(m_txMaxLatency, latency);
+            if (m_txQueueLatency != nullptr)
+                m_txQueueLatency->record(latency);
+
+            m_txBatch.push_back(entry.datagram);
+        }
+
+        if (m_txBatch.empty()) {
+            break;
+        }
+
+        // LogDebug(LOG_NET, "m_txBatch len = %u", m_txBatch.size());
+
+        uint64_t writeStart = now();
+        if (!m_socket->write(m_txBatch)) {
+            // LogError(LOG_NET, "Failed writing data to the network");
+            ret = false;
+        }
+
+        if (m_txWriteLatency != nullptr)
+            m_txWriteLatency->recordSince(writeStart);
+
+        m_txWritten += m_txBatch.size();
+        m_pool.release(m_txBatch);
+        written = true;
+    }
+
+    if (!written) {
+        return false;
+    }
+
+    m_txFlushes++;
+    return ret;
+}
+
+/* Helper to ensure queued datagrams are released back to the datagram pool. */
 
 void RawFrameQueue::deleteBuffers()
 {
-    for (auto& buffer : m_buffers) {
-        if (buffer != nullptr) {
-            // LogDebug(LOG_NET, "deleting buffer, addr %p len %u", buffer->buffer, buffer->length);
-            if (buffer->buffer != nullptr) {
-                delete[] buffer->buffer;
-                buffer->length = 0;
-                buffer->buffer = nullptr;
-            }
+    std::lock_guard<std::mutex> lock(m_flushMutex);
+
+    TxEntry entry;
+    while (m_txQueue.pop(entry)) {
+        m_txDepth--;
+        m_pool.release(entry.datagram);
+    }
+
+    m_pool.release(m_txBatch);
+}
+
+/* Helper to ensure the receive slab is deleted. */
+
+void RawFrameQueue::deleteRxSlab()
+{
+    m_rxBuffers.clear();
+
+    if (m_rxDatagrams != nullptr) {
+        delete[] m_rxDatagrams;
+        m_rxDatagrams = nullptr;
+    }
+
+    if (m_rxSlab != nullptr) {
+        delete[] m_rxSlab;
+        m_rxSlab = nullptr;
+    }
+}
+
+/* Entry point to the writer thread. */
+
+void* RawFrameQueue::writer(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th == nullptr) {
+        return nullptr;
+    }
 
-            delete buffer;
-            buffer = nullptr;
+    RawFrameQueue* queue = static_cast<RawFrameQueue*>(th->obj);
+    if (queue == nullptr) {
+        return nullptr;
+    }
+
+#ifdef _GNU_SOURCE
+    std::string threadName = queue->m_writerName + ":writer";
+    ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+    while (queue->m_writerRunning) {
+        // scope is intentional
+        {
+            std::unique_lock<std::mutex> lock(queue->m_writerMutex);
+            if (queue->m_txDepth.load() > 0) {
+                // datagrams are queued without a flush, hold them at most the latency interval
+                queue->m_writerCond.wait_for(lock, std::chrono::microseconds(queue->m_writerLatency), 
+                    [=] { return !queue->m_writerRunning || queue->m_writerSignalled; });
+            }
+            else {
+                // nothing is queued, sleep until a datagram is queued (or the writer is stopped)
+                queue->m_writerSleeping = true;
+                queue->m_writerCond.wait(lock, 
+                    [=] { return !queue->m_writerRunning || queue->m_writerSignalled || queue->m_txDepth.load() > 0; });
+                queue->m_writerSleeping = false;
+            }
+            queue->m_writerSignalled = false;
         }
+
+        queue->m_writerWakeups++;
+
+        queue->flushPending();
     }
-    m_buffers.clear();
+
+    return nullptr;
 }
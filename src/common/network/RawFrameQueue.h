@@ -17,9 +17,15 @@
 #define __RAW_FRAME_QUEUE_H__
 
 #include "common/Defines.h"
+#include "common/concurrent/mpmc_queue.h"
+#include "common/LatencyHistogram.h"
+#include "common/network/udp/DatagramPool.h"
 #include "common/network/udp/Socket.h"
+#include "common/Thread.h"
 #include "common/Utils.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
 
 namespace network
@@ -31,6 +37,30 @@ namespace network
     const uint32_t DATA_PACKET_LENGTH = 8192U;
     const uint32_t OVERSIZED_PACKET_WARN = 1536U;
     const uint8_t MAX_FAILED_READ_CNT_LOGGING = 5U;
+    const uint32_t MAX_RX_BATCH_COUNT = 256U;
+    const uint32_t TX_QUEUE_LENGTH = 8192U;
+    const uint32_t MAX_TX_BATCH_COUNT = 1024U;
+    const uint32_t DEFAULT_TX_WRITER_LATENCY = 1000U;
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the outbound queue statistics of a frame queue.
+     * @ingroup network_core
+     */
+    struct RawFrameQueueStats {
+        uint32_t queueDepth;                //! Current number of queued datagrams.
+        uint32_t maxQueueDepth;             //! Maximum number of queued datagrams.
+        uint64_t enqueued;                  //! Total number of datagrams enqueued.
+        uint64_t dropped;                   //! Total number of datagrams that failed to enqueue.
+        uint64_t written;                   //! Total number of datagrams written to the socket.
+        uint64_t flushes;                   //! Total number of flushes that wrote datagrams.
+        uint64_t writerWakeups;             //! Total number of times the writer thread woke up.
+        uint64_t avgLatency;                //! Average time (in microseconds) a datagram waits in the queue.
+        uint64_t maxLatency;                //! Maximum time (in microseconds) a datagram waited in the queue.
+    };
 
     // ---------------------------------------------------------------------------
     //  Class Declaration
@@ -65,6 +95,13 @@ namespace network
          * @return UInt8Array Buffer containing message read.
          */
         UInt8Array read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen);
+        /**
+         * @brief Read a batch of UDP packets into the receive slab.
+         * @note The returned datagrams point into the receive slab, and are only valid until the next batched read.
+         * @param[out] datagrams Vector of datagrams read.
+         * @returns int Number of datagrams read, or -1 on error.
+         */
+        int readBatch(udp::BufferVector& datagrams);
         /**
          * @brief Write message to the UDP socket.
          * @param[in] message Message buffer to frame and queue.
@@ -87,27 +124,141 @@ namespace network
 
         /**
          * @brief Flush the message queue.
+         * @note If the writer thread is running, this only wakes the writer thread and does not wait for the
+         *  queued messages to be written.
+         * @returns bool True, if queued messages were written (or the writer thread was woken), otherwise false.
          */
         bool flushQueue();
 
+        /**
+         * @brief Starts a dedicated writer thread that flushes the message queue.
+         * @note The writer thread flushes the message queue whenever flushQueue() is called, and messages queued
+         *  without a flush are never held longer than the latency interval. The writer thread sleeps without a
+         *  timeout while nothing is queued.
+         * @param name Name of the writer thread.
+         * @param latency Maximum time (in microseconds) a queued message waits before being written.
+         * @returns bool True, if the writer thread was started, otherwise false.
+         */
+        bool startWriter(const std::string& name, uint32_t latency = DEFAULT_TX_WRITER_LATENCY);
+        /**
+         * @brief Stops the writer thread, flushing any remaining queued messages.
+         */
+        void stopWriter();
+        /**
+         * @brief Gets a flag indicating whether the writer thread is running.
+         * @returns bool True, if the writer thread is running, otherwise false.
+         */
+        bool isWriterRunning() const { return m_writerRunning.load(); }
+
+        /**
+         * @brief Gets the outbound queue statistics of the frame queue.
+         * @returns RawFrameQueueStats Outbound queue statistics.
+         */
+        RawFrameQueueStats stats() const;
+        /**
+         * @brief Resets the outbound queue statistics of the frame queue.
+         */
+        void resetStats();
+        /**
+         * @brief Sets the histograms the outbound queue records its latency samples into.
+         * @param queueLatency Histogram of the time (in microseconds) datagrams wait in the queue (or nullptr).
+         * @param writeLatency Histogram of the time (in microseconds) taken to write each batch of datagrams
+         *  to the socket (or nullptr).
+         */
+        void setLatencyHistograms(LatencyHistogram* queueLatency, LatencyHistogram* writeLatency);
+
+        /**
+         * @brief Sets the maximum number of UDP packets read per batched read.
+         * @param count Maximum number of UDP packets read per batched read.
+         */
+        void setRxBatchCount(uint32_t count);
+        /**
+         * @brief Gets the maximum number of UDP packets read per batched read.
+         * @returns uint32_t Maximum number of UDP packets read per batched read.
+         */
+        uint32_t getRxBatchCount() const { return m_rxBatchCount; }
+
     protected:
         sockaddr_storage m_addr;
         uint32_t m_addrLen;
         udp::Socket* m_socket;
 
-        static std::mutex m_queueMutex;
-        static bool m_queueFlushing;
-        udp::BufferVector m_buffers;
+        udp::DatagramPool m_pool;
+
+        /**
+         * @brief Represents a queued outbound datagram.
+         */
+        struct TxEntry {
+            udp::UDPDatagram* datagram;
+            uint64_t enqueueTime;
+        };
+        concurrent::mpmc_queue<TxEntry> m_txQueue;
+        std::atomic<int32_t> m_txDepth;
+        std::mutex m_flushMutex;
+        udp::BufferVector m_txBatch;
+
+        thread_t m_writer;
+        std::string m_writerName;
+        std::atomic<bool> m_writerRunning;
+        std::atomic<bool> m_writerSignalled;
+        std::atomic<bool> m_writerSleeping;
+        std::mutex m_writerMutex;
+        std::condition_variable m_writerCond;
+        uint32_t m_writerLatency;
+
+        std::atomic<uint32_t> m_maxTxDepth;
+        std::atomic<uint64_t> m_txEnqueued;
+        std::atomic<uint64_t> m_txDropped;
+        std::atomic<uint64_t> m_txWritten;
+        std::atomic<uint64_t> m_txFlushes;
+        std::atomic<uint64_t> m_writerWakeups;
+        std::atomic<uint64_t> m_txTotalLatency;
+        std::atomic<uint64_t> m_txMaxLatency;
+        LatencyHistogram* m_txQueueLatency;
+        LatencyHistogram* m_txWriteLatency;
+
+        uint8_t* m_rxSlab;
+        udp::UDPDatagram* m_rxDatagrams;
+        udp::BufferVector m_rxBuffers;
+        uint32_t m_rxBatchCount;
 
         uint32_t m_failedReadCnt;
 
         bool m_debug;
 
+        /**
+         * @brief Helper to queue a datagram for transmission.
+         * @note This never blocks waiting on a flush; if the queue is full, the queue is flushed by the calling
+         *  thread.
+         * @param datagram Datagram to queue (acquired from the datagram pool).
+         */
+        void enqueueDatagram(udp::UDPDatagram* datagram);
+
     private:
         /**
-         * @brief Helper to ensure buffers are deleted.
+         * @brief Helper to wake the writer thread, if it is sleeping with nothing queued.
+         */
+        void wakeWriter();
+        /**
+         * @brief Helper to write all queued datagrams to the socket.
+         * @returns bool True, if queued datagrams were written, otherwise false.
+         */
+        bool flushPending();
+        /**
+         * @brief Helper to ensure queued datagrams are released back to the datagram pool.
          */
         void deleteBuffers();
+        /**
+         * @brief Helper to ensure the receive slab is deleted.
+         */
+        void deleteRxSlab();
+
+        /**
+         * @brief Entry point to the writer thread.
+         * @param arg Instance of the thread_t structure.
+         * @returns void* (Ignore)
+         */
+        static void* writer(void* arg);
     };
 } // namespace network
 
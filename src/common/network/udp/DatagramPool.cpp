@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/udp/DatagramPool.h"
+
+using namespace network::udp;
+
+#include <cstring>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the DatagramPool class. */
+
+DatagramPool::DatagramPool() :
+    m_free(DATAGRAM_POOL_SLAB_SLOTS * DATAGRAM_POOL_MAX_SLABS),
+    m_freeCount(0U),
+    m_slabMutex(),
+    m_slabs(),
+    m_slabCount(0U),
+    m_overflowCount(0U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the DatagramPool class. */
+
+DatagramPool::~DatagramPool()
+{
+    std::lock_guard<std::mutex> lock(m_slabMutex);
+    for (Slot* slab : m_slabs) {
+        delete[] slab;
+    }
+    m_slabs.clear();
+}
+
+/* Acquires a datagram from the pool. */
+
+UDPDatagram* DatagramPool::acquire(uint32_t length)
+{
+    Slot* slot = nullptr;
+    while (!m_free.pop(slot)) {
+        slot = nullptr;
+
+        // a failed pop doesn't mean the pool is empty, a concurrent release may not have published its slot yet
+        if (m_freeCount.load() > 0U) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // the pool is empty, grab a slot from a new slab
+        if (!grow())
+            break;
+    }
+
+    if (slot != nullptr) {
+        m_freeCount--;
+    }
+
+    // a datagram that needs any heap allocation (the slot, or its buffer) counts as a single overflow
+    bool overflow = false;
+
+    // the pool is exhausted, fall back to a heap allocated slot
+    if (slot == nullptr) {
+        slot = new Slot;
+        slot->pooled = false;
+        slot->heapBuffer = nullptr;
+        overflow = true;
+    }
+
+    if (length > DATAGRAM_POOL_SLOT_SIZE) {
+        slot->heapBuffer = new uint8_t[length];
+        slot->datagram.buffer = slot->heapBuffer;
+        overflow = true;
+    }
+    else {
+        slot->datagram.buffer = slot->data;
+    }
+
+    if (overflow) {
+        m_overflowCount++;
+    }
+
+    slot->datagram.length = length;
+    slot->datagram.addrLen = 0U;
+    return &slot->datagram;
+}
+
+/* Releases a datagram back to the pool. */
+
+void DatagramPool::release(UDPDatagram* datagram)
+{
+    if (datagram == nullptr)
+        return;
+
+    Slot* slot = reinterpret_cast<Slot*>(datagram);
+    if (slot->heapBuffer != nullptr) {
+        delete[] slot->heapBuffer;
+        slot->heapBuffer = nullptr;
+    }
+
+    slot->datagram.buffer = nullptr;
+    slot->datagram.length = 0U;
+
+    if (!slot->pooled) {
+        delete slot;
+        return;
+    }
+
+    // the slot is counted before it is pushed, so an acquire never mistakes a slot being released for an empty pool
+    m_freeCount++;
+    push(slot);
+}
+
+/* Releases a vector of datagrams back to the pool, and clears the vector. */
+
+void DatagramPool::release(BufferVector& buffers)
+{
+    for (UDPDatagram* datagram : buffers) {
+        release(datagram);
+    }
+    buffers.clear();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to allocate a new slab of slots. */
+
+bool DatagramPool::grow()
+{
+    std::lock_guard<std::mutex> lock(m_slabMutex);
+
+    // another thread allocated a slab (or released a slot) while waiting for the lock
+    if (m_freeCount.load() > 0U) {
+        return true;
+    }
+
+    if (m_slabs.size() >= DATAGRAM_POOL_MAX_SLABS) {
+        return false;
+    }
+
+    Slot* slab = new Slot[DATAGRAM_POOL_SLAB_SLOTS];
+    for (uint32_t i = 0U; i < DATAGRAM_POOL_SLAB_SLOTS; i++) {
+        ::memset(&slab[i].datagram, 0x00U, sizeof(UDPDatagram));
+        slab[i].heapBuffer = nullptr;
+        slab[i].pooled = true;
+
+        m_freeCount++;
+        push(&slab[i]);
+    }
+
+    m_slabs.push_back(slab);
+    m_slabCount++;
+    return true;
+}
+
+/* Helper to push a slot onto the free list. */
+
+void DatagramPool::push(Slot* slot)
+{
+    // the free list is sized to hold every pooled slot, so it is never full; a push only fails while the
+    // consumer of the cell being reused has claimed it but not yet released it
+    while (!m_free.push(slot)) {
+        std::this_thread::yield();
+    }
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file DatagramPool.h
+ * @ingroup udp_socket
+ * @file DatagramPool.cpp
+ * @ingroup udp_socket
+ */
+#if !defined(__UDP_DATAGRAM_POOL_H__)
+#define __UDP_DATAGRAM_POOL_H__
+
+#include "common/Defines.h"
+#include "common/concurrent/mpmc_queue.h"
+#include "common/network/udp/Socket.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace network
+{
+    namespace udp
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        const uint32_t DATAGRAM_POOL_SLOT_SIZE = 1024U;
+        const uint32_t DATAGRAM_POOL_SLAB_SLOTS = 128U;
+        const uint32_t DATAGRAM_POOL_MAX_SLABS = 64U;
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements a slab backed pool of datagrams, used to queue outbound datagrams without
+         *  allocating memory for each datagram.
+         * @note Datagrams are carved out of slabs of fixed size slots; each slot holds the datagram and
+         *  DATAGRAM_POOL_SLOT_SIZE bytes of buffer storage. Slabs are allocated on demand (up to
+         *  DATAGRAM_POOL_MAX_SLABS) and are retained for the lifetime of the pool. Datagrams larger than a
+         *  slot, or datagrams acquired when the pool is exhausted, fall back to being heap allocated. Acquiring
+         *  and releasing datagrams is lock-free and may be done from any thread.
+         * @ingroup udp_socket
+         */
+        class HOST_SW_API DatagramPool {
+        public:
+            auto operator=(DatagramPool&) -> DatagramPool& = delete;
+            auto operator=(DatagramPool&&) -> DatagramPool& = delete;
+            DatagramPool(DatagramPool&) = delete;
+
+            /**
+             * @brief Initializes a new instance of the DatagramPool class.
+             */
+            DatagramPool();
+            /**
+             * @brief Finalizes a instance of the DatagramPool class.
+             * @note All datagrams acquired from the pool must be released before the pool is destroyed.
+             */
+            ~DatagramPool();
+
+            /**
+             * @brief Acquires a datagram from the pool.
+             * @note The datagram buffer is not cleared, the caller is expected to fill the entire buffer.
+             * @param length Length of the datagram buffer.
+             * @returns UDPDatagram* Datagram, with a buffer of the given length.
+             */
+            UDPDatagram* acquire(uint32_t length);
+            /**
+             * @brief Releases a datagram back to the pool.
+             * @param datagram Datagram to release.
+             */
+            void release(UDPDatagram* datagram);
+            /**
+             * @brief Releases a vector of datagrams back to the pool, and clears the vector.
+             * @param buffers Vector of datagrams to release.
+             */
+            void release(BufferVector& buffers);
+
+            /**
+             * @brief Gets the number of slabs allocated by the pool.
+             * @returns uint32_t Number of slabs allocated by the pool.
+             */
+            uint32_t slabCount() const { return m_slabCount.load(); }
+            /**
+             * @brief Gets the number of datagrams that had to be heap allocated.
+             * @returns uint64_t Number of datagrams that had to be heap allocated.
+             */
+            uint64_t overflowCount() const { return m_overflowCount.load(); }
+
+        private:
+            /**
+             * @brief Represents a single datagram slot.
+             * @note The datagram must be the first member, a released datagram pointer is converted back to
+             *  its slot.
+             */
+            struct Slot {
+                UDPDatagram datagram;
+                uint8_t* heapBuffer;
+                bool pooled;
+                uint8_t data[DATAGRAM_POOL_SLOT_SIZE];
+            };
+
+            concurrent::mpmc_queue<Slot*> m_free;
+            std::atomic<uint32_t> m_freeCount;                  //! Slots released (or being released) to the free list.
+
+            std::mutex m_slabMutex;
+            std::vector<Slot*> m_slabs;
+            std::atomic<uint32_t> m_slabCount;
+
+            std::atomic<uint64_t> m_overflowCount;
+
+            /**
+             * @brief Helper to allocate a new slab of slots.
+             * @returns bool True, if a slab was allocated (or another thread allocated one), otherwise false.
+             */
+            bool grow();
+            /**
+             * @brief Helper to push a slot onto the free list.
+             * @param slot Slot to push.
+             */
+            void push(Slot* slot);
+        };
+    } // namespace udp
+} // namespace network
+
+#endif // __UDP_DATAGRAM_POOL_H__
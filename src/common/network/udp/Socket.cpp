@@ -29,6 +29,7 @@ using namespace network::udp;
 // ---------------------------------------------------------------------------
 
 #define MAX_BUFFER_COUNT 16384
+#define MAX_RECV_BUFFER_COUNT 256
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -45,6 +46,7 @@ Socket::Socket(const std::string& address, uint16_t port) :
 #else
     m_fd(-1),
 #endif // defined(_WIN32)
+    m_reusePort(false),
     m_aes(nullptr),
     m_isCryptoWrapped(false),
     m_presharedKey(nullptr),
@@ -73,6 +75,7 @@ Socket::Socket(uint16_t port) :
 #else
     m_fd(-1),
 #endif // defined(_WIN32)
+    m_reusePort(false),
     m_aes(nullptr),
     m_isCryptoWrapped(false),
     m_presharedKey(nullptr),
@@ -149,6 +152,18 @@ bool Socket::open(const uint32_t af, const std::string& address, const uint16_t
             return false;
         }
 
+        if (m_reusePort) {
+#if defined(SO_REUSEPORT)
+            if (::setsockopt(m_fd, SOL_SOCKET, SO_REUSEPORT, (char*)& reuse, sizeof(reuse)) == -1) {
+                LogError(LOG_NET, "Cannot set the UDP socket reuse port option, err: %d", errno);
+                return false;
+            }
+#else
+            LogError(LOG_NET, "Cannot set the UDP socket reuse port option, not supported on this platform");
+            return false;
+#endif // defined(SO_REUSEPORT)
+        }
+
         if (!bind(address, port)) {
             return false;
         }
@@ -233,55 +248,112 @@ ssize_t Socket::read(uint8_t* buffer, uint32_t length, sockaddr_storage& address
 
     // are we crypto wrapped?
     if (m_isCryptoWrapped) {
-        if (m_presharedKey == nullptr) {
-            LogError(LOG_NET, "tried to read datagram encrypted with no key? this shouldn't happen BUGBUG");
-            return -1;
-        }
+        len = unwrap(buffer, len);
+        if (len <= 0)
+            return len;
+    }
 
-        // does the network packet contain the appropriate magic leader?
-        uint16_t magic = GET_UINT16(buffer, 0U);
-        if (magic == AES_WRAPPED_PCKT_MAGIC) {
-            uint32_t cryptedLen = (len - 2U) * sizeof(uint8_t);
-            uint8_t* cryptoBuffer = buffer + 2U;
+    m_counter++;
+    addrLen = size;
+    return len;
+}
 
-            // do we need to pad the original buffer to be block aligned?
-            if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
-                uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
-                cryptedLen += alignment;
+/* Read a batch of datagrams from the UDP socket. */
 
-                // reallocate buffer and copy
-                cryptoBuffer = new uint8_t[cryptedLen];
-                ::memset(cryptoBuffer, 0x00U, cryptedLen);
-                ::memcpy(cryptoBuffer, buffer + 2U, len - 2U);
-            }
+int Socket::read(BufferVector& buffers) noexcept
+{
+    if (buffers.empty())
+        return 0;
 
-            // Utils::dump(1U, "Socket::read() crypted", cryptoBuffer, cryptedLen);
+#if defined(_WIN32)
+    if (m_fd == INVALID_SOCKET)
+        return -1;
+#else
+    if (m_fd < 0)
+        return -1;
+#endif // defined(_WIN32)
 
-            // decrypt
-            uint8_t* decrypted = m_aes->decryptECB(cryptoBuffer, cryptedLen, m_presharedKey);
+#if defined(HAVE_RECVMMSG)
+    struct mmsghdr headers[MAX_RECV_BUFFER_COUNT];
+    struct iovec chunks[MAX_RECV_BUFFER_COUNT];
+
+    uint32_t count = (uint32_t)buffers.size();
+    if (count > MAX_RECV_BUFFER_COUNT)
+        count = MAX_RECV_BUFFER_COUNT;
+
+    // create mmsghdrs from the input buffers and read them at once
+    ::memset(headers, 0x00U, sizeof(struct mmsghdr) * count);
+    for (uint32_t i = 0U; i < count; i++) {
+        assert(buffers[i] != nullptr);
+        assert(buffers[i]->buffer != nullptr);
+
+        chunks[i].iov_base = buffers[i]->buffer;
+        chunks[i].iov_len = buffers[i]->length;
+
+        headers[i].msg_hdr.msg_name = (void*)&buffers[i]->address;
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        headers[i].msg_hdr.msg_iov = &chunks[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_control = 0;
+        headers[i].msg_hdr.msg_controllen = 0;
+    }
 
-            // Utils::dump(1U, "Socket::read() decrypted", decrypted, cryptedLen);
+    // return immediately
+    int ret = ::recvmmsg(m_fd, headers, count, MSG_DONTWAIT, nullptr);
+    if (ret < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+            return 0;
 
-            // finalize, cleanup buffers and replace with new
-            if (decrypted != nullptr) {
-                ::memset(buffer, 0x00U, len);
-                ::memcpy(buffer, decrypted, len - 2U);
+        LogError(LOG_NET, "Error returned from recvmmsg, err: %d", errno);
 
-                delete[] decrypted;
-                len -= 2U;
-            } else {
-                delete[] decrypted;
-                return 0;
-            }
+        if (errno == ENOTSOCK) {
+            LogMessage(LOG_NET, "Re-opening UDP port on %u", m_localPort);
+            close();
+            open();
         }
-        else {
-            return 0; // this will effectively discard packets without the packet magic
+
+        return -1;
+    }
+
+    for (int i = 0; i < ret; i++) {
+        ssize_t len = headers[i].msg_len;
+        buffers[i]->addrLen = headers[i].msg_hdr.msg_namelen;
+
+        // are we crypto wrapped?
+        if (m_isCryptoWrapped && len > 0) {
+            len = unwrap(buffers[i]->buffer, len);
+            if (len < 0)
+                len = 0;
         }
+
+        buffers[i]->length = (size_t)len;
     }
 
-    m_counter++;
-    addrLen = size;
-    return len;
+    m_counter += ret;
+    return ret;
+#else
+    // no recvmmsg() available -- fall back to reading the datagrams one at a time
+    int count = 0;
+    for (UDPDatagram* datagram : buffers) {
+        assert(datagram != nullptr);
+        assert(datagram->buffer != nullptr);
+
+        ssize_t len = read(datagram->buffer, (uint32_t)datagram->length, datagram->address, datagram->addrLen);
+        if (len < 0) {
+            if (count == 0)
+                return -1;
+            break;
+        }
+
+        if (len == 0)
+            break;
+
+        datagram->length = (size_t)len;
+        count++;
+    }
+
+    return count;
+#endif // defined(HAVE_RECVMMSG)
 }
 
 /* Write data to the UDP socket. */
@@ -337,33 +409,29 @@ bool Socket::write(const uint8_t* buffer, uint32_t length, const sockaddr_storag
             ::memcpy(cryptoBuffer, buffer, length);
         }
 
-        // encrypt
-        uint8_t* crypted = m_aes->encryptECB(cryptoBuffer, cryptedLen, m_presharedKey);
+        // encrypt (directly into the wrapped buffer)
+        out = std::unique_ptr<uint8_t[]>(new uint8_t[cryptedLen + 2U]);
+        bool crypted = m_aes->encryptECB(cryptoBuffer, out.get() + 2U, cryptedLen);
 
-        // Utils::dump(1U, "Socket::write() crypted", crypted, cryptedLen);
+        // Utils::dump(1U, "Socket::write() crypted", out.get() + 2U, cryptedLen);
 
-        // finalize, cleanup buffers and replace with new
-        out = std::unique_ptr<uint8_t[]>(new uint8_t[cryptedLen + 2U]);
+        // finalize, cleanup buffers
         delete[] cryptoBuffer;
-        if (crypted != nullptr) {
-            ::memcpy(out.get() + 2U, crypted, cryptedLen);
+        if (crypted) {
             SET_UINT16(AES_WRAPPED_PCKT_MAGIC, out.get(), 0U);
-            delete[] crypted;
             length = cryptedLen + 2U;
         } else {
             if (lenWritten != nullptr) {
                 *lenWritten = -1;
             }
 
-            delete[] crypted;
             return false;
         }
-    } else {
-        out = std::unique_ptr<uint8_t[]>(new uint8_t[length]);
-        ::memcpy(out.get(), buffer, length);
     }
 
-    ssize_t sent = ::sendto(m_fd, (char*)out.get(), length, 0, (sockaddr*)& address, addrLen);
+    // unwrapped datagrams are written straight from the source buffer
+    const uint8_t* data = (out != nullptr) ? out.get() : buffer;
+    ssize_t sent = ::sendto(m_fd, (char*)data, length, 0, (sockaddr*)& address, addrLen);
     if (sent < 0) {
 #if defined(_WIN32)
         LogError(LOG_NET, "Error returned from sendto, err: %lu", ::GetLastError());
@@ -387,6 +455,65 @@ bool Socket::write(const uint8_t* buffer, uint32_t length, const sockaddr_storag
     return result;
 }
 
+/* Write data to the UDP socket, gathered from a header and a payload buffer. */
+
+bool Socket::write(const uint8_t* header, uint32_t headerLen, const uint8_t* buffer, uint32_t length, const sockaddr_storage& address,
+    uint32_t addrLen, ssize_t* lenWritten) noexcept
+{
+    assert(header != nullptr);
+    assert(buffer != nullptr);
+    assert(length > 0U);
+
+#if !defined(_WIN32)
+    // crypto wrapped datagrams are encrypted as a whole, and must be gathered into a single buffer first
+    if (!m_isCryptoWrapped) {
+        if (m_fd < 0) {
+            if (lenWritten != nullptr) {
+                *lenWritten = -1;
+            }
+
+            return false;
+        }
+
+        struct iovec chunks[2U];
+        chunks[0U].iov_base = (void*)header;
+        chunks[0U].iov_len = headerLen;
+        chunks[1U].iov_base = (void*)buffer;
+        chunks[1U].iov_len = length;
+
+        struct msghdr msg;
+        ::memset(&msg, 0x00U, sizeof(msg));
+        msg.msg_name = (void*)&address;
+        msg.msg_namelen = addrLen;
+        msg.msg_iov = chunks;
+        msg.msg_iovlen = 2U;
+
+        ssize_t sent = ::sendmsg(m_fd, &msg, 0);
+        if (sent < 0) {
+            LogError(LOG_NET, "Error returned from sendmsg, err: %d", errno);
+            if (lenWritten != nullptr) {
+                *lenWritten = -1;
+            }
+
+            return false;
+        }
+
+        if (lenWritten != nullptr) {
+            *lenWritten = sent;
+        }
+
+        return (sent == ssize_t(headerLen + length));
+    }
+#endif // !defined(_WIN32)
+
+    uint32_t bufferLen = headerLen + length;
+    UInt8Array out = std::unique_ptr<uint8_t[]>(new uint8_t[bufferLen]);
+    ::memcpy(out.get(), header, headerLen);
+    ::memcpy(out.get() + headerLen, buffer, length);
+
+    return write(out.get(), bufferLen, address, addrLen, lenWritten);
+}
+
 /* Write data to the UDP socket. */
 
 bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
@@ -450,18 +577,24 @@ bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
     struct mmsghdr headers[MAX_BUFFER_COUNT];
     struct iovec chunks[MAX_BUFFER_COUNT];
 
+    // crypto wrapped datagrams are encrypted into separate buffers, the input buffers are never modified (they
+    // may be owned by a datagram pool)
+    std::vector<UInt8Array> wrapped;
+    if (m_isCryptoWrapped) {
+        wrapped.reserve(buffers.size());
+    }
+
     // create mmsghdrs from input buffers and send them at once
-    int size = buffers.size();
+    int size = 0;
     for (size_t i = 0; i < buffers.size(); ++i) {
         if (buffers[i] == nullptr) {
-            --size;
             continue;
         }
 
         uint32_t length = buffers[i]->length;
-        if (buffers[i]->buffer == nullptr) {
+        uint8_t* data = buffers[i]->buffer;
+        if (data == nullptr) {
             LogError(LOG_NET, "discarding buffered message with len = %u, but deleted buffer?", length);
-            --size;
             continue;
         }
 
@@ -469,63 +602,56 @@ bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
             // are we crypto wrapped?
             if (m_isCryptoWrapped && m_presharedKey != nullptr) {
                 uint32_t cryptedLen = length * sizeof(uint8_t);
-                uint8_t* cryptoBuffer = buffers[i]->buffer;
+                uint8_t* cryptoBuffer = data;
 
                 // do we need to pad the original buffer to be block aligned?
+                bool padded = false;
                 if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
                     uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
                     cryptedLen += alignment;
 
-                    // reallocate buffer and copy
+                    // allocate padded buffer and copy
                     cryptoBuffer = new uint8_t[cryptedLen];
                     ::memset(cryptoBuffer, 0x00U, cryptedLen);
-                    ::memcpy(cryptoBuffer, buffers.at(i)->buffer, length);
+                    ::memcpy(cryptoBuffer, data, length);
+                    padded = true;
                 }
 
-                // encrypt
-                uint8_t* crypted = m_aes->encryptECB(cryptoBuffer, cryptedLen, m_presharedKey);
-                delete[] cryptoBuffer;
+                // encrypt (directly into the wrapped buffer)
+                UInt8Array out = std::unique_ptr<uint8_t[]>(new uint8_t[cryptedLen + 2U]);
+                bool crypted = m_aes->encryptECB(cryptoBuffer, out.get() + 2U, cryptedLen);
+                if (padded) {
+                    delete[] cryptoBuffer;
+                }
 
-                if (crypted == nullptr) {
-                    --size;
+                if (!crypted) {
                     continue;
                 }
 
-                // Utils::dump(1U, "Socket::write() crypted", crypted, cryptedLen);
+                // Utils::dump(1U, "Socket::write() crypted", out.get() + 2U, cryptedLen);
 
                 // finalize
-                DECLARE_UINT8_ARRAY(out, cryptedLen + 2U);
-                ::memcpy(out + 2U, crypted, cryptedLen);
-                SET_UINT16(AES_WRAPPED_PCKT_MAGIC, out, 0U);
-
-                // cleanup buffers and replace with new
-                delete[] crypted;
-                //delete buffers[i]->buffer;
+                SET_UINT16(AES_WRAPPED_PCKT_MAGIC, out.get(), 0U);
 
-                // this should never happen...
-                if (buffers[i] == nullptr) {
-                    --size;
-                    continue;
-                }
-
-                buffers[i]->buffer = new uint8_t[cryptedLen + 2U];
-                ::memcpy(buffers[i]->buffer, out, cryptedLen + 2U);
-                buffers[i]->length = cryptedLen + 2U;
+                data = out.get();
+                length = cryptedLen + 2U;
+                wrapped.push_back(std::move(out));
             }
 
-            chunks[i].iov_len = buffers.at(i)->length;
-            chunks[i].iov_base = buffers.at(i)->buffer;
-            sent += buffers.at(i)->length;
-
-            headers[i].msg_hdr.msg_name = (void*)&buffers.at(i)->address;
-            headers[i].msg_hdr.msg_namelen = buffers.at(i)->addrLen;
-            headers[i].msg_hdr.msg_iov = &chunks[i];
-            headers[i].msg_hdr.msg_iovlen = 1;
-            headers[i].msg_hdr.msg_control = 0;
-            headers[i].msg_hdr.msg_controllen = 0;
+            chunks[size].iov_len = length;
+            chunks[size].iov_base = data;
+            sent += length;
+
+            headers[size].msg_hdr.msg_name = (void*)&buffers.at(i)->address;
+            headers[size].msg_hdr.msg_namelen = buffers.at(i)->addrLen;
+            headers[size].msg_hdr.msg_iov = &chunks[size];
+            headers[size].msg_hdr.msg_iovlen = 1;
+            headers[size].msg_hdr.msg_control = 0;
+            headers[size].msg_hdr.msg_controllen = 0;
+            size++;
         }
         catch (...) {
-            --size;
+            /* stub */
         }
     }
 
@@ -582,6 +708,7 @@ void Socket::setPresharedKey(const uint8_t* presharedKey)
     if (presharedKey != nullptr) {
         ::memset(m_presharedKey, 0x00U, AES_WRAPPED_PCKT_KEY_LEN);
         ::memcpy(m_presharedKey, presharedKey, AES_WRAPPED_PCKT_KEY_LEN);
+        m_aes->setKey(m_presharedKey);
         m_isCryptoWrapped = true;
     } else {
         ::memset(m_presharedKey, 0x00U, AES_WRAPPED_PCKT_KEY_LEN);
@@ -847,4 +974,61 @@ void Socket::initAddr(const std::string& ipAddr, const int port, sockaddr_in& ad
     }
 
     addr.sin_port = htons(port);
-}
\ No newline at end of file
+}
+
+/* Internal helper to unwrap (decrypt) an AES wrapped datagram in place. */
+
+ssize_t Socket::unwrap(uint8_t* buffer, ssize_t len) noexcept
+{
+    if (m_presharedKey == nullptr) {
+        LogError(LOG_NET, "tried to read datagram encrypted with no key? this shouldn't happen BUGBUG");
+        return -1;
+    }
+
+    // does the network packet contain the appropriate magic leader?
+    uint16_t magic = GET_UINT16(buffer, 0U);
+    if (magic == AES_WRAPPED_PCKT_MAGIC) {
+        uint32_t cryptedLen = (len - 2U) * sizeof(uint8_t);
+        uint8_t* cryptoBuffer = buffer + 2U;
+
+        // do we need to pad the original buffer to be block aligned?
+        bool padded = false;
+        if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
+            uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
+            cryptedLen += alignment;
+
+            // reallocate buffer and copy
+            cryptoBuffer = new uint8_t[cryptedLen];
+            ::memset(cryptoBuffer, 0x00U, cryptedLen);
+            ::memcpy(cryptoBuffer, buffer + 2U, len - 2U);
+            padded = true;
+        }
+
+        // Utils::dump(1U, "Socket::unwrap() crypted", cryptoBuffer, cryptedLen);
+
+        // decrypt (in place)
+        bool decrypted = m_aes->decryptECB(cryptoBuffer, cryptoBuffer, cryptedLen);
+
+        // Utils::dump(1U, "Socket::unwrap() decrypted", cryptoBuffer, cryptedLen);
+
+        // finalize, cleanup buffers and move the decrypted datagram to the start of the buffer
+        if (decrypted) {
+            ::memmove(buffer, cryptoBuffer, len - 2U);
+            ::memset(buffer + (len - 2U), 0x00U, 2U);
+            len -= 2U;
+        }
+
+        if (padded) {
+            delete[] cryptoBuffer;
+        }
+
+        if (!decrypted) {
+            return 0;
+        }
+    }
+    else {
+        return 0; // this will effectively discard packets without the packet magic
+    }
+
+    return len;
+}
@@ -227,6 +227,23 @@ namespace network
              */
             void close();
 
+            /**
+             * @brief Sets a flag indicating whether the socket is bound with SO_REUSEPORT.
+             * @note This must be set before the socket is opened. Every socket bound to the same address and port must
+             *  set this flag; on Linux the kernel then distributes received datagrams between the sockets by a hash
+             *  of the source address and port.
+             * @param reusePort Flag indicating whether the socket is bound with SO_REUSEPORT.
+             */
+            void setReusePort(bool reusePort) { m_reusePort = reusePort; }
+
+#if !defined(_WIN32)
+            /**
+             * @brief Gets the UDP socket descriptor.
+             * @returns int Socket descriptor, or -1 if the socket is not open.
+             */
+            int getDescriptor() const { return m_fd; }
+#endif // !defined(_WIN32)
+
             /**
              * @brief Read data from the UDP socket.
              * @param[out] buffer Buffer to read data into.
@@ -236,6 +253,15 @@ namespace network
              * @returns ssize_t Actual length of data read from remote UDP socket.
              */
             virtual ssize_t read(uint8_t* buffer, uint32_t length, sockaddr_storage& address, uint32_t& addrLen) noexcept;
+            /**
+             * @brief Read a batch of datagrams from the UDP socket.
+             * @note Each datagram in the vector must have a pre-allocated buffer, and its length set to the size of
+             *  that buffer. On return, the length of each read datagram is set to the actual length of data read
+             *  (a length of zero indicates a discarded datagram).
+             * @param[in,out] buffers Vector of datagrams to read data into.
+             * @returns int Number of datagrams read from remote UDP socket, or -1 on error.
+             */
+            virtual int read(BufferVector& buffers) noexcept;
             /**
              * @brief Write data to the UDP socket.
              * @param[in] buffer Buffer containing data to write to socket.
@@ -246,6 +272,21 @@ namespace network
              * @returns bool True, if message was sent otherwise, false.
              */
             virtual bool write(const uint8_t* buffer, uint32_t length, const sockaddr_storage& address, uint32_t addrLen, ssize_t* lenWritten = nullptr) noexcept;
+            /**
+             * @brief Write data to the UDP socket, gathered from a header and a payload buffer.
+             * @note The header and payload are written straight from their buffers as a single datagram, without
+             *  being copied (unless the socket is crypto wrapped).
+             * @param[in] header Buffer containing the datagram header to write to socket.
+             * @param headerLen Length of the datagram header.
+             * @param[in] buffer Buffer containing the datagram payload to write to socket.
+             * @param length Length of the datagram payload.
+             * @param address IP address to write data to.
+             * @param addrLen 
+             * @param[out] lenWritten Total number of bytes written.
+             * @returns bool True, if message was sent otherwise, false.
+             */
+            virtual bool write(const uint8_t* header, uint32_t headerLen, const uint8_t* buffer, uint32_t length, const sockaddr_storage& address,
+                uint32_t addrLen, ssize_t* lenWritten = nullptr) noexcept;
             /**
              * @brief Write data to the UDP socket.
              * @param[in] buffers Vector of buffers to write to socket.
@@ -325,6 +366,7 @@ namespace network
 #else
             int m_fd;
 #endif // defined(_WIN32)
+            bool m_reusePort;
 
             crypto::AES* m_aes;
             bool m_isCryptoWrapped;
@@ -355,6 +397,14 @@ namespace network
              * @param[out] addr Instance of sockaddr_storage socket address structure.
              */
             static void initAddr(const std::string& ipAddr, const int port, sockaddr_in& addr);
+
+            /**
+             * @brief Internal helper to unwrap (decrypt) an AES wrapped datagram in place.
+             * @param[in,out] buffer Buffer containing datagram.
+             * @param len Length of datagram.
+             * @returns ssize_t Length of unwrapped datagram, zero if the datagram should be discarded, or -1 on error.
+             */
+            ssize_t unwrap(uint8_t* buffer, ssize_t len) noexcept;
         };
     } // namespace udp
 } // namespace network
@@ -43,6 +43,7 @@ P25Crypto::P25Crypto() :
     m_keystreamPos(0U),
     m_mi(nullptr),
     m_tek(nullptr),
+    m_aes(AESKeyLength::AES_256),
     m_random()
 {
     m_mi = new uint8_t[MI_LENGTH_BYTES];
@@ -137,17 +138,10 @@ void P25Crypto::generateKeystream()
 
             uint8_t* iv = expandMIToIV();
 
-            AES aes = AES(AESKeyLength::AES_256);
-
-            uint8_t input[16U];
-            ::memset(input, 0x00U, 16U);
-            ::memcpy(input, iv, 16U);
-
-            for (uint32_t i = 0U; i < (240U / 16U); i++) {
-                uint8_t* output = aes.encryptECB(input, 16U, m_tek.get());
-                ::memcpy(m_keystream + (i * 16U), output, 16U);
-                ::memcpy(input, output, 16U);
-            }
+            // the keystream is the AES-OFB encryption of a zeroed buffer; the key schedule is only expanded
+            // again when the TEK changes
+            m_aes.setKey(m_tek.get());
+            m_aes.encryptOFB(m_keystream, m_keystream, 240U, iv);
 
             delete[] iv;
         }
@@ -283,9 +277,10 @@ void P25Crypto::setKey(const uint8_t* key, uint8_t len)
     if (m_tek != nullptr)
         m_tek.reset();
 
-    m_tek = std::make_unique<uint8_t[]>(len);
-    ::memset(m_tek.get(), 0x00U, MAX_ENC_KEY_LENGTH_BYTES);
-    ::memset(m_tek.get(), 0x00U, m_tekLength);
+    // the key buffer is always at least the maximum key length, shorter keys are zero padded
+    uint32_t tekBufferLen = (len > MAX_ENC_KEY_LENGTH_BYTES) ? len : MAX_ENC_KEY_LENGTH_BYTES;
+    m_tek = std::make_unique<uint8_t[]>(tekBufferLen);
+    ::memset(m_tek.get(), 0x00U, tekBufferLen);
     ::memcpy(m_tek.get(), key, len);
 }
 
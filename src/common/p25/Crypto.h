@@ -22,6 +22,7 @@
 
 #include "common/Defines.h"
 #include "common/p25/P25Defines.h"
+#include "common/AESCrypto.h"
 #include "common/Utils.h"
 
 #include <random>
@@ -144,6 +145,7 @@ namespace p25
             uint8_t* m_mi;
 
             UInt8Array m_tek;
+            ::crypto::AES m_aes;
 
             std::mt19937 m_random;
 
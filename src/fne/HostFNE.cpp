@@ -157,6 +157,14 @@ int HostFNE::run()
     }
 #endif // !defined(_WIN32)
 
+    // start the log writer thread (this is done after forking, the log writer thread does not survive a fork)
+    if (logConf["asyncLogging"].as<bool>(false)) {
+        if (!::LogStartAsync(logConf["asyncBufferSize"].as<uint32_t>(64U) * 1024U, logConf["asyncDropOnOverflow"].as<bool>(true))) {
+            ::LogError(LOG_HOST, "Failed to start log writer thread, log entries will be written synchronously");
+        }
+    }
+    ::LogSetRateLimit(logConf["rateLimit"].as<uint32_t>(0U));
+
     ::LogInfo(__BANNER__ "\r\n" __PROG_NAME__ " " __VER__ " (built " __BUILD__ ")\r\n" \
         "Copyright (c) 2017-2025 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\r\n" \
         "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\r\n" \
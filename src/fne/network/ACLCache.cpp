@@ -0,0 +1,421 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "common/network/PacketBuffer.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "fne/network/ACLCache.h"
+
+using namespace network;
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t ACL_HASH_SEED = 2166136261U;
+const uint32_t ACL_HASH_PRIME = 16777619U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to hash a 32-bit value into a snapshot version. */
+
+static uint32_t hashValue(uint32_t hash, uint32_t value)
+{
+    uint8_t buffer[4U];
+    SET_UINT32(value, buffer, 0U);
+    return ACLCache::hash(hash, buffer, 4U);
+}
+
+/* Helper to hash a list of 32-bit values into a snapshot version. */
+
+static uint32_t hashList(uint32_t hash, const std::vector<uint32_t>& list)
+{
+    hash = hashValue(hash, (uint32_t)list.size());
+    for (uint32_t value : list)
+        hash = hashValue(hash, value);
+
+    return hash;
+}
+
+/* Helper to determine if a peer is permitted to receive a talkgroup. */
+
+static bool peerPermitted(const ACLTalkgroup& tg, uint32_t peerId)
+{
+    // peer inclusion lists take priority over exclusion lists
+    if (tg.inclusion.size() > 0) {
+        auto it = std::find(tg.inclusion.begin(), tg.inclusion.end(), peerId);
+        return it != tg.inclusion.end();
+    }
+
+    if (tg.exclusion.size() > 0) {
+        auto it = std::find(tg.exclusion.begin(), tg.exclusion.end(), peerId);
+        if (it != tg.exclusion.end())
+            return false;
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the ACLSnapshot class. */
+
+ACLSnapshot::ACLSnapshot(std::vector<uint32_t>&& ridWhitelist, std::vector<uint32_t>&& ridBlacklist,
+    std::vector<ACLTalkgroup>&& talkgroups, bool sendTalkgroups) :
+    m_version(0U),
+    m_ridWhitelist(std::move(ridWhitelist)),
+    m_ridBlacklist(std::move(ridBlacklist)),
+    m_whitelistPayloads(),
+    m_blacklistPayloads(),
+    m_talkgroups(std::move(talkgroups)),
+    m_sendTalkgroups(sendTalkgroups)
+{
+    m_whitelistPayloads = encodeRIDs(m_ridWhitelist);
+    m_blacklistPayloads = encodeRIDs(m_ridBlacklist);
+
+    uint32_t hash = ACL_HASH_SEED;
+    hash = hashList(hash, m_ridWhitelist);
+    hash = hashList(hash, m_ridBlacklist);
+
+    hash = hashValue(hash, (m_sendTalkgroups) ? 1U : 0U);
+    hash = hashValue(hash, (uint32_t)m_talkgroups.size());
+    for (const ACLTalkgroup& tg : m_talkgroups) {
+        hash = hashValue(hash, tg.tgId);
+        hash = hashValue(hash, (tg.slot << 8) | ((tg.active) ? 0x02U : 0x00U) | ((tg.affiliated) ? 0x01U : 0x00U));
+        hash = hashList(hash, tg.inclusion);
+        hash = hashList(hash, tg.exclusion);
+        hash = hashList(hash, tg.preferred);
+    }
+
+    // version 0 is reserved to indicate no version
+    m_version = (hash == 0U) ? 1U : hash;
+}
+
+/* Helper to build the active and deactivated talkgroup lists for a peer. */
+
+void ACLSnapshot::peerTalkgroups(uint32_t peerId, std::vector<std::pair<uint32_t, uint8_t>>& active,
+    std::vector<std::pair<uint32_t, uint8_t>>& deactive) const
+{
+    active.clear();
+    deactive.clear();
+
+    for (const ACLTalkgroup& tg : m_talkgroups) {
+        if (!peerPermitted(tg, peerId))
+            continue;
+
+        if (!tg.active) {
+            deactive.push_back({ tg.tgId, tg.slot });
+            continue;
+        }
+
+        uint8_t slotNo = tg.slot;
+
+        // set the $80 bit of the slot number to flag non-preferred
+        if (tg.preferred.size() > 0) {
+            auto it = std::find(tg.preferred.begin(), tg.preferred.end(), peerId);
+            if (it == tg.preferred.end()) {
+                slotNo |= 0x80U;
+            }
+        }
+
+        // set the $40 bit of the slot number to identify if this TG is by affiliation or not
+        if (tg.affiliated) {
+            slotNo |= 0x40U;
+        }
+
+        active.push_back({ tg.tgId, slotNo });
+    }
+}
+
+/* Helper to encode a list of RIDs into master control message payloads. */
+
+ACLPayloadList ACLSnapshot::encodeRIDs(const std::vector<uint32_t>& rids)
+{
+    ACLPayloadList payloads;
+    for (size_t i = 0U; i < rids.size(); i += MAX_RID_LIST_CHUNK) {
+        size_t listSize = std::min((size_t)MAX_RID_LIST_CHUNK, rids.size() - i);
+
+        std::vector<uint8_t> payload(4U + (listSize * 4U), 0x00U);
+        SET_UINT32((uint32_t)listSize, payload.data(), 0U);
+
+        uint32_t offs = 4U;
+        for (size_t j = 0U; j < listSize; j++) {
+            SET_UINT32(rids[i + j], payload.data(), offs);
+            offs += 4U;
+        }
+
+        payloads.push_back(std::move(payload));
+    }
+
+    return payloads;
+}
+
+/* Helper to encode a list of talkgroups into a master control message payload. */
+
+std::vector<uint8_t> ACLSnapshot::encodeTGIDs(const std::vector<std::pair<uint32_t, uint8_t>>& tgs)
+{
+    std::vector<uint8_t> payload(4U + (tgs.size() * 5U), 0x00U);
+    SET_UINT32((uint32_t)tgs.size(), payload.data(), 0U);
+
+    uint32_t offs = 4U;
+    for (const std::pair<uint32_t, uint8_t>& tg : tgs) {
+        SET_UINT32(tg.first, payload.data(), offs);
+        payload[offs + 4U] = tg.second;
+        offs += 5U;
+    }
+
+    return payload;
+}
+
+/* Initializes a new instance of the ACLCache class. */
+
+ACLCache::ACLCache() :
+    m_mutex(),
+    m_current(nullptr),
+    m_history(),
+    m_deltas(),
+    m_peerLinkMutex(),
+    m_peerLinkFiles(),
+    m_peerLinkStale()
+{
+    for (uint32_t i = 0U; i < PL_FILE_COUNT; i++)
+        m_peerLinkStale[i] = true;
+}
+
+/* Builds a new snapshot from the lookup tables. */
+
+std::shared_ptr<const ACLSnapshot> ACLCache::update(lookups::RadioIdLookup* ridLookup, lookups::TalkgroupRulesLookup* tidLookup)
+{
+    assert(ridLookup != nullptr);
+    assert(tidLookup != nullptr);
+
+    std::vector<uint32_t> ridWhitelist;
+    std::vector<uint32_t> ridBlacklist;
+
+    auto ridLookups = ridLookup->table();
+    for (auto entry : ridLookups) {
+        if (entry.second.radioEnabled())
+            ridWhitelist.push_back(entry.first);
+        else
+            ridBlacklist.push_back(entry.first);
+    }
+
+    std::sort(ridWhitelist.begin(), ridWhitelist.end());
+    std::sort(ridBlacklist.begin(), ridBlacklist.end());
+
+    std::vector<ACLTalkgroup> talkgroups;
+    auto groupVoice = tidLookup->groupVoice();
+    for (auto entry : groupVoice) {
+        ACLTalkgroup tg;
+        tg.tgId = entry.source().tgId();
+        tg.slot = entry.source().tgSlot();
+        tg.active = entry.config().active();
+        tg.affiliated = entry.config().affiliated();
+        tg.inclusion = entry.config().inclusion();
+        tg.exclusion = entry.config().exclusion();
+        tg.preferred = entry.config().preferred();
+
+        talkgroups.push_back(std::move(tg));
+    }
+
+    std::sort(talkgroups.begin(), talkgroups.end(), [](const ACLTalkgroup& a, const ACLTalkgroup& b) {
+        return (a.tgId != b.tgId) ? a.tgId < b.tgId : a.slot < b.slot;
+    });
+
+    std::shared_ptr<const ACLSnapshot> snapshot = std::make_shared<const ACLSnapshot>(std::move(ridWhitelist),
+        std::move(ridBlacklist), std::move(talkgroups), tidLookup->sendTalkgroups());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Peer-Link list files are re-read on the next request after every update
+    {
+        std::lock_guard<std::mutex> plLock(m_peerLinkMutex);
+        for (uint32_t i = 0U; i < PL_FILE_COUNT; i++)
+            m_peerLinkStale[i] = true;
+    }
+
+    if (m_current != nullptr && m_current->version() == snapshot->version()) {
+        return m_current;
+    }
+
+    if (m_current != nullptr) {
+        m_history.push_back(m_current);
+        while (m_history.size() > ACL_SNAPSHOT_HISTORY) {
+            uint32_t version = m_history.front()->version();
+            m_history.pop_front();
+
+            // drop any deltas from the expired version
+            for (auto it = m_deltas.begin(); it != m_deltas.end();) {
+                if ((uint32_t)(it->first >> 32) == version)
+                    it = m_deltas.erase(it);
+                else
+                    ++it;
+            }
+        }
+    }
+
+    LogInfoEx(LOG_NET, "ACL lists updated, version = $%08X, whitelisted RIDs = %u, blacklisted RIDs = %u, talkgroups = %u",
+        snapshot->version(), snapshot->ridWhitelist().size(), snapshot->ridBlacklist().size(), snapshot->talkgroups().size());
+
+    m_current = snapshot;
+    return m_current;
+}
+
+/* Gets the current snapshot. */
+
+std::shared_ptr<const ACLSnapshot> ACLCache::current() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_current;
+}
+
+/* Finds a retained snapshot by version. */
+
+std::shared_ptr<const ACLSnapshot> ACLCache::find(uint32_t version) const
+{
+    if (version == 0U)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_current != nullptr && m_current->version() == version)
+        return m_current;
+
+    for (auto snapshot : m_history) {
+        if (snapshot->version() == version)
+            return snapshot;
+    }
+
+    return nullptr;
+}
+
+/* Gets the RIDs that changed between two snapshots. */
+
+std::shared_ptr<const ACLDelta> ACLCache::delta(const std::shared_ptr<const ACLSnapshot>& from, const std::shared_ptr<const ACLSnapshot>& to)
+{
+    assert(from != nullptr);
+    assert(to != nullptr);
+
+    uint64_t key = ((uint64_t)from->version() << 32) | to->version();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_deltas.find(key);
+        if (it != m_deltas.end())
+            return it->second;
+    }
+
+    std::shared_ptr<ACLDelta> delta = std::make_shared<ACLDelta>();
+    delta->fromVersion = from->version();
+    delta->toVersion = to->version();
+
+    // RIDs removed from the lists entirely are not sent, the same as a full update
+    std::vector<uint32_t> whitelisted;
+    std::set_difference(to->ridWhitelist().begin(), to->ridWhitelist().end(), from->ridWhitelist().begin(), from->ridWhitelist().end(),
+        std::back_inserter(whitelisted));
+    std::vector<uint32_t> blacklisted;
+    std::set_difference(to->ridBlacklist().begin(), to->ridBlacklist().end(), from->ridBlacklist().begin(), from->ridBlacklist().end(),
+        std::back_inserter(blacklisted));
+
+    delta->whitelistPayloads = ACLSnapshot::encodeRIDs(whitelisted);
+    delta->blacklistPayloads = ACLSnapshot::encodeRIDs(blacklisted);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_deltas[key] = delta;
+    return delta;
+}
+
+/* Gets an encoded Peer-Link list file. */
+
+std::shared_ptr<const ACLPeerLinkFile> ACLCache::peerLinkFile(PeerLinkFileType type, const std::string& filename)
+{
+    if (filename.empty()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_peerLinkMutex);
+    if (!m_peerLinkStale[type]) {
+        return m_peerLinkFiles[type];
+    }
+
+    m_peerLinkStale[type] = false;
+
+    // read entire file into string buffer
+    std::stringstream b;
+    std::ifstream stream(filename);
+    if (stream.is_open()) {
+        b << stream.rdbuf();
+        stream.close();
+    }
+
+    std::string content = b.str();
+    if (content.empty()) {
+        m_peerLinkFiles[type] = nullptr;
+        return nullptr;
+    }
+
+    uint32_t version = hash(ACL_HASH_SEED, (const uint8_t*)content.data(), content.size());
+    if (m_peerLinkFiles[type] != nullptr && m_peerLinkFiles[type]->version == version) {
+        return m_peerLinkFiles[type];
+    }
+
+    // convert to a byte array
+    uint32_t len = content.size();
+    DECLARE_UINT8_ARRAY(buffer, len);
+    ::memcpy(buffer, content.data(), len);
+
+    const char* name = "Peer-Link, RID List";
+    switch (type) {
+    case PL_FILE_TGID:
+        name = "Peer-Link, TGID List";
+        break;
+    case PL_FILE_PEER:
+        name = "Peer-Link, PID List";
+        break;
+    default:
+        break;
+    }
+
+    PacketBuffer pkt(true, name);
+    pkt.encode((uint8_t*)buffer, len);
+
+    std::shared_ptr<ACLPeerLinkFile> file = std::make_shared<ACLPeerLinkFile>();
+    file->version = version;
+    file->fragments.resize(pkt.fragments.size());
+    for (auto frag : pkt.fragments) {
+        if (frag.first < file->fragments.size())
+            file->fragments[frag.first].assign(frag.second->data, frag.second->data + FRAG_SIZE);
+    }
+
+    m_peerLinkFiles[type] = file;
+    return m_peerLinkFiles[type];
+}
+
+/* Helper to hash a buffer into a snapshot version. */
+
+uint32_t ACLCache::hash(uint32_t hash, const uint8_t* data, size_t length)
+{
+    // 32-bit FNV-1a
+    for (size_t i = 0U; i < length; i++) {
+        hash ^= data[i];
+        hash *= ACL_HASH_PRIME;
+    }
+
+    return hash;
+}
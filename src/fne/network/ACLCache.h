@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file ACLCache.h
+ * @ingroup fne_network
+ * @file ACLCache.cpp
+ * @ingroup fne_network
+ */
+#if !defined(__ACL_CACHE_H__)
+#define __ACL_CACHE_H__
+
+#include "fne/Defines.h"
+#include "common/lookups/RadioIdLookup.h"
+#include "common/lookups/TalkgroupRulesLookup.h"
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @addtogroup fne_network
+     * @{
+     */
+
+    const uint32_t ACL_SNAPSHOT_HISTORY = 8U;
+    const uint32_t MAX_RID_LIST_CHUNK = 50U;
+
+    /** @} */
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a talkgroup rule, as sent to peers in the ACL lists.
+     * @ingroup fne_network
+     */
+    struct ACLTalkgroup {
+        uint32_t tgId;                      //! Talkgroup ID.
+        uint8_t slot;                       //! DMR slot.
+        bool active;                        //! Flag indicating the talkgroup is active.
+        bool affiliated;                    //! Flag indicating the talkgroup requires affiliation.
+
+        std::vector<uint32_t> inclusion;    //! Peer inclusion list.
+        std::vector<uint32_t> exclusion;    //! Peer exclusion list.
+        std::vector<uint32_t> preferred;    //! Preferred peer list.
+    };
+
+    /**
+     * @brief Encoded list of RIDs or TGIDs, each entry is the payload of a single master control message.
+     * @ingroup fne_network
+     */
+    typedef std::vector<std::vector<uint8_t>> ACLPayloadList;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents an immutable, versioned snapshot of the ACL lists sent to peers.
+     * @note The version of a snapshot is a hash of its contents, identical lists always result in the same
+     *  version, even across FNE restarts. The RID lists are encoded once when the snapshot is created and
+     *  are shared by every peer the snapshot is sent to.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API ACLSnapshot {
+    public:
+        /**
+         * @brief Initializes a new instance of the ACLSnapshot class.
+         * @param ridWhitelist Sorted list of whitelisted RIDs.
+         * @param ridBlacklist Sorted list of blacklisted RIDs.
+         * @param talkgroups Sorted list of talkgroup rules.
+         * @param sendTalkgroups Flag indicating talkgroups are sent to peers.
+         */
+        ACLSnapshot(std::vector<uint32_t>&& ridWhitelist, std::vector<uint32_t>&& ridBlacklist,
+            std::vector<ACLTalkgroup>&& talkgroups, bool sendTalkgroups);
+
+        /**
+         * @brief Gets the version of this snapshot.
+         * @returns uint32_t Version of this snapshot.
+         */
+        uint32_t version() const { return m_version; }
+
+        /**
+         * @brief Gets the sorted list of whitelisted RIDs.
+         * @returns const std::vector<uint32_t>& List of whitelisted RIDs.
+         */
+        const std::vector<uint32_t>& ridWhitelist() const { return m_ridWhitelist; }
+        /**
+         * @brief Gets the sorted list of blacklisted RIDs.
+         * @returns const std::vector<uint32_t>& List of blacklisted RIDs.
+         */
+        const std::vector<uint32_t>& ridBlacklist() const { return m_ridBlacklist; }
+        /**
+         * @brief Gets the encoded whitelisted RIDs.
+         * @returns const ACLPayloadList& Encoded whitelisted RIDs.
+         */
+        const ACLPayloadList& whitelistPayloads() const { return m_whitelistPayloads; }
+        /**
+         * @brief Gets the encoded blacklisted RIDs.
+         * @returns const ACLPayloadList& Encoded blacklisted RIDs.
+         */
+        const ACLPayloadList& blacklistPayloads() const { return m_blacklistPayloads; }
+
+        /**
+         * @brief Gets the sorted list of talkgroup rules.
+         * @returns const std::vector<ACLTalkgroup>& List of talkgroup rules.
+         */
+        const std::vector<ACLTalkgroup>& talkgroups() const { return m_talkgroups; }
+        /**
+         * @brief Flag indicating talkgroups are sent to peers.
+         * @returns bool True, if talkgroups are sent to peers, otherwise false.
+         */
+        bool sendTalkgroups() const { return m_sendTalkgroups; }
+
+        /**
+         * @brief Helper to build the active and deactivated talkgroup lists for a peer.
+         * @param peerId Peer ID.
+         * @param[out] active List of talkgroup IDs and slot flags active for the peer.
+         * @param[out] deactive List of talkgroup IDs and slots deactivated for the peer.
+         */
+        void peerTalkgroups(uint32_t peerId, std::vector<std::pair<uint32_t, uint8_t>>& active,
+            std::vector<std::pair<uint32_t, uint8_t>>& deactive) const;
+
+        /**
+         * @brief Helper to encode a list of RIDs into master control message payloads.
+         * @param rids List of RIDs.
+         * @returns ACLPayloadList Encoded RIDs.
+         */
+        static ACLPayloadList encodeRIDs(const std::vector<uint32_t>& rids);
+        /**
+         * @brief Helper to encode a list of talkgroups into a master control message payload.
+         * @param tgs List of talkgroup IDs and slot flags.
+         * @returns std::vector<uint8_t> Encoded talkgroups.
+         */
+        static std::vector<uint8_t> encodeTGIDs(const std::vector<std::pair<uint32_t, uint8_t>>& tgs);
+
+    private:
+        uint32_t m_version;
+
+        std::vector<uint32_t> m_ridWhitelist;
+        std::vector<uint32_t> m_ridBlacklist;
+        ACLPayloadList m_whitelistPayloads;
+        ACLPayloadList m_blacklistPayloads;
+
+        std::vector<ACLTalkgroup> m_talkgroups;
+        bool m_sendTalkgroups;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the RIDs that changed between two ACL snapshots.
+     * @ingroup fne_network
+     */
+    struct ACLDelta {
+        uint32_t fromVersion;                   //! Version the delta applies to.
+        uint32_t toVersion;                     //! Version the delta results in.
+
+        ACLPayloadList whitelistPayloads;       //! Encoded RIDs whitelisted since the earlier version.
+        ACLPayloadList blacklistPayloads;       //! Encoded RIDs blacklisted since the earlier version.
+    };
+
+    /**
+     * @brief Represents a Peer-Link list file, encoded into packet buffer fragments.
+     * @ingroup fne_network
+     */
+    struct ACLPeerLinkFile {
+        uint32_t version;                       //! Version (hash) of the file contents.
+        std::vector<std::vector<uint8_t>> fragments; //! Encoded file fragments, in block order.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a cache of versioned ACL snapshots, used to send the ACL lists to peers.
+     * @note The current snapshot and a short history of earlier snapshots are retained, a peer that reports
+     *  the version of an earlier snapshot only needs to be sent what changed since that version. Peer-Link
+     *  list files are read and encoded at most once per update, and are only re-encoded when they change.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API ACLCache {
+    public:
+        /**
+         * @brief Peer-Link list files.
+         */
+        enum PeerLinkFileType {
+            PL_FILE_RID = 0,                    //! Radio ID List
+            PL_FILE_TGID,                       //! Talkgroup Rules
+            PL_FILE_PEER,                       //! Peer List
+
+            PL_FILE_COUNT
+        };
+
+        /**
+         * @brief Initializes a new instance of the ACLCache class.
+         */
+        ACLCache();
+
+        /**
+         * @brief Builds a new snapshot from the lookup tables.
+         * @note If the lookup tables have not changed, the current snapshot is kept.
+         * @param ridLookup Instance of the RadioIdLookup class.
+         * @param tidLookup Instance of the TalkgroupRulesLookup class.
+         * @returns std::shared_ptr<const ACLSnapshot> Current snapshot.
+         */
+        std::shared_ptr<const ACLSnapshot> update(lookups::RadioIdLookup* ridLookup, lookups::TalkgroupRulesLookup* tidLookup);
+
+        /**
+         * @brief Gets the current snapshot.
+         * @returns std::shared_ptr<const ACLSnapshot> Current snapshot, or nullptr if no snapshot was built.
+         */
+        std::shared_ptr<const ACLSnapshot> current() const;
+        /**
+         * @brief Finds a retained snapshot by version.
+         * @param version Snapshot version.
+         * @returns std::shared_ptr<const ACLSnapshot> Snapshot, or nullptr if the version is not retained.
+         */
+        std::shared_ptr<const ACLSnapshot> find(uint32_t version) const;
+
+        /**
+         * @brief Gets the RIDs that changed between two snapshots.
+         * @note Deltas are computed once per pair of versions and shared by every peer they are sent to.
+         * @param from Earlier snapshot.
+         * @param to Later snapshot.
+         * @returns std::shared_ptr<const ACLDelta> Delta between the snapshots.
+         */
+        std::shared_ptr<const ACLDelta> delta(const std::shared_ptr<const ACLSnapshot>& from, const std::shared_ptr<const ACLSnapshot>& to);
+
+        /**
+         * @brief Gets an encoded Peer-Link list file.
+         * @param type Peer-Link list file type.
+         * @param filename Full-path to the list file.
+         * @returns std::shared_ptr<const ACLPeerLinkFile> Encoded list file, or nullptr if the file could not be read.
+         */
+        std::shared_ptr<const ACLPeerLinkFile> peerLinkFile(PeerLinkFileType type, const std::string& filename);
+
+        /**
+         * @brief Helper to hash a buffer into a snapshot version.
+         * @param hash Running hash value (2166136261 to start a new hash).
+         * @param[in] data Buffer to hash.
+         * @param length Length of buffer.
+         * @returns uint32_t Updated hash value.
+         */
+        static uint32_t hash(uint32_t hash, const uint8_t* data, size_t length);
+
+    private:
+        mutable std::mutex m_mutex;
+        std::shared_ptr<const ACLSnapshot> m_current;
+        std::deque<std::shared_ptr<const ACLSnapshot>> m_history;
+        std::unordered_map<uint64_t, std::shared_ptr<const ACLDelta>> m_deltas;
+
+        std::mutex m_peerLinkMutex;
+        std::shared_ptr<const ACLPeerLinkFile> m_peerLinkFiles[PL_FILE_COUNT];
+        bool m_peerLinkStale[PL_FILE_COUNT];
+    };
+} // namespace network
+
+#endif // __ACL_CACHE_H__
@@ -87,7 +87,7 @@ void DiagNetwork::processNetwork()
         req->buffer = new uint8_t[length];
         ::memcpy(req->buffer, buffer.get(), length);
 
-        if (!m_threadPool.enqueue(new_pooltask(taskNetworkRx, req))) {
+        if (!m_threadPool.enqueue(taskNetworkRx, req)) {
             LogError(LOG_NET, "Failed to task enqueue network packet request, peerId = %u, %s:%u", peerId, 
                 udp::Socket::address(address).c_str(), udp::Socket::port(address));
             if (req != nullptr) {
@@ -184,13 +184,13 @@ void DiagNetwork::taskNetworkRx(NetPacketRequest* req)
                     // resolve peer ID (used for Activity Log and Status Transfer)
                     bool validPeerId = false;
                     uint32_t pktPeerId = 0U;
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         validPeerId = true;
                         pktPeerId = peerId;
                     } else {
                         if (peerId > 0) {
                             // this could be a peer-link transfer -- in which case, we need to check the SSRC of the packet not the peer ID
-                            if (network->m_peers.find(req->rtpHeader.getSSRC()) != network->m_peers.end()) {
+                            if (network->m_peers.contains(req->rtpHeader.getSSRC())) {
                                 FNEPeerConnection* connection = network->m_peers[req->rtpHeader.getSSRC()];
                                 if (connection != nullptr) {
                                     if (connection->isExternalPeer() && connection->isPeerLink()) {
@@ -233,7 +233,7 @@ void DiagNetwork::taskNetworkRx(NetPacketRequest* req)
 
                                             // repeat traffic to the connected SysView peers
                                             if (network->m_peers.size() > 0U) {
-                                                for (auto peer : network->m_peers) {
+                                                for (auto peer : network->m_peers.snapshot()) {
                                                     if (peer.second != nullptr) {
                                                         if (peer.second->isSysView()) {
                                                             sockaddr_storage addr = peer.second->socketStorage();
@@ -272,7 +272,7 @@ void DiagNetwork::taskNetworkRx(NetPacketRequest* req)
                     case NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG:            // Peer Diagnostic Log Transfer
                         {
                             if (network->m_allowDiagnosticTransfer) {
-                                if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                                if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                     FNEPeerConnection* connection = network->m_peers[peerId];
                                     if (connection != nullptr) {
                                         std::string ip = udp::Socket::address(req->address);
@@ -319,7 +319,7 @@ void DiagNetwork::taskNetworkRx(NetPacketRequest* req)
                                     if (connection->connected() && connection->address() == ip) {
                                         if (network->m_peers.size() > 0U) {
                                             // attempt to repeat status traffic to SysView clients
-                                            for (auto peer : network->m_peers) {
+                                            for (auto peer : network->m_peers.snapshot()) {
                                                 if (peer.second != nullptr) {
                                                     if (peer.second->isSysView()) {
                                                         sockaddr_storage addr = peer.second->socketStorage();
@@ -368,7 +368,7 @@ void DiagNetwork::taskNetworkRx(NetPacketRequest* req)
 
             case NET_FUNC::PEER_LINK:
                 if (req->fneHeader.getSubFunction() == NET_SUBFUNC::PL_ACT_PEER_LIST) { // Peer-Link Active Peer List
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         FNEPeerConnection* connection = network->m_peers[peerId];
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
@@ -29,6 +29,7 @@ using namespace compress;
 #include <cerrno>
 #include <chrono>
 #include <fstream>
+#include <sstream>
 #include <streambuf>
 
 // ---------------------------------------------------------------------------
@@ -37,11 +38,12 @@ using namespace compress;
 
 const uint32_t MAX_HARD_CONN_CAP = 250U;
 const uint8_t MAX_PEER_LIST_BEFORE_FLUSH = 10U;
-const uint32_t MAX_RID_LIST_CHUNK = 50U;
 
 const uint32_t MAX_MISSED_ACL_UPDATES = 10U;
+const uint32_t MAX_ACL_DELTA_UPDATES = 10U;
 
 const uint64_t PACKET_LATE_TIME = 200U; // 200ms
+const uint32_t DEFAULT_RECV_BATCH_SIZE = 32U;
 
 // ---------------------------------------------------------------------------
 //  Static Class Members
@@ -76,16 +78,27 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_ridLookup(nullptr),
     m_tidLookup(nullptr),
     m_peerListLookup(nullptr),
+    m_aclCache(),
+    m_peerLinkPacer(),
     m_status(NET_STAT_INVALID),
     m_peers(),
     m_peerLinkPeers(),
     m_peerAffiliations(),
+    m_affiliationIndex(),
     m_ccPeerMap(),
+    m_peerGeneration(0U),
     m_peerLinkKeyQueue(),
     m_peerLinkActPkt(),
     m_maintainenceTimer(1000U, pingTime),
     m_updateLookupTimer(1000U, (updateLookupTime * 60U)),
     m_softConnLimit(0U),
+    m_recvBatchSize(DEFAULT_RECV_BATCH_SIZE),
+    m_sendWriterLatency(DEFAULT_TX_WRITER_LATENCY),
+    m_rxFrames(),
+    m_socketShards(1U),
+    m_shards(),
+    m_workerCnt(workerCnt),
+    m_workerAffinity(),
     m_callInProgress(false),
     m_disallowAdjStsBcast(false),
     m_disallowExtAdjStsBcast(true),
@@ -105,7 +118,20 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_influxOrg("dvm"),
     m_influxBucket("dvm"),
     m_influxLogRawData(false),
+    m_influxLogLatency(false),
+    m_influxBatchInterval(DEFAULT_INFLUX_BATCH_INTERVAL),
+    m_influxBatchSize(DEFAULT_INFLUX_BATCH_BYTES),
+    m_influxMaxQueueSize(DEFAULT_INFLUX_MAX_QUEUED_BYTES),
     m_threadPool(workerCnt, "fne"),
+    m_rxDispatchLatency("rx_dispatch"),
+    m_rxProcessLatency("rx_process"),
+    m_dmrProcessLatency("dmr_process"),
+    m_p25ProcessLatency("p25_process"),
+    m_nxdnProcessLatency("nxdn_process"),
+    m_writePeerLatency("write_peer"),
+    m_txQueueLatency("tx_queue"),
+    m_txWriteLatency("tx_write"),
+    m_influxLatencySnapshots(),
     m_disablePacketData(false),
     m_dumpPacketData(false),
     m_verbosePacketData(false),
@@ -117,6 +143,9 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     assert(port > 0U);
     assert(!password.empty());
 
+    for (uint32_t i = 0U; i < TG_GENERATION_COUNT; i++)
+        m_tgGeneration[i].store(0U, std::memory_order_relaxed);
+
     m_tagDMR = new TagDMRData(this, debug);
     m_tagP25 = new TagP25Data(this, debug);
     m_tagNXDN = new TagNXDNData(this, debug);
@@ -142,11 +171,51 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
     m_rejectUnknownRID = conf["rejectUnknownRID"].as<bool>(false);
     m_disallowCallTerm = conf["disallowCallTerm"].as<bool>(false);
     m_softConnLimit = conf["connectionLimit"].as<uint32_t>(MAX_HARD_CONN_CAP);
+    m_recvBatchSize = conf["recvBatchSize"].as<uint32_t>(DEFAULT_RECV_BATCH_SIZE);
+    m_sendWriterLatency = conf["sendWriterLatency"].as<uint32_t>(DEFAULT_TX_WRITER_LATENCY);
+    m_socketShards = conf["socketShards"].as<uint32_t>(1U);
 
     if (m_softConnLimit > MAX_HARD_CONN_CAP) {
         m_softConnLimit = MAX_HARD_CONN_CAP;
     }
 
+    if (m_recvBatchSize == 0U) {
+        m_recvBatchSize = 1U;
+    }
+
+    if (m_recvBatchSize > MAX_RX_BATCH_COUNT) {
+        m_recvBatchSize = MAX_RX_BATCH_COUNT;
+    }
+
+    if (m_socketShards == 0U) {
+        m_socketShards = 1U;
+    }
+
+    if (m_socketShards > MAX_SOCKET_SHARDS) {
+        m_socketShards = MAX_SOCKET_SHARDS;
+    }
+
+#if defined(_WIN32)
+    if (m_socketShards > 1U) {
+        LogWarning(LOG_NET, "Socket sharding is not supported on this platform, using a single socket.");
+        m_socketShards = 1U;
+    }
+#endif // defined(_WIN32)
+
+    m_threadPool.setLockFree(conf["workerLockFree"].as<bool>(true));
+    m_threadPool.setLockFreeQueueLen(conf["workerQueueLength"].as<uint32_t>(4096U));
+    m_threadPool.setSharded(conf["workerStreamOrdering"].as<bool>(true));
+
+    std::vector<uint32_t> workerAffinity;
+    yaml::Node& workerCpuAffinity = conf["workerCpuAffinity"];
+    if (workerCpuAffinity.size() > 0U) {
+        for (size_t i = 0; i < workerCpuAffinity.size(); i++) {
+            workerAffinity.push_back(workerCpuAffinity[i].as<uint32_t>(0U));
+        }
+    }
+    m_threadPool.setAffinity(workerAffinity);
+    m_workerAffinity = workerAffinity;
+
     // always force disable ADJ_STS_BCAST to external peers if the all option
     // is enabled
     if (m_disallowAdjStsBcast) {
@@ -160,6 +229,13 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
     m_influxOrg = conf["influxOrg"].as<std::string>("dvm");
     m_influxBucket = conf["influxBucket"].as<std::string>("dvm");
     m_influxLogRawData = conf["influxLogRawData"].as<bool>(false);
+    m_influxLogLatency = conf["influxLogLatency"].as<bool>(false);
+    m_influxBatchInterval = conf["influxBatchInterval"].as<uint32_t>(DEFAULT_INFLUX_BATCH_INTERVAL);
+    m_influxBatchSize = conf["influxBatchSize"].as<uint32_t>(DEFAULT_INFLUX_BATCH_BYTES / 1024U) * 1024U;
+    m_influxMaxQueueSize = conf["influxMaxQueueSize"].as<uint32_t>(DEFAULT_INFLUX_MAX_QUEUED_BYTES / 1024U) * 1024U;
+    if (m_influxMaxQueueSize < m_influxBatchSize) {
+        m_influxMaxQueueSize = m_influxBatchSize;
+    }
     if (m_enableInfluxDB) {
         m_influxServer = influxdb::ServerInfo(m_influxServerAddress, m_influxServerPort, m_influxOrg, m_influxServerToken, m_influxBucket);
     }
@@ -191,6 +267,25 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
 
     if (printOptions) {
         LogInfo("    Maximum Permitted Connections: %u", m_softConnLimit);
+        LogInfo("    Receive Batch Size: %u", m_recvBatchSize);
+        if (m_socketShards > 1U) {
+            LogInfo("    Socket Shards: %u (%u workers per shard)", m_socketShards, NetworkShard::shardWorkerCnt(m_workerCnt, m_socketShards));
+        }
+        if (m_sendWriterLatency > 0U) {
+            LogInfo("    Send Writer Latency: %uus", m_sendWriterLatency);
+        } else {
+            LogInfo("    Send Writer Latency: disabled (packets sent by workers)");
+        }
+        LogInfo("    Lock-Free Worker Queue: %s", m_threadPool.isLockFree() ? "yes" : "no");
+        LogInfo("    Per-Stream Ordered Workers: %s", m_threadPool.isSharded() ? "yes" : "no");
+        if (workerAffinity.size() > 0U) {
+            std::stringstream ss;
+            for (uint32_t cpu : workerAffinity) {
+                ss << cpu << " ";
+            }
+
+            LogInfo("    Worker CPU Affinity: %s", ss.str().c_str());
+        }
         LogInfo("    Disable adjacent site broadcasts to any peers: %s", m_disallowAdjStsBcast ? "yes" : "no");
         if (m_disallowAdjStsBcast) {
             LogWarning(LOG_NET, "NOTICE: All P25 ADJ_STS_BCAST messages will be blocked and dropped!");
@@ -213,6 +308,10 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
             LogInfo("    InfluxDB Organization: %s", m_influxOrg.c_str());
             LogInfo("    InfluxDB Bucket: %s", m_influxBucket.c_str());
             LogInfo("    InfluxDB Log Raw TSBK/CSBK/RCCH: %s", m_influxLogRawData ? "yes" : "no");
+            LogInfo("    InfluxDB Log Packet Latency: %s", m_influxLogLatency ? "yes" : "no");
+            LogInfo("    InfluxDB Batch Interval: %ums", m_influxBatchInterval);
+            LogInfo("    InfluxDB Batch Size: %uKB", m_influxBatchSize / 1024U);
+            LogInfo("    InfluxDB Max Queue Size: %uKB", m_influxMaxQueueSize / 1024U);
         }
         LogInfo("    Parrot Repeat to Only Originating Peer: %s", m_parrotOnlyOriginating ? "yes" : "no");
     }
@@ -234,6 +333,9 @@ void FNENetwork::setLookups(lookups::RadioIdLookup* ridLookup, lookups::Talkgrou
 void FNENetwork::setPresharedKey(const uint8_t* presharedKey)
 {
     m_socket->setPresharedKey(presharedKey);
+    for (NetworkShard* shard : m_shards) {
+        shard->socket()->setPresharedKey(presharedKey);
+    }
 }
 
 /* Process a data frames from the network. */
@@ -244,46 +346,7 @@ void FNENetwork::processNetwork()
         return;
     }
 
-    sockaddr_storage address;
-    uint32_t addrLen;
-    frame::RTPHeader rtpHeader;
-    frame::RTPFNEHeader fneHeader;
-    int length = 0U;
-
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
-    if (length > 0) {
-        if (m_debug)
-            Utils::dump(1U, "Network Message", buffer.get(), length);
-
-        uint32_t peerId = fneHeader.getPeerId();
-
-        NetPacketRequest* req = new NetPacketRequest();
-        req->obj = this;
-        req->peerId = peerId;
-
-        req->address = address;
-        req->addrLen = addrLen;
-        req->rtpHeader = rtpHeader;
-        req->fneHeader = fneHeader;
-
-        req->pktRxTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-
-        req->length = length;
-        req->buffer = new uint8_t[length];
-        ::memcpy(req->buffer, buffer.get(), length);
-
-        // enqueue the task
-        if (!m_threadPool.enqueue(new_pooltask(taskNetworkRx, req))) {
-            LogError(LOG_NET, "Failed to task enqueue network packet request, peerId = %u, %s:%u", peerId, 
-                udp::Socket::address(address).c_str(), udp::Socket::port(address));
-            if (req != nullptr) {
-                if (req->buffer != nullptr)
-                    delete[] req->buffer;
-                delete req;
-            }
-        }
-    }
+    readNetwork(m_frameQueue, m_rxFrames, m_threadPool);
 }
 
 /* Updates the timer by the passed number of milliseconds. */
@@ -296,8 +359,12 @@ void FNENetwork::clock(uint32_t ms)
 
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
+    // write any Peer-Link list file fragments that are due
+    m_peerLinkPacer.clock(FragmentPacer::now());
+
     if (m_forceListUpdate) {
-        for (auto peer : m_peers) {
+        m_aclCache.update(m_ridLookup, m_tidLookup);
+        for (auto peer : m_peers.snapshot()) {
             peerACLUpdate(peer.first);
         }
         m_forceListUpdate = false;
@@ -305,9 +372,46 @@ void FNENetwork::clock(uint32_t ms)
 
     m_maintainenceTimer.clock(ms);
     if (m_maintainenceTimer.isRunning() && m_maintainenceTimer.hasExpired()) {
+        if (m_debug) {
+            ThreadPoolStats stats = m_threadPool.stats();
+            LogDebugEx(LOG_NET, "FNENetwork::clock()", "worker queue, depth = %u, maxDepth = %u, enqueued = %llu, dropped = %llu, completed = %llu, avgLatency = %lluus, maxLatency = %lluus",
+                stats.queueDepth, stats.maxQueueDepth, (unsigned long long)stats.enqueued, (unsigned long long)stats.dropped, (unsigned long long)stats.completed,
+                (unsigned long long)stats.avgLatency, (unsigned long long)stats.maxLatency);
+            for (NetworkShard* shard : m_shards) {
+                stats = shard->threadPool()->stats();
+                LogDebugEx(LOG_NET, "FNENetwork::clock()", "shard %u worker queue, depth = %u, maxDepth = %u, enqueued = %llu, dropped = %llu, completed = %llu, avgLatency = %lluus, maxLatency = %lluus",
+                    shard->index(), stats.queueDepth, stats.maxQueueDepth, (unsigned long long)stats.enqueued, (unsigned long long)stats.dropped, (unsigned long long)stats.completed,
+                    (unsigned long long)stats.avgLatency, (unsigned long long)stats.maxLatency);
+            }
+
+            RawFrameQueueStats txStats = m_frameQueue->stats();
+            LogDebugEx(LOG_NET, "FNENetwork::clock()", "send queue, depth = %u, maxDepth = %u, enqueued = %llu, dropped = %llu, written = %llu, flushes = %llu, wakeups = %llu, avgLatency = %lluus, maxLatency = %lluus",
+                txStats.queueDepth, txStats.maxQueueDepth, (unsigned long long)txStats.enqueued, (unsigned long long)txStats.dropped, (unsigned long long)txStats.written,
+                (unsigned long long)txStats.flushes, (unsigned long long)txStats.writerWakeups, (unsigned long long)txStats.avgLatency, (unsigned long long)txStats.maxLatency);
+
+            if (m_enableInfluxDB) {
+                influxdb::WriterStats fluxStats = influxdb::detail::TSCaller::stats();
+                LogDebugEx(LOG_NET, "FNENetwork::clock()", "influx writer, queuedPoints = %u, queuedBytes = %u, written = %llu, batches = %llu, dropped = %llu, failed = %llu, connects = %llu",
+                    fluxStats.queuedPoints, fluxStats.queuedBytes, (unsigned long long)fluxStats.written, (unsigned long long)fluxStats.batches,
+                    (unsigned long long)fluxStats.dropped, (unsigned long long)fluxStats.failed, (unsigned long long)fluxStats.connects);
+            }
+
+            for (LatencyHistogram* histogram : latencyHistograms()) {
+                LatencyHistogramSnapshot latency = histogram->snapshot();
+                LogDebugEx(LOG_NET, "FNENetwork::clock()", "%s latency, count = %llu, mean = %lluus, p50 = %lluus, p99 = %lluus, p99.9 = %lluus, max = %lluus",
+                    histogram->name().c_str(), (unsigned long long)latency.count(), (unsigned long long)latency.mean(), (unsigned long long)latency.percentile(50.0),
+                    (unsigned long long)latency.percentile(99.0), (unsigned long long)latency.percentile(99.9), (unsigned long long)latency.max());
+            }
+        }
+
+        // report packet handling latency to InfluxDB
+        if (m_enableInfluxDB && m_influxLogLatency) {
+            reportLatency();
+        }
+
         // check to see if any peers have been quiet (no ping) longer than allowed
         std::vector<uint32_t> peersToRemove = std::vector<uint32_t>();
-        for (auto peer : m_peers) {
+        for (auto peer : m_peers.snapshot()) {
             uint32_t id = peer.first;
             FNEPeerConnection* connection = peer.second;
             if (connection != nullptr) {
@@ -343,7 +447,7 @@ void FNENetwork::clock(uint32_t ms)
             FNEPeerConnection* connection = m_peers[peerId];
             erasePeer(peerId);
             if (connection != nullptr) {
-                delete connection;
+                releasePeer(connection);
             }
         }
 
@@ -367,7 +471,7 @@ void FNENetwork::clock(uint32_t ms)
 
                         if (m_peers.size() > 0) {
                             json::array peers = json::array();
-                            for (auto entry : m_peers) {
+                            for (auto entry : m_peers.snapshot()) {
                                 uint32_t peerId = entry.first;
                                 network::FNEPeerConnection* peerConn = entry.second;
                                 if (peerConn != nullptr) {
@@ -390,9 +494,10 @@ void FNENetwork::clock(uint32_t ms)
 
     m_updateLookupTimer.clock(ms);
     if (m_updateLookupTimer.isRunning() && m_updateLookupTimer.hasExpired()) {
-        // send ACL updates to peers
-        m_peers.lock(false);
-        for (auto peer : m_peers) {
+        // rebuild the ACL lists, and send ACL updates to peers
+        m_aclCache.update(m_ridLookup, m_tidLookup);
+
+        for (auto peer : m_peers.snapshot()) {
             uint32_t id = peer.first;
             FNEPeerConnection* connection = peer.second;
             if (connection != nullptr) {
@@ -420,7 +525,9 @@ void FNENetwork::clock(uint32_t ms)
                 }
             }
         }
-        m_peers.unlock();
+
+        // talkgroup rules may have changed, force any cached call fan-outs to be resolved again
+        invalidatePeerFanout();
 
         m_updateLookupTimer.start();
     }
@@ -456,12 +563,11 @@ bool FNENetwork::open()
     if (m_debug)
         LogMessage(LOG_NET, "Opening Network");
 
-    // start thread pool
-    m_threadPool.start();
-
-    // start FluxQL thread pool
+    // start InfluxDB writer
     if (m_enableInfluxDB) {
-        influxdb::detail::TSCaller::start();
+        if (!influxdb::detail::TSCaller::start(m_influxServer, m_influxBatchInterval, m_influxBatchSize, m_influxMaxQueueSize)) {
+            LogError(LOG_NET, "Failed to start InfluxDB writer thread");
+        }
     }
 
     m_status = NET_STAT_MST_RUNNING;
@@ -469,6 +575,7 @@ bool FNENetwork::open()
     m_updateLookupTimer.start();
 
     m_socket = new udp::Socket(m_address, m_port);
+    m_socket->setReusePort(m_socketShards > 1U);
 
     // reinitialize the frame queue
     if (m_frameQueue != nullptr) {
@@ -476,10 +583,39 @@ bool FNENetwork::open()
         m_frameQueue = new FrameQueue(m_socket, m_peerId, m_debug);
     }
 
+    if (m_recvBatchSize > 1U) {
+        m_frameQueue->setRxBatchCount(m_recvBatchSize);
+        m_rxFrames.reserve(m_recvBatchSize);
+    }
+
+    m_frameQueue->setLatencyHistograms(&m_txQueueLatency, &m_txWriteLatency);
+
     bool ret = m_socket->open();
     if (!ret) {
         m_status = NET_STAT_INVALID;
     }
+    else {
+        // open the additional receive shards -- if they cannot be opened, all traffic is received by the primary socket
+        if (m_socketShards > 1U) {
+            if (!openShards()) {
+                LogError(LOG_NET, "Failed to open socket shards, all traffic will be received by a single socket");
+            }
+        }
+    }
+
+    // start thread pool -- the packet processing workers are split evenly between the socket shards, but only once
+    // the shards are open; if they could not be opened the primary socket keeps every worker
+    m_threadPool.setMaxWorkerCnt(NetworkShard::shardWorkerCnt(m_workerCnt, (uint32_t)m_shards.size() + 1U));
+    m_threadPool.start();
+
+    if (ret) {
+        // start the dedicated writer for queued outbound traffic
+        if (m_sendWriterLatency > 0U) {
+            if (!m_frameQueue->startWriter("fne", m_sendWriterLatency)) {
+                LogError(LOG_NET, "Failed to start network writer thread, queued packets will be sent by workers");
+            }
+        }
+    }
 
     return ret;
 }
@@ -496,7 +632,7 @@ void FNENetwork::close()
         ::memset(buffer, 0x00U, 1U);
 
         uint32_t streamId = createStreamId();
-        for (auto peer : m_peers) {
+        for (auto peer : m_peers.snapshot()) {
             writePeer(peer.first, { NET_FUNC::MST_DISC, NET_SUBFUNC::NOP }, buffer, 1U, RTP_END_OF_CALL_SEQ, streamId, false);
         }
     }
@@ -504,16 +640,20 @@ void FNENetwork::close()
     m_maintainenceTimer.stop();
     m_updateLookupTimer.stop();
 
-    // stop thread pool
+    // stop the receive shards, and thread pool
+    closeShards();
+
     m_threadPool.stop();
     m_threadPool.wait();
 
-    // stop FluxQL thread pool
+    // stop InfluxDB writer (this writes any remaining queued points)
     if (m_enableInfluxDB) {
         influxdb::detail::TSCaller::stop();
-        influxdb::detail::TSCaller::wait();
     }
 
+    // stop the writer (this flushes any remaining queued traffic)
+    m_frameQueue->stopWriter();
+
     m_socket->close();
 
     m_status = NET_STAT_INVALID;
@@ -523,6 +663,79 @@ void FNENetwork::close()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/* Helper to read data frames from a socket and enqueue them to the worker thread pool. */
+
+int FNENetwork::readNetwork(FrameQueue* frameQueue, std::vector<FrameQueue::RxFrame>& rxFrames, ThreadPool& threadPool)
+{
+    // read a batch of messages directly into the receive slab
+    if (m_recvBatchSize > 1U) {
+        int count = frameQueue->readBatch(rxFrames);
+        if (count > 0) {
+            uint64_t pktRxTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            for (FrameQueue::RxFrame& frame : rxFrames) {
+                enqueueNetworkRx(threadPool, frame.message, frame.messageLength, frame.address, frame.addrLen, frame.rtpHeader, frame.fneHeader, pktRxTime);
+            }
+        }
+
+        return count;
+    }
+
+    sockaddr_storage address;
+    uint32_t addrLen;
+    frame::RTPHeader rtpHeader;
+    frame::RTPFNEHeader fneHeader;
+    int length = 0U;
+
+    // read message
+    UInt8Array buffer = frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
+    if (length > 0) {
+        uint64_t pktRxTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        enqueueNetworkRx(threadPool, buffer.get(), length, address, addrLen, rtpHeader, fneHeader, pktRxTime);
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Helper to enqueue a received network message to the worker thread pool. */
+
+void FNENetwork::enqueueNetworkRx(ThreadPool& threadPool, const uint8_t* message, int length, const sockaddr_storage& address, uint32_t addrLen,
+    const frame::RTPHeader& rtpHeader, const frame::RTPFNEHeader& fneHeader, uint64_t pktRxTime)
+{
+    if (m_debug)
+        Utils::dump(1U, "Network Message", message, length);
+
+    uint32_t peerId = fneHeader.getPeerId();
+
+    NetPacketRequest* req = new NetPacketRequest();
+    req->obj = this;
+    req->peerId = peerId;
+
+    req->address = address;
+    req->addrLen = addrLen;
+    req->rtpHeader = rtpHeader;
+    req->fneHeader = fneHeader;
+
+    req->pktRxTime = pktRxTime;
+    req->pktQueueTime = LatencyHistogram::now();
+
+    req->length = length;
+    req->buffer = new uint8_t[length];
+    ::memcpy(req->buffer, message, length);
+
+    // enqueue the task -- frames for the same peer and stream always hash to the same worker, this keeps
+    // a call in-order and keeps the per-stream state for a call on a single thread
+    if (!threadPool.enqueue(taskNetworkRx, req, NetworkShard::dispatchKey(peerId, fneHeader.getStreamId()))) {
+        LogError(LOG_NET, "Failed to task enqueue network packet request, peerId = %u, %s:%u", peerId, 
+            udp::Socket::address(address).c_str(), udp::Socket::port(address));
+        if (req != nullptr) {
+            if (req->buffer != nullptr)
+                delete[] req->buffer;
+            delete req;
+        }
+    }
+}
+
 /* Process a data frames from the network. */
 
 void FNENetwork::taskNetworkRx(NetPacketRequest* req)
@@ -544,6 +757,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
         if (req == nullptr)
             return;
 
+        uint64_t processStart = LatencyHistogram::now();
+        network->m_rxDispatchLatency.record((processStart > req->pktQueueTime) ? processStart - req->pktQueueTime : 0U);
+
         if (req->length > 0) {
             uint32_t peerId = req->fneHeader.getPeerId();
             uint32_t streamId = req->fneHeader.getStreamId();
@@ -557,7 +773,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
             }
 
             // update current peer packet sequence and stream ID
-            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end()) && streamId != 0U) {
+            if (peerId > 0 && (network->m_peers.contains(peerId)) && streamId != 0U) {
                 FNEPeerConnection* connection = network->m_peers[peerId];
                 uint16_t pktSeq = req->rtpHeader.getSequence();
 
@@ -581,7 +797,6 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                     }
                 }
 
-                network->m_peers[peerId] = connection;
             }
 
             // if we don't have a stream ID and are receiving call data -- throw an error and discard
@@ -604,7 +819,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                     switch (req->fneHeader.getSubFunction()) {
                     case NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR:             // Encapsulated DMR data frame
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
@@ -614,7 +829,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     if (connection->connected() && connection->address() == ip) {
                                         if (network->m_dmrEnabled) {
                                             if (network->m_tagDMR != nullptr) {
+                                                uint64_t start = LatencyHistogram::now();
                                                 network->m_tagDMR->processFrame(req->buffer, req->length, peerId, req->rtpHeader.getSequence(), streamId);
+                                                network->m_dmrProcessLatency.recordSince(start);
                                             }
                                         } else {
                                             network->writePeerNAK(peerId, streamId, TAG_DMR_DATA, NET_CONN_NAK_MODE_NOT_ENABLED);
@@ -630,7 +847,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
                     case NET_SUBFUNC::PROTOCOL_SUBFUNC_P25:             // Encapsulated P25 data frame
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
@@ -640,7 +857,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     if (connection->connected() && connection->address() == ip) {
                                         if (network->m_p25Enabled) {
                                             if (network->m_tagP25 != nullptr) {
+                                                uint64_t start = LatencyHistogram::now();
                                                 network->m_tagP25->processFrame(req->buffer, req->length, peerId, req->rtpHeader.getSequence(), streamId);
+                                                network->m_p25ProcessLatency.recordSince(start);
                                             }
                                         } else {
                                             network->writePeerNAK(peerId, streamId, TAG_P25_DATA, NET_CONN_NAK_MODE_NOT_ENABLED);
@@ -656,7 +875,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
                     case NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN:            // Encapsulated NXDN data frame
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
@@ -666,7 +885,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     if (connection->connected() && connection->address() == ip) {
                                         if (network->m_nxdnEnabled) {
                                             if (network->m_tagNXDN != nullptr) {
+                                                uint64_t start = LatencyHistogram::now();
                                                 network->m_tagNXDN->processFrame(req->buffer, req->length, peerId, req->rtpHeader.getSequence(), streamId);
+                                                network->m_nxdnProcessLatency.recordSince(start);
                                             }
                                         } else {
                                             network->writePeerNAK(peerId, streamId, TAG_NXDN_DATA, NET_CONN_NAK_MODE_NOT_ENABLED);
@@ -689,7 +910,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
             case NET_FUNC::RPTL:                                        // Repeater Login
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) == network->m_peers.end())) {
+                    if (peerId > 0 && (!network->m_peers.contains(peerId))) {
                         if (network->m_peers.size() >= MAX_HARD_CONN_CAP) {
                             LogError(LOG_NET, "PEER %u attempted to connect with no more connections available, currConnections = %u", peerId, network->m_peers.size());
                             network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_FNE_MAX_CONN, req->address, req->addrLen);
@@ -719,20 +940,20 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                 network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_ACL, req->address, req->addrLen);
 
                                 network->erasePeer(peerId);
-                                delete connection;
+                                network->releasePeer(connection);
                             }
                         }
                     }
                     else {
                         // check if the peer is in our peer list -- if he is, and he isn't in a running state, reset
                         // the login sequence
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                        if (peerId > 0 && (network->m_peers.contains(peerId))) {
                             FNEPeerConnection* connection = network->m_peers[peerId];
                             if (connection != nullptr) {
                                 if (connection->connectionState() == NET_STAT_RUNNING) {
                                     LogMessage(LOG_NET, "PEER %u (%s) resetting peer connection, connectionState = %u", peerId, connection->identity().c_str(),
                                         connection->connectionState());
-                                    delete connection;
+                                    FNEPeerConnection* oldConnection = connection;
 
                                     connection = new FNEPeerConnection(peerId, req->address, req->addrLen);
                                     connection->lastPing(now);
@@ -740,6 +961,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     network->erasePeerAffiliations(peerId);
                                     network->setupRepeaterLogin(peerId, streamId, connection);
 
+                                    // the old connection can only be released once it has been replaced in the peers list
+                                    network->releasePeer(oldConnection);
+
                                     // check if the peer is in the peer ACL list
                                     if (network->m_peerListLookup->getACL()) {
                                         if (network->m_peerListLookup->isPeerListEmpty()) {
@@ -752,7 +976,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                             network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_ACL, req->address, req->addrLen);
 
                                             network->erasePeer(peerId);
-                                            delete connection;
+                                            network->releasePeer(connection);
                                         }
                                     }
                                 } else {
@@ -762,7 +986,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                         connection->connectionState());
 
                                     network->erasePeer(peerId);
-                                    delete connection;
+                                    network->releasePeer(connection);
                                 }
                             } else {
                                 network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_BAD_CONN_STATE, req->address, req->addrLen);
@@ -776,7 +1000,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                 break;
             case NET_FUNC::RPTK:                                        // Repeater Authentication
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         FNEPeerConnection* connection = network->m_peers[peerId];
                         if (connection != nullptr) {
                             connection->lastPing(now);
@@ -846,7 +1070,6 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                         connection->connectionState(NET_STAT_WAITING_CONFIG);
                                         network->writePeerACK(peerId, streamId);
                                         LogInfoEx(LOG_NET, "PEER %u RPTK ACK, completed the login exchange", peerId);
-                                        network->m_peers[peerId] = connection;
                                     }
                                     else {
                                         LogWarning(LOG_NET, "PEER %u RPTK NAK, failed the login exchange", peerId);
@@ -863,7 +1086,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                 network->writePeerNAK(peerId, TAG_REPEATER_AUTH, NET_CONN_NAK_BAD_CONN_STATE, req->address, req->addrLen);
 
                                 network->erasePeer(peerId);
-                                delete connection;
+                                network->releasePeer(connection);
                             }
                         }
                     }
@@ -877,7 +1100,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                 break;
             case NET_FUNC::RPTC:                                        // Repeater Configuration
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         FNEPeerConnection* connection = network->m_peers[peerId];
                         if (connection != nullptr) {
                             connection->lastPing(now);
@@ -894,7 +1117,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     LogWarning(LOG_NET, "PEER %u RPTC NAK, supplied invalid configuration data", peerId);
                                     network->writePeerNAK(peerId, TAG_REPEATER_AUTH, NET_CONN_NAK_INVALID_CONFIG_DATA, req->address, req->addrLen);
                                     network->erasePeer(peerId);
-                                    delete connection;
+                                    network->releasePeer(connection);
                                 }
                                 else  {
                                     // ensure parsed JSON is an object
@@ -902,7 +1125,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                         LogWarning(LOG_NET, "PEER %u RPTC NAK, supplied invalid configuration data", peerId);
                                         network->writePeerNAK(peerId, TAG_REPEATER_AUTH, NET_CONN_NAK_INVALID_CONFIG_DATA, req->address, req->addrLen);
                                         network->erasePeer(peerId);
-                                        delete connection;
+                                        network->releasePeer(connection);
                                     }
                                     else {
                                         connection->config(v.get<json::object>());
@@ -911,7 +1134,12 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                         connection->pingsReceived(0U);
                                         connection->lastPing(now);
                                         connection->missedACLUpdates(0U);
-                                        network->m_peers[peerId] = connection;
+                                        connection->aclUpdates(0U);
+                                        connection->aclVersion(0U);
+                                        connection->reportsACLVersion(false);
+                                        connection->plRIDVersion(0U);
+                                        connection->plTGIDVersion(0U);
+                                        connection->plPeerVersion(0U);
 
                                         // attach extra notification data to the RPTC ACK to notify the peer of 
                                         // the use of the alternate diagnostic port
@@ -972,6 +1200,17 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                                 LogInfoEx(LOG_NET, "PEER %u reports SysView peer", peerId);
                                         }
 
+                                        // is the peer reporting the version of the ACL lists it has?
+                                        if (peerConfig["aclVersion"].is<uint32_t>()) {
+                                            uint32_t aclVersion = peerConfig["aclVersion"].get<uint32_t>();
+                                            connection->reportsACLVersion(true);
+                                            connection->aclVersion(aclVersion);
+                                            if (aclVersion != 0U)
+                                                LogInfoEx(LOG_NET, "PEER %u reports ACL version $%08X", peerId, aclVersion);
+                                        }
+
+                                        network->invalidatePeerFanout();
+
                                         if (peerConfig["software"].is<std::string>()) {
                                             std::string software = peerConfig["software"].get<std::string>();
                                             LogInfoEx(LOG_NET, "PEER %u reports software %s", peerId, software.c_str());
@@ -992,7 +1231,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     connection->connectionState());
                                 network->writePeerNAK(peerId, TAG_REPEATER_CONFIG, NET_CONN_NAK_BAD_CONN_STATE, req->address, req->addrLen);
                                 network->erasePeer(peerId);
-                                delete connection;
+                                network->releasePeer(connection);
                             }
                         }
                     }
@@ -1005,7 +1244,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
             case NET_FUNC::RPT_DISC:                                    // Repeater Disconnect
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         FNEPeerConnection* connection = network->m_peers[peerId];
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
@@ -1014,7 +1253,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                             if (connection->connected() && connection->address() == ip) {
                                 LogInfoEx(LOG_NET, "PEER %u (%s) disconnected", peerId, connection->identity().c_str());
                                 network->erasePeer(peerId);
-                                delete connection;
+                                network->releasePeer(connection);
                             }
                         }
                     }
@@ -1022,7 +1261,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                 break;
             case NET_FUNC::PING:                                        // Repeater Ping
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         FNEPeerConnection* connection = network->m_peers[peerId];
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
@@ -1036,6 +1275,12 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                 connection->pingsReceived(pingsRx);
                                 connection->lastPing(now);
 
+                                // peers reporting ACL versions append the version of the ACL lists they have
+                                if (connection->reportsACLVersion() && req->length >= 5) {
+                                    uint32_t aclVersion = GET_UINT32(req->buffer, 1U);
+                                    connection->aclVersion(aclVersion);
+                                }
+
                                 uint8_t payload[8U];
                                 ::memset(payload, 0x00U, 8U);
 
@@ -1049,7 +1294,6 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                 payload[6U] = (uint8_t)((now >> 8) & 0xFFU);
                                 payload[7U] = (uint8_t)((now >> 0) & 0xFFU);
 
-                                network->m_peers[peerId] = connection;
                                 network->writePeerCommand(peerId, { NET_FUNC::PONG, NET_SUBFUNC::NOP }, payload, 8U, streamId, false);
 
                                 if (network->m_reportPeerPing) {
@@ -1067,7 +1311,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
             case NET_FUNC::GRANT_REQ:                                   // Repeater Grant Request
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         FNEPeerConnection* connection = network->m_peers[peerId];
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
@@ -1136,7 +1380,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                     using namespace p25::defines;
                     using namespace p25::kmm;
 
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && (network->m_peers.contains(peerId))) {
                         FNEPeerConnection* connection = network->m_peers[peerId];
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
@@ -1258,11 +1502,11 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                     switch (req->fneHeader.getSubFunction()) {
                     case NET_SUBFUNC::ANNC_SUBFUNC_GRP_AFFIL:           // Announce Group Affiliation
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    std::shared_ptr<lookups::AffiliationLookup> aff = network->m_peerAffiliations[peerId];
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1272,8 +1516,11 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     if (connection->connected() && connection->address() == ip && aff != nullptr) {
                                         uint32_t srcId = GET_UINT24(req->buffer, 0U);           // Source Address
                                         uint32_t dstId = GET_UINT24(req->buffer, 3U);           // Destination Address
+                                        uint32_t prevDstId = aff->getGroupAff(srcId);
                                         aff->groupUnaff(srcId);
                                         aff->groupAff(srcId, dstId);
+                                        network->invalidateTalkgroupRoute(prevDstId);
+                                        network->invalidateTalkgroupRoute(dstId);
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1297,11 +1544,11 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_UNIT_REG:            // Announce Unit Registration
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    std::shared_ptr<lookups::AffiliationLookup> aff = network->m_peerAffiliations[peerId];
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1333,11 +1580,11 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                         break;
                     case NET_SUBFUNC::ANNC_SUBFUNC_UNIT_DEREG:          // Announce Unit Deregistration
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    std::shared_ptr<lookups::AffiliationLookup> aff = network->m_peerAffiliations[peerId];
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1346,7 +1593,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     // validate peer (simple validation really)
                                     if (connection->connected() && connection->address() == ip && aff != nullptr) {
                                         uint32_t srcId = GET_UINT24(req->buffer, 0U);           // Source Address
+                                        uint32_t prevDstId = aff->getGroupAff(srcId);
                                         aff->unitDereg(srcId);
+                                        network->invalidateTalkgroupRoute(prevDstId);
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1370,11 +1619,11 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_GRP_UNAFFIL:         // Announce Group Affiliation Removal
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    std::shared_ptr<lookups::AffiliationLookup> aff = network->m_peerAffiliations[peerId];
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1383,7 +1632,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                     // validate peer (simple validation really)
                                     if (connection->connected() && connection->address() == ip && aff != nullptr) {
                                         uint32_t srcId = GET_UINT24(req->buffer, 0U);           // Source Address
+                                        uint32_t prevDstId = aff->getGroupAff(srcId);
                                         aff->groupUnaff(srcId);
+                                        network->invalidateTalkgroupRoute(prevDstId);
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1407,14 +1658,14 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_AFFILS:              // Announce Update All Affiliations
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
                                     // validate peer (simple validation really)
                                     if (connection->connected() && connection->address() == ip) {
-                                        lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                        std::shared_ptr<lookups::AffiliationLookup> aff = network->m_peerAffiliations[peerId];
                                         if (aff == nullptr) {
                                             LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                             network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1433,6 +1684,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                                 aff->groupAff(srcId, dstId);
                                                 offs += 8U;
                                             }
+                                            network->invalidatePeerFanout();
                                             LogMessage(LOG_NET, "PEER %u (%s) announced %u affiliations", peerId, connection->identity().c_str(), len);
 
                                             // attempt to repeat traffic to Peer-Link masters
@@ -1458,7 +1710,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_SITE_VC:             // Announce Site VCs
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                            if (peerId > 0 && (network->m_peers.contains(peerId))) {
                                 FNEPeerConnection* connection = network->m_peers[peerId];
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
@@ -1472,7 +1724,7 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                         uint32_t offs = 4U;
                                         for (uint32_t i = 0; i < len; i++) {
                                             uint32_t vcPeerId = GET_UINT32(req->buffer, offs);
-                                            if (vcPeerId > 0 && (network->m_peers.find(vcPeerId) != network->m_peers.end())) {
+                                            if (vcPeerId > 0 && (network->m_peers.contains(vcPeerId))) {
                                                 FNEPeerConnection* vcConnection = network->m_peers[vcPeerId];
                                                 if (vcConnection != nullptr) {
                                                     vcConnection->ccPeerId(peerId);
@@ -1481,8 +1733,9 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
                                             }
                                             offs += 4U;
                                         }
+                                        network->invalidatePeerFanout();
                                         LogMessage(LOG_NET, "PEER %u (%s) announced %u VCs", peerId, connection->identity().c_str(), len);
-                                        network->m_ccPeerMap[peerId] = vcPeers;
+                                        network->m_ccPeerMap.set(peerId, vcPeers);
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1516,12 +1769,58 @@ void FNENetwork::taskNetworkRx(NetPacketRequest* req)
             }
         }
 
+        network->m_rxProcessLatency.recordSince(processStart);
+
         if (req->buffer != nullptr)
             delete[] req->buffer;
         delete req;
     }
 }
 
+/* Helper to open the additional receive shards. */
+
+bool FNENetwork::openShards()
+{
+    uint16_t workerCnt = NetworkShard::shardWorkerCnt(m_workerCnt, m_socketShards);
+
+    // the primary socket is the first shard, every additional shard binds its own socket to the master port,
+    // the kernel then hashes each peer's address and port to one of the sockets, so a peer's traffic is always
+    // read, and processed, by the same shard; the peer table itself is not split between the shards, lookups
+    // in it are lock-free (RCU) and the per-stream state of a peer lives in its own connection
+    for (uint32_t i = 1U; i < m_socketShards; i++) {
+        NetworkShard* shard = new NetworkShard(m_address, m_port, i, m_peerId, m_recvBatchSize, m_debug);
+        m_shards.push_back(shard);
+
+        // pin the shard workers to the CPUs following those used by the previous shards
+        std::vector<uint32_t> affinity;
+        for (uint32_t n = 0U; n < m_workerAffinity.size(); n++) {
+            affinity.push_back(m_workerAffinity[(i * workerCnt + n) % m_workerAffinity.size()]);
+        }
+
+        if (!shard->open(m_threadPool, workerCnt, affinity,
+            [this](FrameQueue* frameQueue, std::vector<FrameQueue::RxFrame>& rxFrames, ThreadPool& threadPool) {
+                return readNetwork(frameQueue, rxFrames, threadPool);
+            })) {
+            closeShards();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Helper to close the additional receive shards. */
+
+void FNENetwork::closeShards()
+{
+    for (NetworkShard* shard : m_shards) {
+        shard->close();
+        delete shard;
+    }
+
+    m_shards.clear();
+}
+
 /* Checks if the passed peer ID is blocked from unit-to-unit traffic. */
 
 bool FNENetwork::checkU2UDroppedPeer(uint32_t peerId)
@@ -1540,7 +1839,7 @@ bool FNENetwork::checkU2UDroppedPeer(uint32_t peerId)
 
 void FNENetwork::eraseStreamPktSeq(uint32_t peerId, uint32_t streamId)
 {
-    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
+    if (peerId > 0 && m_peers.contains(peerId)) {
         FNEPeerConnection* connection = m_peers[peerId];
         if (connection != nullptr) {
             connection->eraseStreamPktSeq(streamId);
@@ -1554,25 +1853,36 @@ void FNENetwork::createPeerAffiliations(uint32_t peerId, std::string peerName)
 {
     erasePeerAffiliations(peerId);
 
+    // the affiliations are shared with any handler that is still using them, they (and their channel lookup) are
+    // released once the last user lets go of them
     lookups::ChannelLookup* chLookup = new lookups::ChannelLookup();
-    m_peerAffiliations[peerId] = new lookups::AffiliationLookup(peerName, chLookup, m_verbose);
-    m_peerAffiliations[peerId]->setDisableUnitRegTimeout(true); // FNE doesn't allow unit registration timeouts (notification must come from the peers)
+    std::shared_ptr<lookups::AffiliationLookup> aff(new lookups::AffiliationLookup(peerName, chLookup, m_verbose),
+        [](lookups::AffiliationLookup* aff) {
+            lookups::ChannelLookup* rfCh = aff->rfCh();
+            delete aff;
+            if (rfCh != nullptr)
+                delete rfCh;
+        });
+    aff->setDisableUnitRegTimeout(true); // FNE doesn't allow unit registration timeouts (notification must come from the peers)
+    aff->setAffiliationIndex(&m_affiliationIndex, peerId);
+    m_peerAffiliations.set(peerId, aff);
+
+    invalidatePeerFanout();
 }
 
 /* Helper to erase the peer from the peers affiliations list. */
 
 bool FNENetwork::erasePeerAffiliations(uint32_t peerId)
 {
-    auto it = std::find_if(m_peerAffiliations.begin(), m_peerAffiliations.end(), [&](PeerAffiliationMapPair x) { return x.first == peerId; });
-    if (it != m_peerAffiliations.end()) {
-        lookups::AffiliationLookup* aff = m_peerAffiliations[peerId];
+    std::shared_ptr<lookups::AffiliationLookup> aff;
+    if (m_peerAffiliations.find(peerId, aff)) {
+        // remove the entry first, so no new lookups can get the affiliations we're about to release; handlers that
+        // already hold the affiliations keep them alive until they are done with them
+        m_peerAffiliations.erase(peerId);
         if (aff != nullptr) {
-            lookups::ChannelLookup* rfCh = aff->rfCh();
-            if (rfCh != nullptr)
-                delete rfCh;
-            delete aff;
+            // stop contributing to the aggregated index right away, rather than when the last user lets go
+            aff->setAffiliationIndex(nullptr, 0U);
         }
-        m_peerAffiliations.erase(peerId);
 
         return true;
     }
@@ -1585,16 +1895,14 @@ bool FNENetwork::erasePeerAffiliations(uint32_t peerId)
 void FNENetwork::erasePeer(uint32_t peerId)
 {
     {
-        auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-        if (it != m_peers.end()) {
+        if (m_peers.contains(peerId)) {
             m_peers.erase(peerId);
         }
     }
 
     // erase any CC maps for this peer
     {
-        auto it = std::find_if(m_ccPeerMap.begin(), m_ccPeerMap.end(), [&](auto x) { return x.first == peerId; });
-        if (it != m_ccPeerMap.end()) {
+        if (m_ccPeerMap.contains(peerId)) {
             m_ccPeerMap.erase(peerId);
         }
     }
@@ -1607,8 +1915,24 @@ void FNENetwork::erasePeer(uint32_t peerId)
         }
     }
 
+    // cancel any Peer-Link list files still being sent to this peer
+    m_peerLinkPacer.cancel(peerId);
+
     // cleanup peer affiliations
     erasePeerAffiliations(peerId);
+
+    invalidatePeerFanout();
+}
+
+/* Helper to release a peer connection that has been erased from the peers list. */
+
+void FNENetwork::releasePeer(FNEPeerConnection* connection)
+{
+    if (connection == nullptr)
+        return;
+
+    // snapshots of the peers list taken before the connection was erased may still be iterating over it
+    m_peers.retire([connection]() { delete connection; });
 }
 
 
@@ -1640,9 +1964,8 @@ json::object FNENetwork::fneConnObject(uint32_t peerId, FNEPeerConnection *conn)
     peerObj["config"].set<json::object>(peerConfig);
 
     json::array voiceChannels = json::array();
-    auto it = std::find_if(m_ccPeerMap.begin(), m_ccPeerMap.end(), [&](auto x) { return x.first == peerId; });
-    if (it != m_ccPeerMap.end()) {
-        std::vector<uint32_t> vcPeers = m_ccPeerMap[peerId];
+    std::vector<uint32_t> vcPeers;
+    if (m_ccPeerMap.find(peerId, vcPeers)) {
         for (uint32_t vcEntry : vcPeers) {
             voiceChannels.push_back(json::value((double)vcEntry));
         }
@@ -1656,7 +1979,7 @@ json::object FNENetwork::fneConnObject(uint32_t peerId, FNEPeerConnection *conn)
 
 bool FNENetwork::resetPeer(uint32_t peerId)
 {
-    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
+    if (peerId > 0 && m_peers.contains(peerId)) {
         FNEPeerConnection* connection = m_peers[peerId];
         if (connection != nullptr) {
             sockaddr_storage addr = connection->socketStorage();
@@ -1667,7 +1990,7 @@ bool FNENetwork::resetPeer(uint32_t peerId)
             writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_RESET, addr, addrLen);
 
             erasePeer(peerId);
-            delete connection;
+            releasePeer(connection);
 
             return true;
         }
@@ -1677,14 +2000,21 @@ bool FNENetwork::resetPeer(uint32_t peerId)
     return false;
 }
 
+/* Gets the packet handling latency histograms. */
+
+std::vector<LatencyHistogram*> FNENetwork::latencyHistograms()
+{
+    return std::vector<LatencyHistogram*>({ &m_rxDispatchLatency, &m_rxProcessLatency, &m_dmrProcessLatency, &m_p25ProcessLatency,
+        &m_nxdnProcessLatency, &m_writePeerLatency, &m_txQueueLatency, &m_txWriteLatency });
+}
+
 /* Helper to resolve the peer ID to its identity string. */
 
 std::string FNENetwork::resolvePeerIdentity(uint32_t peerId)
 {
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        if (it->second != nullptr) {
-            FNEPeerConnection* peer = it->second;
+    FNEPeerConnection* peer = nullptr;
+    if (m_peers.find(peerId, peer)) {
+        if (peer != nullptr) {
             return peer->identity();
         }
     }
@@ -1692,6 +2022,28 @@ std::string FNENetwork::resolvePeerIdentity(uint32_t peerId)
     return std::string();
 }
 
+/* Helper to resolve the list of destination peers for call traffic from the given peer. */
+
+FanoutPeerList FNENetwork::resolvePeerFanout(uint32_t srcPeerId, const std::function<bool(uint32_t)>& permitted)
+{
+    return PeerFanout::resolve(m_peers, srcPeerId, permitted);
+}
+
+/* Helper to resolve the materialized route for the given talkgroup. */
+
+FanoutPeerList FNENetwork::resolveTalkgroupRoute(TalkgroupRouteTable& routes, 
+    uint64_t routeKey, uint32_t dstId, const std::function<bool(uint32_t)>& permitted)
+{
+    // the generations are sampled before the route is resolved, if the route is invalidated while it is 
+    // being resolved the next frame will simply resolve it again
+    uint32_t peerGeneration = m_peerGeneration;
+    uint32_t tgGeneration = m_tgGeneration[dstId % TG_GENERATION_COUNT];
+    uint32_t rulesVersion = m_tidLookup->indexVersion();
+
+    return PeerFanout::resolveRoute(routes, routeKey, peerGeneration, tgGeneration, rulesVersion,
+        [&]() { return resolvePeerFanout(0U, permitted); });
+}
+
 /* Helper to complete setting up a repeater login request. */
 
 void FNENetwork::setupRepeaterLogin(uint32_t peerId, uint32_t streamId, FNEPeerConnection* connection)
@@ -1702,7 +2054,8 @@ void FNENetwork::setupRepeaterLogin(uint32_t peerId, uint32_t streamId, FNEPeerC
     LogInfoEx(LOG_NET, "PEER %u started login from, %s:%u", peerId, connection->address().c_str(), connection->port());
 
     connection->connectionState(NET_STAT_WAITING_AUTHORISATION);
-    m_peers[peerId] = connection;
+    m_peers.set(peerId, connection);
+    invalidatePeerFanout();
 
     // transmit salt to peer
     uint8_t salt[4U];
@@ -1722,7 +2075,7 @@ void FNENetwork::peerACLUpdate(uint32_t peerId)
     req->peerId = peerId;
 
     // enqueue the task
-    if (!m_threadPool.enqueue(new_pooltask(taskACLUpdate, req))) {
+    if (!m_threadPool.enqueue(taskACLUpdate, req)) {
         LogError(LOG_NET, "Failed to task enqueue ACL update, peerId = %u", peerId);
         if (req != nullptr)
             delete req;
@@ -1750,22 +2103,60 @@ void FNENetwork::taskACLUpdate(ACLUpdateRequest* req)
         if (connection != nullptr) {
             uint32_t aclStreamId = network->createStreamId();
 
+            std::shared_ptr<const ACLSnapshot> snapshot = network->m_aclCache.current();
+            if (snapshot == nullptr) {
+                snapshot = network->m_aclCache.update(network->m_ridLookup, network->m_tidLookup);
+            }
+
+            // periodically send the complete lists, in case an earlier update was lost in transit
+            bool fullUpdate = false;
+            uint32_t aclUpdates = connection->aclUpdates() + 1U;
+            if (aclUpdates > MAX_ACL_DELTA_UPDATES) {
+                fullUpdate = true;
+                aclUpdates = 0U;
+            }
+            connection->aclUpdates(aclUpdates);
+
             // if the connection is an external peer, and peer is participating in peer link,
             // send the peer proper configuration data
             if (connection->isExternalPeer() && connection->isPeerLink()) {
                 LogInfoEx(LOG_NET, "PEER %u (%s) sending Peer-Link ACL list updates", req->peerId, peerIdentity.c_str());
 
-                network->writeWhitelistRIDs(req->peerId, aclStreamId, true);
-                network->writeTGIDs(req->peerId, aclStreamId, true);
-                network->writePeerList(req->peerId, aclStreamId);
+                connection->plRIDVersion(network->writePeerLinkList(req->peerId, aclStreamId, ACLCache::PL_FILE_RID,
+                    connection->plRIDVersion(), fullUpdate));
+                if (snapshot->sendTalkgroups()) {
+                    connection->plTGIDVersion(network->writePeerLinkList(req->peerId, aclStreamId, ACLCache::PL_FILE_TGID,
+                        connection->plTGIDVersion(), fullUpdate));
+                }
+                connection->plPeerVersion(network->writePeerLinkList(req->peerId, aclStreamId, ACLCache::PL_FILE_PEER,
+                    connection->plPeerVersion(), fullUpdate));
             }
             else {
-                LogInfoEx(LOG_NET, "PEER %u (%s) sending ACL list updates", req->peerId, peerIdentity.c_str());
+                uint32_t peerVersion = connection->aclVersion();
+                if (!fullUpdate && peerVersion == snapshot->version()) {
+                    LogInfoEx(LOG_NET, "PEER %u (%s) ACL lists are up to date, version = $%08X", req->peerId, peerIdentity.c_str(), peerVersion);
+                }
+                else {
+                    std::shared_ptr<const ACLSnapshot> base = nullptr;
+                    if (!fullUpdate) {
+                        base = network->m_aclCache.find(peerVersion);
+                    }
 
-                network->writeWhitelistRIDs(req->peerId, aclStreamId, false);
-                network->writeBlacklistRIDs(req->peerId, aclStreamId);
-                network->writeTGIDs(req->peerId, aclStreamId, false);
-                network->writeDeactiveTGIDs(req->peerId, aclStreamId);
+                    if (base != nullptr) {
+                        LogInfoEx(LOG_NET, "PEER %u (%s) sending ACL list updates, version = $%08X, since version = $%08X", req->peerId, peerIdentity.c_str(),
+                            snapshot->version(), peerVersion);
+                        network->writeACLDelta(req->peerId, aclStreamId, base, snapshot);
+                    }
+                    else {
+                        LogInfoEx(LOG_NET, "PEER %u (%s) sending ACL list updates, version = $%08X", req->peerId, peerIdentity.c_str(), snapshot->version());
+                        network->writeACLLists(req->peerId, aclStreamId, snapshot);
+                    }
+
+                    if (connection->reportsACLVersion()) {
+                        network->writeACLVersion(req->peerId, aclStreamId, snapshot->version());
+                        connection->aclVersion(snapshot->version());
+                    }
+                }
             }
         }
 
@@ -1773,418 +2164,202 @@ void FNENetwork::taskACLUpdate(ACLUpdateRequest* req)
     }
 }
 
-/* Helper to send the list of whitelisted RIDs to the specified peer. */
+/* Helper to send the complete ACL lists of a snapshot to the specified peer. */
 
-void FNENetwork::writeWhitelistRIDs(uint32_t peerId, uint32_t streamId, bool isExternalPeer)
+void FNENetwork::writeACLLists(uint32_t peerId, uint32_t streamId, const std::shared_ptr<const ACLSnapshot>& snapshot)
 {
-    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    writeWhitelistRIDs(peerId, streamId, snapshot->whitelistPayloads());
+    writeBlacklistRIDs(peerId, streamId, snapshot->blacklistPayloads());
 
-    // sending PEER_LINK style RID list to external peers
-    if (isExternalPeer) {
-        FNEPeerConnection* connection = m_peers[peerId];
-        if (connection != nullptr) {
-            std::string filename = m_ridLookup->filename();
-            if (filename.empty()) {
-                return;
-            }
+    if (snapshot->sendTalkgroups()) {
+        std::vector<std::pair<uint32_t, uint8_t>> active, deactive;
+        snapshot->peerTalkgroups(peerId, active, deactive);
 
-            // read entire file into string buffer
-            std::stringstream b;
-            std::ifstream stream(filename);
-            if (stream.is_open()) {
-                while (stream.peek() != EOF) {
-                    b << (char)stream.get();
-                }
+        writeTGIDs(peerId, streamId, active);
+        writeDeactiveTGIDs(peerId, streamId, deactive);
+    }
+}
 
-                stream.close();
-            }
+/* Helper to send the changes to the ACL lists between two snapshots to the specified peer. */
 
-            // convert to a byte array
-            uint32_t len = b.str().size();
-            DECLARE_UINT8_ARRAY(buffer, len);
-            ::memcpy(buffer, b.str().data(), len);
+void FNENetwork::writeACLDelta(uint32_t peerId, uint32_t streamId, const std::shared_ptr<const ACLSnapshot>& base,
+    const std::shared_ptr<const ACLSnapshot>& snapshot)
+{
+    std::shared_ptr<const ACLDelta> delta = m_aclCache.delta(base, snapshot);
+    writeWhitelistRIDs(peerId, streamId, delta->whitelistPayloads);
+    writeBlacklistRIDs(peerId, streamId, delta->blacklistPayloads);
 
-            PacketBuffer pkt(true, "Peer-Link, RID List");
-            pkt.encode((uint8_t*)buffer, len);
+    if (snapshot->sendTalkgroups()) {
+        std::vector<std::pair<uint32_t, uint8_t>> active, deactive;
+        snapshot->peerTalkgroups(peerId, active, deactive);
 
-            LogInfoEx(LOG_NET, "PEER %u Peer-Link, RID List, blocks %u, streamId = %u", peerId, pkt.fragments.size(), streamId);
-            if (pkt.fragments.size() > 0U) {
-                for (auto frag : pkt.fragments) {
-                    writePeer(peerId, { NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_RID_LIST }, 
-                        frag.second->data, FRAG_SIZE, 0U, streamId, false, true, true);
-                    Thread::sleep(60U); // pace block transmission
-                }
-            }
+        std::vector<std::pair<uint32_t, uint8_t>> baseActive, baseDeactive;
+        if (base->sendTalkgroups()) {
+            base->peerTalkgroups(peerId, baseActive, baseDeactive);
         }
 
-        return;
-    }
-
-    // send radio ID white/black lists
-    std::vector<uint32_t> ridWhitelist;
+        // only send talkgroups that are new, or whose state changed, since the earlier version
+        std::sort(active.begin(), active.end());
+        std::sort(deactive.begin(), deactive.end());
+        std::sort(baseActive.begin(), baseActive.end());
+        std::sort(baseDeactive.begin(), baseDeactive.end());
 
-    auto ridLookups = m_ridLookup->table();
-    for (auto entry : ridLookups) {
-        uint32_t id = entry.first;
-        if (entry.second.radioEnabled()) {
-            ridWhitelist.push_back(id);
-        }
-    }
+        std::vector<std::pair<uint32_t, uint8_t>> activated, deactivated;
+        std::set_difference(active.begin(), active.end(), baseActive.begin(), baseActive.end(), std::back_inserter(activated));
+        std::set_difference(deactive.begin(), deactive.end(), baseDeactive.begin(), baseDeactive.end(), std::back_inserter(deactivated));
 
-    if (ridWhitelist.size() == 0U) {
-        return;
+        if (activated.size() > 0U)
+            writeTGIDs(peerId, streamId, activated);
+        if (deactivated.size() > 0U)
+            writeDeactiveTGIDs(peerId, streamId, deactivated);
     }
+}
 
-    // send a chunk of RIDs to the peer
-    FNEPeerConnection* connection = m_peers[peerId];
-    if (connection != nullptr) {
-        uint32_t chunkCnt = (ridWhitelist.size() / MAX_RID_LIST_CHUNK) + 1U;
-        for (uint32_t i = 0U; i < chunkCnt; i++) {
-            size_t listSize = ridWhitelist.size();
-            if (chunkCnt > 1U) {
-                listSize = MAX_RID_LIST_CHUNK;
-
-                if (i == chunkCnt - 1U) {
-                    // this is a disgusting dirty hack...
-                    listSize = ::abs((long)((i * MAX_RID_LIST_CHUNK) - ridWhitelist.size()));
-                }
-            }
-
-            if (listSize > ridWhitelist.size()) {
-                listSize = ridWhitelist.size();
-            }
-
-            // Ignore lists of size 0 (happens on even multiples of 50, TODO: there's probably a better fix for this)
-            if (listSize == 0) {
-                continue;
-            }
-
-            // build dataset
-            uint16_t bufSize = 4U + (listSize * 4U);
-            DECLARE_UINT8_ARRAY(payload, bufSize);
-
-            SET_UINT32(listSize, payload, 0U);
-
-            // write whitelisted IDs to whitelist payload
-            uint32_t offs = 4U;
-            for (uint32_t j = 0; j < listSize; j++) {
-                uint32_t id = ridWhitelist.at(j + (i * MAX_RID_LIST_CHUNK));
-
-                if (m_debug)
-                    LogDebug(LOG_NET, "PEER %u (%s) whitelisting RID %u (%d / %d)", peerId, connection->identity().c_str(),
-                        id, i, j);
-
-                SET_UINT32(id, payload, offs);
-                offs += 4U;
-            }
+/* Helper to send the version of the ACL lists sent to the specified peer. */
 
-            writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_WL_RID },
-                payload, bufSize, streamId, true);
-        }
+void FNENetwork::writeACLVersion(uint32_t peerId, uint32_t streamId, uint32_t version)
+{
+    uint8_t payload[4U];
+    SET_UINT32(version, payload, 0U);
 
-        connection->lastPing(now);
-    }
+    writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_ACL_VERSION },
+        payload, 4U, streamId, true);
 }
 
-/* Helper to send the list of whitelisted RIDs to the specified peer. */
+/* Helper to send a list of whitelisted RIDs to the specified peer. */
 
-void FNENetwork::writeBlacklistRIDs(uint32_t peerId, uint32_t streamId)
+void FNENetwork::writeWhitelistRIDs(uint32_t peerId, uint32_t streamId, const ACLPayloadList& payloads)
 {
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
-    // send radio ID blacklist
-    std::vector<uint32_t> ridBlacklist;
-
-    auto ridLookups = m_ridLookup->table();
-    for (auto entry : ridLookups) {
-        uint32_t id = entry.first;
-        if (!entry.second.radioEnabled()) {
-            ridBlacklist.push_back(id);
-        }
-    }
-
-    if (ridBlacklist.size() == 0U) {
+    if (payloads.size() == 0U) {
         return;
     }
 
     // send a chunk of RIDs to the peer
     FNEPeerConnection* connection = m_peers[peerId];
     if (connection != nullptr) {
-        uint32_t chunkCnt = (ridBlacklist.size() / MAX_RID_LIST_CHUNK) + 1U;
-        for (uint32_t i = 0U; i < chunkCnt; i++) {
-            size_t listSize = ridBlacklist.size();
-            if (chunkCnt > 1U) {
-                listSize = MAX_RID_LIST_CHUNK;
-                
-                if (i == chunkCnt - 1U) {
-                    // this is a disgusting dirty hack...
-                    listSize = ::abs((long)((i * MAX_RID_LIST_CHUNK) - ridBlacklist.size()));
-                }
-            }
-
-            if (listSize > ridBlacklist.size()) {
-                listSize = ridBlacklist.size();
-            }
-
-            // Ignore lists of size 0 (happens on even multiples of 50, TODO: there's probably a better fix for this)
-            if (listSize == 0) {
-                continue;
-            }
-
-            // build dataset
-            uint16_t bufSize = 4U + (listSize * 4U);
-            DECLARE_UINT8_ARRAY(payload, bufSize);
-
-            SET_UINT32(listSize, payload, 0U);
-
-            // write blacklisted IDs to blacklist payload
-            uint32_t offs = 4U;
-            for (uint32_t j = 0; j < listSize; j++) {
-                uint32_t id = ridBlacklist.at(j + (i * MAX_RID_LIST_CHUNK));
-
-                if (m_debug)
-                    LogDebug(LOG_NET, "PEER %u (%s) blacklisting RID %u (%d / %d)", peerId, connection->identity().c_str(),
-                        id, i, j);
-
-                SET_UINT32(id, payload, offs);
-                offs += 4U;
+        for (const std::vector<uint8_t>& payload : payloads) {
+            if (m_debug) {
+                uint32_t len = GET_UINT32(payload, 0U);
+                LogDebug(LOG_NET, "PEER %u (%s) whitelisting %u RIDs", peerId, connection->identity().c_str(), len);
             }
 
-            writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_BL_RID },
-                payload, bufSize, streamId, true);
+            writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_WL_RID },
+                payload.data(), payload.size(), streamId, true);
         }
 
         connection->lastPing(now);
     }
 }
 
-/* Helper to send the list of active TGIDs to the specified peer. */
+/* Helper to send a list of blacklisted RIDs to the specified peer. */
 
-void FNENetwork::writeTGIDs(uint32_t peerId, uint32_t streamId, bool isExternalPeer)
+void FNENetwork::writeBlacklistRIDs(uint32_t peerId, uint32_t streamId, const ACLPayloadList& payloads)
 {
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
-    if (!m_tidLookup->sendTalkgroups()) {
+    if (payloads.size() == 0U) {
         return;
     }
 
-    // sending PEER_LINK style TGID list to external peers
-    if (isExternalPeer) {
-        FNEPeerConnection* connection = m_peers[peerId];
-        if (connection != nullptr) {
-            std::string filename = m_tidLookup->filename();
-            if (filename.empty()) {
-                return;
-            }
-
-            // read entire file into string buffer
-            std::stringstream b;
-            std::ifstream stream(filename);
-            if (stream.is_open()) {
-                while (stream.peek() != EOF) {
-                    b << (char)stream.get();
-                }
-
-                stream.close();
-            }
-
-            // convert to a byte array
-            uint32_t len = b.str().size();
-            DECLARE_UINT8_ARRAY(buffer, len);
-            ::memcpy(buffer, b.str().data(), len);
-
-            PacketBuffer pkt(true, "Peer-Link, TGID List");
-            pkt.encode((uint8_t*)buffer, len);
-
-            LogInfoEx(LOG_NET, "PEER %u Peer-Link, TGID List, blocks %u, streamId = %u", peerId, pkt.fragments.size(), streamId);
-            if (pkt.fragments.size() > 0U) {
-                for (auto frag : pkt.fragments) {
-                    writePeer(peerId, { NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_TALKGROUP_LIST }, 
-                        frag.second->data, FRAG_SIZE, 0U, streamId, false, true, true);
-                    Thread::sleep(60U); // pace block transmission
-                }
-            }
-        }
-
-        return;
-    }
-
-    std::vector<std::pair<uint32_t, uint8_t>> tgidList;
-    auto groupVoice = m_tidLookup->groupVoice();
-    for (auto entry : groupVoice) {
-        std::vector<uint32_t> inclusion = entry.config().inclusion();
-        std::vector<uint32_t> exclusion = entry.config().exclusion();
-        std::vector<uint32_t> preferred = entry.config().preferred();
-
-        // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
-                // LogDebug(LOG_NET, "PEER %u TGID %u TS %u -- not included peer", peerId, entry.source().tgId(), entry.source().tgSlot());
-                continue;
-            }
-        }
-        else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
-                    // LogDebug(LOG_NET, "PEER %u TGID %u TS %u -- excluded peer", peerId, entry.source().tgId(), entry.source().tgSlot());
-                    continue;
-                }
+    // send a chunk of RIDs to the peer
+    FNEPeerConnection* connection = m_peers[peerId];
+    if (connection != nullptr) {
+        for (const std::vector<uint8_t>& payload : payloads) {
+            if (m_debug) {
+                uint32_t len = GET_UINT32(payload, 0U);
+                LogDebug(LOG_NET, "PEER %u (%s) blacklisting %u RIDs", peerId, connection->identity().c_str(), len);
             }
-        }
 
-        // determine if the peer is non-preferred
-        bool nonPreferred = false;
-        if (preferred.size() > 0) {
-            auto it = std::find(preferred.begin(), preferred.end(), peerId);
-            if (it == preferred.end()) {
-                nonPreferred = true;
-            }
+            writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_BL_RID },
+                payload.data(), payload.size(), streamId, true);
         }
 
-        if (entry.config().active()) {
-            uint8_t slotNo = entry.source().tgSlot();
-
-            // set the $80 bit of the slot number to flag non-preferred
-            if (nonPreferred) {
-                slotNo |= 0x80U;
-            }
-
-            // set the $40 bit of the slot number to identify if this TG is by affiliation or not
-            if (entry.config().affiliated()) {
-                slotNo |= 0x40U;
-            }
-
-            tgidList.push_back({ entry.source().tgId(), slotNo });
-        }
+        connection->lastPing(now);
     }
+}
 
-    // build dataset
-    DECLARE_UINT8_ARRAY(payload, 4U + (tgidList.size() * 5U));
-
-    SET_UINT32(tgidList.size(), payload, 0U);
+/* Helper to send a list of active TGIDs to the specified peer. */
 
-    // write talkgroup IDs to active TGID payload
-    uint32_t offs = 4U;
-    for (std::pair<uint32_t, uint8_t> tg : tgidList) {
-        if (m_debug) {
-            std::string peerIdentity = resolvePeerIdentity(peerId);
+void FNENetwork::writeTGIDs(uint32_t peerId, uint32_t streamId, const std::vector<std::pair<uint32_t, uint8_t>>& tgidList)
+{
+    if (m_debug) {
+        std::string peerIdentity = resolvePeerIdentity(peerId);
+        for (std::pair<uint32_t, uint8_t> tg : tgidList) {
             LogDebug(LOG_NET, "PEER %u (%s) activating TGID %u TS %u", peerId, peerIdentity.c_str(),
                 tg.first, tg.second);
         }
-        SET_UINT32(tg.first, payload, offs);
-        payload[offs + 4U] = tg.second;
-        offs += 5U;
     }
 
+    std::vector<uint8_t> payload = ACLSnapshot::encodeTGIDs(tgidList);
     writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_ACTIVE_TGS },
-        payload, 4U + (tgidList.size() * 5U), streamId, true);
+        payload.data(), payload.size(), streamId, true);
 }
 
-/* Helper to send the list of deactivated TGIDs to the specified peer. */
+/* Helper to send a list of deactivated TGIDs to the specified peer. */
 
-void FNENetwork::writeDeactiveTGIDs(uint32_t peerId, uint32_t streamId)
+void FNENetwork::writeDeactiveTGIDs(uint32_t peerId, uint32_t streamId, const std::vector<std::pair<uint32_t, uint8_t>>& tgidList)
 {
-    if (!m_tidLookup->sendTalkgroups()) {
-        return;
-    }
-
-    std::vector<std::pair<uint32_t, uint8_t>> tgidList;
-    auto groupVoice = m_tidLookup->groupVoice();
-    for (auto entry : groupVoice) {
-        std::vector<uint32_t> inclusion = entry.config().inclusion();
-        std::vector<uint32_t> exclusion = entry.config().exclusion();
-
-        // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
-                // LogDebug(LOG_NET, "PEER %u TGID %u TS %u -- not included peer", peerId, entry.source().tgId(), entry.source().tgSlot());
-                continue;
-            }
-        }
-        else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
-                    // LogDebug(LOG_NET, "PEER %u TGID %u TS %u -- excluded peer", peerId, entry.source().tgId(), entry.source().tgSlot());
-                    continue;
-                }
-            }
-        }
-
-        if (!entry.config().active()) {
-            tgidList.push_back({ entry.source().tgId(), entry.source().tgSlot() });
-        }
-    }
-
-    // build dataset
-    DECLARE_UINT8_ARRAY(payload, 4U + (tgidList.size() * 5U));
-
-    SET_UINT32(tgidList.size(), payload, 0U);
-
-    // write talkgroup IDs to deactive TGID payload
-    uint32_t offs = 4U;
-    for (std::pair<uint32_t, uint8_t> tg : tgidList) {
-        if (m_debug) {
-            std::string peerIdentity = resolvePeerIdentity(peerId);
+    if (m_debug) {
+        std::string peerIdentity = resolvePeerIdentity(peerId);
+        for (std::pair<uint32_t, uint8_t> tg : tgidList) {
             LogDebug(LOG_NET, "PEER %u (%s) deactivating TGID %u TS %u", peerId, peerIdentity.c_str(),
                 tg.first, tg.second);
         }
-        SET_UINT32(tg.first, payload, offs);
-        payload[offs + 4U] = tg.second;
-        offs += 5U;
     }
 
-    writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_DEACTIVE_TGS }, 
-        payload, 4U + (tgidList.size() * 5U), streamId, true);
+    std::vector<uint8_t> payload = ACLSnapshot::encodeTGIDs(tgidList);
+    writePeerCommand(peerId, { NET_FUNC::MASTER, NET_SUBFUNC::MASTER_SUBFUNC_DEACTIVE_TGS },
+        payload.data(), payload.size(), streamId, true);
 }
 
-/* Helper to send the list of peers to the specified peer. */
+/* Helper to send a Peer-Link list file to the specified peer. */
 
-void FNENetwork::writePeerList(uint32_t peerId, uint32_t streamId)
+uint32_t FNENetwork::writePeerLinkList(uint32_t peerId, uint32_t streamId, ACLCache::PeerLinkFileType type, uint32_t lastVersion, bool force)
 {
-    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-
-    // sending PEER_LINK style RID list to external peers
-    FNEPeerConnection* connection = m_peers[peerId];
-    if (connection != nullptr) {
-        std::string filename = m_peerListLookup->filename();
-        if (filename.empty()) {
-            return;
-        }
-
-        // read entire file into string buffer
-        std::stringstream b;
-        std::ifstream stream(filename);
-        if (stream.is_open()) {
-            while (stream.peek() != EOF) {
-                b << (char)stream.get();
-            }
+    std::string filename;
+    NET_SUBFUNC::ENUM subFunc = NET_SUBFUNC::PL_RID_LIST;
+    const char* name = "RID List";
+    switch (type) {
+    case ACLCache::PL_FILE_TGID:
+        filename = m_tidLookup->filename();
+        subFunc = NET_SUBFUNC::PL_TALKGROUP_LIST;
+        name = "TGID List";
+        break;
+    case ACLCache::PL_FILE_PEER:
+        filename = m_peerListLookup->filename();
+        subFunc = NET_SUBFUNC::PL_PEER_LIST;
+        name = "PID List";
+        break;
+    default:
+        filename = m_ridLookup->filename();
+        break;
+    }
 
-            stream.close();
-        }
+    // the list file is read and encoded once, and shared by all Peer-Link peers
+    std::shared_ptr<const ACLPeerLinkFile> file = m_aclCache.peerLinkFile(type, filename);
+    if (file == nullptr) {
+        return lastVersion;
+    }
 
-        // convert to a byte array
-        uint32_t len = b.str().size();
-        DECLARE_UINT8_ARRAY(buffer, len);
-        ::memcpy(buffer, b.str().data(), len);
+    if (!force && file->version == lastVersion) {
+        LogInfoEx(LOG_NET, "PEER %u Peer-Link, %s is up to date, version = $%08X", peerId, name, file->version);
+        return lastVersion;
+    }
 
-        PacketBuffer pkt(true, "Peer-Link, PID List");
-        pkt.encode((uint8_t*)buffer, len);
+    LogInfoEx(LOG_NET, "PEER %u Peer-Link, %s, blocks %u, version = $%08X, streamId = %u", peerId, name, file->fragments.size(),
+        file->version, streamId);
 
-        LogInfoEx(LOG_NET, "PEER %u Peer-Link, PID List, blocks %u, streamId = %u", peerId, pkt.fragments.size(), streamId);
-        if (pkt.fragments.size() > 0U) {
-            for (auto frag : pkt.fragments) {
-                writePeer(peerId, { NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_PEER_LIST }, 
-                    frag.second->data, FRAG_SIZE, 0U, streamId, false, true, true);
-                Thread::sleep(60U); // pace block transmission
-            }
-        }
-    }
+    // the fragments are paced out from clock(), instead of holding this thread for the entire transfer
+    std::shared_ptr<const FragmentList> fragments(file, &file->fragments);
+    m_peerLinkPacer.enqueue(peerId, fragments, [this, peerId, subFunc, streamId](const uint8_t* data, uint32_t length) {
+        if (length != FRAG_SIZE)
+            return;
+        writePeer(peerId, { NET_FUNC::PEER_LINK, subFunc }, data, FRAG_SIZE, 0U, streamId, false, true, true);
+    });
 
-    return;
+    return file->version;
 }
 
 /* Helper to send a In-Call Control command to the specified peer. */
@@ -2218,9 +2393,8 @@ bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const
         LogError(LOG_NET, "BUGBUG: PEER %u, trying to send data with a streamId of 0?", peerId);
     }
 
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        FNEPeerConnection* connection = m_peers.at(peerId);
+    FNEPeerConnection* connection = nullptr;
+    if (m_peers.find(peerId, connection)) {
         if (connection != nullptr) {
             sockaddr_storage addr = connection->socketStorage();
             uint32_t addrLen = connection->sockStorageLen();
@@ -2229,20 +2403,60 @@ bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const
                 pktSeq = connection->incStreamPktSeq(streamId, pktSeq);
             }
 
+            uint64_t start = LatencyHistogram::now();
+            bool ret = true;
             if (directWrite)
-                return m_frameQueue->write(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
+                ret = m_frameQueue->write(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
             else {
                 m_frameQueue->enqueueMessage(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
-                if (queueOnly)
-                    return true;
-                return m_frameQueue->flushQueue();
+                if (!queueOnly)
+                    ret = m_frameQueue->flushQueue();
             }
+
+            m_writePeerLatency.recordSince(start);
+            return ret;
         }
     }
 
     return false;
 }
 
+/* Helper to queue a data message to a resolved destination peer with a explicit packet sequence. */
+
+void FNENetwork::writePeerQueue(const FanoutPeer& peer, FrameQueue::OpcodePair opcode, const uint8_t* data,
+    uint32_t length, uint16_t pktSeq, uint32_t streamId) const
+{
+    if (streamId == 0U) {
+        LogError(LOG_NET, "BUGBUG: PEER %u, trying to send data with a streamId of 0?", peer.peerId);
+    }
+
+    uint64_t start = LatencyHistogram::now();
+    sockaddr_storage addr = peer.address;
+    m_frameQueue->enqueueMessage(data, length, streamId, peer.peerId, m_peerId, opcode, pktSeq, addr, peer.addrLen);
+    m_writePeerLatency.recordSince(start);
+}
+
+/* Helper to queue a prepared data message to a resolved destination peer with a explicit packet sequence. */
+
+void FNENetwork::writePeerQueue(const FanoutPeer& peer, const FrameQueue::PreparedFrame& frame, uint16_t pktSeq) const
+{
+    if (frame.streamId == 0U) {
+        LogError(LOG_NET, "BUGBUG: PEER %u, trying to send data with a streamId of 0?", peer.peerId);
+    }
+
+    uint64_t start = LatencyHistogram::now();
+    PeerFanout::write(m_frameQueue, peer, frame, pktSeq);
+    m_writePeerLatency.recordSince(start);
+}
+
+/* Helper to prepare a data message that is repeated to many peers. */
+
+bool FNENetwork::prepareFrame(FrameQueue::PreparedFrame& frame, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+    uint32_t streamId) const
+{
+    return m_frameQueue->prepareMessage(frame, data, length, streamId, m_peerId, opcode);
+}
+
 /* Helper to send a command message to the specified peer. */
 
 bool FNENetwork::writePeerCommand(uint32_t peerId, FrameQueue::OpcodePair opcode,
@@ -2423,3 +2637,36 @@ void FNENetwork::processTEKResponse(p25::kmm::KeyItem* rspKi, uint8_t algId, uin
 
     m_keyQueueMutex.unlock();
 }
+
+/* Helper to report the packet handling latency, since the last report, to InfluxDB. */
+
+void FNENetwork::reportLatency()
+{
+    std::vector<LatencyHistogram*> histograms = latencyHistograms();
+    if (m_influxLatencySnapshots.size() != histograms.size()) {
+        m_influxLatencySnapshots.resize(histograms.size());
+    }
+
+    uint64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    for (size_t i = 0U; i < histograms.size(); i++) {
+        LatencyHistogramSnapshot snapshot = histograms[i]->snapshot();
+        LatencyHistogramSnapshot latency = snapshot.since(m_influxLatencySnapshots[i]);
+        m_influxLatencySnapshots[i] = snapshot;
+
+        if (latency.count() == 0U)
+            continue;
+
+        influxdb::QueryBuilder()
+            .meas("packet_latency")
+                .tag("stage", histograms[i]->name())
+                    .field("count", latency.count())
+                    .field("mean", latency.mean())
+                    .field("p50", latency.percentile(50.0))
+                    .field("p90", latency.percentile(90.0))
+                    .field("p99", latency.percentile(99.0))
+                    .field("p999", latency.percentile(99.9))
+                    .field("max", latency.max())
+                .timestamp(timestamp)
+            .requestAsync(m_influxServer);
+    }
+}
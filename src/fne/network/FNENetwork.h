@@ -25,6 +25,7 @@
 #define __FNE_NETWORK_H__
 
 #include "fne/Defines.h"
+#include "common/concurrent/rcu_unordered_map.h"
 #include "common/concurrent/unordered_map.h"
 #include "common/network/BaseNetwork.h"
 #include "common/network/json/json.h"
@@ -34,12 +35,20 @@
 #include "common/lookups/PeerListLookup.h"
 #include "common/network/Network.h"
 #include "common/network/PacketBuffer.h"
+#include "common/LatencyHistogram.h"
 #include "common/ThreadPool.h"
 #include "fne/network/influxdb/InfluxDB.h"
+#include "fne/network/ACLCache.h"
+#include "fne/network/FragmentPacer.h"
+#include "fne/network/NetworkShard.h"
+#include "fne/network/PeerFanout.h"
 #include "fne/CryptoContainer.h"
 
 #include <string>
 #include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <unordered_map>
 #include <mutex>
 
@@ -118,6 +127,12 @@ namespace network
             m_pingsReceived(0U),
             m_lastPing(0U),
             m_missedACLUpdates(0U),
+            m_aclUpdates(0U),
+            m_aclVersion(0U),
+            m_reportsACLVersion(false),
+            m_plRIDVersion(0U),
+            m_plTGIDVersion(0U),
+            m_plPeerVersion(0U),
             m_isExternalPeer(false),
             m_isConventionalPeer(false),
             m_isSysView(false),
@@ -147,6 +162,12 @@ namespace network
             m_pingsReceived(0U),
             m_lastPing(0U),
             m_missedACLUpdates(0U),
+            m_aclUpdates(0U),
+            m_aclVersion(0U),
+            m_reportsACLVersion(false),
+            m_plRIDVersion(0U),
+            m_plTGIDVersion(0U),
+            m_plPeerVersion(0U),
             m_isExternalPeer(false),
             m_isConventionalPeer(false),
             m_isSysView(false),
@@ -336,6 +357,30 @@ namespace network
          * @brief Number of missed ACL updates.
          */
         DECLARE_PROPERTY_PLAIN(uint32_t, missedACLUpdates);
+        /**
+         * @brief Number of ACL updates sent since the last full ACL update.
+         */
+        DECLARE_PROPERTY_PLAIN(uint32_t, aclUpdates);
+        /**
+         * @brief Version of the ACL lists the peer has (0 if unknown).
+         */
+        DECLARE_PROPERTY_PLAIN(uint32_t, aclVersion);
+        /**
+         * @brief Flag indicating the peer reports the version of the ACL lists it has.
+         */
+        DECLARE_PROPERTY_PLAIN(bool, reportsACLVersion);
+        /**
+         * @brief Version of the Peer-Link RID list last sent to the peer (0 if none).
+         */
+        DECLARE_PROPERTY_PLAIN(uint32_t, plRIDVersion);
+        /**
+         * @brief Version of the Peer-Link talkgroup rules last sent to the peer (0 if none).
+         */
+        DECLARE_PROPERTY_PLAIN(uint32_t, plTGIDVersion);
+        /**
+         * @brief Version of the Peer-Link peer list last sent to the peer (0 if none).
+         */
+        DECLARE_PROPERTY_PLAIN(uint32_t, plPeerVersion);
 
         /**
          * @brief Flag indicating this connection is from an external peer.
@@ -396,6 +441,7 @@ namespace network
         uint8_t* buffer = nullptr;          //! Raw data buffer
 
         uint64_t pktRxTime;                 //! Packet receive time
+        uint64_t pktQueueTime;              //! Packet worker queue time (monotonic, in microseconds)
     };
 
     // ---------------------------------------------------------------------------
@@ -518,6 +564,12 @@ namespace network
          */
         bool resetPeer(uint32_t peerId);
 
+        /**
+         * @brief Gets the packet handling latency histograms.
+         * @returns std::vector<LatencyHistogram*> Packet handling latency histograms, in packet handling order.
+         */
+        std::vector<LatencyHistogram*> latencyHistograms();
+
     private:
         friend class DiagNetwork;
         friend class callhandler::TagDMRData;
@@ -552,14 +604,20 @@ namespace network
 
         CryptoContainer* m_cryptoLookup;
 
+        ACLCache m_aclCache;
+        FragmentPacer m_peerLinkPacer;
+
         NET_CONN_STATUS m_status;
 
-        typedef std::pair<const uint32_t, network::FNEPeerConnection*> PeerMapPair;
-        concurrent::unordered_map<uint32_t, FNEPeerConnection*> m_peers;
+        concurrent::rcu_unordered_map<uint32_t, FNEPeerConnection*> m_peers;
         concurrent::unordered_map<uint32_t, json::array> m_peerLinkPeers;
-        typedef std::pair<const uint32_t, lookups::AffiliationLookup*> PeerAffiliationMapPair;
-        concurrent::unordered_map<uint32_t, lookups::AffiliationLookup*> m_peerAffiliations;
-        concurrent::unordered_map<uint32_t, std::vector<uint32_t>> m_ccPeerMap;
+        typedef std::pair<const uint32_t, std::shared_ptr<lookups::AffiliationLookup>> PeerAffiliationMapPair;
+        concurrent::rcu_unordered_map<uint32_t, std::shared_ptr<lookups::AffiliationLookup>> m_peerAffiliations;
+        lookups::AffiliationIndex m_affiliationIndex;
+        concurrent::rcu_unordered_map<uint32_t, std::vector<uint32_t>> m_ccPeerMap;
+        std::atomic<uint32_t> m_peerGeneration;
+        static const uint32_t TG_GENERATION_COUNT = 4096U;
+        std::atomic<uint32_t> m_tgGeneration[TG_GENERATION_COUNT];
         static std::timed_mutex m_keyQueueMutex;
         std::unordered_map<uint32_t, uint16_t> m_peerLinkKeyQueue;
 
@@ -587,6 +645,15 @@ namespace network
 
         uint32_t m_softConnLimit;
 
+        uint32_t m_recvBatchSize;
+        uint32_t m_sendWriterLatency;
+        std::vector<FrameQueue::RxFrame> m_rxFrames;
+
+        uint32_t m_socketShards;
+        std::vector<NetworkShard*> m_shards;
+        uint16_t m_workerCnt;
+        std::vector<uint32_t> m_workerAffinity;
+
         bool m_callInProgress;
 
         bool m_disallowAdjStsBcast;
@@ -612,10 +679,24 @@ namespace network
         std::string m_influxOrg;
         std::string m_influxBucket;
         bool m_influxLogRawData;
+        bool m_influxLogLatency;
+        uint32_t m_influxBatchInterval;
+        uint32_t m_influxBatchSize;
+        uint32_t m_influxMaxQueueSize;
         influxdb::ServerInfo m_influxServer;
 
         ThreadPool m_threadPool;
 
+        LatencyHistogram m_rxDispatchLatency;
+        LatencyHistogram m_rxProcessLatency;
+        LatencyHistogram m_dmrProcessLatency;
+        LatencyHistogram m_p25ProcessLatency;
+        LatencyHistogram m_nxdnProcessLatency;
+        mutable LatencyHistogram m_writePeerLatency;
+        LatencyHistogram m_txQueueLatency;
+        LatencyHistogram m_txWriteLatency;
+        std::vector<LatencyHistogramSnapshot> m_influxLatencySnapshots;
+
         bool m_disablePacketData;
         bool m_dumpPacketData;
         bool m_verbosePacketData;
@@ -623,12 +704,43 @@ namespace network
         bool m_reportPeerPing;
         bool m_verbose;
 
+        /**
+         * @brief Helper to read data frames from a socket and enqueue them to the worker thread pool.
+         * @param frameQueue Frame queue to read from.
+         * @param rxFrames Receive slab for batched reads.
+         * @param threadPool Worker thread pool to enqueue the frames to.
+         * @returns int Number of frames read.
+         */
+        int readNetwork(FrameQueue* frameQueue, std::vector<FrameQueue::RxFrame>& rxFrames, ThreadPool& threadPool);
+        /**
+         * @brief Helper to enqueue a received network message to the worker thread pool.
+         * @param threadPool Worker thread pool to enqueue the message to.
+         * @param[in] message Buffer containing the received message.
+         * @param length Length of the received message.
+         * @param address IP address the message was received from.
+         * @param addrLen 
+         * @param rtpHeader RTP Header.
+         * @param fneHeader FNE Header.
+         * @param pktRxTime Packet receive time.
+         */
+        void enqueueNetworkRx(ThreadPool& threadPool, const uint8_t* message, int length, const sockaddr_storage& address, uint32_t addrLen,
+            const frame::RTPHeader& rtpHeader, const frame::RTPFNEHeader& fneHeader, uint64_t pktRxTime);
         /**
          * @brief Entry point to process a given network packet.
          * @param req Instance of the NetPacketRequest structure.
          */
         static void taskNetworkRx(NetPacketRequest* req);
 
+        /**
+         * @brief Helper to open the additional receive shards.
+         * @returns bool True, if the receive shards were opened, otherwise false.
+         */
+        bool openShards();
+        /**
+         * @brief Helper to close the additional receive shards.
+         */
+        void closeShards();
+
         /**
          * @brief Checks if the passed peer ID is blocked from unit-to-unit traffic.
          * @param peerId Peer ID.
@@ -662,6 +774,12 @@ namespace network
          * @returns bool True, if peer was deleted, otherwise false.
          */
         void erasePeer(uint32_t peerId);
+        /**
+         * @brief Helper to release a peer connection that has been erased from the peers list.
+         * @note The connection is released once no peer list snapshot can still reference it.
+         * @param connection Instance of the FNEPeerConnection class.
+         */
+        void releasePeer(FNEPeerConnection* connection);
 
         /**
          * @brief Helper to resolve the peer ID to its identity string.
@@ -670,6 +788,43 @@ namespace network
          */
         std::string resolvePeerIdentity(uint32_t peerId);
 
+        /**
+         * @brief Helper to invalidate all talkgroup routes.
+         * @note This should be called whenever the peer list, peer configuration or the affiliations of many
+         *  talkgroups change (routes are checked against the talkgroup rules version on their own).
+         */
+        void invalidatePeerFanout() { m_peerGeneration++; }
+        /**
+         * @brief Helper to invalidate the route for the given talkgroup.
+         * @note This should be called whenever an affiliation to the given talkgroup changes.
+         * @param dstId Talkgroup ID.
+         */
+        void invalidateTalkgroupRoute(uint32_t dstId)
+        {
+            if (dstId != 0U)
+                m_tgGeneration[dstId % TG_GENERATION_COUNT]++;
+        }
+        /**
+         * @brief Helper to resolve the materialized route for the given talkgroup.
+         * @note The route is only resolved again if it was invalidated since it was last resolved, and the
+         *  table is emptied when the talkgroup rules change; the route includes every permitted peer, callers
+         *  are expected to skip the source peer. Private calls are never routed using the table.
+         * @param routes Table of resolved talkgroup routes.
+         * @param routeKey Route key (the talkgroup ID, combined with any call attributes that affect routing).
+         * @param dstId Talkgroup ID.
+         * @param permitted Function used to determine whether a given peer is permitted to receive the traffic.
+         * @returns FanoutPeerList List of resolved destination peers.
+         */
+        FanoutPeerList resolveTalkgroupRoute(TalkgroupRouteTable& routes, 
+            uint64_t routeKey, uint32_t dstId, const std::function<bool(uint32_t)>& permitted);
+        /**
+         * @brief Helper to resolve the list of destination peers for call traffic from the given peer.
+         * @param srcPeerId Source Peer ID.
+         * @param permitted Function used to determine whether a given peer is permitted to receive the traffic.
+         * @returns FanoutPeerList List of resolved destination peers.
+         */
+        FanoutPeerList resolvePeerFanout(uint32_t srcPeerId, const std::function<bool(uint32_t)>& permitted);
+
         /**
          * @brief Helper to complete setting up a repeater login request.
          * @param peerId Peer ID.
@@ -690,37 +845,67 @@ namespace network
         static void taskACLUpdate(ACLUpdateRequest* req);
 
         /**
-         * @brief Helper to send the list of whitelisted RIDs to the specified peer.
+         * @brief Helper to send the complete ACL lists of a snapshot to the specified peer.
+         * @param peerId Peer ID.
+         * @param streamId Stream ID for this message.
+         * @param snapshot ACL snapshot to send.
+         */
+        void writeACLLists(uint32_t peerId, uint32_t streamId, const std::shared_ptr<const ACLSnapshot>& snapshot);
+        /**
+         * @brief Helper to send the changes to the ACL lists between two snapshots to the specified peer.
          * @param peerId Peer ID.
          * @param streamId Stream ID for this message.
-         * @param sendISSI Flag indicating the RID transfer is to an external peer via ISSI.
+         * @param base ACL snapshot the peer has.
+         * @param snapshot ACL snapshot to send.
          */
-        void writeWhitelistRIDs(uint32_t peerId, uint32_t streamId, bool sendISSI);
+        void writeACLDelta(uint32_t peerId, uint32_t streamId, const std::shared_ptr<const ACLSnapshot>& base,
+            const std::shared_ptr<const ACLSnapshot>& snapshot);
         /**
-         * @brief Helper to send the list of blacklisted RIDs to the specified peer.
+         * @brief Helper to send the version of the ACL lists sent to the specified peer.
          * @param peerId Peer ID.
          * @param streamId Stream ID for this message.
+         * @param version ACL snapshot version.
          */
-        void writeBlacklistRIDs(uint32_t peerId, uint32_t streamId);
+        void writeACLVersion(uint32_t peerId, uint32_t streamId, uint32_t version);
         /**
-         * @brief Helper to send the list of active TGIDs to the specified peer.
+         * @brief Helper to send a list of whitelisted RIDs to the specified peer.
          * @param peerId Peer ID.
          * @param streamId Stream ID for this message.
-         * @param sendISSI Flag indicating the TGID transfer is to an external peer via ISSI.
+         * @param payloads Encoded whitelisted RIDs.
          */
-        void writeTGIDs(uint32_t peerId, uint32_t streamId, bool sendISSI);
+        void writeWhitelistRIDs(uint32_t peerId, uint32_t streamId, const ACLPayloadList& payloads);
         /**
-         * @brief Helper to send the list of deactivated TGIDs to the specified peer.
+         * @brief Helper to send a list of blacklisted RIDs to the specified peer.
          * @param peerId Peer ID.
          * @param streamId Stream ID for this message.
+         * @param payloads Encoded blacklisted RIDs.
          */
-        void writeDeactiveTGIDs(uint32_t peerId, uint32_t streamId);
+        void writeBlacklistRIDs(uint32_t peerId, uint32_t streamId, const ACLPayloadList& payloads);
         /**
-         * @brief Helper to send the list of peers to the specified peer.
+         * @brief Helper to send a list of active TGIDs to the specified peer.
          * @param peerId Peer ID.
          * @param streamId Stream ID for this message.
+         * @param tgidList List of talkgroup IDs and slot flags.
          */
-        void writePeerList(uint32_t peerId, uint32_t streamId);
+        void writeTGIDs(uint32_t peerId, uint32_t streamId, const std::vector<std::pair<uint32_t, uint8_t>>& tgidList);
+        /**
+         * @brief Helper to send a list of deactivated TGIDs to the specified peer.
+         * @param peerId Peer ID.
+         * @param streamId Stream ID for this message.
+         * @param tgidList List of talkgroup IDs and slots.
+         */
+        void writeDeactiveTGIDs(uint32_t peerId, uint32_t streamId, const std::vector<std::pair<uint32_t, uint8_t>>& tgidList);
+        /**
+         * @brief Helper to send a Peer-Link list file to the specified peer.
+         * @note The list file fragments are queued to the Peer-Link pacer, and are written from clock().
+         * @param peerId Peer ID.
+         * @param streamId Stream ID for this message.
+         * @param type Peer-Link list file type.
+         * @param lastVersion Version of the list file last sent to the peer.
+         * @param force Flag indicating the list file should be sent even if the peer has the current version.
+         * @returns uint32_t Version of the list file the peer has.
+         */
+        uint32_t writePeerLinkList(uint32_t peerId, uint32_t streamId, ACLCache::PeerLinkFileType type, uint32_t lastVersion, bool force);
         
         /**
          * @brief Helper to send a In-Call Control command to the specified peer.
@@ -749,6 +934,37 @@ namespace network
         bool writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, 
             uint16_t pktSeq, uint32_t streamId, bool queueOnly, bool incPktSeq = false, bool directWrite = false) const;
 
+        /**
+         * @brief Helper to queue a data message to a resolved destination peer with a explicit packet sequence.
+         * @param peer Resolved destination peer.
+         * @param opcode FNE network opcode pair.
+         * @param[in] data Buffer containing message to send to peer.
+         * @param length Length of buffer.
+         * @param pktSeq RTP packet sequence for this message.
+         * @param streamId Stream ID for this message.
+         */
+        void writePeerQueue(const FanoutPeer& peer, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, 
+            uint16_t pktSeq, uint32_t streamId) const;
+        /**
+         * @brief Helper to queue a prepared data message to a resolved destination peer with a explicit packet sequence.
+         * @param peer Resolved destination peer.
+         * @param frame Prepared frame (see prepareFrame()).
+         * @param pktSeq RTP packet sequence for this message.
+         */
+        void writePeerQueue(const FanoutPeer& peer, const FrameQueue::PreparedFrame& frame, uint16_t pktSeq) const;
+        /**
+         * @brief Helper to prepare a data message that is repeated to many peers.
+         * @param[out] frame Prepared frame.
+         * @param opcode FNE network opcode pair.
+         * @param[in] data Buffer containing message to send to peers (this must remain unchanged while the
+         *  prepared frame is used).
+         * @param length Length of buffer.
+         * @param streamId Stream ID for this message.
+         * @returns bool True, if the message was prepared, otherwise false.
+         */
+        bool prepareFrame(FrameQueue::PreparedFrame& frame, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+            uint32_t streamId) const;
+
         /**
          * @brief Helper to send a command message to the specified peer.
          * @param peerId Peer ID.
@@ -802,6 +1018,11 @@ namespace network
          * @param keyLength Length of key in bytes.
          */
         void processTEKResponse(p25::kmm::KeyItem* ki, uint8_t algId, uint8_t keyLength);
+
+        /**
+         * @brief Helper to report the packet handling latency, since the last report, to InfluxDB.
+         */
+        void reportLatency();
     };
 } // namespace network
 
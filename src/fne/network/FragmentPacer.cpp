@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "fne/network/FragmentPacer.h"
+
+using namespace network;
+
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the FragmentPacer class. */
+
+FragmentPacer::FragmentPacer(uint32_t interval) :
+    m_interval(interval),
+    m_mutex(),
+    m_destinations()
+{
+    /* stub */
+}
+
+/* Queues a transfer to a destination. */
+
+void FragmentPacer::enqueue(uint32_t key, std::shared_ptr<const FragmentList> fragments, FragmentWriter writer)
+{
+    if (fragments == nullptr || fragments->empty() || writer == nullptr)
+        return;
+
+    Transfer transfer;
+    transfer.fragments = fragments;
+    transfer.next = 0U;
+    transfer.writer = writer;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_destinations.find(key);
+    if (it == m_destinations.end()) {
+        // the first fragment to an idle destination is written on the next clock
+        Destination destination;
+        destination.nextTime = 0U;
+        it = m_destinations.insert({ key, destination }).first;
+    }
+
+    it->second.transfers.push_back(transfer);
+}
+
+/* Cancels all transfers queued to a destination. */
+
+void FragmentPacer::cancel(uint32_t key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_destinations.erase(key);
+}
+
+/* Writes the fragments that are due. */
+
+uint32_t FragmentPacer::clock(uint64_t now)
+{
+    std::vector<std::pair<Transfer, size_t>> due;
+
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_destinations.begin(); it != m_destinations.end();) {
+            Destination& destination = it->second;
+            if (destination.nextTime > now) {
+                ++it;
+                continue;
+            }
+
+            // an idle destination is only forgotten once its last fragment has been paced out
+            if (destination.transfers.empty()) {
+                it = m_destinations.erase(it);
+                continue;
+            }
+
+            Transfer& transfer = destination.transfers.front();
+            due.push_back({ transfer, transfer.next });
+            destination.nextTime = now + m_interval;
+
+            if (++transfer.next >= transfer.fragments->size())
+                destination.transfers.pop_front();
+
+            ++it;
+        }
+    }
+
+    // fragments are written outside of the lock, the writer may queue further transfers
+    for (auto& entry : due) {
+        const std::vector<uint8_t>& fragment = (*entry.first.fragments)[entry.second];
+        entry.first.writer(fragment.data(), (uint32_t)fragment.size());
+    }
+
+    return (uint32_t)due.size();
+}
+
+/* Gets the number of fragments still queued. */
+
+uint32_t FragmentPacer::pending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t count = 0U;
+    for (auto& entry : m_destinations) {
+        for (const Transfer& transfer : entry.second.transfers)
+            count += (uint32_t)(transfer.fragments->size() - transfer.next);
+    }
+
+    return count;
+}
+
+/* Gets the current monotonic time in milliseconds. */
+
+uint64_t FragmentPacer::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file FragmentPacer.h
+ * @ingroup fne_network
+ * @file FragmentPacer.cpp
+ * @ingroup fne_network
+ */
+#if !defined(__FRAGMENT_PACER_H__)
+#define __FRAGMENT_PACER_H__
+
+#include "fne/Defines.h"
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @addtogroup fne_network
+     * @{
+     */
+
+    const uint32_t FRAGMENT_PACING_INTERVAL = 60U;
+
+    /** @} */
+
+    /**
+     * @brief List of encoded packet buffer fragments, in block order.
+     * @ingroup fne_network
+     */
+    typedef std::vector<std::vector<uint8_t>> FragmentList;
+    /**
+     * @brief Callback used to write a single fragment to the network.
+     * @ingroup fne_network
+     */
+    typedef std::function<void(const uint8_t* data, uint32_t length)> FragmentWriter;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a pacer for large packet buffer transfers (such as Peer-Link list files).
+     * @note Fragments were previously paced by sleeping the sending thread between every block, which held a
+     *  network worker (or the main loop) for the entire transfer. Transfers are instead queued per destination
+     *  and a single fragment per destination is written every pacing interval from clock(). Transfers to the
+     *  same destination are written one after another, in the order they were queued.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API FragmentPacer {
+    public:
+        /**
+         * @brief Initializes a new instance of the FragmentPacer class.
+         * @param interval Interval between fragments written to a destination (ms).
+         */
+        FragmentPacer(uint32_t interval = FRAGMENT_PACING_INTERVAL);
+
+        /**
+         * @brief Queues a transfer to a destination.
+         * @param key Destination (generally a peer ID).
+         * @param fragments Fragments to write.
+         * @param writer Callback used to write each fragment.
+         */
+        void enqueue(uint32_t key, std::shared_ptr<const FragmentList> fragments, FragmentWriter writer);
+        /**
+         * @brief Cancels all transfers queued to a destination.
+         * @param key Destination.
+         */
+        void cancel(uint32_t key);
+
+        /**
+         * @brief Writes the fragments that are due.
+         * @param now Current monotonic time (ms, see now()).
+         * @returns uint32_t Number of fragments written.
+         */
+        uint32_t clock(uint64_t now);
+
+        /**
+         * @brief Gets the number of fragments still queued.
+         * @returns uint32_t Number of fragments still queued.
+         */
+        uint32_t pending() const;
+
+        /**
+         * @brief Gets the current monotonic time in milliseconds.
+         * @returns uint64_t Current monotonic time in milliseconds.
+         */
+        static uint64_t now();
+
+    private:
+        /**
+         * @brief Represents a single queued transfer.
+         */
+        struct Transfer {
+            std::shared_ptr<const FragmentList> fragments;
+            size_t next;
+            FragmentWriter writer;
+        };
+
+        /**
+         * @brief Represents the transfers queued to a destination.
+         */
+        struct Destination {
+            std::deque<Transfer> transfers;
+            uint64_t nextTime;
+        };
+
+        uint32_t m_interval;
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<uint32_t, Destination> m_destinations;
+    };
+} // namespace network
+
+#endif // __FRAGMENT_PACER_H__
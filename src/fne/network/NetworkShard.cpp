@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "fne/network/NetworkShard.h"
+#include "common/Log.h"
+
+using namespace network;
+
+#if !defined(_WIN32)
+#include <poll.h>
+#endif // !defined(_WIN32)
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the NetworkShard class. */
+
+NetworkShard::NetworkShard(const std::string& address, uint16_t port, uint32_t index, uint32_t peerId, uint32_t recvBatchSize, bool debug) :
+    m_index(index),
+    m_recvBatchSize(recvBatchSize),
+    m_socket(nullptr),
+    m_frameQueue(nullptr),
+    m_threadPool(nullptr),
+    m_rxFrames(),
+    m_handler(nullptr),
+    m_running(false),
+    m_thread()
+{
+    m_socket = new udp::Socket(address, port);
+    m_socket->setReusePort(true);
+
+    m_frameQueue = new FrameQueue(m_socket, peerId, debug);
+    if (m_recvBatchSize > 1U) {
+        m_frameQueue->setRxBatchCount(m_recvBatchSize);
+        m_rxFrames.reserve(m_recvBatchSize);
+    }
+
+    m_thread.obj = nullptr;
+}
+
+/* Finalizes a instance of the NetworkShard class. */
+
+NetworkShard::~NetworkShard()
+{
+    close();
+
+    if (m_threadPool != nullptr)
+        delete m_threadPool;
+    delete m_frameQueue;
+    delete m_socket;
+}
+
+/* Opens the socket, and starts the packet processing workers and the reader thread. */
+
+bool NetworkShard::open(const ThreadPool& primary, uint16_t workerCnt, const std::vector<uint32_t>& affinity, ShardReadHandler handler)
+{
+    if (m_running || handler == nullptr) {
+        return false;
+    }
+
+    if (!m_socket->open()) {
+        return false;
+    }
+
+    if (m_threadPool == nullptr) {
+        m_threadPool = new ThreadPool(workerCnt, "fne" + std::to_string(m_index));
+        m_threadPool->setMaxWorkerCnt(workerCnt);
+        m_threadPool->setLockFree(primary.isLockFree());
+        m_threadPool->setLockFreeQueueLen(primary.getLockFreeQueueLen());
+        m_threadPool->setSharded(primary.isSharded());
+        m_threadPool->setAffinity(affinity);
+    }
+
+    m_threadPool->start();
+
+    m_handler = handler;
+    m_running = true;
+    if (!Thread::runAsThread(this, threadReader, &m_thread)) {
+        m_thread.obj = nullptr;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/* Stops the reader thread and the packet processing workers, and closes the socket. */
+
+void NetworkShard::close()
+{
+    m_running = false;
+
+    if (m_thread.obj != nullptr) {
+#if defined(_WIN32)
+        ::WaitForSingleObject(m_thread.thread, INFINITE);
+        ::CloseHandle(m_thread.thread);
+#else
+        ::pthread_join(m_thread.thread, NULL);
+#endif // defined(_WIN32)
+        m_thread.obj = nullptr;
+    }
+
+    if (m_threadPool != nullptr) {
+        m_threadPool->stop();
+        m_threadPool->wait();
+    }
+
+    m_socket->close();
+}
+
+/* Helper to get the number of packet processing workers for each shard. */
+
+uint16_t NetworkShard::shardWorkerCnt(uint16_t workerCnt, uint32_t shards)
+{
+    if (shards <= 1U) {
+        return workerCnt;
+    }
+
+    uint16_t cnt = (uint16_t)(workerCnt / shards);
+    return (cnt > 0U) ? cnt : 1U;
+}
+
+/* Helper to get the key a received frame is dispatched to the packet processing workers with. */
+
+uint32_t NetworkShard::dispatchKey(uint32_t peerId, uint32_t streamId)
+{
+    uint32_t key = (peerId * 0x9E3779B1U) ^ streamId;
+    key ^= key >> 16;
+    return key;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Entry point to the reader thread. */
+
+void* NetworkShard::threadReader(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th == nullptr) {
+        return nullptr;
+    }
+
+    NetworkShard* shard = static_cast<NetworkShard*>(th->obj);
+    if (shard == nullptr) {
+        return nullptr;
+    }
+
+    std::string threadName = "fne:net" + std::to_string(shard->m_index);
+    LogMessage(LOG_HOST, "[ OK ] %s", threadName.c_str());
+#ifdef _GNU_SOURCE
+    ::pthread_setname_np(th->thread, threadName.c_str());
+#endif // _GNU_SOURCE
+
+    while (shard->m_running) {
+        if (shard->m_handler(shard->m_frameQueue, shard->m_rxFrames, *shard->m_threadPool) > 0)
+            continue;
+
+        // wait for the socket to become readable (this is bounded, so the thread notices when it is stopped)
+#if !defined(_WIN32)
+        struct pollfd pfd;
+        pfd.fd = shard->m_socket->getDescriptor();
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        ::poll(&pfd, 1, SHARD_POLL_TIME);
+#else
+        Thread::sleep(1U);
+#endif // !defined(_WIN32)
+    }
+
+    LogMessage(LOG_HOST, "[STOP] %s", threadName.c_str());
+    return nullptr;
+}
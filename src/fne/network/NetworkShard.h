@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file NetworkShard.h
+ * @ingroup fne_network
+ * @file NetworkShard.cpp
+ * @ingroup fne_network
+ */
+#if !defined(__NETWORK_SHARD_H__)
+#define __NETWORK_SHARD_H__
+
+#include "fne/Defines.h"
+#include "common/network/udp/Socket.h"
+#include "common/network/FrameQueue.h"
+#include "common/ThreadPool.h"
+#include "common/Thread.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @addtogroup fne_network
+     * @{
+     */
+
+    const uint32_t MAX_SOCKET_SHARDS = 16U;
+    const int SHARD_POLL_TIME = 100; // 100ms
+
+    /** @} */
+
+    /**
+     * @brief Callback used by a receive shard reader thread to read (and dispatch) frames from its socket.
+     * @ingroup fne_network
+     */
+    typedef std::function<int(FrameQueue* frameQueue, std::vector<FrameQueue::RxFrame>& rxFrames, ThreadPool& threadPool)> ShardReadHandler;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents an additional receive shard; a socket bound to the master port (with SO_REUSEPORT),
+     *  with its own reader thread and packet processing workers.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API NetworkShard {
+    public:
+        /**
+         * @brief Initializes a new instance of the NetworkShard class.
+         * @param address Address of the master port.
+         * @param port Master port.
+         * @param index Index of the shard (the primary socket is shard 0).
+         * @param peerId Unique ID of the FNE.
+         * @param recvBatchSize Maximum number of frames read from the socket per receive cycle.
+         * @param debug Flag indicating whether network debug is enabled.
+         */
+        NetworkShard(const std::string& address, uint16_t port, uint32_t index, uint32_t peerId, uint32_t recvBatchSize, bool debug);
+        /**
+         * @brief Finalizes a instance of the NetworkShard class.
+         */
+        ~NetworkShard();
+
+        /**
+         * @brief Opens the socket, and starts the packet processing workers and the reader thread.
+         * @param primary Thread pool of the primary socket (the workers of the shard are configured the same way).
+         * @param workerCnt Number of packet processing workers.
+         * @param affinity CPUs to pin the packet processing workers to.
+         * @param handler Callback used to read frames from the socket.
+         * @returns bool True, if the shard was opened, otherwise false.
+         */
+        bool open(const ThreadPool& primary, uint16_t workerCnt, const std::vector<uint32_t>& affinity, ShardReadHandler handler);
+        /**
+         * @brief Stops the reader thread and the packet processing workers, and closes the socket.
+         */
+        void close();
+
+        /**
+         * @brief Gets the index of the shard.
+         * @returns uint32_t Index of the shard.
+         */
+        uint32_t index() const { return m_index; }
+        /**
+         * @brief Gets the socket bound to the master port.
+         * @returns udp::Socket* Socket bound to the master port.
+         */
+        udp::Socket* socket() const { return m_socket; }
+        /**
+         * @brief Gets the packet processing workers for frames received on the socket.
+         * @returns ThreadPool* Packet processing workers.
+         */
+        ThreadPool* threadPool() const { return m_threadPool; }
+
+        /**
+         * @brief Helper to get the number of packet processing workers for each shard.
+         * @param workerCnt Total number of packet processing workers.
+         * @param shards Number of shards (including the primary socket).
+         * @returns uint16_t Number of packet processing workers for each shard.
+         */
+        static uint16_t shardWorkerCnt(uint16_t workerCnt, uint32_t shards);
+        /**
+         * @brief Helper to get the key a received frame is dispatched to the packet processing workers with.
+         * @note Frames for the same peer and stream always hash to the same worker, this keeps a call in-order
+         *  and keeps the per-stream state for a call on a single thread.
+         * @param peerId Peer ID.
+         * @param streamId Stream ID.
+         * @returns uint32_t Dispatch key.
+         */
+        static uint32_t dispatchKey(uint32_t peerId, uint32_t streamId);
+
+    private:
+        uint32_t m_index;
+        uint32_t m_recvBatchSize;
+
+        udp::Socket* m_socket;
+        FrameQueue* m_frameQueue;
+        ThreadPool* m_threadPool;
+        std::vector<FrameQueue::RxFrame> m_rxFrames;
+
+        ShardReadHandler m_handler;
+        std::atomic<bool> m_running;
+        thread_t m_thread;
+
+        /**
+         * @brief Entry point to the reader thread.
+         * @param arg Instance of the thread_t structure.
+         * @returns void* (Ignore)
+         */
+        static void* threadReader(void* arg);
+    };
+} // namespace network
+
+#endif // __NETWORK_SHARD_H__
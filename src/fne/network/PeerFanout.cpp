@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "fne/network/PeerFanout.h"
+#include "fne/network/FNENetwork.h"
+
+using namespace network;
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to resolve the list of destination peers for call traffic from the given peer. */
+
+FanoutPeerList PeerFanout::resolve(concurrent::rcu_unordered_map<uint32_t, FNEPeerConnection*>& peers,
+    uint32_t srcPeerId, const std::function<bool(uint32_t)>& permitted)
+{
+    std::vector<FanoutPeer>* resolved = new std::vector<FanoutPeer>();
+    resolved->reserve(peers.size());
+
+    for (auto peer : peers.snapshot()) {
+        if (srcPeerId == peer.first || peer.second == nullptr)
+            continue;
+
+        // is this peer ignored?
+        if (!permitted(peer.first))
+            continue;
+
+        FanoutPeer dst;
+        dst.peerId = peer.first;
+        dst.address = peer.second->socketStorage();
+        dst.addrLen = peer.second->sockStorageLen();
+        resolved->push_back(dst);
+    }
+
+    return FanoutPeerList(resolved);
+}
+
+/* Helper to resolve the materialized route for the given route key. */
+
+FanoutPeerList PeerFanout::resolveRoute(TalkgroupRouteTable& routes, uint64_t routeKey, uint32_t peerGeneration,
+    uint32_t tgGeneration, uint32_t rulesVersion, const std::function<FanoutPeerList()>& resolver)
+{
+    // a change of the talkgroup rules evicts every route, so routes of talkgroups removed from the rules
+    // don't linger in the table
+    uint32_t tableVersion = routes.rulesVersion.load();
+    if (tableVersion != rulesVersion && routes.rulesVersion.compare_exchange_strong(tableVersion, rulesVersion)) {
+        routes.routes.clear();
+    }
+
+    std::shared_ptr<TalkgroupRouteSlot> slot;
+    if (!routes.routes.find(routeKey, slot)) {
+        // this is the only time the route table itself changes, re-resolving a route only replaces the route
+        // held by its slot (insert leaves the slot of a concurrent first caller in place)
+        routes.routes.insert(routeKey, std::make_shared<TalkgroupRouteSlot>());
+        routes.routes.find(routeKey, slot);
+    }
+
+    std::shared_ptr<const TalkgroupRoute> route = std::atomic_load(&slot->route);
+    if (route != nullptr && route->peerGeneration == peerGeneration && route->tgGeneration == tgGeneration &&
+        route->rulesVersion == rulesVersion) {
+        return route->peers;
+    }
+
+    std::shared_ptr<TalkgroupRoute> resolved = std::make_shared<TalkgroupRoute>();
+    resolved->peerGeneration = peerGeneration;
+    resolved->tgGeneration = tgGeneration;
+    resolved->rulesVersion = rulesVersion;
+    resolved->peers = resolver();
+
+    std::atomic_store(&slot->route, std::shared_ptr<const TalkgroupRoute>(resolved));
+    return resolved->peers;
+}
+
+/* Helper to queue a prepared data message to a resolved destination peer. */
+
+void PeerFanout::write(FrameQueue* frameQueue, const FanoutPeer& peer, const FrameQueue::PreparedFrame& frame, uint16_t pktSeq)
+{
+    sockaddr_storage addr = peer.address;
+    frameQueue->enqueueMessage(frame, peer.peerId, pktSeq, addr, peer.addrLen);
+}
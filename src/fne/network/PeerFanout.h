@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PeerFanout.h
+ * @ingroup fne_network
+ * @file PeerFanout.cpp
+ * @ingroup fne_network
+ */
+#if !defined(__PEER_FANOUT_H__)
+#define __PEER_FANOUT_H__
+
+#include "fne/Defines.h"
+#include "common/concurrent/rcu_unordered_map.h"
+#include "common/network/FrameQueue.h"
+
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API FNEPeerConnection;
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a resolved destination peer for call traffic fan-out.
+     * @ingroup fne_network
+     */
+    struct FanoutPeer {
+        uint32_t peerId;                    //! Destination Peer ID.
+
+        sockaddr_storage address;           //! IP Address and Port.
+        uint32_t addrLen;                   //!
+    };
+
+    /**
+     * @brief Represents the list of resolved destination peers for a call stream.
+     * @ingroup fne_network
+     */
+    typedef std::shared_ptr<const std::vector<FanoutPeer>> FanoutPeerList;
+
+    /**
+     * @brief Represents a materialized talkgroup route (the destination peers permitted to receive traffic
+     *  for a given talkgroup).
+     * @note A route is valid for as long as neither the peer generation, the talkgroup generation or the
+     *  talkgroup rules version it was resolved at has changed.
+     * @ingroup fne_network
+     */
+    struct TalkgroupRoute {
+        uint32_t peerGeneration = 0U;       //! Peer generation the route was resolved at.
+        uint32_t tgGeneration = 0U;         //! Talkgroup generation the route was resolved at.
+        uint32_t rulesVersion = 0U;         //! Talkgroup rules version the route was resolved at.
+        FanoutPeerList peers;               //! Resolved destination peers.
+    };
+
+    /**
+     * @brief Represents the slot holding the current materialized route for a route key.
+     * @note The route in the slot is replaced atomically (with std::atomic_load/std::atomic_store), so
+     *  resolving a route again never has to copy the route table.
+     * @ingroup fne_network
+     */
+    struct TalkgroupRouteSlot {
+        std::shared_ptr<const TalkgroupRoute> route;  //! Current route.
+    };
+
+    /**
+     * @brief Represents a table of materialized talkgroup routes, by route key.
+     * @note Only group calls are routed using the table; every route is evicted when the talkgroup rules change.
+     * @ingroup fne_network
+     */
+    struct TalkgroupRouteTable {
+        concurrent::rcu_unordered_map<uint64_t, std::shared_ptr<TalkgroupRouteSlot>> routes;  //! Routes, by route key.
+        std::atomic<uint32_t> rulesVersion{0U};     //! Talkgroup rules version the routes were resolved at.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the resolution of call traffic fan-out lists and talkgroup routes, and the writing of
+     *  prepared frames to resolved destination peers.
+     * @note These are the helpers FNENetwork resolves and writes call traffic with; they only depend on the
+     *  peer map and frame queue they are given.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API PeerFanout {
+    public:
+        /**
+         * @brief Helper to resolve the list of destination peers for call traffic from the given peer.
+         * @param peers Map of peer connections, by peer ID.
+         * @param srcPeerId Source Peer ID.
+         * @param permitted Function used to determine whether a given peer is permitted to receive the traffic.
+         * @returns FanoutPeerList List of resolved destination peers.
+         */
+        static FanoutPeerList resolve(concurrent::rcu_unordered_map<uint32_t, FNEPeerConnection*>& peers,
+            uint32_t srcPeerId, const std::function<bool(uint32_t)>& permitted);
+        /**
+         * @brief Helper to resolve the materialized route for the given route key.
+         * @note The route is only resolved again if any of the given generations differ from the ones it was
+         *  last resolved at, and the table is emptied when the talkgroup rules version changes.
+         * @param routes Table of resolved talkgroup routes.
+         * @param routeKey Route key.
+         * @param peerGeneration Current peer generation.
+         * @param tgGeneration Current talkgroup generation.
+         * @param rulesVersion Current talkgroup rules version.
+         * @param resolver Function used to resolve the destination peers of the route.
+         * @returns FanoutPeerList List of resolved destination peers.
+         */
+        static FanoutPeerList resolveRoute(TalkgroupRouteTable& routes, uint64_t routeKey, uint32_t peerGeneration,
+            uint32_t tgGeneration, uint32_t rulesVersion, const std::function<FanoutPeerList()>& resolver);
+
+        /**
+         * @brief Helper to queue a prepared data message to a resolved destination peer.
+         * @param frameQueue Frame queue to queue the message to.
+         * @param peer Resolved destination peer.
+         * @param frame Prepared frame.
+         * @param pktSeq RTP packet sequence for this packet.
+         */
+        static void write(FrameQueue* frameQueue, const FanoutPeer& peer, const FrameQueue::PreparedFrame& frame, uint16_t pktSeq);
+    };
+} // namespace network
+
+#endif // __PEER_FANOUT_H__
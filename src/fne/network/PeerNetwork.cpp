@@ -39,7 +39,8 @@ PeerNetwork::PeerNetwork(const std::string& address, uint16_t port, uint16_t loc
     m_peerLinkSavesACL(false),
     m_tgidPkt(true, "Peer-Link, TGID List"),
     m_ridPkt(true, "Peer-Link, RID List"),
-    m_pidPkt(true, "Peer-Link, PID List")
+    m_pidPkt(true, "Peer-Link, PID List"),
+    m_peerLinkPacer()
 {
     assert(!address.empty());
     assert(port > 0U);
@@ -52,6 +53,16 @@ PeerNetwork::PeerNetwork(const std::string& address, uint16_t port, uint16_t loc
     m_neverDisableOnACLNAK = true;
 }
 
+/* Updates the timer by the passed number of milliseconds. */
+
+void PeerNetwork::clock(uint32_t ms)
+{
+    // write any Peer-Link fragments that are due
+    m_peerLinkPacer.clock(FragmentPacer::now());
+
+    Network::clock(ms);
+}
+
 /* Sets the instances of the Peer List lookup tables. */
 
 void PeerNetwork::setPeerLookups(lookups::PeerListLookup* pidLookup)
@@ -121,11 +132,17 @@ bool PeerNetwork::writePeerLinkPeers(json::array* peerList)
         uint32_t streamId = createStreamId();
         LogInfoEx(LOG_NET, "PEER %u Peer-Link, Active Peer List, blocks %u, streamId = %u", m_peerId, pkt.fragments.size(), streamId);
         if (pkt.fragments.size() > 0U) {
+            // the fragments are paced out from clock(), instead of holding the caller for the entire transfer
+            std::shared_ptr<FragmentList> fragments = std::make_shared<FragmentList>(pkt.fragments.size());
             for (auto frag : pkt.fragments) {
-                writeMaster({ NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_ACT_PEER_LIST }, 
-                    frag.second->data, FRAG_SIZE, RTP_END_OF_CALL_SEQ, streamId, false, true);
-                Thread::sleep(60U); // pace block transmission
+                if (frag.first < fragments->size())
+                    (*fragments)[frag.first].assign(frag.second->data, frag.second->data + FRAG_SIZE);
             }
+
+            m_peerLinkPacer.enqueue(m_peerId, fragments, [this, streamId](const uint8_t* data, uint32_t length) {
+                writeMaster({ NET_FUNC::PEER_LINK, NET_SUBFUNC::PL_ACT_PEER_LIST }, 
+                    data, length, RTP_END_OF_CALL_SEQ, streamId, false, true);
+            });
         }
 
         return true;
@@ -20,6 +20,7 @@
 #include "common/lookups/PeerListLookup.h"
 #include "common/network/Network.h"
 #include "common/network/PacketBuffer.h"
+#include "fne/network/FragmentPacer.h"
 
 #include <string>
 #include <cstdint>
@@ -58,6 +59,12 @@ namespace network
         PeerNetwork(const std::string& address, uint16_t port, uint16_t localPort, uint32_t peerId, const std::string& password,
             bool duplex, bool debug, bool dmr, bool p25, bool nxdn, bool slot1, bool slot2, bool allowActivityTransfer, bool allowDiagnosticTransfer, bool updateLookup, bool saveLookup);
 
+        /**
+         * @brief Updates the timer by the passed number of milliseconds.
+         * @param ms Number of milliseconds.
+         */
+        void clock(uint32_t ms) override;
+
         /**
          * @brief Sets the instances of the Peer List lookup tables.
          * @param pidLookup Peer List Lookup Table Instance
@@ -150,6 +157,8 @@ namespace network
         PacketBuffer m_tgidPkt;
         PacketBuffer m_ridPkt;
         PacketBuffer m_pidPkt;
+
+        FragmentPacer m_peerLinkPacer;
     };
 } // namespace network
 
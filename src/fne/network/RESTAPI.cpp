@@ -658,6 +658,9 @@ void RESTAPI::initializeEndpoints()
 
     m_dispatcher.match(FNE_GET_AFF_LIST).get(REST_API_BIND(RESTAPI::restAPI_GetAffList, this));
 
+    m_dispatcher.match(FNE_GET_LATENCY).get(REST_API_BIND(RESTAPI::restAPI_GetLatency, this));
+    m_dispatcher.match(FNE_GET_LATENCY_RESET).get(REST_API_BIND(RESTAPI::restAPI_GetLatencyReset, this));
+
     /*
     ** Digital Mobile Radio
     */
@@ -848,7 +851,7 @@ void RESTAPI::restAPI_GetPeerQuery(const HTTPPayload& request, HTTPPayload& repl
     json::array peers = json::array();
     if (m_network != nullptr) {
         if (m_network->m_peers.size() > 0) {
-            for (auto entry : m_network->m_peers) {
+            for (auto entry : m_network->m_peers.snapshot()) {
                 uint32_t peerId = entry.first;
                 network::FNEPeerConnection* peer = entry.second;
                 if (peer != nullptr) {
@@ -1399,11 +1402,11 @@ void RESTAPI::restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply,
     json::array affs = json::array();
     if (m_network != nullptr) {
         if (m_network->m_peers.size() > 0) {
-            for (auto entry : m_network->m_peers) {
+            for (auto entry : m_network->m_peers.snapshot()) {
                 uint32_t peerId = entry.first;
                 network::FNEPeerConnection* peer = entry.second;
                 if (peer != nullptr) {
-                    lookups::AffiliationLookup* affLookup = m_network->m_peerAffiliations[peerId];
+                    std::shared_ptr<lookups::AffiliationLookup> affLookup = m_network->m_peerAffiliations[peerId];
                     if (affLookup != nullptr) {
                         std::unordered_map<uint32_t, uint32_t> affTable = affLookup->grpAffTable();
 
@@ -1435,6 +1438,66 @@ void RESTAPI::restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply,
     reply.payload(response);
 }
 
+/* REST API endpoint; implements get packet handling latency request. */
+
+void RESTAPI::restAPI_GetLatency(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    json::array stages = json::array();
+    if (m_network != nullptr) {
+        for (LatencyHistogram* histogram : m_network->latencyHistograms()) {
+            LatencyHistogramSnapshot latency = histogram->snapshot();
+
+            json::object stageObj = json::object();
+            stageObj["stage"].set<std::string>(histogram->name());
+            uint64_t count = latency.count();
+            stageObj["count"].set<uint64_t>(count);
+            uint64_t mean = latency.mean();
+            stageObj["mean"].set<uint64_t>(mean);
+            uint64_t p50 = latency.percentile(50.0);
+            stageObj["p50"].set<uint64_t>(p50);
+            uint64_t p90 = latency.percentile(90.0);
+            stageObj["p90"].set<uint64_t>(p90);
+            uint64_t p99 = latency.percentile(99.0);
+            stageObj["p99"].set<uint64_t>(p99);
+            uint64_t p999 = latency.percentile(99.9);
+            stageObj["p999"].set<uint64_t>(p999);
+            uint64_t max = latency.max();
+            stageObj["max"].set<uint64_t>(max);
+            stages.push_back(json::value(stageObj));
+        }
+    }
+
+    response["latency"].set<json::array>(stages);
+    reply.payload(response);
+}
+
+/* REST API endpoint; implements reset packet handling latency request. */
+
+void RESTAPI::restAPI_GetLatencyReset(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    if (m_network != nullptr) {
+        for (LatencyHistogram* histogram : m_network->latencyHistograms()) {
+            histogram->reset();
+        }
+    }
+
+    reply.payload(response);
+}
+
 /*
 ** Digital Mobile Radio
 */
@@ -301,6 +301,21 @@ private:
      */
     void restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
 
+    /**
+     * @brief REST API endpoint; implements get packet handling latency request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetLatency(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements reset packet handling latency request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetLatencyReset(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+
     /*
     ** Digital Mobile Radio
     */
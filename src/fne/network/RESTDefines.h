@@ -51,4 +51,7 @@
 
 #define FNE_GET_AFF_LIST                "/report-affiliations"
 
+#define FNE_GET_LATENCY                 "/latency"
+#define FNE_GET_LATENCY_RESET           "/latency/reset"
+
 #endif // __FNE_REST_DEFINES_H__
@@ -47,6 +47,7 @@ TagDMRData::TagDMRData(FNENetwork* network, bool debug) :
     m_parrotFrames(),
     m_parrotFramesReady(false),
     m_status(),
+    m_routes(),
     m_debug(debug)
 {
     assert(network != nullptr);
@@ -297,35 +298,40 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                if (peerId != peer.first) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(peer.first, dmrData, streamId)) {
-                        continue;
-                    }
+            FanoutPeerList fanout = resolveFanout(peerId, dmrData, dstId, streamId, dataSync);
 
-                    // every 5 peers flush the queue
-                    if (i % 5U == 0U) {
-                        m_network->m_frameQueue->flushQueue();
-                    }
-
-                    DECLARE_UINT8_ARRAY(outboundPeerBuffer, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+            // the frame is encoded once and shared by every peer that doesn't require a route rewrite
+            FrameQueue::PreparedFrame frame;
+            if (!m_network->prepareFrame(frame, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, buffer, len, streamId)) {
+                LogError(LOG_NET, "DMR, failed to prepare frame for repeat, peer = %u, len = %u, stream = %u", peerId, len, streamId);
+                return false;
+            }
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, dmrData, dataType, dstId, slotNo);
+            DECLARE_UINT8_ARRAY(outboundPeerBuffer, len);
+            for (const FanoutPeer& peer : *fanout) {
+                // the talkgroup route includes the source peer, never repeat traffic back to it
+                if (peer.peerId == peerId)
+                    continue;
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId, true);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
-                            peerId, peer.first, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
-                    }
+                // perform TGID route rewrites if configured
+                uint32_t rewriteDstId = dstId;
+                uint32_t rewriteSlotNo = slotNo;
+                if (peerRewrite(peer.peerId, rewriteDstId, rewriteSlotNo)) {
+                    ::memcpy(outboundPeerBuffer, buffer, len);
+                    routeRewrite(outboundPeerBuffer, peer.peerId, dmrData, dataType, dstId, slotNo);
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
-                    i++;
+                    m_network->writePeerQueue(peer, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId);
                 }
+                else {
+                    m_network->writePeerQueue(peer, frame, pktSeq);
+                }
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
+                        peerId, peer.peerId, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
+                }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
             m_network->m_frameQueue->flushQueue();
         }
@@ -414,7 +420,7 @@ bool TagDMRData::processGrantReq(uint32_t srcId, uint32_t dstId, uint8_t slot, b
 
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 write_CSBK_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
             }
@@ -444,7 +450,7 @@ void TagDMRData::playbackParrot()
         }
         else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "DMR, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
@@ -555,26 +561,26 @@ void TagDMRData::routeRewrite(uint8_t* buffer, uint32_t peerId, dmr::data::NetDa
 
 bool TagDMRData::peerRewrite(uint32_t peerId, uint32_t& dstId, uint32_t& slotNo, bool outbound)
 {
-    lookups::TalkgroupRuleGroupVoice tg;
+    std::shared_ptr<const lookups::TalkgroupRulesIndex> tgIndex = m_network->m_tidLookup->index();
+    const lookups::TalkgroupRuleIndexEntry* tg = nullptr;
     if (outbound) {
-        tg = m_network->m_tidLookup->find(dstId);
+        tg = tgIndex->find(dstId);
     }
     else {
-        tg = m_network->m_tidLookup->findByRewrite(peerId, dstId);
+        tg = tgIndex->findByRewrite(peerId, dstId);
     }
 
     bool rewrote = false;
-    if (tg.config().rewriteSize() > 0) {
-        std::vector<lookups::TalkgroupRuleRewrite> rewrites = tg.config().rewrite();
-        for (auto entry : rewrites) {
+    if (tg != nullptr && tg->rewrite.size() > 0) {
+        for (const lookups::TalkgroupRuleRewrite& entry : tg->rewrite) {
             if (entry.peerId() == peerId) {
                 if (outbound) {
                     dstId = entry.tgId();
                     slotNo = entry.tgSlot();
                 }
                 else {
-                    dstId = tg.source().tgId();
-                    slotNo = tg.source().tgSlot();
+                    dstId = tg->tgId;
+                    slotNo = tg->tgSlot;
                 }
                 rewrote = true;
                 break;
@@ -661,7 +667,7 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
     FNEPeerConnection* connection = nullptr; // bryanb: this is a possible null ref concurrency issue
                                              //     it is possible if the timing is just right to get a valid 
                                              //     connection back initially, and then for it to be deleted
-    if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
+    if (peerId > 0 && (m_network->m_peers.contains(peerId))) {
         connection = m_network->m_peers[peerId];
     }
 
@@ -675,32 +681,25 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
 
     // is this a group call?
     if (data.getFLCO() == FLCO::GROUP) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(data.getDstId(), data.getSlotNo());
-
-        std::vector<uint32_t> inclusion = tg.config().inclusion();
-        std::vector<uint32_t> exclusion = tg.config().exclusion();
-
-        // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
-                return false;
+        std::shared_ptr<const lookups::TalkgroupRulesIndex> tgIndex = m_network->m_tidLookup->index();
+        const lookups::TalkgroupRuleIndexEntry* tg = tgIndex->find(data.getDstId(), data.getSlotNo());
+        bool affiliated = (tg != nullptr) ? tg->affiliated : false;
+
+        if (tg != nullptr) {
+            // peer inclusion lists take priority over exclusion lists
+            if (tg->inclusion.size() > 0) {
+                if (!tg->isIncluded(peerId)) {
+                    return false;
+                }
             }
-        }
-        else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
+            else {
+                if (tg->isExcluded(peerId)) {
                     return false;
                 }
             }
-        }
 
-        // peer always send list takes priority over any following affiliation rules
-        std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-        if (alwaysSend.size() > 0) {
-            auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-            if (it != alwaysSend.end()) {
+            // peer always send list takes priority over any following affiliation rules
+            if (tg->isAlwaysSend(peerId)) {
                 return true; // skip any following checks and always send traffic
             }
         }
@@ -725,24 +724,16 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
 
         // is this a TG that requires affiliations to repeat?
         // NOTE: external peers *always* repeat traffic regardless of affiliation
-        if (tg.config().affiliated() && !external) {
+        if (affiliated && !external) {
             uint32_t lookupPeerId = peerId;
             if (connection != nullptr) {
                 if (connection->ccPeerId() > 0U)
                     lookupPeerId = connection->ccPeerId();
             }
 
-            // check the affiliations for this peer to see if we can repeat traffic
-            lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
-            if (aff == nullptr) {
-                std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
-                //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
-                return false; // this will cause no traffic to pass for this peer now...I'm not sure this is good behavior
-            }
-            else {
-                if (!aff->hasGroupAff(data.getDstId())) {
-                    return false;
-                }
+            // check the aggregated affiliations to see if this peer has affiliations and we can repeat traffic
+            if (!m_network->m_affiliationIndex.isAffiliated(data.getDstId(), lookupPeerId)) {
+                return false;
             }
         }
     }
@@ -750,6 +741,28 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
     return true;
 }
 
+/* Helper to resolve the list of peers permitted to receive the call traffic. */
+
+FanoutPeerList TagDMRData::resolveFanout(uint32_t peerId, data::NetData& dmrData, uint32_t dstId, uint32_t streamId, bool dataSync)
+{
+    auto permitted = [&](uint32_t dstPeerId) { return isPeerPermitted(dstPeerId, dmrData, streamId); };
+
+    // only voice frames are routed using the talkgroup route table; headers, terminators and CSBKs are 
+    // filtered frame by frame
+    if (dataSync) {
+        return m_network->resolvePeerFanout(peerId, permitted);
+    }
+
+    // private calls are filtered frame by frame, the route table would otherwise grow with every unit called
+    if (dmrData.getFLCO() == FLCO::PRIVATE) {
+        return m_network->resolvePeerFanout(peerId, permitted);
+    }
+
+    // talkgroups are routed per slot
+    uint64_t routeKey = (uint64_t)dstId | ((uint64_t)dmrData.getSlotNo() << 32);
+    return m_network->resolveTalkgroupRoute(m_routes, routeKey, dstId, permitted);
+}
+
 /* Helper to validate the DMR call stream. */
 
 bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamId)
@@ -986,7 +999,7 @@ bool TagDMRData::write_CSBK_Grant(uint32_t peerId, uint32_t srcId, uint32_t dstI
     }
 
     // check the affiliations for this peer to see if we can grant traffic
-    lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[peerId];
+    std::shared_ptr<lookups::AffiliationLookup> aff = m_network->m_peerAffiliations[peerId];
     if (aff == nullptr) {
         std::string peerIdentity = m_network->resolvePeerIdentity(peerId);
         LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", peerId, peerIdentity.c_str());
@@ -1095,7 +1108,7 @@ void TagDMRData::write_CSBK(uint32_t peerId, uint8_t slot, lc::CSBK* csbk)
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 // every 5 peers flush the queue
                 if (i % 5U == 0U) {
                     m_network->m_frameQueue->flushQueue();
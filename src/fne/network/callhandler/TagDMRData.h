@@ -18,6 +18,7 @@
 
 #include "fne/Defines.h"
 #include "common/concurrent/deque.h"
+#include "common/concurrent/rcu_unordered_map.h"
 #include "common/concurrent/unordered_map.h"
 #include "common/dmr/DMRDefines.h"
 #include "common/dmr/data/NetData.h"
@@ -197,6 +198,7 @@ namespace network
             };
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             concurrent::unordered_map<uint32_t, RxStatus> m_status;
+            TalkgroupRouteTable m_routes;
 
             friend class packetdata::DMRPacketData;
             packetdata::DMRPacketData* m_packetData;
@@ -242,6 +244,17 @@ namespace network
              * @returns bool True, if valid, otherwise false.
              */
             bool isPeerPermitted(uint32_t peerId, dmr::data::NetData& data, uint32_t streamId, bool external = false);
+            /**
+             * @brief Helper to resolve the list of peers permitted to receive the call traffic.
+             * @note Voice frames are routed using the materialized talkgroup route, which includes the source peer.
+             * @param peerId Source Peer ID.
+             * @param dmrData Instance of data::NetData DMR data container class.
+             * @param dstId Destination ID.
+             * @param streamId Stream ID.
+             * @param dataSync Flag indicating the frame is a data sync frame.
+             * @returns FanoutPeerList List of resolved destination peers.
+             */
+            FanoutPeerList resolveFanout(uint32_t peerId, dmr::data::NetData& dmrData, uint32_t dstId, uint32_t streamId, bool dataSync);
             /**
              * @brief Helper to validate the DMR call stream.
              * @param peerId Peer ID.
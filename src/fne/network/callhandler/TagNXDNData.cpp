@@ -48,7 +48,8 @@ TagNXDNData::TagNXDNData(FNENetwork* network, bool debug) :
     m_parrotFrames(),
     m_parrotFramesReady(false),
     m_status(),
-   m_debug(debug)
+    m_routes(),
+    m_debug(debug)
 {
     assert(network != nullptr);
 }
@@ -242,35 +243,39 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
 
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                if (peerId != peer.first) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(peer.first, lc, messageType, streamId)) {
-                        continue;
-                    }
+            FanoutPeerList fanout = resolveFanout(peerId, lc, messageType, dstId, streamId);
 
-                    // every 5 peers flush the queue
-                    if (i % 5U == 0U) {
-                        m_network->m_frameQueue->flushQueue();
-                    }
-
-                    DECLARE_UINT8_ARRAY(outboundPeerBuffer, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+            // the frame is encoded once and shared by every peer that doesn't require a route rewrite
+            FrameQueue::PreparedFrame frame;
+            if (!m_network->prepareFrame(frame, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, buffer, len, streamId)) {
+                LogError(LOG_NET, "NXDN, failed to prepare frame for repeat, peer = %u, len = %u, stream = %u", peerId, len, streamId);
+                return false;
+            }
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, messageType, dstId);
+            DECLARE_UINT8_ARRAY(outboundPeerBuffer, len);
+            for (const FanoutPeer& peer : *fanout) {
+                // the talkgroup route includes the source peer, never repeat traffic back to it
+                if (peer.peerId == peerId)
+                    continue;
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId, true);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
-                            peerId, peer.first, messageType, srcId, dstId, len, pktSeq, streamId, external);
-                    }
+                // perform TGID route rewrites if configured
+                uint32_t rewriteDstId = dstId;
+                if (peerRewrite(peer.peerId, rewriteDstId)) {
+                    ::memcpy(outboundPeerBuffer, buffer, len);
+                    routeRewrite(outboundPeerBuffer, peer.peerId, messageType, dstId);
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
-                    i++;
+                    m_network->writePeerQueue(peer, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId);
+                }
+                else {
+                    m_network->writePeerQueue(peer, frame, pktSeq);
                 }
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
+                        peerId, peer.peerId, messageType, srcId, dstId, len, pktSeq, streamId, external);
+                }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
             m_network->m_frameQueue->flushQueue();
         }
@@ -359,7 +364,7 @@ bool TagNXDNData::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUni
 
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 write_Message_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
             }
@@ -389,7 +394,7 @@ void TagNXDNData::playbackParrot()
         }
         else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "NXDN, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
@@ -425,24 +430,24 @@ void TagNXDNData::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t message
 
 bool TagNXDNData::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
 {
-    lookups::TalkgroupRuleGroupVoice tg;
+    std::shared_ptr<const lookups::TalkgroupRulesIndex> tgIndex = m_network->m_tidLookup->index();
+    const lookups::TalkgroupRuleIndexEntry* tg = nullptr;
     if (outbound) {
-        tg = m_network->m_tidLookup->find(dstId);
+        tg = tgIndex->find(dstId);
     }
     else {
-        tg = m_network->m_tidLookup->findByRewrite(peerId, dstId);
+        tg = tgIndex->findByRewrite(peerId, dstId);
     }
 
     bool rewrote = false;
-    if (tg.config().rewriteSize() > 0) {
-        std::vector<lookups::TalkgroupRuleRewrite> rewrites = tg.config().rewrite();
-        for (auto entry : rewrites) {
+    if (tg != nullptr && tg->rewrite.size() > 0) {
+        for (const lookups::TalkgroupRuleRewrite& entry : tg->rewrite) {
             if (entry.peerId() == peerId) {
                 if (outbound) {
                     dstId = entry.tgId();
                 }
                 else {
-                    dstId = tg.source().tgId();
+                    dstId = tg->tgId;
                 }
                 rewrote = true;
                 break;
@@ -468,7 +473,7 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
     FNEPeerConnection* connection = nullptr; // bryanb: this is a possible null ref concurrency issue
                                              //     it is possible if the timing is just right to get a valid 
                                              //     connection back initially, and then for it to be deleted
-    if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
+    if (peerId > 0 && (m_network->m_peers.contains(peerId))) {
         connection = m_network->m_peers[peerId];
     }
 
@@ -482,32 +487,25 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
 
     // is this a group call?
     if (lc.getGroup()) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(lc.getDstId());
-
-        std::vector<uint32_t> inclusion = tg.config().inclusion();
-        std::vector<uint32_t> exclusion = tg.config().exclusion();
-
-        // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
-                return false;
+        std::shared_ptr<const lookups::TalkgroupRulesIndex> tgIndex = m_network->m_tidLookup->index();
+        const lookups::TalkgroupRuleIndexEntry* tg = tgIndex->find(lc.getDstId());
+        bool affiliated = (tg != nullptr) ? tg->affiliated : false;
+
+        if (tg != nullptr) {
+            // peer inclusion lists take priority over exclusion lists
+            if (tg->inclusion.size() > 0) {
+                if (!tg->isIncluded(peerId)) {
+                    return false;
+                }
             }
-        }
-        else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
+            else {
+                if (tg->isExcluded(peerId)) {
                     return false;
                 }
             }
-        }
 
-        // peer always send list takes priority over any following affiliation rules
-        std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-        if (alwaysSend.size() > 0) {
-            auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-            if (it != alwaysSend.end()) {
+            // peer always send list takes priority over any following affiliation rules
+            if (tg->isAlwaysSend(peerId)) {
                 return true; // skip any following checks and always send traffic
             }
         }
@@ -532,24 +530,16 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
 
         // is this a TG that requires affiliations to repeat?
         // NOTE: external peers *always* repeat traffic regardless of affiliation
-        if (tg.config().affiliated() && !external) {
+        if (affiliated && !external) {
             uint32_t lookupPeerId = peerId;
             if (connection != nullptr) {
                 if (connection->ccPeerId() > 0U)
                     lookupPeerId = connection->ccPeerId();
             }
 
-            // check the affiliations for this peer to see if we can repeat traffic
-            lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
-            if (aff == nullptr) {
-                std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
-                //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
-                return false; // this will cause no traffic to pass for this peer now...I'm not sure this is good behavior
-            }
-            else {
-                if (!aff->hasGroupAff(lc.getDstId())) {
-                    return false;
-                }
+            // check the aggregated affiliations to see if this peer has affiliations and we can repeat traffic
+            if (!m_network->m_affiliationIndex.isAffiliated(lc.getDstId(), lookupPeerId)) {
+                return false;
             }
         }
     }
@@ -557,6 +547,26 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
     return true;
 }
 
+/* Helper to resolve the list of peers permitted to receive the call traffic. */
+
+FanoutPeerList TagNXDNData::resolveFanout(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, uint32_t dstId, uint32_t streamId)
+{
+    auto permitted = [&](uint32_t dstPeerId) { return isPeerPermitted(dstPeerId, lc, messageType, streamId); };
+
+    // only voice frames are routed using the talkgroup route table; all other messages are filtered 
+    // frame by frame
+    if (messageType != MessageType::RTCH_VCALL) {
+        return m_network->resolvePeerFanout(peerId, permitted);
+    }
+
+    // private calls are filtered frame by frame, the route table would otherwise grow with every unit called
+    if (!lc.getGroup()) {
+        return m_network->resolvePeerFanout(peerId, permitted);
+    }
+
+    return m_network->resolveTalkgroupRoute(m_routes, (uint64_t)dstId, dstId, permitted);
+}
+
 /* Helper to validate the DMR call stream. */
 
 bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, uint32_t streamId)
@@ -764,7 +774,7 @@ bool TagNXDNData::write_Message_Grant(uint32_t peerId, uint32_t srcId, uint32_t
     std::unique_ptr<lc::rcch::MESSAGE_TYPE_VCALL_CONN> rcch = std::make_unique<lc::rcch::MESSAGE_TYPE_VCALL_CONN>();
 
     // check the affiliations for this peer to see if we can grant traffic
-    lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[peerId];
+    std::shared_ptr<lookups::AffiliationLookup> aff = m_network->m_peerAffiliations[peerId];
     if (aff == nullptr) {
         std::string peerIdentity = m_network->resolvePeerIdentity(peerId);
         LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", peerId, peerIdentity.c_str());
@@ -19,6 +19,7 @@
 #include "fne/Defines.h"
 #include "common/Clock.h"
 #include "common/concurrent/deque.h"
+#include "common/concurrent/rcu_unordered_map.h"
 #include "common/concurrent/unordered_map.h"
 #include "common/nxdn/NXDNDefines.h"
 #include "common/nxdn/lc/RTCH.h"
@@ -161,6 +162,7 @@ namespace network
             };
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             concurrent::unordered_map<uint32_t, RxStatus> m_status;
+            TalkgroupRouteTable m_routes;
 
             bool m_debug;
 
@@ -192,6 +194,17 @@ namespace network
              * @returns bool True, if permitted, otherwise false.
              */
             bool isPeerPermitted(uint32_t peerId, nxdn::lc::RTCH& lc, uint8_t messageType, uint32_t streamId, bool external = false);
+            /**
+             * @brief Helper to resolve the list of peers permitted to receive the call traffic.
+             * @note Voice frames are routed using the materialized talkgroup route, which includes the source peer.
+             * @param peerId Source Peer ID.
+             * @param lc Instance of nxdn::lc::RTCH.
+             * @param messageType Message Type.
+             * @param dstId Destination ID.
+             * @param streamId Stream ID.
+             * @returns FanoutPeerList List of resolved destination peers.
+             */
+            FanoutPeerList resolveFanout(uint32_t peerId, nxdn::lc::RTCH& lc, uint8_t messageType, uint32_t dstId, uint32_t streamId);
             /**
              * @brief Helper to validate the NXDN call stream.
              * @param peerId Peer ID.
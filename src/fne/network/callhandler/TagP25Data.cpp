@@ -48,6 +48,7 @@ TagP25Data::TagP25Data(FNENetwork* network, bool debug) :
     m_parrotFramesReady(false),
     m_parrotFirstFrame(true),
     m_status(),
+    m_routes(),
     m_packetData(nullptr),
     m_debug(debug)
 {
@@ -325,40 +326,44 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                if (peerId != peer.first) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(peer.first, control, duid, streamId)) {
-                        continue;
-                    }
-
-                    // process TSDU to peer
-                    if (!processTSDUTo(buffer, peer.first, duid)) {
-                        continue;
-                    }
+            FanoutPeerList fanout = resolveFanout(peerId, control, duid, streamId);
 
-                    // every 5 peers flush the queue
-                    if (i % 5U == 0U) {
-                        m_network->m_frameQueue->flushQueue();
-                    }
+            // the frame is encoded once and shared by every peer that doesn't require a route rewrite
+            FrameQueue::PreparedFrame frame;
+            if (!m_network->prepareFrame(frame, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, buffer, len, streamId)) {
+                LogError(LOG_NET, "P25, failed to prepare frame for repeat, peer = %u, len = %u, stream = %u", peerId, len, streamId);
+                return false;
+            }
 
-                    DECLARE_UINT8_ARRAY(outboundPeerBuffer, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+            DECLARE_UINT8_ARRAY(outboundPeerBuffer, len);
+            for (const FanoutPeer& peer : *fanout) {
+                // the talkgroup route includes the source peer, never repeat traffic back to it
+                if (peer.peerId == peerId)
+                    continue;
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, duid, dstId);
+                // process TSDU to peer
+                if (!processTSDUTo(buffer, peer.peerId, duid)) {
+                    continue;
+                }
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId, true);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
-                            peerId, peer.first, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
-                    }
+                // perform TGID route rewrites if configured
+                uint32_t rewriteDstId = dstId;
+                if (peerRewrite(peer.peerId, rewriteDstId)) {
+                    ::memcpy(outboundPeerBuffer, buffer, len);
+                    routeRewrite(outboundPeerBuffer, peer.peerId, duid, dstId);
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
-                    i++;
+                    m_network->writePeerQueue(peer, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId);
                 }
+                else {
+                    m_network->writePeerQueue(peer, frame, pktSeq);
+                }
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
+                        peerId, peer.peerId, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
+                }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
             m_network->m_frameQueue->flushQueue();
         }
@@ -450,7 +455,7 @@ bool TagP25Data::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUnit
 
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 write_TSDU_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
             }
@@ -497,7 +502,7 @@ void TagP25Data::playbackParrot()
                             RTP_END_OF_CALL_SEQ, m_network->createStreamId(), false);
                     } else {
                         // repeat traffic to the connected peers
-                        for (auto peer : m_network->m_peers) {
+                        for (auto peer : m_network->m_peers.snapshot()) {
                             LogMessage(LOG_NET, "P25, Parrot Grant Demand, peer = %u, srcId = %u, dstId = %u", peer.first, srcId, dstId);
                             m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, 
                                 RTP_END_OF_CALL_SEQ, m_network->createStreamId(), false);
@@ -517,7 +522,7 @@ void TagP25Data::playbackParrot()
             }
         } else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "P25, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
@@ -672,23 +677,23 @@ void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, ui
 
 bool TagP25Data::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
 {
-    lookups::TalkgroupRuleGroupVoice tg;
+    std::shared_ptr<const lookups::TalkgroupRulesIndex> tgIndex = m_network->m_tidLookup->index();
+    const lookups::TalkgroupRuleIndexEntry* tg = nullptr;
     if (outbound) {
-        tg = m_network->m_tidLookup->find(dstId);
+        tg = tgIndex->find(dstId);
     }
     else {
-        tg = m_network->m_tidLookup->findByRewrite(peerId, dstId);
+        tg = tgIndex->findByRewrite(peerId, dstId);
     }
 
-    if (tg.config().rewriteSize() > 0) {
-        std::vector<lookups::TalkgroupRuleRewrite> rewrites = tg.config().rewrite();
-        for (auto entry : rewrites) {
+    if (tg != nullptr && tg->rewrite.size() > 0) {
+        for (const lookups::TalkgroupRuleRewrite& entry : tg->rewrite) {
             if (entry.peerId() == peerId) {
                 if (outbound) {
                     dstId = entry.tgId();
                 }
                 else {
-                    dstId = tg.source().tgId();
+                    dstId = tg->tgId;
                 }
                 return true;
             }
@@ -812,7 +817,7 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
             uint32_t dstId = tsbk->getDstId();
 
             FNEPeerConnection* connection = nullptr;
-            if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
+            if (peerId > 0 && (m_network->m_peers.contains(peerId))) {
                 connection = m_network->m_peers[peerId];
             }
 
@@ -830,7 +835,7 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
                             }
 
                             // check the affiliations for this peer to see if we can repeat the TSDU
-                            lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
+                            std::shared_ptr<lookups::AffiliationLookup> aff = m_network->m_peerAffiliations[lookupPeerId];
                             if (aff == nullptr) {
                                 std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
                                 //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
@@ -919,7 +924,7 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
     FNEPeerConnection* connection = nullptr; // bryanb: this is a possible null ref concurrency issue
                                              //     it is possible if the timing is just right to get a valid 
                                              //     connection back initially, and then for it to be deleted
-    if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
+    if (peerId > 0 && (m_network->m_peers.contains(peerId))) {
         connection = m_network->m_peers[peerId];
     }
 
@@ -1015,32 +1020,25 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
     }
 
     // is this a group call?
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-
-    std::vector<uint32_t> inclusion = tg.config().inclusion();
-    std::vector<uint32_t> exclusion = tg.config().exclusion();
-
-    // peer inclusion lists take priority over exclusion lists
-    if (inclusion.size() > 0) {
-        auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-        if (it == inclusion.end()) {
-            return false;
+    std::shared_ptr<const lookups::TalkgroupRulesIndex> tgIndex = m_network->m_tidLookup->index();
+    const lookups::TalkgroupRuleIndexEntry* tg = tgIndex->find(control.getDstId());
+    bool affiliated = (tg != nullptr) ? tg->affiliated : false;
+
+    if (tg != nullptr) {
+        // peer inclusion lists take priority over exclusion lists
+        if (tg->inclusion.size() > 0) {
+            if (!tg->isIncluded(peerId)) {
+                return false;
+            }
         }
-    }
-    else {
-        if (exclusion.size() > 0) {
-            auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-            if (it != exclusion.end()) {
+        else {
+            if (tg->isExcluded(peerId)) {
                 return false;
             }
         }
-    }
 
-    // peer always send list takes priority over any other rules
-    std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-    if (alwaysSend.size() > 0) {
-        auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-        if (it != alwaysSend.end()) {
+        // peer always send list takes priority over any other rules
+        if (tg->isAlwaysSend(peerId)) {
             return true; // skip any following checks and always send traffic
         }
     }
@@ -1065,30 +1063,43 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
 
     // is this a TG that requires affiliations to repeat?
     // NOTE: external peers *always* repeat traffic regardless of affiliation
-    if (tg.config().affiliated() && !external) {
+    if (affiliated && !external) {
         uint32_t lookupPeerId = peerId;
         if (connection != nullptr) {
             if (connection->ccPeerId() > 0U)
                 lookupPeerId = connection->ccPeerId();
         }
 
-        // check the affiliations for this peer to see if we can repeat traffic
-        lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
-        if (aff == nullptr) {
-            std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
-            //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
-            return false; // this will cause no traffic to pass for this peer now...I'm not sure this is good behavior
-        }
-        else {
-            if (!aff->hasGroupAff(control.getDstId())) {
-                return false;
-            }
+        // check the aggregated affiliations to see if this peer has affiliations and we can repeat traffic
+        if (!m_network->m_affiliationIndex.isAffiliated(control.getDstId(), lookupPeerId)) {
+            return false;
         }
     }
 
     return true;
 }
 
+/* Helper to resolve the list of peers permitted to receive the call traffic. */
+
+FanoutPeerList TagP25Data::resolveFanout(uint32_t peerId, lc::LC& control, DUID::E duid, uint32_t streamId)
+{
+    auto permitted = [&](uint32_t dstPeerId) { return isPeerPermitted(dstPeerId, control, duid, streamId); };
+
+    // only voice frames are routed using the talkgroup route table; headers, terminators and TSDUs are 
+    // filtered frame by frame
+    if (duid != DUID::LDU1 && duid != DUID::LDU2) {
+        return m_network->resolvePeerFanout(peerId, permitted);
+    }
+
+    // private calls are filtered frame by frame, the route table would otherwise grow with every unit called
+    if (control.getLCO() == LCO::PRIVATE) {
+        return m_network->resolvePeerFanout(peerId, permitted);
+    }
+
+    uint32_t dstId = control.getDstId();
+    return m_network->resolveTalkgroupRoute(m_routes, (uint64_t)dstId, dstId, permitted);
+}
+
 /* Helper to validate the P25 call stream. */
 
 bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const p25::lc::TSBK* tsbk, uint32_t streamId)
@@ -1386,7 +1397,7 @@ bool TagP25Data::write_TSDU_Grant(uint32_t peerId, uint32_t srcId, uint32_t dstI
     }
 
     // check the affiliations for this peer to see if we can grant traffic
-    lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[peerId];
+    std::shared_ptr<lookups::AffiliationLookup> aff = m_network->m_peerAffiliations[peerId];
     if (aff == nullptr) {
         std::string peerIdentity = m_network->resolvePeerIdentity(peerId);
         LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", peerId, peerIdentity.c_str());
@@ -1524,7 +1535,7 @@ void TagP25Data::write_TSDU(uint32_t peerId, lc::TSBK* tsbk)
         // repeat traffic to the connected peers
         if (m_network->m_peers.size() > 0U) {
             uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
+            for (auto peer : m_network->m_peers.snapshot()) {
                 // every 5 peers flush the queue
                 if (i % 5U == 0U) {
                     m_network->m_frameQueue->flushQueue();
@@ -19,6 +19,7 @@
 #include "fne/Defines.h"
 #include "common/Clock.h"
 #include "common/concurrent/deque.h"
+#include "common/concurrent/rcu_unordered_map.h"
 #include "common/concurrent/unordered_map.h"
 #include "common/p25/P25Defines.h"
 #include "common/p25/data/DataHeader.h"
@@ -210,6 +211,7 @@ namespace network
             };
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             concurrent::unordered_map<uint32_t, RxStatus> m_status;
+            TalkgroupRouteTable m_routes;
 
             friend class packetdata::P25PacketData;
             packetdata::P25PacketData* m_packetData;
@@ -270,6 +272,16 @@ namespace network
              * @returns bool True, if permitted, otherwise false.
              */
             bool isPeerPermitted(uint32_t peerId, p25::lc::LC& control, P25DEF::DUID::E duid, uint32_t streamId, bool external = false);
+            /**
+             * @brief Helper to resolve the list of peers permitted to receive the call traffic.
+             * @note Voice frames are routed using the materialized talkgroup route, which includes the source peer.
+             * @param peerId Source Peer ID.
+             * @param control Instance of p25::lc::LC.
+             * @param duid DUID.
+             * @param streamId Stream ID.
+             * @returns FanoutPeerList List of resolved destination peers.
+             */
+            FanoutPeerList resolveFanout(uint32_t peerId, p25::lc::LC& control, P25DEF::DUID::E duid, uint32_t streamId);
             /**
              * @brief Helper to validate the P25 call stream.
              * @param peerId Peer ID.
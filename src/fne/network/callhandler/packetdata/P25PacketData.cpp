@@ -712,7 +712,7 @@ void P25PacketData::dispatchToFNE(uint32_t peerId)
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
         uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             if (peerId != peer.first) {
                 // every 2 peers flush the queue
                 if (i % 2U == 0U) {
@@ -780,7 +780,7 @@ void P25PacketData::dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bo
     // repeat traffic to the connected peers
     if (m_network->m_peers.size() > 0U) {
         uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
+        for (auto peer : m_network->m_peers.snapshot()) {
             // every 2 peers flush the queue
             if (i % 2U == 0U) {
                 m_network->m_frameQueue->flushQueue();
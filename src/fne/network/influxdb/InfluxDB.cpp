@@ -13,9 +13,14 @@
 #if defined(_WIN32)
 #include <ws2tcpip.h>
 #include <Winsock2.h>
+#define strncasecmp _strnicmp
+#else
+#include <netinet/tcp.h>
+#include <strings.h>
 #endif
 
 #include <fcntl.h>
+#include <cerrno>
 
 using namespace network::influxdb;
 
@@ -25,11 +30,78 @@ using namespace network::influxdb;
 
 #define SOCK_CONNECT_TIMEOUT 30
 
+#define HTTP_HEADER_MAX_LEN 8192
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
 
-ThreadPool detail::TSCaller::m_fluxReqThreadPool{MAX_INFLUXQL_THREAD_CNT, "fluxql"};
+Writer detail::TSCaller::m_writer;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to write the entire contents of the given buffers to a socket. */
+
+static bool sendAll(int fd, struct iovec* iv, int cnt)
+{
+    size_t total = 0U;
+    for (int i = 0; i < cnt; i++)
+        total += iv[i].iov_len;
+
+#if defined(_WIN32)
+    return writev(fd, iv, cnt) == (__int64)total;
+#else
+    // MSG_NOSIGNAL prevents a write to a connection closed by the server from raising SIGPIPE
+    struct msghdr msg;
+    ::memset(&msg, 0x00, sizeof(msg));
+    msg.msg_iov = iv;
+    msg.msg_iovlen = cnt;
+
+    int flags = 0;
+#if defined(MSG_NOSIGNAL)
+    flags = MSG_NOSIGNAL;
+#endif // defined(MSG_NOSIGNAL)
+    return ::sendmsg(fd, &msg, flags) == (ssize_t)total;
+#endif // defined(_WIN32)
+}
+
+/* Helper to find a header value in a HTTP response header. */
+
+static bool findHeader(const char* header, size_t length, const char* name, std::string& value)
+{
+    size_t nameLen = ::strlen(name);
+    const char* end = header + length;
+    const char* line = (const char*)::memchr(header, '\n', length);
+    while (line != nullptr && line < end) {
+        line++;
+
+        const char* eol = (const char*)::memchr(line, '\n', end - line);
+        if (eol == nullptr)
+            eol = end;
+
+        if ((size_t)(eol - line) > nameLen && line[nameLen] == ':' && ::strncasecmp(line, name, nameLen) == 0) {
+            const char* v = line + nameLen + 1;
+            while (v < eol && (*v == ' ' || *v == '\t'))
+                v++;
+            const char* ve = eol;
+            while (ve > v && (ve[-1] == '\r' || ve[-1] == ' '))
+                ve--;
+
+            value.assign(v, ve - v);
+            return true;
+        }
+
+        line = eol;
+    }
+
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
 
 /* Generates a InfluxDB REST API request. */
 
@@ -38,8 +110,42 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
 {
     std::string header;
     struct iovec iv[2];
-    int fd, len = 0;
 
+    int fd = connect(si);
+    if (fd < 0) {
+        return 1;
+    }
+
+    iv[0].iov_len = formatHeader(header, method, uri, queryString, body.length(), si, false);
+    iv[0].iov_base = &header[0];
+    iv[1].iov_base = (void*)&body[0];
+    iv[1].iov_len = body.length();
+
+    int ret = 0;
+
+    if (!sendAll(fd, iv, 2)) {
+        ::LogError(LOG_HOST, "Failed to write statistical data to InfluxDB server, err: %d", errno);
+        ret = -6;
+    }
+
+    // set SO_LINGER option
+    struct linger sl;
+    sl.l_onoff = 1;     /* non-zero value enables linger option in kernel */
+    sl.l_linger = 0;    /* timeout interval in seconds */
+#if defined(_WIN32)
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, (char*)&sl, sizeof(sl));
+#else
+    setsockopt(fd, SOL_SOCKET, SO_LINGER, &sl, sizeof(sl));
+#endif
+    // close socket
+    closesocket(fd);
+    return ret;
+}
+
+/* Opens a blocking TCP connection to the InfluxDB server. */
+
+int detail::inner::connect(const ServerInfo& si)
+{
     struct addrinfo hints, *addr = nullptr;
     struct in6_addr serverAddr;
     memset(&hints, 0x00, sizeof(hints));
@@ -64,11 +170,20 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
     ret = getaddrinfo(si.host().c_str(), std::to_string(si.port()).c_str(), &hints, &addr);
     if (ret != 0) {
         ::LogError(LOG_HOST, "Failed to determine InfluxDB server host, err: %d", errno);
-        return 1;
+        return -1;
     }
 
+    // copy the resolved address, the address info is no longer needed after this
+    struct sockaddr_storage serverSockAddr;
+    socklen_t serverSockAddrLen = (socklen_t)addr->ai_addrlen;
+    int family = addr->ai_family;
+    int protocol = addr->ai_protocol;
+    ::memcpy(&serverSockAddr, addr->ai_addr, addr->ai_addrlen);
+    freeaddrinfo(addr);
+
+
     // open the socket
-    fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    int fd = socket(family, SOCK_STREAM, protocol);
     if (fd < 0) {
 #if defined(_WIN32)
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %lu", ::GetLastError());
@@ -76,7 +191,7 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %d", errno);
 #endif // defined(_WIN32)
         closesocket(fd);
-        return 1;
+        return -1;
     }
 
     // set SO_REUSEADDR option
@@ -85,13 +200,13 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
     if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (char*)&sockOptVal, sizeof(int)) != 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %lu", ::GetLastError());
         closesocket(fd);
-        return 1;
+        return -1;
     }
 #else
     if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &sockOptVal, sizeof(int)) < 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %d", errno);
         closesocket(fd);
-        return 1;
+        return -1;
     }
 #endif // defined(_WIN32)
 
@@ -101,20 +216,20 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
     if (ioctlsocket(fd, FIONBIO, &flags) != 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, failed ioctlsocket, err: %d", errno);
         closesocket(fd);
-        return 1;
+        return -1;
     }
 #else
     int flags = fcntl(fd, F_GETFL, 0);
     if (flags < 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, failed fcntl(F_GETFL), err: %d", errno);
         closesocket(fd);
-        return 1;
+        return -1;
     }
 
     if (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, failed fcntl(F_SETFL), err: %d", errno);
         closesocket(fd);
-        return 1;
+        return -1;
     }
 #endif // defined(_WIN32)
 
@@ -123,7 +238,7 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
 
     // connect to the server
     uint8_t retryCnt = 0U;
-    ret = connect(fd, addr->ai_addr, addr->ai_addrlen);
+    ret = ::connect(fd, (struct sockaddr*)&serverSockAddr, serverSockAddrLen);
     if (ret < 0) {
         if (errno == EINPROGRESS) {
             do {
@@ -140,7 +255,7 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
                     if (retryCnt > 5U) {
                         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, timed out while connecting");
                         closesocket(fd);
-                        return 1;
+                        return -1;
                     }
 
                     Thread::sleep(1U);
@@ -153,7 +268,7 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
                     ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %d", errno);
 #endif // defined(_WIN32)
                     closesocket(fd);
-                    return 1;
+                    return -1;
                 } else if (ret > 0) {
 #if !defined(_WIN32)
                     // socket selected for write
@@ -163,20 +278,20 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
                     if (getsockopt(fd, SOL_SOCKET, SO_ERROR, (void *)(&valopt), &slen) < 0) {
                         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %d", errno);
                         closesocket(fd);
-                        return 1;
+                        return -1;
                     }
 
                     if (valopt) {
                         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %d", valopt);
                         closesocket(fd);
-                        return 1;
+                        return -1;
                     }
 #endif // !defined(_WIN32)
                     break;
                 } else {
                     ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, timed out while connecting");
                     closesocket(fd);
-                    return 1;
+                    return -1;
                 }
             } while (true);
         }
@@ -188,20 +303,20 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
     if (ioctlsocket(fd, FIONBIO, &flags) != 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, failed ioctlsocket, err: %d", errno);
         closesocket(fd);
-        return 1;
+        return -1;
     }
 #else
     flags = fcntl(fd, F_GETFL, 0);
     if (flags < 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, failed fcntl(F_GETFL), err: %d", errno);
         closesocket(fd);
-        return 1;
+        return -1;
     }
 
     if (fcntl(fd, F_SETFL, flags & (~O_NONBLOCK)) < 0) {
         ::LogError(LOG_HOST, "Failed to connect to InfluxDB server, failed fcntl(F_SETFL), err: %d", errno);
         closesocket(fd);
-        return 1;
+        return -1;
     }
 #endif // defined(_WIN32)
 
@@ -217,47 +332,530 @@ int detail::inner::request(const char* method, const char* uri, const std::strin
     setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
 #endif // defined(_WIN32)
 
-    header.resize(len = 0x100);
+    return fd;
+}
+
+/* Helper to format the HTTP header of a InfluxDB REST API request. */
+
+size_t detail::inner::formatHeader(std::string& header, const char* method, const char* uri, const std::string& queryString, 
+    size_t bodyLength, const ServerInfo& si, bool keepAlive)
+{
+    const char* connection = (keepAlive) ? "keep-alive" : "close";
+
+    if (header.length() < 0x100U)
+        header.resize(0x100U);
+
+    int len = (int)header.length();
+    int ret = 0;
     while (true) {
         if (!si.token().empty()) {
-            iv[0].iov_len = snprintf(&header[0], len,
-                "%s /api/v2/%s?org=%s&bucket=%s%s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\nAuthorization: Token %s\r\nContent-Type: text/plain; charset=utf-8\r\nContent-Length: %d\r\n\r\n",
-                method, uri, si.org().c_str(), si.bucket().c_str(), queryString.c_str(), si.host().c_str(), si.token().c_str(), (int)body.length());
+            ret = snprintf(&header[0], len,
+                "%s /api/v2/%s?org=%s&bucket=%s%s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\nAuthorization: Token %s\r\nContent-Type: text/plain; charset=utf-8\r\nContent-Length: %d\r\n\r\n",
+                method, uri, si.org().c_str(), si.bucket().c_str(), queryString.c_str(), si.host().c_str(), connection, si.token().c_str(), (int)bodyLength);
         } else {
-            iv[0].iov_len = snprintf(&header[0], len,
-                "%s /api/v2/%s?org=%s&bucket=%s%s HTTP/1.1\r\nHost: %s\r\nConnection: close\r\nContent-Type: text/plain; charset=utf-8\r\nContent-Length: %d\r\n\r\n",
-                method, uri, si.org().c_str(), si.bucket().c_str(), queryString.c_str(), si.host().c_str(), (int)body.length());
+            ret = snprintf(&header[0], len,
+                "%s /api/v2/%s?org=%s&bucket=%s%s HTTP/1.1\r\nHost: %s\r\nConnection: %s\r\nContent-Type: text/plain; charset=utf-8\r\nContent-Length: %d\r\n\r\n",
+                method, uri, si.org().c_str(), si.bucket().c_str(), queryString.c_str(), si.host().c_str(), connection, (int)bodyLength);
         }
-#ifdef INFLUX_DEBUG
-        LogDebug(LOG_HOST, "InfluxDB Request: %s\n%s", &header[0], body.c_str());
-#endif
-        if ((int)iv[0].iov_len >= len)
+
+        if (ret >= len)
             header.resize(len *= 2);
         else
             break;
     }
 
-    iv[0].iov_base = &header[0];
-    iv[1].iov_base = (void*)&body[0];
-    iv[1].iov_len = body.length();
+#ifdef INFLUX_DEBUG
+    LogDebug(LOG_HOST, "InfluxDB Request: %s", &header[0]);
+#endif
+    return (size_t)ret;
+}
 
-    ret = 0;
+/* Helper to append a string to the formatted lines. */
 
-    if (writev(fd, iv, 2) < (int)(iv[0].iov_len + iv[1].iov_len)) {
-        ::LogError(LOG_HOST, "Failed to write statistical data to InfluxDB server, err: %d", errno);
-        ret = -6;
+void QueryBuilder::append(const char* str, size_t length)
+{
+    if (m_overflow.empty()) {
+        if (m_length + length < INFLUX_LINE_BUFFER_LEN) {
+            ::memcpy(m_buffer + m_length, str, length);
+            m_length += length;
+            m_buffer[m_length] = '\0';
+            return;
+        }
+
+        // the line is too long for the fixed buffer, continue in a heap allocated buffer
+        m_overflow.reserve(INFLUX_LINE_BUFFER_LEN * 2U);
+        m_overflow.assign(m_buffer, m_length);
     }
 
-    // set SO_LINGER option
-    struct linger sl;
-    sl.l_onoff = 1;     /* non-zero value enables linger option in kernel */
-    sl.l_linger = 0;    /* timeout interval in seconds */
+    m_overflow.append(str, length);
+}
+
+/* Helper to append a signed integer to the formatted lines. */
+
+void QueryBuilder::appendInt(long long v)
+{
+    if (v < 0) {
+        append('-');
+        appendUInt(0ULL - (unsigned long long)v);
+    }
+    else {
+        appendUInt((unsigned long long)v);
+    }
+}
+
+/* Helper to append an unsigned integer to the formatted lines. */
+
+void QueryBuilder::appendUInt(unsigned long long v)
+{
+    char buffer[24U];
+    char* p = buffer + sizeof(buffer);
+    do {
+        *--p = (char)('0' + (v % 10U));
+        v /= 10U;
+    } while (v != 0U);
+
+    append(p, (buffer + sizeof(buffer)) - p);
+}
+
+/* Helper to append a fixed-point floating point value to the formatted lines. */
+
+void QueryBuilder::appendDouble(double v, int prec)
+{
+    char buffer[64U];
+    int len = ::snprintf(buffer, sizeof(buffer), "%.*f", prec, v);
+    if (len >= (int)sizeof(buffer)) {
+        // very large values are written in exponent form, which is also valid line protocol
+        len = ::snprintf(buffer, sizeof(buffer), "%.*e", prec, v);
+    }
+
+    if (len > 0)
+        append(buffer, (size_t)len);
+}
+
+/* Initializes a new instance of the Writer class. */
+
+Writer::Writer() :
+    m_si(),
+    m_batchInterval(DEFAULT_INFLUX_BATCH_INTERVAL),
+    m_batchBytes(DEFAULT_INFLUX_BATCH_BYTES),
+    m_maxQueuedBytes(DEFAULT_INFLUX_MAX_QUEUED_BYTES),
+    m_thread(),
+    m_running(false),
+    m_signalled(false),
+    m_mutex(),
+    m_cond(),
+    m_pending(),
+    m_pendingPoints(0U),
+    m_pendingStart(),
+    m_sending(),
+    m_header(),
+    m_response(),
+    m_fd(-1),
+    m_retryTime(),
+    m_written(0U),
+    m_batches(0U),
+    m_dropped(0U),
+    m_failed(0U),
+    m_connects(0U),
+    m_reportedDropped(0U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the Writer class. */
+
+Writer::~Writer()
+{
+    stop();
+}
+
+/* Starts the writer thread. */
+
+bool Writer::start(const ServerInfo& si, uint32_t batchInterval, uint32_t batchBytes, uint32_t maxQueuedBytes)
+{
+    if (m_running) {
+        return true;
+    }
+
+    if (batchInterval == 0U)
+        batchInterval = DEFAULT_INFLUX_BATCH_INTERVAL;
+    if (batchBytes == 0U)
+        batchBytes = DEFAULT_INFLUX_BATCH_BYTES;
+    if (maxQueuedBytes < batchBytes)
+        maxQueuedBytes = batchBytes;
+
+    m_si = si;
+    m_batchInterval = batchInterval;
+    m_batchBytes = batchBytes;
+    m_maxQueuedBytes = maxQueuedBytes;
+
+    // preallocate the queue and send buffers, these are swapped (and keep their capacity) for every batch
+    m_pending.clear();
+    m_pending.reserve(maxQueuedBytes);
+    m_pendingPoints = 0U;
+    m_sending.clear();
+    m_sending.reserve(maxQueuedBytes);
+    m_header.resize(0x200U);
+    m_response.resize(HTTP_HEADER_MAX_LEN);
+
+    m_signalled = false;
+    m_running = true;
+
+    if (!Thread::runAsThread(this, threadWriter, &m_thread)) {
+        m_running = false;
+        return false;
+    }
+
+    return true;
+}
+
+/* Stops the writer thread, writing any remaining queued points. */
+
+void Writer::stop()
+{
+    if (!m_running) {
+        return;
+    }
+
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_cond.notify_all();
+
 #if defined(_WIN32)
-    setsockopt(fd, SOL_SOCKET, SO_LINGER, (char*)&sl, sizeof(sl));
+    ::WaitForSingleObject(m_thread.thread, INFINITE);
+    ::CloseHandle(m_thread.thread);
 #else
-    setsockopt(fd, SOL_SOCKET, SO_LINGER, &sl, sizeof(sl));
+    ::pthread_join(m_thread.thread, NULL);
+#endif // defined(_WIN32)
+}
+
+/* Queues lines to be written. */
+
+bool Writer::write(const ServerInfo& si, const char* lines, size_t length, uint32_t points)
+{
+    if (!m_running || lines == nullptr || length == 0U) {
+        return false;
+    }
+
+    // the writer only holds a connection to the server it was started with
+    if (si.port() != m_si.port() || si.host() != m_si.host() || si.bucket() != m_si.bucket()) {
+        ::LogError(LOG_HOST, "InfluxDB writer is not connected to %s:%u (bucket %s)", si.host().c_str(), si.port(), si.bucket().c_str());
+        return false;
+    }
+
+    bool notify = false;
+
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending.length() + length + 1U > m_maxQueuedBytes) {
+            m_dropped.fetch_add(points, std::memory_order_relaxed);
+            return false;
+        }
+
+        // the first queued point starts the batch interval
+        if (m_pending.empty()) {
+            m_pendingStart = std::chrono::steady_clock::now();
+            notify = true;
+        }
+
+        m_pending.append(lines, length);
+        m_pending.push_back('\n');
+        m_pendingPoints += points;
+
+        if (m_pending.length() >= m_batchBytes && !m_signalled) {
+            m_signalled = true;
+            notify = true;
+        }
+    }
+
+    if (notify) {
+        m_cond.notify_one();
+    }
+
+    return true;
+}
+
+/* Wakes the writer thread to write the queued points immediately. */
+
+void Writer::flush()
+{
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_signalled = true;
+    }
+    m_cond.notify_one();
+}
+
+/* Gets the statistics of the writer. */
+
+WriterStats Writer::stats()
+{
+    WriterStats stats;
+
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats.queuedPoints = m_pendingPoints;
+        stats.queuedBytes = (uint32_t)m_pending.length();
+    }
+
+    stats.written = m_written.load(std::memory_order_relaxed);
+    stats.batches = m_batches.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    stats.failed = m_failed.load(std::memory_order_relaxed);
+    stats.connects = m_connects.load(std::memory_order_relaxed);
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Writes a batch of points, reconnecting (once) if the connection was closed. */
+
+void Writer::writeBatch(const std::string& body, uint32_t points)
+{
+    int status = -1;
+    for (uint32_t attempt = 0U; attempt < 2U; attempt++) {
+        if (!ensureConnected())
+            break;
+
+        // a request that could not be sent was never processed, so it is resent once over a new connection;
+        // a request that was sent may have been written by the server even if its response was lost, and is
+        // never resent (which would write the points twice)
+        bool sent = false;
+        status = post(body, sent);
+        if (status > 0 || sent)
+            break;
+    }
+
+    if (status >= 200 && status < 300) {
+        m_written.fetch_add(points, std::memory_order_relaxed);
+        m_batches.fetch_add(1U, std::memory_order_relaxed);
+    }
+    else {
+        m_failed.fetch_add(points, std::memory_order_relaxed);
+        if (status > 0) {
+            ::LogError(LOG_HOST, "InfluxDB server rejected statistical data, status: %d, %u points", status, points);
+        }
+        else {
+            ::LogError(LOG_HOST, "Failed to write statistical data to InfluxDB server, %u points", points);
+        }
+    }
+}
+
+/* Sends a request over the persistent connection and reads the response. */
+
+int Writer::post(const std::string& body, bool& sent)
+{
+    sent = false;
+
+    struct iovec iv[2];
+    iv[0].iov_len = detail::inner::formatHeader(m_header, "POST", "write", "", body.length(), m_si, true);
+    iv[0].iov_base = &m_header[0];
+    iv[1].iov_base = (void*)body.c_str();
+    iv[1].iov_len = body.length();
+
+    if (!sendAll(m_fd, iv, 2)) {
+        disconnect();
+        return -1;
+    }
+
+    sent = true;
+
+    bool keepAlive = true;
+    int status = readResponse(keepAlive);
+    if (status < 0 || !keepAlive) {
+        disconnect();
+    }
+
+    return status;
+}
+
+/* Reads a HTTP response from the persistent connection. */
+
+int Writer::readResponse(bool& keepAlive)
+{
+    char* buffer = &m_response[0];
+    size_t capacity = m_response.length();
+    size_t length = 0U;
+    size_t headerLen = 0U;
+
+    // read until the end of the response header
+    while (headerLen == 0U) {
+        if (length >= capacity) {
+            ::LogError(LOG_HOST, "InfluxDB server response header too large");
+            return -1;
+        }
+
+        int ret = ::recv(m_fd, buffer + length, (int)(capacity - length), 0);
+        if (ret <= 0) {
+            return -1;
+        }
+
+        size_t start = (length > 3U) ? length - 3U : 0U;
+        length += (size_t)ret;
+        for (size_t i = start; i + 3U < length; i++) {
+            if (buffer[i] == '\r' && buffer[i + 1U] == '\n' && buffer[i + 2U] == '\r' && buffer[i + 3U] == '\n') {
+                headerLen = i + 4U;
+                break;
+            }
+        }
+    }
+
+    int status = 0;
+    if (length < 12U || ::strncmp(buffer, "HTTP/1.", 7U) != 0 || (status = ::atoi(buffer + 9U)) <= 0) {
+        ::LogError(LOG_HOST, "InfluxDB server sent an invalid response");
+        return -1;
+    }
+
+    std::string value;
+    if (findHeader(buffer, headerLen, "Connection", value) && ::strncasecmp(value.c_str(), "close", 5U) == 0) {
+        keepAlive = false;
+    }
+
+    // skip the response body (if any), a body without a known length can only end with the connection
+    size_t bodyLen = 0U;
+    if (findHeader(buffer, headerLen, "Content-Length", value)) {
+        bodyLen = (size_t)::strtoul(value.c_str(), nullptr, 10);
+    }
+    else if (status != 204 && status != 304 && status >= 200) {
+        keepAlive = false;
+        return status;
+    }
+
+#ifdef INFLUX_DEBUG
+    if (status >= 300) {
+        std::string body(buffer + headerLen, (length - headerLen < bodyLen) ? length - headerLen : bodyLen);
+        LogDebug(LOG_HOST, "InfluxDB Response: %d, %s", status, body.c_str());
+    }
 #endif
-    // close socket
-    closesocket(fd);
-    return ret;
+
+    size_t remaining = (length - headerLen < bodyLen) ? bodyLen - (length - headerLen) : 0U;
+    while (remaining > 0U) {
+        int ret = ::recv(m_fd, buffer, (int)((remaining < capacity) ? remaining : capacity), 0);
+        if (ret <= 0) {
+            return -1;
+        }
+
+        remaining -= (size_t)ret;
+    }
+
+    return status;
+}
+
+/* Helper to check if the persistent connection is (still) connected, and connect if necessary. */
+
+bool Writer::ensureConnected()
+{
+#if !defined(_WIN32)
+    // a connection closed by the server while idle reads as end-of-stream
+    if (m_fd >= 0) {
+        char c;
+        ssize_t ret = ::recv(m_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+        if (ret == 0 || (ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            disconnect();
+        }
+    }
+#endif // !defined(_WIN32)
+
+    if (m_fd >= 0) {
+        return true;
+    }
+
+    // don't try to reconnect to an unreachable server for every batch
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now < m_retryTime) {
+        return false;
+    }
+
+    m_fd = detail::inner::connect(m_si);
+    if (m_fd < 0) {
+        m_retryTime = now + std::chrono::milliseconds(INFLUX_RECONNECT_INTERVAL);
+        return false;
+    }
+
+    // disable Nagle, a batch is written as a single request
+    const int noDelay = 1;
+#if defined(_WIN32)
+    setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, (char*)&noDelay, sizeof(int));
+#else
+    setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(int));
+#endif // defined(_WIN32)
+
+    m_connects.fetch_add(1U, std::memory_order_relaxed);
+    return true;
+}
+
+/* Closes the persistent connection. */
+
+void Writer::disconnect()
+{
+    if (m_fd >= 0) {
+        closesocket(m_fd);
+        m_fd = -1;
+    }
+}
+
+/* Entry point to writer thread. */
+
+void* Writer::threadWriter(void* arg)
+{
+    thread_t* th = (thread_t*)arg;
+    if (th == nullptr) {
+        return nullptr;
+    }
+
+    Writer* writer = static_cast<Writer*>(th->obj);
+    if (writer == nullptr) {
+        return nullptr;
+    }
+
+#ifdef _GNU_SOURCE
+    ::pthread_setname_np(th->thread, "influx:writer");
+#endif // _GNU_SOURCE
+
+    bool running = true;
+    while (running) {
+        uint32_t points = 0U;
+
+        // scope is intentional
+        {
+            std::unique_lock<std::mutex> lock(writer->m_mutex);
+            writer->m_cond.wait(lock, [=] { return !writer->m_running || !writer->m_pending.empty(); });
+
+            // wait for the batch to fill, or for the oldest queued point to reach the batch interval
+            if (writer->m_running && !writer->m_signalled) {
+                std::chrono::steady_clock::time_point deadline = writer->m_pendingStart + std::chrono::milliseconds(writer->m_batchInterval);
+                writer->m_cond.wait_until(lock, deadline, [=] { return !writer->m_running || writer->m_signalled; });
+            }
+
+            running = writer->m_running;
+            writer->m_signalled = false;
+
+            // swap the queue with the (empty) send buffer, new points are queued while this batch is written
+            writer->m_sending.swap(writer->m_pending);
+            points = writer->m_pendingPoints;
+            writer->m_pendingPoints = 0U;
+        }
+
+        if (!writer->m_sending.empty()) {
+            writer->writeBatch(writer->m_sending, points);
+            writer->m_sending.clear();
+        }
+
+        uint64_t dropped = writer->m_dropped.load(std::memory_order_relaxed);
+        if (dropped != writer->m_reportedDropped) {
+            ::LogWarning(LOG_HOST, "InfluxDB writer queue full, %llu points dropped", (unsigned long long)(dropped - writer->m_reportedDropped));
+            writer->m_reportedDropped = dropped;
+        }
+    }
+
+    writer->disconnect();
+    return nullptr;
 }
@@ -21,9 +21,14 @@
 
 #include "fne/Defines.h"
 #include "common/Log.h"
-#include "common/ThreadPool.h"
+#include "common/Thread.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
+#include <string>
 #include <cstring>
 #include <cstdio>
 #include <cstdlib>
@@ -63,8 +68,12 @@ namespace network
         //  Constants
         // ---------------------------------------------------------------------------
 
-        #define MAX_INFLUXQL_THREAD_CNT 16U
-        #define MAX_INFLUXQL_QUEUED_CNT 256U
+        #define INFLUX_LINE_BUFFER_LEN 512U
+
+        #define DEFAULT_INFLUX_BATCH_INTERVAL 1000U         // ms
+        #define DEFAULT_INFLUX_BATCH_BYTES 65536U
+        #define DEFAULT_INFLUX_MAX_QUEUED_BYTES 1048576U
+        #define INFLUX_RECONNECT_INTERVAL 5000U             // ms
 
         // ---------------------------------------------------------------------------
         //  Class Declaration
@@ -153,6 +162,26 @@ namespace network
                  */
                 static int request(const char* method, const char* uri, const std::string& queryString, const std::string& body, 
                     const ServerInfo& si);
+
+                /**
+                 * @brief Opens a blocking TCP connection to the InfluxDB server.
+                 * @param si Server Information.
+                 * @returns int Socket descriptor, or -1 if the connection failed.
+                 */
+                static int connect(const ServerInfo& si);
+                /**
+                 * @brief Helper to format the HTTP header of a InfluxDB REST API request.
+                 * @param[out] header Buffer to format the header into.
+                 * @param method HTTP Method.
+                 * @param uri URI.
+                 * @param queryString Query.
+                 * @param bodyLength Length of the content body.
+                 * @param si Server Information.
+                 * @param keepAlive Flag indicating the connection should be kept open after the request.
+                 * @returns size_t Length of the header.
+                 */
+                static size_t formatHeader(std::string& header, const char* method, const char* uri, const std::string& queryString, 
+                    size_t bodyLength, const ServerInfo& si, bool keepAlive);
             
             private:
                 /**
@@ -195,21 +224,54 @@ namespace network
 
         /**
          * @brief 
+         * @note Lines are formatted directly into a fixed buffer held by the builder, which only spills into a
+         *  heap allocated buffer for unusually long lines.
          * @ingroup fne_influx
          */
         struct HOST_SW_API QueryBuilder {
         public:
+            /**
+             * @brief Initializes a new instance of the QueryBuilder struct.
+             */
+            QueryBuilder() :
+                m_length(0U),
+                m_overflow(),
+                m_points(0U)
+            {
+                /* stub */
+            }
+
             /**
              * @brief
              * @param m 
              * @return 
              */
             detail::TagCaller& meas(const std::string& m) {
-                m_lines.imbue(std::locale("C"));
-                m_lines.clear();
+                clear();
                 return this->m(m);
             }
 
+            /**
+             * @brief Gets the formatted lines.
+             * @returns const char* Formatted lines.
+             */
+            const char* data() const { return (m_overflow.empty()) ? m_buffer : m_overflow.c_str(); }
+            /**
+             * @brief Gets the length of the formatted lines.
+             * @returns size_t Length of the formatted lines.
+             */
+            size_t length() const { return (m_overflow.empty()) ? m_length : m_overflow.length(); }
+            /**
+             * @brief Gets the number of points (lines) formatted.
+             * @returns uint32_t Number of points.
+             */
+            uint32_t points() const { return m_points; }
+            /**
+             * @brief Gets the formatted lines.
+             * @returns std::string Formatted lines.
+             */
+            std::string str() const { return std::string(data(), length()); }
+
         protected:
             /**
              * @brief
@@ -218,6 +280,7 @@ namespace network
              */
             detail::TagCaller& m(const std::string& m) {
                 escape(m, ", ");
+                m_points++;
                 return (detail::TagCaller&)*this;
             }
 
@@ -228,11 +291,11 @@ namespace network
              * @return 
              */
             detail::TagCaller& t(const std::string& k, const std::string& v) {
-                m_lines << ",";
+                append(',');
 
                 escape(k, ",= ");
-                m_lines << '=';
-                escape(std::string(v.c_str()), ",= ");
+                append('=');
+                escape(v, ",= ");
 
                 return (detail::TagCaller&)*this;
             }
@@ -245,13 +308,12 @@ namespace network
              * @return 
              */
             detail::FieldCaller& f_s(char delim, const std::string& k, const std::string& v) {
-                m_lines << delim;
-                m_lines << std::fixed;
+                append(delim);
 
                 escape(k, ",= ");
-                m_lines << "=\"";
-                escape(std::string(v.c_str()), "\"");
-                m_lines << "\"";
+                append("=\"", 2U);
+                escape(v, "\"");
+                append('"');
 
                 return (detail::FieldCaller&)*this;
             }
@@ -264,12 +326,12 @@ namespace network
              * @return 
              */
             detail::FieldCaller& f_i(char delim, const std::string& k, long long v) {
-                m_lines << delim;
-                m_lines << std::fixed;
+                append(delim);
 
                 escape(k, ",= ");
-                m_lines << "=";
-                m_lines << v << "i";
+                append('=');
+                appendInt(v);
+                append('i');
 
                 return (detail::FieldCaller&)*this;
             }
@@ -282,12 +344,12 @@ namespace network
              * @return 
              */
             detail::FieldCaller& f_ui(char delim, const std::string& k, unsigned long long v) {
-                m_lines << delim;
-                m_lines << std::fixed;
+                append(delim);
 
                 escape(k, ",= ");
-                m_lines << "=";
-                m_lines << v << "i";
+                append('=');
+                appendUInt(v);
+                append('i');
 
                 return (detail::FieldCaller&)*this;
             }
@@ -301,12 +363,11 @@ namespace network
              * @return 
              */
             detail::FieldCaller& f_f(char delim, const std::string& k, double v, int prec) {
-                m_lines << delim;
+                append(delim);
 
                 escape(k, ",= ");
-                m_lines << std::fixed;
-                m_lines.precision(prec);
-                m_lines << "=" << v;
+                append('=');
+                appendDouble(v, prec);
 
                 return (detail::FieldCaller&)*this;
             }
@@ -319,11 +380,10 @@ namespace network
              * @return 
              */
             detail::FieldCaller& f_b(char delim, const std::string& k, bool v) {
-                m_lines << delim;
+                append(delim);
 
                 escape(k, ",= ");
-                m_lines << std::fixed;
-                m_lines << "=" << (v ? "t" : "f");
+                append((v) ? "=t" : "=f", 2U);
 
                 return (detail::FieldCaller&)*this;
             }
@@ -334,7 +394,8 @@ namespace network
              * @return 
              */
             detail::TSCaller& ts(uint64_t ts) {
-                m_lines << " " << ts;
+                append(' ');
+                appendUInt(ts);
                 return (detail::TSCaller&)*this;
             }
 
@@ -348,15 +409,215 @@ namespace network
                 size_t pos = 0, start = 0;
 
                 while ((pos = src.find_first_of(escapeSeq, start)) != std::string::npos) {
-                    m_lines.write(src.c_str() + start, pos - start);
-                    m_lines << "\\" << src[pos];
+                    append(src.c_str() + start, pos - start);
+                    append('\\');
+                    append(src[pos]);
                     start = ++pos;
                 }
 
-                m_lines.write(src.c_str() + start, src.length() - start);
+                append(src.c_str() + start, src.length() - start);
+            }
+
+            /**
+             * @brief Helper to clear the formatted lines.
+             */
+            void clear()
+            {
+                m_length = 0U;
+                m_overflow.clear();
+                m_points = 0U;
             }
 
-            std::stringstream m_lines;
+            /**
+             * @brief Helper to append a character to the formatted lines.
+             * @param c Character.
+             */
+            void append(char c)
+            {
+                if (m_overflow.empty() && m_length < INFLUX_LINE_BUFFER_LEN - 1U) {
+                    m_buffer[m_length++] = c;
+                    m_buffer[m_length] = '\0';
+                    return;
+                }
+
+                append(&c, 1U);
+            }
+            /**
+             * @brief Helper to append a string to the formatted lines.
+             * @param str String.
+             * @param length Length of string.
+             */
+            void append(const char* str, size_t length);
+            /**
+             * @brief Helper to append a signed integer to the formatted lines.
+             * @param v Value.
+             */
+            void appendInt(long long v);
+            /**
+             * @brief Helper to append an unsigned integer to the formatted lines.
+             * @param v Value.
+             */
+            void appendUInt(unsigned long long v);
+            /**
+             * @brief Helper to append a fixed-point floating point value to the formatted lines.
+             * @param v Value.
+             * @param prec Number of decimal places.
+             */
+            void appendDouble(double v, int prec);
+
+            char m_buffer[INFLUX_LINE_BUFFER_LEN];
+            size_t m_length;
+            std::string m_overflow;
+            uint32_t m_points;
+        };
+
+        // ---------------------------------------------------------------------------
+        //  Structure Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Represents the statistics of the InfluxDB writer.
+         * @ingroup fne_influx
+         */
+        struct WriterStats {
+            uint32_t queuedPoints;              //! Number of points waiting to be written.
+            uint32_t queuedBytes;               //! Number of bytes waiting to be written.
+
+            uint64_t written;                   //! Total number of points written.
+            uint64_t batches;                   //! Total number of batches (requests) written.
+            uint64_t dropped;                   //! Total number of points dropped because the queue was full.
+            uint64_t failed;                    //! Total number of points that failed to be sent, or were rejected by the server.
+            uint64_t connects;                  //! Total number of connections opened to the server.
+        };
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements a batched InfluxDB writer, over a persistent (keep-alive) connection.
+         * @note Points are appended to a bounded queue, which is written by a dedicated writer thread as a single
+         *  request once the oldest queued point is older than the batch interval, or the queue holds more than the
+         *  batch size. If the queue is full new points are dropped (and counted) rather than blocking the caller.
+         *  A batch that fails to send over a connection closed by the server is resent once over a new connection.
+         * @ingroup fne_influx
+         */
+        class HOST_SW_API Writer {
+        public:
+            /**
+             * @brief Initializes a new instance of the Writer class.
+             */
+            Writer();
+            /**
+             * @brief Finalizes a instance of the Writer class.
+             */
+            ~Writer();
+
+            /**
+             * @brief Starts the writer thread.
+             * @param si Server Information.
+             * @param batchInterval Maximum time (in milliseconds) a point is queued before it is written.
+             * @param batchBytes Number of queued bytes that causes the queue to be written immediately.
+             * @param maxQueuedBytes Maximum number of queued bytes, before new points are dropped.
+             * @returns bool True, if the writer thread was started, otherwise false.
+             */
+            bool start(const ServerInfo& si, uint32_t batchInterval = DEFAULT_INFLUX_BATCH_INTERVAL, 
+                uint32_t batchBytes = DEFAULT_INFLUX_BATCH_BYTES, uint32_t maxQueuedBytes = DEFAULT_INFLUX_MAX_QUEUED_BYTES);
+            /**
+             * @brief Stops the writer thread, writing any remaining queued points.
+             */
+            void stop();
+            /**
+             * @brief Flag indicating whether the writer thread is running.
+             * @returns bool True, if the writer thread is running, otherwise false.
+             */
+            bool isRunning() const { return m_running; }
+
+            /**
+             * @brief Queues lines to be written.
+             * @param si Server Information.
+             * @param lines Line protocol lines.
+             * @param length Length of lines.
+             * @param points Number of points (lines).
+             * @returns bool True, if the lines were queued, otherwise false.
+             */
+            bool write(const ServerInfo& si, const char* lines, size_t length, uint32_t points);
+            /**
+             * @brief Wakes the writer thread to write the queued points immediately.
+             */
+            void flush();
+
+            /**
+             * @brief Gets the statistics of the writer.
+             * @returns WriterStats Writer statistics.
+             */
+            WriterStats stats();
+
+        private:
+            ServerInfo m_si;
+            uint32_t m_batchInterval;
+            uint32_t m_batchBytes;
+            uint32_t m_maxQueuedBytes;
+
+            thread_t m_thread;
+            std::atomic<bool> m_running;
+            bool m_signalled;
+            std::mutex m_mutex;
+            std::condition_variable m_cond;
+
+            std::string m_pending;
+            uint32_t m_pendingPoints;
+            std::chrono::steady_clock::time_point m_pendingStart;
+
+            std::string m_sending;
+            std::string m_header;
+            std::string m_response;
+
+            int m_fd;
+            std::chrono::steady_clock::time_point m_retryTime;
+
+            std::atomic<uint64_t> m_written;
+            std::atomic<uint64_t> m_batches;
+            std::atomic<uint64_t> m_dropped;
+            std::atomic<uint64_t> m_failed;
+            std::atomic<uint64_t> m_connects;
+            uint64_t m_reportedDropped;
+
+            /**
+             * @brief Writes a batch of points, reconnecting (once) if the connection was closed.
+             * @param body Line protocol lines.
+             * @param points Number of points (lines).
+             */
+            void writeBatch(const std::string& body, uint32_t points);
+            /**
+             * @brief Sends a request over the persistent connection and reads the response.
+             * @param body Line protocol lines.
+             * @param[out] sent Flag indicating the request was sent (and may have been processed by the server).
+             * @returns int HTTP status code, or -1 if the connection failed.
+             */
+            int post(const std::string& body, bool& sent);
+            /**
+             * @brief Reads a HTTP response from the persistent connection.
+             * @param[out] keepAlive Flag indicating the server keeps the connection open.
+             * @returns int HTTP status code, or -1 if the connection failed.
+             */
+            int readResponse(bool& keepAlive);
+            /**
+             * @brief Helper to check if the persistent connection is (still) connected, and connect if necessary.
+             * @returns bool True, if connected, otherwise false.
+             */
+            bool ensureConnected();
+            /**
+             * @brief Closes the persistent connection.
+             */
+            void disconnect();
+
+            /**
+             * @brief Entry point to writer thread.
+             * @param arg Instance of the thread_t structure.
+             * @returns void* (Ignore)
+             */
+            static void* threadWriter(void* arg);
         };
 
         namespace detail {
@@ -372,6 +633,7 @@ namespace network
             {
                 detail::TagCaller& tag(const std::string& k, const std::string& v)       { return t(k, v); }
                 detail::FieldCaller& field(const std::string& k, const std::string& v)   { return f_s(' ', k, v); }
+                detail::FieldCaller& field(const std::string& k, const char* v)          { return f_s(' ', k, v); }
                 detail::FieldCaller& field(const std::string& k, bool v)                 { return f_b(' ', k, v); }
                 detail::FieldCaller& field(const std::string& k, short v)                { return f_i(' ', k, v); }
                 detail::FieldCaller& field(const std::string& k, int v)                  { return f_i(' ', k, v); }
@@ -390,80 +652,34 @@ namespace network
             //  Structure Declaration
             // ---------------------------------------------------------------------------
 
-            /**
-             * @brief Represents the data required for a voice service packet handler thread.
-             * @ingroup rc_network
-             */
-            struct TSCallerRequest : thread_t {
-                ServerInfo si;         //!
-                std::string lines;     //!
-            };
-
-            // ---------------------------------------------------------------------------
-            //  Structure Declaration
-            // ---------------------------------------------------------------------------
-
             /**
              * @brief 
              * @ingroup fne_influx
              */
             struct HOST_SW_API TSCaller : public QueryBuilder
             {                
-                detail::TagCaller& meas(const std::string& m)                   { m_lines << '\n'; return this->m(m); }
-                int request(const ServerInfo& si)  { return detail::inner::request("POST", "write", "", m_lines.str(), si); }
+                detail::TagCaller& meas(const std::string& m)                   { append('\n'); return this->m(m); }
+                int request(const ServerInfo& si)  { return detail::inner::request("POST", "write", "", str(), si); }
                 int requestAsync(const ServerInfo& si) 
                 {
-                    TSCallerRequest* req = new TSCallerRequest();
-                    req->obj = this;
-
-                    req->si = ServerInfo(si.host(), si.port(), si.org(), si.token(), si.bucket());
-                    req->lines = std::string(m_lines.str());
-
-                    // enqueue the task
-                    if (!m_fluxReqThreadPool.enqueue(new_pooltask(taskFluxRequest, req))) {
-                        LogError(LOG_NET, "Failed to task enqueue Influx query request");
-                        if (req != nullptr)
-                            delete req;
+                    // queue the lines for the writer thread
+                    if (!m_writer.write(si, data(), length(), points())) {
                         return 1;
                     }
-            
+
                     return 0; 
                 }
 
-                static void start() 
+                static bool start(const ServerInfo& si, uint32_t batchInterval = DEFAULT_INFLUX_BATCH_INTERVAL, 
+                    uint32_t batchBytes = DEFAULT_INFLUX_BATCH_BYTES, uint32_t maxQueuedBytes = DEFAULT_INFLUX_MAX_QUEUED_BYTES) 
                 { 
-                    m_fluxReqThreadPool.setMaxQueuedTasks(MAX_INFLUXQL_QUEUED_CNT);
-                    m_fluxReqThreadPool.start(); 
+                    return m_writer.start(si, batchInterval, batchBytes, maxQueuedBytes);
                 }
-                static void stop() { m_fluxReqThreadPool.stop(); }
-                static void wait() { m_fluxReqThreadPool.wait(); }
+                static void stop() { m_writer.stop(); }
+                static WriterStats stats() { return m_writer.stats(); }
 
             private:
-                static ThreadPool m_fluxReqThreadPool;
-
-                /**
-                 * @brief 
-                 */
-                static void taskFluxRequest(TSCallerRequest* req)
-                {
-                    if (req == nullptr) {
-                        return;
-                    }
-
-                    TSCaller* caller = static_cast<TSCaller*>(req->obj);
-                    if (caller == nullptr) {
-                        if (req != nullptr) {
-                            delete req;
-                        }
-
-                        return;
-                    }
-
-                    const ServerInfo& si = req->si;
-                    detail::inner::request("POST", "write", "", req->lines, si);
-
-                    delete req;
-                }
+                static Writer m_writer;
             };
 
             // ---------------------------------------------------------------------------
@@ -478,6 +694,7 @@ namespace network
             struct HOST_SW_API FieldCaller : public TSCaller 
             {
                 detail::FieldCaller& field(const std::string& k, const std::string& v)   { return f_s(',', k, v); }
+                detail::FieldCaller& field(const std::string& k, const char* v)          { return f_s(',', k, v); }
                 detail::FieldCaller& field(const std::string& k, bool v)                 { return f_b(',', k, v); }
                 detail::FieldCaller& field(const std::string& k, short v)                { return f_i(',', k, v); }
                 detail::FieldCaller& field(const std::string& k, int v)                  { return f_i(',', k, v); }
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "CCBcastCache.h"
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the CCBcastCache class. */
+
+CCBcastCache::CCBcastCache(uint32_t frameLength, uint32_t maxEntries) :
+    m_frameLength(frameLength),
+    m_maxEntries(maxEntries),
+    m_useCnt(0U),
+    m_entries()
+{
+    assert(frameLength > 0U);
+    assert(maxEntries > 0U);
+}
+
+/* Finds a cached frame. */
+
+const uint8_t* CCBcastCache::find(ulong64_t key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return nullptr;
+
+    it->second.lastUsed = ++m_useCnt;
+    return it->second.data.get();
+}
+
+/* Adds a frame to the cache. */
+
+uint8_t* CCBcastCache::add(ulong64_t key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        if (m_entries.size() >= m_maxEntries) {
+            evict();
+        }
+
+        Entry entry;
+        entry.data = std::make_unique<uint8_t[]>(m_frameLength);
+        it = m_entries.emplace(key, std::move(entry)).first;
+    }
+
+    ::memset(it->second.data.get(), 0x00U, m_frameLength);
+    it->second.lastUsed = ++m_useCnt;
+    return it->second.data.get();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to evict the least recently used frame. */
+
+void CCBcastCache::evict()
+{
+    auto lru = m_entries.begin();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->second.lastUsed < lru->second.lastUsed)
+            lru = it;
+    }
+
+    if (lru != m_entries.end())
+        m_entries.erase(lru);
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file CCBcastCache.h
+ * @ingroup host
+ * @file CCBcastCache.cpp
+ * @ingroup host
+ */
+#if !defined(__CC_BCAST_CACHE_H__)
+#define __CC_BCAST_CACHE_H__
+
+#include "Defines.h"
+#include "common/VariableLengthArray.h"
+
+#include <unordered_map>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup host
+ * @{
+ */
+
+const uint32_t CC_BCAST_CACHE_DEFAULT_MAX = 256U;
+
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a cache of fully encoded (air-ready) control channel broadcast frames.
+ * @note The cache holds a bounded number of frames; when it is full, the least recently used frame is
+ *  evicted to make room (the cache is never cleared to make room). Stale broadcasts (i.e. for an adjacent
+ *  site that no longer exists) are never looked up again, and are the first to be evicted.
+ *
+ *  The cache is not thread-safe, the caller is expected to serialize access.
+ * @ingroup host
+ */
+class HOST_SW_API CCBcastCache {
+public:
+    /**
+     * @brief Initializes a new instance of the CCBcastCache class.
+     * @param frameLength Length of a cached frame.
+     * @param maxEntries Maximum number of cached frames.
+     */
+    CCBcastCache(uint32_t frameLength, uint32_t maxEntries = CC_BCAST_CACHE_DEFAULT_MAX);
+
+    /**
+     * @brief Finds a cached frame.
+     * @param key Cache key of the broadcast.
+     * @returns const uint8_t* Cached frame, or nullptr if the broadcast isn't cached.
+     */
+    const uint8_t* find(ulong64_t key);
+    /**
+     * @brief Adds a frame to the cache.
+     * @note The returned frame is zeroed, and must be encoded by the caller before it is next looked up.
+     * @param key Cache key of the broadcast.
+     * @returns uint8_t* Frame to encode the broadcast into.
+     */
+    uint8_t* add(ulong64_t key);
+
+    /**
+     * @brief Clears all cached frames.
+     */
+    void clear() { m_entries.clear(); }
+
+    /**
+     * @brief Flag indicating the cache has no cached frames.
+     * @returns bool True, if the cache is empty, otherwise false.
+     */
+    bool isEmpty() const { return m_entries.empty(); }
+    /**
+     * @brief Gets the number of cached frames.
+     * @returns uint32_t Number of cached frames.
+     */
+    uint32_t size() const { return (uint32_t)m_entries.size(); }
+    /**
+     * @brief Gets the length of a cached frame.
+     * @returns uint32_t Length of a cached frame.
+     */
+    uint32_t frameLength() const { return m_frameLength; }
+
+private:
+    /**
+     * @brief Represents a cached frame.
+     */
+    struct Entry {
+        UInt8Array data;                                //! Frame data
+        ulong64_t lastUsed = 0U;                        //! Use count when the frame was last looked up
+    };
+
+    uint32_t m_frameLength;
+    uint32_t m_maxEntries;
+    ulong64_t m_useCnt;
+
+    std::unordered_map<ulong64_t, Entry> m_entries;
+
+    /**
+     * @brief Helper to evict the least recently used frame.
+     */
+    void evict();
+};
+
+#endif // __CC_BCAST_CACHE_H__
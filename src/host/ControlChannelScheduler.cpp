@@ -0,0 +1,282 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "ControlChannelScheduler.h"
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the ControlChannelScheduler class. */
+
+ControlChannelScheduler::ControlChannelScheduler(uint32_t length, const char* name) :
+    m_name(name),
+    m_length(length),
+    m_dataSize(0U),
+    m_queue(),
+    m_deadline(),
+    m_stats(),
+    m_latency(),
+    m_heldClass(CC_TRAFFIC_CLASS_CNT)
+{
+    assert(length > 0U);
+
+    m_deadline[CCTrafficClass::GRANT] = CC_DEFAULT_GRANT_DEADLINE;
+    m_deadline[CCTrafficClass::RESPONSE] = CC_DEFAULT_RESPONSE_DEADLINE;
+    m_deadline[CCTrafficClass::SIGNALING] = CC_DEFAULT_SIGNALING_DEADLINE;
+    m_deadline[CCTrafficClass::BROADCAST] = CC_DEFAULT_BROADCAST_DEADLINE;
+
+    for (uint32_t i = 0U; i < CC_TRAFFIC_CLASS_CNT; i++) {
+        ::memset(&m_stats[i], 0x00U, sizeof(CCSchedulerStats));
+        m_latency[i] = new LatencyHistogram(m_name + " " + className((CCTrafficClass::E)i));
+    }
+}
+
+/* Finalizes a instance of the ControlChannelScheduler class. */
+
+ControlChannelScheduler::~ControlChannelScheduler()
+{
+    for (uint32_t i = 0U; i < CC_TRAFFIC_CLASS_CNT; i++) {
+        delete m_latency[i];
+    }
+}
+
+/* Sets the deadline of the given traffic class. */
+
+void ControlChannelScheduler::setDeadline(CCTrafficClass::E trafficClass, uint32_t deadline)
+{
+    assert(trafficClass < CC_TRAFFIC_CLASS_CNT);
+    m_deadline[trafficClass] = deadline;
+}
+
+/* Adds a frame to the scheduler. */
+
+bool ControlChannelScheduler::add(const uint8_t* data, uint32_t length, CCTrafficClass::E trafficClass, ulong64_t key)
+{
+    assert(data != nullptr);
+    assert(trafficClass < CC_TRAFFIC_CLASS_CNT);
+
+    std::deque<Frame>& queue = m_queue[trafficClass];
+
+    // is there already a queued frame this frame supersedes? (the frame held as the next frame is left as it is)
+    if (key != 0U) {
+        for (size_t i = 0U; i < queue.size(); i++) {
+            Frame& frame = queue[i];
+            if (frame.key != key || isHeld(trafficClass, i))
+                continue;
+
+            // a frame of a differing length isn't coalesced; the superseded frame is removed and the frame
+            // is queued as a new frame (making room may expire or drop queued frames)
+            if (frame.length != length) {
+                m_dataSize -= frame.length + 2U;
+                queue.erase(queue.begin() + i);
+                break;
+            }
+
+            ::memcpy(frame.data.get(), data, length);
+            frame.queued = LatencyHistogram::now();
+            m_stats[trafficClass].coalesced++;
+            return true;
+        }
+    }
+
+    // each frame is accounted for along with its length, as it would be in a ring buffer
+    if (!makeRoom(length + 2U, trafficClass)) {
+        m_stats[trafficClass].dropped++;
+        return false;
+    }
+
+    Frame frame;
+    frame.data = std::unique_ptr<uint8_t[]>(new uint8_t[length]);
+    ::memcpy(frame.data.get(), data, length);
+    frame.length = length;
+    frame.key = key;
+    frame.queued = LatencyHistogram::now();
+
+    queue.push_back(std::move(frame));
+    m_dataSize += length + 2U;
+
+    m_stats[trafficClass].queued++;
+    return true;
+}
+
+/* Gets the length of the next frame to be released, and holds the frame as the next frame. */
+
+uint32_t ControlChannelScheduler::peek(CCTrafficClass::E maxClass)
+{
+    if (m_heldClass < CC_TRAFFIC_CLASS_CNT)
+        return m_queue[m_heldClass].front().length;
+
+    if (isEmpty())
+        return 0U;
+
+    expire(LatencyHistogram::now());
+
+    for (uint32_t i = 0U; i <= maxClass && i < CC_TRAFFIC_CLASS_CNT; i++) {
+        if (!m_queue[i].empty()) {
+            m_heldClass = i;
+            return m_queue[i].front().length;
+        }
+    }
+
+    return 0U;
+}
+
+/* Gets the next frame to be released. */
+
+uint32_t ControlChannelScheduler::get(uint8_t* data, CCTrafficClass::E maxClass)
+{
+    assert(data != nullptr);
+
+    uint64_t now = LatencyHistogram::now();
+    if (m_heldClass < CC_TRAFFIC_CLASS_CNT)
+        return release(m_heldClass, data, now);
+
+    if (isEmpty())
+        return 0U;
+
+    expire(now);
+
+    for (uint32_t i = 0U; i <= maxClass && i < CC_TRAFFIC_CLASS_CNT; i++) {
+        if (!m_queue[i].empty())
+            return release(i, data, now);
+    }
+
+    return 0U;
+}
+
+/* Clears all queued frames. */
+
+void ControlChannelScheduler::clear()
+{
+    for (uint32_t i = 0U; i < CC_TRAFFIC_CLASS_CNT; i++) {
+        m_queue[i].clear();
+    }
+
+    m_dataSize = 0U;
+    m_heldClass = CC_TRAFFIC_CLASS_CNT;
+}
+
+/* Clears all queued frames of the given traffic class. */
+
+void ControlChannelScheduler::clear(CCTrafficClass::E trafficClass)
+{
+    std::deque<Frame>& queue = m_queue[trafficClass];
+    for (const Frame& frame : queue) {
+        m_dataSize -= frame.length + 2U;
+    }
+
+    queue.clear();
+    if (m_heldClass == trafficClass)
+        m_heldClass = CC_TRAFFIC_CLASS_CNT;
+}
+
+/* Gets the statistics of the given traffic class. */
+
+CCSchedulerStats ControlChannelScheduler::stats(CCTrafficClass::E trafficClass) const
+{
+    assert(trafficClass < CC_TRAFFIC_CLASS_CNT);
+
+    CCSchedulerStats stats = m_stats[trafficClass];
+    stats.depth = (uint32_t)m_queue[trafficClass].size();
+    return stats;
+}
+
+/* Helper to get the name of the given traffic class. */
+
+std::string ControlChannelScheduler::className(CCTrafficClass::E trafficClass)
+{
+    switch (trafficClass) {
+    case CCTrafficClass::GRANT:
+        return "Grant";
+    case CCTrafficClass::RESPONSE:
+        return "Response";
+    case CCTrafficClass::SIGNALING:
+        return "Signaling";
+    case CCTrafficClass::BROADCAST:
+        return "Broadcast";
+    default:
+        return "Unknown";
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to drop frames that exceeded the deadline of their class. */
+
+void ControlChannelScheduler::expire(uint64_t now)
+{
+    for (uint32_t i = 0U; i < CC_TRAFFIC_CLASS_CNT; i++) {
+        if (m_deadline[i] == 0U)
+            continue;
+
+        // coalescing refreshes the data of a queued frame, so frames within a class aren't in deadline order
+        uint64_t deadline = (uint64_t)m_deadline[i] * 1000U;
+        std::deque<Frame>& queue = m_queue[i];
+        for (size_t j = 0U; j < queue.size();) {
+            if (isHeld(i, j) || (now - queue[j].queued) < deadline) {
+                j++;
+                continue;
+            }
+
+            m_dataSize -= queue[j].length + 2U;
+            queue.erase(queue.begin() + j);
+            m_stats[i].expired++;
+        }
+    }
+}
+
+/* Helper to release the frame at the front of the given traffic class. */
+
+uint32_t ControlChannelScheduler::release(uint32_t trafficClass, uint8_t* data, uint64_t now)
+{
+    std::deque<Frame>& queue = m_queue[trafficClass];
+
+    Frame& frame = queue.front();
+    uint32_t length = frame.length;
+    ::memcpy(data, frame.data.get(), length);
+
+    m_latency[trafficClass]->record(now - frame.queued);
+    m_stats[trafficClass].sent++;
+
+    m_dataSize -= length + 2U;
+    queue.pop_front();
+
+    m_heldClass = CC_TRAFFIC_CLASS_CNT;
+    return length;
+}
+
+/* Helper to drop frames of a lower priority class, until there is room for the given amount of data. */
+
+bool ControlChannelScheduler::makeRoom(uint32_t length, CCTrafficClass::E trafficClass)
+{
+    if (length > m_length)
+        return false;
+
+    if (freeSpace() < length) {
+        expire(LatencyHistogram::now());
+    }
+
+    // drop the newest frames of the lowest priority classes first
+    for (uint32_t i = CC_TRAFFIC_CLASS_CNT - 1U; i > trafficClass && freeSpace() < length; i--) {
+        std::deque<Frame>& queue = m_queue[i];
+        while (!queue.empty() && !isHeld(i, queue.size() - 1U) && freeSpace() < length) {
+            m_dataSize -= queue.back().length + 2U;
+            queue.pop_back();
+            m_stats[i].dropped++;
+        }
+    }
+
+    return freeSpace() >= length;
+}
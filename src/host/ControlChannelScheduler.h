@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file ControlChannelScheduler.h
+ * @ingroup host
+ * @file ControlChannelScheduler.cpp
+ * @ingroup host
+ */
+#if !defined(__CONTROL_CHANNEL_SCHEDULER_H__)
+#define __CONTROL_CHANNEL_SCHEDULER_H__
+
+#include "Defines.h"
+#include "common/LatencyHistogram.h"
+
+#include <deque>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/**
+ * @addtogroup host
+ * @{
+ */
+
+/** @brief Control Channel Traffic Class(es) */
+namespace CCTrafficClass {
+    /** @brief Control Channel Traffic Class(es) (in order of priority) */
+    enum E : uint8_t {
+        GRANT = 0U,                                     //! Channel Grants
+        RESPONSE = 1U,                                  //! Registration, Affiliation, Acknowledge and Deny Responses
+        SIGNALING = 2U,                                 //! Unit-to-Unit Signaling
+        BROADCAST = 3U                                  //! Control Channel Broadcasts
+    };
+}
+
+const uint32_t CC_TRAFFIC_CLASS_CNT = 4U;
+
+const uint32_t CC_DEFAULT_GRANT_DEADLINE = 0U;          // grants never expire
+const uint32_t CC_DEFAULT_RESPONSE_DEADLINE = 2000U;
+const uint32_t CC_DEFAULT_SIGNALING_DEADLINE = 2000U;
+const uint32_t CC_DEFAULT_BROADCAST_DEADLINE = 1000U;
+
+const uint32_t CC_BCAST_QUEUE_DEPTH = 4U;               // broadcast filler queued ahead of the air
+
+/** @} */
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents the statistics of a control channel traffic class.
+ * @ingroup host
+ */
+struct CCSchedulerStats {
+    uint32_t depth;                                     //! Number of queued frames
+    uint64_t queued;                                    //! Total number of queued frames
+    uint64_t sent;                                      //! Total number of frames released for transmission
+    uint64_t coalesced;                                 //! Total number of frames coalesced into an already queued frame
+    uint64_t dropped;                                   //! Total number of frames dropped because the scheduler was full
+    uint64_t expired;                                   //! Total number of frames dropped because they exceeded their deadline
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a priority-aware outbound frame scheduler for control channel signaling.
+ * @note Frames are queued by traffic class, and are always released from the highest priority class
+ *  first (grants, then responses, then signaling, then broadcasts); frames within a class are released in
+ *  the order they were queued. Frames that have waited longer than the deadline of their class are dropped
+ *  instead of being released late. A frame queued with a coalescing key replaces the data of an already queued
+ *  frame of the same class and key, keeping its place in the queue (its deadline and latency restart from the
+ *  newer data); a frame of a differing length instead removes the queued frame and is queued last. When the scheduler is full, frames of a lower priority class are dropped to make room (newest
+ *  first); the scheduler is never cleared to make room.
+ *
+ *  A frame returned by peek() is held as the next frame; it is never expired, dropped or coalesced, and is the
+ *  frame released by the following get(), regardless of any frames queued in between.
+ *
+ *  The scheduler is not thread-safe, the caller is expected to serialize access.
+ * @ingroup host
+ */
+class HOST_SW_API ControlChannelScheduler {
+public:
+    /**
+     * @brief Initializes a new instance of the ControlChannelScheduler class.
+     * @param length Capacity of the scheduler (in bytes).
+     * @param name Name of the scheduler.
+     */
+    ControlChannelScheduler(uint32_t length, const char* name);
+    /**
+     * @brief Finalizes a instance of the ControlChannelScheduler class.
+     */
+    ~ControlChannelScheduler();
+
+    /**
+     * @brief Sets the deadline of the given traffic class.
+     * @param trafficClass Traffic class.
+     * @param deadline Amount of time (ms) a frame may be queued before it is dropped (0 disables the deadline).
+     */
+    void setDeadline(CCTrafficClass::E trafficClass, uint32_t deadline);
+
+    /**
+     * @brief Adds a frame to the scheduler.
+     * @param data Frame data.
+     * @param length Length of the frame.
+     * @param trafficClass Traffic class of the frame.
+     * @param key Coalescing key (0 disables coalescing).
+     * @returns bool True, if the frame was queued or coalesced, otherwise false.
+     */
+    bool add(const uint8_t* data, uint32_t length, CCTrafficClass::E trafficClass, ulong64_t key = 0U);
+    /**
+     * @brief Gets the length of the next frame to be released, and holds the frame as the next frame.
+     * @note Frames that exceeded their deadline are dropped. A frame already held is always returned.
+     * @param maxClass Lowest priority traffic class to consider.
+     * @returns uint32_t Length of the next frame, or 0 if there are no frames.
+     */
+    uint32_t peek(CCTrafficClass::E maxClass = CCTrafficClass::BROADCAST);
+    /**
+     * @brief Gets the next frame to be released.
+     * @note The frame held by peek() is released, if there is one; otherwise frames that exceeded their
+     *  deadline are dropped and the next frame is released.
+     * @param[out] data Buffer to copy the frame into.
+     * @param maxClass Lowest priority traffic class to consider.
+     * @returns uint32_t Length of the frame, or 0 if there are no frames.
+     */
+    uint32_t get(uint8_t* data, CCTrafficClass::E maxClass = CCTrafficClass::BROADCAST);
+
+    /**
+     * @brief Clears all queued frames.
+     */
+    void clear();
+    /**
+     * @brief Clears all queued frames of the given traffic class.
+     * @param trafficClass Traffic class.
+     */
+    void clear(CCTrafficClass::E trafficClass);
+
+    /**
+     * @brief Flag indicating the scheduler has no queued frames.
+     * @returns bool True, if the scheduler is empty, otherwise false.
+     */
+    bool isEmpty() const { return m_dataSize == 0U; }
+    /**
+     * @brief Gets the capacity of the scheduler.
+     * @returns uint32_t Capacity of the scheduler (in bytes).
+     */
+    uint32_t length() const { return m_length; }
+    /**
+     * @brief Gets the amount of queued data.
+     * @returns uint32_t Amount of queued data (in bytes).
+     */
+    uint32_t dataSize() const { return m_dataSize; }
+    /**
+     * @brief Gets the free space of the scheduler.
+     * @returns uint32_t Free space (in bytes).
+     */
+    uint32_t freeSpace() const { return m_length - m_dataSize; }
+    /**
+     * @brief Gets the number of queued frames of the given traffic class.
+     * @param trafficClass Traffic class.
+     * @returns uint32_t Number of queued frames.
+     */
+    uint32_t depth(CCTrafficClass::E trafficClass) const { return (uint32_t)m_queue[trafficClass].size(); }
+
+    /**
+     * @brief Gets the statistics of the given traffic class.
+     * @param trafficClass Traffic class.
+     * @returns CCSchedulerStats Statistics of the traffic class.
+     */
+    CCSchedulerStats stats(CCTrafficClass::E trafficClass) const;
+    /**
+     * @brief Gets the queueing latency histogram of the given traffic class.
+     * @note The histogram of the grant class is the measured grant latency.
+     * @param trafficClass Traffic class.
+     * @returns LatencyHistogram* Queueing latency histogram (us).
+     */
+    LatencyHistogram* latency(CCTrafficClass::E trafficClass) const { return m_latency[trafficClass]; }
+
+    /**
+     * @brief Helper to get the name of the given traffic class.
+     * @param trafficClass Traffic class.
+     * @returns std::string Name of the traffic class.
+     */
+    static std::string className(CCTrafficClass::E trafficClass);
+
+private:
+    /**
+     * @brief Represents a queued frame.
+     */
+    struct Frame {
+        UInt8Array data;                                //! Frame data
+        uint32_t length;                                //! Length of frame data
+        ulong64_t key;                                  //! Coalescing key
+        uint64_t queued;                                //! Time (us) the frame data was queued
+    };
+
+    std::string m_name;
+    uint32_t m_length;
+    uint32_t m_dataSize;
+
+    std::deque<Frame> m_queue[CC_TRAFFIC_CLASS_CNT];
+    uint32_t m_deadline[CC_TRAFFIC_CLASS_CNT];
+
+    CCSchedulerStats m_stats[CC_TRAFFIC_CLASS_CNT];
+    LatencyHistogram* m_latency[CC_TRAFFIC_CLASS_CNT];
+
+    uint32_t m_heldClass;
+
+    /**
+     * @brief Helper to drop frames that exceeded the deadline of their class.
+     * @param now Current time (us).
+     */
+    void expire(uint64_t now);
+    /**
+     * @brief Helper to release the frame at the front of the given traffic class.
+     * @param trafficClass Traffic class.
+     * @param[out] data Buffer to copy the frame into.
+     * @param now Current time (us).
+     * @returns uint32_t Length of the frame.
+     */
+    uint32_t release(uint32_t trafficClass, uint8_t* data, uint64_t now);
+    /**
+     * @brief Helper to determine whether the given queued frame is held as the next frame.
+     * @param trafficClass Traffic class.
+     * @param index Index of the frame within its traffic class.
+     * @returns bool True, if the frame is held, otherwise false.
+     */
+    bool isHeld(uint32_t trafficClass, size_t index) const { return trafficClass == m_heldClass && index == 0U; }
+    /**
+     * @brief Helper to drop frames of a lower priority class, until there is room for the given amount of data.
+     * @param length Amount of data (in bytes).
+     * @param trafficClass Traffic class of the data.
+     * @returns bool True, if there is room for the data, otherwise false.
+     */
+    bool makeRoom(uint32_t length, CCTrafficClass::E trafficClass);
+};
+
+#endif // __CONTROL_CHANNEL_SCHEDULER_H__
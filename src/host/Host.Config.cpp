@@ -76,6 +76,7 @@ bool Host::readParams()
     m_idleTickDelay = (uint8_t)systemConf["idleTickDelay"].as<uint32_t>(5U);
     if (m_idleTickDelay < 1U)
         m_idleTickDelay = 1U;
+    m_modemEventDriven = systemConf["eventDrivenModem"].as<bool>(false);
 
     m_identity = systemConf["identity"].as<std::string>();
     m_fixedMode = systemConf["fixedMode"].as<bool>(false);
@@ -102,6 +103,7 @@ bool Host::readParams()
         }
         LogInfo("    Active Tick Delay: %ums", m_activeTickDelay);
         LogInfo("    Idle Tick Delay: %ums", m_idleTickDelay);
+        LogInfo("    Event Driven Modem: %s", m_modemEventDriven ? "yes" : "no");
         LogInfo("    Timeout: %us", m_timeout);
         LogInfo("    RF Mode Hang: %us", m_rfModeHang);
         LogInfo("    RF Talkgroup Hang: %us", m_rfTalkgroupHang);
@@ -836,6 +838,10 @@ bool Host::createNetwork()
     bool allowStatusTransfer = networkConf["allowStatusTransfer"].as<bool>(true);
     bool updateLookup = networkConf["updateLookups"].as<bool>(false);
     bool saveLookup = networkConf["saveLookups"].as<bool>(false);
+    bool jitterBuffer = networkConf["jitterBuffer"].as<bool>(true);
+    uint32_t jitterBufferMinDepth = networkConf["jitterBufferMinDepth"].as<uint32_t>(JITTER_BUFFER_DEFAULT_MIN_DEPTH);
+    uint32_t jitterBufferMaxDepth = networkConf["jitterBufferMaxDepth"].as<uint32_t>(JITTER_BUFFER_DEFAULT_MAX_DEPTH);
+    uint32_t jitterBufferMaxWait = networkConf["jitterBufferMaxWait"].as<uint32_t>(JITTER_BUFFER_DEFAULT_MAX_WAIT);
     bool debug = networkConf["debug"].as<bool>(false);
 
     m_allowStatusTransfer = allowStatusTransfer;
@@ -922,6 +928,11 @@ bool Host::createNetwork()
         LogInfo("    Allow Status Transfer: %s", m_allowStatusTransfer ? "yes" : "no");
         LogInfo("    Update Lookups: %s", updateLookup ? "yes" : "no");
         LogInfo("    Save Network Lookups: %s", saveLookup ? "yes" : "no");
+        LogInfo("    Jitter Buffer: %s", jitterBuffer ? "yes" : "no");
+        if (jitterBuffer) {
+            LogInfo("    Jitter Buffer Depth: %u - %u frames", jitterBufferMinDepth, jitterBufferMaxDepth);
+            LogInfo("    Jitter Buffer Max Wait: %ums", jitterBufferMaxWait);
+        }
 
         LogInfo("    Encrypted: %s", encrypted ? "yes" : "no");
 
@@ -966,6 +977,8 @@ bool Host::createNetwork()
             m_network->setPresharedKey(presharedKey);
         }
 
+        m_network->setJitterBuffer(jitterBuffer, jitterBufferMinDepth, jitterBufferMaxDepth, jitterBufferMaxWait);
+
         m_network->enable(true);
         bool ret = m_network->open();
         if (!ret) {
@@ -175,10 +175,16 @@ void* Host::threadDMRReader1(void* arg)
                     }
                 }
 
-                if (host->m_state != STATE_IDLE)
-                    Thread::sleep(m_activeTickDelay);
-                if (host->m_state == STATE_IDLE)
-                    Thread::sleep(m_idleTickDelay);
+                if (host->m_modemEventDriven) {
+                    // wait for the modem to queue frame data (the wait is bounded by the tick delay to keep timers clocked)
+                    host->m_modem->waitForRxData(modem::RX_SIGNAL_DMR1, (host->m_state != STATE_IDLE) ? m_activeTickDelay : m_idleTickDelay);
+                }
+                else {
+                    if (host->m_state != STATE_IDLE)
+                        Thread::sleep(m_activeTickDelay);
+                    if (host->m_state == STATE_IDLE)
+                        Thread::sleep(m_idleTickDelay);
+                }
             }
         }
 
@@ -459,10 +465,16 @@ void* Host::threadDMRReader2(void* arg)
                     }
                 }
 
-                if (host->m_state != STATE_IDLE)
-                    Thread::sleep(m_activeTickDelay);
-                if (host->m_state == STATE_IDLE)
-                    Thread::sleep(m_idleTickDelay);
+                if (host->m_modemEventDriven) {
+                    // wait for the modem to queue frame data (the wait is bounded by the tick delay to keep timers clocked)
+                    host->m_modem->waitForRxData(modem::RX_SIGNAL_DMR2, (host->m_state != STATE_IDLE) ? m_activeTickDelay : m_idleTickDelay);
+                }
+                else {
+                    if (host->m_state != STATE_IDLE)
+                        Thread::sleep(m_activeTickDelay);
+                    if (host->m_state == STATE_IDLE)
+                        Thread::sleep(m_idleTickDelay);
+                }
             }
         }
 
@@ -124,10 +124,16 @@ void* Host::threadNXDNReader(void* arg)
                     }
                 }
 
-                if (host->m_state != STATE_IDLE)
-                    Thread::sleep(m_activeTickDelay);
-                if (host->m_state == STATE_IDLE)
-                    Thread::sleep(m_idleTickDelay);
+                if (host->m_modemEventDriven) {
+                    // wait for the modem to queue frame data (the wait is bounded by the tick delay to keep timers clocked)
+                    host->m_modem->waitForRxData(modem::RX_SIGNAL_NXDN, (host->m_state != STATE_IDLE) ? m_activeTickDelay : m_idleTickDelay);
+                }
+                else {
+                    if (host->m_state != STATE_IDLE)
+                        Thread::sleep(m_activeTickDelay);
+                    if (host->m_state == STATE_IDLE)
+                        Thread::sleep(m_idleTickDelay);
+                }
             }
         }
 
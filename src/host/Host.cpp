@@ -162,6 +162,8 @@ Host::Host(const std::string& confFile) :
     m_p25OverflowCnt(0U),
     m_nxdnOverflowCnt(0U),
     m_disableWatchdogOverflow(false),
+    m_modemEventDriven(false),
+    m_modemPoller(),
     m_restAddress("0.0.0.0"),
     m_restPort(REST_API_DEFAULT_PORT),
     m_RESTAPI(nullptr),
@@ -253,6 +255,14 @@ int Host::run()
     }
 #endif // !defined(_WIN32)
 
+    // start the log writer thread (this is done after forking, the log writer thread does not survive a fork)
+    if (logConf["asyncLogging"].as<bool>(false)) {
+        if (!::LogStartAsync(logConf["asyncBufferSize"].as<uint32_t>(64U) * 1024U, logConf["asyncDropOnOverflow"].as<bool>(true))) {
+            ::LogError(LOG_HOST, "Failed to start log writer thread, log entries will be written synchronously");
+        }
+    }
+    ::LogSetRateLimit(logConf["rateLimit"].as<uint32_t>(0U));
+
     ::LogInfo(__BANNER__ "\r\n" __PROG_NAME__ " " __VER__ " (built " __BUILD__ ")\r\n" \
         "Copyright (c) 2017-2025 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\r\n" \
         "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\r\n" \
@@ -815,6 +825,11 @@ int Host::run()
         return EXIT_FAILURE;
 
     /** Modem */
+    if (m_modemEventDriven && !m_modemPoller.open()) {
+        LogWarning(LOG_HOST, "Event driven modem I/O is not supported on this platform, falling back to polling the modem");
+        m_modemEventDriven = false;
+    }
+
     if (!Thread::runAsThread(this, threadModem))
         return EXIT_FAILURE;
 
@@ -1683,6 +1698,8 @@ void Host::setState(uint8_t state)
                 }
 
                 if (m_modem != nullptr) {
+                    m_modemPoller.wake();
+
                     m_modem->close();
                     delete m_modem;
                 }
@@ -1814,6 +1831,8 @@ void* Host::threadModem(void* arg)
         stopWatch.start();
 
         while (!g_killed) {
+            uint32_t timeout = 0U;
+
             // scope is intentional
             {
                 std::lock_guard<std::mutex> lock(m_clockingMutex);
@@ -1826,12 +1845,31 @@ void* Host::threadModem(void* arg)
                 stopWatch.start();
 
                 host->m_modem->clock(ms);
+
+                if (host->m_modemEventDriven) {
+                    // the modem is clocked when data arrives from the port, or when its timers are due; ports that
+                    // cannot be waited on (and modems that must be clocked continuously) are clocked every tick
+                    uint32_t clockTimeout = host->m_modem->getClockTimeout();
+                    if (!host->m_modemPoller.watch(host->m_modem->m_port) || clockTimeout == 0U)
+                        timeout = (host->m_state != STATE_IDLE) ? m_activeTickDelay : m_idleTickDelay;
+                    else
+                        timeout = clockTimeout;
+
+                    // data read from the port but not yet processed will not wake the poller
+                    if (host->m_modem->m_port->hasPendingData())
+                        timeout = 0U;
+                }
             }
 
-            if (host->m_state != STATE_IDLE)
-                Thread::sleep(m_activeTickDelay);
-            if (host->m_state == STATE_IDLE)
-                Thread::sleep(m_idleTickDelay);
+            if (host->m_modemEventDriven) {
+                host->m_modemPoller.wait(timeout);
+            }
+            else {
+                if (host->m_state != STATE_IDLE)
+                    Thread::sleep(m_activeTickDelay);
+                if (host->m_state == STATE_IDLE)
+                    Thread::sleep(m_idleTickDelay);
+            }
         }
 
         LogMessage(LOG_HOST, "[STOP] %s", threadName.c_str());
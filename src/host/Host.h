@@ -43,6 +43,7 @@
 #include "network/RPCDefines.h"
 #include "modem/Modem.h"
 #include "modem/ModemV24.h"
+#include "modem/port/PortPoller.h"
 
 #include <string>
 #include <unordered_map>
@@ -232,6 +233,9 @@ private:
     static uint8_t m_activeTickDelay;
     static uint8_t m_idleTickDelay;
 
+    bool m_modemEventDriven;
+    modem::port::PortPoller m_modemPoller;
+
     friend class RESTAPI;
     std::string m_restAddress;
     uint16_t m_restPort;
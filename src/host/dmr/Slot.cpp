@@ -99,6 +99,7 @@ Slot::Slot(uint32_t slotNo, uint32_t timeout, uint32_t tgHang, uint32_t queueSiz
     m_slotNo(slotNo),
     m_txImmQueue(queueSize, "DMR Imm Slot Frame"),
     m_txQueue(queueSize, "DMR Slot Frame"),
+    m_txQueuePeeked(false),
     m_queueLock(),
     m_rfState(RS_RF_LISTENING),
     m_rfLastDstId(0U),
@@ -319,20 +320,25 @@ uint32_t Slot::peekFrameLength()
 {
     std::lock_guard<std::mutex> lock(m_queueLock);
 
+    // the frame already peeked from the frame queue is the next frame
+    if (m_txQueuePeeked && !m_txQueue.isEmpty())
+        return peekTxQueue();
+    m_txQueuePeeked = false;
+
     if (m_txQueue.isEmpty() && m_txImmQueue.isEmpty())
         return 0U;
 
-    uint8_t len = 0U;
+    // tx immediate queue takes priority (broadcasts only fill air time the frame queue leaves idle)
+    uint32_t len = m_txImmQueue.peek(CCTrafficClass::SIGNALING);
+    if (len > 0U)
+        return len;
 
-    // tx immediate queue takes priority
-    if (!m_txImmQueue.isEmpty()) {
-        m_txImmQueue.peek(&len, 1U);
-    }
-    else {
-        m_txQueue.peek(&len, 1U);
+    if (!m_txQueue.isEmpty()) {
+        m_txQueuePeeked = true;
+        return peekTxQueue();
     }
 
-    return len;
+    return m_txImmQueue.peek();
 }
 
 /* Helper to determine whether or not the internal frame queue is full. */
@@ -365,22 +371,31 @@ uint32_t Slot::getFrame(uint8_t* data)
 
     std::lock_guard<std::mutex> lock(m_queueLock);
 
+    // the frame already peeked from the frame queue is the next frame
+    if (m_txQueuePeeked && !m_txQueue.isEmpty())
+        return getTxQueue(data);
+    m_txQueuePeeked = false;
+
     if (m_txQueue.isEmpty() && m_txImmQueue.isEmpty())
         return 0U;
 
-    uint8_t len = 0U;
+    // tx immediate queue takes priority (broadcasts only fill air time the frame queue leaves idle)
+    uint32_t len = m_txImmQueue.get(data, CCTrafficClass::SIGNALING);
+    if (len > 0U)
+        return len;
 
-    // tx immediate queue takes priority
-    if (!m_txImmQueue.isEmpty()) {
-        m_txImmQueue.get(&len, 1U);
-        m_txImmQueue.get(data, len);
-    }
-    else {
-        m_txQueue.get(&len, 1U);
-        m_txQueue.get(data, len);
-    }
+    if (!m_txQueue.isEmpty())
+        return getTxQueue(data);
 
-    return len;
+    return m_txImmQueue.get(data);
+}
+
+/* Gets the statistics of the given traffic class of the control channel scheduler. */
+
+CCSchedulerStats Slot::getCCSchedulerStats(CCTrafficClass::E trafficClass)
+{
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    return m_txImmQueue.stats(trafficClass);
 }
 
 /* Process a data frame from the network. */
@@ -591,6 +606,10 @@ void Slot::clock()
                 m_ccHalted = false;
                 m_ccPrevRunning = m_ccRunning;
                 m_txQueue.clear(); // clear the frame buffer
+                {
+                    std::lock_guard<std::mutex> lock(m_queueLock);
+                    m_txImmQueue.clear(CCTrafficClass::BROADCAST);
+                }
             }
         }
         else {
@@ -625,6 +644,10 @@ void Slot::clock()
 
         if (m_ccPrevRunning && !m_ccRunning) {
             m_txQueue.clear(); // clear the frame buffer
+            {
+                std::lock_guard<std::mutex> lock(m_queueLock);
+                m_txImmQueue.clear(CCTrafficClass::BROADCAST);
+            }
             m_ccPrevRunning = m_ccRunning;
         }
     }
@@ -1121,7 +1144,7 @@ void Slot::setAlohaConfig(uint8_t nRandWait, uint8_t backOff)
 
 /* Add data frame to the data ring buffer. */
 
-void Slot::addFrame(const uint8_t *data, bool net, bool imm)
+void Slot::addFrame(const uint8_t *data, bool net, bool imm, CCTrafficClass::E trafficClass, ulong64_t key)
 {
     assert(data != nullptr);
 
@@ -1148,23 +1171,12 @@ void Slot::addFrame(const uint8_t *data, bool net, bool imm)
 
     // is this immediate data?
     if (imm) {
-        // resize immediate queue if necessary (this shouldn't really ever happen)
-        uint32_t space = m_txImmQueue.freeSpace();
-        if (space < (len + 1U)) {
-            if (!net) {
-                uint32_t queueLen = m_txImmQueue.length();
-                m_txImmQueue.resize(queueLen + len);
-                LogError(LOG_DMR, "Slot %u, overflow in the imm DMR slot queue; queue free is %u, needed %u; resized was %u is %u, fifoSpace = %u", m_slotNo, space, len, queueLen, m_txQueue.length(), fifoSpace);
-                return;
-            }
-            else {
-                LogError(LOG_DMR, "Slot %u, overflow in the imm DMR slot queue while writing network data; queue free is %u, needed %u, fifoSpace = %u", m_slotNo, space, len, fifoSpace);
-                return;
-            }
+        // the scheduler makes room by dropping lower priority frames, it is never resized
+        if (!m_txImmQueue.add(data, len, trafficClass, key)) {
+            LogError(LOG_DMR, "Slot %u, overflow in the imm DMR slot queue while writing %sdata; queue free is %u, needed %u, fifoSpace = %u", m_slotNo,
+                (net) ? "network " : "", m_txImmQueue.freeSpace(), len, fifoSpace);
         }
 
-        m_txImmQueue.addData(&len, 1U);
-        m_txImmQueue.addData(data, len);
         return;
     }
 
@@ -1186,6 +1198,28 @@ void Slot::addFrame(const uint8_t *data, bool net, bool imm)
     m_txQueue.addData(data, len);
 }
 
+/* Helper to get the frame data length for the next frame in the frame queue. */
+
+uint32_t Slot::peekTxQueue()
+{
+    uint8_t len = 0U;
+    m_txQueue.peek(&len, 1U);
+
+    return len;
+}
+
+/* Helper to get the next frame from the frame queue. */
+
+uint32_t Slot::getTxQueue(uint8_t* data)
+{
+    uint8_t len = 0U;
+    m_txQueue.get(&len, 1U);
+    m_txQueue.get(data, len);
+
+    m_txQueuePeeked = false;
+    return len;
+}
+
 /* Helper to process loss of frame stream from modem. */
 
 void Slot::processFrameLoss()
@@ -1512,10 +1546,16 @@ void Slot::writeRF_ControlData(uint16_t frameCnt, uint8_t n)
     if (!m_ccDebug)
         m_debug = false;
 
-    // don't add any frames if the queue is full
+    // don't add any frames if enough broadcasts are already scheduled, or the scheduler is full
     uint8_t len = DMR_FRAME_LENGTH_BYTES + 2U;
-    uint32_t space = m_txQueue.freeSpace();
-    if (space < (len + 1U)) {
+    bool full = false;
+    {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        full = m_txImmQueue.depth(CCTrafficClass::BROADCAST) >= CC_BCAST_QUEUE_DEPTH ||
+            m_txImmQueue.freeSpace() < (len + 1U);
+    }
+
+    if (full) {
         m_ccSeq--;
         if (m_ccSeq < 0U)
             m_ccSeq = 0U;
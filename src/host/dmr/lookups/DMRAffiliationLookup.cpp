@@ -65,16 +65,8 @@ bool DMRAffiliationLookup::grantChSlot(uint32_t dstId, uint32_t srcId, uint8_t s
         m_chLookup->removeRFCh(chNo);
     }
 
-    m_grantChTable[dstId] = chNo;
-    m_grantSrcIdTable[dstId] = srcId;
     m_grantChSlotTable[dstId] = std::make_tuple(chNo, slot);
-    m_rfGrantChCnt++;
-
-    m_uuGrantedTable[dstId] = !grp;
-    m_netGrantedTable[dstId] = netGranted;
-
-    m_grantTimers[dstId] = Timer(1000U, grantTimeout);
-    m_grantTimers[dstId].start();
+    addGrant(dstId, srcId, chNo, grantTimeout, grp, netGranted);
 
     if (m_verbose) {
         LogMessage(LOG_HOST, "%s, granting channel, chNo = %u, slot = %u, dstId = %u, group = %u",
@@ -124,22 +116,11 @@ bool DMRAffiliationLookup::releaseGrant(uint32_t dstId, bool releaseAll)
             m_releaseGrant(chNo, dstId, slot);
         }
 
-        m_grantChTable.erase(dstId);
-        m_grantSrcIdTable.erase(dstId);
+        removeGrant(dstId, chNo);
         m_grantChSlotTable.erase(dstId);
-        m_netGrantedTable.erase(dstId);
 
         m_chLookup->addRFCh(chNo);
 
-        if (m_rfGrantChCnt > 0U) {
-            m_rfGrantChCnt--;
-        }
-        else {
-            m_rfGrantChCnt = 0U;
-        }
-
-        m_grantTimers[dstId].stop();
-
         return true;
     }
 
@@ -154,29 +135,17 @@ bool DMRAffiliationLookup::isChBusy(uint32_t chNo) const
         return false;
     }
 
-    // lookup dynamic channel grant table entry
-    for (auto grantEntry : m_grantChTable) {
-        if (grantEntry.second == chNo) {
-            uint8_t slotCount = 0U;
-            if (chNo == m_tsccChNo) {
-                slotCount++; // one slot is *always* used for TSCC
-            }
-
-            for (auto slotEntry : m_grantChSlotTable) {
-                uint32_t foundChNo = std::get<0>(slotEntry.second);
-                if (foundChNo == chNo)
-                    slotCount++;
-            }
+    // lookup dynamic channel grant index entry
+    uint32_t slotCount = getGrantCntByCh(chNo);
+    if (slotCount == 0U) {
+        return false;
+    }
 
-            if (slotCount == 2U) {
-                return true;
-            } else {
-                return false;
-            }
-        }
+    if (chNo == m_tsccChNo) {
+        slotCount++; // one slot is *always* used for TSCC
     }
 
-    return false;
+    return slotCount == 2U;
 }
 
 /* Helper to get the slot granted for the given destination ID. */
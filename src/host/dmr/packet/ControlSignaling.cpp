@@ -678,6 +678,44 @@ void ControlSignaling::writeRF_Call_Alrt(uint32_t srcId, uint32_t dstId)
     writeRF_CSBK(csbk.get());
 }
 
+/* Helper to encode a CSBK into an air-ready frame. */
+
+void ControlSignaling::encodeCSBK(lc::CSBK* csbk, uint32_t colorCode, bool duplex, uint8_t* data)
+{
+    assert(csbk != nullptr);
+    assert(data != nullptr);
+
+    ::memset(data + 2U, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+    SlotType slotType;
+    slotType.setColorCode(colorCode);
+    slotType.setDataType(DataType::CSBK);
+
+    // Regenerate the CSBK data
+    csbk->encode(data + 2U);
+
+    // Regenerate the Slot Type
+    slotType.encode(data + 2U);
+
+    // Convert the Data Sync to be from the BS or MS as needed
+    Sync::addDMRDataSync(data + 2U, duplex);
+
+    data[0U] = modem::TAG_DATA;
+    data[1U] = 0x00U;
+}
+
+/* Helper to get the cache key of the TSCC Aloha broadcast. */
+
+ulong64_t ControlSignaling::getAlohaBcastKey(const SiteData& siteData)
+{
+    // the site networked flag is the only dynamic content of the Aloha
+    ulong64_t key = CSBKO::ALOHA;
+    if (siteData.netActive())
+        key |= 0x100U;
+
+    return key;
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
@@ -686,6 +724,7 @@ void ControlSignaling::writeRF_Call_Alrt(uint32_t srcId, uint32_t dstId)
 
 ControlSignaling::ControlSignaling(Slot* slot, network::BaseNetwork * network, bool dumpCSBKData, bool debug, bool verbose) :
     m_slot(slot),
+    m_ccBcastCache(DMR_FRAME_LENGTH_BYTES + 2U),
     m_dumpCSBKData(dumpCSBKData),
     m_verbose(verbose),
     m_debug(debug)
@@ -713,28 +752,78 @@ void ControlSignaling::writeRF_CSBK(lc::CSBK* csbk, bool imm)
     }
 
     uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
-    ::memset(data + 2U, 0x00U, DMR_FRAME_LENGTH_BYTES);
+    encodeCSBK(csbk, m_slot->m_colorCode, m_slot->m_duplex, data);
 
-    SlotType slotType;
-    slotType.setColorCode(m_slot->m_colorCode);
-    slotType.setDataType(DataType::CSBK);
+    m_slot->m_rfSeqNo = 0U;
 
-    // Regenerate the CSBK data
-    csbk->encode(data + 2U);
+    if (m_slot->m_duplex) {
+        CCTrafficClass::E trafficClass = CCTrafficClass::SIGNALING;
+        if (imm) {
+            trafficClass = getCCTrafficClass(csbk);
+        }
 
-    // Regenerate the Slot Type
-    slotType.encode(data + 2U);
+        m_slot->addFrame(data, false, imm, trafficClass);
+    }
+}
 
-    // Convert the Data Sync to be from the BS or MS as needed
-    Sync::addDMRDataSync(data + 2U, m_slot->m_duplex);
+/* Helper to write a cached control channel broadcast CSBK packet. */
 
-    m_slot->m_rfSeqNo = 0U;
+bool ControlSignaling::writeRF_CSBK_Bcast(ulong64_t key)
+{
+    // always regenerate the broadcast when debugging
+    if (m_debug)
+        return false;
 
-    data[0U] = modem::TAG_DATA;
-    data[1U] = 0x00U;
+    const uint8_t* data = m_ccBcastCache.find(key);
+    if (data == nullptr)
+        return false;
+
+    m_slot->m_rfSeqNo = 0U;
 
+    // broadcasts are scheduled on the immediate queue, and only fill air time the frame queue leaves idle
     if (m_slot->m_duplex)
-        m_slot->addFrame(data, false, imm);
+        m_slot->addFrame(data, false, true, CCTrafficClass::BROADCAST);
+
+    return true;
+}
+
+/* Helper to encode and cache a control channel broadcast CSBK packet. */
+
+void ControlSignaling::writeRF_CSBK_Bcast(lc::CSBK* csbk, ulong64_t key)
+{
+    if (m_debug) {
+        writeRF_CSBK(csbk, true);
+        return;
+    }
+
+    // stale adjacent site broadcasts are never looked up again, and are evicted once the cache is full
+    encodeCSBK(csbk, m_slot->m_colorCode, m_slot->m_duplex, m_ccBcastCache.add(key));
+
+    writeRF_CSBK_Bcast(key);
+}
+
+/* Helper to determine the control channel traffic class of the given CSBK. */
+
+CCTrafficClass::E ControlSignaling::getCCTrafficClass(const lc::CSBK* csbk) const
+{
+    switch (csbk->getCSBKO()) {
+    case CSBKO::PV_GRANT:
+    case CSBKO::TV_GRANT:
+    case CSBKO::BTV_GRANT:
+    case CSBKO::PD_GRANT:
+    case CSBKO::TD_GRANT:
+    case CSBKO::P_CLEAR:
+        return CCTrafficClass::GRANT;
+    case CSBKO::ACK_RSP:
+    case CSBKO::NACK_RSP:
+        return CCTrafficClass::RESPONSE;
+    case CSBKO::ALOHA:
+    case CSBKO::BROADCAST:
+    case CSBKO::DVM_GIT_HASH:
+        return CCTrafficClass::BROADCAST;
+    default:
+        return CCTrafficClass::SIGNALING;
+    }
 }
 
 /* Helper to write a network CSBK. */
@@ -1511,12 +1600,16 @@ void ControlSignaling::writeRF_CSBK_Payload_Clear(uint32_t dstId, uint32_t srcId
 
 void ControlSignaling::writeRF_TSCC_Aloha()
 {
+    ulong64_t key = getAlohaBcastKey(m_slot->m_siteData);
+    if (writeRF_CSBK_Bcast(key))
+        return;
+
     std::unique_ptr<CSBK_ALOHA> csbk = std::make_unique<CSBK_ALOHA>();
     DEBUG_LOG_CSBK(csbk->toString());
     csbk->setNRandWait(m_slot->m_alohaNRandWait);
     csbk->setBackoffNo(m_slot->m_alohaBackOff);
 
-    writeRF_CSBK(csbk.get());
+    writeRF_CSBK_Bcast(csbk.get(), key);
 }
 
 /* Helper to write a TSCC Ann-Wd broadcast packet on the RF interface. */
@@ -1525,6 +1618,11 @@ void ControlSignaling::writeRF_TSCC_Bcast_Ann_Wd(uint32_t channelNo, bool annWd,
 {
     m_slot->m_rfSeqNo = 0U;
 
+    ulong64_t key = ((ulong64_t)systemIdentity << 32) | ((channelNo & 0xFFFFU) << 16) | (requireReg ? 0x200U : 0x00U) |
+        (annWd ? 0x100U : 0x00U) | CSBKO::BROADCAST;
+    if (writeRF_CSBK_Bcast(key))
+        return;
+
     std::unique_ptr<CSBK_BROADCAST> csbk = std::make_unique<CSBK_BROADCAST>();
     csbk->siteIdenEntry(m_slot->m_idenEntry);
     csbk->setCdef(false);
@@ -1539,26 +1637,34 @@ void ControlSignaling::writeRF_TSCC_Bcast_Ann_Wd(uint32_t channelNo, bool annWd,
             m_slot->m_slotNo, csbk->toString().c_str(), channelNo, annWd);
     }
 
-    writeRF_CSBK(csbk.get());
+    writeRF_CSBK_Bcast(csbk.get(), key);
 }
 
 /* Helper to write a TSCC Sys_Parm broadcast packet on the RF interface. */
 
 void ControlSignaling::writeRF_TSCC_Bcast_Sys_Parm()
 {
+    ulong64_t key = ((ulong64_t)BroadcastAnncType::SITE_PARMS << 12) | CSBKO::BROADCAST;
+    if (writeRF_CSBK_Bcast(key))
+        return;
+
     std::unique_ptr<CSBK_BROADCAST> csbk = std::make_unique<CSBK_BROADCAST>();
     DEBUG_LOG_CSBK(csbk->toString());
     csbk->setAnncType(BroadcastAnncType::SITE_PARMS);
 
-    writeRF_CSBK(csbk.get());
+    writeRF_CSBK_Bcast(csbk.get(), key);
 }
 
 /* Helper to write a TSCC Git Hash broadcast packet on the RF interface. */
 
 void ControlSignaling::writeRF_TSCC_Git_Hash()
 {
+    ulong64_t key = CSBKO::DVM_GIT_HASH;
+    if (writeRF_CSBK_Bcast(key))
+        return;
+
     std::unique_ptr<CSBK_DVM_GIT_HASH> csbk = std::make_unique<CSBK_DVM_GIT_HASH>();
     DEBUG_LOG_CSBK(csbk->toString());
 
-    writeRF_CSBK(csbk.get());
+    writeRF_CSBK_Bcast(csbk.get(), key);
 }
@@ -18,6 +18,8 @@
 #define __DMR_PACKET_CONTROL_SIGNALING_H__
 
 #include "Defines.h"
+#include "CCBcastCache.h"
+#include "ControlChannelScheduler.h"
 #include "common/dmr/data/NetData.h"
 #include "common/dmr/data/EmbeddedData.h"
 #include "common/dmr/lc/LC.h"
@@ -84,11 +86,31 @@ namespace dmr
             void writeRF_Call_Alrt(uint32_t srcId, uint32_t dstId);
             /** @} */
 
+            /**
+             * @brief Helper to encode a CSBK into an air-ready frame.
+             * @note This is used for both freshly written and cached CSBKs, so both are always encoded alike.
+             * @param csbk CSBK to encode.
+             * @param colorCode DMR color code.
+             * @param duplex Flag indicating whether the frame is transmitted by a duplex (BS) or simplex (MS) station.
+             * @param[out] data Buffer to encode the frame into (tag and frame, DMR_FRAME_LENGTH_BYTES + 2 bytes).
+             */
+            static void encodeCSBK(lc::CSBK* csbk, uint32_t colorCode, bool duplex, uint8_t* data);
+            /**
+             * @brief Helper to get the cache key of the TSCC Aloha broadcast.
+             * @note The site networked flag is the only dynamic content of the Aloha, so the Aloha is cached
+             *  separately for either network state.
+             * @param siteData DMR site data.
+             * @returns ulong64_t Cache key of the Aloha broadcast.
+             */
+            static ulong64_t getAlohaBcastKey(const SiteData& siteData);
+
         private:
             friend class dmr::Control;
             friend class dmr::Slot;
             Slot* m_slot;
 
+            CCBcastCache m_ccBcastCache;
+
             bool m_dumpCSBKData;
             bool m_verbose;
             bool m_debug;
@@ -127,6 +149,24 @@ namespace dmr
              * @param csbk CSBK to write to the network.
              */
             void writeNet_CSBK(lc::CSBK* csbk);
+            /**
+             * @brief Helper to write a cached control channel broadcast CSBK packet.
+             * @param key Cache key of the broadcast.
+             * @returns bool True, if the broadcast was cached and written, otherwise false.
+             */
+            bool writeRF_CSBK_Bcast(ulong64_t key);
+            /**
+             * @brief Helper to encode and cache a control channel broadcast CSBK packet.
+             * @param csbk CSBK to write to the modem.
+             * @param key Cache key of the broadcast.
+             */
+            void writeRF_CSBK_Bcast(lc::CSBK* csbk, ulong64_t key);
+            /**
+             * @brief Helper to determine the control channel traffic class of the given CSBK.
+             * @param csbk CSBK.
+             * @returns CCTrafficClass::E Traffic class of the CSBK.
+             */
+            CCTrafficClass::E getCCTrafficClass(const lc::CSBK* csbk) const;
 
             /*
             ** Control Signalling Logic
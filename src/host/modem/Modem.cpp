@@ -21,7 +21,9 @@
 
 using namespace modem;
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -154,6 +156,9 @@ Modem::Modem(port::IModemPort* port, bool duplex, bool rxInvert, bool txInvert,
     m_dmr2ReadLock(),
     m_p25ReadLock(),
     m_nxdnReadLock(),
+    m_rxSignalLock(),
+    m_rxSignalCond(),
+    m_rxSignalled(0U),
     m_ignoreModemConfigArea(ignoreModemConfigArea),
     m_flashDisabled(false),
     m_gotModemStatus(false),
@@ -563,23 +568,17 @@ void Modem::clock(uint32_t ms)
         case CMD_DMR_DATA1:
         {
             if (m_dmrEnabled) {
-                std::lock_guard<std::mutex> lock(m_dmr1ReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_DMR_DATA1 double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = m_length - 2U;
-                m_rxDMRQueue1.addData(&data, 1U);
-
+                uint8_t tag = TAG_DATA;
                 if (m_buffer[3U] == (DMRDEF::SYNC_DATA | DMRDEF::DataType::TERMINATOR_WITH_LC))
-                    data = TAG_EOT;
-                else
-                    data = TAG_DATA;
-                m_rxDMRQueue1.addData(&data, 1U);
+                    tag = TAG_EOT;
 
-                m_rxDMRQueue1.addData(m_buffer + 3U, m_length - 3U);
+                m_rxDMRQueue1.addRecord(&tag, 1U, m_buffer + 3U, m_length - 3U);
+                signalRxData(RX_SIGNAL_DMR1);
                 if (m_trace)
                     Utils::dump(1U, "[Modem::clock()] RX DMR Data 1", m_buffer + 3U, m_length - 3U);
             }
@@ -589,23 +588,17 @@ void Modem::clock(uint32_t ms)
         case CMD_DMR_DATA2:
         {
             if (m_dmrEnabled) {
-                std::lock_guard<std::mutex> lock(m_dmr2ReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_DMR_DATA2 double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = m_length - 2U;
-                m_rxDMRQueue2.addData(&data, 1U);
-
+                uint8_t tag = TAG_DATA;
                 if (m_buffer[3U] == (DMRDEF::SYNC_DATA | DMRDEF::DataType::TERMINATOR_WITH_LC))
-                    data = TAG_EOT;
-                else
-                    data = TAG_DATA;
-                m_rxDMRQueue2.addData(&data, 1U);
+                    tag = TAG_EOT;
 
-                m_rxDMRQueue2.addData(m_buffer + 3U, m_length - 3U);
+                m_rxDMRQueue2.addRecord(&tag, 1U, m_buffer + 3U, m_length - 3U);
+                signalRxData(RX_SIGNAL_DMR2);
                 if (m_trace)
                     Utils::dump(1U, "[Modem::clock()] RX DMR Data 2", m_buffer + 3U, m_length - 3U);
             }
@@ -615,18 +608,14 @@ void Modem::clock(uint32_t ms)
         case CMD_DMR_LOST1:
         {
             if (m_dmrEnabled) {
-                std::lock_guard<std::mutex> lock(m_dmr1ReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_DMR_LOST1 double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = 1U;
-                m_rxDMRQueue1.addData(&data, 1U);
-
-                data = TAG_LOST;
-                m_rxDMRQueue1.addData(&data, 1U);
+                uint8_t tag = TAG_LOST;
+                m_rxDMRQueue1.addRecord(&tag, 1U);
+                signalRxData(RX_SIGNAL_DMR1);
             }
         }
         break;
@@ -634,18 +623,14 @@ void Modem::clock(uint32_t ms)
         case CMD_DMR_LOST2:
         {
             if (m_dmrEnabled) {
-                std::lock_guard<std::mutex> lock(m_dmr2ReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_DMR_LOST2 double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = 1U;
-                m_rxDMRQueue2.addData(&data, 1U);
-
-                data = TAG_LOST;
-                m_rxDMRQueue2.addData(&data, 1U);
+                uint8_t tag = TAG_LOST;
+                m_rxDMRQueue2.addRecord(&tag, 1U);
+                signalRxData(RX_SIGNAL_DMR2);
             }
         }
         break;
@@ -654,20 +639,9 @@ void Modem::clock(uint32_t ms)
         case CMD_P25_DATA:
         {
             if (m_p25Enabled) {
-                std::lock_guard<std::mutex> lock(m_p25ReadLock);
-
-                uint8_t length[2U];
-                if (m_length > 255U)
-                    length[0U] = ((m_length - cmdOffset) >> 8U) & 0xFFU;
-                else
-                    length[0U] = 0x00U;
-                length[1U] = (m_length - cmdOffset) & 0xFFU;
-                m_rxP25Queue.addData(length, 2U);
-
-                uint8_t data = TAG_DATA;
-                m_rxP25Queue.addData(&data, 1U);
-
-                m_rxP25Queue.addData(m_buffer + (cmdOffset + 1U), m_length - (cmdOffset + 1U));
+                uint8_t tag = TAG_DATA;
+                m_rxP25Queue.addRecord(&tag, 1U, m_buffer + (cmdOffset + 1U), m_length - (cmdOffset + 1U));
+                signalRxData(RX_SIGNAL_P25);
                 if (m_trace)
                     Utils::dump(1U, "[Modem::clock()] RX P25 Data", m_buffer + (cmdOffset + 1U), m_length - (cmdOffset + 1U));
             }
@@ -677,18 +651,14 @@ void Modem::clock(uint32_t ms)
         case CMD_P25_LOST:
         {
             if (m_p25Enabled) {
-                std::lock_guard<std::mutex> lock(m_p25ReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_P25_LOST double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = 1U;
-                m_rxP25Queue.addData(&data, 1U);
-
-                data = TAG_LOST;
-                m_rxP25Queue.addData(&data, 1U);
+                uint8_t tag = TAG_LOST;
+                m_rxP25Queue.addRecord(&tag, 1U);
+                signalRxData(RX_SIGNAL_P25);
             }
         }
         break;
@@ -697,20 +667,14 @@ void Modem::clock(uint32_t ms)
         case CMD_NXDN_DATA:
         {
             if (m_nxdnEnabled) {
-                std::lock_guard<std::mutex> lock(m_nxdnReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_NXDN_DATA double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = m_length - 2U;
-                m_rxNXDNQueue.addData(&data, 1U);
-
-                data = TAG_DATA;
-                m_rxNXDNQueue.addData(&data, 1U);
-
-                m_rxNXDNQueue.addData(m_buffer + 3U, m_length - 3U);
+                uint8_t tag = TAG_DATA;
+                m_rxNXDNQueue.addRecord(&tag, 1U, m_buffer + 3U, m_length - 3U);
+                signalRxData(RX_SIGNAL_NXDN);
                 if (m_trace)
                     Utils::dump(1U, "[Modem::clock()] RX NXDN Data", m_buffer + 3U, m_length - 3U);
             }
@@ -720,18 +684,14 @@ void Modem::clock(uint32_t ms)
         case CMD_NXDN_LOST:
         {
             if (m_nxdnEnabled) {
-                std::lock_guard<std::mutex> lock(m_nxdnReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_NXDN_LOST double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = 1U;
-                m_rxNXDNQueue.addData(&data, 1U);
-
-                data = TAG_LOST;
-                m_rxNXDNQueue.addData(&data, 1U);
+                uint8_t tag = TAG_LOST;
+                m_rxNXDNQueue.addRecord(&tag, 1U);
+                signalRxData(RX_SIGNAL_NXDN);
             }
         }
         break;
@@ -903,6 +863,25 @@ void Modem::clock(uint32_t ms)
     }
 }
 
+/* Gets the time until the modem must next be clocked, if no data arrives from the port. */
+
+uint32_t Modem::getClockTimeout() const
+{
+    // a custom response handler may rely on being clocked continuously
+    if (m_rspHandler != nullptr)
+        return 0U;
+
+    // the modem is never left unclocked for longer than the status poll interval
+    uint32_t timeout = MODEM_POLL_TIME;
+    if (m_statusTimer.isRunning())
+        timeout = std::min(timeout, m_statusTimer.getRemainingMs());
+    if (m_inactivityTimer.isRunning())
+        timeout = std::min(timeout, m_inactivityTimer.getRemainingMs());
+
+    // an expired timer must be clocked immediately
+    return (timeout == 0U) ? 1U : timeout;
+}
+
 /* Closes connection to the air interface modem. */
 
 void Modem::close()
@@ -918,29 +897,63 @@ void Modem::close()
     }
 }
 
-/* Get the frame data length for the next frame in the DMR Slot 1 ring buffer. */
+/* Waits for frame data to be queued into the given Rx ring buffer. */
 
-uint32_t Modem::peekDMRFrame1Length()
+bool Modem::waitForRxData(uint32_t signal, uint32_t timeout)
 {
-    if (m_rxDMRQueue1.isEmpty())
-        return 0U;
+    std::mutex* readLock = nullptr;
+    concurrent::spsc_ring_buffer<uint8_t>* queue = nullptr;
+    switch (signal) {
+    case RX_SIGNAL_DMR1:
+        readLock = &m_dmr1ReadLock;
+        queue = &m_rxDMRQueue1;
+        break;
+    case RX_SIGNAL_DMR2:
+        readLock = &m_dmr2ReadLock;
+        queue = &m_rxDMRQueue2;
+        break;
+    case RX_SIGNAL_P25:
+        readLock = &m_p25ReadLock;
+        queue = &m_rxP25Queue;
+        break;
+    case RX_SIGNAL_NXDN:
+        readLock = &m_nxdnReadLock;
+        queue = &m_rxNXDNQueue;
+        break;
+    default:
+        return false;
+    }
 
-    uint8_t len = 0U;
-    m_rxDMRQueue1.peek(&len, 1U);
-#if DEBUG_MODEM
-    LogDebugEx(LOG_MODEM, "Modem::peekDMRFrame1Length()", "len = %u, dataSize = %u", len, m_rxDMRQueue1.dataSize());
-#endif
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxDMRQueue1.dataSize() == 1U && len > m_rxDMRQueue1.dataSize()) {
-        m_rxDMRQueue1.get(&len, 1U); // ensure we pop the length off
-        return 0U;
+    // clear any stale signal before checking the ring buffer, data queued after this point signals again
+    {
+        std::lock_guard<std::mutex> lock(m_rxSignalLock);
+        m_rxSignalled &= ~signal;
     }
 
-    if (m_rxDMRQueue1.dataSize() >= len) {
-        return len;
+    {
+        std::lock_guard<std::mutex> lock(*readLock);
+        if (!queue->isEmpty())
+            return true;
     }
 
-    return 0U;
+    std::unique_lock<std::mutex> lock(m_rxSignalLock);
+    bool signalled = m_rxSignalCond.wait_for(lock, std::chrono::milliseconds(timeout), [&]() {
+        return (m_rxSignalled & signal) != 0U;
+    });
+
+    m_rxSignalled &= ~signal;
+    return signalled;
+}
+
+/* Get the frame data length for the next frame in the DMR Slot 1 ring buffer. */
+
+uint32_t Modem::peekDMRFrame1Length()
+{
+    uint32_t len = m_rxDMRQueue1.peekRecordLength();
+#if DEBUG_MODEM
+    LogDebugEx(LOG_MODEM, "Modem::peekDMRFrame1Length()", "len = %u, dataSize = %u", len, m_rxDMRQueue1.dataSize());
+#endif
+    return len;
 }
 
 /* Reads DMR Slot 1 frame data from the DMR Slot 1 ring buffer. */
@@ -950,51 +963,18 @@ uint32_t Modem::readDMRFrame1(uint8_t* data)
     assert(data != nullptr);
     std::lock_guard<std::mutex> lock(m_dmr1ReadLock);
 
-    if (m_rxDMRQueue1.isEmpty())
-        return 0U;
-
-    uint8_t len = 0U;
-    m_rxDMRQueue1.peek(&len, 1U);
-
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxDMRQueue1.dataSize() == 1U && len > m_rxDMRQueue1.dataSize()) {
-        m_rxDMRQueue1.get(&len, 1U); // ensure we pop the length off
-        return 0U;
-    }
-
-    if (m_rxDMRQueue1.dataSize() >= len) {
-        m_rxDMRQueue1.get(&len, 1U); // ensure we pop the length off
-        m_rxDMRQueue1.get(data, len);
-    
-        return len;
-    }
-
-    return 0U;
+    return m_rxDMRQueue1.getRecord(data);
 }
 
 /* Get the frame data length for the next frame in the DMR Slot 2 ring buffer. */
 
 uint32_t Modem::peekDMRFrame2Length()
 {
-    if (m_rxDMRQueue2.isEmpty())
-        return 0U;
-
-    uint8_t len = 0U;
-    m_rxDMRQueue2.peek(&len, 1U);
+    uint32_t len = m_rxDMRQueue2.peekRecordLength();
 #if DEBUG_MODEM
     LogDebugEx(LOG_MODEM, "Modem::peekDMRFrame2Length()", "len = %u, dataSize = %u", len, m_rxDMRQueue2.dataSize());
 #endif
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxDMRQueue2.dataSize() == 1U && len > m_rxDMRQueue2.dataSize()) {
-        m_rxDMRQueue2.get(&len, 1U); // ensure we pop the length off
-        return 0U;
-    }
-
-    if (m_rxDMRQueue2.dataSize() >= len) {
-        return len;
-    }
-
-    return 0U;
+    return len;
 }
 
 /* Reads DMR Slot 2 frame data from the DMR Slot 2 ring buffer. */
@@ -1004,55 +984,18 @@ uint32_t Modem::readDMRFrame2(uint8_t* data)
     assert(data != nullptr);
     std::lock_guard<std::mutex> lock(m_dmr2ReadLock);
 
-    if (m_rxDMRQueue2.isEmpty())
-        return 0U;
-
-    uint8_t len = 0U;
-    m_rxDMRQueue2.peek(&len, 1U);
-
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxDMRQueue2.dataSize() == 1U && len > m_rxDMRQueue2.dataSize()) {
-        m_rxDMRQueue2.get(&len, 1U); // ensure we pop the length off
-        return 0U;
-    }
-
-    if (m_rxDMRQueue2.dataSize() >= len) {
-        m_rxDMRQueue2.get(&len, 1U); // ensure we pop the length off
-        m_rxDMRQueue2.get(data, len);
-
-        return len;
-    }
-
-    return 0U;
+    return m_rxDMRQueue2.getRecord(data);
 }
 
 /* Get the frame data length for the next frame in the P25 ring buffer. */
 
 uint32_t Modem::peekP25FrameLength()
 {
-    if (m_rxP25Queue.isEmpty())
-        return 0U;
-
-    uint8_t length[2U];
-    ::memset(length, 0x00U, 2U);
-    m_rxP25Queue.peek(length, 2U);
-
-    uint16_t len = 0U;
-    len = (length[0U] << 8) + length[1U];
+    uint32_t len = m_rxP25Queue.peekRecordLength();
 #if DEBUG_MODEM
     LogDebugEx(LOG_MODEM, "Modem::peekP25FrameLength()", "len = %u, dataSize = %u", len, m_rxP25Queue.dataSize());
 #endif
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxP25Queue.dataSize() == 2U && len > m_rxP25Queue.dataSize()) {
-        m_rxP25Queue.get(length, 2U); // ensure we pop the length off
-        return 0U;
-    }
-
-    if (m_rxP25Queue.dataSize() >= len) {
-        return len;
-    }
-
-    return 0U;
+    return len;
 }
 
 /* Reads P25 frame data from the P25 ring buffer. */
@@ -1062,55 +1005,18 @@ uint32_t Modem::readP25Frame(uint8_t* data)
     assert(data != nullptr);
     std::lock_guard<std::mutex> lock(m_p25ReadLock);
 
-    if (m_rxP25Queue.isEmpty())
-        return 0U;
-
-    uint8_t length[2U];
-    ::memset(length, 0x00U, 2U);
-    m_rxP25Queue.peek(length, 2U);
-
-    uint16_t len = 0U;
-    len = (length[0U] << 8) + length[1U];
-
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxP25Queue.dataSize() == 2U && len > m_rxP25Queue.dataSize()) {
-        m_rxP25Queue.get(length, 2U); // ensure we pop the length off
-        return 0U;
-    }
-
-    if (m_rxP25Queue.dataSize() >= len) {
-        m_rxP25Queue.get(length, 2U); // ensure we pop the length off
-        m_rxP25Queue.get(data, len);
-        
-        return len;
-    }
-
-    return 0U;
+    return m_rxP25Queue.getRecord(data);
 }
 
 /* Get the frame data length for the next frame in the NXDN ring buffer. */
 
 uint32_t Modem::peekNXDNFrameLength()
 {
-    if (m_rxNXDNQueue.isEmpty())
-        return 0U;
-
-    uint8_t len = 0U;
-    m_rxNXDNQueue.peek(&len, 1U);
+    uint32_t len = m_rxNXDNQueue.peekRecordLength();
 #if DEBUG_MODEM
     LogDebugEx(LOG_MODEM, "Modem::peekNXDNFrameLength()", "len = %u, dataSize = %u", len, m_rxNXDNQueue.dataSize());
 #endif
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxNXDNQueue.dataSize() == 1U && len > m_rxNXDNQueue.dataSize()) {
-        m_rxNXDNQueue.get(&len, 1U); // ensure we pop the length off
-        return 0U;
-    }
-
-    if (m_rxNXDNQueue.dataSize() >= len) {
-        return len;
-    }
-
-    return 0U;
+    return len;
 }
 
 /* Reads NXDN frame data from the NXDN ring buffer. */
@@ -1120,26 +1026,7 @@ uint32_t Modem::readNXDNFrame(uint8_t* data)
     assert(data != nullptr);
     std::lock_guard<std::mutex> lock(m_nxdnReadLock);
 
-    if (m_rxNXDNQueue.isEmpty())
-        return 0U;
-
-    uint8_t len = 0U;
-    m_rxNXDNQueue.peek(&len, 1U);
-
-    // this ensures we never get in a situation where we have length stuck on the queue
-    if (m_rxNXDNQueue.dataSize() == 1U && len > m_rxNXDNQueue.dataSize()) {
-        m_rxNXDNQueue.get(&len, 1U); // ensure we pop the length off
-        return 0U;
-    }
-
-    if (m_rxNXDNQueue.dataSize() >= len) {
-        m_rxNXDNQueue.get(&len, 1U); // ensure we pop the length off
-        m_rxNXDNQueue.get(data, len);
-
-        return len;
-    }
-
-    return 0U;
+    return m_rxNXDNQueue.getRecord(data);
 }
 
 /* Helper to test if the DMR Slot 1 ring buffer has free space. */
@@ -1287,15 +1174,12 @@ void Modem::injectDMRFrame1(const uint8_t* data, uint32_t length)
         if (m_trace)
             Utils::dump(1U, "Injected DMR Slot 1 Data", data, length);
 
-        uint8_t val = length;
-        m_rxDMRQueue1.addData(&val, 1U);
+        uint8_t header[2U];
+        header[0U] = TAG_DATA;
+        header[1U] = DMRDEF::SYNC_VOICE & DMRDEF::SYNC_DATA; // valid sync
 
-        val = TAG_DATA;
-        m_rxDMRQueue1.addData(&val, 1U);
-        val = DMRDEF::SYNC_VOICE & DMRDEF::SYNC_DATA; // valid sync
-        m_rxDMRQueue1.addData(&val, 1U);
-
-        m_rxDMRQueue1.addData(data, length);
+        m_rxDMRQueue1.addRecord(header, 2U, data, length);
+        signalRxData(RX_SIGNAL_DMR1);
     }
 }
 
@@ -1310,15 +1194,12 @@ void Modem::injectDMRFrame2(const uint8_t* data, uint32_t length)
         if (m_trace)
             Utils::dump(1U, "Injected DMR Slot 2 Data", data, length);
 
-        uint8_t val = length;
-        m_rxDMRQueue2.addData(&val, 1U);
-
-        val = TAG_DATA;
-        m_rxDMRQueue2.addData(&val, 1U);
-        val = DMRDEF::SYNC_VOICE & DMRDEF::SYNC_DATA; // valid sync
-        m_rxDMRQueue2.addData(&val, 1U);
+        uint8_t header[2U];
+        header[0U] = TAG_DATA;
+        header[1U] = DMRDEF::SYNC_VOICE & DMRDEF::SYNC_DATA; // valid sync
 
-        m_rxDMRQueue2.addData(data, length);
+        m_rxDMRQueue2.addRecord(header, 2U, data, length);
+        signalRxData(RX_SIGNAL_DMR2);
     }
 }
 
@@ -1333,15 +1214,12 @@ void Modem::injectP25Frame(const uint8_t* data, uint32_t length)
         if (m_trace)
             Utils::dump(1U, "Injected P25 Data", data, length);
 
-        uint8_t val = length;
-        m_rxP25Queue.addData(&val, 1U);
-
-        val = TAG_DATA;
-        m_rxP25Queue.addData(&val, 1U);
-        val = 0x01U;    // valid sync
-        m_rxP25Queue.addData(&val, 1U);
+        uint8_t header[2U];
+        header[0U] = TAG_DATA;
+        header[1U] = 0x01U;    // valid sync
 
-        m_rxP25Queue.addData(data, length);
+        m_rxP25Queue.addRecord(header, 2U, data, length);
+        signalRxData(RX_SIGNAL_P25);
     }
 }
 
@@ -1356,15 +1234,12 @@ void Modem::injectNXDNFrame(const uint8_t* data, uint32_t length)
         if (m_trace)
             Utils::dump(1U, "Injected NXDN Data", data, length);
 
-        uint8_t val = length;
-        m_rxNXDNQueue.addData(&val, 1U);
+        uint8_t header[2U];
+        header[0U] = TAG_DATA;
+        header[1U] = 0x01U;    // valid sync
 
-        val = TAG_DATA;
-        m_rxNXDNQueue.addData(&val, 1U);
-        val = 0x01U;    // valid sync
-        m_rxNXDNQueue.addData(&val, 1U);
-
-        m_rxNXDNQueue.addData(data, length);
+        m_rxNXDNQueue.addRecord(header, 2U, data, length);
+        signalRxData(RX_SIGNAL_NXDN);
     }
 }
 
@@ -1796,6 +1671,18 @@ void Modem::reset()
     setState(m_modemState);
 }
 
+/* Helper to wake any threads waiting for frame data in the given Rx ring buffers. */
+
+void Modem::signalRxData(uint32_t signal)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_rxSignalLock);
+        m_rxSignalled |= signal;
+    }
+
+    m_rxSignalCond.notify_all();
+}
+
 /* Retrieve the air interface modem version. */
 
 bool Modem::getFirmwareVersion()
@@ -27,12 +27,14 @@
 #define __MODEM_H__
 
 #include "Defines.h"
+#include "common/concurrent/spsc_ring_buffer.h"
 #include "common/RingBuffer.h"
 #include "common/Timer.h"
 #include "modem/port/IModemPort.h"
 #include "network/RESTAPI.h"
 
 #include <string>
+#include <condition_variable>
 #include <functional>
 #include <mutex>
 
@@ -237,6 +239,16 @@ namespace modem
         RSN_NXDN_DISABLED = 65U             //! NXDN Disabled
     };
 
+    /**
+     * @brief Modem Rx queue signals.
+     */
+    enum RX_SIGNAL {
+        RX_SIGNAL_DMR1 = 0x01U,             //! DMR Slot 1 Rx Queue
+        RX_SIGNAL_DMR2 = 0x02U,             //! DMR Slot 2 Rx Queue
+        RX_SIGNAL_P25 = 0x04U,              //! P25 Rx Queue
+        RX_SIGNAL_NXDN = 0x08U              //! NXDN Rx Queue
+    };
+
     /**
      * @brief Modem response state machine.
      */
@@ -429,12 +441,26 @@ namespace modem
          * @param ms Number of milliseconds.
          */
         virtual void clock(uint32_t ms);
+        /**
+         * @brief Gets the time until the modem must next be clocked, if no data arrives from the port.
+         * @returns uint32_t Number of milliseconds until the modem must next be clocked, or 0 if the modem
+         *  must be clocked continuously.
+         */
+        virtual uint32_t getClockTimeout() const;
 
         /**
          * @brief Closes connection to the air interface modem.
          */
         virtual void close();
 
+        /**
+         * @brief Waits for frame data to be queued into the given Rx ring buffer.
+         * @param signal Rx queue signal (see RX_SIGNAL).
+         * @param timeout Maximum time to wait (in milliseconds).
+         * @returns bool True, if frame data is available, otherwise false.
+         */
+        bool waitForRxData(uint32_t signal, uint32_t timeout);
+
         /**
          * @brief Get the frame data length for the next frame in the DMR Slot 1 ring buffer.
          * @returns uint32_t Length of frame data retrieved.
@@ -574,24 +600,28 @@ namespace modem
 
         /**
          * @brief Internal helper to inject DMR Slot 1 frame data as if it came from the air interface modem.
+         * @note The Rx ring buffers have a single producer, this must only be called from the thread clocking the modem.
          * @param[in] data Data to write to ring buffer.
          * @param length Length of data to write.
          */
         void injectDMRFrame1(const uint8_t* data, uint32_t length);
         /**
          * @brief Internal helper to inject DMR Slot 2 frame data as if it came from the air interface modem.
+         * @note The Rx ring buffers have a single producer, this must only be called from the thread clocking the modem.
          * @param[in] data Data to write to ring buffer.
          * @param length Length of data to write.
          */
         void injectDMRFrame2(const uint8_t* data, uint32_t length);
         /**
          * @brief Internal helper to inject P25 frame data as if it came from the air interface modem.
+         * @note The Rx ring buffers have a single producer, this must only be called from the thread clocking the modem.
          * @param[in] data Data to write to ring buffer.
          * @param length Length of data to write.
          */
         void injectP25Frame(const uint8_t* data, uint32_t length);
         /**
          * @brief Internal helper to inject NXDN frame data as if it came from the air interface modem.
+         * @note The Rx ring buffers have a single producer, this must only be called from the thread clocking the modem.
          * @param[in] data Data to write to ring buffer.
          * @param length Length of data to write.
          */
@@ -798,10 +828,10 @@ namespace modem
         std::function<MODEM_OC_PORT_HANDLER> m_closePortHandler;
         std::function<MODEM_RESP_HANDLER> m_rspHandler;
 
-        RingBuffer<uint8_t> m_rxDMRQueue1;
-        RingBuffer<uint8_t> m_rxDMRQueue2;
-        RingBuffer<uint8_t> m_rxP25Queue;
-        RingBuffer<uint8_t> m_rxNXDNQueue;
+        concurrent::spsc_ring_buffer<uint8_t> m_rxDMRQueue1;
+        concurrent::spsc_ring_buffer<uint8_t> m_rxDMRQueue2;
+        concurrent::spsc_ring_buffer<uint8_t> m_rxP25Queue;
+        concurrent::spsc_ring_buffer<uint8_t> m_rxNXDNQueue;
 
         Timer m_statusTimer;
         Timer m_inactivityTimer;
@@ -821,6 +851,10 @@ namespace modem
         std::mutex m_p25ReadLock;
         std::mutex m_nxdnReadLock;
 
+        std::mutex m_rxSignalLock;
+        std::condition_variable m_rxSignalCond;
+        uint32_t m_rxSignalled;
+
         bool m_ignoreModemConfigArea;
         bool m_flashDisabled;
 
@@ -833,6 +867,12 @@ namespace modem
          */
         void reset();
 
+        /**
+         * @brief Helper to wake any threads waiting for frame data in the given Rx ring buffers.
+         * @param signal Rx queue signals (see RX_SIGNAL).
+         */
+        void signalRxData(uint32_t signal);
+
         /**
          * @brief Retrieve the air interface modem version.
          * @returns bool True, if modem version was received, otherwise false.
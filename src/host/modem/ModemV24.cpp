@@ -191,8 +191,6 @@ void ModemV24::clock(uint32_t ms)
         case CMD_P25_DATA:
         {
             if (m_p25Enabled) {
-                std::lock_guard<std::mutex> lock(m_p25ReadLock);
-            
                 // convert data from V.24/DFSI formatting to TIA-102 air formatting
                 if (m_useTIAFormat)
                     convertToAirTIA(m_buffer + (cmdOffset + 1U), m_length - (cmdOffset + 1U));
@@ -207,18 +205,14 @@ void ModemV24::clock(uint32_t ms)
         case CMD_P25_LOST:
         {
             if (m_p25Enabled) {
-                std::lock_guard<std::mutex> lock(m_p25ReadLock);
-
                 if (m_rspDoubleLength) {
                     LogError(LOG_MODEM, "CMD_P25_LOST double length?; len = %u", m_length);
                     break;
                 }
 
-                uint8_t data = 1U;
-                m_rxP25Queue.addData(&data, 1U);
-
-                data = TAG_LOST;
-                m_rxP25Queue.addData(&data, 1U);
+                uint8_t tag = TAG_LOST;
+                m_rxP25Queue.addRecord(&tag, 1U);
+                signalRxData(RX_SIGNAL_P25);
             }
         }
         break;
@@ -537,17 +531,10 @@ int ModemV24::writeSerial()
 void ModemV24::storeConvertedRx(const uint8_t* buffer, uint32_t length)
 {
     // store converted frame into the Rx modem queue
-    uint8_t storedLen[2U];
-    if (length > 255U)
-        storedLen[0U] = (length >> 8U) & 0xFFU;
-    else
-        storedLen[0U] = 0x00U;
-    storedLen[1U] = length & 0xFFU;
-    m_rxP25Queue.addData(storedLen, 2U);
-
     //Utils::dump("Storing converted RX data", buffer, length);
 
-    m_rxP25Queue.addData(buffer, length);
+    m_rxP25Queue.addRecord(buffer, length);
+    signalRxData(RX_SIGNAL_P25);
 }
 
 /* Helper to generate a P25 TDU packet. */
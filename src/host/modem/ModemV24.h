@@ -278,6 +278,13 @@ namespace modem
          * @param ms Number of milliseconds.
          */
         void clock(uint32_t ms) override;
+        /**
+         * @brief Gets the time until the modem must next be clocked, if no data arrives from the port.
+         * @note The V.24 modem paces its Tx queue from clock(), and is always clocked continuously.
+         * @returns uint32_t Number of milliseconds until the modem must next be clocked, or 0 if the modem
+         *  must be clocked continuously.
+         */
+        uint32_t getClockTimeout() const override { return 0U; }
 
         /**
          * @brief Closes connection to the air interface modem.
@@ -62,6 +62,17 @@ namespace modem
              * @brief Closes the connection to the port.
              */
             virtual void close() = 0;
+
+            /**
+             * @brief Gets the descriptor that becomes readable when data is available from the port.
+             * @returns int Descriptor, or -1 if the port cannot be waited on.
+             */
+            virtual int getReadDescriptor() const { return -1; }
+            /**
+             * @brief Flag indicating data was received from the port, but not yet read.
+             * @returns bool True, if data is pending, otherwise false.
+             */
+            virtual bool hasPendingData() const { return false; }
         };
     } // namespace port
 } // namespace modem
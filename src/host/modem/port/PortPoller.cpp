@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "modem/port/PortPoller.h"
+
+using namespace modem::port;
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif // defined(__linux__)
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const int MAX_POLL_EVENTS = 2;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the PortPoller class. */
+
+PortPoller::PortPoller() :
+    m_epollFd(-1),
+    m_eventFd(-1),
+    m_portFd(-1)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the PortPoller class. */
+
+PortPoller::~PortPoller()
+{
+    close();
+}
+
+/* Opens the poller. */
+
+bool PortPoller::open()
+{
+#if defined(__linux__)
+    if (isOpen())
+        return true;
+
+    m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (m_epollFd < 0) {
+        LogError(LOG_MODEM, "Cannot create the port poller, err: %d (%s)", errno, strerror(errno));
+        return false;
+    }
+
+    m_eventFd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_eventFd < 0) {
+        LogError(LOG_MODEM, "Cannot create the port poller wake event, err: %d (%s)", errno, strerror(errno));
+        close();
+        return false;
+    }
+
+    struct epoll_event ev;
+    ::memset(&ev, 0x00U, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = m_eventFd;
+    if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_eventFd, &ev) < 0) {
+        LogError(LOG_MODEM, "Cannot add the port poller wake event, err: %d (%s)", errno, strerror(errno));
+        close();
+        return false;
+    }
+
+    m_portFd = -1;
+    return true;
+#else
+    return false;
+#endif // defined(__linux__)
+}
+
+/* Closes the poller. */
+
+void PortPoller::close()
+{
+#if defined(__linux__)
+    if (m_eventFd >= 0)
+        ::close(m_eventFd);
+    if (m_epollFd >= 0)
+        ::close(m_epollFd);
+#endif // defined(__linux__)
+
+    m_epollFd = -1;
+    m_eventFd = -1;
+    m_portFd = -1;
+}
+
+/* Sets the port to wait on. */
+
+bool PortPoller::watch(IModemPort* port)
+{
+    if (!isOpen())
+        return false;
+
+    int fd = (port != nullptr) ? port->getReadDescriptor() : -1;
+
+#if defined(__linux__)
+    // a closed descriptor is removed from the epoll set automatically, and a reopened port may be given the same
+    // descriptor number, so the registration is refreshed (and re-added if necessary) every time
+    if (fd != m_portFd && m_portFd >= 0)
+        ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, m_portFd, nullptr);
+    m_portFd = -1;
+
+    if (fd >= 0) {
+        struct epoll_event ev;
+        ::memset(&ev, 0x00U, sizeof(ev));
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (::epoll_ctl(m_epollFd, EPOLL_CTL_MOD, fd, &ev) < 0) {
+            if (errno != ENOENT || ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+                LogError(LOG_MODEM, "Cannot add the modem port to the port poller, err: %d (%s)", errno, strerror(errno));
+                return false;
+            }
+        }
+
+        m_portFd = fd;
+    }
+#endif // defined(__linux__)
+
+    return m_portFd >= 0;
+}
+
+/* Waits for data to become available from the port. */
+
+bool PortPoller::wait(uint32_t timeout)
+{
+    if (!isOpen())
+        return false;
+
+#if defined(__linux__)
+    struct epoll_event events[MAX_POLL_EVENTS];
+    int ret = ::epoll_wait(m_epollFd, events, MAX_POLL_EVENTS, (int)timeout);
+    if (ret < 0) {
+        if (errno != EINTR)
+            LogError(LOG_MODEM, "Failed to wait on the port poller, err: %d (%s)", errno, strerror(errno));
+        return false;
+    }
+
+    bool ready = false;
+    for (int i = 0; i < ret; i++) {
+        if (events[i].data.fd == m_eventFd) {
+            uint64_t value = 0U;
+            while (::read(m_eventFd, &value, sizeof(value)) > 0)
+                ;
+        }
+        else if (events[i].data.fd == m_portFd) {
+            ready = true;
+        }
+    }
+
+    return ready;
+#else
+    return false;
+#endif // defined(__linux__)
+}
+
+/* Wakes a thread waiting on the poller. */
+
+void PortPoller::wake()
+{
+#if defined(__linux__)
+    if (m_eventFd < 0)
+        return;
+
+    // a failed write means the event counter is already saturated, and the waiting thread will wake regardless
+    uint64_t value = 1U;
+    ssize_t ret = ::write(m_eventFd, &value, sizeof(value));
+    (void)ret;
+#endif // defined(__linux__)
+}
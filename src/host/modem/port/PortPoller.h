@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Modem Host Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PortPoller.h
+ * @ingroup port
+ * @file PortPoller.cpp
+ * @ingroup port
+ */
+#if !defined(__PORT_POLLER_H__)
+#define __PORT_POLLER_H__
+
+#include "Defines.h"
+#include "modem/port/IModemPort.h"
+
+namespace modem
+{
+    namespace port
+    {
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief This class implements waiting for data to become available from a modem port.
+         * @note On Linux the port descriptor is waited on with epoll, along with an eventfd used to wake the
+         *  waiting thread. On other platforms the poller cannot be opened, and the caller should fall back
+         *  to polling the port.
+         * @ingroup port
+         */
+        class HOST_SW_API PortPoller {
+        public:
+            /**
+             * @brief Initializes a new instance of the PortPoller class.
+             */
+            PortPoller();
+            /**
+             * @brief Finalizes a instance of the PortPoller class.
+             */
+            ~PortPoller();
+
+            /**
+             * @brief Opens the poller.
+             * @returns bool True, if the poller was opened, otherwise false.
+             */
+            bool open();
+            /**
+             * @brief Closes the poller.
+             */
+            void close();
+
+            /**
+             * @brief Flag indicating whether the poller is open.
+             * @returns bool True, if the poller is open, otherwise false.
+             */
+            bool isOpen() const { return m_epollFd >= 0; }
+
+            /**
+             * @brief Sets the port to wait on.
+             * @note This should be called every time before waiting, as the port descriptor changes when the
+             *  port is reopened.
+             * @param port Port to wait on.
+             * @returns bool True, if the port can be waited on, otherwise false.
+             */
+            bool watch(IModemPort* port);
+
+            /**
+             * @brief Waits for data to become available from the port.
+             * @param timeout Maximum time to wait (in milliseconds).
+             * @returns bool True, if data is available from the port, otherwise false.
+             */
+            bool wait(uint32_t timeout);
+            /**
+             * @brief Wakes a thread waiting on the poller.
+             */
+            void wake();
+
+        private:
+            int m_epollFd;
+            int m_eventFd;
+            int m_portFd;
+        };
+    } // namespace port
+} // namespace modem
+
+#endif // __PORT_POLLER_H__
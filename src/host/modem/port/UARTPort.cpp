@@ -313,6 +313,17 @@ void UARTPort::close()
     m_isOpen = false;
 }
 
+/* Gets the descriptor that becomes readable when data is available from the serial port. */
+
+int UARTPort::getReadDescriptor() const
+{
+#if defined(_WIN32)
+    return -1;
+#else
+    return m_fd;
+#endif // defined(_WIN32)
+}
+
 #if defined(__APPLE__)
 /* Helper on Apple to set serial port to non-blocking. */
 
@@ -108,6 +108,12 @@ namespace modem
              */
             void close() override;
 
+            /**
+             * @brief Gets the descriptor that becomes readable when data is available from the serial port.
+             * @returns int Descriptor, or -1 if the port cannot be waited on.
+             */
+            int getReadDescriptor() const override;
+
 #if defined(__APPLE__)
             /**
              * @brief Helper on Apple to set serial port to non-blocking.
@@ -120,3 +120,14 @@ void UDPPort::close()
 {
     m_socket.close();
 }
+
+/* Gets the descriptor that becomes readable when data is available from the port. */
+
+int UDPPort::getReadDescriptor() const
+{
+#if defined(_WIN32)
+    return -1;
+#else
+    return m_socket.getDescriptor();
+#endif // defined(_WIN32)
+}
@@ -75,6 +75,17 @@ namespace modem
              */
             void close() override;
 
+            /**
+             * @brief Gets the descriptor that becomes readable when data is available from the port.
+             * @returns int Descriptor, or -1 if the port cannot be waited on.
+             */
+            int getReadDescriptor() const override;
+            /**
+             * @brief Flag indicating data was received from the port, but not yet read.
+             * @returns bool True, if data is pending, otherwise false.
+             */
+            bool hasPendingData() const override { return m_buffer.dataSize() > 0U; }
+
         protected:
             network::udp::Socket m_socket;
 
@@ -130,6 +130,44 @@ bool parseRequestBody(const HTTPPayload& request, HTTPPayload& reply, json::obje
     return true;
 }
 
+/**
+ * @brief Helper to generate the statistics of a control channel scheduler traffic class.
+ * @param trafficClass Traffic class.
+ * @param stats Statistics of the traffic class.
+ * @param histogram Queueing latency histogram of the traffic class.
+ * @returns json::object JSON object containing the statistics of the traffic class.
+ */
+json::object ccSchedulerStats(CCTrafficClass::E trafficClass, const CCSchedulerStats& stats, LatencyHistogram* histogram)
+{
+    json::object classObj = json::object();
+    classObj["class"].set<std::string>(ControlChannelScheduler::className(trafficClass));
+    classObj["depth"].set<uint32_t>(stats.depth);
+    classObj["queued"].set<uint64_t>(stats.queued);
+    classObj["sent"].set<uint64_t>(stats.sent);
+    classObj["coalesced"].set<uint64_t>(stats.coalesced);
+    classObj["dropped"].set<uint64_t>(stats.dropped);
+    classObj["expired"].set<uint64_t>(stats.expired);
+
+    LatencyHistogramSnapshot latency = histogram->snapshot();
+
+    json::object latencyObj = json::object();
+    uint64_t count = latency.count();
+    latencyObj["count"].set<uint64_t>(count);
+    uint64_t mean = latency.mean();
+    latencyObj["mean"].set<uint64_t>(mean);
+    uint64_t p50 = latency.percentile(50.0);
+    latencyObj["p50"].set<uint64_t>(p50);
+    uint64_t p90 = latency.percentile(90.0);
+    latencyObj["p90"].set<uint64_t>(p90);
+    uint64_t p99 = latency.percentile(99.0);
+    latencyObj["p99"].set<uint64_t>(p99);
+    uint64_t max = latency.max();
+    latencyObj["max"].set<uint64_t>(max);
+    classObj["latency"].set<json::object>(latencyObj);
+
+    return classObj;
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -307,6 +345,7 @@ void RESTAPI::initializeEndpoints()
     m_dispatcher.match(GET_DMR_CC_DEDICATED).get(REST_API_BIND(RESTAPI::restAPI_GetDMRCCEnable, this));
     m_dispatcher.match(GET_DMR_CC_BCAST).get(REST_API_BIND(RESTAPI::restAPI_GetDMRCCBroadcast, this));
     m_dispatcher.match(GET_DMR_AFFILIATIONS).get(REST_API_BIND(RESTAPI::restAPI_GetDMRAffList, this));
+    m_dispatcher.match(GET_DMR_CC_STATS).get(REST_API_BIND(RESTAPI::restAPI_GetDMRCCStats, this));
 
     /*
     ** Project 25
@@ -320,6 +359,7 @@ void RESTAPI::initializeEndpoints()
     m_dispatcher.match(GET_P25_CC_BCAST).get(REST_API_BIND(RESTAPI::restAPI_GetP25CCBroadcast, this));
     m_dispatcher.match(PUT_P25_RAW_TSBK).put(REST_API_BIND(RESTAPI::restAPI_PutP25RawTSBK, this));
     m_dispatcher.match(GET_P25_AFFILIATIONS).get(REST_API_BIND(RESTAPI::restAPI_GetP25AffList, this));
+    m_dispatcher.match(GET_P25_CC_STATS).get(REST_API_BIND(RESTAPI::restAPI_GetP25CCStats, this));
 
     /*
     ** Next Generation Digital Narrowband
@@ -1275,6 +1315,41 @@ void RESTAPI::restAPI_GetDMRAffList(const HTTPPayload& request, HTTPPayload& rep
     reply.payload(response);
 }
 
+/* REST API endpoint; implements get DMR control channel scheduler statistics request. */
+
+void RESTAPI::restAPI_GetDMRCCStats(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    if (m_dmr == nullptr) {
+        errorPayload(reply, "DMR mode is not enabled", HTTPPayload::SERVICE_UNAVAILABLE);
+        return;
+    }
+
+    dmr::Slot* tscc = m_dmr->getTSCCSlot();
+    if (tscc == nullptr) {
+        errorPayload(reply, "DMR control data is not enabled", HTTPPayload::SERVICE_UNAVAILABLE);
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    json::array classes = json::array();
+    for (uint32_t i = 0U; i < CC_TRAFFIC_CLASS_CNT; i++) {
+        CCTrafficClass::E trafficClass = (CCTrafficClass::E)i;
+        json::object classObj = ccSchedulerStats(trafficClass, tscc->getCCSchedulerStats(trafficClass), tscc->getCCSchedulerLatency(trafficClass));
+        classes.push_back(json::value(classObj));
+    }
+
+    uint8_t slotNo = m_dmr->getTSCCSlotNo();
+    response["slot"].set<uint8_t>(slotNo);
+    response["classes"].set<json::array>(classes);
+    reply.payload(response);
+}
+
 /*
 ** Project 25
 */
@@ -1649,6 +1724,33 @@ void RESTAPI::restAPI_GetP25AffList(const HTTPPayload& request, HTTPPayload& rep
     reply.payload(response);
 }
 
+/* REST API endpoint; implements get P25 control channel scheduler statistics request. */
+
+void RESTAPI::restAPI_GetP25CCStats(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    if (m_p25 == nullptr) {
+        errorPayload(reply, "P25 mode is not enabled", HTTPPayload::SERVICE_UNAVAILABLE);
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    json::array classes = json::array();
+    for (uint32_t i = 0U; i < CC_TRAFFIC_CLASS_CNT; i++) {
+        CCTrafficClass::E trafficClass = (CCTrafficClass::E)i;
+        json::object classObj = ccSchedulerStats(trafficClass, m_p25->getCCSchedulerStats(trafficClass), m_p25->getCCSchedulerLatency(trafficClass));
+        classes.push_back(json::value(classObj));
+    }
+
+    response["classes"].set<json::array>(classes);
+    reply.payload(response);
+}
+
 /*
 ** Next Generation Digital Narrowband
 */
@@ -79,6 +79,7 @@
 #define GET_DMR_CC_DEDICATED            "/dmr/cc-enable"
 #define GET_DMR_CC_BCAST                "/dmr/cc-broadcast"
 #define GET_DMR_AFFILIATIONS            "/dmr/report-affiliations"
+#define GET_DMR_CC_STATS                "/dmr/cc-stats"
 
 #define GET_P25_CC                      "/p25/cc"
 #define GET_P25_CC_FALLBACK_BASE        "/p25/cc-fallback/"
@@ -92,6 +93,7 @@
 #define GET_P25_CC_BCAST                "/p25/cc-broadcast"
 #define PUT_P25_RAW_TSBK                "/p25/raw-tsbk"
 #define GET_P25_AFFILIATIONS            "/p25/report-affiliations"
+#define GET_P25_CC_STATS                "/p25/cc-stats"
 
 #define GET_NXDN_CC                     "/nxdn/cc"
 #define GET_NXDN_DEBUG_BASE             "/nxdn/debug/"
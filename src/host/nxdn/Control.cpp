@@ -300,6 +300,8 @@ void Control::setOptions(yaml::Node& conf, bool supervisor, const std::string cw
     lc::RCCH::setSiteData(m_siteData);
     lc::RCCH::setCallsign(cwCallsign);
 
+    m_control->clearCCBcastCache();
+
     std::vector<lookups::IdenTable> entries = m_idenTable->list();
     for (auto entry : entries) {
         if (entry.channelId() == channelId) {
@@ -278,6 +278,44 @@ bool ControlSignaling::processNetwork(FuncChannelType::E fct, ChOption::E option
     return true;
 }
 
+/* Helper to encode a RCCH into an air-ready CAC frame. */
+
+void ControlSignaling::encodeRCCH(lc::RCCH* rcch, uint32_t length, uint8_t ran, ChStructure::E structure, uint8_t* data)
+{
+    assert(rcch != nullptr);
+    assert(data != nullptr);
+
+    ::memset(data + 2U, 0x00U, NXDN_FRAME_LENGTH_BYTES);
+
+    Sync::addNXDNSync(data + 2U);
+
+    // generate the LICH
+    channel::LICH lich;
+    lich.setRFCT(RFChannelType::RCCH);
+    lich.setFCT(FuncChannelType::CAC_OUTBOUND);
+    lich.setOption(ChOption::DATA_NORMAL);
+    lich.setOutbound(true);
+    lich.encode(data + 2U);
+
+    uint8_t buffer[NXDN_RCCH_LC_LENGTH_BYTES];
+    ::memset(buffer, 0x00U, NXDN_RCCH_LC_LENGTH_BYTES);
+
+    rcch->encode(buffer, length);
+
+    // generate the CAC
+    channel::CAC cac;
+    cac.setRAN(ran);
+    cac.setStructure(structure);
+    cac.setData(buffer);
+    cac.encode(data + 2U);
+
+    data[0U] = modem::TAG_DATA;
+    data[1U] = 0x00U;
+
+    NXDNUtils::scrambler(data + 2U);
+    NXDNUtils::addPostBits(data + 2U);
+}
+
 // ---------------------------------------------------------------------------
 //  Protected Class Members
 // ---------------------------------------------------------------------------
@@ -291,6 +329,7 @@ ControlSignaling::ControlSignaling(Control* nxdn, bool debug, bool verbose) :
     m_ccchPagingCnt(2U),
     m_ccchMultiCnt(2U),
     m_rcchIterateCnt(2U),
+    m_ccBcastCache(NXDN_FRAME_LENGTH_BYTES + 2U),
     m_verifyAff(false),
     m_verifyReg(false),
     m_disableGrantSrcIdCheck(false),
@@ -332,35 +371,7 @@ void ControlSignaling::writeRF_Message(RCCH* rcch, bool noNetwork, bool imm)
         return;
 
     uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
-    ::memset(data + 2U, 0x00U, NXDN_FRAME_LENGTH_BYTES);
-
-    Sync::addNXDNSync(data + 2U);
-
-    // generate the LICH
-    channel::LICH lich;
-    lich.setRFCT(RFChannelType::RCCH);
-    lich.setFCT(FuncChannelType::CAC_OUTBOUND);
-    lich.setOption(ChOption::DATA_NORMAL);
-    lich.setOutbound(true);
-    lich.encode(data + 2U);
-
-    uint8_t buffer[NXDN_RCCH_LC_LENGTH_BYTES];
-    ::memset(buffer, 0x00U, NXDN_RCCH_LC_LENGTH_BYTES);
-
-    rcch->encode(buffer, NXDN_RCCH_LC_LENGTH_BITS);
-
-    // generate the CAC
-    channel::CAC cac;
-    cac.setRAN(m_nxdn->m_ran);
-    cac.setStructure(ChStructure::SR_RCCH_SINGLE);
-    cac.setData(buffer);
-    cac.encode(data + 2U);
-
-    data[0U] = modem::TAG_DATA;
-    data[1U] = 0x00U;
-
-    NXDNUtils::scrambler(data + 2U);
-    NXDNUtils::addPostBits(data + 2U);
+    encodeRCCH(rcch, NXDN_RCCH_LC_LENGTH_BITS, m_nxdn->m_ran, ChStructure::SR_RCCH_SINGLE, data);
 
     if (!noNetwork)
         writeNetwork(data, NXDN_FRAME_LENGTH_BYTES + 2U);
@@ -425,6 +436,25 @@ void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adj
     m_nxdn->m_debug = m_debug = controlDebug;
 }
 
+/* Helper to write a cached CC broadcast packet on the RF interface. */
+
+bool ControlSignaling::writeRF_CC_Message_Bcast(uint8_t messageType)
+{
+    // always regenerate the broadcast when debugging
+    if (m_debug)
+        return false;
+
+    const uint8_t* data = m_ccBcastCache.find(messageType);
+    if (data == nullptr)
+        return false;
+
+    if (m_nxdn->m_duplex) {
+        m_nxdn->addFrame(data);
+    }
+
+    return true;
+}
+
 /* Helper to write a grant packet. */
 
 bool ControlSignaling::writeRF_Message_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, bool skip, uint32_t chNo)
@@ -775,21 +805,8 @@ void ControlSignaling::writeRF_Message_U_Reg_Rsp(uint32_t srcId, uint32_t dstId,
 
 void ControlSignaling::writeRF_CC_Message_Site_Info()
 {
-    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
-    ::memset(data + 2U, 0x00U, NXDN_FRAME_LENGTH_BYTES);
-
-    Sync::addNXDNSync(data + 2U);
-
-    // generate the LICH
-    channel::LICH lich;
-    lich.setRFCT(RFChannelType::RCCH);
-    lich.setFCT(FuncChannelType::CAC_OUTBOUND);
-    lich.setOption(ChOption::DATA_NORMAL);
-    lich.setOutbound(true);
-    lich.encode(data + 2U);
-
-    uint8_t buffer[NXDN_RCCH_LC_LENGTH_BYTES];
-    ::memset(buffer, 0x00U, NXDN_RCCH_LC_LENGTH_BYTES);
+    if (writeRF_CC_Message_Bcast(MessageType::RCCH_SITE_INFO))
+        return;
 
     std::unique_ptr<rcch::MESSAGE_TYPE_SITE_INFO> rcch = std::make_unique<rcch::MESSAGE_TYPE_SITE_INFO>();
     DEBUG_LOG_MSG(rcch->toString());
@@ -799,20 +816,12 @@ void ControlSignaling::writeRF_CC_Message_Site_Info()
     rcch->setCcchMultiCnt(m_ccchMultiCnt);
     rcch->setRcchIterateCount(m_rcchIterateCnt);
 
-    rcch->encode(buffer, NXDN_RCCH_LC_LENGTH_BITS);
-
-    // generate the CAC
-    channel::CAC cac;
-    cac.setRAN(m_nxdn->m_ran);
-    cac.setStructure(ChStructure::SR_RCCH_HEAD_SINGLE);
-    cac.setData(buffer);
-    cac.encode(data + 2U);
-
-    data[0U] = modem::TAG_DATA;
-    data[1U] = 0x00U;
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    encodeRCCH(rcch.get(), NXDN_RCCH_LC_LENGTH_BITS, m_nxdn->m_ran, ChStructure::SR_RCCH_HEAD_SINGLE, data);
 
-    NXDNUtils::scrambler(data + 2U);
-    NXDNUtils::addPostBits(data + 2U);
+    if (!m_debug) {
+        ::memcpy(m_ccBcastCache.add(MessageType::RCCH_SITE_INFO), data, NXDN_FRAME_LENGTH_BYTES + 2U);
+    }
 
     if (m_nxdn->m_duplex) {
         m_nxdn->addFrame(data);
@@ -823,39 +832,18 @@ void ControlSignaling::writeRF_CC_Message_Site_Info()
 
 void ControlSignaling::writeRF_CC_Message_Service_Info()
 {
-    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
-    ::memset(data + 2U, 0x00U, NXDN_FRAME_LENGTH_BYTES);
-
-    Sync::addNXDNSync(data + 2U);
-
-    // generate the LICH
-    channel::LICH lich;
-    lich.setRFCT(RFChannelType::RCCH);
-    lich.setFCT(FuncChannelType::CAC_OUTBOUND);
-    lich.setOption(ChOption::DATA_NORMAL);
-    lich.setOutbound(true);
-    lich.encode(data + 2U);
-
-    uint8_t buffer[NXDN_RCCH_LC_LENGTH_BYTES];
-    ::memset(buffer, 0x00U, NXDN_RCCH_LC_LENGTH_BYTES);
+    if (writeRF_CC_Message_Bcast(MessageType::SRV_INFO))
+        return;
 
     std::unique_ptr<rcch::MESSAGE_TYPE_SRV_INFO> rcch = std::make_unique<rcch::MESSAGE_TYPE_SRV_INFO>();
     DEBUG_LOG_MSG(rcch->toString());
-    rcch->encode(buffer, NXDN_RCCH_LC_LENGTH_BITS / 2U);
-    //rcch->encode(buffer, NXDN_RCCH_LC_LENGTH_BITS / 2U, NXDN_RCCH_LC_LENGTH_BITS / 2U);
 
-    // generate the CAC
-    channel::CAC cac;
-    cac.setRAN(m_nxdn->m_ran);
-    cac.setStructure(ChStructure::SR_RCCH_SINGLE);
-    cac.setData(buffer);
-    cac.encode(data + 2U);
-
-    data[0U] = modem::TAG_DATA;
-    data[1U] = 0x00U;
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    encodeRCCH(rcch.get(), NXDN_RCCH_LC_LENGTH_BITS / 2U, m_nxdn->m_ran, ChStructure::SR_RCCH_SINGLE, data);
 
-    NXDNUtils::scrambler(data + 2U);
-    NXDNUtils::addPostBits(data + 2U);
+    if (!m_debug) {
+        ::memcpy(m_ccBcastCache.add(MessageType::SRV_INFO), data, NXDN_FRAME_LENGTH_BYTES + 2U);
+    }
 
     if (m_nxdn->m_duplex) {
         m_nxdn->addFrame(data);
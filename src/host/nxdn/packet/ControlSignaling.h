@@ -17,6 +17,7 @@
 #define __NXDN_PACKET_CONTROL_SIGNALING_H__
 
 #include "Defines.h"
+#include "CCBcastCache.h"
 #include "common/nxdn/lc/RCCH.h"
 #include "nxdn/Control.h"
 
@@ -67,6 +68,17 @@ namespace nxdn
             bool processNetwork(defines::FuncChannelType::E fct, defines::ChOption::E option, lc::RTCH& netLC, uint8_t* data, uint32_t len);
             /** @} */
 
+            /**
+             * @brief Helper to encode a RCCH into an air-ready CAC frame.
+             * @note This is used for both freshly written and cached RCCHs, so both are always encoded alike.
+             * @param rcch RCCH to encode.
+             * @param length Length of the RCCH (in bits).
+             * @param ran Radio Access Number.
+             * @param structure CAC channel structure.
+             * @param[out] data Buffer to encode the frame into (tag and frame, NXDN_FRAME_LENGTH_BYTES + 2 bytes).
+             */
+            static void encodeRCCH(lc::RCCH* rcch, uint32_t length, uint8_t ran, defines::ChStructure::E structure, uint8_t* data);
+
         protected:
             friend class nxdn::packet::Data;
             friend class nxdn::packet::Voice;
@@ -79,6 +91,8 @@ namespace nxdn
             uint8_t m_ccchMultiCnt;
             uint8_t m_rcchIterateCnt;
 
+            CCBcastCache m_ccBcastCache;
+
             bool m_verifyAff;
             bool m_verifyReg;
 
@@ -137,6 +151,16 @@ namespace nxdn
              * @param adjSS Flag indicating whether or not adjacent site status should be broadcast.
              */
             void writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adjSS);
+            /**
+             * @brief Helper to write a cached CC broadcast packet on the RF interface.
+             * @param messageType RCCH message type of the broadcast.
+             * @returns bool True, if the broadcast was cached and written, otherwise false.
+             */
+            bool writeRF_CC_Message_Bcast(uint8_t messageType);
+            /**
+             * @brief Helper to clear the cached encoded CC broadcasts.
+             */
+            void clearCCBcastCache() { m_ccBcastCache.clear(); }
 
             /**
              * @brief Helper to write a grant packet.
@@ -89,6 +89,7 @@ Control::Control(bool authoritative, uint32_t nac, uint32_t callHang, uint32_t q
     m_activeTG(),
     m_txImmQueue(queueSize, "P25 Imm Frame"),
     m_txQueue(queueSize, "P25 Frame"),
+    m_txQueuePeeked(false),
     m_rfState(RS_RF_LISTENING),
     m_rfLastDstId(0U),
     m_rfLastSrcId(0U),
@@ -418,6 +419,8 @@ void Control::setOptions(yaml::Node& conf, bool supervisor, const std::string cw
     lc::TSBK::setCallsign(cwCallsign);
     lc::TSBK::setSiteData(m_siteData);
 
+    m_control->clearCCBcastCache();
+
     std::vector<::lookups::IdenTable> entries = m_idenTable->list();
     for (auto entry : entries) {
         if (entry.channelId() == channelId) {
@@ -732,25 +735,25 @@ uint32_t Control::peekFrameLength()
 {
     std::lock_guard<std::mutex> lock(m_queueLock);
 
+    // the frame already peeked from the frame queue is the next frame
+    if (m_txQueuePeeked && !m_txQueue.isEmpty())
+        return peekTxQueue();
+    m_txQueuePeeked = false;
+
     if (m_txQueue.isEmpty() && m_txImmQueue.isEmpty())
         return 0U;
 
-    uint8_t length[2U];
-    ::memset(length, 0x00U, 2U);
+    // tx immediate queue takes priority (broadcasts only fill air time the frame queue leaves idle)
+    uint32_t len = m_txImmQueue.peek(CCTrafficClass::SIGNALING);
+    if (len > 0U)
+        return len;
 
-    uint16_t len = 0U;
-
-    // tx immediate queue takes priority
-    if (!m_txImmQueue.isEmpty()) {
-        m_txImmQueue.peek(length, 2U);
-        len = (length[0U] << 8) + length[1U];
-    }
-    else {
-        m_txQueue.peek(length, 2U);
-        len = (length[0U] << 8) + length[1U];
+    if (!m_txQueue.isEmpty()) {
+        m_txQueuePeeked = true;
+        return peekTxQueue();
     }
 
-    return len;
+    return m_txImmQueue.peek();
 }
 
 /* Helper to determine whether or not the internal frame queue is full. */
@@ -783,29 +786,23 @@ uint32_t Control::getFrame(uint8_t* data)
 
     std::lock_guard<std::mutex> lock(m_queueLock);
 
+    // the frame already peeked from the frame queue is the next frame
+    if (m_txQueuePeeked && !m_txQueue.isEmpty())
+        return getTxQueue(data);
+    m_txQueuePeeked = false;
+
     if (m_txQueue.isEmpty() && m_txImmQueue.isEmpty())
         return 0U;
 
-    uint8_t length[2U];
-    ::memset(length, 0x00U, 2U);
-
-    uint16_t len = 0U;
-
-    // tx immediate queue takes priority
-    if (!m_txImmQueue.isEmpty()) {
-        m_txImmQueue.get(length, 2U);
-        len = (length[0U] << 8) + length[1U];
+    // tx immediate queue takes priority (broadcasts only fill air time the frame queue leaves idle)
+    uint32_t len = m_txImmQueue.get(data, CCTrafficClass::SIGNALING);
+    if (len > 0U)
+        return len;
 
-        m_txImmQueue.get(data, len);
-    }
-    else {
-        m_txQueue.get(length, 2U);
-        len = (length[0U] << 8) + length[1U];
+    if (!m_txQueue.isEmpty())
+        return getTxQueue(data);
 
-        m_txQueue.get(data, len);
-    }
-
-    return len;
+    return m_txImmQueue.get(data);
 }
 
 /* Helper to write end of voice call frame data. */
@@ -852,13 +849,14 @@ void Control::clock()
     if (m_network != nullptr) {
         processNetwork();
 
-        if (m_network->getStatus() == network::NET_STAT_RUNNING) {
-            m_siteData.setNetActive(true);
-        }
-        else {
-            m_siteData.setNetActive(false);
+        bool netActive = m_network->getStatus() == network::NET_STAT_RUNNING;
+        if (netActive != m_siteData.netActive()) {
+            // the network state is broadcast on the control channel
+            m_control->clearCCBcastCache();
         }
 
+        m_siteData.setNetActive(netActive);
+
         lc::TDULC::setSiteData(m_siteData);
         lc::TSBK::setSiteData(m_siteData);
     }
@@ -1042,6 +1040,11 @@ void Control::clockSiteData(uint32_t ms)
                         uint8_t updateCnt = entry.second;
                         if (updateCnt > 0U) {
                             updateCnt--;
+
+                            // the adjacent site broadcast flags the site as failed once it expires
+                            if (updateCnt == 0U) {
+                                m_control->clearCCBcastCache();
+                            }
                         }
 
                         if (updateCnt == 0U) {
@@ -1229,6 +1232,14 @@ bool Control::isBusy() const
     return m_rfState != RS_RF_LISTENING || m_netState != RS_NET_IDLE;
 }
 
+/* Gets the statistics of the given traffic class of the control channel scheduler. */
+
+CCSchedulerStats Control::getCCSchedulerStats(CCTrafficClass::E trafficClass)
+{
+    std::lock_guard<std::mutex> lock(m_queueLock);
+    return m_txImmQueue.stats(trafficClass);
+}
+
 /* Helper to change the debug and verbose state. */
 
 void Control::setDebugVerbose(bool debug, bool verbose)
@@ -1273,7 +1284,7 @@ uint32_t Control::getLastSrcId() const
 
 /* Add data frame to the data ring buffer. */
 
-void Control::addFrame(const uint8_t* data, uint32_t length, bool net, bool imm)
+void Control::addFrame(const uint8_t* data, uint32_t length, bool net, bool imm, CCTrafficClass::E trafficClass, ulong64_t key)
 {
     assert(data != nullptr);
 
@@ -1297,30 +1308,12 @@ void Control::addFrame(const uint8_t* data, uint32_t length, bool net, bool imm)
 
     // is this immediate data?
     if (imm) {
-        // resize immediate queue if necessary (this shouldn't really ever happen)
-        uint32_t space = m_txImmQueue.freeSpace();
-        if (space < (length + 1U)) {
-            if (!net) {
-                uint32_t queueLen = m_txImmQueue.length();
-                m_txImmQueue.resize(queueLen + P25_LDU_FRAME_LENGTH_BYTES);
-                LogError(LOG_P25, "overflow in the P25 queue while writing imm data; queue free is %u, needed %u; resized was %u is %u, fifoSpace = %u", space, length, queueLen, m_txImmQueue.length(), fifoSpace);
-                return;
-            }
-            else {
-                LogError(LOG_P25, "overflow in the P25 queue while writing imm network data; queue free is %u, needed %u, fifoSpace = %u", space, length, fifoSpace);
-                return;
-            }
+        // the scheduler makes room by dropping lower priority frames, it is never resized
+        if (!m_txImmQueue.add(data, length, trafficClass, key)) {
+            LogError(LOG_P25, "overflow in the P25 queue while writing imm %sdata; queue free is %u, needed %u, fifoSpace = %u", (net) ? "network " : "",
+                m_txImmQueue.freeSpace(), length, fifoSpace);
         }
 
-        uint8_t lenBuffer[2U];
-        if (length > 255U)
-            lenBuffer[0U] = (length >> 8U) & 0xFFU;
-        else
-            lenBuffer[0U] = 0x00U;
-        lenBuffer[1U] = length & 0xFFU;
-        m_txImmQueue.addData(lenBuffer, 2U);
-
-        m_txImmQueue.addData(data, length);
         return;
     }
 
@@ -1350,6 +1343,35 @@ void Control::addFrame(const uint8_t* data, uint32_t length, bool net, bool imm)
     m_txQueue.addData(data, length);
 }
 
+/* Helper to get the frame data length for the next frame in the frame queue. */
+
+uint32_t Control::peekTxQueue()
+{
+    uint8_t length[2U];
+    ::memset(length, 0x00U, 2U);
+
+    m_txQueue.peek(length, 2U);
+    return (length[0U] << 8) + length[1U];
+}
+
+/* Helper to get the next frame from the frame queue. */
+
+uint32_t Control::getTxQueue(uint8_t* data)
+{
+    uint8_t length[2U];
+    ::memset(length, 0x00U, 2U);
+
+    uint16_t len = 0U;
+
+    m_txQueue.get(length, 2U);
+    len = (length[0U] << 8) + length[1U];
+
+    m_txQueue.get(data, len);
+
+    m_txQueuePeeked = false;
+    return len;
+}
+
 /* Process a data frames from the network. */
 
 void Control::processNetwork()
@@ -1781,11 +1803,14 @@ bool Control::writeRF_ControlData()
         m_ccFrameCnt = 0U;
     }
 
-    // don't add any frames if the queue is full
-    uint8_t len = (P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES * 2U) + 2U;
-    uint32_t space = m_txQueue.freeSpace();
-    if (space < (len + 1U)) {
-        return false;
+    // don't add any frames if enough broadcasts are already scheduled, or the scheduler is full
+    {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        uint8_t len = (P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES * 2U) + 2U;
+        if (m_txImmQueue.depth(CCTrafficClass::BROADCAST) >= CC_BCAST_QUEUE_DEPTH ||
+            m_txImmQueue.freeSpace() < (len + 1U)) {
+            return false;
+        }
     }
 
     const uint8_t maxSeq = 9U;
@@ -1799,7 +1824,7 @@ bool Control::writeRF_ControlData()
         }
     }
 
-    m_control->writeRF_ControlData(m_ccFrameCnt, m_ccSeq, true);
+    m_control->writeRF_ControlData(m_ccFrameCnt, m_ccSeq, true, true);
 
     m_ccSeq++;
     if (m_ccSeq == maxSeq) {
@@ -1817,6 +1842,11 @@ bool Control::writeRF_ControlEnd()
         return false;
 
     m_txQueue.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        m_txImmQueue.clear(CCTrafficClass::BROADCAST);
+    }
+
     m_ccPacketInterval.stop();
     m_adjSiteUpdate.stop();
 
@@ -2070,7 +2100,7 @@ void Control::generateLLA_AM1_Parameters()
         return;
     }
 
-    crypto::AES* aes = new crypto::AES(crypto::AESKeyLength::AES_128);
+    crypto::AES aes = crypto::AES(crypto::AESKeyLength::AES_128);
 
     // generate new RS
     uint8_t RS[AUTH_RAND_SEED_LENGTH_BYTES];
@@ -2093,14 +2123,10 @@ void Control::generateLLA_AM1_Parameters()
         m_llaCRS[i] = ~m_llaRS[i];
 
     // perform crypto
-    uint8_t* KS = aes->encryptECB(m_llaRS, AUTH_KEY_LENGTH_BYTES * sizeof(uint8_t), m_llaK);
-    ::memcpy(m_llaKS, KS, AUTH_KEY_LENGTH_BYTES);
+    aes.setKey(m_llaK);
+    aes.encryptECB(m_llaRS, m_llaKS, AUTH_KEY_LENGTH_BYTES * sizeof(uint8_t));
 
     if (m_verbose) {
         LogMessage(LOG_P25, "P25, generated LLA AM1 parameters");
     }
-
-    // cleanup
-    delete[] KS;
-    delete aes;
 }
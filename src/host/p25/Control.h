@@ -26,6 +26,7 @@
 #define __P25_CONTROL_H__
 
 #include "Defines.h"
+#include "ControlChannelScheduler.h"
 #include "common/p25/NID.h"
 #include "common/lookups/RSSIInterpolator.h"
 #include "common/lookups/IdenTableLookup.h"
@@ -246,6 +247,19 @@ namespace p25
          */
         bool isBusy() const;
 
+        /**
+         * @brief Gets the statistics of the given traffic class of the control channel scheduler.
+         * @param trafficClass Traffic class.
+         * @returns CCSchedulerStats Statistics of the traffic class.
+         */
+        CCSchedulerStats getCCSchedulerStats(CCTrafficClass::E trafficClass);
+        /**
+         * @brief Gets the queueing latency histogram of the given traffic class of the control channel scheduler.
+         * @param trafficClass Traffic class.
+         * @returns LatencyHistogram* Queueing latency histogram (us).
+         */
+        LatencyHistogram* getCCSchedulerLatency(CCTrafficClass::E trafficClass) const { return m_txImmQueue.latency(trafficClass); }
+
         /**
          * @brief Flag indicating whether debug is enabled or not.
          * @returns bool True, if debugging is enabled, otherwise false.
@@ -322,8 +336,9 @@ namespace p25
 
         std::vector<uint32_t> m_activeTG;
 
-        RingBuffer<uint8_t> m_txImmQueue;
+        ControlChannelScheduler m_txImmQueue;
         RingBuffer<uint8_t> m_txQueue;
+        bool m_txQueuePeeked;
         static std::mutex m_queueLock;
 
         RPT_RF_STATE m_rfState;
@@ -398,8 +413,22 @@ namespace p25
          * @param length Length of data to add.
          * @param net Flag indicating whether the data came from the network or not
          * @param imm Flag indicating whether or not the data is priority and is added to the immediate queue.
+         * @param trafficClass Traffic class of the data, when added to the immediate queue.
+         * @param key Coalescing key of the data, when added to the immediate queue (0 disables coalescing).
+         */
+        void addFrame(const uint8_t* data, uint32_t length, bool net = false, bool imm = false,
+            CCTrafficClass::E trafficClass = CCTrafficClass::SIGNALING, ulong64_t key = 0U);
+        /**
+         * @brief Helper to get the frame data length for the next frame in the frame queue.
+         * @returns uint32_t Length of the next frame.
+         */
+        uint32_t peekTxQueue();
+        /**
+         * @brief Helper to get the next frame from the frame queue.
+         * @param[out] data Buffer to copy the frame into.
+         * @returns uint32_t Length of the frame.
          */
-        void addFrame(const uint8_t* data, uint32_t length, bool net = false, bool imm = false);
+        uint32_t getTxQueue(uint8_t* data);
 
         /**
          * @brief Process a data frames from the network.
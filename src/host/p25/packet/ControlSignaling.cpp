@@ -643,7 +643,7 @@ bool ControlSignaling::process(uint8_t* data, uint32_t len, std::unique_ptr<lc::
 
                 ::ActivityLog("P25", true, "authentication response from %u", srcId);
 
-                crypto::AES* aes = new crypto::AES(crypto::AESKeyLength::AES_128);
+                crypto::AES aes = crypto::AES(crypto::AESKeyLength::AES_128);
 
                 // get RES1 from response
                 uint8_t RES1[AUTH_RES_LENGTH_BYTES];
@@ -669,7 +669,9 @@ bool ControlSignaling::process(uint8_t* data, uint32_t len, std::unique_ptr<lc::
                     expandedRAND1[i] = RC[i];
 
                 // generate XRES1
-                uint8_t* XRES1 = aes->encryptECB(expandedRAND1, AUTH_KEY_LENGTH_BYTES * sizeof(uint8_t), m_p25->m_llaKS);
+                uint8_t XRES1[AUTH_KEY_LENGTH_BYTES];
+                aes.setKey(m_p25->m_llaKS);
+                aes.encryptECB(expandedRAND1, XRES1, AUTH_KEY_LENGTH_BYTES * sizeof(uint8_t));
 
                 // compare RES1 and XRES1
                 bool authFailed = false;
@@ -679,9 +681,6 @@ bool ControlSignaling::process(uint8_t* data, uint32_t len, std::unique_ptr<lc::
                     }
                 }
 
-                // cleanup buffers
-                delete[] XRES1;
-
                 if (!authFailed) {
                     writeRF_TSDU_U_Reg_Rsp(srcId, m_p25->m_siteData.sysId());
                 }
@@ -744,10 +743,12 @@ bool ControlSignaling::processNetwork(uint8_t* data, uint32_t len, lc::LC& contr
                     if (osp->getAdjSiteId() != m_p25->m_siteData.siteId()) {
                         // update site table data
                         SiteData site;
+                        bool known = true;
                         try {
                             site = m_adjSiteTable.at(osp->getAdjSiteId());
                         } catch (...) {
                             site = SiteData();
+                            known = false;
                         }
 
                         if (m_verbose) {
@@ -755,6 +756,11 @@ bool ControlSignaling::processNetwork(uint8_t* data, uint32_t len, lc::LC& contr
                                 osp->getAdjSiteSysId(), osp->getAdjSiteRFSSId(), osp->getAdjSiteId(), osp->getAdjSiteChnId(), osp->getAdjSiteChnNo(), osp->getAdjSiteSvcClass());
                         }
 
+                        // invalidate the cached broadcasts if the site is new, has changed or was expired
+                        if (!known || m_adjSiteUpdateCnt[osp->getAdjSiteId()] == 0U || isAdjSiteChanged(site, osp)) {
+                            clearCCBcastCache();
+                        }
+
                         site.setAdjSite(osp->getAdjSiteSysId(), osp->getAdjSiteRFSSId(), osp->getAdjSiteId(), osp->getAdjSiteChnId(), osp->getAdjSiteChnNo(), osp->getAdjSiteSvcClass());
 
                         m_adjSiteTable[site.siteId()] = site;
@@ -765,11 +771,13 @@ bool ControlSignaling::processNetwork(uint8_t* data, uint32_t len, lc::LC& contr
                         */
                         // update site table data
                         SiteData site;
+                        bool known = true;
                         try {
                             site = m_sccbTable.at(osp->getAdjSiteRFSSId());
                         }
                         catch (...) {
                             site = SiteData();
+                            known = false;
                         }
 
                         if (m_verbose) {
@@ -777,6 +785,11 @@ bool ControlSignaling::processNetwork(uint8_t* data, uint32_t len, lc::LC& contr
                                 osp->getAdjSiteSysId(), osp->getAdjSiteRFSSId(), osp->getAdjSiteId(), osp->getAdjSiteChnId(), osp->getAdjSiteChnNo(), osp->getAdjSiteSvcClass());
                         }
 
+                        // invalidate the cached broadcasts if the SCCB is new or has changed
+                        if (!known || isAdjSiteChanged(site, osp)) {
+                            clearCCBcastCache();
+                        }
+
                         site.setAdjSite(osp->getAdjSiteSysId(), osp->getAdjSiteRFSSId(), osp->getAdjSiteId(), osp->getAdjSiteChnId(), osp->getAdjSiteChnNo(), osp->getAdjSiteSvcClass());
 
                         m_sccbTable[site.rfssId()] = site;
@@ -1256,6 +1269,42 @@ void ControlSignaling::setTSBKVerbose(bool verbose)
     lc::TDULC::setVerbose(verbose);
 }
 
+/* Helper to encode a TSBK into an air-ready single-block TSDU frame. */
+
+void ControlSignaling::encodeTSDU_SBF(lc::TSBK* tsbk, NID& nid, bool inbound, uint8_t* data, bool debug)
+{
+    assert(tsbk != nullptr);
+    assert(data != nullptr);
+
+    ::memset(data + 2U, 0x00U, P25_TSDU_FRAME_LENGTH_BYTES);
+
+    // generate Sync
+    Sync::addP25Sync(data + 2U);
+
+    // generate NID
+    nid.encode(data + 2U, DUID::TSDU);
+
+    // generate TSBK block
+    tsbk->setLastBlock(true); // always set last block -- this a Single Block TSDU
+    tsbk->encode(data + 2U);
+
+    if (debug) {
+        LogDebug(LOG_RF, P25_TSDU_STR ", lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
+            tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
+            tsbk->getSysId(), tsbk->getNetId());
+
+        Utils::dump(1U, "!!! *TSDU (SBF) TSBK Block Data", data + P25_PREAMBLE_LENGTH_BYTES + 2U, P25_TSBK_FEC_LENGTH_BYTES);
+    }
+
+    // add status bits
+    P25Utils::addStatusBits(data + 2U, P25_TSDU_FRAME_LENGTH_BITS, inbound, true);
+    P25Utils::addIdleStatusBits(data + 2U, P25_TSDU_FRAME_LENGTH_BITS);
+    P25Utils::setStatusBitsStartIdle(data + 2U);
+
+    data[0U] = modem::TAG_DATA;
+    data[1U] = 0x00U;
+}
+
 // ---------------------------------------------------------------------------
 //  Protected Class Members
 // ---------------------------------------------------------------------------
@@ -1271,10 +1320,15 @@ ControlSignaling::ControlSignaling(Control* p25, bool dumpTSBKData, bool debug,
     m_requireLLAForReg(false),
     m_rfMBF(nullptr),
     m_mbfCnt(0U),
+    m_mbfBcast(false),
     m_mbfIdenCnt(0U),
     m_mbfAdjSSCnt(0U),
     m_mbfSCCBCnt(0U),
     m_mbfGrpGrntCnt(0U),
+    m_ccBcastCache(P25_TSDU_FRAME_LENGTH_BYTES + 2U),
+    m_ccBcastImm(false),
+    m_ccBcastIdenGen(0U),
+    m_ccBcastIdenCnt(0U),
     m_adjSiteTable(),
     m_adjSiteUpdateCnt(),
     m_sccbTable(),
@@ -1467,30 +1521,7 @@ void ControlSignaling::writeRF_TSDU_SBF(lc::TSBK* tsbk, bool noNetwork, bool for
     assert(tsbk != nullptr);
 
     uint8_t data[P25_TSDU_FRAME_LENGTH_BYTES + 2U];
-    ::memset(data + 2U, 0x00U, P25_TSDU_FRAME_LENGTH_BYTES);
-
-    // generate Sync
-    Sync::addP25Sync(data + 2U);
-
-    // generate NID
-    m_p25->m_nid.encode(data + 2U, DUID::TSDU);
-
-    // generate TSBK block
-    tsbk->setLastBlock(true); // always set last block -- this a Single Block TSDU
-    tsbk->encode(data + 2U);
-
-    if (m_debug) {
-        LogDebug(LOG_RF, P25_TSDU_STR ", lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
-            tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
-            tsbk->getSysId(), tsbk->getNetId());
-
-        Utils::dump(1U, "!!! *TSDU (SBF) TSBK Block Data", data + P25_PREAMBLE_LENGTH_BYTES + 2U, P25_TSBK_FEC_LENGTH_BYTES);
-    }
-
-    // add status bits
-    P25Utils::addStatusBits(data + 2U, P25_TSDU_FRAME_LENGTH_BITS, m_inbound, true);
-    P25Utils::addIdleStatusBits(data + 2U, P25_TSDU_FRAME_LENGTH_BITS);
-    P25Utils::setStatusBitsStartIdle(data + 2U);
+    encodeTSDU_SBF(tsbk, m_p25->m_nid, m_inbound, data, m_debug);
 
     if (!noNetwork)
         writeNetworkRF(tsbk, data + 2U, true);
@@ -1513,14 +1544,17 @@ void ControlSignaling::writeRF_TSDU_SBF(lc::TSBK* tsbk, bool noNetwork, bool for
     }
 
     if (m_p25->m_duplex) {
-        data[0U] = modem::TAG_DATA;
-        data[1U] = 0x00U;
+        ulong64_t key = 0U;
+        CCTrafficClass::E trafficClass = CCTrafficClass::SIGNALING;
+        if (imm) {
+            trafficClass = getCCTrafficClass(tsbk, key);
+        }
 
-        m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U, false, imm);
+        m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U, false, imm, trafficClass, key);
         
         if (imm && m_redundantImmediate) {
-            // queue an immediate frame at least twice
-            m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U, false, imm);
+            // queue an immediate frame at least twice (the redundant copy is never coalesced)
+            m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U, false, imm, trafficClass);
         }
     }
 }
@@ -1560,7 +1594,7 @@ void ControlSignaling::writeNet_TSDU(lc::TSBK* tsbk)
 
 /* Helper to write a multi-block (3-block) P25 TSDU packet. */
 
-void ControlSignaling::writeRF_TSDU_MBF(lc::TSBK* tsbk)
+void ControlSignaling::writeRF_TSDU_MBF(lc::TSBK* tsbk, bool bcast)
 {
     if (!m_p25->m_enableControl) {
         ::memset(m_rfMBF, 0x00U, P25_PDU_FRAME_LENGTH_BYTES + 2U);
@@ -1582,25 +1616,40 @@ void ControlSignaling::writeRF_TSDU_MBF(lc::TSBK* tsbk)
         return;
     }
 
+    // generate TSBK block
+    tsbk->setLastBlock(m_mbfCnt + 1U == TSBK_MBF_CNT); // set last block on the last block of the MBF
+    tsbk->encode(frame, true);
+
+    if (m_debug) {
+        LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
+            tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
+            tsbk->getSysId(), tsbk->getNetId());
+
+        Utils::dump(1U, "!!! *TSDU MBF Block Data", frame, P25_TSBK_FEC_LENGTH_BYTES);
+    }
+
+    writeRF_TSDU_MBF_Block(frame, bcast);
+}
+
+/* Helper to write an encoded TSBK block into a multi-block (3-block) P25 TSDU packet. */
+
+void ControlSignaling::writeRF_TSDU_MBF_Block(const uint8_t* block, bool bcast)
+{
+    assert(block != nullptr);
+
     if (m_mbfCnt == 0U) {
         ::memset(m_rfMBF, 0x00U, P25_TSBK_FEC_LENGTH_BYTES * TSBK_MBF_CNT);
+        m_mbfBcast = true;
     }
 
-    // trigger encoding of last block and write to queue
-    if (m_mbfCnt + 1U == TSBK_MBF_CNT) {
-        // generate TSBK block
-        tsbk->setLastBlock(true); // set last block
-        tsbk->encode(frame, true);
+    // a multi-block packet carrying anything other than scheduled broadcasts stays on the frame queue
+    m_mbfBcast = m_mbfBcast && bcast;
 
-        if (m_debug) {
-            LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
-                tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
-                tsbk->getSysId(), tsbk->getNetId());
+    Utils::setBitRange(block, m_rfMBF, (m_mbfCnt * P25_TSBK_FEC_LENGTH_BITS), P25_TSBK_FEC_LENGTH_BITS);
 
-            Utils::dump(1U, "!!! *TSDU MBF Last TSBK Block", frame, P25_TSBK_FEC_LENGTH_BYTES);
-        }
-
-        Utils::setBitRange(frame, m_rfMBF, (m_mbfCnt * P25_TSBK_FEC_LENGTH_BITS), P25_TSBK_FEC_LENGTH_BITS);
+    // trigger write of the TSDU frame to the queue on the last block
+    if (m_mbfCnt + 1U == TSBK_MBF_CNT) {
+        uint8_t frame[P25_TSBK_FEC_LENGTH_BYTES];
 
         // generate TSDU frame
         uint8_t tsdu[P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES];
@@ -1612,10 +1661,6 @@ void ControlSignaling::writeRF_TSDU_MBF(lc::TSBK* tsbk)
             Utils::getBitRange(m_rfMBF, frame, offset, P25_TSBK_FEC_LENGTH_BITS);
 
             if (m_debug) {
-                LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
-                    tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
-                    tsbk->getSysId(), tsbk->getNetId());
-
                 Utils::dump(1U, "!!! *TSDU (MBF) TSBK Block", frame, P25_TSBK_FEC_LENGTH_BYTES);
             }
 
@@ -1646,26 +1691,13 @@ void ControlSignaling::writeRF_TSDU_MBF(lc::TSBK* tsbk)
         data[0U] = modem::TAG_DATA;
         data[1U] = 0x00U;
 
-        m_p25->addFrame(data, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U);
+        m_p25->addFrame(data, P25_TSDU_TRIPLE_FRAME_LENGTH_BYTES + 2U, false, m_mbfBcast, CCTrafficClass::BROADCAST);
 
         ::memset(m_rfMBF, 0x00U, P25_PDU_FRAME_LENGTH_BYTES + 2U);
         m_mbfCnt = 0U;
         return;
     }
 
-    // generate TSBK block
-    tsbk->setLastBlock(false); // clear last block
-    tsbk->encode(frame, true);
-
-    if (m_debug) {
-        LogDebug(LOG_RF, P25_TSDU_STR " (MBF), lco = $%02X, mfId = $%02X, lastBlock = %u, AIV = %u, EX = %u, srcId = %u, dstId = %u, sysId = $%03X, netId = $%05X",
-            tsbk->getLCO(), tsbk->getMFId(), tsbk->getLastBlock(), tsbk->getAIV(), tsbk->getEX(), tsbk->getSrcId(), tsbk->getDstId(),
-            tsbk->getSysId(), tsbk->getNetId());
-
-        Utils::dump(1U, "!!! *TSDU MBF Block Data", frame, P25_TSBK_FEC_LENGTH_BYTES);
-    }
-
-    Utils::setBitRange(frame, m_rfMBF, (m_mbfCnt * P25_TSBK_FEC_LENGTH_BITS), P25_TSBK_FEC_LENGTH_BITS);
     m_mbfCnt++;
 }
 
@@ -1757,7 +1789,7 @@ void ControlSignaling::writeRF_TDULC_ChanRelease(bool grp, uint32_t srcId, uint3
 
 /* Helper to write control channel packet data. */
 
-void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adjSS)
+void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adjSS, bool imm)
 {
     if (!m_p25->m_enableControl)
         return;
@@ -1800,6 +1832,17 @@ void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adj
         LogDebugEx(LOG_P25, "ControlSignaling::writeRF_ControlData()", "mbfCnt = %u, frameCnt = %u, seq = %u, adjSS = %u", m_mbfCnt, frameCnt, n, adjSS);
     }
 
+    // invalidate the cached broadcasts if the identity table has been reloaded
+    uint32_t idenGen = m_p25->m_idenTable->generation();
+    if (m_ccBcastCache.isEmpty() || idenGen != m_ccBcastIdenGen) {
+        clearCCBcastCache();
+        m_ccBcastIdenCnt = (uint8_t)m_p25->m_idenTable->list().size();
+        m_ccBcastIdenGen = idenGen;
+    }
+
+    // broadcasts scheduled on the immediate queue only fill air time the frame queue leaves idle
+    m_ccBcastImm = imm;
+
     // bryanb: this is just a simple counter because we treat the SYNC_BCST as unlocked
     m_microslotCount++;
     if (m_microslotCount > 7999U)
@@ -1896,8 +1939,7 @@ void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adj
 
         // pad MBF if we have 2 queued TSDUs
         if (m_mbfCnt == 2U) {
-            std::vector<::lookups::IdenTable> entries = m_p25->m_idenTable->list();
-            if (entries.size() > 1U) {
+            if (m_ccBcastIdenCnt > 1U) {
                 queueRF_TSBK_Ctrl(TSBKO::OSP_IDEN_UP);
             }
             else {
@@ -1913,6 +1955,8 @@ void ControlSignaling::writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adj
         m_mbfCnt = 0U;
     }
 
+    m_ccBcastImm = false;
+
     lc::TSBK::setVerbose(tsbkVerbose);
     m_p25->m_debug = m_debug = controlDebug;
 }
@@ -1924,6 +1968,34 @@ void ControlSignaling::queueRF_TSBK_Ctrl(uint8_t lco)
     if (!m_p25->m_enableControl)
         return;
 
+    // use the cached encoded broadcast, if there is one
+    uint32_t key = 0U;
+    bool cache = !m_debug && getCCBcastKey(lco, key);
+    if (cache) {
+        const uint8_t* data = m_ccBcastCache.find(key);
+        if (data != nullptr) {
+            switch (lco) {
+            case TSBKO::OSP_IDEN_UP:
+                m_mbfIdenCnt++;
+                break;
+            case TSBKO::OSP_ADJ_STS_BCAST:
+                m_mbfAdjSSCnt++;
+                break;
+            case TSBKO::OSP_SCCB_EXP:
+                m_mbfSCCBCnt++;
+                break;
+            }
+
+            if (m_ctrlTSDUMBF) {
+                writeRF_TSDU_MBF_Block(data, m_ccBcastImm);
+            }
+            else {
+                m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U, false, m_ccBcastImm, CCTrafficClass::BROADCAST);
+            }
+            return;
+        }
+    }
+
     std::unique_ptr<lc::TSBK> tsbk;
 
     switch (lco) {
@@ -2118,9 +2190,31 @@ void ControlSignaling::queueRF_TSBK_Ctrl(uint8_t lco)
     if (tsbk != nullptr) {
         tsbk->setLastBlock(true); // always set last block
 
+        if (cache) {
+            // encode the broadcast once and cache it
+            uint8_t* data = m_ccBcastCache.add(key);
+
+            if (m_ctrlTSDUMBF) {
+                tsbk->setLastBlock(m_mbfCnt + 1U == TSBK_MBF_CNT);
+                tsbk->encode(data, true);
+
+                writeRF_TSDU_MBF_Block(data, m_ccBcastImm);
+            }
+            else {
+                encodeTSDU_SBF(tsbk.get(), m_p25->m_nid, m_inbound, data);
+                m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U, false, m_ccBcastImm, CCTrafficClass::BROADCAST);
+            }
+            return;
+        }
+
         // are we transmitting CC as a multi-block?
         if (m_ctrlTSDUMBF) {
-            writeRF_TSDU_MBF(tsbk.get());
+            writeRF_TSDU_MBF(tsbk.get(), m_ccBcastImm);
+        }
+        else if (m_ccBcastImm && m_p25->m_duplex) {
+            uint8_t data[P25_TSDU_FRAME_LENGTH_BYTES + 2U];
+            encodeTSDU_SBF(tsbk.get(), m_p25->m_nid, m_inbound, data, m_debug);
+            m_p25->addFrame(data, P25_TSDU_FRAME_LENGTH_BYTES + 2U, false, true, CCTrafficClass::BROADCAST);
         }
         else {
             writeRF_TSDU_SBF(tsbk.get(), true);
@@ -2128,6 +2222,148 @@ void ControlSignaling::queueRF_TSBK_Ctrl(uint8_t lco)
     }
 }
 
+/* Helper to get the cache key of the given control TSBK. */
+
+bool ControlSignaling::getCCBcastKey(uint8_t lco, uint32_t& key)
+{
+    // trunking data is unsupported in simplex operation
+    if (!m_p25->m_duplex)
+        return false;
+
+    uint8_t n = 0U;
+    switch (lco) {
+        case TSBKO::OSP_IDEN_UP:
+            if (m_ccBcastIdenCnt == 0U)
+                return false;
+            if (m_mbfIdenCnt >= m_ccBcastIdenCnt)
+                m_mbfIdenCnt = 0U;
+            n = m_mbfIdenCnt;
+            break;
+        case TSBKO::OSP_ADJ_STS_BCAST:
+            if (m_adjSiteTable.size() == 0U)
+                return false;
+            if (m_mbfAdjSSCnt >= m_adjSiteTable.size())
+                m_mbfAdjSSCnt = 0U;
+            n = m_mbfAdjSSCnt;
+            break;
+        case TSBKO::OSP_SCCB_EXP:
+            if (m_sccbTable.size() == 0U)
+                return false;
+            if (m_mbfSCCBCnt >= m_sccbTable.size())
+                m_mbfSCCBCnt = 0U;
+            n = m_mbfSCCBCnt;
+            break;
+        case TSBKO::OSP_NET_STS_BCAST:
+        case TSBKO::OSP_RFSS_STS_BCAST:
+        case TSBKO::OSP_SNDCP_CH_ANN:
+        case TSBKO::OSP_MOT_PSH_CCH:
+        case TSBKO::OSP_MOT_CC_BSI:
+        case TSBKO::OSP_DVM_GIT_HASH:
+            break;
+        default:
+            // sync broadcasts and time/date announcements change every time they are sent
+            return false;
+    }
+
+    // the last block flag is encoded into the TSBK block, the last block of a MBF is cached separately
+    bool lastBlock = !m_ctrlTSDUMBF || (m_mbfCnt + 1U == TSBK_MBF_CNT);
+    key = (m_ctrlTSDUMBF ? 0x20000U : 0U) | (lastBlock ? 0x10000U : 0U) | (n << 8) | lco;
+    return true;
+}
+
+/* Helper to clear the cached encoded control channel broadcasts. */
+
+void ControlSignaling::clearCCBcastCache()
+{
+    m_ccBcastCache.clear();
+}
+
+/* Helper to determine if the adjacent site data differs from the given adjacent site broadcast. */
+
+bool ControlSignaling::isAdjSiteChanged(const SiteData& site, const lc::tsbk::OSP_ADJ_STS_BCAST* osp) const
+{
+    return site.sysId() != osp->getAdjSiteSysId() || site.rfssId() != osp->getAdjSiteRFSSId() || site.siteId() != osp->getAdjSiteId() ||
+        site.channelId() != osp->getAdjSiteChnId() || site.channelNo() != osp->getAdjSiteChnNo() || site.serviceClass() != osp->getAdjSiteSvcClass();
+}
+
+/* Helper to determine the control channel traffic class of the given TSBK. */
+
+CCTrafficClass::E ControlSignaling::getCCTrafficClass(const lc::TSBK* tsbk, ulong64_t& key) const
+{
+    key = 0U;
+
+    uint8_t lco = tsbk->getLCO();
+    uint8_t mfId = tsbk->getMFId();
+
+    if (mfId == MFG_MOT) {
+        switch (lco) {
+        case TSBKO::OSP_MOT_GRG_VCH_GRANT:
+            return CCTrafficClass::GRANT;
+        case TSBKO::OSP_MOT_GRG_VCH_UPD:
+            // a newer grant update for the same destination supersedes any queued grant update
+            key = ((ulong64_t)mfId << 40) | ((ulong64_t)lco << 32) | tsbk->getDstId();
+            return CCTrafficClass::BROADCAST;
+        case TSBKO::OSP_MOT_CC_BSI:
+        case TSBKO::OSP_MOT_PSH_CCH:
+            key = ((ulong64_t)mfId << 40) | ((ulong64_t)lco << 32);
+            return CCTrafficClass::BROADCAST;
+        default:
+            return CCTrafficClass::SIGNALING;
+        }
+    }
+
+    if (mfId != MFG_STANDARD && mfId != MFG_STANDARD_ALT)
+        return CCTrafficClass::SIGNALING;
+
+    switch (lco) {
+    case TSBKO::IOSP_GRP_VCH:
+    case TSBKO::IOSP_UU_VCH:
+    case TSBKO::IOSP_TELE_INT_DIAL:
+    case TSBKO::OSP_SNDCP_CH_GNT:
+        return CCTrafficClass::GRANT;
+
+    case TSBKO::OSP_GRP_VCH_GRANT_UPD:
+    case TSBKO::OSP_UU_VCH_GRANT_UPD:
+        // a newer grant update for the same destination supersedes any queued grant update
+        key = ((ulong64_t)lco << 32) | tsbk->getDstId();
+        return CCTrafficClass::BROADCAST;
+
+    case TSBKO::IOSP_ACK_RSP:
+    case TSBKO::IOSP_GRP_AFF:
+    case TSBKO::IOSP_U_REG:
+    case TSBKO::OSP_QUE_RSP:
+    case TSBKO::OSP_DENY_RSP:
+    case TSBKO::OSP_GRP_AFF_Q:
+    case TSBKO::OSP_LOC_REG_RSP:
+    case TSBKO::OSP_U_REG_CMD:
+    case TSBKO::OSP_U_DEREG_ACK:
+    case TSBKO::OSP_AUTH_DMD:
+    case TSBKO::OSP_AUTH_FNE_RESP:
+        return CCTrafficClass::RESPONSE;
+
+    case TSBKO::OSP_SYNC_BCAST:
+    case TSBKO::OSP_TIME_DATE_ANN:
+    case TSBKO::OSP_SYS_SRV_BCAST:
+    case TSBKO::OSP_RFSS_STS_BCAST:
+    case TSBKO::OSP_NET_STS_BCAST:
+        // site status broadcasts only ever describe this site, a newer broadcast supersedes any queued one
+        key = (ulong64_t)lco << 32;
+        return CCTrafficClass::BROADCAST;
+
+    case TSBKO::OSP_SNDCP_CH_ANN:
+    case TSBKO::OSP_SCCB_EXP:
+    case TSBKO::OSP_IDEN_UP_VU:
+    case TSBKO::OSP_SCCB:
+    case TSBKO::OSP_ADJ_STS_BCAST:
+    case TSBKO::OSP_IDEN_UP:
+        // these broadcasts rotate through differing content (i.e. adjacent sites or identities) and are never coalesced
+        return CCTrafficClass::BROADCAST;
+
+    default:
+        return CCTrafficClass::SIGNALING;
+    }
+}
+
 /* Helper to write a grant packet. */
 
 bool ControlSignaling::writeRF_TSDU_Grant(uint32_t srcId, uint32_t dstId, uint8_t serviceOptions, bool grp, bool net, bool skip, uint32_t chNo)
@@ -17,9 +17,11 @@
 #define __P25_PACKET_CONTROL_SIGNALING_H__
 
 #include "Defines.h"
+#include "CCBcastCache.h"
 #include "common/p25/data/DataHeader.h"
 #include "common/p25/data/DataBlock.h"
 #include "common/p25/lc/TSBK.h"
+#include "common/p25/lc/tsbk/OSP_ADJ_STS_BCAST.h"
 #include "common/p25/lc/AMBT.h"
 #include "common/p25/lc/TDULC.h"
 #include "common/Timer.h"
@@ -153,6 +155,17 @@ namespace p25
              */
             void setTSBKVerbose(bool verbose);
 
+            /**
+             * @brief Helper to encode a TSBK into an air-ready single-block TSDU frame.
+             * @note This is used for both freshly written and cached TSBKs, so both are always encoded alike.
+             * @param tsbk TSBK to encode.
+             * @param nid Network Identifier.
+             * @param inbound Flag indicating whether the frame is inbound.
+             * @param[out] data Buffer to encode the frame into (tag and frame, P25_TSDU_FRAME_LENGTH_BYTES + 2 bytes).
+             * @param debug Flag indicating whether the encoded TSBK is logged.
+             */
+            static void encodeTSDU_SBF(lc::TSBK* tsbk, NID& nid, bool inbound, uint8_t* data, bool debug = false);
+
         protected:
             friend class packet::Voice;
             friend class packet::Data;
@@ -169,12 +182,18 @@ namespace p25
 
             uint8_t* m_rfMBF;
             uint8_t m_mbfCnt;
+            bool m_mbfBcast;
 
             uint8_t m_mbfIdenCnt;
             uint8_t m_mbfAdjSSCnt;
             uint8_t m_mbfSCCBCnt;
             uint8_t m_mbfGrpGrntCnt;
 
+            CCBcastCache m_ccBcastCache;
+            bool m_ccBcastImm;
+            uint32_t m_ccBcastIdenGen;
+            uint8_t m_ccBcastIdenCnt;
+
             std::unordered_map<uint8_t, SiteData> m_adjSiteTable;
             std::unordered_map<uint8_t, uint8_t> m_adjSiteUpdateCnt;
 
@@ -278,8 +297,16 @@ namespace p25
             /**
              * @brief Helper to write a multi-block (3-block) P25 TSDU packet.
              * @param tsbk TSBK to write to the multi-block queue.
+             * @param bcast Flag indicating the TSBK is a scheduled control channel broadcast.
              */
-            void writeRF_TSDU_MBF(lc::TSBK* tsbk);
+            void writeRF_TSDU_MBF(lc::TSBK* tsbk, bool bcast = false);
+            /**
+             * @brief Helper to write an encoded TSBK block into a multi-block (3-block) P25 TSDU packet.
+             * @note A multi-block packet made only of scheduled broadcasts is written to the immediate queue.
+             * @param block Encoded TSBK block to write to the multi-block queue.
+             * @param bcast Flag indicating the block is a scheduled control channel broadcast.
+             */
+            void writeRF_TSDU_MBF_Block(const uint8_t* block, bool bcast = false);
             /**
              * @brief Helper to write a alternate multi-block PDU packet.
              * @param tsbk AMBT to write to the modem.
@@ -304,14 +331,41 @@ namespace p25
              * @param frameCnt Frame counter.
              * @param n 
              * @param adjSS Flag indicating whether or not adjacent site status should be broadcast.
+             * @param imm Flag indicating the broadcasts should be scheduled on the immediate queue.
              */
-            void writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adjSS);
+            void writeRF_ControlData(uint8_t frameCnt, uint8_t n, bool adjSS, bool imm = false);
 
             /**
              * @brief Helper to generate the given control TSBK into the TSDU frame queue.
              * @param lco TSBK LCO to queue into the frame queue.
              */
             void queueRF_TSBK_Ctrl(uint8_t lco);
+            /**
+             * @brief Helper to get the cache key of the given control TSBK.
+             * @note This will reset the rotation counter of the TSBK, if it has wrapped.
+             * @param lco TSBK LCO.
+             * @param[out] key Cache key.
+             * @returns bool True, if the control TSBK can be cached, otherwise false.
+             */
+            bool getCCBcastKey(uint8_t lco, uint32_t& key);
+            /**
+             * @brief Helper to clear the cached encoded control channel broadcasts.
+             */
+            void clearCCBcastCache();
+            /**
+             * @brief Helper to determine if the adjacent site data differs from the given adjacent site broadcast.
+             * @param site Adjacent site data.
+             * @param osp Adjacent site broadcast.
+             * @returns bool True, if the adjacent site data has changed, otherwise false.
+             */
+            bool isAdjSiteChanged(const SiteData& site, const lc::tsbk::OSP_ADJ_STS_BCAST* osp) const;
+            /**
+             * @brief Helper to determine the control channel traffic class of the given TSBK.
+             * @param tsbk TSBK.
+             * @param[out] key Coalescing key of the TSBK (0 if the TSBK is never coalesced).
+             * @returns CCTrafficClass::E Traffic class of the TSBK.
+             */
+            CCTrafficClass::E getCCTrafficClass(const lc::TSBK* tsbk, ulong64_t& key) const;
 
             /**
              * @brief Helper to write a grant packet.
@@ -60,17 +60,13 @@ HostPatch::HostPatch(const std::string& confFile) :
     m_confFile(confFile),
     m_conf(),
     m_network(nullptr),
-    m_srcTGId(0U),
-    m_srcSlot(1U),
-    m_dstTGId(0U),
-    m_dstSlot(1U),
+    m_patches(),
+    m_calls(),
+    m_dmrEmbeddedData(),
+    m_routes(),
     m_identity(),
     m_digiMode(1U),
-    m_dmrEmbeddedData(),
     m_grantDemand(false),
-    m_callInProgress(false),
-    m_rxStartTime(0U),
-    m_rxStreamId(0U),
     m_running(false),
     m_trace(false),
     m_debug(false)
@@ -161,6 +157,11 @@ int HostPatch::run()
 
     yaml::Node systemConf = m_conf["system"];
 
+    // read the talkgroup patches
+    ret = createPatches();
+    if (!ret)
+        return EXIT_FAILURE;
+
     // initialize peer networking
     ret = createNetwork();
     if (!ret)
@@ -243,71 +244,90 @@ bool HostPatch::readParams()
     return true;
 }
 
-/* Initializes network connectivity. */
+/* Reads the talkgroup patches from the configuration, and builds the routing table. */
 
-bool HostPatch::createNetwork()
+bool HostPatch::createPatches()
 {
-    yaml::Node networkConf = m_conf["network"];
+    yaml::Node& patchList = m_conf["patches"];
+    if (patchList.size() > 0U) {
+        for (size_t i = 0; i < patchList.size(); i++) {
+            yaml::Node& patchConf = patchList[i];
+
+            PatchEntry patch;
+            patch.name = patchConf["name"].as<std::string>();
+            patch.srcTGId = (uint32_t)patchConf["sourceTGID"].as<uint32_t>(1U);
+            patch.srcSlot = (uint8_t)patchConf["sourceSlot"].as<uint32_t>(1U);
+            patch.dstTGId = (uint32_t)patchConf["destinationTGID"].as<uint32_t>(1U);
+            patch.dstSlot = (uint8_t)patchConf["destinationSlot"].as<uint32_t>(1U);
+            patch.twoWay = patchConf["twoWay"].as<bool>(false);
+
+            if (patch.name.empty()) {
+                patch.name = std::to_string(patch.srcTGId) + "-" + std::to_string(patch.dstTGId);
+            }
 
-    std::string address = networkConf["address"].as<std::string>();
-    uint16_t port = (uint16_t)networkConf["port"].as<uint32_t>(TRAFFIC_DEFAULT_PORT);
-    uint16_t local = (uint16_t)networkConf["local"].as<uint32_t>(0U);
-    uint32_t id = networkConf["id"].as<uint32_t>(1000U);
-    std::string password = networkConf["password"].as<std::string>();
-    bool allowDiagnosticTransfer = networkConf["allowDiagnosticTransfer"].as<bool>(false);
-    bool debug = networkConf["debug"].as<bool>(false);
+            m_patches.push_back(patch);
+        }
+    }
+    else {
+        // legacy single patch configuration
+        yaml::Node networkConf = m_conf["network"];
+
+        PatchEntry patch;
+        patch.srcTGId = (uint32_t)networkConf["sourceTGID"].as<uint32_t>(1U);
+        patch.srcSlot = (uint8_t)networkConf["sourceSlot"].as<uint32_t>(1U);
+        patch.dstTGId = (uint32_t)networkConf["destinationTGID"].as<uint32_t>(1U);
+        patch.dstSlot = (uint8_t)networkConf["destinationSlot"].as<uint32_t>(1U);
+        patch.twoWay = networkConf["twoWay"].as<bool>(false);
+        patch.name = std::to_string(patch.srcTGId) + "-" + std::to_string(patch.dstTGId);
+
+        m_patches.push_back(patch);
+    }
 
-    m_srcTGId = (uint32_t)networkConf["sourceTGID"].as<uint32_t>(1U);
-    m_srcSlot = (uint8_t)networkConf["sourceSlot"].as<uint32_t>(1U);
-    m_dstTGId = (uint32_t)networkConf["destinationTGID"].as<uint32_t>(1U);
-    m_dstSlot = (uint8_t)networkConf["destinationSlot"].as<uint32_t>(1U);
-    m_twoWayPatch = networkConf["twoWay"].as<bool>(false);
+    LogInfo("Patch Parameters");
+    LogInfo("    Patches: %u", (uint32_t)m_patches.size());
 
-    // make sure our destination ID is sane
-    if (m_srcTGId == 0U) {
-        ::LogError(LOG_HOST, "Patch source TGID cannot be set to 0.");
+    if (!m_routes.build(m_patches, m_digiMode))
         return false;
+
+    for (const PatchEntry& patch : m_patches) {
+        if (m_digiMode == TX_MODE_DMR) {
+            LogInfo("    %s: TG %u (slot %u) %s TG %u (slot %u)", patch.name.c_str(), patch.srcTGId, patch.srcSlot,
+                patch.twoWay ? "<->" : "->", patch.dstTGId, patch.dstSlot);
+        }
+        else {
+            LogInfo("    %s: TG %u %s TG %u", patch.name.c_str(), patch.srcTGId, patch.twoWay ? "<->" : "->", patch.dstTGId);
+        }
     }
 
-    if (m_dstTGId == 0U) {
-        ::LogError(LOG_HOST, "Patch destination TGID cannot be set to 0.");
-        return false;
+    // every route has its own call table entry
+    for (const PatchRoute& route : m_routes.routes()) {
+        PatchCall call = PatchCall();
+        call.patchIdx = route.patchIdx;
+        call.tgId = route.tgId;
+        call.slot = route.slot;
+        m_calls.push_back(call);
     }
 
-    if (m_srcTGId == m_dstTGId) {
-        ::LogError(LOG_HOST, "Patch source TGID and destination TGID cannot be the same.");
-        return false;
+    if (m_digiMode == TX_MODE_DMR) {
+        m_dmrEmbeddedData.resize(m_calls.size());
     }
 
-    // make sure we're range checked
-    switch (m_digiMode) {
-    case TX_MODE_DMR:
-        {
-            if (m_srcTGId > 16777215) {
-                ::LogError(LOG_HOST, "Patch source TGID cannot be greater than 16777215.");
-                return false;
-            }
+    return true;
+}
 
-            if (m_dstTGId > 16777215) {
-                ::LogError(LOG_HOST, "Patch source TGID cannot be greater than 16777215.");
-                return false;
-            }
-        }
-        break;
-    case TX_MODE_P25:
-        {
-            if (m_srcTGId > 65535) {
-                ::LogError(LOG_HOST, "Patch source TGID cannot be greater than 65535.");
-                return false;
-            }
+/* Initializes network connectivity. */
 
-            if (m_dstTGId > 65535) {
-                ::LogError(LOG_HOST, "Patch destination TGID cannot be greater than 65535.");
-                return false;
-            }
-        }
-        break;
-    }
+bool HostPatch::createNetwork()
+{
+    yaml::Node networkConf = m_conf["network"];
+
+    std::string address = networkConf["address"].as<std::string>();
+    uint16_t port = (uint16_t)networkConf["port"].as<uint32_t>(TRAFFIC_DEFAULT_PORT);
+    uint16_t local = (uint16_t)networkConf["local"].as<uint32_t>(0U);
+    uint32_t id = networkConf["id"].as<uint32_t>(1000U);
+    std::string password = networkConf["password"].as<std::string>();
+    bool allowDiagnosticTransfer = networkConf["allowDiagnosticTransfer"].as<bool>(false);
+    bool debug = networkConf["debug"].as<bool>(false);
 
     bool encrypted = networkConf["encrypted"].as<bool>(false);
     std::string key = networkConf["presharedKey"].as<std::string>();
@@ -357,12 +377,6 @@ bool HostPatch::createNetwork()
 
     LogInfo("    Encrypted: %s", encrypted ? "yes" : "no");
 
-    LogInfo("    Source TGID: %u", m_srcTGId);
-    LogInfo("    Source DMR Slot: %u", m_srcSlot);
-    LogInfo("    Destination TGID: %u", m_dstTGId);
-    LogInfo("    Destination DMR Slot: %u", m_dstSlot);
-    LogInfo("    Two-Way Patch: %s", m_twoWayPatch ? "yes" : "no");
-
     if (debug) {
         LogInfo("    Debug: yes");
     }
@@ -403,7 +417,7 @@ bool HostPatch::createNetwork()
 
 /* Helper to process DMR network traffic. */
 
-void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
+void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length, uint32_t streamId)
 {
     assert(buffer != nullptr);
     using namespace dmr;
@@ -474,35 +488,29 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
         if (srcId == 0)
             return;
 
-        // ensure destination ID matches and slot matches
-        if (dstId != m_srcTGId && dstId != m_dstTGId)
-            return;
-        if (slotNo != m_srcSlot && slotNo != m_dstSlot)
+        // ensure destination ID and slot are patched
+        uint32_t callIdx = 0U;
+        if (!m_routes.find(dstId, (uint8_t)slotNo, callIdx))
             return;
 
-        uint32_t actualDstId = m_dstTGId;
-        if (m_twoWayPatch) {
-            if (dstId == m_dstTGId)
-                actualDstId = m_srcTGId;
-        } else {
-            if (dstId == m_dstTGId)
-                return;
-        }
+        PatchCall& call = m_calls[callIdx];
+        const PatchEntry& patch = m_patches[call.patchIdx];
+        data::EmbeddedData& embeddedData = m_dmrEmbeddedData[callIdx];
 
-        // is this a new call stream?
-        if (m_network->getDMRStreamId(slotNo) != m_rxStreamId) {
-            m_callInProgress = true;
+        uint32_t actualDstId = call.tgId;
 
+        // is this a new call stream?
+        if (streamId != call.rxStreamId) {
             uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-            m_rxStartTime = now;
+            call.rxStartTime = now;
 
-            LogMessage(LOG_HOST, "DMR, call start, srcId = %u, dstId = %u, slot = %u", srcId, dstId, slotNo);
+            LogMessage(LOG_HOST, "DMR, call start, patch = %s, srcId = %u, dstId = %u, slot = %u", patch.name.c_str(), srcId, dstId, slotNo);
         }
 
         if (dataSync && (dataType == DataType::TERMINATOR_WITH_LC)) {
             // generate DMR network frame
             data::NetData dmrData;
-            dmrData.setSlotNo(m_dstSlot);
+            dmrData.setSlotNo(call.slot);
             dmrData.setDataType(DataType::TERMINATOR_WITH_LC);
             dmrData.setSrcId(srcId);
             dmrData.setDstId(actualDstId);
@@ -518,23 +526,22 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
 
             dmrData.setData(data.get());
 
-            m_network->writeDMRTerminator(dmrData, &seqNo, &n, m_dmrEmbeddedData);
-            m_network->resetDMR(dmrData.getSlotNo());
+            m_network->writeDMRTerminator(dmrData, &seqNo, &n, embeddedData, call.tx);
 
-            if (m_rxStartTime > 0U) {
+            if (call.rxStartTime > 0U) {
                 uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                uint64_t diff = now - m_rxStartTime;
+                uint64_t diff = now - call.rxStartTime;
 
-                LogMessage(LOG_HOST, "DMR, call end, srcId = %u, dstId = %u, dur = %us", srcId, dstId, diff / 1000U);
+                LogMessage(LOG_HOST, "DMR, call end, patch = %s, srcId = %u, dstId = %u, dur = %us", patch.name.c_str(), srcId, dstId, diff / 1000U);
             }
 
-            m_callInProgress = false;
-            m_rxStartTime = 0U;
-            m_rxStreamId = 0U;
+            call.rxStartTime = 0U;
+            call.rxStreamId = 0U;
+            call.tx.streamId = 0U;
             return;
         }
 
-        m_rxStreamId = m_network->getDMRStreamId(slotNo);
+        call.rxStreamId = streamId;
 
         uint8_t* buffer = nullptr;
 
@@ -544,14 +551,14 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
             lc::FullLC fullLC = lc::FullLC();
             lc = *fullLC.decode(data.get(), DataType::VOICE_LC_HEADER);
 
-            LogMessage(LOG_HOST, DMR_DT_VOICE_LC_HEADER ", slot = %u, srcId = %u, dstId = %u, FLCO = $%02X", m_srcSlot,
+            LogMessage(LOG_HOST, DMR_DT_VOICE_LC_HEADER ", slot = %u, srcId = %u, dstId = %u, FLCO = $%02X", slotNo,
                 lc.getSrcId(), lc.getDstId(), flco);
 
             // send DMR voice header
             buffer = new uint8_t[DMR_FRAME_LENGTH_BYTES];
 
             lc.setDstId(actualDstId);
-            m_dmrEmbeddedData.setLC(lc);
+            embeddedData.setLC(lc);
 
             // generate the Slot TYpe
             SlotType slotType = SlotType();
@@ -562,7 +569,7 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
 
             // generate DMR network frame
             data::NetData dmrData;
-            dmrData.setSlotNo(m_dstSlot);
+            dmrData.setSlotNo(call.slot);
             dmrData.setDataType(DataType::VOICE_LC_HEADER);
             dmrData.setSrcId(srcId);
             dmrData.setDstId(actualDstId);
@@ -583,7 +590,7 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
 
             dmrData.setData(buffer);
 
-            m_network->writeDMR(dmrData, false);
+            m_network->writeDMR(dmrData, call.tx);
             delete[] buffer;
         }
 
@@ -593,7 +600,7 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
             lc::FullLC fullLC = lc::FullLC();
             lc = *fullLC.decodePI(data.get());
 
-            LogMessage(LOG_HOST, DMR_DT_VOICE_PI_HEADER ", slot = %u, algId = %u, kId = %u, dstId = %u", m_srcSlot,
+            LogMessage(LOG_HOST, DMR_DT_VOICE_PI_HEADER ", slot = %u, algId = %u, kId = %u, dstId = %u", slotNo,
                 lc.getAlgId(), lc.getKId(), lc.getDstId());
 
             // send DMR voice header
@@ -610,7 +617,7 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
 
             // generate DMR network frame
             data::NetData dmrData;
-            dmrData.setSlotNo(m_dstSlot);
+            dmrData.setSlotNo(call.slot);
             dmrData.setDataType(DataType::VOICE_PI_HEADER);
             dmrData.setSrcId(srcId);
             dmrData.setDstId(actualDstId);
@@ -631,7 +638,7 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
 
             dmrData.setData(buffer);
 
-            m_network->writeDMR(dmrData, false);
+            m_network->writeDMR(dmrData, call.tx);
             delete[] buffer;
         }
 
@@ -648,7 +655,7 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
             else {
                 dataType = DataType::VOICE;
 
-                uint8_t lcss = m_dmrEmbeddedData.getData(buffer, n);
+                uint8_t lcss = embeddedData.getData(buffer, n);
 
                 // generated embedded signalling
                 data::EMB emb = data::EMB();
@@ -657,11 +664,11 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
                 emb.encode(buffer);
             }
 
-            LogMessage(LOG_HOST, DMR_DT_VOICE ", srcId = %u, dstId = %u, slot = %u, seqNo = %u", srcId, dstId, m_srcSlot, seqNo);
+            LogMessage(LOG_HOST, DMR_DT_VOICE ", srcId = %u, dstId = %u, slot = %u, seqNo = %u", srcId, dstId, slotNo, seqNo);
 
             // generate DMR network frame
             data::NetData dmrData;
-            dmrData.setSlotNo(m_dstSlot);
+            dmrData.setSlotNo(call.slot);
             dmrData.setDataType(dataType);
             dmrData.setSrcId(srcId);
             dmrData.setDstId(actualDstId);
@@ -673,14 +680,14 @@ void HostPatch::processDMRNetwork(uint8_t* buffer, uint32_t length)
 
             dmrData.setData(buffer);
 
-            m_network->writeDMR(dmrData, false);
+            m_network->writeDMR(dmrData, call.tx);
         }
     }
 }
 
 /* Helper to process P25 network traffic. */
 
-void HostPatch::processP25Network(uint8_t* buffer, uint32_t length)
+void HostPatch::processP25Network(uint8_t* buffer, uint32_t length, uint32_t streamId)
 {
     assert(buffer != nullptr);
     using namespace p25;
@@ -757,26 +764,22 @@ void HostPatch::processP25Network(uint8_t* buffer, uint32_t length)
         if (srcId == 0)
             return;
 
-        // ensure destination ID matches
-        if (dstId != m_srcTGId && dstId != m_dstTGId)
+        // ensure destination ID is patched
+        uint32_t callIdx = 0U;
+        if (!m_routes.find(dstId, 0U, callIdx))
             return;
 
-        uint32_t actualDstId = m_dstTGId;
-        if (m_twoWayPatch) {
-            if (dstId == m_dstTGId)
-                actualDstId = m_srcTGId;
-        } else {
-            if (dstId == m_dstTGId)
-                return;
-        }
+        PatchCall& call = m_calls[callIdx];
+        const PatchEntry& patch = m_patches[call.patchIdx];
 
-        if (m_network->getP25StreamId() != m_rxStreamId && ((duid != DUID::TDU) && (duid != DUID::TDULC))) {
-            m_callInProgress = true;
+        uint32_t actualDstId = call.tgId;
 
+        if (streamId != call.rxStreamId && ((duid != DUID::TDU) && (duid != DUID::TDULC))) {
             uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-            m_rxStartTime = now;
+            call.rxStartTime = now;
+            call.tx.streamId = 0U;
 
-            LogMessage(LOG_HOST, "P25, call start, srcId = %u, dstId = %u", srcId, dstId);
+            LogMessage(LOG_HOST, "P25, call start, patch = %s, srcId = %u, dstId = %u", patch.name.c_str(), srcId, dstId);
 
             if (m_grantDemand) {
                 p25::lc::LC lc = p25::lc::LC();
@@ -787,7 +790,7 @@ void HostPatch::processP25Network(uint8_t* buffer, uint32_t length)
                 p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
 
                 uint8_t controlByte = 0x80U;
-                m_network->writeP25TDU(lc, lsd, controlByte);
+                m_network->writeP25TDU(lc, lsd, controlByte, call.tx);
             }
         }
 
@@ -806,25 +809,22 @@ void HostPatch::processP25Network(uint8_t* buffer, uint32_t length)
             LogMessage(LOG_HOST, P25_TDU_STR);
 
             uint8_t controlByte = 0x00U;
-            m_network->writeP25TDU(lc, lsd, controlByte);
+            m_network->writeP25TDU(lc, lsd, controlByte, call.tx);
 
-            if (m_rxStartTime > 0U) {
+            if (call.rxStartTime > 0U) {
                 uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-                uint64_t diff = now - m_rxStartTime;
+                uint64_t diff = now - call.rxStartTime;
 
-                LogMessage(LOG_HOST, "P25, call end, srcId = %u, dstId = %u, dur = %us", srcId, dstId, diff / 1000U);
+                LogMessage(LOG_HOST, "P25, call end, patch = %s, srcId = %u, dstId = %u, dur = %us", patch.name.c_str(), srcId, dstId, diff / 1000U);
             }
 
-            m_rxStartTime = 0U;
-            m_rxStreamId = 0U;
-
-            m_callInProgress = false;
-            m_rxStartTime = 0U;
-            m_rxStreamId = 0U;
+            call.rxStartTime = 0U;
+            call.rxStreamId = 0U;
+            call.tx.streamId = 0U;
             return;
         }
 
-        m_rxStreamId = m_network->getP25StreamId();
+        call.rxStreamId = streamId;
 
         uint8_t* netLDU = new uint8_t[9U * 25U];
         ::memset(netLDU, 0x00U, 9U * 25U);
@@ -902,7 +902,7 @@ void HostPatch::processP25Network(uint8_t* buffer, uint32_t length)
                     }
                 }
 
-                m_network->writeP25LDU1(control, lsd, netLDU, frameType);
+                m_network->writeP25LDU1(control, lsd, netLDU, frameType, call.tx);
             }
             break;
         case DUID::LDU2:
@@ -957,7 +957,7 @@ void HostPatch::processP25Network(uint8_t* buffer, uint32_t length)
                 control.setSrcId(srcId);
                 control.setDstId(actualDstId);
 
-                m_network->writeP25LDU2(control, lsd, netLDU);
+                m_network->writeP25LDU2(control, lsd, netLDU, call.tx);
             }
             break;
 
@@ -1010,21 +1010,22 @@ void* HostPatch::threadNetworkProcess(void* arg)
                 continue;
             }
 
-            uint32_t length = 0U;
-            bool netReadRet = false;
-            if (patch->m_digiMode == TX_MODE_DMR) {
+            // drain every queued frame, the queue is shared by all patches
+            while (!g_killed) {
+                uint32_t length = 0U, streamId = 0U;
+                uint8_t subFunc = 0U;
+                bool netReadRet = false;
+                UInt8Array buffer = patch->m_network->readFrame(netReadRet, length, subFunc, streamId);
+                if (!netReadRet)
+                    break;
+
                 std::lock_guard<std::mutex> lock(HostPatch::m_networkMutex);
-                UInt8Array dmrBuffer = patch->m_network->readDMR(netReadRet, length);
-                if (netReadRet) {
-                    patch->processDMRNetwork(dmrBuffer.get(), length);
+                if (patch->m_digiMode == TX_MODE_DMR && subFunc == NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR) {
+                    patch->processDMRNetwork(buffer.get(), length, streamId);
                 }
-            }
 
-            if (patch->m_digiMode == TX_MODE_P25) {
-                std::lock_guard<std::mutex> lock(HostPatch::m_networkMutex);
-                UInt8Array p25Buffer = patch->m_network->readP25(netReadRet, length);
-                if (netReadRet) {
-                    patch->processP25Network(p25Buffer.get(), length);
+                if (patch->m_digiMode == TX_MODE_P25 && subFunc == NET_SUBFUNC::PROTOCOL_SUBFUNC_P25) {
+                    patch->processP25Network(buffer.get(), length, streamId);
                 }
             }
 
@@ -24,16 +24,30 @@
 #include "common/yaml/Yaml.h"
 #include "common/Timer.h"
 #include "network/PeerNetwork.h"
+#include "PatchRouteTable.h"
 
 #include <string>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 // ---------------------------------------------------------------------------
-//  Constants
+//  Structure Declaration
 // ---------------------------------------------------------------------------
 
-const uint8_t TX_MODE_DMR = 1U;
-const uint8_t TX_MODE_P25 = 2U;
+/**
+ * @brief Represents the state of calls patched in one direction of a talkgroup patch.
+ * @ingroup patch
+ */
+struct PatchCall {
+    uint32_t patchIdx;          //! Index of the patch in the patch table.
+    uint32_t tgId;              //! Talkgroup ID calls are patched to.
+    uint8_t slot;               //! DMR slot calls are patched to.
+
+    uint32_t rxStreamId;        //! Stream ID of the call being received (0 if no call is in progress).
+    uint64_t rxStartTime;       //! Time the call being received started.
+    network::TxStream tx;       //! State of the call stream being transmitted.
+};
 
 // ---------------------------------------------------------------------------
 //  Class Declaration
@@ -67,24 +81,17 @@ private:
 
     network::PeerNetwork* m_network;
 
-    uint32_t m_srcTGId;
-    uint8_t m_srcSlot;
-    uint32_t m_dstTGId;
-    uint8_t m_dstSlot;
-    bool m_twoWayPatch;
+    std::vector<PatchEntry> m_patches;
+    std::vector<PatchCall> m_calls;
+    std::vector<dmr::data::EmbeddedData> m_dmrEmbeddedData;
+    PatchRouteTable m_routes;
 
     std::string m_identity;
 
     uint8_t m_digiMode;
 
-    dmr::data::EmbeddedData m_dmrEmbeddedData;
-
     bool m_grantDemand;
 
-    bool m_callInProgress;
-    uint64_t m_rxStartTime;
-    uint32_t m_rxStreamId;
-
     bool m_running;
     bool m_trace;
     bool m_debug;
@@ -96,6 +103,11 @@ private:
      * @returns bool True, if configuration was read successfully, otherwise false.
      */
     bool readParams();
+    /**
+     * @brief Reads the talkgroup patches from the configuration, and builds the routing table.
+     * @returns bool True, if the patches were read successfully, otherwise false.
+     */
+    bool createPatches();
     /**
      * @brief Initializes network connectivity.
      * @returns bool True, if network connectivity was initialized, otherwise false.
@@ -106,15 +118,17 @@ private:
      * @brief Helper to process DMR network traffic.
      * @param buffer 
      * @param length 
+     * @param streamId Stream ID the traffic was received with.
      */
-    void processDMRNetwork(uint8_t* buffer, uint32_t length);
+    void processDMRNetwork(uint8_t* buffer, uint32_t length, uint32_t streamId);
 
     /**
      * @brief Helper to process P25 network traffic.
      * @param buffer 
      * @param length 
+     * @param streamId Stream ID the traffic was received with.
      */
-    void processP25Network(uint8_t* buffer, uint32_t length);
+    void processP25Network(uint8_t* buffer, uint32_t length, uint32_t streamId);
 
     /**
      * @brief Entry point to network processing thread.
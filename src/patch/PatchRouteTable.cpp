@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - TG Patch
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "PatchRouteTable.h"
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the PatchRouteTable class. */
+
+PatchRouteTable::PatchRouteTable() :
+    m_routes(),
+    m_keys()
+{
+    /* stub */
+}
+
+/* Validates the talkgroup patches, and builds the routing table. */
+
+bool PatchRouteTable::build(const std::vector<PatchEntry>& patches, uint8_t digiMode)
+{
+    m_routes.clear();
+    m_keys.clear();
+
+    for (uint32_t i = 0U; i < patches.size(); i++) {
+        const PatchEntry& patch = patches[i];
+
+        // make sure our destination ID is sane
+        if (patch.srcTGId == 0U) {
+            ::LogError(LOG_HOST, "Patch %s, source TGID cannot be set to 0.", patch.name.c_str());
+            return false;
+        }
+
+        if (patch.dstTGId == 0U) {
+            ::LogError(LOG_HOST, "Patch %s, destination TGID cannot be set to 0.", patch.name.c_str());
+            return false;
+        }
+
+        if (patch.srcTGId == patch.dstTGId) {
+            ::LogError(LOG_HOST, "Patch %s, source TGID and destination TGID cannot be the same.", patch.name.c_str());
+            return false;
+        }
+
+        // make sure we're range checked
+        uint8_t srcSlot = 0U, dstSlot = 0U;
+        switch (digiMode) {
+        case TX_MODE_DMR:
+            {
+                if (patch.srcTGId > 16777215) {
+                    ::LogError(LOG_HOST, "Patch %s, source TGID cannot be greater than 16777215.", patch.name.c_str());
+                    return false;
+                }
+
+                if (patch.dstTGId > 16777215) {
+                    ::LogError(LOG_HOST, "Patch %s, destination TGID cannot be greater than 16777215.", patch.name.c_str());
+                    return false;
+                }
+
+                if (patch.srcSlot < 1U || patch.srcSlot > 2U || patch.dstSlot < 1U || patch.dstSlot > 2U) {
+                    ::LogError(LOG_HOST, "Patch %s, DMR slots must be 1 or 2.", patch.name.c_str());
+                    return false;
+                }
+
+                srcSlot = patch.srcSlot;
+                dstSlot = patch.dstSlot;
+            }
+            break;
+        case TX_MODE_P25:
+            {
+                if (patch.srcTGId > 65535) {
+                    ::LogError(LOG_HOST, "Patch %s, source TGID cannot be greater than 65535.", patch.name.c_str());
+                    return false;
+                }
+
+                if (patch.dstTGId > 65535) {
+                    ::LogError(LOG_HOST, "Patch %s, destination TGID cannot be greater than 65535.", patch.name.c_str());
+                    return false;
+                }
+            }
+            break;
+        }
+
+        if (!addRoute(patches, patch.srcTGId, srcSlot, i, patch.dstTGId, dstSlot))
+            return false;
+        if (patch.twoWay) {
+            if (!addRoute(patches, patch.dstTGId, dstSlot, i, patch.srcTGId, srcSlot))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to add a route from a talkgroup. */
+
+bool PatchRouteTable::addRoute(const std::vector<PatchEntry>& patches, uint32_t tgId, uint8_t slot, uint32_t patchIdx, uint32_t dstTGId, uint8_t dstSlot)
+{
+    uint32_t key = routeKey(tgId, slot);
+
+    // a talkgroup can only be patched by a single patch, otherwise calls would be ambiguous
+    auto it = m_keys.find(key);
+    if (it != m_keys.end()) {
+        const PatchEntry& other = patches[m_routes[it->second].patchIdx];
+        ::LogError(LOG_HOST, "Patch %s, TGID %u is already patched by patch %s.", patches[patchIdx].name.c_str(), tgId,
+            other.name.c_str());
+        return false;
+    }
+
+    PatchRoute route = PatchRoute();
+    route.patchIdx = patchIdx;
+    route.tgId = dstTGId;
+    route.slot = dstSlot;
+
+    m_keys[key] = (uint32_t)m_routes.size();
+    m_routes.push_back(route);
+    return true;
+}
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - TG Patch
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PatchRouteTable.h
+ * @ingroup patch
+ * @file PatchRouteTable.cpp
+ * @ingroup patch
+ */
+#if !defined(__PATCH_ROUTE_TABLE_H__)
+#define __PATCH_ROUTE_TABLE_H__
+
+#include "Defines.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t TX_MODE_DMR = 1U;
+const uint8_t TX_MODE_P25 = 2U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a talkgroup patch.
+ * @ingroup patch
+ */
+struct PatchEntry {
+    std::string name;           //! Textual name of the patch.
+
+    uint32_t srcTGId;           //! Source talkgroup ID.
+    uint8_t srcSlot;            //! Source DMR slot.
+    uint32_t dstTGId;           //! Destination talkgroup ID.
+    uint8_t dstSlot;            //! Destination DMR slot.
+    bool twoWay;                //! Flag indicating whether or not the patch is two-way.
+};
+
+/**
+ * @brief Represents one direction of a talkgroup patch.
+ * @ingroup patch
+ */
+struct PatchRoute {
+    uint32_t patchIdx;          //! Index of the patch in the patch table.
+    uint32_t tgId;              //! Talkgroup ID calls are patched to.
+    uint8_t slot;               //! DMR slot calls are patched to.
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements the table used to route calls on a talkgroup to the patch (direction) it belongs to.
+ * @ingroup patch
+ */
+class HOST_SW_API PatchRouteTable {
+public:
+    /**
+     * @brief Initializes a new instance of the PatchRouteTable class.
+     */
+    PatchRouteTable();
+
+    /**
+     * @brief Validates the talkgroup patches, and builds the routing table.
+     * @note Every direction of every patch is given an index into the routing table, in the order the patches
+     *  are given. A talkgroup can only be patched once.
+     * @param patches Talkgroup patches.
+     * @param digiMode Digital mode (TX_MODE_DMR or TX_MODE_P25).
+     * @returns bool True, if the routing table was built, otherwise false.
+     */
+    bool build(const std::vector<PatchEntry>& patches, uint8_t digiMode);
+
+    /**
+     * @brief Finds the route for a talkgroup.
+     * @param tgId Talkgroup ID.
+     * @param slot DMR slot (0 for P25).
+     * @param[out] routeIdx Index of the route.
+     * @returns bool True, if the talkgroup is patched, otherwise false.
+     */
+    bool find(uint32_t tgId, uint8_t slot, uint32_t& routeIdx) const
+    {
+        auto it = m_keys.find(routeKey(tgId, slot));
+        if (it == m_keys.end())
+            return false;
+
+        routeIdx = it->second;
+        return true;
+    }
+
+    /**
+     * @brief Gets the routes, in routing table index order.
+     * @returns std::vector<PatchRoute> Routes.
+     */
+    const std::vector<PatchRoute>& routes() const { return m_routes; }
+
+    /**
+     * @brief Helper to generate the routing table key for a talkgroup.
+     * @param tgId Talkgroup ID.
+     * @param slot DMR slot (0 for P25).
+     * @returns uint32_t Routing table key.
+     */
+    static uint32_t routeKey(uint32_t tgId, uint8_t slot) { return ((uint32_t)slot << 24) | (tgId & 0xFFFFFFU); }
+
+private:
+    std::vector<PatchRoute> m_routes;
+    std::unordered_map<uint32_t, uint32_t> m_keys;
+
+    /**
+     * @brief Helper to add a route from a talkgroup.
+     * @param patches Talkgroup patches.
+     * @param tgId Talkgroup ID the route is for.
+     * @param slot DMR slot the route is for.
+     * @param patchIdx Index of the patch in the patch table.
+     * @param dstTGId Talkgroup ID calls are patched to.
+     * @param dstSlot DMR slot calls are patched to.
+     * @returns bool True, if the route was added, otherwise false.
+     */
+    bool addRoute(const std::vector<PatchEntry>& patches, uint32_t tgId, uint8_t slot, uint32_t patchIdx, uint32_t dstTGId, uint8_t dstSlot);
+};
+
+#endif // __PATCH_ROUTE_TABLE_H__
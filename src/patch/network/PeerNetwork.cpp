@@ -21,6 +21,13 @@ using namespace network;
 
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t RX_FRAME_QUEUE_LEN = 65536U;
+const uint32_t RX_FRAME_HEADER_LEN = 5U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -29,11 +36,127 @@ using namespace network;
 
 PeerNetwork::PeerNetwork(const std::string& address, uint16_t port, uint16_t localPort, uint32_t peerId, const std::string& password,
     bool duplex, bool debug, bool dmr, bool p25, bool nxdn, bool slot1, bool slot2, bool allowActivityTransfer, bool allowDiagnosticTransfer, bool updateLookup, bool saveLookup) :
-    Network(address, port, localPort, peerId, password, duplex, debug, dmr, p25, nxdn, slot1, slot2, allowActivityTransfer, allowDiagnosticTransfer, updateLookup, saveLookup)
+    Network(address, port, localPort, peerId, password, duplex, debug, dmr, p25, nxdn, slot1, slot2, allowActivityTransfer, allowDiagnosticTransfer, updateLookup, saveLookup),
+    m_rxFrames(RX_FRAME_QUEUE_LEN, "Patch Net Frames")
 {
     assert(!address.empty());
     assert(port > 0U);
     assert(!password.empty());
+
+    // protocol frames are queued along with their stream ID, so many call streams can be patched at once
+    m_userHandleProtocol = true;
+}
+
+/* Reads a protocol frame from the network receive queue. */
+
+UInt8Array PeerNetwork::readFrame(bool& ret, uint32_t& length, uint8_t& subFunc, uint32_t& streamId)
+{
+    ret = false;
+    length = 0U;
+
+    uint32_t recordLength = m_rxFrames.peekRecordLength();
+    if (recordLength <= RX_FRAME_HEADER_LEN) {
+        if (recordLength > 0U)
+            m_rxFrames.skipRecord();
+        return nullptr;
+    }
+
+    UInt8Array record = std::unique_ptr<uint8_t[]>(new uint8_t[recordLength]);
+    if (m_rxFrames.getRecord(record.get(), recordLength) != recordLength)
+        return nullptr;
+
+    subFunc = record[0U];
+    streamId = GET_UINT32(record, 1U);
+
+    length = recordLength - RX_FRAME_HEADER_LEN;
+    UInt8Array buffer = std::unique_ptr<uint8_t[]>(new uint8_t[length]);
+    ::memcpy(buffer.get(), record.get() + RX_FRAME_HEADER_LEN, length);
+
+    ret = true;
+    return buffer;
+}
+
+/* Writes DMR frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeDMR(const dmr::data::NetData& data, TxStream& stream)
+{
+    using namespace dmr::defines;
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    uint32_t slotNo = data.getSlotNo();
+
+    // individual slot disabling
+    if (slotNo == 1U && !m_slot1)
+        return false;
+    if (slotNo == 2U && !m_slot2)
+        return false;
+
+    DataType::E dataType = data.getDataType();
+    uint16_t seq = streamSeq(stream, dataType == DataType::VOICE_LC_HEADER);
+    if (dataType == DataType::TERMINATOR_WITH_LC) {
+        seq = RTP_END_OF_CALL_SEQ;
+    }
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createDMR_Message(messageLength, stream.streamId, data);
+    if (message == nullptr) {
+        return false;
+    }
+
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, seq, stream.streamId);
+}
+
+/* Writes P25 LDU1 frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeP25LDU1(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, 
+    p25::defines::FrameType::E frameType, TxStream& stream)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createP25_LDU1Message_Raw(messageLength, control, lsd, data, frameType);
+    if (message == nullptr) {
+        return false;
+    }
+
+    uint16_t seq = streamSeq(stream, false);
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, seq, stream.streamId);
+}
+
+/* Writes P25 LDU2 frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeP25LDU2(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, TxStream& stream)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createP25_LDU2Message_Raw(messageLength, control, lsd, data);
+    if (message == nullptr) {
+        return false;
+    }
+
+    uint16_t seq = streamSeq(stream, false);
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, seq, stream.streamId);
+}
+
+/* Writes P25 TDU frame data to the network, as part of the given call stream. */
+
+bool PeerNetwork::writeP25TDU(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t controlByte, TxStream& stream)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    uint32_t messageLength = 0U;
+    UInt8Array message = createP25_TDUMessage(messageLength, control, lsd, controlByte);
+    if (message == nullptr) {
+        return false;
+    }
+
+    streamSeq(stream, false);
+    return writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, RTP_END_OF_CALL_SEQ, stream.streamId);
 }
 
 /* Writes P25 LDU1 frame data to the network. */
@@ -141,10 +264,103 @@ void PeerNetwork::writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo,
     dmrN = 0;
 }
 
+/* Helper to send a DMR terminator with LC message, as part of the given call stream. */
+
+void PeerNetwork::writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo, uint8_t* dmrN, dmr::data::EmbeddedData& embeddedData, 
+    TxStream& stream)
+{
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    uint8_t n = (uint8_t)((*seqNo - 3U) % 6U);
+    uint32_t fill = 6U - n;
+
+    uint8_t buffer[DMR_FRAME_LENGTH_BYTES];
+    if (n > 0U) {
+        for (uint32_t i = 0U; i < fill; i++) {
+            // generate DMR AMBE data
+            ::memcpy(buffer, SILENCE_DATA, DMR_FRAME_LENGTH_BYTES);
+
+            uint8_t lcss = embeddedData.getData(buffer, n);
+
+            // generated embedded signalling
+            data::EMB emb = data::EMB();
+            emb.setColorCode(0U);
+            emb.setLCSS(lcss);
+            emb.encode(buffer);
+
+            // generate DMR network frame
+            data.setData(buffer);
+
+            writeDMR(data, stream);
+        }
+    }
+
+    ::memset(buffer, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+    // generate DMR LC
+    lc::LC dmrLC = lc::LC();
+    dmrLC.setFLCO(FLCO::GROUP);
+    dmrLC.setSrcId(data.getSrcId());
+    dmrLC.setDstId(data.getDstId());
+
+    // generate the Slot Type
+    SlotType slotType = SlotType();
+    slotType.setDataType(DataType::TERMINATOR_WITH_LC);
+    slotType.encode(buffer);
+
+    lc::FullLC fullLC = lc::FullLC();
+    fullLC.encode(dmrLC, buffer, DataType::TERMINATOR_WITH_LC);
+
+    // generate DMR network frame
+    data.setData(buffer);
+
+    writeDMR(data, stream);
+
+    *seqNo = 0U;
+    *dmrN = 0U;
+}
+
 // ---------------------------------------------------------------------------
 //  Protected Class Members
 // ---------------------------------------------------------------------------
 
+/* User overrideable handler that allows user code to process network packets not handled by this class. */
+
+void PeerNetwork::userPacketHandler(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, uint32_t streamId)
+{
+    if (opcode.first != NET_FUNC::PROTOCOL) {
+        Network::userPacketHandler(peerId, opcode, data, length, streamId);
+        return;
+    }
+
+    if (!m_enabled || data == nullptr || length == 0U)
+        return;
+
+    switch (opcode.second) {
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR:
+        if (!m_dmrEnabled)
+            return;
+        break;
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_P25:
+        if (!m_p25Enabled)
+            return;
+        break;
+    default:
+        return;
+    }
+
+    if (m_debug) {
+        LogDebug(LOG_NET, "Protocol, subFunc = $%02X, peer = %u, len = %u, streamId = %u", opcode.second, peerId, length, streamId);
+    }
+
+    uint8_t header[RX_FRAME_HEADER_LEN];
+    header[0U] = opcode.second;
+    SET_UINT32(streamId, header, 1U);
+
+    m_rxFrames.addRecord(header, RX_FRAME_HEADER_LEN, data, length);
+}
+
 /* Writes configuration to the network. */
 
 bool PeerNetwork::writeConfig()
@@ -208,6 +424,24 @@ bool PeerNetwork::writeConfig()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/* Helper to get the next RTP packet sequence for the given call stream. */
+
+uint16_t PeerNetwork::streamSeq(TxStream& stream, bool newStream)
+{
+    if (newStream || stream.streamId == 0U) {
+        stream.streamId = createStreamId();
+        stream.pktSeq = 0U;
+    }
+
+    uint16_t curr = stream.pktSeq;
+    ++stream.pktSeq;
+    if (stream.pktSeq > (RTP_END_OF_CALL_SEQ - 1U)) {
+        stream.pktSeq = 0U;
+    }
+
+    return curr;
+}
+
 /* Creates an P25 LDU1 frame message. */
 
 UInt8Array PeerNetwork::createP25_LDU1Message_Raw(uint32_t& length, const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, 
@@ -21,6 +21,7 @@
 #define __PEER_NETWORK_H__
 
 #include "Defines.h"
+#include "common/concurrent/spsc_ring_buffer.h"
 #include "common/dmr/data/EmbeddedData.h"
 #include "common/network/Network.h"
 
@@ -29,6 +30,19 @@
 
 namespace network
 {
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the state of a call stream being transmitted to the network.
+     * @ingroup patch_network
+     */
+    struct TxStream {
+        uint32_t streamId;      //! Stream ID (0 if no stream is active).
+        uint16_t pktSeq;        //! Next RTP packet sequence.
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     //      Implements the core peer networking logic.
@@ -57,6 +71,57 @@ namespace network
         PeerNetwork(const std::string& address, uint16_t port, uint16_t localPort, uint32_t peerId, const std::string& password,
             bool duplex, bool debug, bool dmr, bool p25, bool nxdn, bool slot1, bool slot2, bool allowActivityTransfer, bool allowDiagnosticTransfer, bool updateLookup, bool saveLookup);
 
+        /**
+         * @brief Reads a protocol frame from the network receive queue.
+         * 
+         *  Unlike readDMR() and readP25(), every frame is returned along with the stream ID it was received
+         *  with, this allows many simultaneous call streams to be told apart.
+         * 
+         * @param[out] ret Flag indicating whether or not a frame was read.
+         * @param[out] length Length of the frame.
+         * @param[out] subFunc Protocol subfunction of the frame.
+         * @param[out] streamId Stream ID of the frame.
+         * @returns UInt8Array Buffer containing the frame.
+         */
+        UInt8Array readFrame(bool& ret, uint32_t& length, uint8_t& subFunc, uint32_t& streamId);
+
+        /**
+         * @brief Writes DMR frame data to the network, as part of the given call stream.
+         * @param[in] data Instance of the dmr::data::NetData class containing the DMR message.
+         * @param stream Call stream state.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeDMR(const dmr::data::NetData& data, TxStream& stream);
+        /**
+         * @brief Writes P25 LDU1 frame data to the network, as part of the given call stream.
+         * @param[in] control Instance of p25::lc::LC containing link control data.
+         * @param[in] lsd Instance of p25::data::LowSpeedData containing low speed data.
+         * @param[in] data Buffer containing P25 LDU1 data to send.
+         * @param[in] frameType DVM P25 frame type.
+         * @param stream Call stream state.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeP25LDU1(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, 
+            p25::defines::FrameType::E frameType, TxStream& stream);
+        /**
+         * @brief Writes P25 LDU2 frame data to the network, as part of the given call stream.
+         * @param[in] control Instance of p25::lc::LC containing link control data.
+         * @param[in] lsd Instance of p25::data::LowSpeedData containing low speed data.
+         * @param[in] data Buffer containing P25 LDU2 data to send.
+         * @param stream Call stream state.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeP25LDU2(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t* data, TxStream& stream);
+        /**
+         * @brief Writes P25 TDU frame data to the network, as part of the given call stream.
+         * @param[in] control Instance of p25::lc::LC containing link control data.
+         * @param[in] lsd Instance of p25::data::LowSpeedData containing low speed data.
+         * @param[in] controlByte DVM Network Control Byte.
+         * @param stream Call stream state.
+         * @returns bool True, if message was sent, otherwise false.
+         */
+        bool writeP25TDU(const p25::lc::LC& control, const p25::data::LowSpeedData& lsd, const uint8_t controlByte, TxStream& stream);
+
         /**
          * @brief Writes P25 LDU1 frame data to the network.
          * @param[in] control Instance of p25::lc::LC containing link control data.
@@ -84,8 +149,32 @@ namespace network
          * @param embeddedData 
          */
         void writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo, uint8_t* dmrN, dmr::data::EmbeddedData& embeddedData);
+        /**
+         * @brief Helper to send a DMR terminator with LC message, as part of the given call stream.
+         * @param data 
+         * @param seqNo 
+         * @param dmrN 
+         * @param embeddedData 
+         * @param stream Call stream state.
+         */
+        void writeDMRTerminator(dmr::data::NetData& data, uint32_t* seqNo, uint8_t* dmrN, dmr::data::EmbeddedData& embeddedData, 
+            TxStream& stream);
+
+        using Network::writeDMR;
+        using Network::writeP25TDU;
 
     protected:
+        /**
+         * @brief User overrideable handler that allows user code to process network packets not handled by this class.
+         * @param peerId Peer ID.
+         * @param opcode FNE network opcode pair.
+         * @param[in] data Buffer containing message to send to peer.
+         * @param length Length of buffer.
+         * @param streamId Stream ID.
+         */
+        void userPacketHandler(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data = nullptr, uint32_t length = 0U,
+            uint32_t streamId = 0U) override;
+
         /**
          * @brief Writes configuration to the network.
          * @returns bool True, if configuration was sent, otherwise false.
@@ -93,6 +182,16 @@ namespace network
         bool writeConfig() override;
 
     private:
+        concurrent::spsc_ring_buffer<uint8_t> m_rxFrames;
+
+        /**
+         * @brief Helper to get the next RTP packet sequence for the given call stream.
+         * @param stream Call stream state.
+         * @param newStream Flag indicating a new stream ID should always be created.
+         * @returns uint16_t RTP packet sequence.
+         */
+        uint16_t streamSeq(TxStream& stream, bool newStream);
+
         /**
          * @brief Creates an P25 LDU1 frame message.
          * 
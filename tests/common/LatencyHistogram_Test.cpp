@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/LatencyHistogram.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <thread>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t HISTOGRAM_SAMPLES = 1000U;
+const uint32_t HISTOGRAM_THREADS = 4U;
+const uint32_t HISTOGRAM_SAMPLES_PER_THREAD = 50000U;
+
+TEST_CASE("LatencyHistogram", "[Histogram Test]") {
+    SECTION("LatencyHistogram_Bucket_Test") {
+        INFO("Latency Histogram Bucket Test");
+
+        // values below the first magnitude are counted exactly
+        for (uint64_t value = 0U; value < LATENCY_HISTOGRAM_SUB_BUCKETS * 2U; value++) {
+            uint32_t index = LatencyHistogram::bucketIndex(value);
+            REQUIRE(LatencyHistogram::bucketUpperBound(index) == value);
+        }
+
+        // every value falls in a bucket whose bounds contain it, and whose width is within the histogram precision
+        std::mt19937_64 rng(5150U);
+        uint32_t lastIndex = 0U;
+        for (uint32_t n = 0U; n < 100000U; n++) {
+            uint64_t value = rng() >> (rng() % 36U + 28U);
+            uint32_t index = LatencyHistogram::bucketIndex(value);
+            REQUIRE(index < LATENCY_HISTOGRAM_BUCKETS);
+
+            uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+            uint64_t lower = (index > 0U) ? LatencyHistogram::bucketUpperBound(index - 1U) + 1U : 0U;
+            REQUIRE(value >= lower);
+            REQUIRE(value <= upper);
+            REQUIRE((upper - lower) * LATENCY_HISTOGRAM_SUB_BUCKETS <= value);
+        }
+
+        // bucket indexes increase with the value, and adjacent buckets do not overlap
+        for (uint64_t value = 0U; value < 100000U; value++) {
+            uint32_t index = LatencyHistogram::bucketIndex(value);
+            REQUIRE(index >= lastIndex);
+            REQUIRE(index <= lastIndex + 1U);
+            lastIndex = index;
+        }
+
+        // values beyond the highest magnitude are counted in the last bucket
+        REQUIRE(LatencyHistogram::bucketIndex(UINT64_MAX) == LATENCY_HISTOGRAM_BUCKETS - 1U);
+        REQUIRE(LatencyHistogram::bucketIndex(LatencyHistogram::bucketUpperBound(LATENCY_HISTOGRAM_BUCKETS - 1U)) == LATENCY_HISTOGRAM_BUCKETS - 1U);
+    }
+
+    SECTION("LatencyHistogram_Percentile_Test") {
+        INFO("Latency Histogram Percentile Test");
+
+        LatencyHistogram histogram("test");
+
+        // an empty histogram reports nothing
+        LatencyHistogramSnapshot empty = histogram.snapshot();
+        REQUIRE(empty.count() == 0U);
+        REQUIRE(empty.mean() == 0U);
+        REQUIRE(empty.max() == 0U);
+        REQUIRE(empty.percentile(99.0) == 0U);
+
+        for (uint64_t value = 1U; value <= HISTOGRAM_SAMPLES; value++)
+            histogram.record(value);
+
+        LatencyHistogramSnapshot snapshot = histogram.snapshot();
+        REQUIRE(snapshot.count() == HISTOGRAM_SAMPLES);
+        REQUIRE(snapshot.mean() == (HISTOGRAM_SAMPLES + 1U) / 2U);
+        REQUIRE(snapshot.max() == HISTOGRAM_SAMPLES);
+
+        // a percentile is never below the exact sample, and within the histogram precision above it
+        const double percentiles[] = { 1.0, 10.0, 50.0, 90.0, 99.0, 99.9 };
+        for (double p : percentiles) {
+            uint64_t exact = (uint64_t)((p / 100.0) * HISTOGRAM_SAMPLES + 0.5);
+            uint64_t value = snapshot.percentile(p);
+            REQUIRE(value >= exact);
+            REQUIRE(value <= exact + exact / LATENCY_HISTOGRAM_SUB_BUCKETS);
+        }
+
+        // the extremes are the smallest and the largest sample, and never exceed the largest sample
+        REQUIRE(snapshot.percentile(0.0) == 1U);
+        REQUIRE(snapshot.percentile(100.0) == HISTOGRAM_SAMPLES);
+        REQUIRE(snapshot.percentile(150.0) == HISTOGRAM_SAMPLES);
+
+        histogram.reset();
+        REQUIRE(histogram.snapshot().count() == 0U);
+        REQUIRE(histogram.snapshot().max() == 0U);
+    }
+
+    SECTION("LatencyHistogram_Since_Test") {
+        INFO("Latency Histogram Interval Test");
+
+        LatencyHistogram histogram("test");
+        for (uint32_t n = 0U; n < 100U; n++)
+            histogram.record(10U);
+        LatencyHistogramSnapshot prev = histogram.snapshot();
+
+        for (uint32_t n = 0U; n < 50U; n++)
+            histogram.record(1000U);
+
+        // only the samples recorded after the earlier snapshot are in the interval
+        LatencyHistogramSnapshot delta = histogram.snapshot().since(prev);
+        REQUIRE(delta.count() == 50U);
+        REQUIRE(delta.mean() == 1000U);
+        REQUIRE(delta.percentile(50.0) >= 1000U);
+        REQUIRE(delta.percentile(0.0) >= 1000U);
+        REQUIRE(delta.max() >= 1000U);
+        REQUIRE(delta.max() <= 1000U + 1000U / LATENCY_HISTOGRAM_SUB_BUCKETS);
+
+        // a reset between the snapshots leaves only the samples recorded after the reset
+        histogram.reset();
+        histogram.record(5U);
+        delta = histogram.snapshot().since(prev);
+        REQUIRE(delta.count() == 1U);
+        REQUIRE(delta.max() == 5U);
+    }
+
+    SECTION("LatencyHistogram_Concurrent_Test") {
+        INFO("Latency Histogram Concurrent Test");
+
+        LatencyHistogram histogram("test");
+
+        // samples recorded from many threads are all counted
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0U; t < HISTOGRAM_THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                for (uint32_t n = 0U; n < HISTOGRAM_SAMPLES_PER_THREAD; n++)
+                    histogram.record((uint64_t)(t + 1U) * 100U);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        LatencyHistogramSnapshot snapshot = histogram.snapshot();
+        REQUIRE(snapshot.count() == HISTOGRAM_THREADS * HISTOGRAM_SAMPLES_PER_THREAD);
+        REQUIRE(snapshot.max() == HISTOGRAM_THREADS * 100U);
+        REQUIRE(snapshot.mean() == ((HISTOGRAM_THREADS + 1U) * 100U) / 2U);
+        REQUIRE(snapshot.percentile(100.0) == HISTOGRAM_THREADS * 100U);
+    }
+}
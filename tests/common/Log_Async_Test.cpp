@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Log.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t LOG_THREADS = 4U;
+const uint32_t LOG_ENTRIES_PER_THREAD = 5000U;
+const uint32_t LOG_RATE_LIMIT = 5U;
+const uint32_t LOG_RATE_ENTRIES = 100U;
+
+/**
+ * @brief Helper to start logging to a log file in a new temporary directory.
+ * @returns std::string Path of the temporary directory.
+ */
+static std::string startLogFile()
+{
+    char path[] = "/tmp/dvmlogXXXXXX";
+    REQUIRE(::mkdtemp(path) != nullptr);
+
+    // log everything to the file, and nothing to the console
+    REQUIRE(LogInitialise(path, "test", 1U, 9999U, true));
+    return std::string(path);
+}
+
+/**
+ * @brief Helper to get the name of the log file in the given directory.
+ * @param path Path of the log directory.
+ * @returns std::string Log file name.
+ */
+static std::string logFileName(const std::string& path)
+{
+    time_t now;
+    ::time(&now);
+    struct tm* tm = ::localtime(&now);
+
+    char filename[200U];
+    ::snprintf(filename, sizeof(filename), "%s/test-%04d-%02d-%02d.log", path.c_str(), tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
+    return std::string(filename);
+}
+
+/**
+ * @brief Helper to stop logging to the log file, and read back the lines written to it.
+ * @param path Path of the log directory.
+ * @returns std::vector<std::string> Lines of the log file.
+ */
+static std::vector<std::string> finishLogFile(const std::string& path)
+{
+    LogFinalise();
+    LogSetRateLimit(0U);
+
+    std::string filename = logFileName(path);
+    std::vector<std::string> lines;
+    std::ifstream file(filename);
+    std::string line;
+    while (std::getline(file, line))
+        lines.push_back(line);
+    file.close();
+
+    ::unlink(filename.c_str());
+    ::rmdir(path.c_str());
+
+    // restore the default log levels
+    LogInitialise("", "", 0U, 2U);
+    return lines;
+}
+
+/**
+ * @brief Helper to count the lines containing the given text.
+ * @param lines Lines of the log file.
+ * @param text Text to find.
+ * @returns uint32_t Number of lines containing the text.
+ */
+static uint32_t countLines(const std::vector<std::string>& lines, const char* text)
+{
+    uint32_t count = 0U;
+    for (const std::string& line : lines) {
+        if (line.find(text) != std::string::npos)
+            count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Helper to sum the number preceding the given text, over every line containing the text.
+ * @param lines Lines of the log file.
+ * @param text Text following the number.
+ * @returns uint64_t Sum of the numbers.
+ */
+static uint64_t sumCounts(const std::vector<std::string>& lines, const char* text)
+{
+    uint64_t sum = 0U;
+    for (const std::string& line : lines) {
+        size_t pos = line.find(text);
+        if (pos == std::string::npos)
+            continue;
+
+        size_t end = pos;
+        while (end > 0U && line[end - 1U] == ' ')
+            end--;
+        size_t start = end;
+        while (start > 0U && ::isdigit((unsigned char)line[start - 1U]))
+            start--;
+
+        sum += std::strtoull(line.substr(start, end - start).c_str(), nullptr, 10);
+    }
+
+    return sum;
+}
+
+/**
+ * @brief Helper to log entries from several threads at once.
+ */
+static void logFromThreads()
+{
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0U; t < LOG_THREADS; t++) {
+        threads.emplace_back([t]() {
+            for (uint32_t i = 0U; i < LOG_ENTRIES_PER_THREAD; i++)
+                LogInfoEx(LOG_HOST, "async entry thread %u seq %u", t, i);
+        });
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+TEST_CASE("Log", "[Log Test]") {
+    SECTION("Log_Async_Writer_Test") {
+        INFO("Log Asynchronous Writer Test");
+
+        std::string path = startLogFile();
+
+        uint64_t written = 0U, dropped = 0U, suppressed = 0U;
+        LogGetCounters(written, dropped, suppressed);
+
+        // waiting for the log writer never drops an entry, and entries from each thread are written in order
+        REQUIRE(LogStartAsync(LOG_ASYNC_DEFAULT_BUFFER_LEN, false));
+        logFromThreads();
+        LogStopAsync();
+
+        uint64_t writtenAfter = 0U, droppedAfter = 0U, suppressedAfter = 0U;
+        LogGetCounters(writtenAfter, droppedAfter, suppressedAfter);
+
+        std::vector<std::string> lines = finishLogFile(path);
+        REQUIRE(droppedAfter == dropped);
+        REQUIRE(writtenAfter - written == LOG_THREADS * LOG_ENTRIES_PER_THREAD);
+        REQUIRE(countLines(lines, "async entry") == LOG_THREADS * LOG_ENTRIES_PER_THREAD);
+
+        std::vector<uint32_t> next(LOG_THREADS, 0U);
+        uint32_t outOfOrder = 0U;
+        for (const std::string& line : lines) {
+            uint32_t t = 0U, seq = 0U;
+            size_t pos = line.find("async entry thread ");
+            if (pos == std::string::npos || ::sscanf(line.c_str() + pos, "async entry thread %u seq %u", &t, &seq) != 2)
+                continue;
+
+            if (seq != next[t])
+                outOfOrder++;
+            next[t] = seq + 1U;
+        }
+
+        REQUIRE(outOfOrder == 0U);
+    }
+
+    SECTION("Log_Async_Drop_Test") {
+        INFO("Log Asynchronous Writer Dropped Entry Test");
+
+        std::string path = startLogFile();
+
+        uint64_t written = 0U, dropped = 0U, suppressed = 0U;
+        LogGetCounters(written, dropped, suppressed);
+
+        // with the smallest buffer, entries are dropped when the log writer falls behind
+        REQUIRE(LogStartAsync(1U, true));
+        logFromThreads();
+        LogStopAsync();
+
+        uint64_t writtenAfter = 0U, droppedAfter = 0U, suppressedAfter = 0U;
+        LogGetCounters(writtenAfter, droppedAfter, suppressedAfter);
+
+        // every entry is either written or counted as dropped, and every dropped entry is reported
+        std::vector<std::string> lines = finishLogFile(path);
+        uint32_t entries = countLines(lines, "async entry");
+        uint32_t reports = countLines(lines, "log entries dropped");
+        REQUIRE(entries + (droppedAfter - dropped) == LOG_THREADS * LOG_ENTRIES_PER_THREAD);
+        REQUIRE(writtenAfter - written == entries + reports);
+        REQUIRE(sumCounts(lines, "log entries dropped") == droppedAfter - dropped);
+    }
+
+    SECTION("Log_Async_Stop_Test") {
+        INFO("Log Asynchronous Writer Stop Test");
+
+        std::string path = startLogFile();
+        REQUIRE(LogStartAsync(LOG_ASYNC_DEFAULT_BUFFER_LEN, false));
+
+        // entries logged while (and after) the log writer stops are not lost, and stopping twice at once is safe
+        std::atomic<bool> started(false);
+        std::thread logger([&]() {
+            for (uint32_t i = 0U; i < LOG_ENTRIES_PER_THREAD; i++) {
+                LogInfoEx(LOG_HOST, "async entry thread 0 seq %u", i);
+                started = true;
+            }
+        });
+
+        while (!started)
+            std::this_thread::yield();
+
+        std::thread stopper([]() { LogStopAsync(); });
+        LogStopAsync();
+        stopper.join();
+        logger.join();
+
+        // the log writer can be started again
+        REQUIRE(LogStartAsync(LOG_ASYNC_DEFAULT_BUFFER_LEN, false));
+        LogInfoEx(LOG_HOST, "async entry restarted");
+
+        std::vector<std::string> lines = finishLogFile(path);
+        REQUIRE(countLines(lines, "async entry thread 0") == LOG_ENTRIES_PER_THREAD);
+        REQUIRE(countLines(lines, "async entry restarted") == 1U);
+    }
+
+    SECTION("Log_Rate_Limit_Test") {
+        INFO("Log Rate Limit Test");
+
+        std::string path = startLogFile();
+        LogSetRateLimit(LOG_RATE_LIMIT);
+
+        uint64_t written = 0U, dropped = 0U, suppressed = 0U;
+        LogGetCounters(written, dropped, suppressed);
+
+        // entries filtered out by the log levels never count against the limit
+        LogInitialise(path, "test", 2U, 9999U, true);
+        for (uint32_t i = 0U; i < LOG_RATE_ENTRIES; i++)
+            LogDebug(LOG_HOST, "filtered entry %u", i);
+
+        uint64_t writtenAfter = 0U, droppedAfter = 0U, suppressedAfter = 0U;
+        LogGetCounters(writtenAfter, droppedAfter, suppressedAfter);
+        REQUIRE(suppressedAfter == suppressed);
+
+        // entries over the limit are suppressed, and counted on the next entry written by the same call site
+        for (uint32_t i = 0U; i < LOG_RATE_ENTRIES + 1U; i++) {
+            if (i == LOG_RATE_ENTRIES)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+            LogInfoEx(LOG_HOST, "limited entry %u", i);
+        }
+
+        LogGetCounters(writtenAfter, droppedAfter, suppressedAfter);
+
+        std::vector<std::string> lines = finishLogFile(path);
+        uint32_t entries = countLines(lines, "limited entry");
+        REQUIRE(countLines(lines, "filtered entry") == 0U);
+        REQUIRE(suppressedAfter - suppressed >= LOG_RATE_ENTRIES - (LOG_RATE_LIMIT * 2U));
+        REQUIRE(entries + (suppressedAfter - suppressed) == LOG_RATE_ENTRIES + 1U);
+        REQUIRE(sumCounts(lines, "similar log entries suppressed") == suppressedAfter - suppressed);
+    }
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/concurrent/mpmc_queue.h"
+
+using namespace concurrent;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+const uint32_t MPMC_PRODUCERS = 4U;
+const uint32_t MPMC_CONSUMERS = 4U;
+const uint32_t MPMC_ITEMS_PER_PRODUCER = 50000U;
+
+TEST_CASE("MPMC", "[Queue Test]") {
+    SECTION("MPMC_Queue_Capacity_Test") {
+        INFO("MPMC Queue Capacity Test");
+
+        // capacity is rounded up to the next power of 2
+        mpmc_queue<uint32_t> queue(100U);
+        REQUIRE(queue.capacity() == 128U);
+
+        for (uint32_t i = 0U; i < queue.capacity(); i++)
+            REQUIRE(queue.push(i));
+
+        // a full queue rejects further pushes, without losing what was queued
+        REQUIRE(!queue.push(0xFFFFU));
+
+        uint32_t value = 0U;
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == 0U);
+        REQUIRE(queue.push(1000U));
+        REQUIRE(!queue.push(1001U));
+    }
+
+    SECTION("MPMC_Queue_Order_Test") {
+        INFO("MPMC Queue Order Test");
+
+        mpmc_queue<uint32_t> queue(8U);
+
+        uint32_t value = 0U;
+        REQUIRE(!queue.pop(value));
+
+        // wrap the ring several times, elements always come out in the order they went in
+        uint32_t next = 0U;
+        for (uint32_t i = 0U; i < 100U; i++) {
+            REQUIRE(queue.push(i * 2U));
+            REQUIRE(queue.push(i * 2U + 1U));
+
+            REQUIRE(queue.pop(value));
+            REQUIRE(value == next++);
+            REQUIRE(queue.pop(value));
+            REQUIRE(value == next++);
+        }
+
+        REQUIRE(!queue.pop(value));
+    }
+
+    SECTION("MPMC_Queue_Concurrent_Test") {
+        INFO("MPMC Queue Concurrent Test");
+
+        mpmc_queue<uint32_t> queue(1024U);
+
+        const uint32_t total = MPMC_PRODUCERS * MPMC_ITEMS_PER_PRODUCER;
+        std::vector<std::atomic<uint32_t>> seen(total);
+        for (auto& s : seen)
+            s = 0U;
+
+        std::atomic<uint32_t> consumed(0U);
+        std::atomic<uint32_t> outOfOrder(0U);
+
+        std::vector<std::thread> consumers;
+        for (uint32_t c = 0U; c < MPMC_CONSUMERS; c++) {
+            consumers.emplace_back([&]() {
+                // per producer, a single consumer must observe increasing sequence numbers
+                std::vector<int64_t> last(MPMC_PRODUCERS, -1);
+                while (consumed.load() < total) {
+                    uint32_t value = 0U;
+                    if (!queue.pop(value)) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    uint32_t producer = value / MPMC_ITEMS_PER_PRODUCER;
+                    uint32_t seq = value % MPMC_ITEMS_PER_PRODUCER;
+                    if ((int64_t)seq <= last[producer])
+                        outOfOrder++;
+                    last[producer] = seq;
+
+                    seen[value]++;
+                    consumed++;
+                }
+            });
+        }
+
+        std::vector<std::thread> producers;
+        for (uint32_t p = 0U; p < MPMC_PRODUCERS; p++) {
+            producers.emplace_back([&, p]() {
+                for (uint32_t i = 0U; i < MPMC_ITEMS_PER_PRODUCER; i++) {
+                    while (!queue.push(p * MPMC_ITEMS_PER_PRODUCER + i))
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto& producer : producers)
+            producer.join();
+        for (auto& consumer : consumers)
+            consumer.join();
+
+        // every element is consumed exactly once
+        REQUIRE(consumed == total);
+        uint32_t missing = 0U, duplicated = 0U;
+        for (auto& s : seen) {
+            if (s == 0U)
+                missing++;
+            if (s > 1U)
+                duplicated++;
+        }
+
+        REQUIRE(missing == 0U);
+        REQUIRE(duplicated == 0U);
+        REQUIRE(outOfOrder == 0U);
+    }
+}
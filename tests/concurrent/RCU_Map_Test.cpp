@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/concurrent/rcu_unordered_map.h"
+#include "common/concurrent/unordered_map.h"
+#include "common/Log.h"
+
+using namespace concurrent;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+const uint32_t KEY_COUNT = 256U;
+const uint32_t READER_CNT = 4U;
+const uint32_t BENCH_DURATION_MS = 250U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a test value that counts its live instances.
+ */
+struct RCUTestValue {
+    std::atomic<int32_t>& live;
+
+    RCUTestValue(std::atomic<int32_t>& l) : live(l) { live++; }
+    ~RCUTestValue() { live--; }
+};
+
+TEST_CASE("RCU", "[Unordered Map Test]") {
+    SECTION("RCU_Map_Sanity_Test") {
+        INFO("RCU Unordered Map Sanity Test");
+
+        rcu_unordered_map<uint32_t, uint32_t> map;
+        for (uint32_t i = 0U; i < KEY_COUNT; i++)
+            map.insert(i, i * 2U);
+
+        REQUIRE(map.size() == KEY_COUNT);
+        REQUIRE(map.contains(10U));
+        REQUIRE(map[10U] == 20U);
+
+        uint32_t value = 0U;
+        REQUIRE(map.find(20U, value));
+        REQUIRE(value == 40U);
+        REQUIRE(!map.find(KEY_COUNT, value));
+
+        map.insert(10U, 0U); // insert does not replace
+        REQUIRE(map[10U] == 20U);
+        map.set(10U, 0U);
+        REQUIRE(map[10U] == 0U);
+
+        map.erase(10U);
+        REQUIRE(!map.contains(10U));
+        REQUIRE(map.size() == KEY_COUNT - 1U);
+
+        map.clear();
+        REQUIRE(map.empty());
+    }
+
+    SECTION("RCU_Map_Snapshot_Test") {
+        INFO("RCU Unordered Map Snapshot Test");
+
+        rcu_unordered_map<uint32_t, uint32_t> map;
+        for (uint32_t i = 0U; i < KEY_COUNT; i++)
+            map.insert(i, i);
+
+        std::atomic<bool> snapshotTaken(false);
+        std::thread writer([&]() {
+            while (!snapshotTaken)
+                std::this_thread::yield();
+            map.clear();
+        });
+
+        // the snapshot must remain stable, even though the writer clears the map underneath it
+        {
+            auto snapshot = map.snapshot();
+            snapshotTaken = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            uint32_t count = 0U;
+            for (auto entry : snapshot) {
+                REQUIRE(entry.first == entry.second);
+                count++;
+            }
+
+            REQUIRE(count == KEY_COUNT);
+        }
+
+        writer.join();
+        REQUIRE(map.empty());
+    }
+
+    SECTION("RCU_Map_Concurrent_Test") {
+        INFO("RCU Unordered Map Concurrent Test");
+
+        rcu_unordered_map<uint32_t, uint32_t> map;
+        for (uint32_t i = 0U; i < KEY_COUNT; i++)
+            map.insert(i, i);
+
+        // readers must always observe complete writes, every stored value always matches its key
+        std::atomic<bool> running(true);
+        std::atomic<uint32_t> mismatches(0U);
+        std::vector<std::thread> readers;
+        for (uint32_t r = 0U; r < READER_CNT; r++) {
+            readers.emplace_back([&]() {
+                uint32_t key = 0U;
+                while (running) {
+                    uint32_t value = 0U;
+                    if (map.find(key, value) && value != key)
+                        mismatches++;
+                    key = (key + 1U) % KEY_COUNT;
+                }
+            });
+        }
+
+        for (uint32_t i = 0U; i < 1000U; i++) {
+            uint32_t key = i % KEY_COUNT;
+            map.erase(key);
+            map.insert(key, key);
+        }
+
+        running = false;
+        for (auto& reader : readers)
+            reader.join();
+
+        REQUIRE(mismatches == 0U);
+        REQUIRE(map.size() == KEY_COUNT);
+    }
+
+    SECTION("RCU_Map_Writer_Snapshot_Test") {
+        INFO("RCU Unordered Map Writer Holding Snapshot Test");
+
+        rcu_unordered_map<uint32_t, uint32_t> map;
+        for (uint32_t i = 0U; i < KEY_COUNT; i++)
+            map.insert(i, i);
+
+        // a thread holding a snapshot may write to the map (writers never wait for readers), and other writers
+        // are not held up by the outstanding snapshot
+        std::atomic<bool> done(false);
+        std::thread writer([&]() {
+            auto snapshot = map.snapshot();
+            for (auto entry : snapshot)
+                map.set(entry.first, entry.second + 1U);
+
+            std::thread other([&]() { map.erase(0U); });
+            other.join();
+            done = true;
+        });
+
+        for (uint32_t i = 0U; i < 5000U && !done; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        REQUIRE(done);
+        writer.join();
+
+        REQUIRE(!map.contains(0U));
+        REQUIRE(map[1U] == 2U);
+    }
+
+    SECTION("RCU_Map_Reclaim_Test") {
+        INFO("RCU Unordered Map Reclaim Test");
+
+        std::atomic<int32_t> live(0);
+        {
+            rcu_unordered_map<uint32_t, std::shared_ptr<RCUTestValue>> map;
+            map.set(1U, std::make_shared<RCUTestValue>(live));
+            REQUIRE(live == 1);
+
+            // a retired version is kept while a snapshot may still reference it...
+            {
+                auto snapshot = map.snapshot();
+                map.erase(1U);
+                for (uint32_t i = 0U; i < 4U; i++)
+                    map.set(2U, nullptr);
+                REQUIRE(live == 1);
+                REQUIRE(snapshot.size() == 1U);
+            }
+
+            // ...and released by the next write once the snapshot has been left
+            map.set(2U, nullptr);
+            REQUIRE(live == 0);
+
+            // data retired alongside an element is released the same way
+            bool released = false;
+            {
+                auto snapshot = map.snapshot();
+                map.retire([&]() { released = true; });
+                map.set(3U, nullptr);
+                REQUIRE(!released);
+            }
+
+            map.set(3U, nullptr);
+            REQUIRE(released);
+        }
+    }
+
+    SECTION("RCU_Map_Contention_Benchmark") {
+        INFO("RCU Unordered Map Contention Benchmark");
+
+        // measures lookup throughput and worst case lookup latency of the locked and read-copy-update maps, with a
+        // writer constantly replacing the contents of the map in the background (as a peer list reload would)
+        std::unordered_map<uint32_t, uint32_t> source;
+        for (uint32_t i = 0U; i < KEY_COUNT; i++)
+            source[i] = i;
+
+        concurrent::unordered_map<uint32_t, uint32_t> lockedMap;
+        rcu_unordered_map<uint32_t, uint32_t> rcuMap;
+        lockedMap = source;
+        rcuMap = source;
+
+        struct BenchResult {
+            uint64_t lookups;
+            uint64_t writes;
+            uint64_t maxLookupNs;
+        };
+
+        auto bench = [&](std::function<void(uint32_t)> lookup, std::function<void(uint32_t)> write) -> BenchResult {
+            std::atomic<bool> running(true);
+            std::atomic<uint64_t> lookups(0U);
+            std::atomic<uint64_t> maxLookupNs(0U);
+            uint64_t writes = 0U;
+
+            std::vector<std::thread> readers;
+            for (uint32_t r = 0U; r < READER_CNT; r++) {
+                readers.emplace_back([&]() {
+                    uint64_t count = 0U, maxNs = 0U;
+                    uint32_t key = 0U;
+                    while (running) {
+                        auto start = std::chrono::steady_clock::now();
+                        lookup(key);
+                        uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+                        if (ns > maxNs)
+                            maxNs = ns;
+
+                        key = (key + 1U) % KEY_COUNT;
+                        count++;
+                    }
+
+                    lookups += count;
+                    uint64_t prev = maxLookupNs.load();
+                    while (maxNs > prev && !maxLookupNs.compare_exchange_weak(prev, maxNs)) { /* stub */ }
+                });
+            }
+
+            std::thread writer([&]() {
+                uint32_t key = 0U;
+                while (running) {
+                    write(key);
+                    key = (key + 1U) % KEY_COUNT;
+                    writes++;
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                }
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(BENCH_DURATION_MS));
+            running = false;
+            writer.join();
+            for (auto& reader : readers)
+                reader.join();
+
+            return BenchResult { lookups.load(), writes, maxLookupNs.load() };
+        };
+
+        BenchResult locked = bench([&](uint32_t key) {
+            auto it = lockedMap.find(key);
+            (void)it;
+        }, [&](uint32_t key) {
+            source[key] = key;
+            lockedMap = source;
+        });
+
+        BenchResult rcu = bench([&](uint32_t key) {
+            uint32_t value = 0U;
+            rcuMap.find(key, value);
+        }, [&](uint32_t key) {
+            source[key] = key;
+            rcuMap = source;
+        });
+
+        ::LogDebug("T", "RCU_Map_Contention_Benchmark, %u readers, %ums, locked map = %llu lookups (%.1f/us, max %llu ns, %llu writes), rcu map = %llu lookups (%.1f/us, max %llu ns, %llu writes)",
+            READER_CNT, BENCH_DURATION_MS,
+            (unsigned long long)locked.lookups, (double)locked.lookups / (BENCH_DURATION_MS * 1000U), (unsigned long long)locked.maxLookupNs, (unsigned long long)locked.writes,
+            (unsigned long long)rcu.lookups, (double)rcu.lookups / (BENCH_DURATION_MS * 1000U), (unsigned long long)rcu.maxLookupNs, (unsigned long long)rcu.writes);
+
+        // the writer must make progress against continuous readers (it never waits for them)
+        REQUIRE(rcu.writes > 0U);
+        REQUIRE(locked.writes > 0U);
+
+        // locked map readers back off while the writer holds the map, read-copy-update readers never do; the
+        // lookup counts are only logged, as they depend on how many readers the host actually runs in parallel
+        REQUIRE(rcu.lookups > 0U);
+        REQUIRE(locked.lookups > 0U);
+    }
+}
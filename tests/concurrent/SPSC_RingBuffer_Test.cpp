@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/concurrent/spsc_ring_buffer.h"
+#include "common/Log.h"
+#include "common/RingBuffer.h"
+
+using namespace concurrent;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+const uint32_t STRESS_RECORDS = 200000U;
+const uint32_t BENCH_FRAMES = 100000U;
+const uint32_t BENCH_FRAME_LENGTH = 35U;
+
+/**
+ * @brief Helper to fill a test record.
+ * @param[out] buffer Buffer to fill.
+ * @param seq Record sequence number.
+ * @returns uint32_t Length of the record.
+ */
+static uint32_t fillRecord(uint8_t* buffer, uint32_t seq)
+{
+    uint32_t length = 4U + (seq % 61U);
+    buffer[0U] = (seq >> 24) & 0xFFU;
+    buffer[1U] = (seq >> 16) & 0xFFU;
+    buffer[2U] = (seq >> 8) & 0xFFU;
+    buffer[3U] = (seq >> 0) & 0xFFU;
+    for (uint32_t i = 4U; i < length; i++)
+        buffer[i] = (uint8_t)(seq + i);
+
+    return length;
+}
+
+TEST_CASE("SPSC", "[Ring Buffer Test]") {
+    SECTION("SPSC_RingBuffer_Wrap_Test") {
+        INFO("SPSC Ring Buffer Wrap Test");
+
+        spsc_ring_buffer<short> buffer(10U, "Test");
+        REQUIRE(buffer.length() == 10U);
+        REQUIRE(buffer.isEmpty());
+        REQUIRE(buffer.freeSpace() == 10U);
+
+        short in[10U], out[10U];
+        for (short i = 0; i < 10; i++)
+            in[i] = i + 100;
+
+        // move the indexes towards the end of the buffer
+        REQUIRE(buffer.addData(in, 7U));
+        REQUIRE(buffer.get(out, 7U));
+        REQUIRE(buffer.isEmpty());
+
+        // data wraps around the end of the buffer
+        REQUIRE(buffer.addData(in, 10U));
+        REQUIRE(buffer.freeSpace() == 0U);
+        REQUIRE(!buffer.hasSpace(1U));
+        REQUIRE(!buffer.addData(in, 1U));
+
+        spsc_ring_buffer<short>::span s;
+        REQUIRE(buffer.peekSpans(10U, s));
+        REQUIRE(s.firstLength == 4U);
+        REQUIRE(s.secondLength == 6U);
+        REQUIRE(s.first[0U] == 100);
+        REQUIRE(s.second[0U] == 104);
+        REQUIRE(!buffer.peekSpans(11U, s));
+
+        ::memset(out, 0x00U, sizeof(out));
+        REQUIRE(buffer.peek(out, 10U));
+        REQUIRE(::memcmp(in, out, sizeof(in)) == 0);
+        REQUIRE(buffer.dataSize() == 10U);
+
+        ::memset(out, 0x00U, sizeof(out));
+        REQUIRE(buffer.get(out, 10U));
+        REQUIRE(::memcmp(in, out, sizeof(in)) == 0);
+        REQUIRE(buffer.isEmpty());
+        REQUIRE(!buffer.get(out, 1U));
+
+        REQUIRE(buffer.addData(in, 5U));
+        buffer.clear();
+        REQUIRE(buffer.isEmpty());
+        REQUIRE(buffer.freeSpace() == 10U);
+    }
+
+    SECTION("SPSC_RingBuffer_Record_Test") {
+        INFO("SPSC Ring Buffer Record Test");
+
+        spsc_ring_buffer<uint8_t> buffer(32U, "Test");
+        REQUIRE(buffer.peekRecordLength() == 0U);
+
+        uint8_t out[64U];
+        REQUIRE(buffer.getRecord(out) == 0U);
+
+        // gathered header and data
+        uint8_t header[2U] = { 0x01U, 0x02U };
+        uint8_t data[32U];
+        for (uint8_t i = 0U; i < 32U; i++)
+            data[i] = i;
+
+        REQUIRE(buffer.addRecord(header, 2U, data, 10U));
+        REQUIRE(buffer.dataSize() == SPSC_RECORD_HEADER_LENGTH + 12U);
+        REQUIRE(buffer.peekRecordLength() == 12U);
+        REQUIRE(buffer.getRecord(out) == 12U);
+        REQUIRE(out[0U] == 0x01U);
+        REQUIRE(out[1U] == 0x02U);
+        REQUIRE(::memcmp(out + 2U, data, 10U) == 0);
+
+        // a record whose data wraps around the end of the buffer
+        REQUIRE(buffer.addRecord(data, 20U));
+        spsc_ring_buffer<uint8_t>::span s;
+        REQUIRE(buffer.peekRecord(s));
+        REQUIRE(s.length() == 20U);
+        REQUIRE(s.secondLength > 0U);
+
+        ::memset(out, 0x00U, sizeof(out));
+        s.copy(out);
+        REQUIRE(::memcmp(out, data, 20U) == 0);
+        REQUIRE(buffer.skipRecord());
+        REQUIRE(buffer.isEmpty());
+
+        // a record whose length header wraps around the end of the buffer
+        REQUIRE(buffer.addData(data, 29U));
+        REQUIRE(buffer.skip(29U));
+        REQUIRE(buffer.addRecord(data, 3U));
+        REQUIRE(buffer.peekRecordLength() == 3U);
+        REQUIRE(buffer.getRecord(out) == 3U);
+        REQUIRE(::memcmp(out, data, 3U) == 0);
+
+        // records that do not fit are rejected, without disturbing the buffered records
+        REQUIRE(buffer.addRecord(data, 20U));
+        REQUIRE(!buffer.addRecord(data, 20U));
+        REQUIRE(!buffer.addRecord(data, 0U));
+        REQUIRE(buffer.getRecord(out) == 20U);
+        REQUIRE(buffer.isEmpty());
+
+        // records too long for the destination are discarded
+        REQUIRE(buffer.addRecord(data, 20U));
+        REQUIRE(buffer.addRecord(data, 4U));
+        REQUIRE(buffer.getRecord(out, 10U) == 0U);
+        REQUIRE(buffer.getRecord(out, 10U) == 4U);
+        REQUIRE(buffer.isEmpty());
+    }
+
+    SECTION("SPSC_RingBuffer_Stress_Test") {
+        INFO("SPSC Ring Buffer Producer/Consumer Stress Test");
+
+        spsc_ring_buffer<uint8_t> buffer(1024U, "Test");
+        std::atomic<bool> failed(false);
+
+        std::thread producer([&]() {
+            uint8_t record[64U];
+            uint32_t seq = 0U;
+            while (seq < STRESS_RECORDS) {
+                uint32_t length = fillRecord(record, seq);
+                if (!buffer.hasSpace(SPSC_RECORD_HEADER_LENGTH + length)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                if (!buffer.addRecord(record, length)) {
+                    failed = true;
+                    return;
+                }
+                seq++;
+            }
+        });
+
+        uint8_t record[64U], expected[64U];
+        uint32_t seq = 0U;
+        while (seq < STRESS_RECORDS && !failed) {
+            uint32_t length = buffer.getRecord(record, 64U);
+            if (length == 0U) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            uint32_t expectedLength = fillRecord(expected, seq);
+            if (length != expectedLength || ::memcmp(record, expected, length) != 0) {
+                failed = true;
+                break;
+            }
+            seq++;
+        }
+
+        producer.join();
+
+        REQUIRE(!failed);
+        REQUIRE(seq == STRESS_RECORDS);
+        REQUIRE(buffer.isEmpty());
+    }
+
+    SECTION("SPSC_RingBuffer_Benchmark") {
+        INFO("SPSC Ring Buffer vs Locked Ring Buffer Benchmark");
+
+        uint8_t frame[BENCH_FRAME_LENGTH];
+        ::memset(frame, 0xA5U, BENCH_FRAME_LENGTH);
+
+        // locked ring buffer, with the length byte framing previously used by the modem queues
+        RingBuffer<uint8_t> locked(4096U, "Test");
+        std::mutex lock;
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread lockedProducer([&]() {
+            uint8_t len = BENCH_FRAME_LENGTH;
+            uint32_t n = 0U;
+            while (n < BENCH_FRAMES) {
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    if (locked.hasSpace(1U + BENCH_FRAME_LENGTH)) {
+                        locked.addData(&len, 1U);
+                        locked.addData(frame, BENCH_FRAME_LENGTH);
+                        n++;
+                        continue;
+                    }
+                }
+
+                std::this_thread::yield();
+            }
+        });
+
+        uint32_t lockedRead = 0U;
+        uint8_t data[BENCH_FRAME_LENGTH];
+        while (lockedRead < BENCH_FRAMES) {
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if (!locked.isEmpty()) {
+                    uint8_t len = 0U;
+                    locked.get(&len, 1U);
+                    locked.get(data, len);
+                    lockedRead++;
+                    continue;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+
+        lockedProducer.join();
+        auto lockedTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        // lock-free ring buffer, with framed records
+        spsc_ring_buffer<uint8_t> lockFree(4096U, "Test");
+
+        start = std::chrono::steady_clock::now();
+        std::thread lockFreeProducer([&]() {
+            uint32_t n = 0U;
+            while (n < BENCH_FRAMES) {
+                if (!lockFree.hasSpace(SPSC_RECORD_HEADER_LENGTH + BENCH_FRAME_LENGTH)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                lockFree.addRecord(frame, BENCH_FRAME_LENGTH);
+                n++;
+            }
+        });
+
+        uint32_t lockFreeRead = 0U;
+        while (lockFreeRead < BENCH_FRAMES) {
+            if (lockFree.getRecord(data, BENCH_FRAME_LENGTH) > 0U)
+                lockFreeRead++;
+            else
+                std::this_thread::yield();
+        }
+
+        lockFreeProducer.join();
+        auto lockFreeTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        ::LogDebug("T", "SPSC_RingBuffer_Benchmark, frames = %u, locked = %lldus, lock-free = %lldus",
+            BENCH_FRAMES, (long long)lockedTime, (long long)lockFreeTime);
+
+        REQUIRE(lockedRead == BENCH_FRAMES);
+        REQUIRE(lockFreeRead == BENCH_FRAMES);
+        REQUIRE(::memcmp(data, frame, BENCH_FRAME_LENGTH) == 0);
+    }
+}
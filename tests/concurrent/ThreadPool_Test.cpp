@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/ThreadPool.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const uint32_t POOL_TASKS = 10000U;
+const uint32_t POOL_KEYS = 64U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents the shared state of a set of test tasks.
+ */
+struct PoolTestState {
+    std::atomic<uint32_t> ran;
+    std::atomic<uint32_t> blocked;
+    std::atomic<bool> release;
+
+    PoolTestState() : ran(0U), blocked(0U), release(false) { /* stub */ }
+};
+
+/**
+ * @brief Represents a keyed test task.
+ */
+struct KeyedTestTask {
+    uint32_t key;
+    uint32_t seq;
+    std::vector<std::vector<uint32_t>>* order;
+    std::vector<std::thread::id>* threads;
+    std::atomic<uint32_t>* mismatchedThread;
+    std::atomic<uint32_t>* ran;
+    std::mutex* mutex;
+};
+
+/**
+ * @brief Test task that records the order it was run in, for its key.
+ * @param task Keyed task.
+ */
+static void keyedTask(KeyedTestTask* task)
+{
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(*task->mutex);
+        (*task->order)[task->key].push_back(task->seq);
+
+        std::thread::id& owner = (*task->threads)[task->key];
+        if (owner == std::thread::id())
+            owner = std::this_thread::get_id();
+        else if (owner != std::this_thread::get_id())
+            (*task->mismatchedThread)++;
+    }
+
+    (*task->ran)++;
+}
+
+/**
+ * @brief Test task that counts its execution.
+ * @param state Shared task state.
+ */
+static void countTask(PoolTestState* state)
+{
+    state->ran++;
+}
+
+/**
+ * @brief Test task that blocks its worker until released.
+ * @param state Shared task state.
+ */
+static void blockTask(PoolTestState* state)
+{
+    state->blocked++;
+    while (!state->release)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    state->ran++;
+}
+
+/**
+ * @brief Helper to wait for a counter to reach the given value.
+ * @param counter Counter.
+ * @param value Value to wait for.
+ * @returns bool True, if the counter reached the value, otherwise false.
+ */
+static bool waitFor(std::atomic<uint32_t>& counter, uint32_t value)
+{
+    for (uint32_t i = 0U; i < 5000U && counter.load() < value; i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return counter.load() >= value;
+}
+
+TEST_CASE("ThreadPool", "[Thread Pool Test]") {
+    SECTION("ThreadPool_Run_Test") {
+        INFO("Thread Pool Run Test");
+
+        // every queue mode runs every enqueued task exactly once
+        for (uint32_t mode = 0U; mode < 3U; mode++) {
+            PoolTestState state;
+
+            ThreadPool pool(4U, "test");
+            pool.setLockFree(mode == 1U);
+            pool.setSharded(mode == 2U);
+            pool.setLockFreeQueueLen(POOL_TASKS);
+            pool.start();
+
+            for (uint32_t i = 0U; i < POOL_TASKS; i++)
+                REQUIRE(pool.enqueue(countTask, &state));
+
+            REQUIRE(waitFor(state.ran, POOL_TASKS));
+
+            pool.stop();
+            pool.wait();
+
+            ThreadPoolStats stats = pool.stats();
+            REQUIRE(state.ran == POOL_TASKS);
+            REQUIRE(stats.enqueued == POOL_TASKS);
+            REQUIRE(stats.completed == POOL_TASKS);
+            REQUIRE(stats.dropped == 0U);
+            REQUIRE(stats.queueDepth == 0U);
+        }
+    }
+
+    SECTION("ThreadPool_Keyed_Order_Test") {
+        INFO("Thread Pool Keyed Dispatch Order Test");
+
+        ThreadPool pool(4U, "test");
+        pool.setSharded(true);
+        pool.setLockFreeQueueLen(POOL_TASKS);
+        pool.start();
+
+        std::vector<std::vector<uint32_t>> order(POOL_KEYS);
+        std::vector<std::thread::id> threads(POOL_KEYS);
+        std::atomic<uint32_t> mismatchedThread(0U);
+        std::atomic<uint32_t> ran(0U);
+        std::mutex mutex;
+
+        // interleave the keys, as received frames from many streams would be
+        std::vector<KeyedTestTask> tasks(POOL_TASKS);
+        for (uint32_t i = 0U; i < POOL_TASKS; i++) {
+            KeyedTestTask& task = tasks[i];
+            task.key = i % POOL_KEYS;
+            task.seq = i / POOL_KEYS;
+            task.order = &order;
+            task.threads = &threads;
+            task.mismatchedThread = &mismatchedThread;
+            task.ran = &ran;
+            task.mutex = &mutex;
+
+            REQUIRE(pool.enqueue(keyedTask, &task, task.key * 0x9E3779B1U));
+        }
+
+        REQUIRE(waitFor(ran, POOL_TASKS));
+
+        pool.stop();
+        pool.wait();
+
+        // every key ran on a single worker, in the order its tasks were enqueued
+        REQUIRE(mismatchedThread == 0U);
+        for (uint32_t key = 0U; key < POOL_KEYS; key++) {
+            std::vector<uint32_t>& seqs = order[key];
+            REQUIRE(!seqs.empty());
+            for (uint32_t i = 0U; i < seqs.size(); i++)
+                REQUIRE(seqs[i] == i);
+        }
+    }
+
+    SECTION("ThreadPool_Unkeyed_Isolation_Test") {
+        INFO("Thread Pool Unkeyed Task Isolation Test");
+
+        PoolTestState state;
+
+        ThreadPool pool(4U, "test");
+        pool.setSharded(true);
+        pool.setControlWorkerCnt(1U);
+        pool.start();
+
+        // a slow unkeyed task occupies the control worker
+        REQUIRE(pool.enqueue(blockTask, &state));
+        REQUIRE(waitFor(state.blocked, 1U));
+
+        // keyed tasks for every shard still run while the unkeyed task is blocked
+        PoolTestState keyed;
+        for (uint32_t key = 0U; key < POOL_KEYS; key++)
+            REQUIRE(pool.enqueue(countTask, &keyed, key));
+        REQUIRE(waitFor(keyed.ran, POOL_KEYS));
+        REQUIRE(state.ran == 0U);
+
+        // further unkeyed tasks wait for the control worker, not for a shard
+        REQUIRE(pool.enqueue(countTask, &state));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(state.ran == 0U);
+
+        state.release = true;
+        REQUIRE(waitFor(state.ran, 2U));
+
+        pool.stop();
+        pool.wait();
+    }
+
+    SECTION("ThreadPool_Bounded_Queue_Test") {
+        INFO("Thread Pool Bounded Lock-Free Queue Test");
+
+        PoolTestState state;
+
+        ThreadPool pool(4U, "test");
+        pool.setLockFree(true);
+        pool.setLockFreeQueueLen(8U);
+        REQUIRE(pool.getLockFreeQueueLen() == 8U);
+        pool.start();
+
+        // occupy every worker, so that nothing is dequeued
+        for (uint32_t i = 0U; i < 4U; i++)
+            REQUIRE(pool.enqueue(blockTask, &state));
+        REQUIRE(waitFor(state.blocked, 4U));
+
+        // the queue holds exactly its capacity, further tasks are dropped
+        for (uint32_t i = 0U; i < 8U; i++)
+            REQUIRE(pool.enqueue(countTask, &state));
+        REQUIRE(!pool.enqueue(countTask, &state));
+        REQUIRE(pool.stats().dropped == 1U);
+
+        // a dropped allocated task is owned (and deleted) by the pool
+        std::shared_ptr<uint32_t> owned = std::make_shared<uint32_t>(0U);
+        REQUIRE(!pool.enqueue(new_pooltask([](std::shared_ptr<uint32_t> v) { (*v)++; }, owned)));
+        REQUIRE(owned.use_count() == 1);
+
+        state.release = true;
+        REQUIRE(waitFor(state.ran, 4U + 8U));
+
+        pool.stop();
+        pool.wait();
+
+        REQUIRE(*owned == 0U);
+        REQUIRE(pool.stats().dropped == 2U);
+    }
+
+    SECTION("ThreadPool_Stopped_Test") {
+        INFO("Thread Pool Stopped Test");
+
+        PoolTestState state;
+
+        // a stopped pool rejects (and releases) tasks
+        ThreadPool pool(4U, "test");
+        REQUIRE(!pool.enqueue(countTask, &state));
+
+        std::shared_ptr<uint32_t> owned = std::make_shared<uint32_t>(0U);
+        REQUIRE(!pool.enqueue(new_pooltask([](std::shared_ptr<uint32_t> v) { (*v)++; }, owned)));
+        REQUIRE(owned.use_count() == 1);
+        REQUIRE(state.ran == 0U);
+    }
+}
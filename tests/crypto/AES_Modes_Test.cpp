@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/AESCrypto.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace crypto;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+TEST_CASE("AES", "[Modes Test]") {
+    // FIPS-197 Appendix C.1 and C.3 sample keys
+    uint8_t K128[16] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+    };
+
+    uint8_t K256[32] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+    };
+
+    uint8_t plaintext[16] =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+    };
+
+    SECTION("FIPS_197_Test") {
+        bool failed = false;
+
+        INFO("AES FIPS-197 Sample Vectors Test");
+
+        uint8_t expected128[16] =
+        {
+            0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30,
+            0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A
+        };
+
+        uint8_t expected256[16] =
+        {
+            0x8E, 0xA2, 0xB7, 0xCA, 0x51, 0x67, 0x45, 0xBF,
+            0xEA, 0xFC, 0x49, 0x90, 0x4B, 0x49, 0x60, 0x89
+        };
+
+        ::LogDebug("T", "FIPS_197_Test, AES-NI supported = %u", AES::isHardwareSupported());
+
+        // check both the portable implementation and AES-NI (if supported)
+        for (uint32_t hw = 0U; hw < 2U; hw++) {
+            AES aes128 = AES(AESKeyLength::AES_128, hw == 1U);
+            AES aes256 = AES(AESKeyLength::AES_256, hw == 1U);
+
+            uint8_t crypted[16], decrypted[16];
+
+            aes128.setKey(K128);
+            aes128.encryptECB(plaintext, crypted, 16U);
+            aes128.decryptECB(crypted, decrypted, 16U);
+            if (::memcmp(crypted, expected128, 16U) != 0 || ::memcmp(decrypted, plaintext, 16U) != 0) {
+                Utils::dump(2U, "FIPS_197_Test, AES-128 Encrypted", crypted, 16U);
+                ::LogDebug("T", "FIPS_197_Test, AES-128 INVALID, hw = %u\n", hw);
+                failed = true;
+            }
+
+            aes256.setKey(K256);
+            aes256.encryptECB(plaintext, crypted, 16U);
+            aes256.decryptECB(crypted, decrypted, 16U);
+            if (::memcmp(crypted, expected256, 16U) != 0 || ::memcmp(decrypted, plaintext, 16U) != 0) {
+                Utils::dump(2U, "FIPS_197_Test, AES-256 Encrypted", crypted, 16U);
+                ::LogDebug("T", "FIPS_197_Test, AES-256 INVALID, hw = %u\n", hw);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Modes_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("AES Allocation-Free Modes Equivalence Test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 160U;
+        uint8_t message[len];
+        for (uint32_t i = 0U; i < len; i++)
+            message[i] = (uint8_t)rand();
+
+        uint8_t iv[16];
+        for (uint32_t i = 0U; i < 16U; i++)
+            iv[i] = (uint8_t)rand();
+
+        AES portable = AES(AESKeyLength::AES_256, false);
+        AES aes = AES(AESKeyLength::AES_256);
+
+        // ECB and CBC, compared against the allocating API of the portable implementation
+        uint8_t* refECB = portable.encryptECB(message, len, K256);
+        uint8_t* refCBC = portable.encryptCBC(message, len, K256, iv);
+
+        uint8_t buffer[len];
+        aes.setKey(K256);
+        aes.encryptECB(message, buffer, len);
+        if (::memcmp(buffer, refECB, len) != 0) {
+            ::LogDebug("T", "Modes_Equivalence_Test, ECB encrypt INVALID\n");
+            failed = true;
+        }
+
+        // decrypt in place
+        aes.decryptECB(buffer, buffer, len);
+        if (::memcmp(buffer, message, len) != 0) {
+            ::LogDebug("T", "Modes_Equivalence_Test, ECB decrypt INVALID\n");
+            failed = true;
+        }
+
+        aes.encryptCBC(message, buffer, len, iv);
+        if (::memcmp(buffer, refCBC, len) != 0) {
+            ::LogDebug("T", "Modes_Equivalence_Test, CBC encrypt INVALID\n");
+            failed = true;
+        }
+
+        aes.decryptCBC(buffer, buffer, len, iv);
+        if (::memcmp(buffer, message, len) != 0) {
+            ::LogDebug("T", "Modes_Equivalence_Test, CBC decrypt INVALID\n");
+            failed = true;
+        }
+
+        // OFB, compared against chained ECB encryption of the IV (as used to generate the P25 keystream)
+        const uint32_t ofbLen = 150U;
+        uint8_t keystream[ofbLen];
+        uint8_t block[16];
+        ::memcpy(block, iv, 16U);
+        for (uint32_t i = 0U; i < ofbLen; i += 16U) {
+            portable.encryptECB(block, block, 16U);
+            ::memcpy(keystream + i, block, (ofbLen - i < 16U) ? ofbLen - i : 16U);
+        }
+
+        aes.encryptOFB(message, buffer, ofbLen, iv);
+        for (uint32_t i = 0U; i < ofbLen; i++) {
+            if (buffer[i] != (message[i] ^ keystream[i])) {
+                ::LogDebug("T", "Modes_Equivalence_Test, OFB encrypt INVALID AT IDX %d\n", i);
+                failed = true;
+                break;
+            }
+        }
+
+        aes.decryptOFB(buffer, buffer, ofbLen, iv);
+        if (::memcmp(buffer, message, ofbLen) != 0) {
+            ::LogDebug("T", "Modes_Equivalence_Test, OFB decrypt INVALID\n");
+            failed = true;
+        }
+
+        // changing the key must expand a new key schedule
+        uint8_t K2[32];
+        ::memcpy(K2, K256, 32U);
+        K2[31U] ^= 0x01U;
+
+        uint8_t* refECB2 = portable.encryptECB(message, len, K2);
+        aes.setKey(K2);
+        aes.encryptECB(message, buffer, len);
+        if (::memcmp(buffer, refECB2, len) != 0 || ::memcmp(refECB2, refECB, len) == 0) {
+            ::LogDebug("T", "Modes_Equivalence_Test, key change INVALID\n");
+            failed = true;
+        }
+
+        delete[] refECB;
+        delete[] refCBC;
+        delete[] refECB2;
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Keystream_Throughput_Benchmark") {
+        INFO("AES Keystream Throughput Benchmark");
+
+        // measures generating the 240 byte P25 AES keystream (15 blocks per superframe) with the key schedule
+        // expanded for every block (as done previously) against the cached key schedule
+        const uint32_t ITERATIONS = 20000U;
+        const uint32_t len = 240U;
+
+        uint8_t iv[16];
+        for (uint32_t i = 0U; i < 16U; i++)
+            iv[i] = (uint8_t)rand();
+
+        uint8_t uncachedKS[len], cachedKS[len];
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t n = 0U; n < ITERATIONS; n++) {
+            iv[0U] = (uint8_t)n;
+
+            uint8_t input[16];
+            ::memcpy(input, iv, 16U);
+            for (uint32_t i = 0U; i < (len / 16U); i++) {
+                // a new instance forces the key schedule to be expanded for every block
+                AES portable = AES(AESKeyLength::AES_256, false);
+                uint8_t* output = portable.encryptECB(input, 16U, K256);
+                ::memcpy(uncachedKS + (i * 16U), output, 16U);
+                ::memcpy(input, output, 16U);
+                delete[] output;
+            }
+        }
+        uint64_t uncached = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        AES aes = AES(AESKeyLength::AES_256);
+        start = std::chrono::steady_clock::now();
+        for (uint32_t n = 0U; n < ITERATIONS; n++) {
+            iv[0U] = (uint8_t)n;
+
+            ::memset(cachedKS, 0x00U, len);
+            aes.setKey(K256);
+            aes.encryptOFB(cachedKS, cachedKS, len, iv);
+        }
+        uint64_t cached = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        ::LogDebug("T", "Keystream_Throughput_Benchmark, %u keystreams, uncached = %lluus, cached = %lluus (AES-NI = %u)",
+            ITERATIONS, (unsigned long long)uncached, (unsigned long long)cached, aes.isHardwareAccelerated());
+
+        REQUIRE(::memcmp(uncachedKS, cachedKS, len) == 0);
+    }
+}
@@ -18,6 +18,25 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/* Bit-at-a-time reference 12-bit CRC, used to verify the table driven implementation. */
+
+static uint16_t referenceCRC12(const uint8_t* in, uint32_t bitLength)
+{
+    uint16_t crc = 0x0FFFU;
+
+    for (uint32_t i = 0U; i < bitLength; i++) {
+        bool bit1 = (in[i >> 3] & (0x80U >> (i & 7U))) != 0x00U;
+        bool bit2 = (crc & 0x0800U) == 0x0800U;
+
+        crc <<= 1;
+
+        if (bit1 ^ bit2)
+            crc ^= 0x080FU;
+    }
+
+    return crc & 0x0FFFU;
+}
+
 TEST_CASE("CRC", "[12-bit Test]") {
     SECTION("12_Sanity_Test") {
         bool failed = false;
@@ -62,4 +81,34 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("12_Table_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 12-bit CRC Table Equivalence Test");
+
+        srand((unsigned int)time(NULL));
+
+        // covers the slicing, whole byte and trailing bit paths, including lengths that are not byte aligned
+        const uint32_t len = 256U;
+        uint8_t* random = (uint8_t*)malloc(len + 4U);
+
+        for (uint32_t n = 0U; n < 1000U; n++) {
+            for (size_t i = 0; i < len + 4U; i++) {
+                random[i] = rand();
+            }
+
+            uint32_t bitLength = (n < 128U) ? n : (uint32_t)(rand() % (len * 8U));
+            uint16_t expected = referenceCRC12(random, bitLength);
+            uint16_t crc = CRC::addCRC12(random, bitLength);
+            if (crc != expected) {
+                ::LogDebug("T", "12_Table_Equivalence_Test, bitlen = %u, crc = $%03X, expected = $%03X", bitLength, crc, expected);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
 }
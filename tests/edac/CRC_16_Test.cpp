@@ -15,9 +15,30 @@
 using namespace edac;
 
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <functional>
 #include <stdlib.h>
 #include <time.h>
 
+/* Bit-at-a-time reference 16-bit CRC, used to verify the table driven implementation. */
+
+static uint16_t referenceCRC16(const uint8_t* in, uint32_t bitLength)
+{
+    uint16_t crc = 0xFFFFU;
+
+    for (uint32_t i = 0U; i < bitLength; i++) {
+        bool bit1 = (in[i >> 3] & (0x80U >> (i & 7U))) != 0x00U;
+        bool bit2 = (crc & 0x8000U) == 0x8000U;
+
+        crc <<= 1;
+
+        if (bit1 ^ bit2)
+            crc ^= 0x1021U;
+    }
+
+    return crc & 0xFFFFU;
+}
+
 TEST_CASE("CRC", "[16-bit Test]") {
     SECTION("16_Sanity_Test") {
         bool failed = false;
@@ -62,4 +83,69 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("16_Table_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC 16-bit CRC Table Equivalence Test");
+
+        srand((unsigned int)time(NULL));
+
+        // covers the slicing, whole byte and trailing bit paths, including lengths that are not byte aligned
+        const uint32_t len = 256U;
+        uint8_t* random = (uint8_t*)malloc(len + 4U);
+
+        for (uint32_t n = 0U; n < 1000U; n++) {
+            for (size_t i = 0; i < len + 4U; i++) {
+                random[i] = rand();
+            }
+
+            uint32_t bitLength = (n < 128U) ? n : (uint32_t)(rand() % (len * 8U));
+            uint16_t expected = referenceCRC16(random, bitLength);
+            uint16_t crc = CRC::createCRC16(random, bitLength);
+            if (crc != expected) {
+                ::LogDebug("T", "16_Table_Equivalence_Test, bitlen = %u, crc = $%04X, expected = $%04X", bitLength, crc, expected);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
+
+    SECTION("16_Throughput_Benchmark") {
+        INFO("CRC 16-bit CRC Throughput Benchmark");
+
+        // measures the throughput of the table driven CRC against the bit-at-a-time reference, over frames
+        // sized like the data blocks typically protected by the CRC
+        const uint32_t len = 24U;
+        const uint32_t lenBits = len * 8U;
+        const uint32_t ITERATIONS = 200000U;
+
+        uint8_t* random = (uint8_t*)malloc(len);
+        for (size_t i = 0; i < len; i++) {
+            random[i] = rand();
+        }
+
+        auto bench = [&](std::function<uint16_t(const uint8_t*, uint32_t)> crcFunc, uint16_t& crc) -> uint64_t {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t n = 0U; n < ITERATIONS; n++) {
+                random[0U] = (uint8_t)n;
+                crc ^= crcFunc(random, lenBits);
+            }
+
+            return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        uint16_t refCrc = 0U, tableCrc = 0U;
+        uint64_t reference = bench(referenceCRC16, refCrc);
+        uint64_t table = bench(CRC::createCRC16, tableCrc);
+
+        ::LogDebug("T", "16_Throughput_Benchmark, %u frames of %u bytes, reference = %lluus, table = %lluus",
+            ITERATIONS, len, (unsigned long long)reference, (unsigned long long)table);
+
+        free(random);
+        REQUIRE(refCrc == tableCrc);
+    }
 }
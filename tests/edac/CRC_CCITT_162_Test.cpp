@@ -18,6 +18,26 @@ using namespace edac;
 #include <stdlib.h>
 #include <time.h>
 
+/* Bit-at-a-time reference CCITT-162 CRC, used to verify the table driven implementation. */
+
+static uint16_t referenceCCITT162(const uint8_t* in, uint32_t length)
+{
+    uint16_t crc = 0x0000U;
+
+    for (uint32_t i = 0U; i < length * 8U; i++) {
+        bool bit1 = (in[i >> 3] & (0x80U >> (i & 7U))) != 0x00U;
+        bool bit2 = (crc & 0x8000U) == 0x8000U;
+
+        crc <<= 1;
+
+        if (bit1 ^ bit2)
+            crc ^= 0x1021U;
+    }
+
+    crc = ~crc;
+    return crc;
+}
+
 TEST_CASE("CRC", "[16-bit CCITT-162 Test]") {
     SECTION("CCITT-162_Sanity_Test") {
         bool failed = false;
@@ -61,4 +81,34 @@ cleanup:
         delete random;
         REQUIRE(failed==false);
     }
+
+    SECTION("CCITT-162_Table_Equivalence_Test") {
+        bool failed = false;
+
+        INFO("CRC CCITT-162 16-bit CRC Table Equivalence Test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 256U;
+        uint8_t* random = (uint8_t*)malloc(len);
+
+        for (uint32_t n = 3U; n < len; n++) {
+            for (size_t i = 0; i < len; i++) {
+                random[i] = rand();
+            }
+
+            uint16_t expected = referenceCCITT162(random, n - 2U);
+            CRC::addCCITT162(random, n);
+
+            uint16_t crc = (random[n - 2U] << 8) | (random[n - 1U] << 0);
+            if (crc != expected) {
+                ::LogDebug("T", "CCITT-162_Table_Equivalence_Test, len = %u, crc = $%04X, expected = $%04X", n, crc, expected);
+                failed = true;
+                break;
+            }
+        }
+
+        free(random);
+        REQUIRE(failed==false);
+    }
 }
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/RadioIdLookup.h"
+#include "common/lookups/TalkgroupRulesLookup.h"
+#include "common/network/PacketBuffer.h"
+#include "common/Log.h"
+#include "fne/network/ACLCache.h"
+
+using namespace network;
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t ACL_TEST_RIDS = 120U;
+
+/**
+ * @brief Helper to read a 32-bit value from a payload.
+ * @param payload Payload.
+ * @param offset Offset of the value.
+ * @returns uint32_t Value.
+ */
+static uint32_t getUInt32(const std::vector<uint8_t>& payload, uint32_t offset)
+{
+    uint32_t value = GET_UINT32(payload, offset);
+    return value;
+}
+
+/**
+ * @brief Helper to decode the RIDs from encoded master control message payloads.
+ * @param payloads Encoded RIDs.
+ * @returns std::vector<uint32_t> Decoded RIDs.
+ */
+static std::vector<uint32_t> decodeRIDs(const ACLPayloadList& payloads)
+{
+    std::vector<uint32_t> rids;
+    for (const std::vector<uint8_t>& payload : payloads) {
+        uint32_t len = getUInt32(payload, 0U);
+        REQUIRE(payload.size() == 4U + (len * 4U));
+        for (uint32_t i = 0U; i < len; i++)
+            rids.push_back(getUInt32(payload, 4U + (i * 4U)));
+    }
+
+    return rids;
+}
+
+/**
+ * @brief Helper to add a talkgroup rule.
+ * @param tidLookup Talkgroup rules lookup.
+ * @param tgId Talkgroup ID.
+ * @param inclusion Peer inclusion list.
+ * @param exclusion Peer exclusion list.
+ * @param preferred Preferred peer list.
+ */
+static void addTalkgroup(TalkgroupRulesLookup& tidLookup, uint32_t tgId, const std::vector<uint32_t>& inclusion,
+    const std::vector<uint32_t>& exclusion, const std::vector<uint32_t>& preferred)
+{
+    TalkgroupRuleGroupVoice groupVoice;
+    groupVoice.name("tg " + std::to_string(tgId));
+
+    TalkgroupRuleGroupVoiceSource source;
+    source.tgId(tgId);
+    source.tgSlot(1U);
+    groupVoice.source(source);
+
+    TalkgroupRuleConfig config;
+    config.active(true);
+    config.inclusion(inclusion);
+    config.exclusion(exclusion);
+    config.preferred(preferred);
+    groupVoice.config(config);
+
+    tidLookup.addEntry(groupVoice);
+}
+
+TEST_CASE("ACLCache", "[ACL Cache Test]") {
+    SECTION("ACLCache_Version_Test") {
+        INFO("ACL Cache Snapshot Version Test");
+
+        RadioIdLookup ridLookup("", 0U, false);
+        TalkgroupRulesLookup tidLookup("", 0U, false);
+        for (uint32_t rid = 1U; rid <= ACL_TEST_RIDS; rid++)
+            ridLookup.addEntry(rid, (rid % 4U) != 0U, "");
+        tidLookup.addEntry(100U, 1U, true);
+
+        // identical lists result in the same version, in any cache
+        ACLCache cache, other;
+        REQUIRE(cache.current() == nullptr);
+        std::shared_ptr<const ACLSnapshot> first = cache.update(&ridLookup, &tidLookup);
+        REQUIRE(first != nullptr);
+        REQUIRE(first->version() != 0U);
+        REQUIRE(other.update(&ridLookup, &tidLookup)->version() == first->version());
+
+        // an update of unchanged lists keeps the current snapshot
+        REQUIRE(cache.update(&ridLookup, &tidLookup) == first);
+        REQUIRE(cache.current() == first);
+
+        // the lists are sorted and split by enabled state
+        REQUIRE(first->ridWhitelist().size() == ACL_TEST_RIDS - (ACL_TEST_RIDS / 4U));
+        REQUIRE(first->ridBlacklist().size() == ACL_TEST_RIDS / 4U);
+        REQUIRE(std::is_sorted(first->ridWhitelist().begin(), first->ridWhitelist().end()));
+        REQUIRE(decodeRIDs(first->whitelistPayloads()) == first->ridWhitelist());
+        REQUIRE(decodeRIDs(first->blacklistPayloads()) == first->ridBlacklist());
+        REQUIRE(first->whitelistPayloads().size() == (first->ridWhitelist().size() + MAX_RID_LIST_CHUNK - 1U) / MAX_RID_LIST_CHUNK);
+
+        // any change to the lists results in a new version
+        ridLookup.addEntry(4U, true, "");
+        std::shared_ptr<const ACLSnapshot> second = cache.update(&ridLookup, &tidLookup);
+        REQUIRE(second != first);
+        REQUIRE(second->version() != first->version());
+
+        tidLookup.addEntry(200U, 1U, true);
+        std::shared_ptr<const ACLSnapshot> third = cache.update(&ridLookup, &tidLookup);
+        REQUIRE(third->version() != second->version());
+        REQUIRE(third->talkgroups().size() == 2U);
+    }
+
+    SECTION("ACLCache_History_Test") {
+        INFO("ACL Cache Snapshot History Test");
+
+        RadioIdLookup ridLookup("", 0U, false);
+        TalkgroupRulesLookup tidLookup("", 0U, false);
+
+        ACLCache cache;
+        REQUIRE(cache.find(0U) == nullptr);
+
+        std::vector<uint32_t> versions;
+        for (uint32_t n = 0U; n <= ACL_SNAPSHOT_HISTORY + 1U; n++) {
+            ridLookup.addEntry(1000U + n, true, "");
+            versions.push_back(cache.update(&ridLookup, &tidLookup)->version());
+        }
+
+        // the current snapshot and the most recent earlier snapshots are retained, older snapshots are not
+        REQUIRE(cache.find(versions.back()) == cache.current());
+        for (uint32_t n = 0U; n < versions.size(); n++) {
+            if (n < versions.size() - 1U - ACL_SNAPSHOT_HISTORY)
+                REQUIRE(cache.find(versions[n]) == nullptr);
+            else
+                REQUIRE(cache.find(versions[n]) != nullptr);
+        }
+    }
+
+    SECTION("ACLCache_Delta_Test") {
+        INFO("ACL Cache Snapshot Delta Test");
+
+        RadioIdLookup ridLookup("", 0U, false);
+        TalkgroupRulesLookup tidLookup("", 0U, false);
+        for (uint32_t rid = 1U; rid <= ACL_TEST_RIDS; rid++)
+            ridLookup.addEntry(rid, true, "");
+
+        ACLCache cache;
+        std::shared_ptr<const ACLSnapshot> from = cache.update(&ridLookup, &tidLookup);
+
+        // whitelist a new RID, and blacklist an existing one
+        ridLookup.addEntry(ACL_TEST_RIDS + 1U, true, "");
+        ridLookup.addEntry(10U, false, "");
+        std::shared_ptr<const ACLSnapshot> to = cache.update(&ridLookup, &tidLookup);
+
+        // only the RIDs that changed are in the delta
+        std::shared_ptr<const ACLDelta> delta = cache.delta(from, to);
+        REQUIRE(delta->fromVersion == from->version());
+        REQUIRE(delta->toVersion == to->version());
+        REQUIRE(decodeRIDs(delta->whitelistPayloads) == std::vector<uint32_t>({ ACL_TEST_RIDS + 1U }));
+        REQUIRE(decodeRIDs(delta->blacklistPayloads) == std::vector<uint32_t>({ 10U }));
+
+        // the delta is computed once and shared
+        REQUIRE(cache.delta(from, to) == delta);
+
+        // a delta between identical snapshots is empty
+        std::shared_ptr<const ACLDelta> none = cache.delta(to, to);
+        REQUIRE(none->whitelistPayloads.empty());
+        REQUIRE(none->blacklistPayloads.empty());
+    }
+
+    SECTION("ACLCache_Peer_Talkgroups_Test") {
+        INFO("ACL Cache Peer Talkgroups Test");
+
+        RadioIdLookup ridLookup("", 0U, false);
+        TalkgroupRulesLookup tidLookup("", 0U, false);
+        tidLookup.sendTalkgroups(true);
+        addTalkgroup(tidLookup, 1U, { 10U }, { }, { });
+        addTalkgroup(tidLookup, 2U, { }, { 10U }, { });
+        addTalkgroup(tidLookup, 3U, { }, { }, { 20U });
+        tidLookup.addEntry(4U, 1U, false);
+
+        ACLCache cache;
+        std::shared_ptr<const ACLSnapshot> snapshot = cache.update(&ridLookup, &tidLookup);
+        REQUIRE(snapshot->sendTalkgroups());
+
+        // inclusion and exclusion lists limit the talkgroups a peer gets, preferred lists flag the slot
+        std::vector<std::pair<uint32_t, uint8_t>> active, deactive;
+        snapshot->peerTalkgroups(10U, active, deactive);
+        REQUIRE(active == std::vector<std::pair<uint32_t, uint8_t>>({ { 1U, 1U }, { 3U, 0x81U } }));
+        REQUIRE(deactive == std::vector<std::pair<uint32_t, uint8_t>>({ { 4U, 1U } }));
+
+        snapshot->peerTalkgroups(20U, active, deactive);
+        REQUIRE(active == std::vector<std::pair<uint32_t, uint8_t>>({ { 2U, 1U }, { 3U, 1U } }));
+
+        // talkgroups are encoded as a count followed by the ID and slot of each talkgroup
+        std::vector<uint8_t> payload = ACLSnapshot::encodeTGIDs(active);
+        REQUIRE(payload.size() == 4U + (2U * 5U));
+        REQUIRE(getUInt32(payload, 0U) == 2U);
+        REQUIRE(getUInt32(payload, 9U) == 3U);
+        REQUIRE(payload[13U] == 1U);
+    }
+
+    SECTION("ACLCache_PeerLink_File_Test") {
+        INFO("ACL Cache Peer-Link File Test");
+
+        char filename[] = "/tmp/dvm_acl_cache_XXXXXX";
+        int fd = ::mkstemp(filename);
+        REQUIRE(fd >= 0);
+        ::close(fd);
+
+        std::ofstream file(filename);
+        for (uint32_t rid = 1U; rid <= ACL_TEST_RIDS; rid++)
+            file << rid << ",1,RID " << rid << ",\n";
+        file.close();
+
+        RadioIdLookup ridLookup("", 0U, false);
+        TalkgroupRulesLookup tidLookup("", 0U, false);
+
+        ACLCache cache;
+        REQUIRE(cache.peerLinkFile(ACLCache::PL_FILE_RID, "") == nullptr);
+        REQUIRE(cache.peerLinkFile(ACLCache::PL_FILE_TGID, "/tmp/dvm_acl_cache_missing") == nullptr);
+
+        // the file is encoded once into full fragments, and shared until the next update
+        std::shared_ptr<const ACLPeerLinkFile> first = cache.peerLinkFile(ACLCache::PL_FILE_RID, filename);
+        REQUIRE(first != nullptr);
+        REQUIRE(!first->fragments.empty());
+        for (const std::vector<uint8_t>& frag : first->fragments)
+            REQUIRE(frag.size() == FRAG_SIZE);
+        REQUIRE(cache.peerLinkFile(ACLCache::PL_FILE_RID, filename) == first);
+
+        // an unchanged file keeps its encoding across an update
+        cache.update(&ridLookup, &tidLookup);
+        REQUIRE(cache.peerLinkFile(ACLCache::PL_FILE_RID, filename) == first);
+
+        // a changed file is re-encoded with a new version after an update
+        std::ofstream append(filename, std::ios::app);
+        append << "999999,0,Disabled,\n";
+        append.close();
+
+        REQUIRE(cache.peerLinkFile(ACLCache::PL_FILE_RID, filename) == first);
+        cache.update(&ridLookup, &tidLookup);
+        std::shared_ptr<const ACLPeerLinkFile> second = cache.peerLinkFile(ACLCache::PL_FILE_RID, filename);
+        REQUIRE(second != nullptr);
+        REQUIRE(second != first);
+        REQUIRE(second->version != first->version);
+
+        ::remove(filename);
+    }
+}
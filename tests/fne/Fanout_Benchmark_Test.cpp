@@ -0,0 +1,324 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/RTPFNEHeader.h"
+#include "common/network/udp/Socket.h"
+#include "common/Log.h"
+#include "fne/network/FNENetwork.h"
+#include "fne/network/PeerFanout.h"
+
+using namespace network;
+using namespace network::frame;
+using namespace network::udp;
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t FANOUT_FRAMES = 100U;
+const uint32_t FANOUT_FRAME_LEN = 178U;
+const uint32_t FANOUT_EXCLUSIONS = 16U;
+const uint32_t FANOUT_PEER_COUNTS[] = { 8U, 64U, 256U, 1024U };
+const uint32_t FANOUT_FNE_PEER_ID = 9000123U;
+const uint32_t FANOUT_STREAM_ID = 5150U;
+
+/**
+ * @brief Helper to open a loopback socket on a free port.
+ * @param[out] addr Address of the opened socket.
+ * @param[out] addrLen Length of address structure.
+ * @returns Socket* Opened socket.
+ */
+static Socket* openLoopback(sockaddr_storage& addr, uint32_t& addrLen)
+{
+    // find a free port
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    struct sockaddr_in sin;
+    ::memset(&sin, 0x00, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sin.sin_port = 0;
+    ::bind(fd, (struct sockaddr*)&sin, sizeof(sin));
+
+    socklen_t len = sizeof(sin);
+    ::getsockname(fd, (struct sockaddr*)&sin, &len);
+    ::close(fd);
+
+    uint16_t port = ntohs(sin.sin_port);
+
+    Socket* socket = new Socket("127.0.0.1", port);
+    REQUIRE(socket->open());
+    REQUIRE(Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+    return socket;
+}
+
+/**
+ * @brief Helper to build a peer map, with every other peer affiliated to the call talkgroup.
+ * @param peerCount Number of peers.
+ * @param addr Address every peer connection is addressed to (or nullptr, to give every peer its own port).
+ * @param addrLen Length of address structure.
+ * @param peers Peer map.
+ * @param affiliated Set of affiliated peers.
+ */
+static void buildPeers(uint32_t peerCount, const sockaddr_storage* addr, uint32_t addrLen,
+    concurrent::rcu_unordered_map<uint32_t, FNEPeerConnection*>& peers, std::unordered_set<uint32_t>& affiliated)
+{
+    for (uint32_t i = 0U; i < peerCount; i++) {
+        uint32_t peerId = 1000U + i;
+
+        sockaddr_storage peerAddr;
+        uint32_t peerAddrLen = addrLen;
+        if (addr != nullptr) {
+            peerAddr = *addr;
+        } else {
+            ::memset(&peerAddr, 0x00, sizeof(peerAddr));
+            sockaddr_in* sin = (sockaddr_in*)&peerAddr;
+            sin->sin_family = AF_INET;
+            sin->sin_port = htons((uint16_t)(40000U + i));
+            sin->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            peerAddrLen = sizeof(sockaddr_in);
+        }
+
+        peers.set(peerId, new FNEPeerConnection(peerId, peerAddr, peerAddrLen));
+
+        if ((i % 2U) == 0U)
+            affiliated.insert(peerId);
+    }
+}
+
+/**
+ * @brief Helper to release the peer connections of a peer map.
+ * @param peers Peer map.
+ */
+static void releasePeers(concurrent::rcu_unordered_map<uint32_t, FNEPeerConnection*>& peers)
+{
+    for (auto peer : peers.snapshot())
+        delete peer.second;
+    peers.clear();
+}
+
+/**
+ * @brief Helper to receive a datagram.
+ * @param socket Socket to receive on.
+ * @returns std::vector<uint8_t> Received datagram (empty if nothing was received).
+ */
+static std::vector<uint8_t> receive(Socket* socket)
+{
+    struct pollfd pfd;
+    pfd.fd = socket->getDescriptor();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, 1000) <= 0)
+        return std::vector<uint8_t>();
+
+    std::vector<uint8_t> buffer(DATA_PACKET_LENGTH);
+    ssize_t len = ::recv(socket->getDescriptor(), buffer.data(), buffer.size(), 0);
+    buffer.resize((len > 0) ? (size_t)len : 0U);
+    return buffer;
+}
+
+TEST_CASE("Fanout", "[Benchmark Test]") {
+    SECTION("Fanout_Equivalence_Test") {
+        INFO("Call Fan-out Equivalence Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+        FrameQueue txQueue(txSocket, FANOUT_FNE_PEER_ID, false);
+
+        concurrent::rcu_unordered_map<uint32_t, FNEPeerConnection*> peers;
+        std::unordered_set<uint32_t> affiliated;
+        buildPeers(64U, &rxAddr, rxAddrLen, peers, affiliated);
+
+        uint32_t srcPeerId = 1000U;
+        auto permitted = [&](uint32_t peerId) { return affiliated.find(peerId) != affiliated.end(); };
+
+        FanoutPeerList fanout = PeerFanout::resolve(peers, srcPeerId, permitted);
+
+        // the resolved list must contain exactly the peers the per-frame filter would have sent to
+        std::vector<uint32_t> expected;
+        for (auto peer : peers.snapshot()) {
+            if (peer.first != srcPeerId && permitted(peer.first))
+                expected.push_back(peer.first);
+        }
+
+        std::vector<uint32_t> actual;
+        for (const FanoutPeer& peer : *fanout) {
+            actual.push_back(peer.peerId);
+            REQUIRE(peer.addrLen == rxAddrLen);
+            REQUIRE(::memcmp(&peer.address, &rxAddr, sizeof(sockaddr_storage)) == 0);
+        }
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        REQUIRE(actual == expected);
+
+        // a frame written to the resolved list is delivered once to every permitted peer
+        uint8_t message[FANOUT_FRAME_LEN];
+        ::memset(message, 0xA5U, sizeof(message));
+
+        FrameQueue::PreparedFrame frame;
+        REQUIRE(txQueue.prepareMessage(frame, message, FANOUT_FRAME_LEN, FANOUT_STREAM_ID, FANOUT_FNE_PEER_ID,
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }));
+        for (const FanoutPeer& peer : *fanout)
+            PeerFanout::write(&txQueue, peer, frame, 0U);
+        REQUIRE(txQueue.flushQueue());
+
+        std::vector<uint32_t> delivered;
+        for (uint32_t i = 0U; i < fanout->size(); i++) {
+            std::vector<uint8_t> data = receive(rxSocket);
+            REQUIRE(data.size() == DVM_FRAME_HEADER_LENGTH_BYTES + FANOUT_FRAME_LEN);
+
+            RTPFNEHeader fneHeader;
+            REQUIRE(fneHeader.decode(data.data() + RTP_HEADER_LENGTH_BYTES));
+            REQUIRE(fneHeader.getStreamId() == FANOUT_STREAM_ID);
+            delivered.push_back(fneHeader.getPeerId());
+        }
+
+        std::sort(delivered.begin(), delivered.end());
+        REQUIRE(delivered == expected);
+
+        releasePeers(peers);
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+
+    SECTION("Fanout_Route_Test") {
+        INFO("Talkgroup Route Resolution Test");
+
+        TalkgroupRouteTable routes;
+        uint32_t resolves = 0U;
+        auto resolver = [&]() {
+            resolves++;
+            return FanoutPeerList(new std::vector<FanoutPeer>());
+        };
+
+        // a route is resolved once, and then reused for as long as its generations don't change
+        FanoutPeerList first = PeerFanout::resolveRoute(routes, 1U, 1U, 1U, 1U, resolver);
+        REQUIRE(resolves == 1U);
+        REQUIRE(PeerFanout::resolveRoute(routes, 1U, 1U, 1U, 1U, resolver) == first);
+        REQUIRE(resolves == 1U);
+
+        // a changed peer or talkgroup generation resolves the route again
+        REQUIRE(PeerFanout::resolveRoute(routes, 1U, 2U, 1U, 1U, resolver) != first);
+        REQUIRE(resolves == 2U);
+        PeerFanout::resolveRoute(routes, 1U, 2U, 2U, 1U, resolver);
+        REQUIRE(resolves == 3U);
+
+        PeerFanout::resolveRoute(routes, 2U, 2U, 2U, 1U, resolver);
+        REQUIRE(resolves == 4U);
+        REQUIRE(routes.routes.size() == 2U);
+
+        // a changed talkgroup rules version evicts every route
+        PeerFanout::resolveRoute(routes, 2U, 2U, 2U, 2U, resolver);
+        REQUIRE(resolves == 5U);
+        REQUIRE(routes.routes.size() == 1U);
+    }
+
+    SECTION("Fanout_PerFrame_Benchmark") {
+        INFO("Call Fan-out Per-Frame Cost Benchmark");
+
+        // measures the per-frame cost of repeating a voice frame to every permitted peer, filtering the peer map
+        // for every frame (as the call handlers used to) versus walking the fan-out list resolved once per stream
+        sockaddr_storage txAddr;
+        uint32_t txAddrLen = 0U;
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+        FrameQueue txQueue(txSocket, FANOUT_FNE_PEER_ID, false);
+
+        uint8_t message[FANOUT_FRAME_LEN];
+        ::memset(message, 0xA5U, sizeof(message));
+
+        std::vector<uint32_t> exclusions;
+        for (uint32_t i = 0U; i < FANOUT_EXCLUSIONS; i++)
+            exclusions.push_back(900000U + i);
+
+        for (uint32_t peerCount : FANOUT_PEER_COUNTS) {
+            concurrent::rcu_unordered_map<uint32_t, FNEPeerConnection*> peers;
+            std::unordered_set<uint32_t> affiliated;
+            buildPeers(peerCount, nullptr, 0U, peers, affiliated);
+
+            uint32_t srcPeerId = 1000U;
+
+            // approximates isPeerPermitted(), a talkgroup exclusion list scan followed by an affiliation lookup
+            std::function<bool(uint32_t)> permitted = [&](uint32_t peerId) {
+                if (std::find(exclusions.begin(), exclusions.end(), peerId) != exclusions.end())
+                    return false;
+                return affiliated.find(peerId) != affiliated.end();
+            };
+
+            uint64_t filteredSent = 0U, resolvedSent = 0U;
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t n = 0U; n < FANOUT_FRAMES; n++) {
+                FrameQueue::PreparedFrame frame;
+                txQueue.prepareMessage(frame, message, FANOUT_FRAME_LEN, FANOUT_STREAM_ID, FANOUT_FNE_PEER_ID,
+                    { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 });
+
+                for (auto peer : peers.snapshot()) {
+                    if (peer.first == srcPeerId || !permitted(peer.first))
+                        continue;
+
+                    FanoutPeer dst;
+                    dst.peerId = peer.first;
+                    dst.address = peer.second->socketStorage();
+                    dst.addrLen = peer.second->sockStorageLen();
+                    PeerFanout::write(&txQueue, dst, frame, (uint16_t)n);
+                    filteredSent++;
+                }
+                txQueue.flushQueue();
+            }
+            uint64_t filteredUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+            start = std::chrono::steady_clock::now();
+            FanoutPeerList fanout = PeerFanout::resolve(peers, srcPeerId, permitted);
+            for (uint32_t n = 0U; n < FANOUT_FRAMES; n++) {
+                FrameQueue::PreparedFrame frame;
+                txQueue.prepareMessage(frame, message, FANOUT_FRAME_LEN, FANOUT_STREAM_ID, FANOUT_FNE_PEER_ID,
+                    { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 });
+
+                for (const FanoutPeer& peer : *fanout) {
+                    PeerFanout::write(&txQueue, peer, frame, (uint16_t)n);
+                    resolvedSent++;
+                }
+                txQueue.flushQueue();
+            }
+            uint64_t resolvedUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+            ::LogDebug("T", "Fanout_PerFrame_Benchmark, peers = %u, frames = %u, per-frame filter = %.3f us/frame, resolved list = %.3f us/frame",
+                peerCount, FANOUT_FRAMES, (double)filteredUs / FANOUT_FRAMES, (double)resolvedUs / FANOUT_FRAMES);
+
+            // both paths deliver the same number of frames (the timings are only logged, they depend on the host)
+            REQUIRE(filteredSent == resolvedSent);
+            REQUIRE(filteredSent == (uint64_t)fanout->size() * FANOUT_FRAMES);
+
+            releasePeers(peers);
+        }
+
+        txSocket->close();
+        delete txSocket;
+    }
+}
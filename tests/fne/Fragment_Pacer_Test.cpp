@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "fne/network/FragmentPacer.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t PACER_INTERVAL = 60U;
+
+/**
+ * @brief Helper to build a list of fragments, each filled with its transfer and block number.
+ * @param transfer Transfer number.
+ * @param count Number of fragments.
+ * @returns std::shared_ptr<const FragmentList> List of fragments.
+ */
+static std::shared_ptr<const FragmentList> makeFragments(uint8_t transfer, uint32_t count)
+{
+    std::shared_ptr<FragmentList> fragments = std::make_shared<FragmentList>();
+    for (uint32_t i = 0U; i < count; i++)
+        fragments->push_back(std::vector<uint8_t>({ transfer, (uint8_t)i }));
+    return fragments;
+}
+
+TEST_CASE("FragmentPacer", "[Fragment Pacer Test]") {
+    SECTION("FragmentPacer_Pacing_Test") {
+        INFO("Fragment Pacer Pacing Test");
+
+        FragmentPacer pacer(PACER_INTERVAL);
+
+        // (destination, transfer, block) of every written fragment
+        std::vector<std::vector<uint8_t>> written;
+        auto writer = [&](uint8_t dest) {
+            return [&, dest](const uint8_t* data, uint32_t length) {
+                REQUIRE(length == 2U);
+                written.push_back({ dest, data[0U], data[1U] });
+            };
+        };
+
+        pacer.enqueue(1U, makeFragments(0U, 3U), writer(1U));
+        pacer.enqueue(1U, makeFragments(1U, 2U), writer(1U));
+        pacer.enqueue(2U, makeFragments(2U, 2U), writer(2U));
+        REQUIRE(pacer.pending() == 7U);
+
+        // queuing a transfer writes nothing, the first fragment to each destination is written on the next clock
+        REQUIRE(written.empty());
+        uint64_t now = 1000U;
+        REQUIRE(pacer.clock(now) == 2U);
+
+        // nothing more is written to a destination until the pacing interval elapsed
+        REQUIRE(pacer.clock(now + PACER_INTERVAL - 1U) == 0U);
+        REQUIRE(pacer.clock(now + PACER_INTERVAL) == 2U);
+
+        for (uint32_t i = 2U; i < 6U; i++)
+            pacer.clock(now + (PACER_INTERVAL * i));
+        REQUIRE(pacer.pending() == 0U);
+
+        // transfers to a destination are written whole and in order, one fragment per interval
+        std::vector<std::vector<uint8_t>> dest1, dest2;
+        for (const std::vector<uint8_t>& w : written)
+            (w[0U] == 1U ? dest1 : dest2).push_back({ w[1U], w[2U] });
+        REQUIRE(dest1 == std::vector<std::vector<uint8_t>>({ { 0U, 0U }, { 0U, 1U }, { 0U, 2U }, { 1U, 0U }, { 1U, 1U } }));
+        REQUIRE(dest2 == std::vector<std::vector<uint8_t>>({ { 2U, 0U }, { 2U, 1U } }));
+
+        // a transfer queued right after the last one finished is still paced
+        now += PACER_INTERVAL * 10U;
+        pacer.enqueue(3U, makeFragments(3U, 1U), writer(3U));
+        REQUIRE(pacer.clock(now) == 1U);
+        pacer.enqueue(3U, makeFragments(4U, 1U), writer(3U));
+        REQUIRE(pacer.clock(now + 1U) == 0U);
+        REQUIRE(pacer.clock(now + PACER_INTERVAL) == 1U);
+        REQUIRE(pacer.pending() == 0U);
+    }
+
+    SECTION("FragmentPacer_Cancel_Test") {
+        INFO("Fragment Pacer Cancel Test");
+
+        FragmentPacer pacer(PACER_INTERVAL);
+        uint32_t written = 0U;
+        FragmentWriter writer = [&](const uint8_t*, uint32_t) { written++; };
+
+        pacer.enqueue(1U, makeFragments(0U, 4U), writer);
+        pacer.enqueue(2U, makeFragments(1U, 4U), writer);
+        REQUIRE(pacer.clock(0U) == 2U);
+
+        // a cancelled destination gets nothing further, other destinations are unaffected
+        pacer.cancel(1U);
+        REQUIRE(pacer.pending() == 3U);
+        for (uint32_t i = 1U; i <= 4U; i++)
+            pacer.clock(PACER_INTERVAL * i);
+        REQUIRE(written == 5U);
+
+        // empty transfers are ignored
+        pacer.enqueue(3U, makeFragments(2U, 0U), writer);
+        pacer.enqueue(3U, nullptr, writer);
+        REQUIRE(pacer.pending() == 0U);
+    }
+}
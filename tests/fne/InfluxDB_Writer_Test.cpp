@@ -0,0 +1,407 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Log.h"
+#include "fne/network/influxdb/InfluxDB.h"
+
+using namespace network::influxdb;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Minimal HTTP listener standing in for an InfluxDB server.
+ */
+class StubHTTPListener {
+public:
+    /**
+     * @brief Initializes a new instance of the StubHTTPListener class.
+     * @param closeAfterResponse Flag indicating the connection is closed after every response.
+     * @param responseDelay Delay (in milliseconds) before every response.
+     * @param dropResponse Flag indicating the connection is closed after every request, without a response.
+     */
+    StubHTTPListener(bool closeAfterResponse = false, uint32_t responseDelay = 0U, bool dropResponse = false) :
+        m_fd(-1),
+        m_port(0U),
+        m_closeAfterResponse(closeAfterResponse),
+        m_responseDelay(responseDelay),
+        m_dropResponse(dropResponse),
+        m_running(false),
+        m_connections(0U),
+        m_requests(0U),
+        m_mutex(),
+        m_bodies()
+    {
+        m_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        struct sockaddr_in addr;
+        ::memset(&addr, 0x00, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(m_fd, (struct sockaddr*)&addr, sizeof(addr));
+        ::listen(m_fd, 8);
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(m_fd, (struct sockaddr*)&addr, &len);
+        m_port = ntohs(addr.sin_port);
+
+        m_running = true;
+        m_thread = std::thread([this]() { accept(); });
+    }
+    /**
+     * @brief Finalizes a instance of the StubHTTPListener class.
+     */
+    ~StubHTTPListener()
+    {
+        m_running = false;
+        ::shutdown(m_fd, SHUT_RDWR);
+        ::close(m_fd);
+        m_thread.join();
+    }
+
+    uint16_t port() const { return m_port; }
+    uint32_t connections() const { return m_connections.load(); }
+    uint32_t requests() const { return m_requests.load(); }
+
+    /**
+     * @brief Gets all received request bodies, concatenated.
+     * @returns std::string Received request bodies.
+     */
+    std::string bodies()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bodies;
+    }
+
+private:
+    int m_fd;
+    uint16_t m_port;
+    bool m_closeAfterResponse;
+    uint32_t m_responseDelay;
+    bool m_dropResponse;
+    std::atomic<bool> m_running;
+    std::atomic<uint32_t> m_connections;
+    std::atomic<uint32_t> m_requests;
+    std::mutex m_mutex;
+    std::string m_bodies;
+    std::thread m_thread;
+
+    /**
+     * @brief Accepts and services connections (one at a time).
+     */
+    void accept()
+    {
+        while (m_running) {
+            int fd = ::accept(m_fd, nullptr, nullptr);
+            if (fd < 0)
+                break;
+
+            m_connections++;
+            serve(fd);
+            ::close(fd);
+        }
+    }
+
+    /**
+     * @brief Services requests on a connection until it is closed.
+     * @param fd Connection socket.
+     */
+    void serve(int fd)
+    {
+        std::string buffer;
+        char chunk[4096];
+        while (m_running) {
+            // read the request header
+            size_t headerEnd = std::string::npos;
+            while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t ret = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (ret <= 0)
+                    return;
+                buffer.append(chunk, ret);
+            }
+
+            size_t contentLength = 0U;
+            size_t pos = buffer.find("Content-Length: ");
+            if (pos != std::string::npos && pos < headerEnd)
+                contentLength = (size_t)::strtoul(buffer.c_str() + pos + 16U, nullptr, 10);
+
+            // read the request body
+            while (buffer.length() < headerEnd + 4U + contentLength) {
+                ssize_t ret = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (ret <= 0)
+                    return;
+                buffer.append(chunk, ret);
+            }
+
+            // scope is intentional
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bodies.append(buffer, headerEnd + 4U, contentLength);
+            }
+            buffer.erase(0U, headerEnd + 4U + contentLength);
+            m_requests++;
+
+            if (m_dropResponse)
+                return;
+
+            if (m_responseDelay > 0U)
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_responseDelay));
+
+            const char* response = (m_closeAfterResponse) ?
+                "HTTP/1.1 204 No Content\r\nConnection: close\r\n\r\n" :
+                "HTTP/1.1 204 No Content\r\nX-Influxdb-Version: v2.7.1\r\n\r\n";
+            ::send(fd, response, ::strlen(response), MSG_NOSIGNAL);
+
+            if (m_closeAfterResponse)
+                return;
+        }
+    }
+};
+
+/**
+ * @brief Helper to count the lines in a buffer.
+ * @param str Buffer.
+ * @returns uint32_t Number of lines.
+ */
+static uint32_t countLines(const std::string& str)
+{
+    uint32_t lines = 0U;
+    for (char c : str) {
+        if (c == '\n')
+            lines++;
+    }
+
+    return lines;
+}
+
+/**
+ * @brief Helper to wait for the writer to finish writing (or fail to write) the given number of points.
+ * @param writer InfluxDB writer.
+ * @param points Number of points.
+ * @returns bool True, if the points were written (or failed), otherwise false.
+ */
+static bool waitForPoints(Writer& writer, uint64_t points)
+{
+    for (uint32_t i = 0U; i < 5000U; i++) {
+        WriterStats stats = writer.stats();
+        if (stats.written + stats.failed >= points)
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return false;
+}
+
+TEST_CASE("InfluxDB", "[Writer Test]") {
+    SECTION("Line_Format_Test") {
+        INFO("InfluxDB Line Protocol Format Test");
+
+        std::string line = QueryBuilder()
+            .meas("call event")
+                .tag("peer,Id", "1234")
+                .tag("name", "a=b")
+                    .field("message", "say \"hi\"")
+                    .field("srcId", 9999U)
+                    .field("offset", -42)
+                    .field("max", (uint64_t)18446744073709551615ULL)
+                    .field("ratio", 0.125, 3)
+                    .field("lost", true)
+                .timestamp(1700000000000000000ULL)
+            .str();
+        REQUIRE(line == "call\\ event,peer\\,Id=1234,name=a\\=b message=\"say \\\"hi\\\"\",srcId=9999i,offset=-42i,max=18446744073709551615i,ratio=0.125,lost=t 1700000000000000000");
+
+        // multiple points built by a single builder
+        QueryBuilder builder;
+        std::string lines = builder
+            .meas("a")
+                .field("v", 1)
+            .timestamp(1U)
+            .meas("b")
+                .field("v", false)
+            .timestamp(2U)
+            .str();
+        REQUIRE(lines == "a v=1i 1\nb v=f 2");
+        REQUIRE(builder.points() == 2U);
+
+        // lines longer than the fixed buffer
+        std::string value(INFLUX_LINE_BUFFER_LEN * 2U, 'x');
+        std::string longLine = QueryBuilder()
+            .meas("long")
+                .field("value", value)
+            .timestamp(3U)
+            .str();
+        REQUIRE(longLine == "long value=\"" + value + "\" 3");
+    }
+
+    SECTION("Batched_KeepAlive_Test") {
+        INFO("InfluxDB Batched Keep-Alive Writer Test");
+
+        const uint32_t POINTS = 2000U;
+
+        StubHTTPListener listener;
+        ServerInfo si = ServerInfo("127.0.0.1", listener.port(), "dvm", "token", "dvm");
+
+        Writer writer;
+        REQUIRE(writer.start(si, 50U, 16384U, 1048576U));
+
+        for (uint32_t i = 0U; i < POINTS; i++) {
+            QueryBuilder builder;
+            builder.meas("point")
+                .tag("peerId", "1234")
+                    .field("seq", i)
+                .timestamp(i);
+            REQUIRE(writer.write(si, builder.data(), builder.length(), builder.points()));
+        }
+
+        writer.stop();
+
+        WriterStats stats = writer.stats();
+        ::LogDebug("T", "Batched_KeepAlive_Test, written = %llu, batches = %llu, connects = %llu, requests = %u",
+            (unsigned long long)stats.written, (unsigned long long)stats.batches, (unsigned long long)stats.connects, listener.requests());
+
+        REQUIRE(stats.written == POINTS);
+        REQUIRE(stats.dropped == 0U);
+        REQUIRE(stats.failed == 0U);
+        REQUIRE(stats.queuedPoints == 0U);
+
+        // all points are written in a handful of requests, over a single connection
+        REQUIRE(stats.connects == 1U);
+        REQUIRE(listener.connections() == 1U);
+        REQUIRE(listener.requests() == stats.batches);
+        REQUIRE(stats.batches < POINTS / 10U);
+        REQUIRE(countLines(listener.bodies()) == POINTS);
+    }
+
+    SECTION("Connection_Close_Test") {
+        INFO("InfluxDB Writer Connection Close Test");
+
+        StubHTTPListener listener(true);
+        ServerInfo si = ServerInfo("127.0.0.1", listener.port(), "dvm", "token", "dvm");
+
+        Writer writer;
+        REQUIRE(writer.start(si, 10U));
+
+        // every batch requires a new connection, as the server closes the connection after every response
+        for (uint32_t i = 0U; i < 3U; i++) {
+            std::string line = QueryBuilder().meas("point").field("seq", i).timestamp(i).str();
+            REQUIRE(writer.write(si, line.c_str(), line.length(), 1U));
+            writer.flush();
+            REQUIRE(waitForPoints(writer, i + 1U));
+        }
+
+        writer.stop();
+
+        WriterStats stats = writer.stats();
+        REQUIRE(stats.written == 3U);
+        REQUIRE(stats.failed == 0U);
+        REQUIRE(stats.connects == 3U);
+        REQUIRE(listener.connections() == 3U);
+    }
+
+    SECTION("Lost_Response_Test") {
+        INFO("InfluxDB Writer Lost Response Test");
+
+        // the server closes the connection after reading each request, without responding
+        StubHTTPListener listener(false, 0U, true);
+        ServerInfo si = ServerInfo("127.0.0.1", listener.port(), "dvm", "token", "dvm");
+
+        Writer writer;
+        REQUIRE(writer.start(si, 10U));
+
+        std::string line = QueryBuilder().meas("point").field("seq", 1).timestamp(1U).str();
+        REQUIRE(writer.write(si, line.c_str(), line.length(), 1U));
+        writer.flush();
+        REQUIRE(waitForPoints(writer, 1U));
+
+        // a request that was sent is never resent, as the server may have written its points
+        line = QueryBuilder().meas("point").field("seq", 2).timestamp(2U).str();
+        REQUIRE(writer.write(si, line.c_str(), line.length(), 1U));
+
+        writer.stop();
+
+        WriterStats stats = writer.stats();
+        REQUIRE(stats.written == 0U);
+        REQUIRE(stats.failed == 2U);
+        REQUIRE(stats.connects == 2U);
+        REQUIRE(listener.requests() == 2U);
+        REQUIRE(countLines(listener.bodies()) == 2U);
+    }
+
+    SECTION("Backpressure_Test") {
+        INFO("InfluxDB Writer Backpressure Test");
+
+        const uint32_t POINTS = 5000U;
+
+        // a slow server, with a queue that can only hold a fraction of the points
+        StubHTTPListener listener(false, 100U);
+        ServerInfo si = ServerInfo("127.0.0.1", listener.port(), "dvm", "token", "dvm");
+
+        Writer writer;
+        REQUIRE(writer.start(si, 10U, 4096U, 8192U));
+
+        uint32_t accepted = 0U;
+        for (uint32_t i = 0U; i < POINTS; i++) {
+            std::string line = QueryBuilder().meas("point").field("seq", i).timestamp(i).str();
+            if (writer.write(si, line.c_str(), line.length(), 1U))
+                accepted++;
+        }
+
+        writer.stop();
+
+        WriterStats stats = writer.stats();
+        ::LogDebug("T", "Backpressure_Test, accepted = %u, written = %llu, dropped = %llu",
+            accepted, (unsigned long long)stats.written, (unsigned long long)stats.dropped);
+
+        REQUIRE(stats.dropped > 0U);
+        REQUIRE(stats.written == accepted);
+        REQUIRE(stats.written + stats.dropped == POINTS);
+        REQUIRE(countLines(listener.bodies()) == accepted);
+    }
+
+    SECTION("Unreachable_Server_Test") {
+        INFO("InfluxDB Writer Unreachable Server Test");
+
+        // bind and close a listener to find a port nothing is listening on
+        uint16_t port = 0U;
+        {
+            StubHTTPListener listener;
+            port = listener.port();
+        }
+
+        ServerInfo si = ServerInfo("127.0.0.1", port, "dvm", "token", "dvm");
+
+        Writer writer;
+        REQUIRE(writer.start(si, 10U));
+
+        std::string line = QueryBuilder().meas("point").field("seq", 1).timestamp(1U).str();
+        REQUIRE(writer.write(si, line.c_str(), line.length(), 1U));
+
+        writer.stop();
+
+        WriterStats stats = writer.stats();
+        REQUIRE(stats.written == 0U);
+        REQUIRE(stats.failed == 1U);
+        REQUIRE(stats.connects == 0U);
+    }
+}
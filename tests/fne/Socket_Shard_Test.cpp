@@ -0,0 +1,340 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/udp/Socket.h"
+#include "common/network/FrameQueue.h"
+#include "common/ThreadPool.h"
+#include "common/Log.h"
+#include "fne/network/NetworkShard.h"
+
+using namespace network;
+using namespace network::frame;
+using namespace network::udp;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t SHARD_COUNT = 4U;
+const uint32_t SENDER_COUNT = 32U;
+const uint32_t SENDER_PACKETS = 10U;
+const uint32_t SENDER_STREAMS = 2U;
+const uint32_t SHARD_PEER_ID = 9000123U;
+const uint32_t SHARD_MSG_LEN = 33U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a frame processed by a shard packet processing worker.
+ */
+struct ShardFrame {
+    uint32_t shard;
+    uint32_t peerId;
+    uint32_t streamId;
+    uint16_t seq;
+    std::thread::id worker;
+};
+
+/**
+ * @brief Represents the frames processed by every shard.
+ */
+struct ShardDispatchState {
+    std::mutex mutex;
+    std::vector<ShardFrame> frames;
+    std::atomic<uint32_t> processed;
+
+    ShardDispatchState() : mutex(), frames(), processed(0U) { /* stub */ }
+};
+
+/**
+ * @brief Represents a frame task dispatched to a shard packet processing worker.
+ */
+struct ShardTask {
+    ShardDispatchState* state;
+    ShardFrame frame;
+};
+
+/**
+ * @brief Test task that records the shard and worker a frame was processed by.
+ * @param task Frame task.
+ */
+static void shardTask(ShardTask* task)
+{
+    task->frame.worker = std::this_thread::get_id();
+
+    // scope is intentional
+    {
+        std::lock_guard<std::mutex> lock(task->state->mutex);
+        task->state->frames.push_back(task->frame);
+    }
+
+    task->state->processed++;
+    delete task;
+}
+
+/**
+ * @brief Helper to find a free loopback UDP port.
+ * @returns uint16_t Port number.
+ */
+static uint16_t findFreePort()
+{
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    struct sockaddr_in addr;
+    ::memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    ::bind(fd, (struct sockaddr*)&addr, sizeof(addr));
+
+    socklen_t len = sizeof(addr);
+    ::getsockname(fd, (struct sockaddr*)&addr, &len);
+    ::close(fd);
+
+    return ntohs(addr.sin_port);
+}
+
+/**
+ * @brief Helper to create the read handler for a shard, this reads and dispatches frames the way the FNE does.
+ * @param state Shared dispatch state.
+ * @param shard Index of the shard.
+ * @returns ShardReadHandler Read handler.
+ */
+static ShardReadHandler shardReadHandler(ShardDispatchState* state, uint32_t shard)
+{
+    return [state, shard](FrameQueue* frameQueue, std::vector<FrameQueue::RxFrame>& rxFrames, ThreadPool& threadPool) {
+        int count = frameQueue->readBatch(rxFrames);
+        for (FrameQueue::RxFrame& frame : rxFrames) {
+            ShardTask* task = new ShardTask();
+            task->state = state;
+            task->frame.shard = shard;
+            task->frame.peerId = frame.fneHeader.getPeerId();
+            task->frame.streamId = frame.fneHeader.getStreamId();
+            task->frame.seq = frame.rtpHeader.getSequence();
+
+            if (!threadPool.enqueue(shardTask, task, NetworkShard::dispatchKey(task->frame.peerId, task->frame.streamId)))
+                delete task;
+        }
+
+        return count;
+    };
+}
+
+TEST_CASE("Socket", "[Shard Test]") {
+    SECTION("ReusePort_Shard_Test") {
+        INFO("UDP Socket Reuse Port Shard Test");
+
+        uint16_t port = findFreePort();
+
+        Socket* shards[SHARD_COUNT];
+        for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+            shards[i] = new Socket("127.0.0.1", port);
+            shards[i]->setReusePort(true);
+            REQUIRE(shards[i]->open());
+        }
+
+        sockaddr_storage dest;
+        uint32_t destLen = 0U;
+        REQUIRE(Socket::lookup("127.0.0.1", port, dest, destLen) == 0);
+
+        // every sender has its own source port, and so is hashed to a single shard
+        int senders[SENDER_COUNT];
+        for (uint32_t i = 0U; i < SENDER_COUNT; i++) {
+            senders[i] = ::socket(AF_INET, SOCK_DGRAM, 0);
+            for (uint32_t n = 0U; n < SENDER_PACKETS; n++) {
+                uint8_t buffer[8U];
+                ::memset(buffer, 0x00U, sizeof(buffer));
+                buffer[0U] = (uint8_t)i;
+                buffer[1U] = (uint8_t)n;
+                ::sendto(senders[i], buffer, sizeof(buffer), 0, (struct sockaddr*)&dest, destLen);
+            }
+        }
+
+        std::map<uint16_t, std::set<uint32_t>> sourceShards;
+        std::set<uint32_t> usedShards;
+        uint32_t received = 0U;
+        while (received < SENDER_COUNT * SENDER_PACKETS) {
+            struct pollfd pfds[SHARD_COUNT];
+            for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+                pfds[i].fd = shards[i]->getDescriptor();
+                pfds[i].events = POLLIN;
+                pfds[i].revents = 0;
+            }
+
+            if (::poll(pfds, SHARD_COUNT, 1000) <= 0)
+                break;
+
+            for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+                uint8_t buffer[8U];
+                sockaddr_storage address;
+                uint32_t addrLen = 0U;
+                while (shards[i]->read(buffer, sizeof(buffer), address, addrLen) > 0) {
+                    sourceShards[Socket::port(address)].insert(i);
+                    usedShards.insert(i);
+                    received++;
+                }
+            }
+        }
+
+        ::LogDebug("T", "ReusePort_Shard_Test, received = %u, senders = %u, shards used = %u",
+            received, (uint32_t)sourceShards.size(), (uint32_t)usedShards.size());
+
+        REQUIRE(received == SENDER_COUNT * SENDER_PACKETS);
+        REQUIRE(sourceShards.size() == SENDER_COUNT);
+        for (auto& entry : sourceShards) {
+            REQUIRE(entry.second.size() == 1U);
+        }
+
+        // with this many senders, traffic is spread across more than one shard
+        REQUIRE(usedShards.size() > 1U);
+
+        for (uint32_t i = 0U; i < SENDER_COUNT; i++)
+            ::close(senders[i]);
+        for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+            shards[i]->close();
+            delete shards[i];
+        }
+    }
+
+    SECTION("NetworkShard_Dispatch_Test") {
+        INFO("FNE Network Shard Dispatch Test");
+
+        uint16_t port = findFreePort();
+
+        ThreadPool primary(4U, "test");
+        primary.setSharded(true);
+
+        ShardDispatchState state;
+        NetworkShard* shards[SHARD_COUNT];
+        for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+            shards[i] = new NetworkShard("127.0.0.1", port, i, SHARD_PEER_ID, 8U, false);
+            REQUIRE(shards[i]->open(primary, NetworkShard::shardWorkerCnt(8U, SHARD_COUNT), std::vector<uint32_t>(), shardReadHandler(&state, i)));
+            REQUIRE(shards[i]->threadPool()->isSharded());
+        }
+
+        sockaddr_storage dest;
+        uint32_t destLen = 0U;
+        REQUIRE(Socket::lookup("127.0.0.1", port, dest, destLen) == 0);
+
+        // every sender is a peer, with its own source port, sending frames for several streams
+        std::vector<Socket*> senders;
+        for (uint32_t i = 0U; i < SENDER_COUNT; i++) {
+            Socket* socket = new Socket("127.0.0.1", findFreePort());
+            REQUIRE(socket->open());
+            senders.push_back(socket);
+
+            FrameQueue txQueue(socket, 1000U + i, false);
+            for (uint32_t n = 0U; n < SENDER_PACKETS; n++) {
+                uint8_t message[SHARD_MSG_LEN];
+                ::memset(message, (uint8_t)n, SHARD_MSG_LEN);
+                REQUIRE(txQueue.write(message, SHARD_MSG_LEN, 1U + (n % SENDER_STREAMS), 1000U + i, SHARD_PEER_ID,
+                    { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, (uint16_t)n, dest, destLen));
+            }
+        }
+
+        for (uint32_t i = 0U; i < 5000U && state.processed < SENDER_COUNT * SENDER_PACKETS; i++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        uint64_t completed = 0U;
+        for (uint32_t i = 0U; i < SHARD_COUNT; i++) {
+            shards[i]->close();
+            completed += shards[i]->threadPool()->stats().completed;
+            delete shards[i];
+        }
+
+        for (Socket* socket : senders) {
+            socket->close();
+            delete socket;
+        }
+
+        // every frame was read by the shard its peer hashed to, and processed by that shard's own workers
+        REQUIRE(state.processed == SENDER_COUNT * SENDER_PACKETS);
+        REQUIRE(completed == SENDER_COUNT * SENDER_PACKETS);
+
+        std::map<uint32_t, std::set<uint32_t>> peerShards;
+        std::map<uint64_t, std::set<std::thread::id>> streamWorkers;
+        std::map<uint64_t, int32_t> streamSeq;
+        std::set<uint32_t> usedShards;
+        uint32_t outOfOrder = 0U;
+        for (const ShardFrame& frame : state.frames) {
+            peerShards[frame.peerId].insert(frame.shard);
+            usedShards.insert(frame.shard);
+
+            // a stream is processed by a single worker, in the order it was sent
+            uint64_t stream = ((uint64_t)frame.peerId << 32) | frame.streamId;
+            streamWorkers[stream].insert(frame.worker);
+            auto it = streamSeq.find(stream);
+            if (it != streamSeq.end() && (int32_t)frame.seq <= it->second)
+                outOfOrder++;
+            streamSeq[stream] = frame.seq;
+        }
+
+        REQUIRE(peerShards.size() == SENDER_COUNT);
+        for (auto& entry : peerShards) {
+            REQUIRE(entry.second.size() == 1U);
+        }
+
+        REQUIRE(streamWorkers.size() == SENDER_COUNT * SENDER_STREAMS);
+        for (auto& entry : streamWorkers) {
+            REQUIRE(entry.second.size() == 1U);
+        }
+
+        REQUIRE(outOfOrder == 0U);
+        REQUIRE(usedShards.size() > 1U);
+    }
+
+    SECTION("NetworkShard_Fallback_Test") {
+        INFO("FNE Network Shard Fallback Test");
+
+        // the workers are split between the shards, every shard has at least one worker
+        REQUIRE(NetworkShard::shardWorkerCnt(16U, 1U) == 16U);
+        REQUIRE(NetworkShard::shardWorkerCnt(16U, 4U) == 4U);
+        REQUIRE(NetworkShard::shardWorkerCnt(2U, 4U) == 1U);
+
+        // a shard cannot share a port already bound exclusively by another socket
+        int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+        struct sockaddr_in addr;
+        ::memset(&addr, 0x00, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        REQUIRE(::bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(fd, (struct sockaddr*)&addr, &len);
+        uint16_t port = ntohs(addr.sin_port);
+
+        ThreadPool primary(4U, "test");
+        ShardDispatchState state;
+        NetworkShard shard("127.0.0.1", port, 1U, SHARD_PEER_ID, 8U, false);
+        REQUIRE(!shard.open(primary, 1U, std::vector<uint32_t>(), shardReadHandler(&state, 1U)));
+        REQUIRE(shard.threadPool() == nullptr);
+
+        ::close(fd);
+    }
+}
@@ -0,0 +1,325 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/dmr/lc/csbk/CSBKFactory.h"
+#include "common/nxdn/lc/rcch/RCCHFactory.h"
+#include "common/p25/lc/tsbk/TSBKFactory.h"
+#include "host/CCBcastCache.h"
+#include "host/dmr/packet/ControlSignaling.h"
+#include "host/nxdn/packet/ControlSignaling.h"
+#include "host/p25/packet/ControlSignaling.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <memory>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t TEST_FRAME_LENGTH = 8U;
+const uint32_t TEST_CACHE_MAX = 4U;
+const uint32_t CC_BCAST_CYCLES = 3U;
+
+const uint32_t DMR_BCAST_FRAME_LENGTH = dmr::defines::DMR_FRAME_LENGTH_BYTES + 2U;
+const uint32_t P25_BCAST_FRAME_LENGTH = p25::defines::P25_TSDU_FRAME_LENGTH_BYTES + 2U;
+const uint32_t NXDN_BCAST_FRAME_LENGTH = nxdn::defines::NXDN_FRAME_LENGTH_BYTES + 2U;
+
+/**
+ * @brief Helper to add a test frame (filled with its own key) to the cache.
+ * @param cache Control channel broadcast cache.
+ * @param key Cache key.
+ */
+static void addFrame(CCBcastCache& cache, ulong64_t key)
+{
+    ::memset(cache.add(key), (uint8_t)key, TEST_FRAME_LENGTH);
+}
+
+/**
+ * @brief Helper to check a cached test frame holds its own key.
+ * @param cache Control channel broadcast cache.
+ * @param key Cache key.
+ * @returns bool True, if the frame is cached and holds its key, otherwise false.
+ */
+static bool hasFrame(CCBcastCache& cache, ulong64_t key)
+{
+    const uint8_t* data = cache.find(key);
+    if (data == nullptr)
+        return false;
+
+    for (uint32_t i = 0U; i < TEST_FRAME_LENGTH; i++) {
+        if (data[i] != (uint8_t)key)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Helper to encode a fresh DMR CSBK broadcast, as it is written when it isn't cached.
+ * @param anncType Broadcast announcement type (or 0xFF for an Aloha).
+ * @param[out] data Buffer to encode the frame into.
+ */
+static void encodeDMRBcast(uint8_t anncType, uint8_t* data)
+{
+    if (anncType == 0xFFU) {
+        std::unique_ptr<dmr::lc::csbk::CSBK_ALOHA> csbk = std::make_unique<dmr::lc::csbk::CSBK_ALOHA>();
+        csbk->setNRandWait(2U);
+        csbk->setBackoffNo(1U);
+        dmr::packet::ControlSignaling::encodeCSBK(csbk.get(), 1U, true, data);
+    }
+    else {
+        std::unique_ptr<dmr::lc::csbk::CSBK_BROADCAST> csbk = std::make_unique<dmr::lc::csbk::CSBK_BROADCAST>();
+        csbk->setAnncType(anncType);
+        dmr::packet::ControlSignaling::encodeCSBK(csbk.get(), 1U, true, data);
+    }
+}
+
+/**
+ * @brief Helper to create a fresh P25 TSBK broadcast, as it is queued when it isn't cached.
+ * @param lco TSBK LCO.
+ * @returns std::unique_ptr<p25::lc::TSBK> TSBK broadcast.
+ */
+static std::unique_ptr<p25::lc::TSBK> createP25Bcast(uint8_t lco)
+{
+    using namespace p25::lc::tsbk;
+
+    switch (lco) {
+    case p25::defines::TSBKO::OSP_IDEN_UP:
+        {
+            std::unique_ptr<OSP_IDEN_UP> osp = std::make_unique<OSP_IDEN_UP>();
+            osp->siteIdenEntry(::lookups::IdenTable(1U, 851006250U, 6.25F, -45.0F, 12.5F));
+            return std::move(osp);
+        }
+    case p25::defines::TSBKO::OSP_RFSS_STS_BCAST:
+        return std::make_unique<OSP_RFSS_STS_BCAST>();
+    default:
+        return std::make_unique<OSP_NET_STS_BCAST>();
+    }
+}
+
+/**
+ * @brief Helper to encode a fresh NXDN RCCH broadcast, as it is written when it isn't cached.
+ * @param messageType RCCH message type.
+ * @param[out] data Buffer to encode the frame into.
+ */
+static void encodeNXDNBcast(uint8_t messageType, uint8_t* data)
+{
+    using namespace nxdn::lc::rcch;
+
+    if (messageType == nxdn::defines::MessageType::RCCH_SITE_INFO) {
+        std::unique_ptr<MESSAGE_TYPE_SITE_INFO> rcch = std::make_unique<MESSAGE_TYPE_SITE_INFO>();
+        rcch->setBcchCnt(1U);
+        rcch->setRcchGroupingCnt(1U);
+        rcch->setCcchPagingCnt(2U);
+        rcch->setCcchMultiCnt(2U);
+        rcch->setRcchIterateCount(2U);
+        nxdn::packet::ControlSignaling::encodeRCCH(rcch.get(), nxdn::defines::NXDN_RCCH_LC_LENGTH_BITS, 1U,
+            nxdn::defines::ChStructure::SR_RCCH_HEAD_SINGLE, data);
+    }
+    else {
+        std::unique_ptr<MESSAGE_TYPE_SRV_INFO> rcch = std::make_unique<MESSAGE_TYPE_SRV_INFO>();
+        nxdn::packet::ControlSignaling::encodeRCCH(rcch.get(), nxdn::defines::NXDN_RCCH_LC_LENGTH_BITS / 2U, 1U,
+            nxdn::defines::ChStructure::SR_RCCH_SINGLE, data);
+    }
+}
+
+TEST_CASE("CCBcastCache", "[CC Broadcast Cache Test]") {
+    SECTION("CCBcastCache_LRU_Test") {
+        INFO("Control Channel Broadcast Cache Least Recently Used Eviction Test");
+
+        CCBcastCache cache(TEST_FRAME_LENGTH, TEST_CACHE_MAX);
+        for (ulong64_t key = 1U; key <= TEST_CACHE_MAX; key++)
+            addFrame(cache, key);
+
+        REQUIRE(cache.size() == TEST_CACHE_MAX);
+        REQUIRE(cache.find(TEST_CACHE_MAX + 1U) == nullptr);
+
+        // re-adding a cached broadcast replaces it in place
+        addFrame(cache, 2U);
+        REQUIRE(cache.size() == TEST_CACHE_MAX);
+
+        // a full cache evicts the least recently used broadcast only, it is never cleared to make room
+        REQUIRE(hasFrame(cache, 1U));
+        addFrame(cache, TEST_CACHE_MAX + 1U);
+        REQUIRE(cache.size() == TEST_CACHE_MAX);
+        REQUIRE(cache.find(3U) == nullptr);
+        REQUIRE(hasFrame(cache, 1U));
+        REQUIRE(hasFrame(cache, 2U));
+        REQUIRE(hasFrame(cache, 4U));
+        REQUIRE(hasFrame(cache, TEST_CACHE_MAX + 1U));
+
+        // broadcasts that keep being looked up outlive any number of stale broadcasts
+        for (ulong64_t key = 100U; key < 100U + (TEST_CACHE_MAX * 4U); key++) {
+            REQUIRE(hasFrame(cache, 1U));
+            addFrame(cache, key);
+        }
+
+        REQUIRE(hasFrame(cache, 1U));
+        REQUIRE(cache.size() == TEST_CACHE_MAX);
+
+        cache.clear();
+        REQUIRE(cache.isEmpty());
+        REQUIRE(cache.find(1U) == nullptr);
+    }
+
+    SECTION("CCBcastCache_DMR_Test") {
+        INFO("Control Channel Broadcast Cache DMR CSBK Test");
+
+        dmr::SiteData siteData(dmr::defines::SiteModel::SM_SMALL, 1U, 1U, 3U, false);
+        siteData.setNetActive(true);
+        dmr::lc::CSBK::setSiteData(siteData);
+
+        const uint8_t bcasts[] = { 0xFFU, dmr::defines::BroadcastAnncType::SITE_PARMS };
+        CCBcastCache cache(DMR_BCAST_FRAME_LENGTH);
+        for (uint8_t anncType : bcasts)
+            encodeDMRBcast(anncType, cache.add(anncType));
+
+        // every cycle, the cached broadcasts are byte-identical to freshly encoded ones
+        for (uint32_t cycle = 0U; cycle < CC_BCAST_CYCLES; cycle++) {
+            for (uint8_t anncType : bcasts) {
+                uint8_t fresh[DMR_BCAST_FRAME_LENGTH];
+                encodeDMRBcast(anncType, fresh);
+
+                const uint8_t* cached = cache.find(anncType);
+                REQUIRE(cached != nullptr);
+                REQUIRE(::memcmp(cached, fresh, DMR_BCAST_FRAME_LENGTH) == 0);
+            }
+        }
+
+        // the networked flag is encoded into the Aloha, so the network state must be part of its cache key
+        uint8_t fresh[DMR_BCAST_FRAME_LENGTH];
+        siteData.setNetActive(false);
+        dmr::lc::CSBK::setSiteData(siteData);
+        encodeDMRBcast(0xFFU, fresh);
+        REQUIRE(::memcmp(cache.find(0xFFU), fresh, DMR_BCAST_FRAME_LENGTH) != 0);
+
+        dmr::lc::CSBK::setSiteData(dmr::SiteData());
+    }
+
+    SECTION("CCBcastCache_DMR_Invalidation_Test") {
+        INFO("Control Channel Broadcast Cache DMR Network State Invalidation Test");
+
+        dmr::SiteData siteData(dmr::defines::SiteModel::SM_SMALL, 1U, 1U, 3U, false);
+        siteData.setNetActive(true);
+        dmr::lc::CSBK::setSiteData(siteData);
+
+        CCBcastCache cache(DMR_BCAST_FRAME_LENGTH);
+        ulong64_t netKey = dmr::packet::ControlSignaling::getAlohaBcastKey(siteData);
+        encodeDMRBcast(0xFFU, cache.add(netKey));
+
+        // a change of the network state re-keys the Aloha, the Aloha cached for the previous state is never sent
+        siteData.setNetActive(false);
+        dmr::lc::CSBK::setSiteData(siteData);
+        ulong64_t localKey = dmr::packet::ControlSignaling::getAlohaBcastKey(siteData);
+        REQUIRE(localKey != netKey);
+        REQUIRE(cache.find(localKey) == nullptr);
+
+        uint8_t fresh[DMR_BCAST_FRAME_LENGTH];
+        encodeDMRBcast(0xFFU, fresh);
+        ::memcpy(cache.add(localKey), fresh, DMR_BCAST_FRAME_LENGTH);
+        REQUIRE(::memcmp(cache.find(localKey), fresh, DMR_BCAST_FRAME_LENGTH) == 0);
+
+        // the Aloha cached for either state remains valid once the network state changes back
+        siteData.setNetActive(true);
+        dmr::lc::CSBK::setSiteData(siteData);
+        REQUIRE(dmr::packet::ControlSignaling::getAlohaBcastKey(siteData) == netKey);
+
+        encodeDMRBcast(0xFFU, fresh);
+        REQUIRE(::memcmp(cache.find(netKey), fresh, DMR_BCAST_FRAME_LENGTH) == 0);
+        REQUIRE(::memcmp(cache.find(localKey), fresh, DMR_BCAST_FRAME_LENGTH) != 0);
+
+        dmr::lc::CSBK::setSiteData(dmr::SiteData());
+    }
+
+    SECTION("CCBcastCache_P25_Test") {
+        INFO("Control Channel Broadcast Cache P25 TSBK Test");
+
+        p25::SiteData siteData(0xBB800U, 0x001U, 1U, 1U, 0U, 1U, 1U, p25::defines::ServiceClass::VOICE | p25::defines::ServiceClass::DATA, 0);
+        siteData.setNetActive(true);
+        p25::lc::TSBK::setSiteData(siteData);
+
+        p25::NID nid(0x293U);
+
+        const uint8_t bcasts[] = { p25::defines::TSBKO::OSP_IDEN_UP, p25::defines::TSBKO::OSP_NET_STS_BCAST,
+            p25::defines::TSBKO::OSP_RFSS_STS_BCAST };
+
+        // single-block TSDUs are cached as full frames, multi-block TSDU blocks are cached as encoded blocks
+        // (the last block of a multi-block TSDU is cached separately, as the last block flag is encoded)
+        CCBcastCache cache(P25_BCAST_FRAME_LENGTH);
+        for (uint8_t lco : bcasts) {
+            p25::packet::ControlSignaling::encodeTSDU_SBF(createP25Bcast(lco).get(), nid, false, cache.add(lco));
+
+            for (uint32_t lastBlock = 0U; lastBlock < 2U; lastBlock++) {
+                std::unique_ptr<p25::lc::TSBK> tsbk = createP25Bcast(lco);
+                tsbk->setLastBlock(lastBlock == 1U);
+                tsbk->encode(cache.add(((lastBlock + 1U) << 8) | lco), true);
+            }
+        }
+
+        // every cycle, the cached broadcasts are byte-identical to freshly encoded ones
+        for (uint32_t cycle = 0U; cycle < CC_BCAST_CYCLES; cycle++) {
+            for (uint8_t lco : bcasts) {
+                uint8_t fresh[P25_BCAST_FRAME_LENGTH];
+                ::memset(fresh, 0x00U, P25_BCAST_FRAME_LENGTH);
+                p25::packet::ControlSignaling::encodeTSDU_SBF(createP25Bcast(lco).get(), nid, false, fresh);
+
+                const uint8_t* cached = cache.find(lco);
+                REQUIRE(cached != nullptr);
+                REQUIRE(::memcmp(cached, fresh, P25_BCAST_FRAME_LENGTH) == 0);
+
+                for (uint32_t lastBlock = 0U; lastBlock < 2U; lastBlock++) {
+                    ::memset(fresh, 0x00U, P25_BCAST_FRAME_LENGTH);
+                    std::unique_ptr<p25::lc::TSBK> tsbk = createP25Bcast(lco);
+                    tsbk->setLastBlock(lastBlock == 1U);
+                    tsbk->encode(fresh, true);
+
+                    cached = cache.find(((lastBlock + 1U) << 8) | lco);
+                    REQUIRE(cached != nullptr);
+                    REQUIRE(::memcmp(cached, fresh, p25::defines::P25_TSBK_FEC_LENGTH_BYTES) == 0);
+                }
+            }
+        }
+
+        // the last block flag is encoded into the block, so blocks must be cached by their position in the MBF
+        REQUIRE(::memcmp(cache.find((1U << 8) | bcasts[0U]), cache.find((2U << 8) | bcasts[0U]),
+            p25::defines::P25_TSBK_FEC_LENGTH_BYTES) != 0);
+
+        p25::lc::TSBK::setSiteData(p25::SiteData());
+    }
+
+    SECTION("CCBcastCache_NXDN_Test") {
+        INFO("Control Channel Broadcast Cache NXDN RCCH Test");
+
+        nxdn::SiteData siteData(1U, 1U, 1U, nxdn::defines::SiteInformation1::VOICE_CALL_SVC | nxdn::defines::SiteInformation1::DATA_CALL_SVC,
+            0U, false);
+        siteData.setNetActive(true);
+        nxdn::lc::RCCH::setSiteData(siteData);
+
+        const uint8_t bcasts[] = { nxdn::defines::MessageType::RCCH_SITE_INFO, nxdn::defines::MessageType::SRV_INFO };
+        CCBcastCache cache(NXDN_BCAST_FRAME_LENGTH);
+        for (uint8_t messageType : bcasts)
+            encodeNXDNBcast(messageType, cache.add(messageType));
+
+        // every cycle, the cached broadcasts are byte-identical to freshly encoded ones
+        for (uint32_t cycle = 0U; cycle < CC_BCAST_CYCLES; cycle++) {
+            for (uint8_t messageType : bcasts) {
+                uint8_t fresh[NXDN_BCAST_FRAME_LENGTH];
+                encodeNXDNBcast(messageType, fresh);
+
+                const uint8_t* cached = cache.find(messageType);
+                REQUIRE(cached != nullptr);
+                REQUIRE(::memcmp(cached, fresh, NXDN_BCAST_FRAME_LENGTH) == 0);
+            }
+        }
+
+        nxdn::lc::RCCH::setSiteData(nxdn::SiteData());
+    }
+}
@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Thread.h"
+#include "host/ControlChannelScheduler.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <vector>
+
+const uint32_t TEST_FRAME_LENGTH = 8U;
+
+/**
+ * @brief Helper to add a test frame (containing its own tag) to the scheduler.
+ * @param scheduler Control channel scheduler.
+ * @param tag Tag identifying the frame.
+ * @param trafficClass Traffic class of the frame.
+ * @param key Coalescing key.
+ * @returns bool True, if the frame was queued or coalesced, otherwise false.
+ */
+static bool addFrame(ControlChannelScheduler& scheduler, uint8_t tag, CCTrafficClass::E trafficClass, ulong64_t key = 0U)
+{
+    uint8_t data[TEST_FRAME_LENGTH];
+    ::memset(data, tag, TEST_FRAME_LENGTH);
+    return scheduler.add(data, TEST_FRAME_LENGTH, trafficClass, key);
+}
+
+/**
+ * @brief Helper to release all the queued frames from the scheduler.
+ * @param scheduler Control channel scheduler.
+ * @returns std::vector<uint8_t> Tags of the released frames.
+ */
+static std::vector<uint8_t> getFrames(ControlChannelScheduler& scheduler)
+{
+    std::vector<uint8_t> tags;
+
+    uint8_t data[TEST_FRAME_LENGTH];
+    while (scheduler.peek() > 0U) {
+        REQUIRE(scheduler.get(data) == TEST_FRAME_LENGTH);
+        tags.push_back(data[0U]);
+    }
+
+    REQUIRE(scheduler.isEmpty());
+    return tags;
+}
+
+TEST_CASE("ControlChannelScheduler", "[CC Scheduler Test]") {
+    SECTION("CCScheduler_Priority_Test") {
+        INFO("Control Channel Scheduler Priority Test");
+
+        ControlChannelScheduler scheduler(1024U, "Test");
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST));
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::SIGNALING));
+        REQUIRE(addFrame(scheduler, 3U, CCTrafficClass::RESPONSE));
+        REQUIRE(addFrame(scheduler, 4U, CCTrafficClass::RESPONSE));
+        REQUIRE(addFrame(scheduler, 5U, CCTrafficClass::GRANT));
+
+        // grants are released first, frames within a class are released in order
+        std::vector<uint8_t> tags = getFrames(scheduler);
+        REQUIRE(tags == std::vector<uint8_t>({ 5U, 3U, 4U, 2U, 1U }));
+
+        REQUIRE(scheduler.stats(CCTrafficClass::RESPONSE).queued == 2U);
+        REQUIRE(scheduler.stats(CCTrafficClass::RESPONSE).sent == 2U);
+        REQUIRE(scheduler.latency(CCTrafficClass::GRANT)->snapshot().count() == 1U);
+    }
+
+    SECTION("CCScheduler_Coalesce_Test") {
+        INFO("Control Channel Scheduler Coalesce Test");
+
+        ControlChannelScheduler scheduler(1024U, "Test");
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST, 0x100U));
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::BROADCAST, 0x200U));
+
+        // a newer broadcast with the same key replaces the queued broadcast, keeping its place
+        REQUIRE(addFrame(scheduler, 3U, CCTrafficClass::BROADCAST, 0x100U));
+        REQUIRE(scheduler.dataSize() == 2U * (TEST_FRAME_LENGTH + 2U));
+
+        std::vector<uint8_t> tags = getFrames(scheduler);
+        REQUIRE(tags == std::vector<uint8_t>({ 3U, 2U }));
+
+        CCSchedulerStats stats = scheduler.stats(CCTrafficClass::BROADCAST);
+        REQUIRE(stats.queued == 2U);
+        REQUIRE(stats.coalesced == 1U);
+        REQUIRE(stats.sent == 2U);
+    }
+
+    SECTION("CCScheduler_Coalesce_Length_Test") {
+        INFO("Control Channel Scheduler Coalesce Length Test");
+
+        // room for exactly two frames
+        ControlChannelScheduler scheduler(2U * (TEST_FRAME_LENGTH + 2U), "Test");
+        scheduler.setDeadline(CCTrafficClass::BROADCAST, 1U);
+
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST, 0x100U));
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::BROADCAST));
+        Thread::sleep(5U);
+
+        // a longer frame supersedes the queued frame, making room expires the stale frame
+        uint8_t data[TEST_FRAME_LENGTH + 4U];
+        ::memset(data, 3U, TEST_FRAME_LENGTH + 4U);
+        REQUIRE(scheduler.add(data, TEST_FRAME_LENGTH + 4U, CCTrafficClass::BROADCAST, 0x100U));
+        REQUIRE(scheduler.depth(CCTrafficClass::BROADCAST) == 1U);
+        REQUIRE(scheduler.dataSize() == TEST_FRAME_LENGTH + 4U + 2U);
+
+        REQUIRE(scheduler.get(data) == TEST_FRAME_LENGTH + 4U);
+        REQUIRE(data[0U] == 3U);
+        REQUIRE(scheduler.isEmpty());
+        REQUIRE(scheduler.stats(CCTrafficClass::BROADCAST).coalesced == 0U);
+    }
+
+    SECTION("CCScheduler_Coalesce_Deadline_Test") {
+        INFO("Control Channel Scheduler Coalesce Deadline Test");
+
+        ControlChannelScheduler scheduler(1024U, "Test");
+        scheduler.setDeadline(CCTrafficClass::BROADCAST, 50U);
+
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST, 0x100U));
+        Thread::sleep(35U);
+
+        // the coalesced data restarts the deadline, the frame outlives the deadline of the original data
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::BROADCAST, 0x100U));
+        Thread::sleep(25U);
+
+        std::vector<uint8_t> tags = getFrames(scheduler);
+        REQUIRE(tags == std::vector<uint8_t>({ 2U }));
+        REQUIRE(scheduler.stats(CCTrafficClass::BROADCAST).expired == 0U);
+    }
+
+    SECTION("CCScheduler_Deadline_Test") {
+        INFO("Control Channel Scheduler Deadline Test");
+
+        ControlChannelScheduler scheduler(1024U, "Test");
+        scheduler.setDeadline(CCTrafficClass::BROADCAST, 1U);
+        scheduler.setDeadline(CCTrafficClass::GRANT, 0U);
+
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST));
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::GRANT));
+        Thread::sleep(5U);
+
+        // the stale broadcast is dropped, the grant never expires
+        std::vector<uint8_t> tags = getFrames(scheduler);
+        REQUIRE(tags == std::vector<uint8_t>({ 2U }));
+        REQUIRE(scheduler.stats(CCTrafficClass::BROADCAST).expired == 1U);
+        REQUIRE(scheduler.stats(CCTrafficClass::GRANT).expired == 0U);
+    }
+
+    SECTION("CCScheduler_Overflow_Test") {
+        INFO("Control Channel Scheduler Overflow Test");
+
+        // room for exactly three frames
+        ControlChannelScheduler scheduler(3U * (TEST_FRAME_LENGTH + 2U), "Test");
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST));
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::BROADCAST));
+        REQUIRE(addFrame(scheduler, 3U, CCTrafficClass::RESPONSE));
+
+        // a full scheduler makes room by dropping the newest lower priority frames
+        REQUIRE(addFrame(scheduler, 4U, CCTrafficClass::GRANT));
+        REQUIRE(addFrame(scheduler, 5U, CCTrafficClass::GRANT));
+
+        // frames of an equal or higher priority class are never dropped to make room
+        REQUIRE(!addFrame(scheduler, 6U, CCTrafficClass::RESPONSE));
+
+        std::vector<uint8_t> tags = getFrames(scheduler);
+        REQUIRE(tags == std::vector<uint8_t>({ 4U, 5U, 3U }));
+
+        REQUIRE(scheduler.stats(CCTrafficClass::BROADCAST).dropped == 2U);
+        REQUIRE(scheduler.stats(CCTrafficClass::RESPONSE).dropped == 1U);
+        REQUIRE(scheduler.stats(CCTrafficClass::GRANT).dropped == 0U);
+    }
+
+    SECTION("CCScheduler_Hold_Test") {
+        INFO("Control Channel Scheduler Hold Test");
+
+        // room for exactly two frames
+        ControlChannelScheduler scheduler(2U * (TEST_FRAME_LENGTH + 2U), "Test");
+        scheduler.setDeadline(CCTrafficClass::BROADCAST, 1U);
+
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST, 0x100U));
+        REQUIRE(scheduler.peek() == TEST_FRAME_LENGTH);
+
+        // the peeked frame is neither coalesced, dropped to make room, expired or preempted
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::BROADCAST, 0x100U));
+        REQUIRE(addFrame(scheduler, 3U, CCTrafficClass::GRANT));
+        REQUIRE(!addFrame(scheduler, 4U, CCTrafficClass::GRANT));
+        Thread::sleep(5U);
+
+        REQUIRE(scheduler.peek() == TEST_FRAME_LENGTH);
+
+        uint8_t data[TEST_FRAME_LENGTH];
+        REQUIRE(scheduler.get(data) == TEST_FRAME_LENGTH);
+        REQUIRE(data[0U] == 1U);
+
+        std::vector<uint8_t> tags = getFrames(scheduler);
+        REQUIRE(tags == std::vector<uint8_t>({ 3U }));
+
+        CCSchedulerStats stats = scheduler.stats(CCTrafficClass::BROADCAST);
+        REQUIRE(stats.coalesced == 0U);
+        REQUIRE(stats.dropped == 1U);
+        REQUIRE(stats.expired == 0U);
+        REQUIRE(stats.sent == 1U);
+    }
+
+    SECTION("CCScheduler_MaxClass_Test") {
+        INFO("Control Channel Scheduler Max Class Test");
+
+        ControlChannelScheduler scheduler(1024U, "Test");
+        REQUIRE(addFrame(scheduler, 1U, CCTrafficClass::BROADCAST));
+        REQUIRE(addFrame(scheduler, 2U, CCTrafficClass::SIGNALING));
+
+        uint8_t data[TEST_FRAME_LENGTH];
+        REQUIRE(scheduler.peek(CCTrafficClass::SIGNALING) == TEST_FRAME_LENGTH);
+        REQUIRE(scheduler.get(data, CCTrafficClass::SIGNALING) == TEST_FRAME_LENGTH);
+        REQUIRE(data[0U] == 2U);
+
+        // broadcasts are only released when they are considered
+        REQUIRE(scheduler.peek(CCTrafficClass::SIGNALING) == 0U);
+        REQUIRE(scheduler.get(data, CCTrafficClass::SIGNALING) == 0U);
+        REQUIRE(scheduler.depth(CCTrafficClass::BROADCAST) == 1U);
+
+        scheduler.clear(CCTrafficClass::BROADCAST);
+        REQUIRE(scheduler.isEmpty());
+        REQUIRE(scheduler.dataSize() == 0U);
+    }
+}
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/LatencyHistogram.h"
+#include "common/Log.h"
+#include "common/StopWatch.h"
+#include "common/Thread.h"
+#include "modem/Modem.h"
+#include "modem/port/PortPoller.h"
+
+using namespace modem;
+using namespace modem::port;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t TEST_FRAMES = 100U;
+const uint32_t TEST_FRAME_INTERVAL = 10U;
+const uint32_t TEST_TICK_DELAY = 5U;
+const uint32_t TEST_FRAME_LENGTH = 3U + 8U + 12U;
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Modem port backed by a pipe, standing in for a serial port.
+ */
+class PipePort : public IModemPort {
+public:
+    /**
+     * @brief Initializes a new instance of the PipePort class.
+     */
+    PipePort()
+    {
+        m_fds[0U] = m_fds[1U] = -1;
+        if (::pipe(m_fds) == 0)
+            ::fcntl(m_fds[0U], F_SETFL, ::fcntl(m_fds[0U], F_GETFL, 0) | O_NONBLOCK);
+    }
+    /**
+     * @brief Finalizes a instance of the PipePort class.
+     */
+    ~PipePort() override { close(); }
+
+    bool open() override { return m_fds[0U] >= 0; }
+    int read(uint8_t* buffer, uint32_t length) override
+    {
+        ssize_t ret = ::read(m_fds[0U], buffer, length);
+        return (ret < 0) ? 0 : int(ret);
+    }
+    int write(const uint8_t* buffer, uint32_t length) override { return length; }
+    void close() override
+    {
+        for (uint32_t i = 0U; i < 2U; i++) {
+            if (m_fds[i] >= 0)
+                ::close(m_fds[i]);
+            m_fds[i] = -1;
+        }
+    }
+
+    int getReadDescriptor() const override { return m_fds[0U]; }
+
+    /**
+     * @brief Writes data into the port, as if it was received from the modem.
+     * @param[in] buffer Buffer containing data.
+     * @param length Length of data.
+     */
+    void inject(const uint8_t* buffer, uint32_t length)
+    {
+        ssize_t ret = ::write(m_fds[1U], buffer, length);
+        (void)ret;
+    }
+
+private:
+    int m_fds[2U];
+};
+
+/**
+ * @brief Helper to measure the latency of P25 frames received from the modem, from the frame arriving at the
+ *  port to the frame being read by the frame processor.
+ * @param eventDriven Flag indicating the modem and frame processor loops are event driven.
+ * @param histogram Histogram to record latencies into.
+ * @returns uint32_t Number of frames read.
+ */
+static uint32_t measureRxLatency(bool eventDriven, LatencyHistogram& histogram)
+{
+    PipePort* port = new PipePort();
+    Modem modem(port, true, false, false, false, false, false, 0U, 0U, 0U, 4096U, 4096U, 4096U, false, false, false, false, false);
+    modem.setModeParams(false, true, false);
+
+    PortPoller poller;
+    if (eventDriven)
+        REQUIRE(poller.open());
+
+    std::atomic<bool> running(true);
+    std::atomic<uint32_t> read(0U);
+
+    // modem clocking loop (see Host::threadModem())
+    std::thread modemThread([&]() {
+        StopWatch stopWatch;
+        stopWatch.start();
+
+        while (running) {
+            uint32_t ms = stopWatch.elapsed();
+            stopWatch.start();
+
+            modem.clock(ms);
+
+            if (eventDriven) {
+                poller.watch(port);
+                poller.wait(modem.getClockTimeout());
+            }
+            else {
+                Thread::sleep(TEST_TICK_DELAY);
+            }
+        }
+    });
+
+    // frame processor loop (see Host::threadP25Reader())
+    std::thread readerThread([&]() {
+        uint8_t data[512U];
+        while (running) {
+            uint32_t len = 0U;
+            while ((len = modem.readP25Frame(data)) > 0U) {
+                uint64_t timestamp = 0U;
+                ::memcpy(&timestamp, data + 1U, sizeof(uint64_t));
+                histogram.recordSince(timestamp);
+                read++;
+            }
+
+            if (eventDriven)
+                modem.waitForRxData(RX_SIGNAL_P25, TEST_TICK_DELAY);
+            else
+                Thread::sleep(TEST_TICK_DELAY);
+        }
+    });
+
+    for (uint32_t i = 0U; i < TEST_FRAMES; i++) {
+        uint8_t frame[TEST_FRAME_LENGTH];
+        ::memset(frame, 0x00U, TEST_FRAME_LENGTH);
+        frame[0U] = DVM_SHORT_FRAME_START;
+        frame[1U] = TEST_FRAME_LENGTH;
+        frame[2U] = CMD_P25_DATA;
+
+        uint64_t timestamp = LatencyHistogram::now();
+        ::memcpy(frame + 3U, &timestamp, sizeof(uint64_t));
+        port->inject(frame, TEST_FRAME_LENGTH);
+
+        Thread::sleep(TEST_FRAME_INTERVAL);
+    }
+
+    // allow the last frames to be processed
+    Thread::sleep(TEST_TICK_DELAY * 10U);
+
+    running = false;
+    poller.wake();
+    modemThread.join();
+    readerThread.join();
+
+    return read.load();
+}
+
+TEST_CASE("Modem", "[Event Loop Test]") {
+    SECTION("Rx_Signal_Test") {
+        INFO("Modem Rx Queue Signal Test");
+
+        PipePort* port = new PipePort();
+        Modem modem(port, true, false, false, false, false, false, 0U, 0U, 0U, 4096U, 4096U, 4096U, false, false, false, false, false);
+        modem.setModeParams(false, true, false);
+
+        // nothing queued, the wait times out
+        REQUIRE(modem.waitForRxData(RX_SIGNAL_P25, 10U) == false);
+
+        uint8_t frame[TEST_FRAME_LENGTH];
+        ::memset(frame, 0x00U, TEST_FRAME_LENGTH);
+        frame[0U] = DVM_SHORT_FRAME_START;
+        frame[1U] = TEST_FRAME_LENGTH;
+        frame[2U] = CMD_P25_DATA;
+        port->inject(frame, TEST_FRAME_LENGTH);
+
+        PortPoller poller;
+        REQUIRE(poller.open());
+        REQUIRE(poller.watch(port));
+        REQUIRE(poller.wait(1000U));
+
+        modem.clock(0U);
+
+        // a frame is queued, the wait returns immediately and other queues are not signalled
+        REQUIRE(modem.waitForRxData(RX_SIGNAL_P25, 1000U));
+        REQUIRE(modem.waitForRxData(RX_SIGNAL_DMR1, 10U) == false);
+
+        uint8_t data[512U];
+        REQUIRE(modem.readP25Frame(data) == TEST_FRAME_LENGTH - 2U);
+
+        // a frame queued while waiting wakes the waiting thread
+        std::thread clockThread([&]() {
+            Thread::sleep(20U);
+            port->inject(frame, TEST_FRAME_LENGTH);
+            modem.clock(0U);
+        });
+
+        StopWatch stopWatch;
+        stopWatch.start();
+        bool signalled = modem.waitForRxData(RX_SIGNAL_P25, 5000U);
+        uint32_t elapsed = stopWatch.elapsed();
+        clockThread.join();
+
+        REQUIRE(signalled);
+        REQUIRE(elapsed < 1000U);
+        REQUIRE(modem.readP25Frame(data) == TEST_FRAME_LENGTH - 2U);
+
+        // waking the poller does not report data from the port
+        poller.wake();
+        REQUIRE(poller.wait(1000U) == false);
+    }
+
+    SECTION("Rx_Latency_Benchmark") {
+        INFO("Modem Rx Latency Benchmark");
+
+        LatencyHistogram polled("polled");
+        LatencyHistogram evented("evented");
+
+        uint32_t polledFrames = measureRxLatency(false, polled);
+        uint32_t eventedFrames = measureRxLatency(true, evented);
+
+        LatencyHistogramSnapshot p = polled.snapshot();
+        LatencyHistogramSnapshot e = evented.snapshot();
+
+        ::LogDebug("T", "Rx_Latency_Benchmark, polled, frames = %u, mean = %lluus, p50 = %lluus, p99 = %lluus, max = %lluus",
+            polledFrames, (unsigned long long)p.mean(), (unsigned long long)p.percentile(50.0),
+            (unsigned long long)p.percentile(99.0), (unsigned long long)p.max());
+        ::LogDebug("T", "Rx_Latency_Benchmark, event driven, frames = %u, mean = %lluus, p50 = %lluus, p99 = %lluus, max = %lluus",
+            eventedFrames, (unsigned long long)e.mean(), (unsigned long long)e.percentile(50.0),
+            (unsigned long long)e.percentile(99.0), (unsigned long long)e.max());
+
+        // both paths receive every frame (the latencies are only logged, they depend on the host scheduler)
+        REQUIRE(polledFrames == TEST_FRAMES);
+        REQUIRE(eventedFrames == TEST_FRAMES);
+    }
+}
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/RTPFNEHeader.h"
+#include "common/network/RTPJitterBuffer.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+/**
+ * @brief Helper to add a test frame (containing its own sequence) to the jitter buffer.
+ * @param buffer Jitter buffer.
+ * @param seq RTP sequence.
+ * @param now Current time (ms).
+ * @returns bool True, if the frame was buffered, otherwise false.
+ */
+static bool pushFrame(RTPJitterBuffer& buffer, uint16_t seq, uint64_t now)
+{
+    UInt8Array data = std::unique_ptr<uint8_t[]>(new uint8_t[2U]);
+    data[0U] = (seq >> 8) & 0xFFU;
+    data[1U] = (seq >> 0) & 0xFFU;
+    return buffer.push(seq, data, 2U, now);
+}
+
+/**
+ * @brief Helper to release all the ready frames from the jitter buffer.
+ * @param buffer Jitter buffer.
+ * @param now Current time (ms).
+ * @returns std::vector<uint16_t> Sequences of the released frames.
+ */
+static std::vector<uint16_t> popFrames(RTPJitterBuffer& buffer, uint64_t now)
+{
+    std::vector<uint16_t> seqs;
+
+    UInt8Array data = nullptr;
+    uint32_t length = 0U;
+    while (buffer.pop(data, length, now)) {
+        REQUIRE(length == 2U);
+        seqs.push_back((uint16_t)((data[0U] << 8) | data[1U]));
+    }
+
+    return seqs;
+}
+
+TEST_CASE("RTPJitterBuffer", "[Jitter Buffer Test]") {
+    SECTION("JitterBuffer_InOrder_Test") {
+        INFO("RTP Jitter Buffer In-Order Test");
+
+        RTPJitterBuffer buffer(2U, 8U, 120U);
+        for (uint16_t seq = 0U; seq < 10U; seq++) {
+            REQUIRE(pushFrame(buffer, seq, 0U));
+
+            // in-order frames are released immediately
+            std::vector<uint16_t> seqs = popFrames(buffer, 0U);
+            REQUIRE(seqs.size() == 1U);
+            REQUIRE(seqs[0U] == seq);
+        }
+
+        REQUIRE(buffer.isEmpty());
+        REQUIRE(buffer.lostCnt() == 0U);
+        REQUIRE(buffer.lateCnt() == 0U);
+        REQUIRE(buffer.reorderCnt() == 0U);
+    }
+
+    SECTION("JitterBuffer_Reorder_Test") {
+        INFO("RTP Jitter Buffer Reorder Test");
+
+        RTPJitterBuffer buffer(2U, 8U, 120U);
+        REQUIRE(pushFrame(buffer, 0U, 0U));
+        REQUIRE(popFrames(buffer, 0U).size() == 1U);
+
+        // sequence 1 is delayed behind sequence 2
+        REQUIRE(pushFrame(buffer, 2U, 0U));
+        REQUIRE(popFrames(buffer, 0U).empty());
+
+        REQUIRE(pushFrame(buffer, 1U, 10U));
+        std::vector<uint16_t> seqs = popFrames(buffer, 10U);
+        REQUIRE(seqs == std::vector<uint16_t>({ 1U, 2U }));
+
+        REQUIRE(buffer.lostCnt() == 0U);
+        REQUIRE(buffer.reorderCnt() == 1U);
+        REQUIRE(buffer.depth() == 3U);
+
+        // duplicate frames are dropped, and frames already released are late
+        REQUIRE(!pushFrame(buffer, 1U, 20U));
+        REQUIRE(buffer.lateCnt() == 1U);
+    }
+
+    SECTION("JitterBuffer_Loss_Test") {
+        INFO("RTP Jitter Buffer Loss Test");
+
+        RTPJitterBuffer buffer(2U, 8U, 120U);
+        REQUIRE(pushFrame(buffer, 0U, 0U));
+        REQUIRE(popFrames(buffer, 0U).size() == 1U);
+
+        // sequence 1 is lost; the gap is skipped once the buffer depth is reached
+        REQUIRE(pushFrame(buffer, 2U, 0U));
+        REQUIRE(popFrames(buffer, 0U).empty());
+        REQUIRE(pushFrame(buffer, 3U, 0U));
+        std::vector<uint16_t> seqs = popFrames(buffer, 0U);
+        REQUIRE(seqs == std::vector<uint16_t>({ 2U, 3U }));
+        REQUIRE(buffer.lostCnt() == 1U);
+
+        // sequence 4 is lost; the gap is skipped once the frame waits too long
+        REQUIRE(pushFrame(buffer, 5U, 100U));
+        REQUIRE(popFrames(buffer, 200U).empty());
+        seqs = popFrames(buffer, 220U);
+        REQUIRE(seqs == std::vector<uint16_t>({ 5U }));
+        REQUIRE(buffer.lostCnt() == 2U);
+
+        // the missing frame arriving afterwards is late
+        REQUIRE(!pushFrame(buffer, 4U, 230U));
+        REQUIRE(buffer.lateCnt() == 1U);
+    }
+
+    SECTION("JitterBuffer_EndOfCall_Test") {
+        INFO("RTP Jitter Buffer End of Call Test");
+
+        RTPJitterBuffer buffer(2U, 8U, 120U);
+        REQUIRE(pushFrame(buffer, 0U, 0U));
+        REQUIRE(pushFrame(buffer, 2U, 0U));
+
+        // the end of call frame is held until the stream frames are released
+        REQUIRE(pushFrame(buffer, RTP_END_OF_CALL_SEQ, 0U));
+        std::vector<uint16_t> seqs = popFrames(buffer, 0U);
+        REQUIRE(seqs == std::vector<uint16_t>({ 0U }));
+        REQUIRE(!buffer.isEnded());
+
+        REQUIRE(pushFrame(buffer, 1U, 10U));
+        seqs = popFrames(buffer, 10U);
+        REQUIRE(seqs == std::vector<uint16_t>({ 1U, 2U, RTP_END_OF_CALL_SEQ }));
+        REQUIRE(buffer.isEnded());
+        REQUIRE(buffer.isEmpty());
+    }
+
+    SECTION("JitterBuffer_Wrap_Test") {
+        INFO("RTP Jitter Buffer Sequence Wrap Test");
+
+        RTPJitterBuffer buffer(2U, 8U, 120U);
+        REQUIRE(pushFrame(buffer, 65533U, 0U));
+        REQUIRE(popFrames(buffer, 0U).size() == 1U);
+
+        // sequences roll over to 0 before the end of call sequence
+        REQUIRE(pushFrame(buffer, 0U, 0U));
+        REQUIRE(popFrames(buffer, 0U).empty());
+        REQUIRE(pushFrame(buffer, 65534U, 10U));
+        std::vector<uint16_t> seqs = popFrames(buffer, 10U);
+        REQUIRE(seqs == std::vector<uint16_t>({ 65534U, 0U }));
+
+        REQUIRE(buffer.lostCnt() == 0U);
+        REQUIRE(buffer.lateCnt() == 0U);
+    }
+}
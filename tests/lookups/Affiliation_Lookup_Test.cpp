@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/AffiliationIndex.h"
+#include "common/lookups/AffiliationLookup.h"
+#include "common/lookups/ChannelLookup.h"
+#include "common/Log.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BENCH_UNITS = 50000U;
+const uint32_t BENCH_TALKGROUPS = 500U;
+const uint32_t BENCH_LOOKUPS = 2000U;
+
+TEST_CASE("Affiliation", "[Lookup Test]") {
+    SECTION("Affiliation_Index_Test") {
+        INFO("Affiliation Lookup Bidirectional Index Test");
+
+        ChannelLookup chLookup;
+        AffiliationLookup aff("Test", &chLookup, false);
+
+        aff.unitReg(1001U);
+        aff.unitReg(1002U);
+        aff.unitReg(1001U);
+        REQUIRE(aff.unitRegSize() == 2U);
+        REQUIRE(aff.isUnitReg(1001U));
+        REQUIRE(!aff.isUnitReg(1003U));
+
+        aff.groupAff(1001U, 100U);
+        aff.groupAff(1002U, 100U);
+        REQUIRE(aff.hasGroupAff(100U));
+        REQUIRE(aff.isGroupAff(1001U, 100U));
+        REQUIRE(aff.getGroupAffSrcIds(100U).size() == 2U);
+
+        // moving a unit to another talkgroup removes it from the previous talkgroup
+        aff.groupAff(1002U, 200U);
+        REQUIRE(aff.getGroupAff(1002U) == 200U);
+        REQUIRE(aff.getGroupAffSrcIds(100U).size() == 1U);
+        REQUIRE(aff.hasGroupAff(200U));
+
+        // deregistering a unit removes its affiliation
+        REQUIRE(aff.unitDereg(1002U));
+        REQUIRE(!aff.isUnitReg(1002U));
+        REQUIRE(!aff.hasGroupAff(200U));
+        REQUIRE(aff.grpAffSize() == 1U);
+
+        std::vector<uint32_t> srcIds = aff.clearGroupAff(100U, false);
+        REQUIRE(srcIds.size() == 1U);
+        REQUIRE(srcIds[0U] == 1001U);
+        REQUIRE(!aff.hasGroupAff(100U));
+        REQUIRE(aff.grpAffSize() == 0U);
+    }
+
+    SECTION("Affiliation_Grant_Index_Test") {
+        INFO("Affiliation Lookup Grant Index Test");
+
+        ChannelLookup chLookup;
+        chLookup.addRFCh(1U);
+        chLookup.addRFCh(2U);
+
+        AffiliationLookup aff("Test", &chLookup, false);
+
+        REQUIRE(aff.grantCh(100U, 1001U, 30U, true, false));
+        uint32_t chNo = aff.getGrantedCh(100U);
+        REQUIRE(chNo != 0U);
+        REQUIRE(aff.isChBusy(chNo));
+        REQUIRE(aff.getGrantedDstByCh(chNo) == 100U);
+        REQUIRE(aff.getGrantedBySrcId(1001U) == 100U);
+        REQUIRE(aff.getGrantedSrcId(100U) == 1001U);
+        REQUIRE(aff.isGroup(100U));
+
+        REQUIRE(aff.grantCh(200U, 1002U, 30U, false, true));
+        REQUIRE(!aff.isGroup(200U));
+        REQUIRE(aff.isNetGranted(200U));
+        REQUIRE(!chLookup.isRFChAvailable());
+
+        REQUIRE(aff.releaseGrant(100U, false));
+        REQUIRE(!aff.isGranted(100U));
+        REQUIRE(!aff.isChBusy(chNo));
+        REQUIRE(aff.getGrantedDstByCh(chNo) == 0U);
+        REQUIRE(aff.getGrantedBySrcId(1001U) == 0U);
+        REQUIRE(chLookup.isRFChAvailable());
+
+        REQUIRE(aff.releaseGrant(0U, true));
+        REQUIRE(aff.getGrantedBySrcId(1002U) == 0U);
+        REQUIRE(aff.grantTable().empty());
+    }
+
+    SECTION("Affiliation_Aggregated_Index_Test") {
+        INFO("Affiliation Lookup Aggregated Index Test");
+
+        AffiliationIndex index;
+        ChannelLookup chLookup;
+
+        AffiliationLookup* peerA = new AffiliationLookup("Peer A", &chLookup, false);
+        AffiliationLookup* peerB = new AffiliationLookup("Peer B", &chLookup, false);
+
+        // affiliations made before the index is attached are carried over
+        peerA->groupAff(1001U, 100U);
+        peerA->setAffiliationIndex(&index, 1U);
+        peerB->setAffiliationIndex(&index, 2U);
+        REQUIRE(index.isAffiliated(100U, 1U));
+        REQUIRE(!index.isAffiliated(100U, 2U));
+
+        peerA->groupAff(1002U, 100U);
+        peerB->groupAff(2001U, 100U);
+        peerB->groupAff(2002U, 200U);
+        REQUIRE(index.ownerCount(100U) == 2U);
+        REQUIRE(index.size() == 2U);
+
+        // an owner remains affiliated until its last unit leaves the talkgroup
+        peerA->groupUnaff(1001U);
+        REQUIRE(index.isAffiliated(100U, 1U));
+        peerA->groupUnaff(1002U);
+        REQUIRE(!index.isAffiliated(100U, 1U));
+        REQUIRE(index.isAffiliated(100U));
+
+        // destroying a lookup removes its entries from the index
+        delete peerB;
+        REQUIRE(!index.isAffiliated(100U));
+        REQUIRE(!index.isAffiliated(200U));
+        REQUIRE(index.size() == 0U);
+
+        delete peerA;
+    }
+
+    SECTION("Affiliation_Lookup_Benchmark") {
+        INFO("Affiliation Lookup Benchmark");
+
+        ChannelLookup chLookup;
+        AffiliationLookup aff("Test", &chLookup, false);
+
+        // linear tables, as previously used by the affiliation lookup
+        std::vector<uint32_t> unitRegTable;
+        std::unordered_map<uint32_t, uint32_t> grpAffTable;
+
+        for (uint32_t i = 0U; i < BENCH_UNITS; i++) {
+            uint32_t srcId = 1000000U + i;
+            uint32_t dstId = 1U + (i % BENCH_TALKGROUPS);
+
+            aff.unitReg(srcId);
+            aff.groupAff(srcId, dstId);
+
+            unitRegTable.push_back(srcId);
+            grpAffTable[srcId] = dstId;
+        }
+
+        REQUIRE(aff.unitRegSize() == BENCH_UNITS);
+        REQUIRE(aff.grpAffSize() == BENCH_UNITS);
+
+        // linear lookups
+        uint32_t linearFound = 0U;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0U; i < BENCH_LOOKUPS; i++) {
+            uint32_t srcId = 1000000U + ((i * 7919U) % BENCH_UNITS);
+            if (std::find(unitRegTable.begin(), unitRegTable.end(), srcId) != unitRegTable.end())
+                linearFound++;
+
+            // a missing talkgroup is the worst case, every entry is scanned
+            uint32_t dstId = 1U + (i % (BENCH_TALKGROUPS * 2U));
+            for (auto& entry : grpAffTable) {
+                if (entry.second == dstId) {
+                    linearFound++;
+                    break;
+                }
+            }
+        }
+        auto linearTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        // indexed lookups
+        uint32_t indexedFound = 0U;
+        start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0U; i < BENCH_LOOKUPS; i++) {
+            uint32_t srcId = 1000000U + ((i * 7919U) % BENCH_UNITS);
+            if (aff.isUnitReg(srcId))
+                indexedFound++;
+
+            uint32_t dstId = 1U + (i % (BENCH_TALKGROUPS * 2U));
+            if (aff.hasGroupAff(dstId))
+                indexedFound++;
+        }
+        auto indexedTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        ::LogDebug("T", "Affiliation_Lookup_Benchmark, units = %u, lookups = %u, linear = %lldus, indexed = %lldus",
+            BENCH_UNITS, BENCH_LOOKUPS, (long long)linearTime, (long long)indexedTime);
+
+        REQUIRE(linearFound == indexedFound);
+        REQUIRE(indexedFound == BENCH_LOOKUPS + (BENCH_LOOKUPS / 2U));
+
+        // clearing a talkgroup only touches the units affiliated to it
+        start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> srcIds = aff.clearGroupAff(1U, false);
+        auto clearTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        ::LogDebug("T", "Affiliation_Lookup_Benchmark, cleared = %u, clear = %lldus", (uint32_t)srcIds.size(), (long long)clearTime);
+
+        REQUIRE(srcIds.size() == BENCH_UNITS / BENCH_TALKGROUPS);
+        REQUIRE(!aff.hasGroupAff(1U));
+    }
+}
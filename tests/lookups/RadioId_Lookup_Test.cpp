@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/CSVReader.h"
+#include "common/lookups/RadioIdLookup.h"
+#include "common/Log.h"
+#include "common/Thread.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BENCH_RIDS = 300000U;
+const uint32_t WATCH_TIMEOUT = 3000U;
+
+/**
+ * @brief Helper to wait for the lookup table to be reloaded.
+ * @param rid Radio ID lookup table.
+ * @param generation Generation of the lookup table before the reload.
+ * @returns bool True, if the lookup table was reloaded, otherwise false.
+ */
+static bool waitReload(RadioIdLookup& rid, uint32_t generation)
+{
+    for (uint32_t ms = 0U; ms < WATCH_TIMEOUT; ms += 50U) {
+        if (rid.generation() != generation)
+            return true;
+        Thread::sleep(50U);
+    }
+
+    return false;
+}
+
+/**
+ * @brief Helper to write a test lookup table file.
+ * @param filename Full-path to the file.
+ * @param content File content.
+ */
+static void writeFile(const std::string& filename, const std::string& content)
+{
+    FILE* fp = ::fopen(filename.c_str(), "wb");
+    REQUIRE(fp != nullptr);
+    ::fwrite(content.c_str(), 1U, content.length(), fp);
+    ::fclose(fp);
+}
+
+TEST_CASE("RadioIdLookup", "[Lookup Test]") {
+    SECTION("CSVReader_Tokenize_Test") {
+        INFO("CSV Reader Tokenize Test");
+
+        const char* data = "# comment\n\n1234,1,Alias,10.0.0.1\r\n5678,,0,\n9012,0,Alias 2,";
+        CSVReader reader;
+        reader.open(data, ::strlen(data));
+
+        // comments and empty lines are skipped, and carriage returns are stripped
+        REQUIRE(reader.next());
+        REQUIRE(reader.fields() == 4U);
+        REQUIRE(reader.toInt(0U) == 1234);
+        REQUIRE(reader.toInt(1U) == 1);
+        REQUIRE(reader.str(2U) == "Alias");
+        REQUIRE(reader.str(3U) == "10.0.0.1");
+
+        // empty fields are skipped, by default
+        REQUIRE(reader.next());
+        REQUIRE(reader.fields() == 2U);
+        REQUIRE(reader.toInt(1U) == 0);
+
+        // the last line does not need to be terminated
+        REQUIRE(reader.next());
+        REQUIRE(reader.fields() == 3U);
+        REQUIRE(reader.str(2U) == "Alias 2");
+        REQUIRE(reader.str(3U).empty());
+        REQUIRE(!reader.next());
+
+        // empty fields are significant, when not skipped
+        const char* peers = "1,,1,Peer,0,\n2.5,-3";
+        CSVReader peerReader(false);
+        peerReader.open(peers, ::strlen(peers));
+
+        REQUIRE(peerReader.next());
+        REQUIRE(peerReader.fields() == 5U);
+        REQUIRE(peerReader.str(1U).empty());
+        REQUIRE(peerReader.toInt(2U) == 1);
+        REQUIRE(peerReader.str(3U) == "Peer");
+
+        REQUIRE(peerReader.next());
+        REQUIRE(peerReader.toFloat(0U) == 2.5F);
+        REQUIRE(peerReader.toInt(1U) == -3);
+    }
+
+    SECTION("RadioIdLookup_Reload_Test") {
+        INFO("Radio ID Lookup Reload Test");
+
+        std::string filename = "rid_lookup_test.csv";
+        writeFile(filename, "1001,1,Unit 1\n1002,0,Unit 2\n");
+
+        RadioIdLookup rid(filename, 0U, true);
+        REQUIRE(rid.read());
+        REQUIRE(rid.find(1001U).radioEnabled());
+        REQUIRE(rid.find(1001U).radioAlias() == "Unit 1");
+        REQUIRE(!rid.find(1002U).radioEnabled());
+        REQUIRE(rid.find(1003U).radioDefault());
+
+        // modifications are published as a new table
+        std::vector<uint32_t> ids = { 1002U, 1003U };
+        rid.toggleEntries(ids, true);
+        REQUIRE(rid.find(1002U).radioEnabled());
+        REQUIRE(rid.find(1002U).radioAlias() == "Unit 2");
+        REQUIRE(rid.find(1003U).radioEnabled());
+
+        // a reload replaces the table entirely
+        uint32_t generation = rid.generation();
+        writeFile(filename, "1003,0,Unit 3\n");
+        REQUIRE(rid.reload());
+        REQUIRE(rid.generation() == generation + 1U);
+        REQUIRE(!rid.hasEntry(1001U));
+        REQUIRE(!rid.find(1003U).radioEnabled());
+        REQUIRE(rid.find(1003U).radioAlias() == "Unit 3");
+
+        ::remove(filename.c_str());
+    }
+
+#if defined(__linux__)
+    SECTION("RadioIdLookup_Watch_Test") {
+        INFO("Radio ID Lookup Watch Test");
+
+        std::string filename = "rid_lookup_watch.csv";
+        writeFile(filename, "1001,1,Unit 1\n");
+
+        RadioIdLookup rid(filename, 1U, true);
+        REQUIRE(rid.read());
+        Thread::sleep(250U); // allow the watch to start
+
+        // an external change to the file is reloaded
+        uint32_t generation = rid.generation();
+        writeFile(filename, "1003,1,Unit 3\n");
+        REQUIRE(waitReload(rid, generation));
+        REQUIRE(rid.generation() == generation + 1U);
+        REQUIRE(!rid.hasEntry(1001U));
+        REQUIRE(rid.find(1003U).radioEnabled());
+
+        // changes saved by the lookup table itself are not reloaded
+        generation = rid.generation();
+        rid.toggleEntry(1003U, false);
+        rid.commit();
+        REQUIRE(!waitReload(rid, generation));
+        REQUIRE(!rid.find(1003U).radioEnabled());
+
+        rid.stop(true);
+        ::remove(filename.c_str());
+    }
+#endif // defined(__linux__)
+
+    SECTION("RadioIdLookup_Load_Benchmark") {
+        INFO("Radio ID Lookup Load Benchmark");
+
+        std::string filename = "rid_lookup_bench.csv";
+
+        std::string content;
+        content.reserve(BENCH_RIDS * 24U);
+        for (uint32_t i = 0U; i < BENCH_RIDS; i++) {
+            content += std::to_string(1000000U + i) + "," + std::to_string(i % 2U) + ",Unit " + std::to_string(i) + ",\n";
+        }
+        writeFile(filename, content);
+
+        RadioIdLookup rid(filename, 0U, true);
+
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(rid.read());
+        auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        ::LogDebug("T", "RadioIdLookup_Load_Benchmark, rids = %u, load = %lldms", BENCH_RIDS, (long long)loadTime);
+
+        REQUIRE(rid.table().size() == BENCH_RIDS);
+        REQUIRE(rid.find(1000001U).radioEnabled());
+        REQUIRE(rid.find(1000001U).radioAlias() == "Unit 1");
+
+        ::remove(filename.c_str());
+    }
+}
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/TalkgroupRulesLookup.h"
+#include "common/Log.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t TG_RULE_OPS = 2000U;
+const uint32_t TG_RULE_IDS = 64U;
+const uint32_t TG_RULE_PEERS = 4U;
+
+/**
+ * @brief Helper to find a rule, the way the lookup table searched its rules before they were indexed.
+ * @param rules List of group voice rules.
+ * @param id Talkgroup ID.
+ * @param slot DMR slot (0 matches any slot).
+ * @returns TalkgroupRuleGroupVoice First matching rule.
+ */
+static TalkgroupRuleGroupVoice linearFind(const std::vector<TalkgroupRuleGroupVoice>& rules, uint32_t id, uint8_t slot)
+{
+    auto it = std::find_if(rules.begin(), rules.end(),
+        [&](TalkgroupRuleGroupVoice x)
+        {
+            if (slot != 0U) {
+                return x.source().tgId() == id && x.source().tgSlot() == slot;
+            }
+
+            return x.source().tgId() == id;
+        });
+    if (it != rules.end())
+        return *it;
+    return TalkgroupRuleGroupVoice();
+}
+
+/**
+ * @brief Helper to find a rule by rewrite, the way the lookup table searched its rules before they were indexed.
+ * @param rules List of group voice rules.
+ * @param peerId Peer ID of the rewrite.
+ * @param id Rewritten talkgroup ID.
+ * @param slot DMR slot (0 matches any slot).
+ * @returns TalkgroupRuleGroupVoice First matching rule.
+ */
+static TalkgroupRuleGroupVoice linearFindByRewrite(const std::vector<TalkgroupRuleGroupVoice>& rules, uint32_t peerId, uint32_t id, uint8_t slot)
+{
+    auto it = std::find_if(rules.begin(), rules.end(),
+        [&](TalkgroupRuleGroupVoice x)
+        {
+            std::vector<TalkgroupRuleRewrite> rewrite = x.config().rewrite();
+            auto innerIt = std::find_if(rewrite.begin(), rewrite.end(),
+                [&](TalkgroupRuleRewrite y)
+                {
+                    if (slot != 0U) {
+                        return y.peerId() == peerId && y.tgId() == id && y.tgSlot() == slot;
+                    }
+
+                    return y.peerId() == peerId && y.tgId() == id;
+                });
+
+            return innerIt != rewrite.end();
+        });
+    if (it != rules.end())
+        return *it;
+    return TalkgroupRuleGroupVoice();
+}
+
+/**
+ * @brief Helper to check that two lookups resolved to the same rule.
+ * @param a Rule.
+ * @param b Rule.
+ * @returns bool True, if both are the same rule, otherwise false.
+ */
+static bool sameRule(const TalkgroupRuleGroupVoice& a, const TalkgroupRuleGroupVoice& b)
+{
+    if (a.isInvalid() || b.isInvalid())
+        return a.isInvalid() == b.isInvalid();
+    return a.name() == b.name() && a.source().tgId() == b.source().tgId() && a.source().tgSlot() == b.source().tgSlot();
+}
+
+/**
+ * @brief Helper to check every lookup against the linear search of the rules.
+ * @param lookup Talkgroup rules lookup.
+ * @returns uint32_t Number of mismatched lookups.
+ */
+static uint32_t checkAgainstLinear(TalkgroupRulesLookup& lookup)
+{
+    std::vector<TalkgroupRuleGroupVoice> rules = lookup.groupVoice();
+
+    uint32_t mismatches = 0U;
+    for (uint32_t id = 0U; id <= TG_RULE_IDS; id++) {
+        for (uint8_t slot = 0U; slot <= 2U; slot++) {
+            if (!sameRule(lookup.find(id, slot), linearFind(rules, id, slot)))
+                mismatches++;
+
+            for (uint32_t peerId = 0U; peerId <= TG_RULE_PEERS; peerId++) {
+                if (!sameRule(lookup.findByRewrite(peerId, id, slot), linearFindByRewrite(rules, peerId, id, slot)))
+                    mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+TEST_CASE("TalkgroupRulesLookup", "[Lookup Test]") {
+    SECTION("TalkgroupRules_Index_Equivalence_Test") {
+        INFO("Talkgroup Rules Index Equivalence Test");
+
+        TalkgroupRulesLookup lookup("", 0U, false);
+        std::mt19937 rng(5150U);
+
+        // apply a random mix of changes, the index must always resolve the same first match the linear search did
+        for (uint32_t n = 0U; n < TG_RULE_OPS; n++) {
+            uint32_t id = 1U + (rng() % TG_RULE_IDS);
+            uint8_t slot = (uint8_t)(rng() % 3U);
+
+            if ((rng() % 4U) == 0U) {
+                lookup.eraseEntry(id, slot);
+            }
+            else {
+                TalkgroupRuleGroupVoice groupVoice;
+                groupVoice.name("rule " + std::to_string(n));
+
+                TalkgroupRuleGroupVoiceSource source;
+                source.tgId(id);
+                source.tgSlot(slot);
+                groupVoice.source(source);
+
+                TalkgroupRuleConfig config;
+                config.active(true);
+
+                std::vector<TalkgroupRuleRewrite> rewrites;
+                uint32_t rewriteCnt = rng() % 3U;
+                for (uint32_t i = 0U; i < rewriteCnt; i++) {
+                    TalkgroupRuleRewrite rewrite;
+                    rewrite.peerId(1U + (rng() % TG_RULE_PEERS));
+                    rewrite.tgId(1U + (rng() % TG_RULE_IDS));
+                    rewrite.tgSlot((uint8_t)(rng() % 3U));
+                    rewrites.push_back(rewrite);
+                }
+                config.rewrite(rewrites);
+                groupVoice.config(config);
+
+                lookup.addEntry(groupVoice);
+            }
+
+            if ((n % 100U) == 0U) {
+                REQUIRE(checkAgainstLinear(lookup) == 0U);
+            }
+        }
+
+        REQUIRE(lookup.groupVoice().size() > 0U);
+        REQUIRE(checkAgainstLinear(lookup) == 0U);
+    }
+
+    SECTION("TalkgroupRules_Batch_Update_Test") {
+        INFO("Talkgroup Rules Batched Update Test");
+
+        TalkgroupRulesLookup lookup("", 0U, false);
+        lookup.addEntry(1U, 1U, true);
+
+        std::shared_ptr<const TalkgroupRulesIndex> before = lookup.index();
+        uint32_t version = lookup.indexVersion();
+        REQUIRE(before->size() == 1U);
+
+        // changes made in a batch are not indexed until the (outermost) batch ends
+        lookup.beginUpdate();
+        lookup.beginUpdate();
+        for (uint32_t id = 2U; id <= TG_RULE_IDS; id++)
+            lookup.addEntry(id, 1U, true);
+        lookup.eraseEntry(1U, 1U);
+        lookup.endUpdate();
+
+        REQUIRE(lookup.index() == before);
+        REQUIRE(lookup.indexVersion() == version);
+        REQUIRE(!lookup.find(1U, 1U).isInvalid());
+        REQUIRE(lookup.find(2U, 1U).isInvalid());
+
+        lookup.endUpdate();
+
+        std::shared_ptr<const TalkgroupRulesIndex> after = lookup.index();
+        REQUIRE(after != before);
+        REQUIRE(lookup.indexVersion() == version + 1U);
+        REQUIRE(after->size() == TG_RULE_IDS - 1U);
+        REQUIRE(lookup.find(1U, 1U).isInvalid());
+        REQUIRE(!lookup.find(2U, 1U).isInvalid());
+        REQUIRE(checkAgainstLinear(lookup) == 0U);
+
+        // an unbalanced end is ignored, and changes outside of a batch are indexed immediately
+        lookup.endUpdate();
+        lookup.addEntry(1U, 2U, true);
+        REQUIRE(lookup.indexVersion() == version + 2U);
+        REQUIRE(!lookup.find(1U, 2U).isInvalid());
+    }
+}
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/udp/DatagramPool.h"
+
+using namespace network::udp;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t POOL_THREADS = 4U;
+const uint32_t POOL_ITERATIONS = 20000U;
+
+TEST_CASE("DatagramPool", "[Pool Test]") {
+    SECTION("DatagramPool_Reuse_Test") {
+        INFO("Datagram Pool Reuse Test");
+
+        DatagramPool pool;
+        REQUIRE(pool.slabCount() == 0U);
+
+        // the first datagram allocates a slab, released datagrams are handed out again
+        UDPDatagram* datagram = pool.acquire(64U);
+        REQUIRE(datagram != nullptr);
+        REQUIRE(datagram->buffer != nullptr);
+        REQUIRE(datagram->length == 64U);
+        REQUIRE(pool.slabCount() == 1U);
+        ::memset(datagram->buffer, 0xA5U, datagram->length);
+        pool.release(datagram);
+
+        for (uint32_t i = 0U; i < DATAGRAM_POOL_SLAB_SLOTS * 4U; i++) {
+            UDPDatagram* d = pool.acquire(DATAGRAM_POOL_SLOT_SIZE);
+            REQUIRE(d->length == DATAGRAM_POOL_SLOT_SIZE);
+            pool.release(d);
+        }
+
+        REQUIRE(pool.slabCount() == 1U);
+        REQUIRE(pool.overflowCount() == 0U);
+
+        // releasing a vector releases every datagram and clears the vector
+        BufferVector buffers;
+        for (uint32_t i = 0U; i < 8U; i++)
+            buffers.push_back(pool.acquire(32U));
+        pool.release(buffers);
+        REQUIRE(buffers.empty());
+
+        pool.release(nullptr);
+    }
+
+    SECTION("DatagramPool_Growth_Test") {
+        INFO("Datagram Pool Slab Growth Test");
+
+        DatagramPool pool;
+
+        // a slab is only allocated once the previous slabs are entirely in use, and every datagram is distinct
+        std::vector<UDPDatagram*> datagrams;
+        std::unordered_set<UDPDatagram*> distinct;
+        for (uint32_t i = 0U; i < DATAGRAM_POOL_SLAB_SLOTS + 1U; i++) {
+            UDPDatagram* d = pool.acquire(16U);
+            datagrams.push_back(d);
+            distinct.insert(d);
+        }
+
+        REQUIRE(distinct.size() == datagrams.size());
+        REQUIRE(pool.slabCount() == 2U);
+        REQUIRE(pool.overflowCount() == 0U);
+
+        for (UDPDatagram* d : datagrams)
+            pool.release(d);
+    }
+
+    SECTION("DatagramPool_Overflow_Test") {
+        INFO("Datagram Pool Overflow Test");
+
+        DatagramPool pool;
+
+        // a datagram larger than a slot is heap allocated, but still uses a pooled slot
+        UDPDatagram* large = pool.acquire(DATAGRAM_POOL_SLOT_SIZE + 1U);
+        REQUIRE(large->length == DATAGRAM_POOL_SLOT_SIZE + 1U);
+        ::memset(large->buffer, 0x5AU, large->length);
+        REQUIRE(pool.overflowCount() == 1U);
+        pool.release(large);
+
+        // exhaust the pool, further datagrams fall back to being heap allocated
+        std::vector<UDPDatagram*> datagrams;
+        for (uint32_t i = 0U; i < DATAGRAM_POOL_SLAB_SLOTS * DATAGRAM_POOL_MAX_SLABS; i++)
+            datagrams.push_back(pool.acquire(16U));
+        REQUIRE(pool.slabCount() == DATAGRAM_POOL_MAX_SLABS);
+        REQUIRE(pool.overflowCount() == 1U);
+
+        UDPDatagram* heap = pool.acquire(16U);
+        REQUIRE(pool.overflowCount() == 2U);
+
+        // an exhausted pool and an oversized datagram at once are a single overflow
+        UDPDatagram* heapLarge = pool.acquire(DATAGRAM_POOL_SLOT_SIZE * 2U);
+        ::memset(heapLarge->buffer, 0x5AU, heapLarge->length);
+        REQUIRE(pool.overflowCount() == 3U);
+
+        pool.release(heap);
+        pool.release(heapLarge);
+        for (UDPDatagram* d : datagrams)
+            pool.release(d);
+
+        // pooled slots are reusable after the overflow
+        UDPDatagram* d = pool.acquire(16U);
+        REQUIRE(pool.overflowCount() == 3U);
+        pool.release(d);
+    }
+
+    SECTION("DatagramPool_Concurrent_Test") {
+        INFO("Datagram Pool Concurrent Test");
+
+        DatagramPool pool;
+        std::atomic<uint32_t> corrupted(0U);
+
+        // datagrams acquired concurrently are never handed out to two threads at once
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0U; t < POOL_THREADS; t++) {
+            threads.emplace_back([&, t]() {
+                std::vector<UDPDatagram*> held;
+                for (uint32_t i = 0U; i < POOL_ITERATIONS; i++) {
+                    UDPDatagram* d = pool.acquire(8U);
+                    ::memset(d->buffer, (uint8_t)t, d->length);
+                    held.push_back(d);
+
+                    if (held.size() >= 16U) {
+                        for (UDPDatagram* h : held) {
+                            for (uint32_t n = 0U; n < h->length; n++) {
+                                if (h->buffer[n] != (uint8_t)t)
+                                    corrupted++;
+                            }
+                        }
+
+                        pool.release(held.front());
+                        held.erase(held.begin());
+                    }
+                }
+
+                for (UDPDatagram* h : held)
+                    pool.release(h);
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        REQUIRE(corrupted == 0U);
+        // the threads never hold more datagrams than a single slab
+        REQUIRE(pool.overflowCount() == 0U);
+        REQUIRE(pool.slabCount() == 1U);
+    }
+}
@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/FrameQueue.h"
+#include "common/network/udp/Socket.h"
+#include "common/Log.h"
+
+using namespace network;
+using namespace network::frame;
+using namespace network::udp;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t BATCH_FRAMES = 32U;
+const uint32_t BATCH_MSG_LEN = 33U;
+const uint32_t BATCH_PEER_ID = 9000123U;
+
+/**
+ * @brief Helper to open a loopback socket on a free port.
+ * @param[out] addr Address of the opened socket.
+ * @param[out] addrLen Length of address structure.
+ * @returns Socket* Opened socket.
+ */
+static Socket* openLoopback(sockaddr_storage& addr, uint32_t& addrLen)
+{
+    // find a free port
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    struct sockaddr_in sin;
+    ::memset(&sin, 0x00, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sin.sin_port = 0;
+    ::bind(fd, (struct sockaddr*)&sin, sizeof(sin));
+
+    socklen_t len = sizeof(sin);
+    ::getsockname(fd, (struct sockaddr*)&sin, &len);
+    ::close(fd);
+
+    uint16_t port = ntohs(sin.sin_port);
+
+    Socket* socket = new Socket("127.0.0.1", port);
+    REQUIRE(socket->open());
+    REQUIRE(Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+    return socket;
+}
+
+/**
+ * @brief Helper to fill a test message.
+ * @param[out] message Message buffer.
+ * @param n Message number.
+ */
+static void fillMessage(uint8_t* message, uint32_t n)
+{
+    for (uint32_t i = 0U; i < BATCH_MSG_LEN; i++)
+        message[i] = (uint8_t)(n + i);
+}
+
+TEST_CASE("FrameQueue", "[Batch Read Test]") {
+    SECTION("ReadBatch_Test") {
+        INFO("Frame Queue Batched Read Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+
+        FrameQueue rxQueue(rxSocket, BATCH_PEER_ID, false);
+        FrameQueue txQueue(txSocket, BATCH_PEER_ID, false);
+        rxQueue.setRxBatchCount(BATCH_FRAMES);
+
+        for (uint32_t n = 0U; n < BATCH_FRAMES; n++) {
+            uint8_t message[BATCH_MSG_LEN];
+            fillMessage(message, n);
+            REQUIRE(txQueue.write(message, BATCH_MSG_LEN, 1000U + n, BATCH_PEER_ID, BATCH_PEER_ID,
+                { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, (uint16_t)n, rxAddr, rxAddrLen));
+        }
+
+        // every frame is read in a single batched read, in order and with its headers decoded
+        std::vector<FrameQueue::RxFrame> frames;
+        REQUIRE(rxQueue.readBatch(frames) == (int)BATCH_FRAMES);
+        REQUIRE(frames.size() == BATCH_FRAMES);
+
+        for (uint32_t n = 0U; n < BATCH_FRAMES; n++) {
+            uint8_t expected[BATCH_MSG_LEN];
+            fillMessage(expected, n);
+
+            FrameQueue::RxFrame& frame = frames[n];
+            REQUIRE(frame.messageLength == (int)BATCH_MSG_LEN);
+            REQUIRE(::memcmp(frame.message, expected, BATCH_MSG_LEN) == 0);
+            REQUIRE(frame.rtpHeader.getSequence() == (uint16_t)n);
+            REQUIRE(frame.fneHeader.getStreamId() == 1000U + n);
+            REQUIRE(frame.fneHeader.getFunction() == NET_FUNC::PROTOCOL);
+            REQUIRE(frame.fneHeader.getSubFunction() == NET_SUBFUNC::PROTOCOL_SUBFUNC_P25);
+            REQUIRE(Socket::port(frame.address) == Socket::port(txAddr));
+        }
+
+        // nothing left to read
+        REQUIRE(rxQueue.readBatch(frames) == 0);
+        REQUIRE(frames.empty());
+
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+
+    SECTION("ReadBatch_Limit_Test") {
+        INFO("Frame Queue Batched Read Limit Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+
+        FrameQueue rxQueue(rxSocket, BATCH_PEER_ID, false);
+        FrameQueue txQueue(txSocket, BATCH_PEER_ID, false);
+        rxQueue.setRxBatchCount(8U);
+        REQUIRE(rxQueue.getRxBatchCount() == 8U);
+
+        for (uint32_t n = 0U; n < 20U; n++) {
+            uint8_t message[BATCH_MSG_LEN];
+            fillMessage(message, n);
+            REQUIRE(txQueue.write(message, BATCH_MSG_LEN, 1000U, BATCH_PEER_ID, BATCH_PEER_ID,
+                { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, (uint16_t)n, rxAddr, rxAddrLen));
+        }
+
+        // a batched read never returns more than the configured batch count
+        std::vector<FrameQueue::RxFrame> frames;
+        REQUIRE(rxQueue.readBatch(frames) == 8);
+        REQUIRE(frames[0U].rtpHeader.getSequence() == 0U);
+        REQUIRE(rxQueue.readBatch(frames) == 8);
+        REQUIRE(frames[0U].rtpHeader.getSequence() == 8U);
+        REQUIRE(rxQueue.readBatch(frames) == 4);
+        REQUIRE(frames[3U].rtpHeader.getSequence() == 19U);
+
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+
+    SECTION("ReadBatch_Malformed_Test") {
+        INFO("Frame Queue Batched Read Malformed Packet Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+
+        FrameQueue rxQueue(rxSocket, BATCH_PEER_ID, false);
+        FrameQueue txQueue(txSocket, BATCH_PEER_ID, false);
+        rxQueue.setRxBatchCount(8U);
+
+        uint8_t message[BATCH_MSG_LEN];
+        fillMessage(message, 1U);
+        REQUIRE(txQueue.write(message, BATCH_MSG_LEN, 1000U, BATCH_PEER_ID, BATCH_PEER_ID,
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, 1U, rxAddr, rxAddrLen));
+
+        // a runt packet, and a packet that is not RTP at all
+        uint8_t runt[4U] = { 0x80U, 0x00U, 0x00U, 0x01U };
+        REQUIRE(txSocket->write(runt, sizeof(runt), rxAddr, rxAddrLen));
+        uint8_t garbage[64U];
+        ::memset(garbage, 0xFFU, sizeof(garbage));
+        REQUIRE(txSocket->write(garbage, sizeof(garbage), rxAddr, rxAddrLen));
+
+        fillMessage(message, 2U);
+        REQUIRE(txQueue.write(message, BATCH_MSG_LEN, 1000U, BATCH_PEER_ID, BATCH_PEER_ID,
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, 2U, rxAddr, rxAddrLen));
+
+        // the malformed packets are dropped from the batch, the valid frames on either side are kept
+        std::vector<FrameQueue::RxFrame> frames;
+        REQUIRE(rxQueue.readBatch(frames) == 2);
+        REQUIRE(frames[0U].rtpHeader.getSequence() == 1U);
+        REQUIRE(frames[1U].rtpHeader.getSequence() == 2U);
+        REQUIRE(frames[1U].message[0U] == 2U);
+
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+}
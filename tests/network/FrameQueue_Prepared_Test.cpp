@@ -0,0 +1,200 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/FrameQueue.h"
+#include "common/network/udp/Socket.h"
+#include "common/Log.h"
+
+using namespace network;
+using namespace network::frame;
+using namespace network::udp;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t PREPARED_FRAMES = 32U;
+const uint32_t PREPARED_PEERS = 4U;
+const uint32_t PREPARED_FNE_PEER_ID = 9000123U;
+const uint32_t PREPARED_STREAM_ID = 5150U;
+
+/**
+ * @brief Helper to open a loopback socket on a free port.
+ * @param[out] addr Address of the opened socket.
+ * @param[out] addrLen Length of address structure.
+ * @returns Socket* Opened socket.
+ */
+static Socket* openLoopback(sockaddr_storage& addr, uint32_t& addrLen)
+{
+    // find a free port
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    struct sockaddr_in sin;
+    ::memset(&sin, 0x00, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sin.sin_port = 0;
+    ::bind(fd, (struct sockaddr*)&sin, sizeof(sin));
+
+    socklen_t len = sizeof(sin);
+    ::getsockname(fd, (struct sockaddr*)&sin, &len);
+    ::close(fd);
+
+    uint16_t port = ntohs(sin.sin_port);
+
+    Socket* socket = new Socket("127.0.0.1", port);
+    REQUIRE(socket->open());
+    REQUIRE(Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+    return socket;
+}
+
+/**
+ * @brief Helper to receive a datagram.
+ * @param socket Socket to receive on.
+ * @returns std::vector<uint8_t> Received datagram (empty if nothing was received).
+ */
+static std::vector<uint8_t> receive(Socket* socket)
+{
+    struct pollfd pfd;
+    pfd.fd = socket->getDescriptor();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, 1000) <= 0)
+        return std::vector<uint8_t>();
+
+    std::vector<uint8_t> buffer(DATA_PACKET_LENGTH);
+    ssize_t len = ::recv(socket->getDescriptor(), buffer.data(), buffer.size(), 0);
+    buffer.resize((len > 0) ? (size_t)len : 0U);
+    return buffer;
+}
+
+TEST_CASE("FrameQueue", "[Prepared Frame Test]") {
+    SECTION("PreparedFrame_Equivalence_Test") {
+        INFO("Frame Queue Prepared Frame Byte Equivalence Test");
+
+        sockaddr_storage rxAddr, plainAddr, preparedAddr;
+        uint32_t rxAddrLen = 0U, plainAddrLen = 0U, preparedAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* plainSocket = openLoopback(plainAddr, plainAddrLen);
+        Socket* preparedSocket = openLoopback(preparedAddr, preparedAddrLen);
+
+        FrameQueue plainQueue(plainSocket, PREPARED_FNE_PEER_ID, false);
+        FrameQueue preparedQueue(preparedSocket, PREPARED_FNE_PEER_ID, false);
+
+        const FrameQueue::OpcodePair opcodes[] = {
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR },
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 },
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }
+        };
+
+        std::mt19937 rng(5150U);
+        for (const FrameQueue::OpcodePair& opcode : opcodes) {
+            std::vector<uint32_t> plainTS, preparedTS;
+
+            for (uint32_t n = 0U; n < PREPARED_FRAMES; n++) {
+                uint32_t length = 1U + (rng() % 200U);
+                std::vector<uint8_t> message(length);
+                for (uint8_t& b : message)
+                    b = (uint8_t)rng();
+
+                // a frame prepared once and queued to many peers is encoded exactly as a frame queued per peer
+                FrameQueue::PreparedFrame frame;
+                REQUIRE(preparedQueue.prepareMessage(frame, message.data(), length, PREPARED_STREAM_ID, PREPARED_FNE_PEER_ID, opcode));
+
+                for (uint32_t p = 0U; p < PREPARED_PEERS; p++) {
+                    uint32_t peerId = 1000U + p;
+                    uint16_t rtpSeq = (uint16_t)(n * PREPARED_PEERS + p);
+
+                    plainQueue.enqueueMessage(message.data(), length, PREPARED_STREAM_ID, peerId, PREPARED_FNE_PEER_ID, opcode,
+                        rtpSeq, rxAddr, rxAddrLen);
+                    REQUIRE(plainQueue.flushQueue());
+                    std::vector<uint8_t> plain = receive(rxSocket);
+
+                    preparedQueue.enqueueMessage(frame, peerId, rtpSeq, rxAddr, rxAddrLen);
+                    REQUIRE(preparedQueue.flushQueue());
+                    std::vector<uint8_t> prepared = receive(rxSocket);
+
+                    REQUIRE(plain.size() == DVM_FRAME_HEADER_LENGTH_BYTES + length);
+                    REQUIRE(prepared.size() == plain.size());
+
+                    // the RTP timestamp is per queue and starts from the wall clock, the deltas are compared below
+                    RTPHeader plainHeader, preparedHeader;
+                    REQUIRE(plainHeader.decode(plain.data()));
+                    REQUIRE(preparedHeader.decode(prepared.data()));
+                    plainTS.push_back(plainHeader.getTimestamp());
+                    preparedTS.push_back(preparedHeader.getTimestamp());
+                    ::memset(plain.data() + 4U, 0x00U, 4U);
+                    ::memset(prepared.data() + 4U, 0x00U, 4U);
+
+                    REQUIRE(::memcmp(plain.data(), prepared.data(), plain.size()) == 0);
+                }
+            }
+
+            for (uint32_t i = 1U; i < plainTS.size(); i++)
+                REQUIRE(plainTS[i] - plainTS[0U] == preparedTS[i] - preparedTS[0U]);
+
+            // end the stream on both queues, so the next opcode starts a new stream
+            uint8_t end[1U] = { 0x00U };
+            plainQueue.enqueueMessage(end, 1U, PREPARED_STREAM_ID, 1000U, PREPARED_FNE_PEER_ID, opcode, RTP_END_OF_CALL_SEQ, rxAddr, rxAddrLen);
+            preparedQueue.enqueueMessage(end, 1U, PREPARED_STREAM_ID, 1000U, PREPARED_FNE_PEER_ID, opcode, RTP_END_OF_CALL_SEQ, rxAddr, rxAddrLen);
+            REQUIRE(plainQueue.flushQueue());
+            REQUIRE(preparedQueue.flushQueue());
+            REQUIRE(receive(rxSocket).size() == DVM_FRAME_HEADER_LENGTH_BYTES + 1U);
+            REQUIRE(receive(rxSocket).size() == DVM_FRAME_HEADER_LENGTH_BYTES + 1U);
+        }
+
+        preparedSocket->close();
+        plainSocket->close();
+        rxSocket->close();
+        delete preparedSocket;
+        delete plainSocket;
+        delete rxSocket;
+    }
+
+    SECTION("PreparedFrame_Invalid_Test") {
+        INFO("Frame Queue Invalid Prepared Frame Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+
+        FrameQueue txQueue(txSocket, PREPARED_FNE_PEER_ID, false);
+
+        // an empty message cannot be prepared, and the failed frame queues nothing
+        uint8_t message[8U] = { 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U };
+        FrameQueue::PreparedFrame frame;
+        REQUIRE(!txQueue.prepareMessage(frame, nullptr, 8U, PREPARED_STREAM_ID, PREPARED_FNE_PEER_ID,
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }));
+        txQueue.enqueueMessage(frame, 1000U, 0U, rxAddr, rxAddrLen);
+        REQUIRE(!txQueue.prepareMessage(frame, message, 0U, PREPARED_STREAM_ID, PREPARED_FNE_PEER_ID,
+            { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }));
+        txQueue.enqueueMessage(frame, 1000U, 0U, rxAddr, rxAddrLen);
+
+        REQUIRE(txQueue.stats().enqueued == 0U);
+        REQUIRE(!txQueue.flushQueue());
+
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+}
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/RawFrameQueue.h"
+#include "common/network/udp/Socket.h"
+#include "common/Log.h"
+
+using namespace network;
+using namespace network::udp;
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t WRITER_MSG_LEN = 24U;
+const uint32_t WRITER_LATENCY = 1000U;
+const uint32_t WRITER_IDLE_MS = 200U;
+
+/**
+ * @brief Helper to open a loopback socket on a free port.
+ * @param[out] addr Address of the opened socket.
+ * @param[out] addrLen Length of address structure.
+ * @returns Socket* Opened socket.
+ */
+static Socket* openLoopback(sockaddr_storage& addr, uint32_t& addrLen)
+{
+    // find a free port
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+
+    struct sockaddr_in sin;
+    ::memset(&sin, 0x00, sizeof(sin));
+    sin.sin_family = AF_INET;
+    sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sin.sin_port = 0;
+    ::bind(fd, (struct sockaddr*)&sin, sizeof(sin));
+
+    socklen_t len = sizeof(sin);
+    ::getsockname(fd, (struct sockaddr*)&sin, &len);
+    ::close(fd);
+
+    uint16_t port = ntohs(sin.sin_port);
+
+    Socket* socket = new Socket("127.0.0.1", port);
+    REQUIRE(socket->open());
+    REQUIRE(Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+    return socket;
+}
+
+/**
+ * @brief Helper to receive a datagram, waiting at most the given time for it.
+ * @param socket Socket to receive on.
+ * @param[out] buffer Buffer to receive into.
+ * @param timeoutMs Time to wait, in milliseconds.
+ * @returns int Length of the received datagram, or -1 if nothing was received.
+ */
+static int receive(Socket* socket, uint8_t* buffer, int timeoutMs)
+{
+    struct pollfd pfd;
+    pfd.fd = socket->getDescriptor();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, timeoutMs) <= 0)
+        return -1;
+
+    return (int)::recv(socket->getDescriptor(), buffer, DATA_PACKET_LENGTH, 0);
+}
+
+TEST_CASE("RawFrameQueue", "[Writer Test]") {
+    SECTION("RawFrameQueue_Writer_Idle_Test") {
+        INFO("Raw Frame Queue Idle Writer Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+
+        RawFrameQueue queue(txSocket, false);
+        REQUIRE(queue.startWriter("test:writer", WRITER_LATENCY));
+        REQUIRE(queue.isWriterRunning());
+
+        // with nothing queued, the writer sleeps instead of waking every latency interval
+        std::this_thread::sleep_for(std::chrono::milliseconds(WRITER_IDLE_MS));
+        REQUIRE(queue.stats().writerWakeups <= 2U);
+
+        queue.stopWriter();
+        REQUIRE(!queue.isWriterRunning());
+
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+
+    SECTION("RawFrameQueue_Writer_Flush_Test") {
+        INFO("Raw Frame Queue Writer Flush Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+
+        RawFrameQueue queue(txSocket, false);
+        REQUIRE(queue.startWriter("test:writer", WRITER_LATENCY));
+
+        // a flushed message is written by the woken writer
+        uint8_t message[WRITER_MSG_LEN];
+        ::memset(message, 0x5AU, WRITER_MSG_LEN);
+        queue.enqueueMessage(message, WRITER_MSG_LEN, rxAddr, rxAddrLen);
+        REQUIRE(queue.flushQueue());
+
+        uint8_t buffer[DATA_PACKET_LENGTH];
+        REQUIRE(receive(rxSocket, buffer, 1000) == (int)WRITER_MSG_LEN);
+        REQUIRE(::memcmp(buffer, message, WRITER_MSG_LEN) == 0);
+
+        // a message queued without a flush is still written, after at most the latency interval
+        ::memset(message, 0xA5U, WRITER_MSG_LEN);
+        queue.enqueueMessage(message, WRITER_MSG_LEN, rxAddr, rxAddrLen);
+
+        REQUIRE(receive(rxSocket, buffer, 1000) == (int)WRITER_MSG_LEN);
+        REQUIRE(::memcmp(buffer, message, WRITER_MSG_LEN) == 0);
+
+        // the writer counts a datagram after it is written, so only check the stats once the writer stopped
+        queue.stopWriter();
+
+        RawFrameQueueStats stats = queue.stats();
+        REQUIRE(stats.enqueued == 2U);
+        REQUIRE(stats.written == 2U);
+        REQUIRE(stats.queueDepth == 0U);
+
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+
+    SECTION("RawFrameQueue_Writer_Stop_Test") {
+        INFO("Raw Frame Queue Writer Stop Test");
+
+        sockaddr_storage rxAddr, txAddr;
+        uint32_t rxAddrLen = 0U, txAddrLen = 0U;
+        Socket* rxSocket = openLoopback(rxAddr, rxAddrLen);
+        Socket* txSocket = openLoopback(txAddr, txAddrLen);
+
+        RawFrameQueue queue(txSocket, false);
+        REQUIRE(queue.startWriter("test:writer", WRITER_LATENCY));
+
+        // stopping the writer writes whatever is still queued
+        uint8_t message[WRITER_MSG_LEN];
+        for (uint32_t n = 0U; n < 4U; n++) {
+            ::memset(message, (uint8_t)n, WRITER_MSG_LEN);
+            queue.enqueueMessage(message, WRITER_MSG_LEN, rxAddr, rxAddrLen);
+        }
+        queue.stopWriter();
+
+        uint8_t buffer[DATA_PACKET_LENGTH];
+        for (uint32_t n = 0U; n < 4U; n++) {
+            REQUIRE(receive(rxSocket, buffer, 1000) == (int)WRITER_MSG_LEN);
+            REQUIRE(buffer[0U] == (uint8_t)n);
+        }
+
+        REQUIRE(queue.stats().queueDepth == 0U);
+
+        txSocket->close();
+        rxSocket->close();
+        delete txSocket;
+        delete rxSocket;
+    }
+}
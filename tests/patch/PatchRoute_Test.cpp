@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "patch/PatchRouteTable.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Helper to create a talkgroup patch.
+ * @param name Textual name of the patch.
+ * @param srcTGId Source talkgroup ID.
+ * @param srcSlot Source DMR slot.
+ * @param dstTGId Destination talkgroup ID.
+ * @param dstSlot Destination DMR slot.
+ * @param twoWay Flag indicating whether or not the patch is two-way.
+ * @returns PatchEntry Talkgroup patch.
+ */
+static PatchEntry makePatch(const std::string& name, uint32_t srcTGId, uint8_t srcSlot, uint32_t dstTGId, uint8_t dstSlot, bool twoWay)
+{
+    PatchEntry patch;
+    patch.name = name;
+    patch.srcTGId = srcTGId;
+    patch.srcSlot = srcSlot;
+    patch.dstTGId = dstTGId;
+    patch.dstSlot = dstSlot;
+    patch.twoWay = twoWay;
+    return patch;
+}
+
+TEST_CASE("PatchRouteTable", "[Patch Test]") {
+    SECTION("PatchRoute_Build_Test") {
+        INFO("Patch Route Table Build Test");
+
+        std::vector<PatchEntry> patches;
+        patches.push_back(makePatch("a", 100U, 1U, 200U, 2U, false));
+        patches.push_back(makePatch("b", 300U, 1U, 400U, 1U, true));
+        patches.push_back(makePatch("c", 100U, 2U, 500U, 1U, false));
+
+        PatchRouteTable table;
+        REQUIRE(table.build(patches, TX_MODE_DMR));
+
+        // every direction of every patch has a route, in patch order
+        const std::vector<PatchRoute>& routes = table.routes();
+        REQUIRE(routes.size() == 4U);
+
+        uint32_t routeIdx = 0U;
+        REQUIRE(table.find(100U, 1U, routeIdx));
+        REQUIRE(routeIdx == 0U);
+        REQUIRE(routes[routeIdx].patchIdx == 0U);
+        REQUIRE(routes[routeIdx].tgId == 200U);
+        REQUIRE(routes[routeIdx].slot == 2U);
+
+        // a two-way patch routes both of its talkgroups
+        REQUIRE(table.find(300U, 1U, routeIdx));
+        REQUIRE(routeIdx == 1U);
+        REQUIRE(routes[routeIdx].tgId == 400U);
+        REQUIRE(table.find(400U, 1U, routeIdx));
+        REQUIRE(routeIdx == 2U);
+        REQUIRE(routes[routeIdx].patchIdx == 1U);
+        REQUIRE(routes[routeIdx].tgId == 300U);
+
+        // the same talkgroup on the other DMR slot is a different route
+        REQUIRE(table.find(100U, 2U, routeIdx));
+        REQUIRE(routeIdx == 3U);
+        REQUIRE(routes[routeIdx].patchIdx == 2U);
+        REQUIRE(routes[routeIdx].tgId == 500U);
+
+        // one-way destinations, and unpatched talkgroups, are not routed
+        REQUIRE(!table.find(200U, 2U, routeIdx));
+        REQUIRE(!table.find(500U, 1U, routeIdx));
+        REQUIRE(!table.find(300U, 2U, routeIdx));
+        REQUIRE(!table.find(999U, 1U, routeIdx));
+
+        // P25 has no slots, so the same talkgroup patched on both DMR slots is a duplicate
+        REQUIRE(!table.build(patches, TX_MODE_P25));
+        patches.pop_back();
+        REQUIRE(table.build(patches, TX_MODE_P25));
+        REQUIRE(table.routes().size() == 3U);
+        REQUIRE(table.find(100U, 0U, routeIdx));
+        REQUIRE(table.routes()[routeIdx].slot == 0U);
+        REQUIRE(!table.find(100U, 1U, routeIdx));
+
+        // the route key keeps the slot apart from the talkgroup
+        REQUIRE(PatchRouteTable::routeKey(100U, 1U) != PatchRouteTable::routeKey(100U, 2U));
+        REQUIRE(PatchRouteTable::routeKey(16777215U, 0U) != PatchRouteTable::routeKey(16777215U, 1U));
+    }
+
+    SECTION("PatchRoute_Duplicate_Test") {
+        INFO("Patch Route Table Duplicate Talkgroup Test");
+
+        PatchRouteTable table;
+
+        // a talkgroup patched twice as a source
+        std::vector<PatchEntry> patches;
+        patches.push_back(makePatch("a", 100U, 1U, 200U, 1U, false));
+        patches.push_back(makePatch("b", 100U, 1U, 300U, 1U, false));
+        REQUIRE(!table.build(patches, TX_MODE_DMR));
+
+        // the destination of a two-way patch is also a source
+        patches.clear();
+        patches.push_back(makePatch("a", 100U, 1U, 200U, 1U, true));
+        patches.push_back(makePatch("b", 200U, 1U, 300U, 1U, false));
+        REQUIRE(!table.build(patches, TX_MODE_DMR));
+
+        // the destination of a one-way patch may be patched onward
+        patches.clear();
+        patches.push_back(makePatch("a", 100U, 1U, 200U, 1U, false));
+        patches.push_back(makePatch("b", 200U, 1U, 300U, 1U, false));
+        REQUIRE(table.build(patches, TX_MODE_DMR));
+        REQUIRE(table.routes().size() == 2U);
+
+        // invalid patches are rejected
+        patches.clear();
+        patches.push_back(makePatch("a", 100U, 1U, 100U, 1U, false));
+        REQUIRE(!table.build(patches, TX_MODE_DMR));
+
+        patches.clear();
+        patches.push_back(makePatch("a", 0U, 1U, 100U, 1U, false));
+        REQUIRE(!table.build(patches, TX_MODE_DMR));
+
+        patches.clear();
+        patches.push_back(makePatch("a", 100U, 3U, 200U, 1U, false));
+        REQUIRE(!table.build(patches, TX_MODE_DMR));
+
+        patches.clear();
+        patches.push_back(makePatch("a", 100U, 1U, 70000U, 1U, false));
+        REQUIRE(!table.build(patches, TX_MODE_P25));
+        REQUIRE(table.build(patches, TX_MODE_DMR));
+    }
+}